@@ -0,0 +1,133 @@
+#include "AnimationFrameClock.h"
+#include "duilib/Animation/AnimationPlayer.h"
+#include "duilib/Core/GlobalManager.h"
+#include <algorithm>
+
+namespace ui
+{
+
+AnimationFrameClock::AnimationFrameClock():
+    m_nFrameIntervalMs(16),
+    m_bRunning(false),
+    m_bInFrame(false)
+{
+}
+
+AnimationFrameClock::~AnimationFrameClock()
+{
+    Clear();
+}
+
+void AnimationFrameClock::AddPlayer(AnimationPlayerBase* pPlayer)
+{
+    ASSERT(pPlayer != nullptr);
+    if ((pPlayer == nullptr) || pPlayer->m_bInFrameClock) {
+        return;
+    }
+    pPlayer->m_bInFrameClock = true;
+    m_players.push_back(pPlayer);
+    if (!IsRunning()) {
+        StartClock();
+    }
+}
+
+void AnimationFrameClock::RemovePlayer(AnimationPlayerBase* pPlayer)
+{
+    if ((pPlayer == nullptr) || !pPlayer->m_bInFrameClock) {
+        return;
+    }
+    pPlayer->m_bInFrameClock = false;
+    auto iter = std::find(m_players.begin(), m_players.end(), pPlayer);
+    ASSERT(iter != m_players.end());
+    if (iter == m_players.end()) {
+        return;
+    }
+    if (m_bInFrame) {
+        //帧回调过程中不改变容器，回调结束后再清理
+        *iter = nullptr;
+        return;
+    }
+    m_players.erase(iter);
+    if (m_players.empty()) {
+        StopClock();
+    }
+}
+
+void AnimationFrameClock::SetFrameInterval(uint32_t nFrameIntervalMs)
+{
+    if (nFrameIntervalMs == 0) {
+        nFrameIntervalMs = 1;
+    }
+    if (m_nFrameIntervalMs != nFrameIntervalMs) {
+        m_nFrameIntervalMs = nFrameIntervalMs;
+        if (IsRunning()) {
+            StopClock();
+            StartClock();
+        }
+    }
+}
+
+uint32_t AnimationFrameClock::GetFrameInterval() const
+{
+    return m_nFrameIntervalMs;
+}
+
+bool AnimationFrameClock::IsRunning() const
+{
+    return m_bRunning;
+}
+
+size_t AnimationFrameClock::GetPlayerCount() const
+{
+    return m_players.size() - std::count(m_players.begin(), m_players.end(), nullptr);
+}
+
+void AnimationFrameClock::Clear()
+{
+    StopClock();
+    for (AnimationPlayerBase*& pPlayer : m_players) {
+        if (pPlayer != nullptr) {
+            pPlayer->m_bInFrameClock = false;
+            pPlayer = nullptr;
+        }
+    }
+    if (!m_bInFrame) {
+        m_players.clear();
+    }
+}
+
+void AnimationFrameClock::StartClock()
+{
+    m_clockFlag.Cancel();
+    m_bRunning = true;
+    GlobalManager::Instance().Timer().AddTimer(m_clockFlag.GetWeakFlag(),
+                                               [this]() { OnFrame(); },
+                                               m_nFrameIntervalMs);
+}
+
+void AnimationFrameClock::StopClock()
+{
+    m_clockFlag.Cancel();
+    m_bRunning = false;
+}
+
+void AnimationFrameClock::OnFrame()
+{
+    //本帧开始播放的动画已经在启动时播放过一次，不在本帧中处理
+    m_bInFrame = true;
+    const size_t nPlayerCount = m_players.size();
+    for (size_t nIndex = 0; nIndex < nPlayerCount; ++nIndex) {
+        AnimationPlayerBase* pPlayer = m_players[nIndex];
+        if (pPlayer != nullptr) {
+            pPlayer->Play();
+        }
+    }
+    m_bInFrame = false;
+
+    m_players.erase(std::remove(m_players.begin(), m_players.end(), nullptr), m_players.end());
+    if (m_players.empty()) {
+        StopClock();
+    }
+}
+
+} // namespace ui
@@ -0,0 +1,89 @@
+#ifndef UI_ANIMATION_ANIMATION_FRAME_CLOCK_H_
+#define UI_ANIMATION_ANIMATION_FRAME_CLOCK_H_
+
+#include "duilib/Core/Callback.h"
+#include <vector>
+
+namespace ui
+{
+class AnimationPlayerBase;
+
+/** 动画的帧时钟：所有正在播放的动画共用一个定时器，每帧依次驱动各个动画播放器
+*   1. 同时播放的多个动画在同一次定时器回调中更新，控件的重绘请求合并到同一次绘制中
+*   2. 第一个动画开始播放时启动定时器，所有动画都停止后关闭定时器，没有动画时不会唤醒
+*/
+class UILIB_API AnimationFrameClock
+{
+public:
+    AnimationFrameClock();
+    ~AnimationFrameClock();
+    AnimationFrameClock(const AnimationFrameClock& r) = delete;
+    AnimationFrameClock& operator=(const AnimationFrameClock& r) = delete;
+
+public:
+    /** 添加一个正在播放的动画播放器（如果已经存在，则不重复添加）
+    * @param [in] pPlayer 动画播放器接口
+    */
+    void AddPlayer(AnimationPlayerBase* pPlayer);
+
+    /** 移除一个动画播放器（动画停止或者播放器销毁时调用）
+    * @param [in] pPlayer 动画播放器接口
+    */
+    void RemovePlayer(AnimationPlayerBase* pPlayer);
+
+    /** 设置帧间隔（毫秒），默认为16毫秒（约60帧/秒）
+    */
+    void SetFrameInterval(uint32_t nFrameIntervalMs);
+
+    /** 获取帧间隔（毫秒）
+    */
+    uint32_t GetFrameInterval() const;
+
+    /** 帧时钟的定时器是否正在运行
+    */
+    bool IsRunning() const;
+
+    /** 获取正在播放的动画播放器个数
+    */
+    size_t GetPlayerCount() const;
+
+    /** 停止定时器，并清除所有动画播放器
+    */
+    void Clear();
+
+    /** 驱动所有动画播放一帧（由定时器回调调用，也可直接调用以逐帧驱动动画）
+    *   帧回调过程中可以添加或者移除动画播放器：本帧中添加的播放器从下一帧开始驱动，移除的播放器不再驱动
+    */
+    void OnFrame();
+
+private:
+    /** 启动或停止定时器
+    */
+    void StartClock();
+    void StopClock();
+
+private:
+    /** 正在播放的动画播放器（在帧回调过程中移除时置为nullptr，回调结束后再清理）
+    */
+    std::vector<AnimationPlayerBase*> m_players;
+
+    /** 帧间隔（毫秒）
+    */
+    uint32_t m_nFrameIntervalMs;
+
+    /** 定时器是否正在运行
+    */
+    bool m_bRunning;
+
+    /** 是否正在执行帧回调
+    */
+    bool m_bInFrame;
+
+    /** 定时器取消标志
+    */
+    WeakCallbackFlag m_clockFlag;
+};
+
+} // namespace ui
+
+#endif // UI_ANIMATION_ANIMATION_FRAME_CLOCK_H_
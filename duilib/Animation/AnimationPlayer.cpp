@@ -1,4 +1,5 @@
 #include "AnimationPlayer.h"
+#include "duilib/Animation/AnimationFrameClock.h"
 #include "duilib/Core/GlobalManager.h"
 
 #define AP_NO_VALUE -1
@@ -14,24 +15,26 @@ AnimationPlayerBase::AnimationPlayerBase():
     m_animationType(AnimationType::kAnimationNone),
     m_bFirstRun(true),
     m_playCallback(nullptr),
-    m_completeCallback(nullptr)
+    m_completeCallback(nullptr),
+    m_bInFrameClock(false)
 {
     InitBaseData();
 }
 
 AnimationPlayerBase::~AnimationPlayerBase()
 {
+    StopTimer();
 }
 
 void AnimationPlayerBase::Reset()
 {
-    m_weakFlagOwner.Cancel();
+    StopTimer();
     Init();
 }
 
 void AnimationPlayerBase::Clear()
 {
-    m_weakFlagOwner.Cancel();
+    StopTimer();
     m_playCallback = nullptr;
     m_completeCallback = nullptr;
 }
@@ -56,7 +59,7 @@ void AnimationPlayerBase::Init()
 
 void AnimationPlayerBase::Start()
 {
-    m_weakFlagOwner.Cancel();
+    StopTimer();
     m_palyedMillSeconds = 0;
     m_reverseStart = false;
     StartTimer();
@@ -64,12 +67,12 @@ void AnimationPlayerBase::Start()
 
 void AnimationPlayerBase::Stop()
 {
-    m_weakFlagOwner.Cancel();
+    StopTimer();
 }
 
 void AnimationPlayerBase::Continue()
 {
-    m_weakFlagOwner.Cancel();
+    StopTimer();
     if (m_reverseStart) {
         ReverseAllValue();
     }    
@@ -81,7 +84,7 @@ void AnimationPlayerBase::Continue()
 
 void AnimationPlayerBase::ReverseContinue()
 {
-    m_weakFlagOwner.Cancel();
+    StopTimer();
     if (!m_reverseStart) {
         ReverseAllValue();
     }        
@@ -110,9 +113,17 @@ void AnimationPlayerBase::StartTimer()
     }
 
     Play();
-    auto playCallback = UiBind(&AnimationPlayerBase::Play, this);
-    ASSERT(m_elapseMillSeconds <= INT32_MAX);
-    GlobalManager::Instance().Timer().AddTimer(m_weakFlagOwner.GetWeakFlag(), playCallback, (uint32_t)m_elapseMillSeconds);
+    if (m_bPlaying) {
+        //所有动画共用帧时钟，同一帧内的重绘请求合并到一次绘制中
+        GlobalManager::Instance().FrameClock().AddPlayer(this);
+    }
+}
+
+void AnimationPlayerBase::StopTimer()
+{
+    if (m_bInFrameClock) {
+        GlobalManager::Instance().FrameClock().RemovePlayer(this);
+    }
 }
 
 void AnimationPlayerBase::Play()
@@ -160,7 +171,7 @@ void AnimationPlayerBase::Complete()
         m_completeCallback();
     }        
 
-    m_weakFlagOwner.Cancel();
+    StopTimer();
     m_bPlaying = false;
 }
 
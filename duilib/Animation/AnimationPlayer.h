@@ -7,6 +7,7 @@
 
 namespace ui 
 {
+class AnimationFrameClock;
 
 typedef std::function<void (int64_t)> PlayCallback;        //播放回调函数
 typedef std::function<void (void)> CompleteCallback;    //播放完成回调函数
@@ -99,7 +100,7 @@ public:
     */
     virtual void ReverseContinue();
 
-    /** 启动动画定时器
+    /** 启动动画定时器（加入全局的动画帧时钟）
     */
     virtual void StartTimer();
 
@@ -108,10 +109,16 @@ public:
     virtual int64_t GetCurrentValue() const = 0;
 
 private:
-    /** 播放一次动画（在定时器中触发调用）
+    friend class AnimationFrameClock;
+
+    /** 播放一次动画（由动画帧时钟每帧触发调用）
     */
     void Play();
 
+    /** 停止动画定时器（从动画帧时钟中移除）
+    */
+    void StopTimer();
+
     /** 交换起始值和结束值
     */
     void ReverseAllValue();
@@ -177,9 +184,9 @@ protected:
     */
     std::chrono::steady_clock::time_point m_startTime;
     
-    /** 定时器终止标志
+    /** 是否已经加入动画帧时钟
     */
-    WeakCallbackFlag m_weakFlagOwner;
+    bool m_bInFrameClock;
 };
 
 
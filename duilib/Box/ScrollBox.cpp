@@ -6,6 +6,7 @@
 #include "duilib/Core/GlobalManager.h"
 #include "duilib/Utils/AttributeUtil.h"
 #include "duilib/Utils/StringUtil.h"
+#include "duilib/Utils/PerformanceUtil.h"
 
 namespace ui
 {
@@ -291,6 +292,7 @@ UiSize64 ScrollBox::DoArrangeChildren(const UiRect& rc, bool bEstimateOnly)
     childSize.Validate();
 
     //在目标区域中，对子控件进行布局管理（调整子控件的位置和大小）
+    PerformanceTrace traceArrange(_T("Layout::ArrangeChildren"));
     requiredSize = GetLayout()->ArrangeChildren(m_items, childSize, bEstimateOnly);
     return requiredSize;
 }
@@ -7,6 +7,7 @@
 #include "duilib/Core/StateColorMap.h"
 #include "duilib/Utils/StringConvert.h"
 #include "duilib/Utils/AttributeUtil.h"
+#include "duilib/Utils/AttributeNameTable.h"
 #include "duilib/Animation/AnimationManager.h"
 #include "duilib/Animation/AnimationPlayer.h"
 
@@ -48,159 +49,236 @@ LabelImpl::~LabelImpl()
 
 bool LabelImpl::OnSetAttribute(const DString& strName, const DString& strValue)
 {
-    if (strName == _T("text_align")) {
-        bool bHCenter = false;        
-        size_t centerPos = strValue.find(_T("center"));
-        if (centerPos != DString::npos) {
-            //"center"这个属性有歧义，保留以保持兼容性，新的属性是"hcenter"
-            bHCenter = true;
-            size_t vCenterPos = strValue.find(_T("vcenter"));
-            if (vCenterPos != DString::npos) {
-                if ((vCenterPos + 1) == centerPos) {
-                    bHCenter = false;
+    //属性名称对应的ID
+    enum AttributeId : int32_t
+    {
+        kTextAlign, kEndEllipsis, kPathEllipsis, kSingleLine, kMultiLine, kText, kTextId, kAutoTooltip,
+        kFont, kNormalTextColor, kHotTextColor, kPushedTextColor, kDisabledTextColor, kTextPadding,
+        kReplaceNewline, kSpacingMul, kSpacingAdd, kVerticalText, kWordSpacing, kUseFontHeight,
+        kAsciiRotate90, kRichText
+    };
+    static const AttributeNameTable attributeNames = {
+        { _T("text_align"), kTextAlign },
+        { _T("end_ellipsis"), kEndEllipsis }, { _T("endellipsis"), kEndEllipsis },
+        { _T("path_ellipsis"), kPathEllipsis }, { _T("pathellipsis"), kPathEllipsis },
+        { _T("single_line"), kSingleLine }, { _T("singleline"), kSingleLine },
+        { _T("multi_line"), kMultiLine }, { _T("multiline"), kMultiLine },
+        { _T("text"), kText },
+        { _T("text_id"), kTextId }, { _T("textid"), kTextId },
+        { _T("auto_tooltip"), kAutoTooltip }, { _T("autotooltip"), kAutoTooltip },
+        { _T("font"), kFont },
+        { _T("normal_text_color"), kNormalTextColor }, { _T("normaltextcolor"), kNormalTextColor },
+        { _T("hot_text_color"), kHotTextColor }, { _T("hottextcolor"), kHotTextColor },
+        { _T("pushed_text_color"), kPushedTextColor }, { _T("pushedtextcolor"), kPushedTextColor },
+        { _T("disabled_text_color"), kDisabledTextColor }, { _T("disabledtextcolor"), kDisabledTextColor },
+        { _T("text_padding"), kTextPadding }, { _T("textpadding"), kTextPadding },
+        { _T("replace_newline"), kReplaceNewline },
+        { _T("spacing_mul"), kSpacingMul },
+        { _T("spacing_add"), kSpacingAdd },
+        { _T("vertical_text"), kVerticalText },
+        { _T("word_spacing"), kWordSpacing },
+        { _T("use_font_height"), kUseFontHeight },
+        { _T("ascii_rotate_90"), kAsciiRotate90 },
+        { _T("rich_text"), kRichText }
+    };
+    switch (attributeNames.Find(strName)) {
+    case kTextAlign:
+        {
+            bool bHCenter = false;        
+            size_t centerPos = strValue.find(_T("center"));
+            if (centerPos != DString::npos) {
+                //"center"这个属性有歧义，保留以保持兼容性，新的属性是"hcenter"
+                bHCenter = true;
+                size_t vCenterPos = strValue.find(_T("vcenter"));
+                if (vCenterPos != DString::npos) {
+                    if ((vCenterPos + 1) == centerPos) {
+                        bHCenter = false;
+                    }
                 }
             }
-        }
 
-        //水平对齐方式
-        if (strValue.find(_T("hcenter")) != DString::npos) {            
-            bHCenter = true;
-        }
-        if (bHCenter) {
-            //水平对齐：居中
-            m_uTextStyle &= ~TEXT_HALIGN_ALL;
-            m_uTextStyle |= TEXT_HCENTER;
-        }
-        else if (strValue.find(_T("right")) != DString::npos) {
-            //水平对齐：靠右
-            m_uTextStyle &= ~TEXT_HALIGN_ALL;
-            m_uTextStyle |= TEXT_RIGHT;
-        }
-        else if (strValue.find(_T("left")) != DString::npos) {
-            //水平对齐：靠左
-            m_uTextStyle &= ~TEXT_HALIGN_ALL;
-            m_uTextStyle |= TEXT_LEFT;
-        }
-        else if (strValue.find(_T("hjustify")) != DString::npos) {
-            //水平对齐：两端对齐
-            m_uTextStyle &= ~TEXT_HALIGN_ALL;
-            m_uTextStyle |= TEXT_HJUSTIFY;
-        }
+            //水平对齐方式
+            if (strValue.find(_T("hcenter")) != DString::npos) {            
+                bHCenter = true;
+            }
+            if (bHCenter) {
+                //水平对齐：居中
+                m_uTextStyle &= ~TEXT_HALIGN_ALL;
+                m_uTextStyle |= TEXT_HCENTER;
+            }
+            else if (strValue.find(_T("right")) != DString::npos) {
+                //水平对齐：靠右
+                m_uTextStyle &= ~TEXT_HALIGN_ALL;
+                m_uTextStyle |= TEXT_RIGHT;
+            }
+            else if (strValue.find(_T("left")) != DString::npos) {
+                //水平对齐：靠左
+                m_uTextStyle &= ~TEXT_HALIGN_ALL;
+                m_uTextStyle |= TEXT_LEFT;
+            }
+            else if (strValue.find(_T("hjustify")) != DString::npos) {
+                //水平对齐：两端对齐
+                m_uTextStyle &= ~TEXT_HALIGN_ALL;
+                m_uTextStyle |= TEXT_HJUSTIFY;
+            }
 
-        //垂直对齐方式
-        if (strValue.find(_T("top")) != DString::npos) {
-            //垂直对齐：靠上
-            m_uTextStyle &= ~TEXT_VALIGN_ALL;
-            m_uTextStyle |= TEXT_TOP;
-        }
-        else if (strValue.find(_T("vcenter")) != DString::npos) {
-            //垂直对齐：居中
-            m_uTextStyle &= ~TEXT_VALIGN_ALL;
-            m_uTextStyle |= TEXT_VCENTER;
-        }
-        else if (strValue.find(_T("bottom")) != DString::npos) {
-            //垂直对齐：靠下
-            m_uTextStyle &= ~TEXT_VALIGN_ALL;
-            m_uTextStyle |= TEXT_BOTTOM;
-        }
-        else if (strValue.find(_T("vjustify")) != DString::npos) {
-            //垂直对齐：靠下
-            m_uTextStyle &= ~TEXT_VALIGN_ALL;
-            m_uTextStyle |= TEXT_VJUSTIFY;
-        }
-    }
-    else if ((strName == _T("end_ellipsis")) || (strName == _T("endellipsis"))) {
-        if (strValue == _T("true")) {
-            m_uTextStyle |= TEXT_END_ELLIPSIS;
-        }
-        else {
-            m_uTextStyle &= ~TEXT_END_ELLIPSIS;
+            //垂直对齐方式
+            if (strValue.find(_T("top")) != DString::npos) {
+                //垂直对齐：靠上
+                m_uTextStyle &= ~TEXT_VALIGN_ALL;
+                m_uTextStyle |= TEXT_TOP;
+            }
+            else if (strValue.find(_T("vcenter")) != DString::npos) {
+                //垂直对齐：居中
+                m_uTextStyle &= ~TEXT_VALIGN_ALL;
+                m_uTextStyle |= TEXT_VCENTER;
+            }
+            else if (strValue.find(_T("bottom")) != DString::npos) {
+                //垂直对齐：靠下
+                m_uTextStyle &= ~TEXT_VALIGN_ALL;
+                m_uTextStyle |= TEXT_BOTTOM;
+            }
+            else if (strValue.find(_T("vjustify")) != DString::npos) {
+                //垂直对齐：靠下
+                m_uTextStyle &= ~TEXT_VALIGN_ALL;
+                m_uTextStyle |= TEXT_VJUSTIFY;
+            }
         }
-    }
-    else if ((strName == _T("path_ellipsis")) || (strName == _T("pathellipsis"))) {
-        if (strValue == _T("true")) {
-            m_uTextStyle |= TEXT_PATH_ELLIPSIS;
+        break;
+    case kEndEllipsis:
+        {
+            if (strValue == _T("true")) {
+                m_uTextStyle |= TEXT_END_ELLIPSIS;
+            }
+            else {
+                m_uTextStyle &= ~TEXT_END_ELLIPSIS;
+            }
         }
-        else {
-            m_uTextStyle &= ~TEXT_PATH_ELLIPSIS;
+        break;
+    case kPathEllipsis:
+        {
+            if (strValue == _T("true")) {
+                m_uTextStyle |= TEXT_PATH_ELLIPSIS;
+            }
+            else {
+                m_uTextStyle &= ~TEXT_PATH_ELLIPSIS;
+            }
         }
-    }
-    else if ((strName == _T("single_line")) || (strName == _T("singleline"))) {
-        SetSingleLine(strValue == _T("true"));
-    }
-    else if ((strName == _T("multi_line")) || (strName == _T("multiline"))) {
-        SetSingleLine(strValue != _T("true"));
-    }
-    else if (strName == _T("text")) {
-        SetText(strValue);
-    }
-    else if ((strName == _T("text_id")) || (strName == _T("textid"))){
-        SetTextId(strValue);
-    }
-    else if ((strName == _T("auto_tooltip")) || (strName == _T("autotooltip"))) {
-        SetAutoShowToolTipEnabled(strValue == _T("true"));
-    }
-    else if (strName == _T("font")) {
-        SetFontId(strValue);
-    }
-    else if ((strName == _T("normal_text_color")) || (strName == _T("normaltextcolor"))) {
-        SetStateTextColor(kControlStateNormal, strValue);
-    }
-    else if ((strName == _T("hot_text_color")) || (strName == _T("hottextcolor"))) {
-        SetStateTextColor(kControlStateHot, strValue);
-    }
-    else if ((strName == _T("pushed_text_color")) || (strName == _T("pushedtextcolor"))) {
-        SetStateTextColor(kControlStatePushed, strValue);
-    }
-    else if ((strName == _T("disabled_text_color")) || (strName == _T("disabledtextcolor"))) {
-        SetStateTextColor(kControlStateDisabled, strValue);
-    }
-    else if ((strName == _T("text_padding")) || (strName == _T("textpadding"))) {
-        UiPadding rcTextPadding;
-        AttributeUtil::ParsePaddingValue(strValue.c_str(), rcTextPadding);
-        SetTextPadding(rcTextPadding, true);
-    }
-    else if (strName == _T("replace_newline")) {
-        // 设置是否替换换行符(将字符串"\\n"替换为换行符"\n"
-        SetReplaceNewline(strValue == _T("true"));
-    }
-    else if (strName == _T("spacing_mul")) {
-        // 设置行间距倍数
-        float mul = 1.0f;
-        float add = 0;
-        GetLineSpacing(&mul, &add);
-        mul = StringUtil::StringToFloat(strValue.c_str(), nullptr);
-        SetLineSpacing(mul, add, false);
-    }
-    else if (strName == _T("spacing_add")) {
-        // 设置行间距固定的附加像素值
-        float mul = 1.0f;
-        float add = 0;
-        GetLineSpacing(&mul, &add);
-        add = StringUtil::StringToFloat(strValue.c_str(), nullptr);
-        SetLineSpacing(mul, add, true);
-    }
-    else if (strName == _T("vertical_text")) {
-        // 设置是否为纵向文本
-        SetVerticalText(strValue == _T("true"));
-    }
-    else if (strName == _T("word_spacing")) {
-        // 设置两个相邻的字符之间的间隔（像素）
-        SetWordSpacing(StringUtil::StringToFloat(strValue.c_str(), nullptr), true);
-    }
-    else if (strName == _T("use_font_height")) {
-        // 设置当纵向绘制文本时，使用字体的默认高度，而不是每个字体的高度（显示时所有字体等高）
-        SetUseFontHeight(strValue == _T("true"));
-    }
-    else if (strName == _T("ascii_rotate_90")) {
-        // 设置当纵向绘制文本时，对于字母数字等，顺时针旋转90度显示
-        SetRotate90ForAscii(strValue == _T("true"));
-    }
-    else if (strName == _T("rich_text")) {
-        // 设置文本内容是否为RichText
-        SetRichText(strValue == _T("true"));
-    }
-    else {
+        break;
+    case kSingleLine:
+        {
+            SetSingleLine(strValue == _T("true"));
+        }
+        break;
+    case kMultiLine:
+        {
+            SetSingleLine(strValue != _T("true"));
+        }
+        break;
+    case kText:
+        {
+            SetText(strValue);
+        }
+        break;
+    case kTextId:
+        {
+            SetTextId(strValue);
+        }
+        break;
+    case kAutoTooltip:
+        {
+            SetAutoShowToolTipEnabled(strValue == _T("true"));
+        }
+        break;
+    case kFont:
+        {
+            SetFontId(strValue);
+        }
+        break;
+    case kNormalTextColor:
+        {
+            SetStateTextColor(kControlStateNormal, strValue);
+        }
+        break;
+    case kHotTextColor:
+        {
+            SetStateTextColor(kControlStateHot, strValue);
+        }
+        break;
+    case kPushedTextColor:
+        {
+            SetStateTextColor(kControlStatePushed, strValue);
+        }
+        break;
+    case kDisabledTextColor:
+        {
+            SetStateTextColor(kControlStateDisabled, strValue);
+        }
+        break;
+    case kTextPadding:
+        {
+            UiPadding rcTextPadding;
+            AttributeUtil::ParsePaddingValue(strValue.c_str(), rcTextPadding);
+            SetTextPadding(rcTextPadding, true);
+        }
+        break;
+    case kReplaceNewline:
+        {
+            // 设置是否替换换行符(将字符串"\\n"替换为换行符"\n"
+            SetReplaceNewline(strValue == _T("true"));
+        }
+        break;
+    case kSpacingMul:
+        {
+            // 设置行间距倍数
+            float mul = 1.0f;
+            float add = 0;
+            GetLineSpacing(&mul, &add);
+            mul = StringUtil::StringToFloat(strValue.c_str(), nullptr);
+            SetLineSpacing(mul, add, false);
+        }
+        break;
+    case kSpacingAdd:
+        {
+            // 设置行间距固定的附加像素值
+            float mul = 1.0f;
+            float add = 0;
+            GetLineSpacing(&mul, &add);
+            add = StringUtil::StringToFloat(strValue.c_str(), nullptr);
+            SetLineSpacing(mul, add, true);
+        }
+        break;
+    case kVerticalText:
+        {
+            // 设置是否为纵向文本
+            SetVerticalText(strValue == _T("true"));
+        }
+        break;
+    case kWordSpacing:
+        {
+            // 设置两个相邻的字符之间的间隔（像素）
+            SetWordSpacing(StringUtil::StringToFloat(strValue.c_str(), nullptr), true);
+        }
+        break;
+    case kUseFontHeight:
+        {
+            // 设置当纵向绘制文本时，使用字体的默认高度，而不是每个字体的高度（显示时所有字体等高）
+            SetUseFontHeight(strValue == _T("true"));
+        }
+        break;
+    case kAsciiRotate90:
+        {
+            // 设置当纵向绘制文本时，对于字母数字等，顺时针旋转90度显示
+            SetRotate90ForAscii(strValue == _T("true"));
+        }
+        break;
+    case kRichText:
+        {
+            // 设置文本内容是否为RichText
+            SetRichText(strValue == _T("true"));
+        }
+        break;
+    default:
         return false;
     }
     return true;
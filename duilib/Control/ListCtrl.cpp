@@ -1801,6 +1801,45 @@ bool ListCtrl::IsDataItemVisible(size_t itemIndex) const
     return m_pData->IsDataItemVisible(itemIndex);
 }
 
+bool ListCtrl::FilterDataItems(size_t columnIndex, const DString& filterText, bool bMatchPrefix,
+                               std::vector<size_t>& visibleItemIndexs)
+{
+    visibleItemIndexs.clear();
+    size_t nColumnId = GetColumnId(columnIndex);
+    ASSERT(nColumnId != Box::InvalidIndex);
+    if (nColumnId == Box::InvalidIndex) {
+        return false;
+    }
+    return FilterDataItemsById(nColumnId, filterText, bMatchPrefix, visibleItemIndexs);
+}
+
+bool ListCtrl::FilterDataItemsById(size_t columnId, const DString& filterText, bool bMatchPrefix,
+                                   std::vector<size_t>& visibleItemIndexs)
+{
+    bool bChanged = false;
+    bool bRet = m_pData->FilterDataItems(columnId, filterText, bMatchPrefix, visibleItemIndexs, bChanged);
+    if (bChanged) {
+        UpdateHeaderColumnCheckBox(Box::InvalidIndex);
+        UpdateHeaderCheckBox();
+    }
+    return bRet;
+}
+
+bool ListCtrl::SetColumnFilterIndex(size_t columnIndex, bool bEnable)
+{
+    size_t nColumnId = GetColumnId(columnIndex);
+    ASSERT(nColumnId != Box::InvalidIndex);
+    if (nColumnId == Box::InvalidIndex) {
+        return false;
+    }
+    return SetColumnFilterIndexById(nColumnId, bEnable);
+}
+
+bool ListCtrl::SetColumnFilterIndexById(size_t columnId, bool bEnable)
+{
+    return m_pData->SetColumnFilterIndex(columnId, bEnable);
+}
+
 bool ListCtrl::SetDataItemSelected(size_t itemIndex, bool bSelected)
 {
     bool bChanged = false;
@@ -266,6 +266,27 @@ public:
     */
     bool IsDataItemVisible(size_t itemIndex) const;
 
+    /** 按列的文本过滤数据项（不区分大小写）：匹配的数据项显示，其他数据项隐藏
+    *   该列首次过滤时建立文本索引，之后随数据的修改同步更新，适用于输入时逐字过滤大量数据的场景
+    * @param [in] columnIndex 列的索引号，有效范围：[0, GetColumnCount())
+    * @param [in] columnId 列的ID
+    * @param [in] filterText 过滤的文本，为空时显示所有数据项
+    * @param [in] bMatchPrefix true表示文本以filterText开头，false表示文本中包含filterText
+    * @param [out] visibleItemIndexs 返回可见的数据项索引号，按升序排列
+    */
+    bool FilterDataItems(size_t columnIndex, const DString& filterText, bool bMatchPrefix,
+                         std::vector<size_t>& visibleItemIndexs);
+    bool FilterDataItemsById(size_t columnId, const DString& filterText, bool bMatchPrefix,
+                             std::vector<size_t>& visibleItemIndexs);
+
+    /** 启用或者关闭列的文本过滤索引（首次过滤时会自动启用；关闭后释放索引占用的内存）
+    * @param [in] columnIndex 列的索引号，有效范围：[0, GetColumnCount())
+    * @param [in] columnId 列的ID
+    * @param [in] bEnable true表示启用，false表示关闭
+    */
+    bool SetColumnFilterIndex(size_t columnIndex, bool bEnable);
+    bool SetColumnFilterIndexById(size_t columnId, bool bEnable);
+
     /** 设置数据项的选择属性
     * @param [in] itemIndex 数据项的索引号, 有效范围：[0, GetDataItemCount())
     * @param [in] bSelected 是否选择状态
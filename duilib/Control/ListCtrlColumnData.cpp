@@ -0,0 +1,403 @@
+#include "ListCtrlColumnData.h"
+#include "duilib/Utils/StringUtil.h"
+#include <string>
+
+namespace ui
+{
+//每行的标志位
+static const uint8_t kFlagHasData       = 0x01; //有数据
+static const uint8_t kFlagShowCheckBox  = 0x02; //显示CheckBox
+static const uint8_t kFlagChecked       = 0x04; //勾选状态
+static const uint8_t kFlagEditable      = 0x08; //可编辑
+
+//字符池中无用的字符数超过该值，并且超过字符池的一半时，重新整理字符池
+static const size_t kMinTextGarbage = 64 * 1024;
+
+bool ListCtrlColumnData::ExtraData::IsDefault() const
+{
+    return textColor.IsEmpty() && bkColor.IsEmpty() && (userDataN == 0) && userDataS.empty() &&
+           (nImageId == -1) && (nSortGroup == 0) && (nTextFormat == 0);
+}
+
+ListCtrlColumnData::ListCtrlColumnData():
+    m_nTextGarbage(0)
+{
+    //偏移为0的位置保留为空字符串
+    m_textPool.push_back(_T('\0'));
+}
+
+size_t ListCtrlColumnData::GetCount() const
+{
+    return m_flags.size();
+}
+
+void ListCtrlColumnData::Resize(size_t nCount)
+{
+    for (size_t itemIndex = nCount; itemIndex < m_flags.size(); ++itemIndex) {
+        ReleaseRow(itemIndex);
+    }
+    m_textOffsets.resize(nCount, 0);
+    m_textLengths.resize(nCount, 0);
+    m_flags.resize(nCount, 0);
+    m_extraIds.resize(nCount, 0);
+    CompactTextPool();
+    if (m_pTextIndex != nullptr) {
+        m_pTextIndex->OnResize(nCount);
+    }
+}
+
+void ListCtrlColumnData::Insert(size_t itemIndex)
+{
+    ASSERT(itemIndex <= m_flags.size());
+    if (itemIndex > m_flags.size()) {
+        itemIndex = m_flags.size();
+    }
+    m_textOffsets.insert(m_textOffsets.begin() + itemIndex, 0);
+    m_textLengths.insert(m_textLengths.begin() + itemIndex, 0);
+    m_flags.insert(m_flags.begin() + itemIndex, (uint8_t)0);
+    m_extraIds.insert(m_extraIds.begin() + itemIndex, 0);
+    if (m_pTextIndex != nullptr) {
+        m_pTextIndex->OnInsert(itemIndex);
+    }
+}
+
+void ListCtrlColumnData::Erase(size_t itemIndex)
+{
+    ASSERT(itemIndex < m_flags.size());
+    if (itemIndex >= m_flags.size()) {
+        return;
+    }
+    ReleaseRow(itemIndex);
+    m_textOffsets.erase(m_textOffsets.begin() + itemIndex);
+    m_textLengths.erase(m_textLengths.begin() + itemIndex);
+    m_flags.erase(m_flags.begin() + itemIndex);
+    m_extraIds.erase(m_extraIds.begin() + itemIndex);
+    CompactTextPool();
+    if (m_pTextIndex != nullptr) {
+        m_pTextIndex->OnErase(itemIndex);
+    }
+}
+
+void ListCtrlColumnData::Clear()
+{
+    std::vector<uint32_t>().swap(m_textOffsets);
+    std::vector<uint32_t>().swap(m_textLengths);
+    std::vector<DString::value_type>(1, _T('\0')).swap(m_textPool);
+    m_nTextGarbage = 0;
+    std::vector<uint8_t>().swap(m_flags);
+    std::vector<uint32_t>().swap(m_extraIds);
+    std::vector<ExtraData>().swap(m_extraDataList);
+    std::vector<uint32_t>().swap(m_freeExtraIds);
+    if (m_pTextIndex != nullptr) {
+        m_pTextIndex->Build(*this);
+    }
+}
+
+void ListCtrlColumnData::Reorder(const std::vector<size_t>& orders)
+{
+    const size_t nCount = m_flags.size();
+    ASSERT(orders.size() == nCount);
+    if (orders.size() != nCount) {
+        return;
+    }
+    //各个数组按相同的顺序调整，文本和附加数据本身不需要移动
+    std::vector<uint32_t> textOffsets(nCount);
+    std::vector<uint32_t> textLengths(nCount);
+    std::vector<uint8_t> flags(nCount);
+    std::vector<uint32_t> extraIds(nCount);
+    for (size_t index = 0; index < nCount; ++index) {
+        const size_t nOrgIndex = orders[index];
+        ASSERT(nOrgIndex < nCount);
+        textOffsets[index] = m_textOffsets[nOrgIndex];
+        textLengths[index] = m_textLengths[nOrgIndex];
+        flags[index] = m_flags[nOrgIndex];
+        extraIds[index] = m_extraIds[nOrgIndex];
+    }
+    m_textOffsets.swap(textOffsets);
+    m_textLengths.swap(textLengths);
+    m_flags.swap(flags);
+    m_extraIds.swap(extraIds);
+    if (m_pTextIndex != nullptr) {
+        m_pTextIndex->OnReorder(orders);
+    }
+}
+
+bool ListCtrlColumnData::HasData(size_t itemIndex) const
+{
+    ASSERT(itemIndex < m_flags.size());
+    return (itemIndex < m_flags.size()) && (m_flags[itemIndex] & kFlagHasData);
+}
+
+bool ListCtrlColumnData::SetData(size_t itemIndex, const ListCtrlSubItemData2& data)
+{
+    ASSERT(itemIndex < m_flags.size());
+    if (itemIndex >= m_flags.size()) {
+        return false;
+    }
+    const bool bCheckChanged = IsChecked(itemIndex) != data.bChecked;
+    const DString::value_type* text = data.text.c_str();
+    SetText(itemIndex, text, StringUtil::StringLen(text));
+    uint8_t nFlags = kFlagHasData;
+    if (data.bShowCheckBox) {
+        nFlags |= kFlagShowCheckBox;
+    }
+    if (data.bChecked) {
+        nFlags |= kFlagChecked;
+    }
+    if (data.bEditable) {
+        nFlags |= kFlagEditable;
+    }
+    m_flags[itemIndex] = nFlags;
+
+    ExtraData extraData;
+    extraData.textColor = data.textColor;
+    extraData.bkColor = data.bkColor;
+    extraData.userDataN = data.userDataN;
+    extraData.userDataS = data.userDataS;
+    extraData.nImageId = data.nImageId;
+    extraData.nSortGroup = data.nSortGroup;
+    extraData.nTextFormat = data.nTextFormat;
+    if (!extraData.IsDefault()) {
+        GetExtraDataForWrite(itemIndex) = extraData;
+    }
+    else if (m_extraIds[itemIndex] != 0) {
+        m_extraDataList[m_extraIds[itemIndex] - 1] = extraData;
+        ReleaseDefaultExtraData(itemIndex);
+    }
+    return bCheckChanged;
+}
+
+bool ListCtrlColumnData::GetData(size_t itemIndex, ListCtrlSubItemData2& data) const
+{
+    data = ListCtrlSubItemData2();
+    if (!HasData(itemIndex)) {
+        return false;
+    }
+    data.text = GetText(itemIndex);
+    data.bShowCheckBox = IsShowCheckBox(itemIndex);
+    data.bChecked = IsChecked(itemIndex);
+    data.bEditable = IsEditable(itemIndex);
+    const ExtraData& extraData = GetExtraData(itemIndex);
+    data.textColor = extraData.textColor;
+    data.bkColor = extraData.bkColor;
+    data.userDataN = extraData.userDataN;
+    data.userDataS = extraData.userDataS;
+    data.nImageId = extraData.nImageId;
+    data.nSortGroup = extraData.nSortGroup;
+    data.nTextFormat = extraData.nTextFormat;
+    return true;
+}
+
+bool ListCtrlColumnData::SetText(size_t itemIndex, const DString::value_type* text, size_t nLength)
+{
+    ASSERT(itemIndex < m_flags.size());
+    if (itemIndex >= m_flags.size()) {
+        return false;
+    }
+    m_flags[itemIndex] |= kFlagHasData;
+    if (text == nullptr) {
+        nLength = 0;
+    }
+    const size_t nOldLength = m_textLengths[itemIndex];
+    const size_t nOldOffset = m_textOffsets[itemIndex];
+    if ((nOldLength == nLength) &&
+        ((nLength == 0) || (std::char_traits<DString::value_type>::compare(&m_textPool[nOldOffset], text, nLength) == 0))) {
+        return false;
+    }
+    if (nLength == 0) {
+        m_nTextGarbage += nOldLength + 1;
+        m_textOffsets[itemIndex] = 0;
+        m_textLengths[itemIndex] = 0;
+    }
+    else if ((nOldOffset != 0) && (nLength <= nOldLength)) {
+        //新文本不比原文本长，原位置覆盖
+        std::char_traits<DString::value_type>::copy(&m_textPool[nOldOffset], text, nLength);
+        m_textPool[nOldOffset + nLength] = _T('\0');
+        m_textLengths[itemIndex] = (uint32_t)nLength;
+        m_nTextGarbage += nOldLength - nLength;
+    }
+    else {
+        //追加到字符池的末尾
+        ASSERT(m_textPool.size() + nLength + 1 < UINT32_MAX);
+        if (m_textPool.size() + nLength + 1 >= UINT32_MAX) {
+            return false;
+        }
+        if (nOldOffset != 0) {
+            m_nTextGarbage += nOldLength + 1;
+        }
+        m_textOffsets[itemIndex] = (uint32_t)m_textPool.size();
+        m_textLengths[itemIndex] = (uint32_t)nLength;
+        m_textPool.insert(m_textPool.end(), text, text + nLength);
+        m_textPool.push_back(_T('\0'));
+    }
+    CompactTextPool();
+    if (m_pTextIndex != nullptr) {
+        m_pTextIndex->OnTextChanged(itemIndex, text, nLength);
+    }
+    return true;
+}
+
+const DString::value_type* ListCtrlColumnData::GetText(size_t itemIndex) const
+{
+    ASSERT(itemIndex < m_flags.size());
+    if (itemIndex >= m_flags.size()) {
+        return m_textPool.data();
+    }
+    return m_textPool.data() + m_textOffsets[itemIndex];
+}
+
+size_t ListCtrlColumnData::GetTextLength(size_t itemIndex) const
+{
+    ASSERT(itemIndex < m_flags.size());
+    return (itemIndex < m_flags.size()) ? m_textLengths[itemIndex] : 0;
+}
+
+bool ListCtrlColumnData::IsShowCheckBox(size_t itemIndex) const
+{
+    return (itemIndex < m_flags.size()) && (m_flags[itemIndex] & kFlagShowCheckBox);
+}
+
+bool ListCtrlColumnData::IsChecked(size_t itemIndex) const
+{
+    return (itemIndex < m_flags.size()) && (m_flags[itemIndex] & kFlagChecked);
+}
+
+bool ListCtrlColumnData::IsEditable(size_t itemIndex) const
+{
+    return (itemIndex < m_flags.size()) && (m_flags[itemIndex] & kFlagEditable);
+}
+
+bool ListCtrlColumnData::SetShowCheckBox(size_t itemIndex, bool bShowCheckBox)
+{
+    return SetFlag(itemIndex, kFlagShowCheckBox, bShowCheckBox);
+}
+
+bool ListCtrlColumnData::SetChecked(size_t itemIndex, bool bChecked)
+{
+    return SetFlag(itemIndex, kFlagChecked, bChecked);
+}
+
+bool ListCtrlColumnData::SetEditable(size_t itemIndex, bool bEditable)
+{
+    return SetFlag(itemIndex, kFlagEditable, bEditable);
+}
+
+bool ListCtrlColumnData::SetFlag(size_t itemIndex, uint8_t nFlag, bool bSet)
+{
+    ASSERT(itemIndex < m_flags.size());
+    if (itemIndex >= m_flags.size()) {
+        return false;
+    }
+    const uint8_t nOldFlags = m_flags[itemIndex];
+    uint8_t nNewFlags = nOldFlags | kFlagHasData;
+    if (bSet) {
+        nNewFlags |= nFlag;
+    }
+    else {
+        nNewFlags &= ~nFlag;
+    }
+    m_flags[itemIndex] = nNewFlags;
+    return (nOldFlags & nFlag) != (nNewFlags & nFlag);
+}
+
+const ListCtrlColumnData::ExtraData& ListCtrlColumnData::GetExtraData(size_t itemIndex) const
+{
+    static const ExtraData s_defaultExtraData;
+    ASSERT(itemIndex < m_extraIds.size());
+    if ((itemIndex >= m_extraIds.size()) || (m_extraIds[itemIndex] == 0)) {
+        return s_defaultExtraData;
+    }
+    return m_extraDataList[m_extraIds[itemIndex] - 1];
+}
+
+ListCtrlColumnData::ExtraData& ListCtrlColumnData::GetExtraDataForWrite(size_t itemIndex)
+{
+    ASSERT(itemIndex < m_extraIds.size());
+    m_flags[itemIndex] |= kFlagHasData;
+    uint32_t& nExtraId = m_extraIds[itemIndex];
+    if (nExtraId == 0) {
+        if (!m_freeExtraIds.empty()) {
+            nExtraId = m_freeExtraIds.back();
+            m_freeExtraIds.pop_back();
+        }
+        else {
+            m_extraDataList.push_back(ExtraData());
+            nExtraId = (uint32_t)m_extraDataList.size();
+        }
+    }
+    return m_extraDataList[nExtraId - 1];
+}
+
+void ListCtrlColumnData::ReleaseDefaultExtraData(size_t itemIndex)
+{
+    ASSERT(itemIndex < m_extraIds.size());
+    if ((itemIndex < m_extraIds.size()) && (m_extraIds[itemIndex] != 0)) {
+        if (m_extraDataList[m_extraIds[itemIndex] - 1].IsDefault()) {
+            m_freeExtraIds.push_back(m_extraIds[itemIndex]);
+            m_extraIds[itemIndex] = 0;
+        }
+    }
+}
+
+void ListCtrlColumnData::SetTextIndexEnabled(bool bEnabled)
+{
+    if (bEnabled) {
+        if (m_pTextIndex == nullptr) {
+            m_pTextIndex = std::make_unique<ListCtrlTextIndex>();
+            m_pTextIndex->Build(*this);
+        }
+    }
+    else {
+        m_pTextIndex.reset();
+    }
+}
+
+bool ListCtrlColumnData::IsTextIndexEnabled() const
+{
+    return m_pTextIndex != nullptr;
+}
+
+void ListCtrlColumnData::FindText(const DString& filterText, bool bMatchPrefix, std::vector<size_t>& itemIndexs)
+{
+    SetTextIndexEnabled(true);
+    m_pTextIndex->Find(*this, filterText, bMatchPrefix, itemIndexs);
+}
+
+void ListCtrlColumnData::ReleaseRow(size_t itemIndex)
+{
+    if (m_textOffsets[itemIndex] != 0) {
+        m_nTextGarbage += m_textLengths[itemIndex] + 1;
+        m_textOffsets[itemIndex] = 0;
+        m_textLengths[itemIndex] = 0;
+    }
+    const uint32_t nExtraId = m_extraIds[itemIndex];
+    if (nExtraId != 0) {
+        m_extraDataList[nExtraId - 1] = ExtraData();
+        m_freeExtraIds.push_back(nExtraId);
+        m_extraIds[itemIndex] = 0;
+    }
+    m_flags[itemIndex] = 0;
+}
+
+void ListCtrlColumnData::CompactTextPool()
+{
+    if ((m_nTextGarbage < kMinTextGarbage) || (m_nTextGarbage * 2 < m_textPool.size())) {
+        return;
+    }
+    std::vector<DString::value_type> textPool;
+    textPool.reserve(m_textPool.size() - m_nTextGarbage);
+    textPool.push_back(_T('\0'));
+    const size_t nCount = m_textOffsets.size();
+    for (size_t index = 0; index < nCount; ++index) {
+        if (m_textOffsets[index] == 0) {
+            continue;
+        }
+        const DString::value_type* text = m_textPool.data() + m_textOffsets[index];
+        m_textOffsets[index] = (uint32_t)textPool.size();
+        textPool.insert(textPool.end(), text, text + m_textLengths[index] + 1);
+    }
+    m_textPool.swap(textPool);
+    m_nTextGarbage = 0;
+}
+
+}//namespace ui
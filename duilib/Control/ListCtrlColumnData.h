@@ -0,0 +1,185 @@
+#ifndef UI_CONTROL_LIST_CTRL_COLUMN_DATA_H_
+#define UI_CONTROL_LIST_CTRL_COLUMN_DATA_H_
+
+#include "duilib/Control/ListCtrlDefs.h"
+#include "duilib/Control/ListCtrlTextIndex.h"
+#include <memory>
+
+namespace ui
+{
+/** 列表中一列数据的列式存储（每列一个对象，不为每个<行,列>单独分配内存）
+*   1. 文本：所有行的文本保存在一个连续的字符池中，每行只记录在字符池中的偏移和长度
+*   2. 标志（是否有数据、是否显示CheckBox、勾选状态、是否可编辑）：每行一个字节的紧凑数组
+*   3. 较少设置的属性（颜色、图标、文本属性、分组、用户数据）：保存在附加数据表中，每行只记录附加数据的编号，未设置时为0
+*   4. 文本过滤索引（可选）：启用后随数据的修改同步更新
+*/
+class ListCtrlColumnData
+{
+public:
+    /** 附加数据（较少设置的属性）
+    */
+    struct ExtraData
+    {
+        UiColor textColor;          //文本颜色
+        UiColor bkColor;            //背景颜色
+        uint64_t userDataN = 0;     //用户自定义数据(整型)
+        UiString userDataS;         //用户自定义数据(字符串类型)
+        int32_t nImageId = -1;      //图标资源Id，如果为-1表示不显示图标
+        int32_t nSortGroup = 0;     //所属分组
+        uint16_t nTextFormat = 0;   //文本对齐方式等属性，0表示使用默认值
+
+        /** 是否所有属性均为默认值
+        */
+        bool IsDefault() const;
+    };
+
+public:
+    ListCtrlColumnData();
+
+    /** 获取行数
+    */
+    size_t GetCount() const;
+
+    /** 设置行数（新增的行无数据）
+    */
+    void Resize(size_t nCount);
+
+    /** 在指定位置插入一个无数据的行
+    * @param [in] itemIndex 插入位置，有效范围：[0, GetCount()]
+    */
+    void Insert(size_t itemIndex);
+
+    /** 删除一行
+    * @param [in] itemIndex 数据项的索引号，有效范围：[0, GetCount())
+    */
+    void Erase(size_t itemIndex);
+
+    /** 清空所有行，并释放内存
+    */
+    void Clear();
+
+    /** 按新的顺序调整所有行
+    * @param [in] orders 新的顺序，第i行的数据为原来的第orders[i]行，orders的长度必须与行数相同
+    */
+    void Reorder(const std::vector<size_t>& orders);
+
+public:
+    /** 该行是否有数据（未设置过任何属性的行无数据）
+    */
+    bool HasData(size_t itemIndex) const;
+
+    /** 设置该行的全部数据
+    * @return 返回bChecked标志是否变化
+    */
+    bool SetData(size_t itemIndex, const ListCtrlSubItemData2& data);
+
+    /** 获取该行的全部数据
+    * @return 该行无数据时返回false
+    */
+    bool GetData(size_t itemIndex, ListCtrlSubItemData2& data) const;
+
+    /** 设置文本
+    * @return 文本有变化返回true，否则返回false
+    */
+    bool SetText(size_t itemIndex, const DString::value_type* text, size_t nLength);
+
+    /** 获取文本（以'\0'结尾，在下次修改该列数据之前有效）
+    */
+    const DString::value_type* GetText(size_t itemIndex) const;
+
+    /** 获取文本的长度
+    */
+    size_t GetTextLength(size_t itemIndex) const;
+
+    /** 是否显示CheckBox、勾选状态、是否可编辑
+    */
+    bool IsShowCheckBox(size_t itemIndex) const;
+    bool IsChecked(size_t itemIndex) const;
+    bool IsEditable(size_t itemIndex) const;
+
+    /** 设置是否显示CheckBox、勾选状态、是否可编辑
+    * @return 有变化返回true，否则返回false
+    */
+    bool SetShowCheckBox(size_t itemIndex, bool bShowCheckBox);
+    bool SetChecked(size_t itemIndex, bool bChecked);
+    bool SetEditable(size_t itemIndex, bool bEditable);
+
+    /** 获取附加数据（未设置时返回默认值）
+    */
+    const ExtraData& GetExtraData(size_t itemIndex) const;
+
+    /** 获取附加数据用于修改（未设置时分配一个新的附加数据）
+    */
+    ExtraData& GetExtraDataForWrite(size_t itemIndex);
+
+    /** 修改附加数据以后调用：如果所有属性均为默认值，释放该行的附加数据
+    */
+    void ReleaseDefaultExtraData(size_t itemIndex);
+
+public:
+    /** 启用或者关闭文本过滤索引（启用时根据现有数据建立索引，关闭时释放索引）
+    */
+    void SetTextIndexEnabled(bool bEnabled);
+
+    /** 是否启用了文本过滤索引
+    */
+    bool IsTextIndexEnabled() const;
+
+    /** 查找文本匹配的行（不区分大小写），未启用文本过滤索引时自动启用
+    * @param [in] filterText 查找的文本，为空时返回所有行
+    * @param [in] bMatchPrefix true表示文本以filterText开头，false表示文本中包含filterText
+    * @param [out] itemIndexs 返回匹配的行号，按行号升序排列
+    */
+    void FindText(const DString& filterText, bool bMatchPrefix, std::vector<size_t>& itemIndexs);
+
+private:
+    /** 设置标志位
+    */
+    bool SetFlag(size_t itemIndex, uint8_t nFlag, bool bSet);
+
+    /** 释放一行的文本和附加数据（不改变行数）
+    */
+    void ReleaseRow(size_t itemIndex);
+
+    /** 字符池中无用的字符过多时，重新整理字符池
+    */
+    void CompactTextPool();
+
+private:
+    /** 每行文本在字符池中的偏移和长度（不含结尾的'\0'）
+    */
+    std::vector<uint32_t> m_textOffsets;
+    std::vector<uint32_t> m_textLengths;
+
+    /** 字符池（每个文本以'\0'结尾）
+    */
+    std::vector<DString::value_type> m_textPool;
+
+    /** 字符池中不再使用的字符数
+    */
+    size_t m_nTextGarbage;
+
+    /** 每行的标志位
+    */
+    std::vector<uint8_t> m_flags;
+
+    /** 每行附加数据的编号（0表示无附加数据，其他值为m_extraDataList的下标+1）
+    */
+    std::vector<uint32_t> m_extraIds;
+
+    /** 附加数据表
+    */
+    std::vector<ExtraData> m_extraDataList;
+
+    /** 附加数据表中可重用的编号
+    */
+    std::vector<uint32_t> m_freeExtraIds;
+
+    /** 文本过滤索引（未启用时为nullptr）
+    */
+    std::unique_ptr<ListCtrlTextIndex> m_pTextIndex;
+};
+
+}//namespace ui
+
+#endif //UI_CONTROL_LIST_CTRL_COLUMN_DATA_H_
@@ -1,6 +1,7 @@
 #include "ListCtrlData.h"
 #include "duilib/Control/ListCtrl.h"
 #include "duilib/Core/GlobalManager.h"
+#include "duilib/Utils/ParallelSort.h"
 #include <set>
 #include <algorithm>
 
@@ -44,8 +45,9 @@ bool ListCtrlData::FillElement(Control* pControl, size_t nElementIndex)
         return false;
     }
     const ListCtrlItemData& itemData = m_rowDataList[nElementIndex];
+    std::vector<Storage> storageList;
     std::vector<ListCtrlSubItemData2Pair> subItemList;
-    if (!GetSubItemStorageList(nElementIndex, subItemList)) {
+    if (!GetSubItemStorageList(nElementIndex, storageList, subItemList)) {
         return false;
     }
 
@@ -60,15 +62,17 @@ bool ListCtrlData::FillElement(Control* pControl, size_t nElementIndex)
 int32_t ListCtrlData::GetMaxColumnWidth(size_t columnId) const
 {
     int32_t nMaxWidth = -1;
-    std::vector<ListCtrlSubItemData2Ptr> subItemList;
+    std::vector<Storage> subItemList;
     auto iter = m_dataMap.find(columnId);
     ASSERT(iter != m_dataMap.end());
     if (iter != m_dataMap.end()) {
-        const StoragePtrList& storageList = iter->second;
-        const size_t nCount = storageList.size();
+        //文本为空的数据项不影响列宽，不需要读取
+        const ListCtrlColumnData& columnData = iter->second;
+        const size_t nCount = columnData.GetCount();
         for (size_t index = 0; index < nCount; ++index) {
-            if (storageList[index] != nullptr) {
-                subItemList.push_back(storageList[index]);
+            if (columnData.HasData(index) && (columnData.GetTextLength(index) > 0)) {
+                subItemList.push_back(Storage());
+                columnData.GetData(index, subItemList.back());
             }
         }
     }
@@ -273,9 +277,9 @@ bool ListCtrlData::AddColumn(size_t columnId)
     if ((columnId == Box::InvalidIndex) || (columnId == 0)) {
         return false;
     }
-    StoragePtrList& storageList = m_dataMap[columnId];
+    ListCtrlColumnData& columnData = m_dataMap[columnId];
     //列的长度与行保持一致
-    storageList.resize(m_rowDataList.size());
+    columnData.Resize(m_rowDataList.size());
     EmitCountChanged();
     return true;
 }
@@ -305,13 +309,10 @@ bool ListCtrlData::SetColumnCheck(size_t columnId, bool bChecked, bool bRefresh)
     auto iter = m_dataMap.find(columnId);
     ASSERT(iter != m_dataMap.end());
     if (iter != m_dataMap.end()) {
-        StoragePtrList& storageList = iter->second;
-        const size_t nCount = storageList.size();
+        ListCtrlColumnData& columnData = iter->second;
+        const size_t nCount = columnData.GetCount();
         for (size_t index = 0; index < nCount; ++index) {
-            if (storageList[index] == nullptr) {
-                storageList[index] = std::make_shared<Storage>();
-            }
-            storageList[index]->bChecked = bChecked;
+            columnData.SetChecked(index, bChecked);
         }
         bRet = true;
     }
@@ -321,58 +322,53 @@ bool ListCtrlData::SetColumnCheck(size_t columnId, bool bChecked, bool bRefresh)
     return bRet;
 }
 
-ListCtrlData::StoragePtr ListCtrlData::GetSubItemStorage(
-    size_t itemIndex, size_t nColumnId) const
+const ListCtrlColumnData* ListCtrlData::GetColumnData(size_t itemIndex, size_t nColumnId) const
 {
-    StoragePtr pStorage;
     auto iter = m_dataMap.find(nColumnId);
     ASSERT(iter != m_dataMap.end());
-    if (iter != m_dataMap.end()) {
-        const StoragePtrList& storageList = iter->second;
-        ASSERT(itemIndex < storageList.size());
-        if (itemIndex < storageList.size()) {
-            //关联列：获取数据
-            pStorage = storageList[itemIndex];
-        }
+    if (iter == m_dataMap.end()) {
+        return nullptr;
+    }
+    ASSERT(itemIndex < iter->second.GetCount());
+    if (itemIndex >= iter->second.GetCount()) {
+        return nullptr;
     }
-    return pStorage;
+    return &iter->second;
 }
 
-ListCtrlData::StoragePtr ListCtrlData::GetSubItemStorageForWrite(
-    size_t itemIndex, size_t nColumnId)
+ListCtrlColumnData* ListCtrlData::GetColumnDataForWrite(size_t itemIndex, size_t nColumnId)
 {
-    StoragePtr pStorage;
     auto iter = m_dataMap.find(nColumnId);
     ASSERT(iter != m_dataMap.end());
-    if (iter != m_dataMap.end()) {
-        StoragePtrList& storageList = iter->second;
-        ASSERT(itemIndex < storageList.size());
-        if (itemIndex < storageList.size()) {
-            //关联列：获取数据
-            pStorage = storageList[itemIndex];
-            if (pStorage == nullptr) {
-                pStorage = std::make_shared<Storage>();
-                storageList[itemIndex] = pStorage;
-            }
-        }
+    if (iter == m_dataMap.end()) {
+        return nullptr;
     }
-    return pStorage;
+    ASSERT(itemIndex < iter->second.GetCount());
+    if (itemIndex >= iter->second.GetCount()) {
+        return nullptr;
+    }
+    return &iter->second;
 }
 
-bool ListCtrlData::GetSubItemStorageList(size_t itemIndex, std::vector<ListCtrlSubItemData2Pair>& subItemList) const
+bool ListCtrlData::GetSubItemStorageList(size_t itemIndex, std::vector<Storage>& storageList,
+                                         std::vector<ListCtrlSubItemData2Pair>& subItemList) const
 {
+    storageList.clear();
     subItemList.clear();
     ASSERT(itemIndex < m_rowDataList.size());
     if (itemIndex >= m_rowDataList.size()) {
         return false;
     }
+    //预先分配空间，保证subItemList中的指针有效
+    storageList.resize(m_dataMap.size());
+    size_t nStorageIndex = 0;
     ListCtrlSubItemData2Pair dataPair;
-    for (auto iter = m_dataMap.begin(); iter != m_dataMap.end(); ++iter) {
-        dataPair.nColumnId = iter->first;        
-        const StoragePtrList& dataList = iter->second;
-        ASSERT(itemIndex < dataList.size());
-        if (itemIndex < dataList.size()) {
-            dataPair.pSubItemData = dataList.at(itemIndex);
+    for (auto iter = m_dataMap.begin(); iter != m_dataMap.end(); ++iter, ++nStorageIndex) {
+        dataPair.nColumnId = iter->first;
+        const ListCtrlColumnData& columnData = iter->second;
+        ASSERT(itemIndex < columnData.GetCount());
+        if ((itemIndex < columnData.GetCount()) && columnData.GetData(itemIndex, storageList[nStorageIndex])) {
+            dataPair.pSubItemData = &storageList[nStorageIndex];
         }
         else {
             dataPair.pSubItemData = nullptr;
@@ -398,7 +394,7 @@ size_t ListCtrlData::GetDataItemCount() const
 #ifdef _DEBUG
     auto iter = m_dataMap.begin();
     for (; iter != m_dataMap.end(); ++iter) {
-        ASSERT(iter->second.size() == m_rowDataList.size());
+        ASSERT(iter->second.GetCount() == m_rowDataList.size());
     }
 #endif
     return m_rowDataList.size();
@@ -420,7 +416,7 @@ bool ListCtrlData::SetDataItemCount(size_t itemCount)
         m_nSelectedIndex = Box::InvalidIndex;
     }
     for (auto iter = m_dataMap.begin(); iter != m_dataMap.end(); ++iter) {
-        iter->second.resize(itemCount);
+        iter->second.Resize(itemCount);
     }
     if (itemCount < nOldCount) {
         //行数变少了
@@ -463,15 +459,13 @@ size_t ListCtrlData::AddDataItem(size_t columnId, const ListCtrlSubItemData& dat
     size_t nDataItemIndex = Box::InvalidIndex;
     for (auto iter = m_dataMap.begin(); iter != m_dataMap.end(); ++iter) {
         size_t id = iter->first;
-        StoragePtrList& storageList = iter->second;
+        ListCtrlColumnData& columnData = iter->second;
+        //所有列：插入空数据
+        columnData.Resize(columnData.GetCount() + 1);
         if (id == columnId) {
             //关联列：保存数据
-            storageList.push_back(std::make_shared<Storage>(storage));
-            nDataItemIndex = storageList.size() - 1;
-        }
-        else {
-            //其他列：插入空数据
-            storageList.push_back(nullptr);
+            nDataItemIndex = columnData.GetCount() - 1;
+            columnData.SetData(nDataItemIndex, storage);
         }
     }
 
@@ -498,14 +492,12 @@ bool ListCtrlData::InsertDataItem(size_t itemIndex, size_t columnId, const ListC
 
     for (auto iter = m_dataMap.begin(); iter != m_dataMap.end(); ++iter) {
         size_t id = iter->first;
-        StoragePtrList& storageList = iter->second;
+        ListCtrlColumnData& columnData = iter->second;
+        //所有列：插入空数据
+        columnData.Insert(itemIndex);
         if (id == columnId) {
             //关联列：保存数据
-            storageList.insert(storageList.begin() + itemIndex, std::make_shared<Storage>(storage));
-        }
-        else {
-            //其他列：插入空数据
-            storageList.insert(storageList.begin() + itemIndex, nullptr);
+            columnData.SetData(itemIndex, storage);
         }
     }
 
@@ -528,9 +520,9 @@ bool ListCtrlData::DeleteDataItem(size_t itemIndex)
     }
 
     for (auto iter = m_dataMap.begin(); iter != m_dataMap.end(); ++iter) {
-        StoragePtrList& storageList = iter->second;
-        if (itemIndex < storageList.size()) {
-            storageList.erase(storageList.begin() + itemIndex);
+        ListCtrlColumnData& columnData = iter->second;
+        if (itemIndex < columnData.GetCount()) {
+            columnData.Erase(itemIndex);
         }
     }
 
@@ -567,12 +559,11 @@ bool ListCtrlData::DeleteAllDataItems()
 {
     bool bDeleted = false;
     for (auto iter = m_dataMap.begin(); iter != m_dataMap.end(); ++iter) {
-        StoragePtrList& storageList = iter->second;
-        if (!storageList.empty()) {
+        ListCtrlColumnData& columnData = iter->second;
+        if (columnData.GetCount() > 0) {
             bDeleted = true;
         }
-        StoragePtrList emptyList;
-        storageList.swap(emptyList);
+        columnData.Clear();
     }
     //清空行数据
     if (!m_rowDataList.empty()) {
@@ -705,6 +696,56 @@ bool ListCtrlData::SetDataItemVisible(size_t itemIndex, bool bVisible, bool& bCh
     return bRet;
 }
 
+bool ListCtrlData::FilterDataItems(size_t columnId, const DString& filterText, bool bMatchPrefix,
+                                   std::vector<size_t>& visibleItemIndexs, bool& bChanged)
+{
+    visibleItemIndexs.clear();
+    bChanged = false;
+    auto iter = m_dataMap.find(columnId);
+    ASSERT(iter != m_dataMap.end());
+    if (iter == m_dataMap.end()) {
+        return false;
+    }
+    ListCtrlColumnData& columnData = iter->second;
+    ASSERT(columnData.GetCount() == m_rowDataList.size());
+    if (columnData.GetCount() != m_rowDataList.size()) {
+        return false;
+    }
+    columnData.FindText(filterText, bMatchPrefix, visibleItemIndexs);
+
+    //一次更新所有行的可见性
+    const size_t nCount = m_rowDataList.size();
+    size_t nNextVisible = 0;
+    for (size_t itemIndex = 0; itemIndex < nCount; ++itemIndex) {
+        bool bVisible = false;
+        if ((nNextVisible < visibleItemIndexs.size()) && (visibleItemIndexs[nNextVisible] == itemIndex)) {
+            bVisible = true;
+            ++nNextVisible;
+        }
+        ListCtrlItemData& rowData = m_rowDataList[itemIndex];
+        if (rowData.bVisible != bVisible) {
+            rowData.bVisible = bVisible;
+            bChanged = true;
+        }
+    }
+    m_hideRowCount = (int32_t)(nCount - visibleItemIndexs.size());
+    if (bChanged) {
+        EmitCountChanged();
+    }
+    return true;
+}
+
+bool ListCtrlData::SetColumnFilterIndex(size_t columnId, bool bEnable)
+{
+    auto iter = m_dataMap.find(columnId);
+    ASSERT(iter != m_dataMap.end());
+    if (iter == m_dataMap.end()) {
+        return false;
+    }
+    iter->second.SetTextIndexEnabled(bEnable);
+    return true;
+}
+
 bool ListCtrlData::IsDataItemVisible(size_t itemIndex) const
 {
     bool bValue = false;
@@ -919,10 +960,10 @@ void ListCtrlData::GetColumnCheckStatus(size_t columnId, bool& bChecked, bool& b
     if (iter == m_dataMap.end()) {
         return;
     }
-    const StoragePtrList& sortStorageList = iter->second;
+    const ListCtrlColumnData& columnData = iter->second;
     size_t nCheckCount = 0;
     size_t nUnCheckCount = 0;
-    const size_t nCount = sortStorageList.size();
+    const size_t nCount = columnData.GetCount();
     if (nCount == 0) {
         return;
     }
@@ -936,14 +977,10 @@ void ListCtrlData::GetColumnCheckStatus(size_t columnId, bool& bChecked, bool& b
         if (!rowData.bVisible) {
             continue;
         }
-        const StoragePtr& pStorage = sortStorageList[itemIndex];
-        if (pStorage == nullptr) {
-            continue;
-        }
-        if (!pStorage->bShowCheckBox) {
+        if (!columnData.IsShowCheckBox(itemIndex)) {
             continue;
         }
-        if (pStorage->bChecked) {
+        if (columnData.IsChecked(itemIndex)) {
             nCheckCount++;
         }
         else {
@@ -1108,28 +1145,11 @@ bool ListCtrlData::SetSubItemData(size_t itemIndex, size_t columnId,
     SubItemToStorage(subItemData, storage);
 
     bool bRet = false;
-    auto iter = m_dataMap.find(columnId);
-    ASSERT(iter != m_dataMap.end());
-    if (iter != m_dataMap.end()) {
+    ListCtrlColumnData* pColumnData = GetColumnDataForWrite(itemIndex, columnId);
+    if (pColumnData != nullptr) {
         //关联列：更新数据
-        StoragePtrList& storageList = iter->second;
-        ASSERT(itemIndex < storageList.size());
-        if (itemIndex < storageList.size()) {
-            StoragePtr pStorage = storageList[itemIndex];
-            if (pStorage == nullptr) {
-                storageList[itemIndex] = std::make_shared<Storage>(storage);
-                if (storage.bChecked) {
-                    bCheckChanged = true;
-                }
-            }
-            else {
-                if (storage.bChecked != pStorage->bChecked) {
-                    bCheckChanged = true;
-                }
-                *pStorage = storage;
-            }
-            bRet = true;
-        }
+        bCheckChanged = pColumnData->SetData(itemIndex, storage);
+        bRet = true;
     }
 
     if (bRet) {
@@ -1143,32 +1163,25 @@ bool ListCtrlData::GetSubItemData(size_t itemIndex, size_t columnId, ListCtrlSub
     subItemData = ListCtrlSubItemData();
 
     bool bRet = false;
-    auto iter = m_dataMap.find(columnId);
-    ASSERT(iter != m_dataMap.end());
-    if (iter != m_dataMap.end()) {
-        const StoragePtrList& storageList = iter->second;
-        ASSERT(itemIndex < storageList.size());
-        if (itemIndex < storageList.size()) {
-            StoragePtr pStorage = storageList[itemIndex];
-            if (pStorage != nullptr) {
-                StorageToSubItem(*pStorage, subItemData);
-            }
-            bRet = true;
+    const ListCtrlColumnData* pColumnData = GetColumnData(itemIndex, columnId);
+    if (pColumnData != nullptr) {
+        Storage storage;
+        if (pColumnData->GetData(itemIndex, storage)) {
+            StorageToSubItem(storage, subItemData);
         }
+        bRet = true;
     }
     return bRet;
 }
 
 bool ListCtrlData::SetSubItemText(size_t itemIndex, size_t columnId, const DString& text)
 {
-    StoragePtr pStorage = GetSubItemStorageForWrite(itemIndex, columnId);
-    ASSERT(pStorage != nullptr);
-    if (pStorage == nullptr) {
+    ListCtrlColumnData* pColumnData = GetColumnDataForWrite(itemIndex, columnId);
+    if (pColumnData == nullptr) {
         //索引号无效
         return false;
     }
-    if (pStorage->text != text) {
-        pStorage->text = text;
+    if (pColumnData->SetText(itemIndex, text.c_str(), text.size())) {
         EmitDataChanged(itemIndex, itemIndex);
     }    
     return true;
@@ -1176,25 +1189,24 @@ bool ListCtrlData::SetSubItemText(size_t itemIndex, size_t columnId, const DStri
 
 DString ListCtrlData::GetSubItemText(size_t itemIndex, size_t columnId) const
 {
-    StoragePtr pStorage = GetSubItemStorage(itemIndex, columnId);
-    ASSERT(pStorage != nullptr);
-    if (pStorage == nullptr) {
+    const ListCtrlColumnData* pColumnData = GetColumnData(itemIndex, columnId);
+    if (pColumnData == nullptr) {
         //索引号无效
         return DString();
     }
-    return pStorage->text.c_str();
+    return DString(pColumnData->GetText(itemIndex), pColumnData->GetTextLength(itemIndex));
 }
 
 bool ListCtrlData::SetSubItemSortGroup(size_t itemIndex, size_t columnId, int32_t nSortGroup)
 {
-    StoragePtr pStorage = GetSubItemStorageForWrite(itemIndex, columnId);
-    ASSERT(pStorage != nullptr);
-    if (pStorage == nullptr) {
+    ListCtrlColumnData* pColumnData = GetColumnDataForWrite(itemIndex, columnId);
+    if (pColumnData == nullptr) {
         //索引号无效
         return false;
     }
-    if (pStorage->nSortGroup != nSortGroup) {
-        pStorage->nSortGroup = nSortGroup;
+    if (pColumnData->GetExtraData(itemIndex).nSortGroup != nSortGroup) {
+        pColumnData->GetExtraDataForWrite(itemIndex).nSortGroup = nSortGroup;
+        pColumnData->ReleaseDefaultExtraData(itemIndex);
         EmitDataChanged(itemIndex, itemIndex);
     }
     return true;
@@ -1202,25 +1214,24 @@ bool ListCtrlData::SetSubItemSortGroup(size_t itemIndex, size_t columnId, int32_
 
 int32_t ListCtrlData::GetSubItemSortGroup(size_t itemIndex, size_t columnId) const
 {
-    StoragePtr pStorage = GetSubItemStorage(itemIndex, columnId);
-    ASSERT(pStorage != nullptr);
-    if (pStorage == nullptr) {
+    const ListCtrlColumnData* pColumnData = GetColumnData(itemIndex, columnId);
+    if (pColumnData == nullptr) {
         //索引号无效
         return 0;
     }
-    return pStorage->nSortGroup;
+    return pColumnData->GetExtraData(itemIndex).nSortGroup;
 }
 
 bool ListCtrlData::SetSubItemUserDataN(size_t itemIndex, size_t columnId, uint64_t userDataN)
 {
-    StoragePtr pStorage = GetSubItemStorageForWrite(itemIndex, columnId);
-    ASSERT(pStorage != nullptr);
-    if (pStorage == nullptr) {
+    ListCtrlColumnData* pColumnData = GetColumnDataForWrite(itemIndex, columnId);
+    if (pColumnData == nullptr) {
         //索引号无效
         return false;
     }
-    if (pStorage->userDataN != userDataN) {
-        pStorage->userDataN = userDataN;
+    if (pColumnData->GetExtraData(itemIndex).userDataN != userDataN) {
+        pColumnData->GetExtraDataForWrite(itemIndex).userDataN = userDataN;
+        pColumnData->ReleaseDefaultExtraData(itemIndex);
         EmitDataChanged(itemIndex, itemIndex);
     }
     return true;
@@ -1228,25 +1239,24 @@ bool ListCtrlData::SetSubItemUserDataN(size_t itemIndex, size_t columnId, uint64
 
 uint64_t ListCtrlData::GetSubItemUserDataN(size_t itemIndex, size_t columnId) const
 {
-    StoragePtr pStorage = GetSubItemStorage(itemIndex, columnId);
-    ASSERT(pStorage != nullptr);
-    if (pStorage == nullptr) {
+    const ListCtrlColumnData* pColumnData = GetColumnData(itemIndex, columnId);
+    if (pColumnData == nullptr) {
         //索引号无效
         return 0;
     }
-    return pStorage->userDataN;
+    return pColumnData->GetExtraData(itemIndex).userDataN;
 }
 
 bool ListCtrlData::SetSubItemUserDataS(size_t itemIndex, size_t columnId, const DString& userDataS)
 {
-    StoragePtr pStorage = GetSubItemStorageForWrite(itemIndex, columnId);
-    ASSERT(pStorage != nullptr);
-    if (pStorage == nullptr) {
+    ListCtrlColumnData* pColumnData = GetColumnDataForWrite(itemIndex, columnId);
+    if (pColumnData == nullptr) {
         //索引号无效
         return false;
     }
-    if (pStorage->userDataS != userDataS) {
-        pStorage->userDataS = userDataS;
+    if (pColumnData->GetExtraData(itemIndex).userDataS != userDataS) {
+        pColumnData->GetExtraDataForWrite(itemIndex).userDataS = userDataS;
+        pColumnData->ReleaseDefaultExtraData(itemIndex);
         EmitDataChanged(itemIndex, itemIndex);
     }
     return true;
@@ -1254,25 +1264,24 @@ bool ListCtrlData::SetSubItemUserDataS(size_t itemIndex, size_t columnId, const
 
 DString ListCtrlData::GetSubItemUserDataS(size_t itemIndex, size_t columnId) const
 {
-    StoragePtr pStorage = GetSubItemStorage(itemIndex, columnId);
-    ASSERT(pStorage != nullptr);
-    if (pStorage == nullptr) {
+    const ListCtrlColumnData* pColumnData = GetColumnData(itemIndex, columnId);
+    if (pColumnData == nullptr) {
         //索引号无效
         return DString();
     }
-    return pStorage->userDataS.c_str();
+    return pColumnData->GetExtraData(itemIndex).userDataS.c_str();
 }
 
 bool ListCtrlData::SetSubItemTextColor(size_t itemIndex, size_t columnId, const UiColor& textColor)
 {
-    StoragePtr pStorage = GetSubItemStorageForWrite(itemIndex, columnId);
-    ASSERT(pStorage != nullptr);
-    if (pStorage == nullptr) {
+    ListCtrlColumnData* pColumnData = GetColumnDataForWrite(itemIndex, columnId);
+    if (pColumnData == nullptr) {
         //索引号无效
         return false;
     }
-    if (pStorage->textColor != textColor) {
-        pStorage->textColor = textColor;
+    if (pColumnData->GetExtraData(itemIndex).textColor != textColor) {
+        pColumnData->GetExtraDataForWrite(itemIndex).textColor = textColor;
+        pColumnData->ReleaseDefaultExtraData(itemIndex);
         EmitDataChanged(itemIndex, itemIndex);
     }    
     return true;
@@ -1281,27 +1290,26 @@ bool ListCtrlData::SetSubItemTextColor(size_t itemIndex, size_t columnId, const
 bool ListCtrlData::GetSubItemTextColor(size_t itemIndex, size_t columnId, UiColor& textColor) const
 {
     textColor = UiColor();
-    StoragePtr pStorage = GetSubItemStorage(itemIndex, columnId);
-    ASSERT(pStorage != nullptr);
-    if (pStorage == nullptr) {
-        //索引号无效
+    const ListCtrlColumnData* pColumnData = GetColumnData(itemIndex, columnId);
+    if ((pColumnData == nullptr) || !pColumnData->HasData(itemIndex)) {
+        //索引号无效或者无数据
         return false;
     }
-    textColor = pStorage->textColor;
+    textColor = pColumnData->GetExtraData(itemIndex).textColor;
     return true;
 }
 
 bool ListCtrlData::SetSubItemTextFormat(size_t itemIndex, size_t columnId, int32_t nTextFormat)
 {
-    StoragePtr pStorage = GetSubItemStorageForWrite(itemIndex, columnId);
-    ASSERT(pStorage != nullptr);
-    if (pStorage == nullptr) {
+    ListCtrlColumnData* pColumnData = GetColumnDataForWrite(itemIndex, columnId);
+    if (pColumnData == nullptr) {
         //索引号无效
         return false;
     }
     int32_t nValidTextFormat = (int32_t)Label::GetValidTextStyle(nTextFormat);
-    if (pStorage->nTextFormat != nValidTextFormat) {
-        pStorage->nTextFormat = ui::TruncateToUInt16(nValidTextFormat);
+    if (pColumnData->GetExtraData(itemIndex).nTextFormat != nValidTextFormat) {
+        pColumnData->GetExtraDataForWrite(itemIndex).nTextFormat = ui::TruncateToUInt16(nValidTextFormat);
+        pColumnData->ReleaseDefaultExtraData(itemIndex);
         EmitDataChanged(itemIndex, itemIndex);
     }
     return true;
@@ -1310,10 +1318,9 @@ bool ListCtrlData::SetSubItemTextFormat(size_t itemIndex, size_t columnId, int32
 int32_t ListCtrlData::GetSubItemTextFormat(size_t itemIndex, size_t columnId) const
 {
     int32_t nTextFormat = 0;
-    StoragePtr pStorage = GetSubItemStorage(itemIndex, columnId);
-    ASSERT(pStorage != nullptr);
-    if (pStorage != nullptr) {
-        nTextFormat = pStorage->nTextFormat;
+    const ListCtrlColumnData* pColumnData = GetColumnData(itemIndex, columnId);
+    if ((pColumnData != nullptr) && pColumnData->HasData(itemIndex)) {
+        nTextFormat = pColumnData->GetExtraData(itemIndex).nTextFormat;
         if (nTextFormat <= 0) {
             nTextFormat = m_nDefaultTextStyle;
         }
@@ -1323,14 +1330,14 @@ int32_t ListCtrlData::GetSubItemTextFormat(size_t itemIndex, size_t columnId) co
 
 bool ListCtrlData::SetSubItemBkColor(size_t itemIndex, size_t columnId, const UiColor& bkColor)
 {
-    StoragePtr pStorage = GetSubItemStorageForWrite(itemIndex, columnId);
-    ASSERT(pStorage != nullptr);
-    if (pStorage == nullptr) {
+    ListCtrlColumnData* pColumnData = GetColumnDataForWrite(itemIndex, columnId);
+    if (pColumnData == nullptr) {
         //索引号无效
         return false;
     }
-    if (pStorage->bkColor != bkColor) {
-        pStorage->bkColor = bkColor;
+    if (pColumnData->GetExtraData(itemIndex).bkColor != bkColor) {
+        pColumnData->GetExtraDataForWrite(itemIndex).bkColor = bkColor;
+        pColumnData->ReleaseDefaultExtraData(itemIndex);
         EmitDataChanged(itemIndex, itemIndex);
     }    
     return true;
@@ -1339,37 +1346,33 @@ bool ListCtrlData::SetSubItemBkColor(size_t itemIndex, size_t columnId, const Ui
 bool ListCtrlData::GetSubItemBkColor(size_t itemIndex, size_t columnId, UiColor& bkColor) const
 {
     bkColor = UiColor();
-    StoragePtr pStorage = GetSubItemStorage(itemIndex, columnId);
-    ASSERT(pStorage != nullptr);
-    if (pStorage == nullptr) {
-        //索引号无效
+    const ListCtrlColumnData* pColumnData = GetColumnData(itemIndex, columnId);
+    if ((pColumnData == nullptr) || !pColumnData->HasData(itemIndex)) {
+        //索引号无效或者无数据
         return false;
     }
-    bkColor = pStorage->bkColor;
+    bkColor = pColumnData->GetExtraData(itemIndex).bkColor;
     return true;
 }
 
 bool ListCtrlData::IsSubItemShowCheckBox(size_t itemIndex, size_t columnId) const
 {
-    StoragePtr pStorage = GetSubItemStorage(itemIndex, columnId);
-    ASSERT(pStorage != nullptr);
-    if (pStorage == nullptr) {
+    const ListCtrlColumnData* pColumnData = GetColumnData(itemIndex, columnId);
+    if (pColumnData == nullptr) {
         //索引号无效
         return false;
     }
-    return pStorage->bShowCheckBox;
+    return pColumnData->IsShowCheckBox(itemIndex);
 }
 
 bool ListCtrlData::SetSubItemShowCheckBox(size_t itemIndex, size_t columnId, bool bShowCheckBox)
 {
-    StoragePtr pStorage = GetSubItemStorageForWrite(itemIndex, columnId);
-    ASSERT(pStorage != nullptr);
-    if (pStorage == nullptr) {
+    ListCtrlColumnData* pColumnData = GetColumnDataForWrite(itemIndex, columnId);
+    if (pColumnData == nullptr) {
         //索引号无效
         return false;
     }
-    if (pStorage->bShowCheckBox != bShowCheckBox) {
-        pStorage->bShowCheckBox = bShowCheckBox;
+    if (pColumnData->SetShowCheckBox(itemIndex, bShowCheckBox)) {
         EmitDataChanged(itemIndex, itemIndex);
     }    
     return true;
@@ -1377,16 +1380,14 @@ bool ListCtrlData::SetSubItemShowCheckBox(size_t itemIndex, size_t columnId, boo
 
 bool ListCtrlData::SetSubItemCheck(size_t itemIndex, size_t columnId, bool bChecked, bool bRefresh)
 {
-    StoragePtr pStorage = GetSubItemStorageForWrite(itemIndex, columnId);
-    ASSERT(pStorage != nullptr);
-    if (pStorage == nullptr) {
+    ListCtrlColumnData* pColumnData = GetColumnDataForWrite(itemIndex, columnId);
+    if (pColumnData == nullptr) {
         //索引号无效
         return false;
     }
-    ASSERT(pStorage->bShowCheckBox);
-    if (pStorage->bShowCheckBox) {
-        if (pStorage->bChecked != bChecked) {
-            pStorage->bChecked = bChecked;
+    ASSERT(pColumnData->IsShowCheckBox(itemIndex));
+    if (pColumnData->IsShowCheckBox(itemIndex)) {
+        if (pColumnData->SetChecked(itemIndex, bChecked)) {
             if (bRefresh) {
                 EmitDataChanged(itemIndex, itemIndex);
             }            
@@ -1399,15 +1400,14 @@ bool ListCtrlData::SetSubItemCheck(size_t itemIndex, size_t columnId, bool bChec
 bool ListCtrlData::GetSubItemCheck(size_t itemIndex, size_t columnId, bool& bChecked) const
 {
     bChecked = false;
-    StoragePtr pStorage = GetSubItemStorage(itemIndex, columnId);
-    ASSERT(pStorage != nullptr);
-    if (pStorage == nullptr) {
+    const ListCtrlColumnData* pColumnData = GetColumnData(itemIndex, columnId);
+    if (pColumnData == nullptr) {
         //索引号无效
         return false;
     }
-    ASSERT(pStorage->bShowCheckBox);
-    if (pStorage->bShowCheckBox) {
-        bChecked = pStorage->bChecked;
+    ASSERT(pColumnData->IsShowCheckBox(itemIndex));
+    if (pColumnData->IsShowCheckBox(itemIndex)) {
+        bChecked = pColumnData->IsChecked(itemIndex);
         return true;
     }
     return false;
@@ -1415,17 +1415,17 @@ bool ListCtrlData::GetSubItemCheck(size_t itemIndex, size_t columnId, bool& bChe
 
 bool ListCtrlData::SetSubItemImageId(size_t itemIndex, size_t columnId, int32_t imageId)
 {
-    StoragePtr pStorage = GetSubItemStorageForWrite(itemIndex, columnId);
-    ASSERT(pStorage != nullptr);
-    if (pStorage == nullptr) {
+    ListCtrlColumnData* pColumnData = GetColumnDataForWrite(itemIndex, columnId);
+    if (pColumnData == nullptr) {
         //索引号无效
         return false;
     }
     if (imageId < -1) {
         imageId = -1;
     }
-    if (pStorage->nImageId != imageId) {
-        pStorage->nImageId = imageId;
+    if (pColumnData->GetExtraData(itemIndex).nImageId != imageId) {
+        pColumnData->GetExtraDataForWrite(itemIndex).nImageId = imageId;
+        pColumnData->ReleaseDefaultExtraData(itemIndex);
         EmitDataChanged(itemIndex, itemIndex);
     }
     return true;
@@ -1434,24 +1434,21 @@ bool ListCtrlData::SetSubItemImageId(size_t itemIndex, size_t columnId, int32_t
 int32_t ListCtrlData::GetSubItemImageId(size_t itemIndex, size_t columnId) const
 {
     int32_t nImageId = -1;
-    StoragePtr pStorage = GetSubItemStorage(itemIndex, columnId);
-    ASSERT(pStorage != nullptr);
-    if (pStorage != nullptr) {
-        nImageId = pStorage->nImageId;
+    const ListCtrlColumnData* pColumnData = GetColumnData(itemIndex, columnId);
+    if (pColumnData != nullptr) {
+        nImageId = pColumnData->GetExtraData(itemIndex).nImageId;
     }
     return nImageId;
 }
 
 bool ListCtrlData::SetSubItemEditable(size_t itemIndex, size_t columnId, bool bEditable)
 {
-    StoragePtr pStorage = GetSubItemStorageForWrite(itemIndex, columnId);
-    ASSERT(pStorage != nullptr);
-    if (pStorage == nullptr) {
+    ListCtrlColumnData* pColumnData = GetColumnDataForWrite(itemIndex, columnId);
+    if (pColumnData == nullptr) {
         //索引号无效
         return false;
     }
-    if (pStorage->bEditable != bEditable) {
-        pStorage->bEditable = bEditable;
+    if (pColumnData->SetEditable(itemIndex, bEditable)) {
         EmitDataChanged(itemIndex, itemIndex);
     }
     return true;
@@ -1460,10 +1457,9 @@ bool ListCtrlData::SetSubItemEditable(size_t itemIndex, size_t columnId, bool bE
 bool ListCtrlData::IsSubItemEditable(size_t itemIndex, size_t columnId) const
 {
     bool bEditable = false;
-    StoragePtr pStorage = GetSubItemStorage(itemIndex, columnId);
-    ASSERT(pStorage != nullptr);
-    if (pStorage != nullptr) {
-        bEditable = pStorage->bEditable;
+    const ListCtrlColumnData* pColumnData = GetColumnData(itemIndex, columnId);
+    if (pColumnData != nullptr) {
+        bEditable = pColumnData->IsEditable(itemIndex);
     }
     return bEditable;
 }
@@ -1477,31 +1473,32 @@ bool ListCtrlData::SortDataItems(size_t nColumnId, size_t nColumnIndex,
     if (iter == m_dataMap.end()) {
         return false;
     }
-    StoragePtrList sortStorageList = iter->second;
-    if (sortStorageList.empty()) {
+    const ListCtrlColumnData& sortColumnData = iter->second;
+    const size_t dataCount = sortColumnData.GetCount();
+    if (dataCount == 0) {
         return false;
     }
     std::vector<StorageData> sortedDataList;
-    const size_t dataCount = sortStorageList.size();
+    sortedDataList.reserve(dataCount);
     for (size_t index = 0; index < dataCount; ++index) {
-        sortedDataList.push_back({index, sortStorageList[index] });
+        sortedDataList.push_back({ index });
     }    
-    SortStorageData(sortedDataList, nColumnId, nColumnIndex, bSortedUp, nSortFlag, pfnCompareFunc, pUserData);
+    SortStorageData(sortedDataList, sortColumnData, nColumnId, nColumnIndex, bSortedUp, nSortFlag, pfnCompareFunc, pUserData);
 
     //对原数据进行顺序调整
     const size_t sortedDataCount = sortedDataList.size();
-    StoragePtrList orgStorageList; //副本数据
+    std::vector<size_t> orders;
+    orders.reserve(sortedDataCount);
+    for (const StorageData& sortedData : sortedDataList) {
+        orders.push_back(sortedData.index);
+    }
     for (iter = m_dataMap.begin(); iter != m_dataMap.end(); ++iter) {
-        orgStorageList = iter->second; 
-        StoragePtrList& storageList = iter->second;   //修改目标
-        ASSERT(storageList.size() == sortedDataList.size());
-        if (storageList.size() != sortedDataList.size()) {
+        ListCtrlColumnData& columnData = iter->second;   //修改目标
+        ASSERT(columnData.GetCount() == sortedDataCount);
+        if (columnData.GetCount() != sortedDataCount) {
             return false;
         }
-        for (size_t index = 0; index < sortedDataCount; ++index) {
-            const StorageData& sortedData = sortedDataList[index];
-            storageList[index] = orgStorageList[sortedData.index]; //赋值原数据
-        }
+        columnData.Reorder(orders);
     }
 
     //对行数据进行排序
@@ -1521,7 +1518,44 @@ bool ListCtrlData::SortDataItems(size_t nColumnId, size_t nColumnIndex,
     return true;
 }
 
-bool ListCtrlData::SortStorageData(std::vector<StorageData>& dataList, size_t nColumnId, size_t nColumnIndex,
+/** 排序关键字：排序前每行提取一次，排序时不再读取列数据
+*/
+struct ListCtrlSortKey
+{
+    const DString::value_type* text = nullptr;  //排序用的文本（不区分大小写时，为转换为小写后的文本）
+    uint64_t nNumber = 0;                       //排序用的整型值
+    int32_t nGroup = 0;                         //所属分组
+    uint32_t nTextLength = 0;                   //文本长度
+    uint32_t nIndex = 0;                        //原来的数据索引号
+    bool bHasData = false;                      //是否有数据（无数据的行排在前面）
+};
+
+/** 排序关键字的比较函数：实现(a < b)的比较逻辑
+*/
+static bool CompareSortKey(const ListCtrlSortKey& a, const ListCtrlSortKey& b, bool bSortByGroup, bool bSortByNumber)
+{
+    if (a.bHasData != b.bHasData) {
+        return !a.bHasData;
+    }
+    if (!a.bHasData) {
+        return false;
+    }
+    if (bSortByGroup && (a.nGroup != b.nGroup)) {
+        return a.nGroup < b.nGroup;
+    }
+    if (bSortByNumber) {
+        return a.nNumber < b.nNumber;
+    }
+    const size_t nLength = std::min(a.nTextLength, b.nTextLength);
+    const int32_t nRet = std::char_traits<DString::value_type>::compare(a.text, b.text, nLength);
+    if (nRet != 0) {
+        return nRet < 0;
+    }
+    return a.nTextLength < b.nTextLength;
+}
+
+bool ListCtrlData::SortStorageData(std::vector<StorageData>& dataList, const ListCtrlColumnData& columnData,
+                                   size_t nColumnId, size_t nColumnIndex,
                                    bool bSortedUp, uint8_t nSortFlag,
                                    ListCtrlDataCompareFunc pfnCompareFunc, void* pUserData)
 {
@@ -1536,81 +1570,109 @@ bool ListCtrlData::SortStorageData(std::vector<StorageData>& dataList, size_t nC
     }
 
     if (pfnCompareFunc != nullptr) {
-        //使用自定义的比较函数排序
+        //使用自定义的比较函数排序：需要完整的数据，先读取每行的数据（无数据的行为nullptr）
+        //自定义的比较函数不保证线程安全，在当前线程排序
+        std::vector<Storage> storageList(columnData.GetCount());
+        std::vector<const Storage*> storagePtrList(columnData.GetCount(), nullptr);
+        for (size_t index = 0; index < storageList.size(); ++index) {
+            if (columnData.GetData(index, storageList[index])) {
+                storagePtrList[index] = &storageList[index];
+            }
+        }
         ListCtrlCompareParam param;
         param.nColumnId = nColumnId;
         param.nColumnIndex = nColumnIndex;
         param.nSortFlag = nSortFlag;
         param.pUserData = pUserData;
-        std::sort(dataList.begin(), dataList.end(), [this, pfnCompareFunc, &param](const StorageData& a, const StorageData& b) {
+        auto compareFunc = [pfnCompareFunc, &param, &storagePtrList](const StorageData& a, const StorageData& b) {
                 //实现(a < b)的比较逻辑
-                if (b.pStorage == nullptr) {
+                const Storage* pStorageA = storagePtrList[a.index];
+                const Storage* pStorageB = storagePtrList[b.index];
+                if (pStorageB == nullptr) {
                     return false;
                 }
-                if (a.pStorage == nullptr) {
+                if (pStorageA == nullptr) {
                     return true;
                 }
-                const Storage& storageA = *a.pStorage;
-                const Storage& storageB = *b.pStorage;
-                return pfnCompareFunc(storageA, storageB, param);
-            });
-    }
-    else {
-        //排序：升序，使用默认的排序函数
-        std::sort(dataList.begin(), dataList.end(), [this, nSortFlag](const StorageData& a, const StorageData& b) {
-                //实现(a < b)的比较逻辑
-                if (b.pStorage == nullptr) {
-                    return false;
-                }
-                if (a.pStorage == nullptr) {
-                    return true;
-                }
-                const Storage& storageA = *a.pStorage;
-                const Storage& storageB = *b.pStorage;
-                return SortDataCompareFunc(storageA, storageB, nSortFlag);
-            });
-    }
-    if (!bSortedUp) {
-        //降序
-        std::reverse(dataList.begin(), dataList.end());
+                return pfnCompareFunc(*pStorageA, *pStorageB, param);
+            };
+        if (bSortedUp) {
+            std::stable_sort(dataList.begin(), dataList.end(), compareFunc);
+        }
+        else {
+            //降序：交换比较参数，相等的数据保持原来的顺序
+            std::stable_sort(dataList.begin(), dataList.end(), [&compareFunc](const StorageData& a, const StorageData& b) {
+                    return compareFunc(b, a);
+                });
+        }
+        return true;
     }
-    return true;
-}
 
-bool ListCtrlData::SortDataCompareFunc(const ListCtrlSubItemData2& a, const ListCtrlSubItemData2& b, uint8_t nSortFlag) const
-{
-    if (nSortFlag & ListCtrlSubItemSortFlag::kSortByGroup) {
-        //支持分组排序
-        if (a.nSortGroup != b.nSortGroup) {
-            return a.nSortGroup < b.nSortGroup;
+    //使用默认的排序方法：每行提取一次排序关键字，然后多线程排序关键字
+    const bool bSortByGroup = (nSortFlag & ListCtrlSubItemSortFlag::kSortByGroup) != 0;
+    const bool bSortByNumber = (nSortFlag & ListCtrlSubItemSortFlag::kSortByUserDataN) != 0;
+    const bool bSortByUserDataS = !bSortByNumber && ((nSortFlag & ListCtrlSubItemSortFlag::kSortByUserDataS) != 0);
+    const bool bNoCase = (nSortFlag & ListCtrlSubItemSortFlag::kSortNoCase) != 0;
+
+    const size_t nCount = dataList.size();
+    std::vector<ListCtrlSortKey> sortKeys(nCount);
+    size_t nTotalTextLength = 0;
+    for (size_t i = 0; i < nCount; ++i) {
+        const size_t index = dataList[i].index;
+        ListCtrlSortKey& sortKey = sortKeys[i];
+        sortKey.nIndex = (uint32_t)index;
+        sortKey.bHasData = columnData.HasData(index);
+        if (!sortKey.bHasData) {
+            continue;
         }
-    }
-    if (nSortFlag & ListCtrlSubItemSortFlag::kSortByUserDataN) {
-        //按 .userDataN 字段排序(整型值)
-        return a.userDataN < b.userDataN;
-    }
-    else if (nSortFlag & ListCtrlSubItemSortFlag::kSortByUserDataS) {
-        //按 .userDataS 字段排序(字符串值)
-        if (nSortFlag & ListCtrlSubItemSortFlag::kSortNoCase) {
-            //不区分大小写
-            return StringUtil::StringICompare(a.userDataS.c_str(), b.userDataS.c_str()) < 0;
+        const ListCtrlColumnData::ExtraData& extraData = columnData.GetExtraData(index);
+        sortKey.nGroup = extraData.nSortGroup;
+        if (bSortByNumber) {
+            sortKey.nNumber = extraData.userDataN;
+        }
+        else if (bSortByUserDataS) {
+            sortKey.text = extraData.userDataS.c_str();
+            sortKey.nTextLength = (uint32_t)StringUtil::StringLen(sortKey.text);
         }
         else {
-            //区分大小写
-            return StringUtil::StringCompare(a.userDataS.c_str(), b.userDataS.c_str()) < 0;
+            sortKey.text = columnData.GetText(index);
+            sortKey.nTextLength = (uint32_t)StringUtil::StringLen(sortKey.text);
         }
+        nTotalTextLength += sortKey.nTextLength;
     }
-    else {
-        //按 .text 字段排序(字符串值)
-        if (nSortFlag & ListCtrlSubItemSortFlag::kSortNoCase) {
-            //不区分大小写
-            return StringUtil::StringICompare(a.text.c_str(), b.text.c_str()) < 0;
-        }
-        else {
-            //区分大小写
-            return StringUtil::StringCompare(a.text.c_str(), b.text.c_str()) < 0;
+
+    //不区分大小写时，预先生成转换为小写后的文本，排序时直接比较
+    std::vector<DString::value_type> foldedTexts;
+    if (!bSortByNumber && bNoCase) {
+        foldedTexts.resize(nTotalTextLength + 1);
+        DString::value_type* pFolded = foldedTexts.data();
+        for (ListCtrlSortKey& sortKey : sortKeys) {
+            if (sortKey.text == nullptr) {
+                continue;
+            }
+            for (uint32_t nPos = 0; nPos < sortKey.nTextLength; ++nPos) {
+                pFolded[nPos] = ListCtrlTextIndex::FoldChar(sortKey.text[nPos]);
+            }
+            sortKey.text = pFolded;
+            pFolded += sortKey.nTextLength;
         }
     }
+
+    if (bSortedUp) {
+        ParallelSort::StableSort(sortKeys, [bSortByGroup, bSortByNumber](const ListCtrlSortKey& a, const ListCtrlSortKey& b) {
+                return CompareSortKey(a, b, bSortByGroup, bSortByNumber);
+            });
+    }
+    else {
+        //降序：交换比较参数，相等的数据保持原来的顺序
+        ParallelSort::StableSort(sortKeys, [bSortByGroup, bSortByNumber](const ListCtrlSortKey& a, const ListCtrlSortKey& b) {
+                return CompareSortKey(b, a, bSortByGroup, bSortByNumber);
+            });
+    }
+    for (size_t i = 0; i < nCount; ++i) {
+        dataList[i].index = sortKeys[i].nIndex;
+    }
+    return true;
 }
 
 void ListCtrlData::SetSortCompareFunction(ListCtrlDataCompareFunc pfnCompareFunc, void* pUserData)
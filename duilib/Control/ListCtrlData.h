@@ -3,6 +3,7 @@
 
 #include "duilib/Box/VirtualListBox.h"
 #include "duilib/Control/ListCtrlDefs.h"
+#include "duilib/Control/ListCtrlColumnData.h"
 #include <unordered_map>
 
 namespace ui
@@ -16,9 +17,7 @@ class ListCtrlData : public ui::VirtualListBoxElement
 public:
     //用于存储的数据结构
     typedef ListCtrlSubItemData2 Storage;
-    typedef std::shared_ptr<Storage> StoragePtr;
-    typedef std::vector<StoragePtr> StoragePtrList;
-    typedef std::unordered_map<size_t, StoragePtrList> StorageMap;
+    typedef std::unordered_map<size_t, ListCtrlColumnData> StorageMap;
     typedef std::vector<ListCtrlItemData> RowDataList;
 
 public:
@@ -178,6 +177,22 @@ public:
     */
     bool IsDataItemVisible(size_t itemIndex) const;
 
+    /** 按文本过滤数据项（不区分大小写）：匹配的行设置为可见，其他行设置为隐藏，只刷新一次
+    * @param [in] columnId 列的ID
+    * @param [in] filterText 过滤的文本，为空时显示所有行
+    * @param [in] bMatchPrefix true表示文本以filterText开头，false表示文本中包含filterText
+    * @param [out] visibleItemIndexs 返回可见的数据项索引号，按升序排列
+    * @param [out] bChanged 返回是否有数据项的可见性变化
+    */
+    bool FilterDataItems(size_t columnId, const DString& filterText, bool bMatchPrefix,
+                         std::vector<size_t>& visibleItemIndexs, bool& bChanged);
+
+    /** 启用或者关闭列的文本过滤索引（首次过滤时会自动启用；关闭后释放索引占用的内存）
+    * @param [in] columnId 列的ID
+    * @param [in] bEnable true表示启用，false表示关闭
+    */
+    bool SetColumnFilterIndex(size_t columnId, bool bEnable);
+
     /** 设置数据项的选择属性, 并刷新界面显示
     * @param [in] itemIndex 数据项的索引号, 有效范围：[0, GetDataItemCount())
     * @param [in] bSelected 是否选择状态
@@ -536,25 +551,27 @@ private:
     */
     bool IsValidDataColumnId(size_t nColumnId) const;
 
-    /** 获取指定数据项的数据, 读取
+    /** 获取指定数据项所在列的数据, 读取
     * @param [in] itemIndex 数据项的索引号, 有效范围：[0, GetDataItemCount())
     * @param [in] columnId 列的ID
-    * @return 如果失败则返回nullptr
+    * @return 如果列ID或者索引号无效则返回nullptr
     */
-    StoragePtr GetSubItemStorage(size_t itemIndex, size_t nColumnId) const;
+    const ListCtrlColumnData* GetColumnData(size_t itemIndex, size_t nColumnId) const;
 
-    /** 获取指定数据项的数据, 写入
+    /** 获取指定数据项所在列的数据, 写入
     * @param [in] itemIndex 数据项的索引号, 有效范围：[0, GetDataItemCount())
     * @param [in] columnId 列的ID
-    * @return 如果失败则返回nullptr
+    * @return 如果列ID或者索引号无效则返回nullptr
     */
-    StoragePtr GetSubItemStorageForWrite(size_t itemIndex, size_t nColumnId);
+    ListCtrlColumnData* GetColumnDataForWrite(size_t itemIndex, size_t nColumnId);
 
     /** 获取各个列的数据，用于UI展示
     * @param [in] itemIndex 数据项的索引号, 有效范围：[0, GetDataItemCount())
+    * @param [out] storageList 各个列数据的副本，subItemList中的数据指针指向该列表中的元素
     * @param [out] subItemList 返回改行所有列的数据列表
     */
-    bool GetSubItemStorageList(size_t itemIndex, std::vector<ListCtrlSubItemData2Pair>& subItemList) const;
+    bool GetSubItemStorageList(size_t itemIndex, std::vector<Storage>& storageList,
+                               std::vector<ListCtrlSubItemData2Pair>& subItemList) const;
 
 public:
     /** 获取行属性数据
@@ -571,11 +588,11 @@ private:
     struct StorageData
     {
         size_t index;       //原来的数据索引号
-        StoragePtr pStorage;
     };
 
-    /** 对数据排序
+    /** 对数据排序（稳定排序）：使用默认的比较方法时，每行预先提取一次排序关键字，数据量大时使用多线程排序
     * @param [in] dataList 待排序的数据
+    * @param [in] columnData 排序列的数据
     * @param [in] nColumnId 列的ID
     * @param [in] nColumnIndex 列的序号
     * @param [in] bSortedUp true表示升序，false表示降序
@@ -583,18 +600,11 @@ private:
     * @param [in] pfnCompareFunc 数据比较函数
     * @param [in] pUserData 用户自定义数据，调用比较函数的时候，通过参数传回给比较函数
     */
-    bool SortStorageData(std::vector<StorageData>& dataList, size_t nColumnId, size_t nColumnIndex,
+    bool SortStorageData(std::vector<StorageData>& dataList, const ListCtrlColumnData& columnData,
+                         size_t nColumnId, size_t nColumnIndex,
                          bool bSortedUp, uint8_t nSortFlag,
                          ListCtrlDataCompareFunc pfnCompareFunc, void* pUserData);
 
-    /** 默认的数据比较函数
-    * @param [in] a 第一个比较数据
-    * @param [in] b 第二个比较数据
-    * @param [in] nSortFlag 排序方法标志位，参见 ListCtrlSubItemSortFlag 的枚举值
-    * @return 如果 (a < b)，返回true，否则返回false
-    */
-    bool SortDataCompareFunc(const ListCtrlSubItemData2& a, const ListCtrlSubItemData2& b, uint8_t nSortFlag) const;
-
     /** 更新个性化数据（隐藏行、行高、置顶等）
     */
     void UpdateNormalMode();
@@ -608,7 +618,7 @@ private:
     */
     bool m_bAutoCheckSelect;
 
-    /** 数据，按列保存，每个列一个数组
+    /** 数据，按列保存，每个列的数据连续存储（参见ListCtrlColumnData）
     */
     StorageMap m_dataMap;
 
@@ -207,7 +207,7 @@ bool ListCtrlIconView::FillDataItem(Control* pControl,
     if ((pControl == nullptr) || (m_pListCtrl == nullptr)) {
         return false;
     }
-    ListCtrlSubItemData2Ptr pSubItemData;
+    const ListCtrlSubItemData2* pSubItemData = nullptr;
     int32_t nImageId = -1;
     size_t nColumnId = m_pListCtrl->GetColumnId(0); //取第一列的ID
     for (const ListCtrlSubItemData2Pair& pair : subItemList) {
@@ -298,7 +298,7 @@ bool ListCtrlIconView::FillDataItem(Control* pControl,
     return true;
 }
 
-int32_t ListCtrlIconView::GetMaxDataItemWidth(const std::vector<ListCtrlSubItemData2Ptr>& /*subItemList*/)
+int32_t ListCtrlIconView::GetMaxDataItemWidth(const std::vector<ListCtrlSubItemData2>& /*subItemList*/)
 {
     //不需要实现
     return -1;
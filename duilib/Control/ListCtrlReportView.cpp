@@ -902,7 +902,7 @@ bool ListCtrlReportView::FillDataItem(Control* pControl,
 
     // 详细的结构说明，参见：ListCtrlItem.h
 
-    std::map<size_t, ListCtrlSubItemData2Ptr> subItemDataMap;
+    std::map<size_t, const ListCtrlSubItemData2*> subItemDataMap;
     for (const ListCtrlSubItemData2Pair& dataPair : subItemList) {
         subItemDataMap[dataPair.nColumnId] = dataPair.pSubItemData;
     }
@@ -913,7 +913,7 @@ bool ListCtrlReportView::FillDataItem(Control* pControl,
         size_t nColumnIndex = Box::InvalidIndex;
         size_t nColumnId = Box::InvalidIndex;
         int32_t nColumnWidth = 0;
-        ListCtrlSubItemData2Ptr pStorage;
+        const ListCtrlSubItemData2* pStorage = nullptr;
     };
     std::vector<ElementData> elementDataList;
     const size_t nColumnCount = pHeaderCtrl->GetColumnCount();
@@ -1037,7 +1037,7 @@ bool ListCtrlReportView::FillDataItem(Control* pControl,
 
         //填充数据，设置属性        
         pSubItem->SetFixedWidth(UiFixedInt(elementData.nColumnWidth), true, false);
-        const ListCtrlSubItemData2Ptr& pStorage = elementData.pStorage;
+        const ListCtrlSubItemData2* pStorage = elementData.pStorage;
         if (pStorage != nullptr) {
             pSubItem->SetText(pStorage->text.c_str());
             if (pStorage->nTextFormat != 0) {
@@ -1120,7 +1120,7 @@ bool ListCtrlReportView::FillDataItem(Control* pControl,
     return true;
 }
 
-int32_t ListCtrlReportView::GetMaxDataItemWidth(const std::vector<ListCtrlSubItemData2Ptr>& subItemList)
+int32_t ListCtrlReportView::GetMaxDataItemWidth(const std::vector<ListCtrlSubItemData2>& subItemList)
 {
     int32_t nMaxWidth = -1;
     if (m_pListCtrl == nullptr) {
@@ -1141,24 +1141,21 @@ int32_t ListCtrlReportView::GetMaxDataItemWidth(const std::vector<ListCtrlSubIte
     subItem.SetClass(defaultSubItemClass);
     subItem.SetListCtrlItem(&defaultItem);
 
-    for (const ListCtrlSubItemData2Ptr& pStorage : subItemList) {
-        if (pStorage == nullptr) {
-            continue;
-        }
-        if (pStorage->text.empty()) {
+    for (const ListCtrlSubItemData2& storage : subItemList) {
+        if (storage.text.empty()) {
             continue;
         }
 
-        subItem.SetText(pStorage->text.c_str());
-        if (pStorage->nTextFormat != 0) {
-            subItem.SetTextStyle(pStorage->nTextFormat, false);
+        subItem.SetText(storage.text.c_str());
+        if (storage.nTextFormat != 0) {
+            subItem.SetTextStyle(storage.nTextFormat, false);
         }
         else {
             subItem.SetTextStyle(defaultSubItem.GetTextStyle(), false);
         }
         subItem.SetTextPadding(defaultSubItem.GetTextPadding(), false);
-        subItem.SetShowCheckBox(pStorage->bShowCheckBox);
-        subItem.SetImageId(pStorage->nImageId);
+        subItem.SetShowCheckBox(storage.bShowCheckBox);
+        subItem.SetImageId(storage.nImageId);
         subItem.SetFixedWidth(UiFixedInt::MakeAuto(), false, false);
         subItem.SetFixedHeight(UiFixedInt::MakeAuto(), false, false);
         subItem.SetReEstimateSize(true);
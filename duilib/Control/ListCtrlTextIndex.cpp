@@ -0,0 +1,539 @@
+#include "ListCtrlTextIndex.h"
+#include "duilib/Control/ListCtrlColumnData.h"
+#include <algorithm>
+#include <cwctype>
+#include <string>
+#include <type_traits>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    #include <xmmintrin.h>
+#endif
+
+namespace ui
+{
+//无效的行号
+static const uint32_t kInvalidRowIndex = UINT32_MAX;
+
+//桶的数量：前16384个桶对应两个字符都是ASCII字符的二元组（一一对应），其余的桶按哈希值映射
+static const uint32_t kBucketCount = 65536;
+static const uint32_t kExactBucketCount = 128 * 128;
+
+//索引中无效的记录数超过该值，并且超过有效记录数时，重建索引
+static const size_t kMinStaleCount = 64 * 1024;
+
+//桶中记录的二元组信息：低15位是二元组在行文本中第一次出现的位置（超过32766时为kUnknownGramPos），
+//最高位表示二元组在行文本中出现了多次
+static const uint16_t kUnknownGramPos = 0x7FFF;
+static const uint16_t kRepeatedGramFlag = 0x8000;
+
+//逐个校验文本（查找文本的位置未知）的耗时，大约是扫描一个桶中记录的倍数（用于选择查找方式）
+static const size_t kVerifyCost = 8;
+
+//查找结果分块写入缓冲区的行数
+static const size_t kResultBlockSize = 1024;
+
+//比较文本时，提前读取后面第几个候选行的文本
+static const size_t kPrefetchDistance = 16;
+
+typedef std::make_unsigned<DString::value_type>::type UChar;
+typedef std::char_traits<DString::value_type> CharTraits;
+
+/** 二元组对应的桶
+*/
+static inline uint32_t GetGramBucket(DString::value_type a, DString::value_type b)
+{
+    const uint32_t ua = (uint32_t)(UChar)a;
+    const uint32_t ub = (uint32_t)(UChar)b;
+    if ((ua < 0x80) && (ub < 0x80)) {
+        return (ua << 7) | ub;
+    }
+    const uint32_t nHash = (ua * 0x9E3779B1u) ^ (ub * 0x85EBCA77u);
+    return kExactBucketCount + (nHash >> 16) % (kBucketCount - kExactBucketCount);
+}
+
+/** 字符在字符集合中对应的位：ASCII可见字符一一对应（0~95），其他字符按哈希值映射（96~127）
+*/
+static inline uint32_t GetCharBit(DString::value_type ch)
+{
+    const uint32_t uch = (uint32_t)(UChar)ch;
+    if ((uch >= 0x20) && (uch < 0x80)) {
+        return uch - 0x20;
+    }
+    return 96 + ((uch * 0x9E3779B1u) >> 27);
+}
+
+/** 字符是否与字符集合中的位一一对应
+*/
+static inline bool IsExactCharBit(DString::value_type ch)
+{
+    const uint32_t uch = (uint32_t)(UChar)ch;
+    return (uch >= 0x20) && (uch < 0x80);
+}
+
+/** 提前读取文本到CPU缓存（候选行的文本分散在文本池中，逐行读取时需要等待内存）
+*/
+static inline void PrefetchText(const DString::value_type* pText)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(pText);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_prefetch((const char*)pText, _MM_HINT_T0);
+#else
+    (void)pText;
+#endif
+}
+
+ListCtrlTextIndex::ListCtrlTextIndex():
+    m_bRowIndexsDirty(false),
+    m_nFoldedGarbage(0),
+    m_nPostingCount(0),
+    m_nLivePostingCount(0),
+    m_bLastMatchPrefix(false),
+    m_bLastResultValid(false)
+{
+}
+
+DString::value_type ListCtrlTextIndex::FoldChar(DString::value_type ch)
+{
+    if ((ch >= _T('A')) && (ch <= _T('Z'))) {
+        return (DString::value_type)(ch + (_T('a') - _T('A')));
+    }
+#ifdef DUILIB_UNICODE
+    if (ch >= 0x80) {
+        return (DString::value_type)::towlower((wint_t)ch);
+    }
+#endif
+    return ch;
+}
+
+void ListCtrlTextIndex::Build(const ListCtrlColumnData& columnData)
+{
+    const size_t nCount = columnData.GetCount();
+    m_rowIds.resize(nCount);
+    m_rowIndexs.resize(nCount);
+    for (size_t index = 0; index < nCount; ++index) {
+        m_rowIds[index] = (uint32_t)index;
+        m_rowIndexs[index] = (uint32_t)index;
+    }
+    m_bRowIndexsDirty = false;
+    m_freeRowIds.clear();
+    m_foldedOffsets.assign(nCount, 0);
+    m_foldedLengths.assign(nCount, 0);
+    m_foldedPool.clear();
+    m_nFoldedGarbage = 0;
+    m_textChanged.assign(nCount, 0);
+    m_gramCounts.assign(nCount, 0);
+    m_charMasks.assign(nCount * 2, 0);
+    m_buckets.clear();
+    m_buckets.resize(kBucketCount);
+    m_nPostingCount = 0;
+    m_nLivePostingCount = 0;
+
+    size_t nTotalLength = 0;
+    for (size_t index = 0; index < nCount; ++index) {
+        nTotalLength += columnData.GetTextLength(index);
+    }
+    m_foldedPool.reserve(nTotalLength);
+    for (size_t index = 0; index < nCount; ++index) {
+        AddText((uint32_t)index, columnData.GetText(index), columnData.GetTextLength(index));
+    }
+    ResetLastResult();
+}
+
+void ListCtrlTextIndex::OnResize(size_t nCount)
+{
+    while (m_rowIds.size() > nCount) {
+        FreeRowId(m_rowIds.back());
+        m_rowIds.pop_back();
+    }
+    while (m_rowIds.size() < nCount) {
+        m_rowIds.push_back(AllocRowId());
+    }
+    m_bRowIndexsDirty = true;
+    ResetLastResult();
+}
+
+void ListCtrlTextIndex::OnInsert(size_t itemIndex)
+{
+    ASSERT(itemIndex <= m_rowIds.size());
+    itemIndex = std::min(itemIndex, m_rowIds.size());
+    m_rowIds.insert(m_rowIds.begin() + itemIndex, AllocRowId());
+    m_bRowIndexsDirty = true;
+    ResetLastResult();
+}
+
+void ListCtrlTextIndex::OnErase(size_t itemIndex)
+{
+    ASSERT(itemIndex < m_rowIds.size());
+    if (itemIndex >= m_rowIds.size()) {
+        return;
+    }
+    FreeRowId(m_rowIds[itemIndex]);
+    m_rowIds.erase(m_rowIds.begin() + itemIndex);
+    m_bRowIndexsDirty = true;
+    ResetLastResult();
+}
+
+void ListCtrlTextIndex::OnReorder(const std::vector<size_t>& orders)
+{
+    ASSERT(orders.size() == m_rowIds.size());
+    if (orders.size() != m_rowIds.size()) {
+        return;
+    }
+    std::vector<uint32_t> rowIds(orders.size());
+    for (size_t index = 0; index < orders.size(); ++index) {
+        rowIds[index] = m_rowIds[orders[index]];
+    }
+    m_rowIds.swap(rowIds);
+    m_bRowIndexsDirty = true;
+    ResetLastResult();
+}
+
+void ListCtrlTextIndex::OnTextChanged(size_t itemIndex, const DString::value_type* text, size_t nLength)
+{
+    ASSERT(itemIndex < m_rowIds.size());
+    if (itemIndex >= m_rowIds.size()) {
+        return;
+    }
+    //旧文本的二元组保留在索引中，查询时校验文本
+    const uint32_t nRowId = m_rowIds[itemIndex];
+    m_nLivePostingCount -= m_gramCounts[nRowId];
+    m_gramCounts[nRowId] = 0;
+    m_nFoldedGarbage += m_foldedLengths[nRowId];
+    m_foldedLengths[nRowId] = 0;
+    m_charMasks[nRowId * 2] = 0;
+    m_charMasks[nRowId * 2 + 1] = 0;
+    m_textChanged[nRowId] = 1;
+    AddText(nRowId, text, nLength);
+    ResetLastResult();
+}
+
+uint32_t ListCtrlTextIndex::AllocRowId()
+{
+    if (!m_freeRowIds.empty()) {
+        //重用的编号，桶中可能有原来文本的二元组
+        const uint32_t nRowId = m_freeRowIds.back();
+        m_freeRowIds.pop_back();
+        m_textChanged[nRowId] = 1;
+        return nRowId;
+    }
+    m_rowIndexs.push_back(kInvalidRowIndex);
+    m_foldedOffsets.push_back(0);
+    m_foldedLengths.push_back(0);
+    m_textChanged.push_back(0);
+    m_gramCounts.push_back(0);
+    m_charMasks.push_back(0);
+    m_charMasks.push_back(0);
+    return (uint32_t)(m_gramCounts.size() - 1);
+}
+
+void ListCtrlTextIndex::FreeRowId(uint32_t nRowId)
+{
+    m_nLivePostingCount -= m_gramCounts[nRowId];
+    m_gramCounts[nRowId] = 0;
+    m_nFoldedGarbage += m_foldedLengths[nRowId];
+    m_foldedLengths[nRowId] = 0;
+    m_charMasks[nRowId * 2] = 0;
+    m_charMasks[nRowId * 2 + 1] = 0;
+    m_freeRowIds.push_back(nRowId);
+}
+
+void ListCtrlTextIndex::AddText(uint32_t nRowId, const DString::value_type* text, size_t nLength)
+{
+    if ((text == nullptr) || (nLength == 0)) {
+        return;
+    }
+    ASSERT(m_foldedPool.size() + nLength < UINT32_MAX);
+    if (m_foldedPool.size() + nLength >= UINT32_MAX) {
+        return;
+    }
+    const size_t nOffset = m_foldedPool.size();
+    m_foldedOffsets[nRowId] = (uint32_t)nOffset;
+    m_foldedLengths[nRowId] = (uint32_t)nLength;
+    uint64_t charMasks[2] = { 0, 0 };
+    for (size_t nPos = 0; nPos < nLength; ++nPos) {
+        const DString::value_type ch = FoldChar(text[nPos]);
+        m_foldedPool.push_back(ch);
+        const uint32_t nBit = GetCharBit(ch);
+        charMasks[nBit >> 6] |= (uint64_t)1 << (nBit & 63);
+    }
+    m_charMasks[nRowId * 2] = charMasks[0];
+    m_charMasks[nRowId * 2 + 1] = charMasks[1];
+    if (m_buckets.empty()) {
+        m_buckets.resize(kBucketCount);
+    }
+
+    //添加二元组，同一个文本中重复的二元组只记录一次（处理一行时，桶的最后一个记录就是当前行）
+    const DString::value_type* pFolded = m_foldedPool.data() + nOffset;
+    uint32_t nGramCount = 0;
+    for (size_t nPos = 1; nPos < nLength; ++nPos) {
+        GramBucket& bucket = m_buckets[GetGramBucket(pFolded[nPos - 1], pFolded[nPos])];
+        if (bucket.rowIds.empty() || (bucket.rowIds.back() != nRowId)) {
+            bucket.rowIds.push_back(nRowId);
+            bucket.positions.push_back((uint16_t)std::min<size_t>(nPos - 1, kUnknownGramPos));
+            ++nGramCount;
+        }
+        else {
+            bucket.positions.back() |= kRepeatedGramFlag;
+        }
+    }
+    m_gramCounts[nRowId] = nGramCount;
+    m_nPostingCount += nGramCount;
+    m_nLivePostingCount += nGramCount;
+}
+
+void ListCtrlTextIndex::UpdateRowIndexs()
+{
+    if (!m_bRowIndexsDirty) {
+        return;
+    }
+    std::fill(m_rowIndexs.begin(), m_rowIndexs.end(), kInvalidRowIndex);
+    const size_t nCount = m_rowIds.size();
+    for (size_t index = 0; index < nCount; ++index) {
+        m_rowIndexs[m_rowIds[index]] = (uint32_t)index;
+    }
+    m_bRowIndexsDirty = false;
+}
+
+bool ListCtrlTextIndex::IsMatch(uint32_t nRowId, const DString& foldedText, bool bMatchPrefix) const
+{
+    const size_t nTextLength = foldedText.size();
+    const size_t nLength = m_foldedLengths[nRowId];
+    if (nLength < nTextLength) {
+        return false;
+    }
+    const DString::value_type* pText = m_foldedPool.data() + m_foldedOffsets[nRowId];
+    const DString::value_type* pFilter = foldedText.c_str();
+    if (bMatchPrefix) {
+        return CharTraits::compare(pText, pFilter, nTextLength) == 0;
+    }
+    const DString::value_type* pEnd = pText + (nLength - nTextLength + 1);
+    while (pText < pEnd) {
+        pText = CharTraits::find(pText, (size_t)(pEnd - pText), pFilter[0]);
+        if (pText == nullptr) {
+            return false;
+        }
+        if (CharTraits::compare(pText + 1, pFilter + 1, nTextLength - 1) == 0) {
+            return true;
+        }
+        ++pText;
+    }
+    return false;
+}
+
+void ListCtrlTextIndex::ResetLastResult()
+{
+    m_bLastResultValid = false;
+    m_lastResult.clear();
+}
+
+void ListCtrlTextIndex::Find(const ListCtrlColumnData& columnData, const DString& filterText, bool bMatchPrefix,
+                             std::vector<size_t>& itemIndexs)
+{
+    itemIndexs.clear();
+    const size_t nCount = columnData.GetCount();
+    ASSERT(nCount == m_rowIds.size());
+    if ((nCount != m_rowIds.size()) ||
+        ((m_nPostingCount > kMinStaleCount) && (m_nPostingCount > m_nLivePostingCount * 2)) ||
+        ((m_nFoldedGarbage > kMinStaleCount) && (m_nFoldedGarbage * 2 > m_foldedPool.size()))) {
+        //索引中的无效数据过多，重建索引
+        Build(columnData);
+    }
+    UpdateRowIndexs();
+
+    DString foldedText = filterText;
+    for (DString::value_type& ch : foldedText) {
+        ch = FoldChar(ch);
+    }
+    if (foldedText.empty()) {
+        itemIndexs.resize(nCount);
+        for (size_t index = 0; index < nCount; ++index) {
+            itemIndexs[index] = index;
+        }
+        ResetLastResult();
+        return;
+    }
+
+    //查询文本中记录数最少的二元组的桶，以及该二元组在查询文本中的位置（只有一个字符时逐行查找）
+    uint32_t nQueryBucket = 0;
+    size_t nQueryGramPos = 0;
+    size_t nIndexCost = nCount;
+    for (size_t nPos = 1; nPos < foldedText.size(); ++nPos) {
+        const uint32_t nBucket = GetGramBucket(foldedText[nPos - 1], foldedText[nPos]);
+        const size_t nBucketSize = m_buckets[nBucket].rowIds.size();
+        if ((nPos == 1) || (nBucketSize < nIndexCost)) {
+            nQueryBucket = nBucket;
+            nQueryGramPos = nPos - 1;
+            nIndexCost = nBucketSize;
+        }
+    }
+
+    if (m_bLastResultValid && (m_bLastMatchPrefix == bMatchPrefix) &&
+        (m_lastResult.size() * kVerifyCost <= nIndexCost) &&
+        (bMatchPrefix ? (foldedText.compare(0, m_lastFoldedText.size(), m_lastFoldedText) == 0) :
+                        (foldedText.find(m_lastFoldedText) != DString::npos))) {
+        //新的查询文本包含上次的查询文本（输入时逐字查找的情况），并且上次的结果较少，只需要在上次的结果中查找
+        itemIndexs.reserve(m_lastResult.size());
+        for (size_t index : m_lastResult) {
+            if (IsMatch(m_rowIds[index], foldedText, bMatchPrefix)) {
+                itemIndexs.push_back(index);
+            }
+        }
+    }
+    else if (foldedText.size() == 1) {
+        //只有一个字符：按每行的字符集合查找
+        FindChar(foldedText[0], bMatchPrefix, itemIndexs);
+    }
+    else {
+        FindGram(nQueryBucket, nQueryGramPos, foldedText, bMatchPrefix, itemIndexs);
+    }
+
+    //结果较多时，下次查询不会在结果中查找，不需要保存
+    if (itemIndexs.size() * kVerifyCost > nCount) {
+        ResetLastResult();
+        return;
+    }
+    m_lastFoldedText = foldedText;
+    m_bLastMatchPrefix = bMatchPrefix;
+    m_lastResult = itemIndexs;
+    m_bLastResultValid = true;
+}
+
+void ListCtrlTextIndex::FindChar(DString::value_type ch, bool bMatchPrefix, std::vector<size_t>& itemIndexs) const
+{
+    if (m_foldedPool.empty()) {
+        return;
+    }
+    //字符集合与当前文本一致，字符与位一一对应时不需要校验文本
+    const uint32_t nBit = GetCharBit(ch);
+    const size_t nWord = nBit >> 6;
+    const uint64_t nMask = (uint64_t)1 << (nBit & 63);
+    const bool bExact = IsExactCharBit(ch);
+    const DString foldedText(1, ch);
+    itemIndexs.reserve(m_rowIds.size());
+
+    //每行的结果都写入缓冲区，匹配时才增加计数（大量的行时避免分支预测失败）
+    size_t buffer[kResultBlockSize];
+    const size_t nCount = m_rowIds.size();
+    for (size_t nBlockStart = 0; nBlockStart < nCount; nBlockStart += kResultBlockSize) {
+        const size_t nBlockEnd = std::min(nCount, nBlockStart + kResultBlockSize);
+        size_t nMatchCount = 0;
+        for (size_t index = nBlockStart; index < nBlockEnd; ++index) {
+            const uint32_t nRowId = m_rowIds[index];
+            bool bMatch = false;
+            if (bMatchPrefix) {
+                bMatch = (m_foldedLengths[nRowId] > 0) & (m_foldedPool[m_foldedOffsets[nRowId]] == ch);
+            }
+            else {
+                bMatch = (m_charMasks[nRowId * 2 + nWord] & nMask) != 0;
+                if (bMatch && !bExact) {
+                    bMatch = IsMatch(nRowId, foldedText, false);
+                }
+            }
+            buffer[nMatchCount] = index;
+            nMatchCount += bMatch ? 1 : 0;
+        }
+        itemIndexs.insert(itemIndexs.end(), buffer, buffer + nMatchCount);
+    }
+}
+
+void ListCtrlTextIndex::FindGram(uint32_t nBucket, size_t nGramPos, const DString& foldedText, bool bMatchPrefix,
+                                 std::vector<size_t>& itemIndexs)
+{
+    //只有包含该二元组的行可能匹配：查询文本只能从二元组出现的位置往前nGramPos个字符处开始，
+    //文本未修改过的行，如果二元组只出现一次，只需要在该位置比较一次（不需要对各个桶求交集，也不需要逐个字符查找）
+    const GramBucket& bucket = m_buckets[nBucket];
+    const uint32_t* pRowIds = bucket.rowIds.data();
+    const uint16_t* pPositions = bucket.positions.data();
+    const size_t nRecordCount = bucket.rowIds.size();
+    const DString::value_type* pFilter = foldedText.c_str();
+    const size_t nTextLength = foldedText.size();
+    //查询文本就是该二元组（与桶一一对应）时，不需要比较文本
+    const bool bSameGram = (nTextLength == 2) && (nBucket < kExactBucketCount);
+    bool bRowVisitedReady = false;
+    itemIndexs.reserve(nRecordCount);
+    size_t buffer[kResultBlockSize];
+    bool bSorted = true;
+    size_t nLastIndex = 0;
+    for (size_t nBlockStart = 0; nBlockStart < nRecordCount; nBlockStart += kResultBlockSize) {
+        const size_t nBlockEnd = std::min(nRecordCount, nBlockStart + kResultBlockSize);
+        size_t nMatchCount = 0;
+        for (size_t nRecord = nBlockStart; nRecord < nBlockEnd; ++nRecord) {
+            if (!bSameGram && (nRecord + kPrefetchDistance < nRecordCount)) {
+                const size_t nNextRecord = nRecord + kPrefetchDistance;
+                PrefetchText(m_foldedPool.data() + m_foldedOffsets[pRowIds[nNextRecord]] +
+                             (bMatchPrefix ? 0 : (pPositions[nNextRecord] & kUnknownGramPos)));
+            }
+            const uint32_t nRowId = pRowIds[nRecord];
+            const uint32_t nRowIndex = m_rowIndexs[nRowId];
+            if (nRowIndex == kInvalidRowIndex) {
+                continue;
+            }
+            bool bMatch = false;
+            if (m_textChanged[nRowId] != 0) {
+                //修改过的行，桶中可能有旧文本的记录（一行可能有多个记录），逐个字符查找，并且只查找一次
+                if (!bRowVisitedReady) {
+                    m_rowVisited.assign(m_rowIndexs.size(), 0);
+                    bRowVisitedReady = true;
+                }
+                if (m_rowVisited[nRowId] == 0) {
+                    m_rowVisited[nRowId] = 1;
+                    bMatch = IsMatch(nRowId, foldedText, bMatchPrefix);
+                }
+            }
+            else {
+                const uint16_t nGramInfo = pPositions[nRecord];
+                const size_t nFirstPos = nGramInfo & kUnknownGramPos;
+                const size_t nLength = m_foldedLengths[nRowId];
+                if (bSameGram) {
+                    bMatch = !bMatchPrefix || (nFirstPos == 0);
+                }
+                else if (bMatchPrefix) {
+                    bMatch = (nLength >= nTextLength) &&
+                             (CharTraits::compare(m_foldedPool.data() + m_foldedOffsets[nRowId], pFilter, nTextLength) == 0);
+                }
+                else {
+                    if ((nFirstPos != kUnknownGramPos) && (nFirstPos >= nGramPos) &&
+                        (nFirstPos - nGramPos + nTextLength <= nLength)) {
+                        const DString::value_type* pText = m_foldedPool.data() + m_foldedOffsets[nRowId];
+                        bMatch = CharTraits::compare(pText + (nFirstPos - nGramPos), pFilter, nTextLength) == 0;
+                    }
+                    if (!bMatch && ((nFirstPos == kUnknownGramPos) || ((nGramInfo & kRepeatedGramFlag) != 0))) {
+                        //二元组出现了多次，或者位置未知
+                        bMatch = IsMatch(nRowId, foldedText, false);
+                    }
+                }
+            }
+            buffer[nMatchCount] = nRowIndex;
+            nMatchCount += bMatch ? 1 : 0;
+            bSorted = bSorted && (!bMatch || (nRowIndex >= nLastIndex));
+            nLastIndex = bMatch ? nRowIndex : nLastIndex;
+        }
+        itemIndexs.insert(itemIndexs.end(), buffer, buffer + nMatchCount);
+    }
+    if (bSorted) {
+        //行的顺序没有调整过时，编号与行号的顺序一致
+        return;
+    }
+
+    //按行号排列结果
+    const size_t nCount = m_rowIds.size();
+    m_matchFlags.resize(nCount, 0);
+    uint8_t* pMatchFlags = m_matchFlags.data();
+    for (size_t index : itemIndexs) {
+        pMatchFlags[index] = 1;
+    }
+    itemIndexs.clear();
+    for (size_t nBlockStart = 0; nBlockStart < nCount; nBlockStart += kResultBlockSize) {
+        const size_t nBlockEnd = std::min(nCount, nBlockStart + kResultBlockSize);
+        size_t nMatchCount = 0;
+        for (size_t index = nBlockStart; index < nBlockEnd; ++index) {
+            buffer[nMatchCount] = index;
+            nMatchCount += pMatchFlags[index];
+            pMatchFlags[index] = 0;
+        }
+        itemIndexs.insert(itemIndexs.end(), buffer, buffer + nMatchCount);
+    }
+}
+
+}//namespace ui
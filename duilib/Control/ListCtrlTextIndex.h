@@ -0,0 +1,155 @@
+#ifndef UI_CONTROL_LIST_CTRL_TEXT_INDEX_H_
+#define UI_CONTROL_LIST_CTRL_TEXT_INDEX_H_
+
+#include "duilib/duilib_defs.h"
+#include <vector>
+
+namespace ui
+{
+class ListCtrlColumnData;
+
+/** 列表中一列文本的过滤索引（不区分大小写的二元组倒排索引）
+*   1. 每行分配一个内部编号，索引中记录编号，插入、删除、排序时只调整行号与编号的对应关系，不需要重建索引
+*   2. 二元组按字符映射到固定数量的桶中（两个字符都是ASCII字符时一一对应，其他字符按哈希值映射），每个桶记录包含该二元组的行编号
+*   3. 修改文本时只追加新文本的二元组，旧文本的二元组保留在索引中（查询时校验文本），无效数据过多时重建索引
+*   4. 桶中同时记录二元组在行文本中第一次出现的位置，以及是否出现了多次；查询时只使用查询文本中记录数最少的二元组的桶，
+*      候选行中查询文本只能从该二元组出现的位置开始，二元组只出现一次时，在该位置比较一次即可（查询耗时与该桶的记录数成正比）
+*   5. 每行记录文本中出现的字符集合（ASCII可见字符一一对应），只有一个字符的查询不需要校验文本
+*   6. 如果新的查询文本包含上次的查询文本（输入时逐字查找），并且上次的结果较少，只在上次的结果中查找
+*/
+class ListCtrlTextIndex
+{
+public:
+    ListCtrlTextIndex();
+
+    /** 比较时使用的字符转换（转换为小写）
+    */
+    static DString::value_type FoldChar(DString::value_type ch);
+
+    /** 根据列的数据重建索引
+    */
+    void Build(const ListCtrlColumnData& columnData);
+
+    /** 列数据变化的通知（由ListCtrlColumnData调用）
+    */
+    void OnResize(size_t nCount);
+    void OnInsert(size_t itemIndex);
+    void OnErase(size_t itemIndex);
+    void OnReorder(const std::vector<size_t>& orders);
+    void OnTextChanged(size_t itemIndex, const DString::value_type* text, size_t nLength);
+
+    /** 查找包含指定文本的行（不区分大小写）
+    * @param [in] columnData 列的数据（索引中的无效数据过多时，用于重建索引）
+    * @param [in] filterText 查找的文本，为空时返回所有行
+    * @param [in] bMatchPrefix true表示文本以filterText开头，false表示文本中包含filterText
+    * @param [out] itemIndexs 返回匹配的行号，按行号升序排列
+    */
+    void Find(const ListCtrlColumnData& columnData, const DString& filterText, bool bMatchPrefix,
+              std::vector<size_t>& itemIndexs);
+
+private:
+    /** 分配一个行编号
+    */
+    uint32_t AllocRowId();
+
+    /** 释放一个行编号
+    */
+    void FreeRowId(uint32_t nRowId);
+
+    /** 设置一行的文本：保存转换为小写后的文本，并添加二元组
+    */
+    void AddText(uint32_t nRowId, const DString::value_type* text, size_t nLength);
+
+    /** 更新编号到行号的映射表
+    */
+    void UpdateRowIndexs();
+
+    /** 校验一行的文本是否匹配（foldedText为已转换为小写的查找文本）
+    */
+    bool IsMatch(uint32_t nRowId, const DString& foldedText, bool bMatchPrefix) const;
+
+    /** 数据变化，清除上次的查询结果
+    */
+    void ResetLastResult();
+
+    /** 查找只有一个字符的文本
+    */
+    void FindChar(DString::value_type ch, bool bMatchPrefix, std::vector<size_t>& itemIndexs) const;
+
+    /** 使用查询文本中一个二元组的桶，查找多个字符的文本
+    * @param [in] nBucket 二元组的桶
+    * @param [in] nGramPos 二元组在查询文本中的位置
+    */
+    void FindGram(uint32_t nBucket, size_t nGramPos, const DString& foldedText, bool bMatchPrefix,
+                  std::vector<size_t>& itemIndexs);
+
+private:
+    /** 二元组的桶：包含该二元组的行编号，以及该二元组在行文本中第一次出现的位置和是否出现了多次
+    */
+    struct GramBucket
+    {
+        std::vector<uint32_t> rowIds;
+        std::vector<uint16_t> positions;
+    };
+
+private:
+    /** 每行的编号（下标为行号）
+    */
+    std::vector<uint32_t> m_rowIds;
+
+    /** 每个编号对应的行号（下标为编号，未使用的编号为UINT32_MAX），在查询时按需更新
+    */
+    std::vector<uint32_t> m_rowIndexs;
+    bool m_bRowIndexsDirty;
+
+    /** 可重用的编号
+    */
+    std::vector<uint32_t> m_freeRowIds;
+
+    /** 每个编号转换为小写后的文本（在m_foldedPool中的偏移和长度）
+    */
+    std::vector<uint32_t> m_foldedOffsets;
+    std::vector<uint32_t> m_foldedLengths;
+    std::vector<DString::value_type> m_foldedPool;
+
+    /** m_foldedPool中不再使用的字符数
+    */
+    size_t m_nFoldedGarbage;
+
+    /** 每个编号的文本在建立索引后是否修改过（修改过的行，桶中可能有旧文本的二元组）
+    */
+    std::vector<uint8_t> m_textChanged;
+
+    /** 每个编号当前文本中出现的字符（每个编号两个64位整数，字符与位的对应关系见GetCharBit）
+    */
+    std::vector<uint64_t> m_charMasks;
+
+    /** 二元组的桶
+    */
+    std::vector<GramBucket> m_buckets;
+
+    /** 索引中的记录总数，以及其中有效的记录数（每行当前文本的二元组数之和）
+    */
+    size_t m_nPostingCount;
+    size_t m_nLivePostingCount;
+
+    /** 每个编号当前文本的二元组数
+    */
+    std::vector<uint32_t> m_gramCounts;
+
+    /** 上次的查询条件和结果
+    */
+    DString m_lastFoldedText;
+    bool m_bLastMatchPrefix;
+    bool m_bLastResultValid;
+    std::vector<size_t> m_lastResult;
+
+    /** 查询时使用的临时数据（在多次查询之间重用，避免每次查询重新分配内存）：每个编号是否已校验过，每行是否匹配
+    */
+    std::vector<uint8_t> m_rowVisited;
+    std::vector<uint8_t> m_matchFlags;
+};
+
+}//namespace ui
+
+#endif //UI_CONTROL_LIST_CTRL_TEXT_INDEX_H_
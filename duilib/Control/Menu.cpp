@@ -211,6 +211,12 @@ DString Menu::GetSkinFile()
     return m_xml.c_str();
 }
 
+bool Menu::IsSkinFileCacheEnabled() const
+{
+    //菜单每次弹出时都会创建新的窗口，使用窗口模板缓存，避免每次都解析XML文件
+    return true;
+}
+
 LRESULT Menu::OnKillFocusMsg(WindowBase* pSetFocusWindow, const NativeMsg& nativeMsg, bool& bHandled)
 {
     LRESULT lResult = BaseClass::OnKillFocusMsg(pSetFocusWindow, nativeMsg, bHandled);
@@ -173,6 +173,7 @@ private:
     virtual ui::Control* CreateControl(const DString& pstrClass) override;
     virtual DString GetSkinFolder() override;
     virtual DString GetSkinFile() override;
+    virtual bool IsSkinFileCacheEnabled() const override;
     virtual void PostInitWindow() override;
     virtual void OnCloseWindow() override;
 
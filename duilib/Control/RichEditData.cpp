@@ -1,9 +1,22 @@
 #include "RichEditData.h"
 #include "duilib/Utils/PerformanceUtil.h"
+#include <algorithm>
 #include <unordered_set>
 
 namespace ui
 {
+/** 文本长度（字符数）超过该值时，分段计算文字区域
+*/
+static const size_t s_nPendingTextRectsMinChars = 256 * 1024;
+
+/** 分段计算时，首段的字符数（首段至少包含可见的行）
+*/
+static const size_t s_nFirstTextRectsChars = 32 * 1024;
+
+/** 分段计算时，后续每段的字符数（每段计算后需要更新所有行的纵坐标，所以文本越长，每段越长）
+*/
+static const size_t s_nPendingTextRectsChars = 256 * 1024;
+
 RichEditData::RichEditData(IRichTextData* pRichTextData):
     m_pRichText(pRichTextData),
     m_hAlignType(HorAlignType::kAlignLeft),
@@ -12,6 +25,9 @@ RichEditData::RichEditData(IRichTextData* pRichTextData):
     m_pRender(nullptr),
     m_pRenderFactory(nullptr),
     m_bCacheDirty(true),
+    m_nTextLength(0),
+    m_nCalcTextRectsLines(0),
+    m_bTextRectsPending(false),
     m_nUndoLimit(64),
     m_bTextRectYOffsetUpdated(false),
     m_bTextRectXOffsetUpdated(false)
@@ -347,9 +363,144 @@ void RichEditData::CheckCalcTextRects()
     }
 }
 
+bool RichEditData::IsTextRectsPending() const
+{
+    return m_bTextRectsPending;
+}
+
+size_t RichEditData::GetCalcTextRectsLineCount() const
+{
+    if (m_bTextRectsPending) {
+        return m_nCalcTextRectsLines;
+    }
+    return m_lineTextInfo.size();
+}
+
+bool RichEditData::CalcPendingTextRects()
+{
+    if (!m_bTextRectsPending || m_bCacheDirty) {
+        //需要全部重新计算时，不再分段计算
+        return false;
+    }
+    //文本越长，每段越长，控制分段的个数
+    const size_t nSegmentChars = std::max(s_nPendingTextRectsChars, m_nTextLength / 64);
+    const size_t nLineCount = m_lineTextInfo.size();
+    size_t nEndLine = m_nCalcTextRectsLines;
+    size_t nChars = 0;
+    while ((nEndLine < nLineCount) && (nChars < nSegmentChars)) {
+        nChars += m_lineTextInfo[nEndLine]->m_nLineTextLen;
+        ++nEndLine;
+    }
+    CalcPendingTextRects(nEndLine);
+    return true;
+}
+
+void RichEditData::CalcPendingTextRects(size_t nEndLine)
+{
+    PerformanceStat statPerformance(_T("RichEditData::CalcPendingTextRects"));
+    const size_t nLineCount = m_lineTextInfo.size();
+    nEndLine = std::min(nEndLine, nLineCount);
+    if (!m_bTextRectsPending || (nEndLine <= m_nCalcTextRectsLines)) {
+        return;
+    }
+    const size_t nStartLine = m_nCalcTextRectsLines;
+    std::vector<size_t> pendingLines;
+    pendingLines.reserve(nEndLine - nStartLine);
+    size_t nPendingRows = 0;
+    for (size_t nLine = nStartLine; nLine < nEndLine; ++nLine) {
+        pendingLines.push_back(nLine);
+        nPendingRows += m_lineTextInfo[nLine]->m_rowInfo.size();
+    }
+    m_nCalcTextRectsLines = nEndLine;
+    if (nEndLine >= nLineCount) {
+        CancelPendingTextRects();
+    }
+    //估算的行数据按删除的行处理，重新计算的行按修改的行处理，使用增量计算
+    CalcTextRects(nStartLine, pendingLines, pendingLines, nPendingRows);
+}
+
+void RichEditData::MakePendingRowInfo(size_t nStartLine)
+{
+    const size_t nLineCount = m_lineTextInfo.size();
+    ASSERT(nStartLine <= nLineCount);
+    if (nStartLine > nLineCount) {
+        return;
+    }
+    //按已经计算的行，估算行高和每个逻辑行的字符数
+    UiRectF lastRowRect;
+    float fFirstRowTop = 0;
+    size_t nRowCount = 0;
+    size_t nCharCount = 0;
+    for (size_t nLine = 0; nLine < nStartLine; ++nLine) {
+        const RichTextLineInfo& lineInfo = *m_lineTextInfo[nLine];
+        nCharCount += lineInfo.m_nLineTextLen;
+        for (const RichTextRowInfoPtr& spRowInfo : lineInfo.m_rowInfo) {
+            if (nRowCount == 0) {
+                fFirstRowTop = spRowInfo->m_rowRect.top;
+            }
+            lastRowRect = spRowInfo->m_rowRect;
+            ++nRowCount;
+        }
+    }
+    float fRowHeight = 0;
+    if (nRowCount > 0) {
+        fRowHeight = (lastRowRect.bottom - fFirstRowTop) / nRowCount;
+    }
+    if (fRowHeight <= 0) {
+        fRowHeight = (float)m_pRichText->GetTextRowHeight();
+    }
+    //已计算的行有自动换行时，按平均每行的字符数估算逻辑行数
+    size_t nRowChars = 0;
+    if (nRowCount > nStartLine) {
+        nRowChars = std::max(nCharCount / nRowCount, (size_t)1);
+    }
+
+    float fRowTop = lastRowRect.bottom;
+    for (size_t nLine = nStartLine; nLine < nLineCount; ++nLine) {
+        RichTextLineInfo& lineInfo = *m_lineTextInfo[nLine];
+        const std::wstring_view lineText(lineInfo.m_lineText.c_str(), lineInfo.m_nLineTextLen);
+        RichTextRowInfoPtr spRowInfo(new RichTextRowInfo);
+        spRowInfo->m_charInfo.resize(lineText.size());
+        for (size_t nIndex = 0; nIndex < lineText.size(); ++nIndex) {
+            const std::wstring_view::value_type ch = lineText[nIndex];
+            RichTextCharInfo& charInfo = spRowInfo->m_charInfo[nIndex];
+            if (ch == L'\r') {
+                charInfo.AddCharFlag(RichTextCharFlag::kIsIgnoredChar);
+                charInfo.AddCharFlag(RichTextCharFlag::kIsReturn);
+            }
+            else if (ch == L'\n') {
+                charInfo.AddCharFlag(RichTextCharFlag::kIsNewLine);
+            }
+            else if ((nIndex > 0) && (ch >= 0xDC00) && (ch <= 0xDFFF)) {
+                charInfo.AddCharFlag(RichTextCharFlag::kIsIgnoredChar);
+                charInfo.AddCharFlag(RichTextCharFlag::kIsLowSurrogate);
+            }
+        }
+        size_t nLineRows = 1;
+        if (nRowChars > 0) {
+            nLineRows = std::max((lineText.size() + nRowChars - 1) / nRowChars, (size_t)1);
+        }
+        spRowInfo->m_rowRect.left = lastRowRect.left;
+        spRowInfo->m_rowRect.right = lastRowRect.left;
+        spRowInfo->m_rowRect.top = fRowTop;
+        spRowInfo->m_rowRect.bottom = fRowTop + fRowHeight * nLineRows;
+        fRowTop = spRowInfo->m_rowRect.bottom;
+
+        lineInfo.m_rowInfo.clear();
+        lineInfo.m_rowInfo.push_back(spRowInfo);
+    }
+}
+
+void RichEditData::CancelPendingTextRects()
+{
+    m_bTextRectsPending = false;
+    m_nCalcTextRectsLines = 0;
+}
+
 void RichEditData::CalcTextRects()
 {
     PerformanceStat statPerformance(_T("RichEditData::CalcTextRects"));
+    CancelPendingTextRects();
     //清空所有行的缓存数据
     for (RichTextLineInfoPtr& pLineInfo : m_lineTextInfo) {
         ASSERT(pLineInfo != nullptr);
@@ -399,6 +550,23 @@ void RichEditData::CalcTextRects()
     lineInfoParam.m_nStartRowIndex = 0;
     lineInfoParam.m_pLineInfoList = &m_lineTextInfo;
 
+    //文本较长时，分段计算：本次只计算首段（包含可见的行），其余的行使用估算的行数据，稍后再逐段计算
+    if ((nTextLen >= s_nPendingTextRectsMinChars) && !m_pRichText->IsTextPasswordMode()) {
+        const int32_t nRowHeight = std::max(m_pRichText->GetTextRowHeight(), 1);
+        const size_t nMinLines = (size_t)(rcDrawText.Height() / nRowHeight) + 1;
+        size_t nCalcLines = 0;
+        size_t nCalcChars = 0;
+        while ((nCalcLines < textView.size()) && ((nCalcChars < s_nFirstTextRectsChars) || (nCalcLines < nMinLines))) {
+            nCalcChars += textView[nCalcLines].size();
+            ++nCalcLines;
+        }
+        if (nCalcLines < textView.size()) {
+            textView.resize(nCalcLines);
+            m_nCalcTextRectsLines = nCalcLines;
+            m_bTextRectsPending = true;
+        }
+    }
+
     //绘制所有数据，清空行数据信息
     std::vector<RichTextData> richTextDataList;
     m_pRichText->GetRichTextForDraw(textView, richTextDataList);
@@ -424,7 +592,10 @@ void RichEditData::CalcTextRects()
     }
     else {
         m_pRender->MeasureRichText3(rcDrawText, szScrollOffset, m_pRenderFactory, richTextDataList, &lineInfoParam, m_spDrawRichTextCache, nullptr);
-    }    
+    }
+    if (m_bTextRectsPending) {
+        MakePendingRowInfo(m_nCalcTextRectsLines);
+    }
     SetTextDrawRect(rcDrawText, false);
     CalcCacheTextRects(m_rcTextRect);
 
@@ -436,6 +607,10 @@ void RichEditData::CalcTextRects()
     }
 
     UpdateRowTextOffsetX(m_lineTextInfo, GetHAlignType(), m_rowXOffset, m_bTextRectXOffsetUpdated);
+
+    if (m_bTextRectsPending) {
+        m_pRichText->OnTextRectsPending();
+    }
 }
 
 void RichEditData::CalcTextRects(size_t nStartLine,
@@ -505,6 +680,11 @@ void RichEditData::CalcTextRects(size_t nStartLine,
 
     std::vector<std::wstring_view> textView;
     GetTextView(textView);
+    if (m_bTextRectsPending && (m_nCalcTextRectsLines < textView.size())) {
+        //分段计算时，只有已经计算过的行在绘制缓存中
+        ASSERT(modifiedLines.empty() || (modifiedLines.back() < m_nCalcTextRectsLines));
+        textView.resize(m_nCalcTextRectsLines);
+    }
     if (textView.empty()) {
         return;
     }
@@ -610,8 +790,8 @@ void RichEditData::CalcTextRects(size_t nStartLine,
     UpdateRowTextOffsetX(m_lineTextInfo, GetHAlignType(), m_rowXOffset, m_bTextRectXOffsetUpdated);
     
 #ifdef _DEBUG
-    //比较与完整绘制时是否一致
-    if (nStartLine != (size_t)-1) {
+    //比较与完整绘制时是否一致（分段计算未完成时，后面的行是估算的数据，不比较）
+    if ((nStartLine != (size_t)-1) && !m_bTextRectsPending) {
         std::vector<std::wstring_view> textView2;
         RichTextLineInfoList lineTextInfoList;
         for (RichTextLineInfoPtr& pLineInfo : m_lineTextInfo) {
@@ -730,6 +910,7 @@ bool RichEditData::SetText(const DStringW& text)
         bTextChanged = true;
     }
     if (bTextChanged) {
+        size_t nTextLength = 0;
         RichTextLineInfoList lineTextInfo;
         if (nLineCount > 0) {
             lineTextInfo.resize(nLineCount);
@@ -740,9 +921,13 @@ bool RichEditData::SetText(const DStringW& text)
                 lineText->m_lineText = lineTextView; //文本数据复制一份，保存起来
                 lineText->m_nLineTextLen = (uint32_t)lineTextView.size();
                 ASSERT(lineText->m_nLineTextLen > 0);
+                nTextLength += lineText->m_nLineTextLen;
             }
         }
         m_lineTextInfo.swap(lineTextInfo);
+        m_nTextLength = nTextLength;
+        InvalidateLineStartChars(0);
+        CancelPendingTextRects();
         SetCacheDirty(true);
         ClearUndoList();
     }
@@ -828,28 +1013,43 @@ void RichEditData::GetTextView(std::vector<std::wstring_view>& textView) const
 
 size_t RichEditData::GetTextLength() const
 {
-    size_t nTextLen = 0;
-    const size_t nLineCount = m_lineTextInfo.size();
-    for (size_t nIndex = 0; nIndex < nLineCount; ++nIndex) {
-        const RichTextLineInfo& lineText = *m_lineTextInfo[nIndex];
-        ASSERT(lineText.m_nLineTextLen > 0);
-        nTextLen += lineText.m_nLineTextLen;
-    }
-    return nTextLen;
+    return m_nTextLength;
 }
 
 bool RichEditData::IsEmpty() const
 {
-    bool bEmpty = true;
+    return m_nTextLength == 0;
+}
+
+size_t RichEditData::FindCharLine(size_t nCharIndex, size_t& nLineStartChar) const
+{
+    nLineStartChar = 0;
     const size_t nLineCount = m_lineTextInfo.size();
-    for (size_t nIndex = 0; nIndex < nLineCount; ++nIndex) {
-        const RichTextLineInfo& lineText = *m_lineTextInfo[nIndex];
-        if (lineText.m_nLineTextLen > 0) {
-            bEmpty = false;
-            break;
-        }
+    if (nLineCount == 0) {
+        return 0;
+    }
+    //按需补充行起始位置索引，直到包含该字符所在的行
+    if (m_lineStartChars.empty()) {
+        m_lineStartChars.push_back(0);
+    }
+    size_t nLastLine = m_lineStartChars.size() - 1;
+    while ((nCharIndex >= (m_lineStartChars[nLastLine] + m_lineTextInfo[nLastLine]->m_nLineTextLen)) &&
+           ((nLastLine + 1) < nLineCount)) {
+        m_lineStartChars.push_back(m_lineStartChars[nLastLine] + m_lineTextInfo[nLastLine]->m_nLineTextLen);
+        ++nLastLine;
+    }
+    auto iter = std::upper_bound(m_lineStartChars.begin(), m_lineStartChars.end(), nCharIndex);
+    ASSERT(iter != m_lineStartChars.begin());
+    const size_t nLineIndex = (size_t)(iter - m_lineStartChars.begin()) - 1;
+    nLineStartChar = m_lineStartChars[nLineIndex];
+    return nLineIndex;
+}
+
+void RichEditData::InvalidateLineStartChars(size_t nLineIndex)
+{
+    if (m_lineStartChars.size() > nLineIndex) {
+        m_lineStartChars.resize(nLineIndex);
     }
-    return bEmpty;
 }
 
 DStringW RichEditData::GetText() const
@@ -894,7 +1094,7 @@ bool RichEditData::FindLineTextPos(int32_t nStartChar, int32_t nEndChar,
     nEndCharLineOffset = nNotFound;         //在结束行中，结束字符的偏移量
     size_t nTextLen = 0;                    //文本总长度
     const size_t nLineCount = m_lineTextInfo.size();
-    for (size_t nIndex = 0; nIndex < nLineCount; ++nIndex) {
+    for (size_t nIndex = FindCharLine((size_t)nStartChar, nTextLen); nIndex < nLineCount; ++nIndex) {
         const RichTextLineInfo& lineText = *m_lineTextInfo[nIndex];
         ASSERT(lineText.m_nLineTextLen > 0);
         nTextLen += lineText.m_nLineTextLen;
@@ -967,15 +1167,19 @@ bool RichEditData::ReplaceText(int32_t nStartChar, int32_t nEndChar, const DStri
     if (!FindLineTextPos(nStartChar, nEndChar, nStartLine, nEndLine, nStartCharLineOffset, nEndCharLineOffset)) {
         return false;
     }
+    if (m_bTextRectsPending && (nEndLine >= m_nCalcTextRectsLines)) {
+        //修改的行尚未计算文字区域，先计算到修改的行为止（增量计算需要修改的行之前的行数据）
+        CalcPendingTextRects(nEndLine + 1);
+    }
 
-    DStringW oldText; //旧文本内容
+    TUndoText oldText; //旧文本内容
 
     //是否需要记录撤销操作
     if (m_nUndoLimit == 0) {
         bCanUndo = false;
     }
     if (bCanUndo && (nEndChar > nStartChar)) {
-        oldText = GetTextRange(nStartChar, nEndChar);
+        MakeUndoText(nStartLine, nEndLine, nStartCharLineOffset, (size_t)(nEndChar - nStartChar), oldText);
     }
     //操作结果
     std::wstring_view startLineTextView; //起始行的剩余文本
@@ -1021,45 +1225,62 @@ bool RichEditData::ReplaceText(int32_t nStartChar, int32_t nEndChar, const DStri
     newText += text;
     newText += endLineTextView;
 
+    //新文本在首行中的起始位置
+    const size_t nNewTextLineOffset = startLineTextView.size();
+
     //待删除的行
     std::vector<size_t> deletedLines;
     for (size_t nIndex = nStartLine; nIndex <= nEndLine; ++nIndex) {
         deletedLines.push_back(nIndex);
     }
-    //删除了几行
+    //删除了几行（一次删除所有的行，避免逐行删除时反复移动后面的数据）
     size_t nDeletedRows = 0;
-    //倒序删除
-    if (!deletedLines.empty()) {
-        int32_t nDelIndex = (int32_t)deletedLines.size() - 1;
-        for (; nDelIndex >= 0; --nDelIndex) {
-            if (deletedLines[nDelIndex] < m_lineTextInfo.size()) {
-                nDeletedRows += m_lineTextInfo[deletedLines[nDelIndex]]->m_rowInfo.size();
-                m_lineTextInfo.erase(m_lineTextInfo.begin() + deletedLines[nDelIndex]);
-            }
+    size_t nDeletedLineCount = 0;
+    if (nStartLine < m_lineTextInfo.size()) {
+        const size_t nDeleteEndLine = std::min(nEndLine + 1, m_lineTextInfo.size());
+        nDeletedLineCount = nDeleteEndLine - nStartLine;
+        for (size_t nIndex = nStartLine; nIndex < nDeleteEndLine; ++nIndex) {
+            RichTextLineInfo& lineText = *m_lineTextInfo[nIndex];
+            nDeletedRows += lineText.m_rowInfo.size();
+            //删除的行可能被Undo数据引用（只引用文本），不需要保留行的绘制信息
+            lineText.m_rowInfo.clear();
         }
+        m_lineTextInfo.erase(m_lineTextInfo.begin() + nStartLine, m_lineTextInfo.begin() + nDeleteEndLine);
     }
 
     std::wstring_view newTextView = newText;
     std::vector<std::wstring_view> lineTextViewList;
     SplitLines(newTextView, lineTextViewList);
 
-    size_t nNewLineCount = 0;
+    RichTextLineInfoList newLineTextInfo;
+    newLineTextInfo.reserve(lineTextViewList.size());
     for (const std::wstring_view& textView : lineTextViewList) {
         if (!textView.empty()) {
             //插入新行
             RichTextLineInfoPtr lineTextInfo(new RichTextLineInfo);
             lineTextInfo->m_lineText = textView;
             lineTextInfo->m_nLineTextLen = (uint32_t)textView.size();
-            m_lineTextInfo.insert(m_lineTextInfo.begin() + nStartLine + nNewLineCount, lineTextInfo);
-            ++nNewLineCount;
+            newLineTextInfo.push_back(lineTextInfo);
         }
     }
+    const size_t nNewLineCount = newLineTextInfo.size();
+    m_lineTextInfo.insert(m_lineTextInfo.begin() + nStartLine, newLineTextInfo.begin(), newLineTextInfo.end());
+    m_nTextLength = m_nTextLength + text.size() - (size_t)(nEndChar - nStartChar);
+    InvalidateLineStartChars(nStartLine);
 
     //文本有变化的行
     std::vector<size_t> modifiedLines;
     for (size_t nIndex = 0; nIndex < nNewLineCount; ++nIndex) {
         modifiedLines.push_back(nStartLine + nIndex);
     }
+    if (m_bTextRectsPending) {
+        //已计算的行数随修改的行数变化（修改的行都在已计算的行中）
+        ASSERT(m_nCalcTextRectsLines >= nDeletedLineCount);
+        m_nCalcTextRectsLines = m_nCalcTextRectsLines + nNewLineCount - nDeletedLineCount;
+        if (m_nCalcTextRectsLines >= m_lineTextInfo.size()) {
+            CancelPendingTextRects();
+        }
+    }
 
     if (!m_bCacheDirty && (!modifiedLines.empty() || !deletedLines.empty())) {
         //修改的行，需要重新计算(增量计算)
@@ -1074,7 +1295,11 @@ bool RichEditData::ReplaceText(int32_t nStartChar, int32_t nEndChar, const DStri
     }
     if (bCanUndo) {
         //生成撤销列表
-        AddToUndoList(nStartChar, text, oldText);
+        TUndoText newUndoText;
+        if (!text.empty() && (nNewLineCount > 0)) {
+            MakeUndoText(nStartLine, nStartLine + nNewLineCount - 1, nNewTextLineOffset, text.size(), newUndoText);
+        }
+        AddToUndoList(nStartChar, std::move(newUndoText), std::move(oldText));
     }
     else if (bClearRedo){
         ClearUndoList();
@@ -1101,33 +1326,32 @@ DStringW RichEditData::GetTextRange(int32_t nStartChar, int32_t nEndChar) const
     if (nStartLine == nEndLine) {
         //在相同行
         const RichTextLineInfo& lineText = *m_lineTextInfo[nStartLine];
-        DStringW newText = lineText.m_lineText.c_str();
+        std::wstring_view lineView(lineText.m_lineText.c_str(), lineText.m_nLineTextLen);
         if (nEndCharLineOffset > nStartCharLineOffset) {
             //有选择的文本
             size_t nCharCount = nEndCharLineOffset - nStartCharLineOffset;
-            selText = newText.substr(nStartCharLineOffset, nCharCount);
+            selText = lineView.substr(nStartCharLineOffset, nCharCount);
         }
     }
     else if (nEndLine > nStartLine) {
         //在不同行
-        DStringW newText;
+        selText.reserve((size_t)(nEndChar - nStartChar));
         for (size_t nIndex = nStartLine; nIndex <= nEndLine; ++nIndex) {
             const RichTextLineInfo& lineText = *m_lineTextInfo[nIndex];
-            newText = lineText.m_lineText.c_str();
+            std::wstring_view lineView(lineText.m_lineText.c_str(), lineText.m_nLineTextLen);
             if (nIndex == nStartLine) {
                 //首行, 选择到行尾
-                selText = newText.substr(nStartCharLineOffset);
+                selText = lineView.substr(nStartCharLineOffset);
             }
             else if (nIndex == nEndLine) {
                 //末行，选择到行首
-                newText = lineText.m_lineText.c_str();
                 if (nEndCharLineOffset > 0) {
-                    selText += newText.substr(0, nEndCharLineOffset);
+                    selText += lineView.substr(0, nEndCharLineOffset);
                 }                    
             }
             else {
                 //中间行
-                selText += lineText.m_lineText.c_str();
+                selText += lineView;
             }
         }
     }
@@ -1188,7 +1412,7 @@ bool RichEditData::GetCharLineRowIndex(int32_t nCharIndex, size_t& nLineNumber,
     size_t nTextLen = 0; //文本总长度
     const RichTextLineInfoList& lineTextInfoList = m_lineTextInfo;
     const size_t nLineCount = lineTextInfoList.size();
-    for (size_t nLineIndex = 0; nLineIndex < nLineCount; ++nLineIndex) {
+    for (size_t nLineIndex = FindCharLine((size_t)nCharIndex, nTextLen); nLineIndex < nLineCount; ++nLineIndex) {
         ASSERT(lineTextInfoList[nLineIndex] != nullptr);
         const RichTextLineInfo& lineTextInfo = *lineTextInfoList[nLineIndex];
         ASSERT(lineTextInfo.m_nLineTextLen > 0);
@@ -1719,7 +1943,7 @@ int32_t RichEditData::GetNextValidCharIndex(const int32_t nCharIndex)
     int32_t nNewCharIndex = nCharIndex;
     size_t nTextLen = 0; //文本总长度
     const size_t nLineCount = m_lineTextInfo.size();
-    for (size_t nIndex = 0; nIndex < nLineCount; ++nIndex) {
+    for (size_t nIndex = FindCharLine((size_t)nCharIndex, nTextLen); nIndex < nLineCount; ++nIndex) {
         const RichTextLineInfo& lineText = *m_lineTextInfo[nIndex];
         ASSERT(lineText.m_nLineTextLen > 0);
         nTextLen += lineText.m_nLineTextLen;
@@ -1785,7 +2009,7 @@ int32_t RichEditData::GetPrevValidCharIndex(int32_t nCharIndex)
     int32_t nNewCharIndex = nCharIndex;
     size_t nTextLen = 0; //文本总长度
     const size_t nLineCount = m_lineTextInfo.size();
-    for (size_t nIndex = 0; nIndex < nLineCount; ++nIndex) {
+    for (size_t nIndex = FindCharLine((size_t)nCharIndex, nTextLen); nIndex < nLineCount; ++nIndex) {
         const RichTextLineInfo& lineText = *m_lineTextInfo[nIndex];
         ASSERT(lineText.m_nLineTextLen > 0);
         nTextLen += lineText.m_nLineTextLen;
@@ -1871,7 +2095,7 @@ int32_t RichEditData::GetNextValidWordIndex(int32_t nCharIndex)
     int32_t nNewCharIndex = nCharIndex;
     size_t nTextLen = 0; //文本总长度
     const size_t nLineCount = m_lineTextInfo.size();
-    for (size_t nIndex = 0; nIndex < nLineCount; ++nIndex) {
+    for (size_t nIndex = FindCharLine((size_t)nCharIndex, nTextLen); nIndex < nLineCount; ++nIndex) {
         const RichTextLineInfo& lineText = *m_lineTextInfo[nIndex];
         ASSERT(lineText.m_nLineTextLen > 0);
         nTextLen += lineText.m_nLineTextLen;
@@ -1954,7 +2178,7 @@ int32_t RichEditData::GetPrevValidWordIndex(int32_t nCharIndex)
     int32_t nNewCharIndex = nCharIndex;
     size_t nTextLen = 0; //文本总长度
     const size_t nLineCount = m_lineTextInfo.size();
-    for (size_t nIndex = 0; nIndex < nLineCount; ++nIndex) {
+    for (size_t nIndex = FindCharLine((size_t)nCharIndex, nTextLen); nIndex < nLineCount; ++nIndex) {
         const RichTextLineInfo& lineText = *m_lineTextInfo[nIndex];
         ASSERT(lineText.m_nLineTextLen > 0);
         nTextLen += lineText.m_nLineTextLen;
@@ -2055,7 +2279,7 @@ bool RichEditData::GetCurrentWordIndex(int32_t nCharIndex, int32_t& nWordStartIn
 
     size_t nTextLen = 0; //文本总长度
     const size_t nLineCount = m_lineTextInfo.size();
-    for (size_t nIndex = 0; nIndex < nLineCount; ++nIndex) {
+    for (size_t nIndex = FindCharLine((size_t)nCharIndex, nTextLen); nIndex < nLineCount; ++nIndex) {
         const RichTextLineInfo& lineText = *m_lineTextInfo[nIndex];
         ASSERT(lineText.m_nLineTextLen > 0);
         nTextLen += lineText.m_nLineTextLen;
@@ -2162,7 +2386,7 @@ int32_t RichEditData::GetRowStartCharIndex(int32_t nCharIndex)
     int32_t nNewCharIndex = nCharIndex;
     size_t nTextLen = 0; //文本总长度
     const size_t nLineCount = m_lineTextInfo.size();
-    for (size_t nIndex = 0; nIndex < nLineCount; ++nIndex) {
+    for (size_t nIndex = FindCharLine((size_t)nCharIndex, nTextLen); nIndex < nLineCount; ++nIndex) {
         const RichTextLineInfo& lineText = *m_lineTextInfo[nIndex];
         ASSERT(lineText.m_nLineTextLen > 0);
         nTextLen += lineText.m_nLineTextLen;
@@ -2200,7 +2424,7 @@ int32_t RichEditData::GetRowEndCharIndex(int32_t nCharIndex)
     int32_t nNewCharIndex = nCharIndex;
     size_t nTextLen = 0; //文本总长度
     const size_t nLineCount = m_lineTextInfo.size();
-    for (size_t nIndex = 0; nIndex < nLineCount; ++nIndex) {
+    for (size_t nIndex = FindCharLine((size_t)nCharIndex, nTextLen); nIndex < nLineCount; ++nIndex) {
         const RichTextLineInfo& lineText = *m_lineTextInfo[nIndex];
         ASSERT(lineText.m_nLineTextLen > 0);
         nTextLen += lineText.m_nLineTextLen;
@@ -2477,7 +2701,57 @@ void RichEditData::EmptyUndoBuffer()
     ClearUndoList();
 }
 
-void RichEditData::AddToUndoList(int32_t nStartChar, const DStringW& newText, const DStringW& oldText)
+void RichEditData::MakeUndoText(size_t nStartLine, size_t nEndLine, size_t nStartOffset, size_t nLength, TUndoText& undoText) const
+{
+    //文本较短，或者引用的行中大部分文本不属于该文本时，复制文本；否则引用行数据
+    const size_t nMinRefLength = 1024;
+    undoText = TUndoText();
+    undoText.m_nLength = (uint32_t)nLength;
+    ASSERT((nStartLine <= nEndLine) && (nEndLine < m_lineTextInfo.size()));
+    if ((nLength == 0) || (nStartLine > nEndLine) || (nEndLine >= m_lineTextInfo.size())) {
+        return;
+    }
+    size_t nLinesLength = 0;
+    for (size_t nIndex = nStartLine; nIndex <= nEndLine; ++nIndex) {
+        nLinesLength += m_lineTextInfo[nIndex]->m_nLineTextLen;
+    }
+    if ((nLength >= nMinRefLength) && (nLinesLength <= nLength * 2)) {
+        undoText.m_lines.assign(m_lineTextInfo.begin() + nStartLine, m_lineTextInfo.begin() + nEndLine + 1);
+        undoText.m_nStartOffset = (uint32_t)nStartOffset;
+        return;
+    }
+    undoText.m_text.reserve(nLength);
+    for (size_t nIndex = nStartLine; (nIndex <= nEndLine) && (undoText.m_text.size() < nLength); ++nIndex) {
+        const RichTextLineInfo& lineText = *m_lineTextInfo[nIndex];
+        std::wstring_view lineView(lineText.m_lineText.c_str(), lineText.m_nLineTextLen);
+        if (nIndex == nStartLine) {
+            lineView = lineView.substr(std::min(nStartOffset, lineView.size()));
+        }
+        undoText.m_text += lineView.substr(0, nLength - undoText.m_text.size());
+    }
+}
+
+DStringW RichEditData::GetUndoText(const TUndoText& undoText)
+{
+    if (undoText.m_lines.empty()) {
+        return undoText.m_text;
+    }
+    DStringW text;
+    text.reserve(undoText.m_nLength);
+    for (const RichTextLineInfoPtr& spLineInfo : undoText.m_lines) {
+        if (text.size() >= undoText.m_nLength) {
+            break;
+        }
+        std::wstring_view lineView(spLineInfo->m_lineText.c_str(), spLineInfo->m_nLineTextLen);
+        if (text.empty()) {
+            lineView = lineView.substr(std::min((size_t)undoText.m_nStartOffset, lineView.size()));
+        }
+        text += lineView.substr(0, undoText.m_nLength - text.size());
+    }
+    return text;
+}
+
+void RichEditData::AddToUndoList(int32_t nStartChar, TUndoText&& newText, TUndoText&& oldText)
 {
     ASSERT(nStartChar >= 0);
     if (nStartChar < 0) {
@@ -2490,8 +2764,8 @@ void RichEditData::AddToUndoList(int32_t nStartChar, const DStringW& newText, co
 
     TUndoData undoData;
     undoData.m_nStartChar = nStartChar;
-    undoData.m_newText = newText;
-    undoData.m_oldText = oldText;
+    undoData.m_newText = std::move(newText);
+    undoData.m_oldText = std::move(oldText);
 
     while (!m_undoList.empty() && (m_undoList.size() >= m_nUndoLimit)) {
         m_undoList.pop_front();
@@ -2517,16 +2791,20 @@ bool RichEditData::Undo(int32_t& nEndCharIndex)
     bool bRet = false;
     if (!m_undoList.empty()) {
         //取出Undo列表尾部的数据
-        TUndoData undoData = m_undoList.back();
+        TUndoData undoData = std::move(m_undoList.back());
         m_undoList.pop_back();
 
+        //执行Undo操作
+        const int32_t nStartChar = undoData.m_nStartChar;
+        const int32_t nOldTextLength = (int32_t)undoData.m_oldText.m_nLength;
+        nEndCharIndex = nStartChar + (int32_t)undoData.m_newText.m_nLength;
+        const DStringW oldText = GetUndoText(undoData.m_oldText);
+
         //添加到redo列表
-        m_redoList.push_back(undoData);
+        m_redoList.push_back(std::move(undoData));
 
-        //执行Undo操作
-        nEndCharIndex = undoData.m_nStartChar + (int32_t)undoData.m_newText.size();
-        bRet = ReplaceText(undoData.m_nStartChar, nEndCharIndex, undoData.m_oldText, false, false);
-        nEndCharIndex = undoData.m_nStartChar + (int32_t)undoData.m_oldText.size();
+        bRet = ReplaceText(nStartChar, nEndCharIndex, oldText, false, false);
+        nEndCharIndex = nStartChar + nOldTextLength;
     }
     if (!bRet) {
         nEndCharIndex = -1;
@@ -2547,16 +2825,20 @@ bool RichEditData::Redo(int32_t& nEndCharIndex)
     bool bRet = false;
     if (!m_redoList.empty()) {
         //取出Redo列表尾部的数据
-        TUndoData undoData = m_redoList.back();
+        TUndoData undoData = std::move(m_redoList.back());
         m_redoList.pop_back();
 
+        //执行Redo操作
+        const int32_t nStartChar = undoData.m_nStartChar;
+        const int32_t nNewTextLength = (int32_t)undoData.m_newText.m_nLength;
+        nEndCharIndex = nStartChar + (int32_t)undoData.m_oldText.m_nLength;
+        const DStringW newText = GetUndoText(undoData.m_newText);
+
         //添加到undo列表
-        m_undoList.push_back(undoData);
+        m_undoList.push_back(std::move(undoData));
 
-        //执行Redo操作
-        nEndCharIndex = undoData.m_nStartChar + (int32_t)undoData.m_oldText.size();
-        bRet = ReplaceText(undoData.m_nStartChar, nEndCharIndex, undoData.m_newText, false, false);
-        nEndCharIndex = undoData.m_nStartChar + (int32_t)undoData.m_newText.size();
+        bRet = ReplaceText(nStartChar, nEndCharIndex, newText, false, false);
+        nEndCharIndex = nStartChar + nNewTextLength;
     }
     if (!bRet) {
         nEndCharIndex = -1;
@@ -2568,6 +2850,9 @@ void RichEditData::Clear()
 {
     RichTextLineInfoList lineTextInfo;
     m_lineTextInfo.swap(lineTextInfo);
+    m_nTextLength = 0;
+    InvalidateLineStartChars(0);
+    CancelPendingTextRects();
     m_spDrawRichTextCache.reset();
     m_rcTextRect.Clear();
 
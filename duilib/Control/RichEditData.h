@@ -58,6 +58,10 @@ public:
     /** 获取文本限制长度
     */
     virtual int32_t GetTextLimitLength() const = 0;
+
+    /** 文本较长时，文字区域分段计算：已经计算了可见部分，其余的行需要稍后调用RichEditData::CalcPendingTextRects继续计算
+    */
+    virtual void OnTextRectsPending() = 0;
 };
 
 class RichEditData
@@ -134,7 +138,7 @@ public:
     */
     DStringW GetText() const;
 
-    /** 获取文本视图，文本视图是按行组织，每行一条数据（以'\n'切分的行）
+    /** 获取文本视图，文本视图是按行组织，每行一条数据（以'\n'切分的行），文本视图引用内部的行数据，不复制文本
     */
     void GetTextView(std::vector<std::wstring_view>& textView) const;
 
@@ -351,6 +355,19 @@ public:
     */
     void CheckCalcTextRects();
 
+    /** 是否有尚未计算文字区域的行（分段计算时，这些行的区域是估算值）
+    */
+    bool IsTextRectsPending() const;
+
+    /** 已经计算过文字区域的行数（从首行开始）
+    */
+    size_t GetCalcTextRectsLineCount() const;
+
+    /** 分段计算文字区域：计算下一段尚未计算的行
+    * @return 如果计算了新的行，返回true
+    */
+    bool CalcPendingTextRects();
+
     /** 按字符数限制，截断文本
     */
     void TruncateLimitText(DStringW& text, int32_t nLimitLen) const;
@@ -380,9 +397,16 @@ private:
     */
     void ClearUndoList();
 
-    /** 记录操作到撤销列表
+    /** 定位字符所在的物理行（按行起始位置索引二分查找）
+    * @param [in] nCharIndex 字符索引位置
+    * @param [out] nLineStartChar 返回行的起始字符下标
+    * @return 返回该字符所在的物理行号；如果字符超出文本范围，返回最后一行；如果没有文本，返回0
+    */
+    size_t FindCharLine(size_t nCharIndex, size_t& nLineStartChar) const;
+
+    /** 行起始位置索引从指定行开始失效（文本有变化时调用）
     */
-    void AddToUndoList(int32_t nStartChar, const DStringW& newText, const DStringW& oldText);
+    void InvalidateLineStartChars(size_t nLineIndex);
 
     /** 从缓存中计算文本所占的矩形区域
     */
@@ -411,6 +435,20 @@ private:
                        const std::vector<size_t>& deletedLines,
                        size_t nDeletedRows);
 
+    /** 分段计算文字区域：计算尚未计算的行，直到指定的行
+    * @param [in] nEndLine 计算到该行为止（不含该行）
+    */
+    void CalcPendingTextRects(size_t nEndLine);
+
+    /** 分段计算文字区域：为尚未计算的行生成估算的行数据（每个物理行一个逻辑行，字符宽度为0，行高按已计算的行估算）
+    * @param [in] nStartLine 从该行开始生成
+    */
+    void MakePendingRowInfo(size_t nStartLine);
+
+    /** 取消分段计算
+    */
+    void CancelPendingTextRects();
+
     /** 定位字符范围所属的行和行文本偏移量
     * @param [in] nStartChar 起始下标值
     * @param [in] nEndChar 结束下标值， nEndChar >= nStartChar
@@ -536,16 +574,64 @@ private:
     */
     bool m_bCacheDirty;
 
+    /** 文本总长度
+    */
+    size_t m_nTextLength;
+
+    /** 分段计算文字区域时，已经计算过的行数（小于m_lineTextInfo的行数时，后面的行是估算的行数据）
+    */
+    size_t m_nCalcTextRectsLines;
+    bool m_bTextRectsPending;
+
+    /** 每个物理行的起始字符下标：只记录前面若干行，文本修改后从修改的行开始失效，查找时按需补充
+    */
+    mutable std::vector<size_t> m_lineStartChars;
+
 private:
+    /** Undo数据中的文本：较长的文本直接引用行数据（行数据的文本创建后不再修改），不复制文本
+    */
+    struct TUndoText
+    {
+        /** 复制的文本（m_lines为空时有效）
+        */
+        DStringW m_text;
+
+        /** 引用的行数据，文本从首行的m_nStartOffset开始
+        */
+        RichTextLineInfoList m_lines;
+        uint32_t m_nStartOffset = 0;
+
+        /** 文本长度
+        */
+        uint32_t m_nLength = 0;
+    };
+
     /** Undo的数据
     */
     struct TUndoData
     {
         int32_t m_nStartChar = -1;
-        DStringW m_newText;
-        DStringW m_oldText;
+        TUndoText m_newText;
+        TUndoText m_oldText;
     };
 
+    /** 生成Undo数据中的文本
+    * @param [in] nStartLine 起始行号
+    * @param [in] nEndLine 结束行号
+    * @param [in] nStartOffset 在起始行中的文本偏移量
+    * @param [in] nLength 文本长度
+    * @param [out] undoText 返回Undo数据中的文本
+    */
+    void MakeUndoText(size_t nStartLine, size_t nEndLine, size_t nStartOffset, size_t nLength, TUndoText& undoText) const;
+
+    /** 获取Undo数据中的文本
+    */
+    static DStringW GetUndoText(const TUndoText& undoText);
+
+    /** 记录操作到撤销列表
+    */
+    void AddToUndoList(int32_t nStartChar, TUndoText&& newText, TUndoText&& oldText);
+
     /** Undo的数据列表
     */
     std::list<TUndoData> m_undoList;
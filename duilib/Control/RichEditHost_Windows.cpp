@@ -2,6 +2,7 @@
 #include "RichEdit_Windows.h"
 #include "duilib/Core/GlobalManager.h"
 #include "duilib/Core/Window.h"
+#include "duilib/Render/RenderCache.h"
 #include "duilib/Utils/StringConvert.h"
 
 #if defined (DUILIB_BUILD_FOR_WIN) && !defined (DUILIB_BUILD_FOR_SDL)
@@ -387,6 +388,7 @@ void RichEditHost::TxInvalidateRect(LPCRECT prc, BOOL /*fMode*/)
     rcRichEdit.Offset(-scrollOffset.x, -scrollOffset.y);
     rc.Intersect(rcRichEdit);
     pWindow->Invalidate(rc);
+    RenderCache::Instance().Invalidate(m_pRichEdit);
 }
 
 void RichEditHost::TxViewChange(BOOL /*fUpdate*/)
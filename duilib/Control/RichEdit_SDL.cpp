@@ -1825,6 +1825,11 @@ void RichEdit::Paint(IRender* pRender, const UiRect& rcPaint)
         //非密码模式，使用绘制缓存来绘制
         std::vector<RichTextData> richTextDataList;
         GetRichTextForDraw(richTextDataList);
+        //文字区域分段计算时，只绘制已经计算过的行
+        const size_t nCalcLineCount = m_pTextData->GetCalcTextRectsLineCount();
+        if (richTextDataList.size() > nCalcLineCount) {
+            richTextDataList.resize(nCalcLineCount);
+        }
 
         std::shared_ptr<DrawRichTextCache> spDrawRichTextCache = m_pTextData->GetDrawRichTextCache();
         if (spDrawRichTextCache != nullptr) {
@@ -3138,6 +3143,21 @@ void RichEdit::OnTextRectsChanged()
     UpdateScrollRange();
 }
 
+void RichEdit::OnTextRectsPending()
+{
+    //在后续的UI线程任务中逐段计算，每段计算完成后更新滚动条的范围（估算值逐步变为准确值）并重绘
+    m_textRectsPendingFlag.Cancel();
+    GlobalManager::Instance().Thread().PostTask(kThreadUI, m_textRectsPendingFlag.ToWeakCallback([this]() {
+            if (m_pTextData->CalcPendingTextRects()) {
+                UpdateScrollRange();
+                Invalidate();
+            }
+            if (m_pTextData->IsTextRectsPending()) {
+                OnTextRectsPending();
+            }
+        }));
+}
+
 int32_t RichEdit::GetTextRowHeight() const
 {
     return m_nRowHeight;
@@ -890,6 +890,10 @@ protected:
     */
     virtual int32_t GetTextLimitLength() const override;
 
+    /** 文字区域分段计算，尚有未计算的行的事件
+    */
+    virtual void OnTextRectsPending() override;
+
     /** 设置可用状态事件
     * @param [in] bChanged true表示状态发生变化，false表示状态未发生变化
     */
@@ -1300,6 +1304,10 @@ private:
     /** 密码字符闪现功能的定时器取消机制
     */
     WeakCallbackFlag m_falshPasswordFlag;
+
+    /** 分段计算文字区域的任务取消机制
+    */
+    WeakCallbackFlag m_textRectsPendingFlag;
 };
 
 } // namespace ui
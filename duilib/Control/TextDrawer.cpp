@@ -15,6 +15,7 @@ TextDrawer::~TextDrawer()
 void TextDrawer::SetTextChanged()
 {
     m_bRichTextChanged = true;
+    m_spDrawStringCache.reset();
 }
 
 void TextDrawer::UpdateTextDrawProps(uint32_t uFormat, float fSpacingMul, float fSpacingAdd, const DString& fontId)
@@ -132,8 +133,8 @@ void TextDrawer::DrawString(IRender* pRender,
         m_pRichText->PaintText(pRender);
     }
     else {
-        //普通文本
-        pRender->DrawString(strText, drawParam);
+        //普通文本（使用文字绘制缓存，文字内容、字体、绘制区域等不变时不需要重新排版）
+        pRender->DrawString(strText, drawParam, m_spDrawStringCache);
     }
 }
 
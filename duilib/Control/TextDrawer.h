@@ -47,7 +47,7 @@ public:
                     bool bRichText,
                     Control* pOwner);
 
-    /** 设置原文本内容发生变化（当文本内容变化时，需要重新解析）
+    /** 设置原文本内容发生变化（当文本内容变化时，需要重新解析，并清除文字绘制缓存）
     */
     void SetTextChanged();
 
@@ -68,6 +68,10 @@ private:
     /** 原文本内容是否发生变化（当文本内容变化时，需要重新解析）
     */
     bool m_bRichTextChanged;
+
+    /** 普通文本的绘制缓存（排版结果）
+    */
+    IDrawStringCachePtr m_spDrawStringCache;
 };
 
 }//namespace ui
@@ -1,6 +1,8 @@
 #include "Box.h"
 #include "duilib/Core/Window.h"
+#include "duilib/Core/HitTestGrid.h"
 #include "duilib/Utils/StringUtil.h"
+#include "duilib/Utils/PerformanceUtil.h"
 
 namespace ui
 {
@@ -109,9 +111,17 @@ void Box::SetWindow(Window* pWindow)
 
 void Box::SetPos(UiRect rc)
 {
+    const UiRect rcOldRect = GetRect();
     Control::SetPos(rc);
     if (m_pLayout != nullptr) {
-        m_pLayout->ArrangeChildren(m_items, rc);    
+        PerformanceTrace traceArrange(_T("Layout::ArrangeChildren"));
+        //只移动位置时，记录移动的偏移量：随容器一起移动的子控件，不需要重新绘制容器的图层
+        const UiRect& rcNewRect = GetRect();
+        if ((rcOldRect.Width() == rcNewRect.Width()) && (rcOldRect.Height() == rcNewRect.Height())) {
+            m_ptArrangeMoveOffset = UiPoint(rcNewRect.left - rcOldRect.left, rcNewRect.top - rcOldRect.top);
+        }
+        m_pLayout->ArrangeChildren(m_items, rc);
+        m_ptArrangeMoveOffset = UiPoint();
     }
 }
 
@@ -304,39 +314,26 @@ Control* Box::FindControlInItems(const std::vector<Control*>& items,
     UiPoint boxPt(ptMouse);
     boxPt.Offset(scrollPos);
     UiRect rc = GetRectWithoutPadding();
-    if ((uFlags & UIFIND_TOP_FIRST) != 0) {
-        //倒序
-        for (int32_t it = (int32_t)items.size() - 1; it >= 0; --it) {
-            if (items[it] == nullptr) {
-                continue;
-            }
-            Control* pControl = items[it]->FindControl(Proc, pProcData, uFlags, boxPt);
-            if (pControl != nullptr) {
-                if ((uFlags & UIFIND_HITTEST) != 0 &&
-                    !pControl->IsFloat() && !rc.ContainsPt(ptMouse)) {
-                    continue;
-                }
-                else {
-                    return pControl;
-                }
-            }
+    //按坐标查找时，子控件的矩形区域必须包含该坐标，子控件较多时使用空间索引过滤
+    std::vector<size_t> hitTestItems;
+    const bool bUseIndex = ((uFlags & UIFIND_HITTEST) != 0) && (&items == &m_items) &&
+                           QueryHitTestIndex(boxPt, hitTestItems);
+    const size_t nCount = bUseIndex ? hitTestItems.size() : items.size();
+    for (size_t n = 0; n < nCount; ++n) {
+        //UIFIND_TOP_FIRST：倒序，否则为正常顺序
+        const size_t nPos = ((uFlags & UIFIND_TOP_FIRST) != 0) ? (nCount - 1 - n) : n;
+        Control* pItemControl = bUseIndex ? items[hitTestItems[nPos]] : items[nPos];
+        if (pItemControl == nullptr) {
+            continue;
         }
-    }
-    else {
-        //正常顺序
-        for (Control* pItemControl : items) {
-            if (pItemControl == nullptr) {
+        Control* pControl = pItemControl->FindControl(Proc, pProcData, uFlags, boxPt);
+        if (pControl != nullptr) {
+            if ((uFlags & UIFIND_HITTEST) != 0 &&
+                !pControl->IsFloat() && !rc.ContainsPt(ptMouse)) {
                 continue;
             }
-            Control* pControl = pItemControl->FindControl(Proc, pProcData, uFlags, boxPt);
-            if (pControl != nullptr) {
-                if ((uFlags & UIFIND_HITTEST) != 0 && 
-                    !pControl->IsFloat() && !rc.ContainsPt(ptMouse)) {
-                    continue;
-                }
-                else {
-                    return pControl;
-                }
+            else {
+                return pControl;
             }
         }
     }
@@ -431,6 +428,7 @@ bool Box::SetItemIndex(Control* pControl, size_t iIndex)
             Arrange();            
             m_items.erase(it);
             m_items.insert(m_items.begin() + iIndex, pControl);
+            OnItemRectChanged();
             return true;
         }
     }
@@ -463,6 +461,7 @@ bool Box::DoAddItemAt(Control* pControl, size_t iIndex)
         return false;
     }
     m_items.insert(m_items.begin() + iIndex, pControl);
+    OnItemRectChanged();
     Window* pWindow = GetWindow();
     if (pWindow != nullptr) {
         pWindow->InitControls(pControl);
@@ -504,6 +503,7 @@ bool Box::DoRemoveItem(Control* pControl)
     for (auto it = m_items.begin(); it != m_items.end(); ++it) {
         if (*it == pControl) {
             m_items.erase(it);
+            OnItemRectChanged();
             if (m_bAutoDestroyChild) {
                 if (pControl) {
                     if (pControl->HasDestroyEventCallback()) {
@@ -523,6 +523,7 @@ void Box::RemoveAllItems()
 {
     std::vector<Control*> items;
     items.swap(m_items);
+    m_pHitTestGrid.reset();
     if (m_bAutoDestroyChild) {
         for(Control* pControl : items) {
             delete pControl;
@@ -533,6 +534,38 @@ void Box::RemoveAllItems()
     }    
 }
 
+void Box::OnItemRectChanged()
+{
+    if (m_pHitTestGrid != nullptr) {
+        m_pHitTestGrid->SetDirty();
+    }
+}
+
+bool Box::QueryHitTestIndex(const UiPoint& pt, std::vector<size_t>& itemIndexs)
+{
+    //子控件数量少于该值时，直接遍历查找
+    const size_t nMinItemCount = 32;
+    Window* pWindow = GetWindow();
+    if ((m_items.size() < nMinItemCount) || (pWindow == nullptr) || !pWindow->IsHitTestIndexEnabled()) {
+        m_pHitTestGrid.reset();
+        return false;
+    }
+    if (m_pHitTestGrid == nullptr) {
+        m_pHitTestGrid = std::make_unique<HitTestGrid>();
+    }
+    if (m_pHitTestGrid->IsDirty() || (m_pHitTestGrid->GetItemCount() != m_items.size())) {
+        //子控件的位置或者子控件列表发生变化后，在首次查找时重建索引
+        std::vector<UiRect> itemRects;
+        itemRects.reserve(m_items.size());
+        for (const Control* pControl : m_items) {
+            itemRects.push_back((pControl != nullptr) ? pControl->GetRect() : UiRect());
+        }
+        m_pHitTestGrid->Build(itemRects);
+    }
+    m_pHitTestGrid->Query(pt, itemIndexs);
+    return true;
+}
+
 Layout* Box::ResetLayout(Layout* pNewLayout)
 {
     ASSERT(pNewLayout != nullptr);
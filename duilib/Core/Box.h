@@ -6,6 +6,8 @@
 
 namespace ui 
 {
+class HitTestGrid;
+
 /** 容器基类(Container)
 */
 class UILIB_API Box : public Control
@@ -50,6 +52,11 @@ public:
     */
     virtual UiRect GetPosWithoutPadding() const;
 
+    /** 获取本容器在SetPos中排列子控件时，容器位置移动的偏移量（容器大小变化或者不在排列子控件时，返回(0,0)）
+    *   子控件移动的偏移量与此相同时，表示子控件随容器一起移动，在容器中的相对位置不变
+    */
+    const UiPoint& GetArrangeMoveOffset() const { return m_ptArrangeMoveOffset; }
+
     /** 获取控件实际可用矩形区域
     *@return 返回控件的实际可用区域，即GetRect剪去Padding后的区域
     */
@@ -203,6 +210,10 @@ public:
     */
     uint8_t GetDragOutId() const;
 
+    /** 子控件的位置发生变化（由PlaceHolder::SetRect调用，标记按坐标查找控件时使用的空间索引需要重建）
+    */
+    void OnItemRectChanged();
+
 protected:
 
     /** 查找控件, 子控件列表由外部传入
@@ -236,6 +247,13 @@ private:
      */
     bool DoRemoveItem(Control* pControl);
 
+    /** 使用空间索引查找矩形区域包含指定坐标的子控件（窗口启用了空间索引，并且子控件数量较多时使用）
+     * @param[in] pt 坐标（已经按容器的滚动条偏移调整）
+     * @param[out] itemIndexs 返回子控件的索引，按索引升序排列
+     * @return 使用了空间索引时返回true，否则返回false（需要遍历所有子控件）
+     */
+    bool QueryHitTestIndex(const UiPoint& pt, std::vector<size_t>& itemIndexs);
+
 protected:
 
     //容器中的子控件列表
@@ -256,6 +274,12 @@ private:
 
     //是否支持拖拽拖出该容器：如果不等于0，支持拖出，否则不支持拖出（拖出到DropInId==DragOutId的容器）
     uint8_t m_nDragOutId;
+
+    //按坐标查找子控件时使用的空间索引（按需创建）
+    std::unique_ptr<HitTestGrid> m_pHitTestGrid;
+
+    //在SetPos中排列子控件时，容器位置移动的偏移量（仅移动位置时有效）
+    UiPoint m_ptArrangeMoveOffset;
 };
 
 } // namespace ui
@@ -9,11 +9,13 @@
 #include "duilib/Image/Image.h"
 #include "duilib/Render/IRender.h"
 #include "duilib/Render/AutoClip.h"
+#include "duilib/Render/RenderCache.h"
 #include "duilib/Animation/AnimationPlayer.h"
 #include "duilib/Animation/AnimationManager.h"
 #include "duilib/Utils/StringConvert.h"
 #include "duilib/Utils/StringUtil.h"
 #include "duilib/Utils/AttributeUtil.h"
+#include "duilib/Utils/AttributeNameTable.h"
 #include "duilib/Utils/PerformanceUtil.h"
 
 #ifdef DUILIB_BUILD_FOR_LUA
@@ -45,7 +47,8 @@ Control::Control(Window* pWindow) :
     m_bShowFocusRect(false),
     m_nPaintOrder(0),
     m_bBordersOnTop(true),
-    m_bMouseEnter(false)
+    m_bMouseEnter(false),
+    m_bLayerCache(false)
 {
 }
 
@@ -54,6 +57,11 @@ Control::~Control()
     //从延迟绘制列表中删除
     GlobalManager::Instance().Image().RemoveDelayPaintData(this);
 
+    //删除图层缓存
+    if (m_bLayerCache) {
+        RenderCache::Instance().RemoveLayer(this);
+    }
+
     //清理动画相关资源，避免定时器再产生回调，引发错误
     if (m_pAnimationData != nullptr) {
         if (m_pAnimationData->m_animationManager != nullptr) {
@@ -84,511 +92,814 @@ DString Control::GetType() const { return DUI_CTR_CONTROL; }
 void Control::SetAttribute(const DString& strName, const DString& strValue)
 {
     ASSERT(GetWindow() != nullptr);//由于需要做DPI感知功能，所以必须先设置关联窗口
-    if (strName == _T("class")) {
-        SetClass(strValue);
-    }
-    else if (strName == _T("halign")) {
-        if (strValue == _T("left")) {
-            SetHorAlignType(HorAlignType::kAlignLeft);
+    //属性名称对应的ID（同一个属性的多个名称对应相同的ID），查表后按ID分发，不需要逐个比较属性名称
+    enum AttributeId : int32_t
+    {
+        kClass, kHalign, kValign, kAlign, kMargin, kPadding, kControlPadding, kBkcolor, kBkcolor2,
+        kBkcolor2Direction, kForeColor, kBorderSize, kBorderDashStyle, kBordersOnTop, kBorderRound,
+        kBoxShadow, kWidth, kHeight, kState, kCursorType, kRenderOffset, kNormalColor, kHotColor,
+        kPushedColor, kDisabledColor, kNormalColorMargin, kHotColorMargin, kPushedColorMargin,
+        kDisabledColorMargin, kNormalColorRound, kHotColorRound, kPushedColorRound, kDisabledColorRound,
+        kBorderColor, kNormalBorderColor, kHotBorderColor, kPushedBorderColor, kDisabledBorderColor,
+        kFocusBorderColor, kLeftBorderSize, kTopBorderSize, kRightBorderSize, kBottomBorderSize, kBkimage,
+        kMinWidth, kMaxWidth, kMinHeight, kMaxHeight, kName, kTooltipText, kTooltipTextId, kTooltipWidth,
+        kDataId, kUserDataId, kEnabled, kMouseEnabled, kKeyboardEnabled, kVisible, kFadeVisible, kFloat,
+        kKeepFloatPos, kCache, kNoFocus, kAlpha, kNormalImage, kHotImage, kPushedImage, kDisabledImage,
+        kForeNormalImage, kForeHotImage, kForePushedImage, kForeDisabledImage, kFadeAlpha, kFadeHot,
+        kFadeWidth, kFadeHeight, kFadeInOutXFromLeft, kFadeInOutXFromRight, kFadeInOutYFromTop,
+        kFadeInOutYFromBottom, kTabStop, kLoading, kShowFocusRect, kFocusRectColor, kPaintOrder,
+        kStartImageAnimation, kStopImageAnimation, kSetImageAnimationFrame, kEnableDragDrop, kEnableDropFile,
+        kDropFileTypes, kRowSpan, kColSpan
+    };
+    static const AttributeNameTable attributeNames = {
+        { _T("class"), kClass },
+        { _T("halign"), kHalign },
+        { _T("valign"), kValign },
+        { _T("align"), kAlign },
+        { _T("margin"), kMargin },
+        { _T("padding"), kPadding },
+        { _T("control_padding"), kControlPadding },
+        { _T("bkcolor"), kBkcolor },
+        { _T("bkcolor2"), kBkcolor2 },
+        { _T("bkcolor2_direction"), kBkcolor2Direction },
+        { _T("fore_color"), kForeColor },
+        { _T("border_size"), kBorderSize }, { _T("bordersize"), kBorderSize },
+        { _T("border_dash_style"), kBorderDashStyle },
+        { _T("borders_on_top"), kBordersOnTop },
+        { _T("border_round"), kBorderRound }, { _T("borderround"), kBorderRound },
+        { _T("box_shadow"), kBoxShadow }, { _T("boxshadow"), kBoxShadow },
+        { _T("width"), kWidth },
+        { _T("height"), kHeight },
+        { _T("state"), kState },
+        { _T("cursor_type"), kCursorType }, { _T("cursortype"), kCursorType },
+        { _T("render_offset"), kRenderOffset }, { _T("renderoffset"), kRenderOffset },
+        { _T("normal_color"), kNormalColor }, { _T("normalcolor"), kNormalColor },
+        { _T("hot_color"), kHotColor }, { _T("hotcolor"), kHotColor },
+        { _T("pushed_color"), kPushedColor }, { _T("pushedcolor"), kPushedColor },
+        { _T("disabled_color"), kDisabledColor }, { _T("disabledcolor"), kDisabledColor },
+        { _T("normal_color_margin"), kNormalColorMargin },
+        { _T("hot_color_margin"), kHotColorMargin },
+        { _T("pushed_color_margin"), kPushedColorMargin },
+        { _T("disabled_color_margin"), kDisabledColorMargin },
+        { _T("normal_color_round"), kNormalColorRound },
+        { _T("hot_color_round"), kHotColorRound },
+        { _T("pushed_color_round"), kPushedColorRound },
+        { _T("disabled_color_round"), kDisabledColorRound },
+        { _T("border_color"), kBorderColor }, { _T("bordercolor"), kBorderColor },
+        { _T("normal_border_color"), kNormalBorderColor },
+        { _T("hot_border_color"), kHotBorderColor },
+        { _T("pushed_border_color"), kPushedBorderColor },
+        { _T("disabled_border_color"), kDisabledBorderColor },
+        { _T("focus_border_color"), kFocusBorderColor },
+        { _T("left_border_size"), kLeftBorderSize }, { _T("leftbordersize"), kLeftBorderSize },
+        { _T("top_border_size"), kTopBorderSize }, { _T("topbordersize"), kTopBorderSize },
+        { _T("right_border_size"), kRightBorderSize }, { _T("rightbordersize"), kRightBorderSize },
+        { _T("bottom_border_size"), kBottomBorderSize }, { _T("bottombordersize"), kBottomBorderSize },
+        { _T("bkimage"), kBkimage },
+        { _T("min_width"), kMinWidth }, { _T("minwidth"), kMinWidth },
+        { _T("max_width"), kMaxWidth }, { _T("maxwidth"), kMaxWidth },
+        { _T("min_height"), kMinHeight }, { _T("minheight"), kMinHeight },
+        { _T("max_height"), kMaxHeight }, { _T("maxheight"), kMaxHeight },
+        { _T("name"), kName },
+        { _T("tooltip_text"), kTooltipText }, { _T("tooltiptext"), kTooltipText },
+        { _T("tooltip_text_id"), kTooltipTextId }, { _T("tooltip_textid"), kTooltipTextId }, { _T("tooltiptextid"), kTooltipTextId },
+        { _T("tooltip_width"), kTooltipWidth },
+        { _T("data_id"), kDataId }, { _T("dataid"), kDataId },
+        { _T("user_data_id"), kUserDataId }, { _T("user_dataid"), kUserDataId },
+        { _T("enabled"), kEnabled },
+        { _T("mouse_enabled"), kMouseEnabled }, { _T("mouse"), kMouseEnabled },
+        { _T("keyboard_enabled"), kKeyboardEnabled }, { _T("keyboard"), kKeyboardEnabled },
+        { _T("visible"), kVisible },
+        { _T("fade_visible"), kFadeVisible }, { _T("fadevisible"), kFadeVisible },
+        { _T("float"), kFloat },
+        { _T("keep_float_pos"), kKeepFloatPos },
+        { _T("cache"), kCache },
+        { _T("no_focus"), kNoFocus }, { _T("nofocus"), kNoFocus },
+        { _T("alpha"), kAlpha },
+        { _T("normal_image"), kNormalImage }, { _T("normalimage"), kNormalImage },
+        { _T("hot_image"), kHotImage }, { _T("hotimage"), kHotImage },
+        { _T("pushed_image"), kPushedImage }, { _T("pushedimage"), kPushedImage },
+        { _T("disabled_image"), kDisabledImage }, { _T("disabledimage"), kDisabledImage },
+        { _T("fore_normal_image"), kForeNormalImage }, { _T("forenormalimage"), kForeNormalImage },
+        { _T("fore_hot_image"), kForeHotImage }, { _T("forehotimage"), kForeHotImage },
+        { _T("fore_pushed_image"), kForePushedImage }, { _T("forepushedimage"), kForePushedImage },
+        { _T("fore_disabled_image"), kForeDisabledImage }, { _T("foredisabledimage"), kForeDisabledImage },
+        { _T("fade_alpha"), kFadeAlpha }, { _T("fadealpha"), kFadeAlpha },
+        { _T("fade_hot"), kFadeHot }, { _T("fadehot"), kFadeHot },
+        { _T("fade_width"), kFadeWidth }, { _T("fadewidth"), kFadeWidth },
+        { _T("fade_height"), kFadeHeight }, { _T("fadeheight"), kFadeHeight },
+        { _T("fade_in_out_x_from_left"), kFadeInOutXFromLeft }, { _T("fadeinoutxfromleft"), kFadeInOutXFromLeft },
+        { _T("fade_in_out_x_from_right"), kFadeInOutXFromRight }, { _T("fadeinoutxfromright"), kFadeInOutXFromRight },
+        { _T("fade_in_out_y_from_top"), kFadeInOutYFromTop }, { _T("fadeinoutyfromtop"), kFadeInOutYFromTop },
+        { _T("fade_in_out_y_from_bottom"), kFadeInOutYFromBottom }, { _T("fadeinoutyfrombottom"), kFadeInOutYFromBottom },
+        { _T("tab_stop"), kTabStop }, { _T("tabstop"), kTabStop },
+        { _T("loading"), kLoading },
+        { _T("show_focus_rect"), kShowFocusRect },
+        { _T("focus_rect_color"), kFocusRectColor },
+        { _T("paint_order"), kPaintOrder },
+        { _T("start_image_animation"), kStartImageAnimation }, { _T("start_gif_play"), kStartImageAnimation },
+        { _T("stop_image_animation"), kStopImageAnimation }, { _T("stop_gif_play"), kStopImageAnimation },
+        { _T("set_image_animation_frame"), kSetImageAnimationFrame },
+        { _T("enable_drag_drop"), kEnableDragDrop },
+        { _T("enable_drop_file"), kEnableDropFile },
+        { _T("drop_file_types"), kDropFileTypes },
+        { _T("row_span"), kRowSpan },
+        { _T("col_span"), kColSpan }
+    };
+    switch (attributeNames.Find(strName)) {
+    case kClass:
+        {
+            SetClass(strValue);
         }
-        else if (strValue == _T("center")) {
-            SetHorAlignType(HorAlignType::kAlignCenter);
+        break;
+    case kHalign:
+        {
+            if (strValue == _T("left")) {
+                SetHorAlignType(HorAlignType::kAlignLeft);
+            }
+            else if (strValue == _T("center")) {
+                SetHorAlignType(HorAlignType::kAlignCenter);
+            }
+            else if (strValue == _T("right")) {
+                SetHorAlignType(HorAlignType::kAlignRight);
+            }
+            else {
+                ASSERT(0);
+            }
         }
-        else if (strValue == _T("right")) {
-            SetHorAlignType(HorAlignType::kAlignRight);
+        break;
+    case kValign:
+        {
+            if (strValue == _T("top")) {
+                SetVerAlignType(VerAlignType::kAlignTop);
+            }
+            else if (strValue == _T("center")) {
+                SetVerAlignType(VerAlignType::kAlignCenter);
+            }
+            else if (strValue == _T("bottom")) {
+                SetVerAlignType(VerAlignType::kAlignBottom);
+            }
+            else {
+                ASSERT(0);
+            }
         }
-        else {
-            ASSERT(0);
+        break;
+    case kAlign:
+        {
+            //水平方向对齐方式
+            if (strValue.find(_T("left")) != DString::npos) {
+                SetHorAlignType(HorAlignType::kAlignLeft);
+            }
+            else if (strValue.find(_T("hcenter")) != DString::npos) {
+                SetHorAlignType(HorAlignType::kAlignCenter);
+            }
+            else if (strValue.find(_T("right")) != DString::npos) {
+                SetHorAlignType(HorAlignType::kAlignRight);
+            }
+            //垂直方向对齐方式
+            if (strValue.find(_T("top")) != DString::npos) {
+                SetVerAlignType(VerAlignType::kAlignTop);
+            }
+            else if (strValue.find(_T("vcenter")) != DString::npos) {
+                SetVerAlignType(VerAlignType::kAlignCenter);
+            }
+            else if (strValue.find(_T("bottom")) != DString::npos) {
+                SetVerAlignType(VerAlignType::kAlignBottom);
+            }
         }
-    }
-    else if (strName == _T("valign")) {
-        if (strValue == _T("top")) {
-            SetVerAlignType(VerAlignType::kAlignTop);
+        break;
+    case kMargin:
+        {
+            UiMargin rcMargin;
+            AttributeUtil::ParseMarginValue(strValue.c_str(), rcMargin);
+            SetMargin(rcMargin, true);
         }
-        else if (strValue == _T("center")) {
-            SetVerAlignType(VerAlignType::kAlignCenter);
+        break;
+    case kPadding:
+        {
+            UiPadding rcPadding;
+            AttributeUtil::ParsePaddingValue(strValue.c_str(), rcPadding);
+            SetPadding(rcPadding, true);
         }
-        else if (strValue == _T("bottom")) {
-            SetVerAlignType(VerAlignType::kAlignBottom);
+        break;
+    case kControlPadding:
+        {
+            SetEnableControlPadding(strValue == _T("true"));
         }
-        else {
-            ASSERT(0);
+        break;
+    case kBkcolor:
+        {
+            //背景色
+            SetBkColor(strValue);
         }
-    }
-    else if (strName == _T("align")) {
-        //水平方向对齐方式
-        if (strValue.find(_T("left")) != DString::npos) {
-            SetHorAlignType(HorAlignType::kAlignLeft);
+        break;
+    case kBkcolor2:
+        {
+            //第二背景色（实现渐变背景色）
+            SetBkColor2(strValue);
         }
-        else if (strValue.find(_T("hcenter")) != DString::npos) {
-            SetHorAlignType(HorAlignType::kAlignCenter);
+        break;
+    case kBkcolor2Direction:
+        {
+            //第二背景色的方向："1": 左->右，"2": 上->下，"3": 左上->右下，"4": 右上->左下
+            SetBkColor2Direction(strValue);
         }
-        else if (strValue.find(_T("right")) != DString::npos) {
-            SetHorAlignType(HorAlignType::kAlignRight);
+        break;
+    case kForeColor:
+        {
+            //前景色
+            SetForeColor(strValue);
         }
-        //垂直方向对齐方式
-        if (strValue.find(_T("top")) != DString::npos) {
-            SetVerAlignType(VerAlignType::kAlignTop);
+        break;
+    case kBorderSize:
+        {
+            //边线宽度
+            DString nValue = strValue;
+            if (nValue.find(_T(',')) == DString::npos) {
+                int32_t nBorderSize = StringUtil::StringToInt32(strValue);
+                if (nBorderSize < 0) {
+                    nBorderSize = 0;
+                }
+                UiRectF rcBorder((float)nBorderSize, (float)nBorderSize, (float)nBorderSize, (float)nBorderSize);
+                SetBorderSize(rcBorder, true);
+            }
+            else {
+                UiMargin rcMargin;
+                AttributeUtil::ParseMarginValue(strValue.c_str(), rcMargin);
+                UiRectF rcBorder((float)rcMargin.left, (float)rcMargin.top, (float)rcMargin.right, (float)rcMargin.bottom);
+                SetBorderSize(rcBorder, true);
+            }
         }
-        else if (strValue.find(_T("vcenter")) != DString::npos) {
-            SetVerAlignType(VerAlignType::kAlignCenter);
+        break;
+    case kBorderDashStyle:
+        {
+            //边线的线形（四个边的边线的线形只能一致，不支持分开设置）
+            IPen::DashStyle dashStyle = IPen::kDashStyleSolid;
+            if (strValue == _T("solid")) {
+                dashStyle = IPen::kDashStyleSolid;
+            }
+            else if (strValue == _T("dash")) {
+                dashStyle = IPen::kDashStyleDash;
+            }
+            else if (strValue == _T("dot")) {
+                dashStyle = IPen::kDashStyleDot;
+            }
+            else if (strValue == _T("dash_dot")) {
+                dashStyle = IPen::kDashStyleDashDot;
+            }
+            else if (strValue == _T("dash_dot_dot")) {
+                dashStyle = IPen::kDashStyleDashDotDot;
+            }
+            SetBorderDashStyle((int8_t)dashStyle);
         }
-        else if (strValue.find(_T("bottom")) != DString::npos) {
-            SetVerAlignType(VerAlignType::kAlignBottom);
+        break;
+    case kBordersOnTop:
+        {
+            //边框是否在顶层（即先绘制子控件，后绘制边框，避免边框被子控件覆盖）
+            SetBordersOnTop(strValue == _T("true"));
         }
-    }
-    else if (strName == _T("margin")) {
-        UiMargin rcMargin;
-        AttributeUtil::ParseMarginValue(strValue.c_str(), rcMargin);
-        SetMargin(rcMargin, true);
-    }
-    else if (strName == _T("padding")) {
-        UiPadding rcPadding;
-        AttributeUtil::ParsePaddingValue(strValue.c_str(), rcPadding);
-        SetPadding(rcPadding, true);
-    }
-    else if (strName == _T("control_padding")) {
-        SetEnableControlPadding(strValue == _T("true"));
-    }
-    else if (strName == _T("bkcolor")) {
-        //背景色
-        SetBkColor(strValue);
-    }
-    else if (strName == _T("bkcolor2")) {
-        //第二背景色（实现渐变背景色）
-        SetBkColor2(strValue);
-    }
-    else if (strName == _T("bkcolor2_direction")) {
-        //第二背景色的方向："1": 左->右，"2": 上->下，"3": 左上->右下，"4": 右上->左下
-        SetBkColor2Direction(strValue);
-    }
-    else if (strName == _T("fore_color")) {
-        //前景色
-        SetForeColor(strValue);
-    }
-    else if ((strName == _T("border_size")) || (strName == _T("bordersize"))) {
-        //边线宽度
-        DString nValue = strValue;
-        if (nValue.find(_T(',')) == DString::npos) {
-            int32_t nBorderSize = StringUtil::StringToInt32(strValue);
-            if (nBorderSize < 0) {
-                nBorderSize = 0;
+        break;
+    case kBorderRound:
+        {
+            //圆角大小
+            UiSize cxyRound;
+            AttributeUtil::ParseSizeValue(strValue.c_str(), cxyRound);
+            SetBorderRound(cxyRound);
+        }
+        break;
+    case kBoxShadow:
+        {
+            SetBoxShadow(strValue);
+        }
+        break;
+    case kWidth:
+        {
+            if (strValue == _T("stretch")) {
+                //宽度为拉伸：由父容器负责分配宽度
+                SetFixedWidth(UiFixedInt::MakeStretch(), true, true);
+            }
+            else if (strValue == _T("auto")) {
+                //宽度为自动：根据控件的文本、图片等自动计算宽度
+                SetFixedWidth(UiFixedInt::MakeAuto(), true, true);
+            }
+            else if (!strValue.empty()) {
+                if (strValue.back() == _T('%')) {
+                    //宽度为拉伸：由父容器负责按百分比分配宽度，比如 width="30%"，代表该控件的宽度期望值为父控件宽度的30%
+                    int32_t iValue = StringUtil::StringToInt32(strValue);
+                    if ((iValue <= 0) || (iValue > 100)) {
+                        iValue = 100;
+                    }
+                    SetFixedWidth(UiFixedInt::MakeStretch(iValue), true, false);
+                }
+                else {
+                    //宽度为固定值
+                    ASSERT(StringUtil::StringToInt32(strValue) >= 0);
+                    SetFixedWidth(UiFixedInt(StringUtil::StringToInt32(strValue)), true, true);
+                }
+            }
+            else {
+                SetFixedWidth(UiFixedInt(0), true, true);
             }
-            UiRectF rcBorder((float)nBorderSize, (float)nBorderSize, (float)nBorderSize, (float)nBorderSize);
-            SetBorderSize(rcBorder, true);
         }
-        else {
+        break;
+    case kHeight:
+        {
+            if (strValue == _T("stretch")) {
+                //高度为拉伸：由父容器负责分配高度
+                SetFixedHeight(UiFixedInt::MakeStretch(), true, true);
+            }
+            else if (strValue == _T("auto")) {
+                //高度为自动：根据控件的文本、图片等自动计算高度
+                SetFixedHeight(UiFixedInt::MakeAuto(), true, true);
+            }
+            else if (!strValue.empty()) {
+                if (strValue.back() == _T('%')) {
+                    //高度为拉伸：由父容器负责按百分比分配高度，比如 height="30%"，代表该控件的高度期望值为父控件高度的30%
+                    int32_t iValue = StringUtil::StringToInt32(strValue);
+                    if ((iValue <= 0) || (iValue > 100)) {
+                        iValue = 100;
+                    }
+                    SetFixedHeight(UiFixedInt::MakeStretch(iValue), true, false);
+                }
+                else {
+                    //高度为固定值
+                    ASSERT(StringUtil::StringToInt32(strValue) >= 0);
+                    SetFixedHeight(UiFixedInt(StringUtil::StringToInt32(strValue)), true, true);
+                }
+            }
+            else {
+                SetFixedHeight(UiFixedInt(0), true, true);
+            }
+        }
+        break;
+    case kState:
+        {
+            if (strValue == _T("normal")) {
+                SetState(kControlStateNormal);
+            }
+            else if (strValue == _T("hot")) {
+                SetState(kControlStateHot);
+            }
+            else if (strValue == _T("pushed")) {
+                SetState(kControlStatePushed);
+            }
+            else if (strValue == _T("disabled")) {
+                SetState(kControlStateDisabled);
+            }
+            else {
+                ASSERT(0);
+            }
+        }
+        break;
+    case kCursorType:
+        {
+            if (strValue == _T("arrow")) {
+                SetCursorType(CursorType::kCursorArrow);
+            }
+            else if (strValue == _T("ibeam")) {
+                SetCursorType(CursorType::kCursorIBeam);
+            }
+            else if (strValue == _T("hand")) {
+                SetCursorType(CursorType::kCursorHand);
+            }
+            else if (strValue == _T("wait")) {
+                SetCursorType(CursorType::kCursorWait);
+            }
+            else if (strValue == _T("cross")) {
+                SetCursorType(CursorType::kCursorCross);
+            }
+            else if (strValue == _T("size_we")) {
+                SetCursorType(CursorType::kCursorSizeWE);
+            }
+            else if (strValue == _T("size_ns")) {
+                SetCursorType(CursorType::kCursorSizeNS);
+            }
+            else if (strValue == _T("size_nwse")) {
+                SetCursorType(CursorType::kCursorSizeNWSE);
+            }
+            else if (strValue == _T("size_nesw")) {
+                SetCursorType(CursorType::kCursorSizeNESW);
+            }
+            else if (strValue == _T("size_all")) {
+                SetCursorType(CursorType::kCursorSizeAll);
+            }
+            else if (strValue == _T("no")) {
+                SetCursorType(CursorType::kCursorNo);
+            }
+            else if (strValue == _T("progress")) {
+                SetCursorType(CursorType::kCursorProgress);
+            }
+            else {
+                ASSERT(0);
+            }
+        }
+        break;
+    case kRenderOffset:
+        {
+            UiPoint renderOffset;
+            AttributeUtil::ParsePointValue(strValue.c_str(), renderOffset);
+            SetRenderOffset(renderOffset, true);
+        }
+        break;
+    case kNormalColor:
+        {
+            SetStateColor(kControlStateNormal, strValue);
+        }
+        break;
+    case kHotColor:
+        {
+            SetStateColor(kControlStateHot, strValue);
+        }
+        break;
+    case kPushedColor:
+        {
+            SetStateColor(kControlStatePushed, strValue);
+        }
+        break;
+    case kDisabledColor:
+        {
+            SetStateColor(kControlStateDisabled, strValue);
+        }
+        break;
+    case kNormalColorMargin:
+        {
             UiMargin rcMargin;
             AttributeUtil::ParseMarginValue(strValue.c_str(), rcMargin);
-            UiRectF rcBorder((float)rcMargin.left, (float)rcMargin.top, (float)rcMargin.right, (float)rcMargin.bottom);
-            SetBorderSize(rcBorder, true);
+            SetStateColorMargin(kControlStateNormal, rcMargin, true);
         }
-    }
-    else if (strName == _T("border_dash_style")) {
-        //边线的线形（四个边的边线的线形只能一致，不支持分开设置）
-        IPen::DashStyle dashStyle = IPen::kDashStyleSolid;
-        if (strValue == _T("solid")) {
-            dashStyle = IPen::kDashStyleSolid;
+        break;
+    case kHotColorMargin:
+        {
+            UiMargin rcMargin;
+            AttributeUtil::ParseMarginValue(strValue.c_str(), rcMargin);
+            SetStateColorMargin(kControlStateHot, rcMargin, true);
         }
-        else if (strValue == _T("dash")) {
-            dashStyle = IPen::kDashStyleDash;
+        break;
+    case kPushedColorMargin:
+        {
+            UiMargin rcMargin;
+            AttributeUtil::ParseMarginValue(strValue.c_str(), rcMargin);
+            SetStateColorMargin(kControlStatePushed, rcMargin, true);
         }
-        else if (strValue == _T("dot")) {
-            dashStyle = IPen::kDashStyleDot;
+        break;
+    case kDisabledColorMargin:
+        {
+            UiMargin rcMargin;
+            AttributeUtil::ParseMarginValue(strValue.c_str(), rcMargin);
+            SetStateColorMargin(kControlStateDisabled, rcMargin, true);
         }
-        else if (strValue == _T("dash_dot")) {
-            dashStyle = IPen::kDashStyleDashDot;
+        break;
+    case kNormalColorRound:
+        {
+            UiSize szRound;
+            AttributeUtil::ParseSizeValue(strValue.c_str(), szRound);
+            SetStateColorRound(kControlStateNormal, szRound, true);
         }
-        else if (strValue == _T("dash_dot_dot")) {
-            dashStyle = IPen::kDashStyleDashDotDot;
+        break;
+    case kHotColorRound:
+        {
+            UiSize szRound;
+            AttributeUtil::ParseSizeValue(strValue.c_str(), szRound);
+            SetStateColorRound(kControlStateHot, szRound, true);
         }
-        SetBorderDashStyle((int8_t)dashStyle);
-    }
-    else if (strName == _T("borders_on_top")) {
-        //边框是否在顶层（即先绘制子控件，后绘制边框，避免边框被子控件覆盖）
-        SetBordersOnTop(strValue == _T("true"));
-    }
-    else if ((strName == _T("border_round")) || (strName == _T("borderround"))) {
-        //圆角大小
-        UiSize cxyRound;
-        AttributeUtil::ParseSizeValue(strValue.c_str(), cxyRound);
-        SetBorderRound(cxyRound);
-    }
-    else if ((strName == _T("box_shadow")) || (strName == _T("boxshadow"))) {
-        SetBoxShadow(strValue);
-    }
-    else if (strName == _T("width")) {
-        if (strValue == _T("stretch")) {
-            //宽度为拉伸：由父容器负责分配宽度
-            SetFixedWidth(UiFixedInt::MakeStretch(), true, true);
+        break;
+    case kPushedColorRound:
+        {
+            UiSize szRound;
+            AttributeUtil::ParseSizeValue(strValue.c_str(), szRound);
+            SetStateColorRound(kControlStatePushed, szRound, true);
         }
-        else if (strValue == _T("auto")) {
-            //宽度为自动：根据控件的文本、图片等自动计算宽度
-            SetFixedWidth(UiFixedInt::MakeAuto(), true, true);
+        break;
+    case kDisabledColorRound:
+        {
+            UiSize szRound;
+            AttributeUtil::ParseSizeValue(strValue.c_str(), szRound);
+            SetStateColorRound(kControlStateDisabled, szRound, true);
         }
-        else if (!strValue.empty()) {
-            if (strValue.back() == _T('%')) {
-                //宽度为拉伸：由父容器负责按百分比分配宽度，比如 width="30%"，代表该控件的宽度期望值为父控件宽度的30%
-                int32_t iValue = StringUtil::StringToInt32(strValue);
-                if ((iValue <= 0) || (iValue > 100)) {
-                    iValue = 100;
-                }
-                SetFixedWidth(UiFixedInt::MakeStretch(iValue), true, false);
-            }
-            else {
-                //宽度为固定值
-                ASSERT(StringUtil::StringToInt32(strValue) >= 0);
-                SetFixedWidth(UiFixedInt(StringUtil::StringToInt32(strValue)), true, true);
-            }
+        break;
+    case kBorderColor:
+        {
+            SetBorderColor(strValue);
         }
-        else {
-            SetFixedWidth(UiFixedInt(0), true, true);
+        break;
+    case kNormalBorderColor:
+        {
+            SetBorderColor(kControlStateNormal, strValue);
         }
-    }
-    else if (strName == _T("height")) {
-        if (strValue == _T("stretch")) {
-            //高度为拉伸：由父容器负责分配高度
-            SetFixedHeight(UiFixedInt::MakeStretch(), true, true);
+        break;
+    case kHotBorderColor:
+        {
+            SetBorderColor(kControlStateHot, strValue);
+        }
+        break;
+    case kPushedBorderColor:
+        {
+            SetBorderColor(kControlStatePushed, strValue);
+        }
+        break;
+    case kDisabledBorderColor:
+        {
+            SetBorderColor(kControlStateDisabled, strValue);
+        }
+        break;
+    case kFocusBorderColor:
+        {
+            SetFocusBorderColor(strValue);
+        }
+        break;
+    case kLeftBorderSize:
+        {
+            SetLeftBorderSize((float)StringUtil::StringToInt32(strValue), true);
+        }
+        break;
+    case kTopBorderSize:
+        {
+            SetTopBorderSize((float)StringUtil::StringToInt32(strValue), true);
+        }
+        break;
+    case kRightBorderSize:
+        {
+            SetRightBorderSize((float)StringUtil::StringToInt32(strValue), true);
+        }
+        break;
+    case kBottomBorderSize:
+        {
+            SetBottomBorderSize((float)StringUtil::StringToInt32(strValue), true);
+        }
+        break;
+    case kBkimage:
+        {
+            SetBkImage(strValue);
+        }
+        break;
+    case kMinWidth:
+        {
+            SetMinWidth(StringUtil::StringToInt32(strValue), true);
+        }
+        break;
+    case kMaxWidth:
+        {
+            SetMaxWidth(StringUtil::StringToInt32(strValue), true);
+        }
+        break;
+    case kMinHeight:
+        {
+            SetMinHeight(StringUtil::StringToInt32(strValue), true);
+        }
+        break;
+    case kMaxHeight:
+        {
+            SetMaxHeight(StringUtil::StringToInt32(strValue), true);
+        }
+        break;
+    case kName:
+        {
+            SetName(strValue);
+        }
+        break;
+    case kTooltipText:
+        {
+            SetToolTipText(strValue);
+        }
+        break;
+    case kTooltipTextId:
+        {
+            SetToolTipTextId(strValue);
+        }
+        break;
+    case kTooltipWidth:
+        {
+            SetToolTipWidth(StringUtil::StringToInt32(strValue), true);
+        }
+        break;
+    case kDataId:
+        {
+            SetDataID(strValue);
+        }
+        break;
+    case kUserDataId:
+        {
+            SetUserDataID(StringUtil::StringToInt32(strValue));
         }
-        else if (strValue == _T("auto")) {
-            //高度为自动：根据控件的文本、图片等自动计算高度
-            SetFixedHeight(UiFixedInt::MakeAuto(), true, true);
+        break;
+    case kEnabled:
+        {
+            SetEnabled(strValue == _T("true"));
+        }
+        break;
+    case kMouseEnabled:
+        {
+            SetMouseEnabled(strValue == _T("true"));
+        }
+        break;
+    case kKeyboardEnabled:
+        {
+            SetKeyboardEnabled(strValue == _T("true"));
+        }
+        break;
+    case kVisible:
+        {
+            SetVisible(strValue == _T("true"));
+        }
+        break;
+    case kFadeVisible:
+        {
+            SetFadeVisible(strValue == _T("true"));
+        }
+        break;
+    case kFloat:
+        {
+            SetFloat(strValue == _T("true"));
+        }
+        break;
+    case kKeepFloatPos:
+        {
+            SetKeepFloatPos(strValue == _T("true"));
+        }
+        break;
+    case kCache:
+        {
+            SetLayerCacheEnabled(strValue == _T("true"));
+        }
+        break;
+    case kNoFocus:
+        {
+            SetNoFocus();
+        }
+        break;
+    case kAlpha:
+        {
+            SetAlpha(StringUtil::StringToInt32(strValue));
+        }
+        break;
+    case kNormalImage:
+        {
+            SetStateImage(kControlStateNormal, strValue);
+        }
+        break;
+    case kHotImage:
+        {
+            SetStateImage(kControlStateHot, strValue);
+        }
+        break;
+    case kPushedImage:
+        {
+            SetStateImage(kControlStatePushed, strValue);
+        }
+        break;
+    case kDisabledImage:
+        {
+            SetStateImage(kControlStateDisabled, strValue);
         }
-        else if (!strValue.empty()) {
-            if (strValue.back() == _T('%')) {
-                //高度为拉伸：由父容器负责按百分比分配高度，比如 height="30%"，代表该控件的高度期望值为父控件高度的30%
-                int32_t iValue = StringUtil::StringToInt32(strValue);
-                if ((iValue <= 0) || (iValue > 100)) {
-                    iValue = 100;
+        break;
+    case kForeNormalImage:
+        {
+            SetForeStateImage(kControlStateNormal, strValue);
+        }
+        break;
+    case kForeHotImage:
+        {
+            SetForeStateImage(kControlStateHot, strValue);
+        }
+        break;
+    case kForePushedImage:
+        {
+            SetForeStateImage(kControlStatePushed, strValue);
+        }
+        break;
+    case kForeDisabledImage:
+        {
+            SetForeStateImage(kControlStateDisabled, strValue);
+        }
+        break;
+    case kFadeAlpha:
+        {
+            bool bFadeVisible = strValue != _T("false");
+            int32_t nEndAlpha = GetAlpha();
+            if (bFadeVisible) {
+                if (strValue != _T("true")) {
+                    nEndAlpha = StringUtil::StringToInt32(strValue);
                 }
-                SetFixedHeight(UiFixedInt::MakeStretch(iValue), true, false);
-            }
-            else {
-                //高度为固定值
-                ASSERT(StringUtil::StringToInt32(strValue) >= 0);
-                SetFixedHeight(UiFixedInt(StringUtil::StringToInt32(strValue)), true, true);
             }
+            GetAnimationManager().SetFadeAlpha(bFadeVisible, nEndAlpha);
         }
-        else {
-            SetFixedHeight(UiFixedInt(0), true, true);
+        break;
+    case kFadeHot:
+        {
+            GetAnimationManager().SetFadeHot(strValue == _T("true"));
         }
-    }
-    else if (strName == _T("state")) {
-        if (strValue == _T("normal")) {
-            SetState(kControlStateNormal);
+        break;
+    case kFadeWidth:
+        {
+            GetAnimationManager().SetFadeWidth(strValue == _T("true"));
         }
-        else if (strValue == _T("hot")) {
-            SetState(kControlStateHot);
+        break;
+    case kFadeHeight:
+        {
+            GetAnimationManager().SetFadeHeight(strValue == _T("true"));
         }
-        else if (strValue == _T("pushed")) {
-            SetState(kControlStatePushed);
+        break;
+    case kFadeInOutXFromLeft:
+        {
+            GetAnimationManager().SetFadeInOutX(strValue == _T("true"), false);
         }
-        else if (strValue == _T("disabled")) {
-            SetState(kControlStateDisabled);
+        break;
+    case kFadeInOutXFromRight:
+        {
+            GetAnimationManager().SetFadeInOutX(strValue == _T("true"), true);
         }
-        else {
-            ASSERT(0);
+        break;
+    case kFadeInOutYFromTop:
+        {
+            GetAnimationManager().SetFadeInOutY(strValue == _T("true"), false);
         }
-    }
-    else if ((strName == _T("cursor_type")) || (strName == _T("cursortype"))) {
-        if (strValue == _T("arrow")) {
-            SetCursorType(CursorType::kCursorArrow);
+        break;
+    case kFadeInOutYFromBottom:
+        {
+            GetAnimationManager().SetFadeInOutY(strValue == _T("true"), true);
         }
-        else if (strValue == _T("ibeam")) {
-            SetCursorType(CursorType::kCursorIBeam);
+        break;
+    case kTabStop:
+        {
+            SetTabStop(strValue == _T("true"));
         }
-        else if (strValue == _T("hand")) {
-            SetCursorType(CursorType::kCursorHand);
+        break;
+    case kLoading:
+        {
+            SetLoadingAttribute(strValue);
         }
-        else if (strValue == _T("wait")) {
-            SetCursorType(CursorType::kCursorWait);
+        break;
+    case kShowFocusRect:
+        {
+            SetShowFocusRect(strValue == _T("true"));
         }
-        else if (strValue == _T("cross")) {
-            SetCursorType(CursorType::kCursorCross);
+        break;
+    case kFocusRectColor:
+        {
+            SetFocusRectColor(strValue);
         }
-        else if (strValue == _T("size_we")) {
-            SetCursorType(CursorType::kCursorSizeWE);
+        break;
+    case kPaintOrder:
+        {
+            uint8_t nPaintOrder = TruncateToUInt8(StringUtil::StringToInt32(strValue));
+            SetPaintOrder(nPaintOrder);
         }
-        else if (strValue == _T("size_ns")) {
-            SetCursorType(CursorType::kCursorSizeNS);
+        break;
+    case kStartImageAnimation:
+        {
+            ParseStartImageAnimation(strValue);
         }
-        else if (strValue == _T("size_nwse")) {
-            SetCursorType(CursorType::kCursorSizeNWSE);
+        break;
+    case kStopImageAnimation:
+        {
+            ParseStopImageAnimation(strValue);
         }
-        else if (strValue == _T("size_nesw")) {
-            SetCursorType(CursorType::kCursorSizeNESW);
+        break;
+    case kSetImageAnimationFrame:
+        {
+            ParseSetImageAnimationFrame(strValue);
         }
-        else if (strValue == _T("size_all")) {
-            SetCursorType(CursorType::kCursorSizeAll);
+        break;
+    case kEnableDragDrop:
+        {
+            //是否允许拖放操作
+            SetEnableDragDrop(strValue == _T("true"));
         }
-        else if (strValue == _T("no")) {
-            SetCursorType(CursorType::kCursorNo);
+        break;
+    case kEnableDropFile:
+        {
+            //是否允许拖放文件操作
+            SetEnableDropFile(strValue == _T("true"));
         }
-        else if (strValue == _T("progress")) {
-            SetCursorType(CursorType::kCursorProgress);
+        break;
+    case kDropFileTypes:
+        {
+            //拖放文件的扩展名列表
+            SetDropFileTypes(strValue);
         }
-        else {
-            ASSERT(0);
+        break;
+    case kRowSpan:
+        {
+            //设置单元格合并属性（占几行），仅在GridLayout布局中生效
+            SetRowSpan(StringUtil::StringToInt32(strValue));
         }
-    }
-    else if ((strName == _T("render_offset")) || (strName == _T("renderoffset"))) {
-        UiPoint renderOffset;
-        AttributeUtil::ParsePointValue(strValue.c_str(), renderOffset);
-        SetRenderOffset(renderOffset, true);
-    }
-    else if ((strName == _T("normal_color")) || (strName == _T("normalcolor"))) {
-        SetStateColor(kControlStateNormal, strValue);
-    }
-    else if ((strName == _T("hot_color")) || (strName == _T("hotcolor"))) {
-        SetStateColor(kControlStateHot, strValue);
-    }
-    else if ((strName == _T("pushed_color")) || (strName == _T("pushedcolor"))) {
-        SetStateColor(kControlStatePushed, strValue);
-    }
-    else if ((strName == _T("disabled_color")) || (strName == _T("disabledcolor"))) {
-        SetStateColor(kControlStateDisabled, strValue);
-    }
-    else if (strName == _T("normal_color_margin")) {
-        UiMargin rcMargin;
-        AttributeUtil::ParseMarginValue(strValue.c_str(), rcMargin);
-        SetStateColorMargin(kControlStateNormal, rcMargin, true);
-    }
-    else if (strName == _T("hot_color_margin")) {
-        UiMargin rcMargin;
-        AttributeUtil::ParseMarginValue(strValue.c_str(), rcMargin);
-        SetStateColorMargin(kControlStateHot, rcMargin, true);
-    }
-    else if (strName == _T("pushed_color_margin")) {
-        UiMargin rcMargin;
-        AttributeUtil::ParseMarginValue(strValue.c_str(), rcMargin);
-        SetStateColorMargin(kControlStatePushed, rcMargin, true);
-    }
-    else if (strName == _T("disabled_color_margin")) {
-        UiMargin rcMargin;
-        AttributeUtil::ParseMarginValue(strValue.c_str(), rcMargin);
-        SetStateColorMargin(kControlStateDisabled, rcMargin, true);
-    }
-    else if (strName == _T("normal_color_round")) {
-        UiSize szRound;
-        AttributeUtil::ParseSizeValue(strValue.c_str(), szRound);
-        SetStateColorRound(kControlStateNormal, szRound, true);
-    }
-    else if (strName == _T("hot_color_round")) {
-        UiSize szRound;
-        AttributeUtil::ParseSizeValue(strValue.c_str(), szRound);
-        SetStateColorRound(kControlStateHot, szRound, true);
-    }
-    else if (strName == _T("pushed_color_round")) {
-        UiSize szRound;
-        AttributeUtil::ParseSizeValue(strValue.c_str(), szRound);
-        SetStateColorRound(kControlStatePushed, szRound, true);
-    }
-    else if (strName == _T("disabled_color_round")) {
-        UiSize szRound;
-        AttributeUtil::ParseSizeValue(strValue.c_str(), szRound);
-        SetStateColorRound(kControlStateDisabled, szRound, true);
-    }
-    else if ((strName == _T("border_color")) || (strName == _T("bordercolor"))) {
-        SetBorderColor(strValue);
-    }
-    else if (strName == _T("normal_border_color")) {
-        SetBorderColor(kControlStateNormal, strValue);
-    }
-    else if (strName == _T("hot_border_color")) {
-        SetBorderColor(kControlStateHot, strValue);
-    }
-    else if (strName == _T("pushed_border_color")) {
-        SetBorderColor(kControlStatePushed, strValue);
-    }
-    else if (strName == _T("disabled_border_color")) {
-        SetBorderColor(kControlStateDisabled, strValue);
-    }
-    else if (strName == _T("focus_border_color")) {
-        SetFocusBorderColor(strValue);
-    }
-    else if ((strName == _T("left_border_size")) || (strName == _T("leftbordersize"))) {
-        SetLeftBorderSize((float)StringUtil::StringToInt32(strValue), true);
-    }
-    else if ((strName == _T("top_border_size")) || (strName == _T("topbordersize"))) {
-        SetTopBorderSize((float)StringUtil::StringToInt32(strValue), true);
-    }
-    else if ((strName == _T("right_border_size")) || (strName == _T("rightbordersize"))) {
-        SetRightBorderSize((float)StringUtil::StringToInt32(strValue), true);
-    }
-    else if ((strName == _T("bottom_border_size")) || (strName == _T("bottombordersize"))) {
-        SetBottomBorderSize((float)StringUtil::StringToInt32(strValue), true);
-    }
-    else if (strName == _T("bkimage")) {
-        SetBkImage(strValue);
-    }
-    else if ((strName == _T("min_width")) || (strName == _T("minwidth"))) {
-        SetMinWidth(StringUtil::StringToInt32(strValue), true);
-    }
-    else if ((strName == _T("max_width")) || (strName == _T("maxwidth"))) {
-        SetMaxWidth(StringUtil::StringToInt32(strValue), true);
-    }
-    else if ((strName == _T("min_height")) || (strName == _T("minheight"))) {
-        SetMinHeight(StringUtil::StringToInt32(strValue), true);
-    }
-    else if ((strName == _T("max_height")) || (strName == _T("maxheight"))) {
-        SetMaxHeight(StringUtil::StringToInt32(strValue), true);
-    }
-    else if (strName == _T("name")) {
-        SetName(strValue);
-    }
-    else if ((strName == _T("tooltip_text")) || (strName == _T("tooltiptext"))) {
-        SetToolTipText(strValue);
-    }
-    else if ((strName == _T("tooltip_text_id")) || (strName == _T("tooltip_textid")) || (strName == _T("tooltiptextid"))) {
-        SetToolTipTextId(strValue);
-    }
-    else if (strName == _T("tooltip_width")) {
-        SetToolTipWidth(StringUtil::StringToInt32(strValue), true);
-    }
-    else if ((strName == _T("data_id")) || (strName == _T("dataid"))) {
-        SetDataID(strValue);
-    }
-    else if ((strName == _T("user_data_id")) || (strName == _T("user_dataid"))) {
-        SetUserDataID(StringUtil::StringToInt32(strValue));
-    }
-    else if (strName == _T("enabled")) {
-        SetEnabled(strValue == _T("true"));
-    }
-    else if ((strName == _T("mouse_enabled")) || (strName == _T("mouse"))) {
-        SetMouseEnabled(strValue == _T("true"));
-    }
-    else if ((strName == _T("keyboard_enabled")) || (strName == _T("keyboard"))) {
-        SetKeyboardEnabled(strValue == _T("true"));
-    }
-    else if (strName == _T("visible")) {
-        SetVisible(strValue == _T("true"));
-    }
-    else if ((strName == _T("fade_visible")) || (strName == _T("fadevisible"))) {
-        SetFadeVisible(strValue == _T("true"));
-    }
-    else if (strName == _T("float")) {
-        SetFloat(strValue == _T("true"));
-    }
-    else if (strName == _T("keep_float_pos")) {
-        SetKeepFloatPos(strValue == _T("true"));
-    }
-    else if (strName == _T("cache")) {
-        //忽略该选项：对应功能已经删除
-    }
-    else if ((strName == _T("no_focus")) || (strName == _T("nofocus"))) {
-        SetNoFocus();
-    }
-    else if (strName == _T("alpha")) {
-        SetAlpha(StringUtil::StringToInt32(strValue));
-    }
-    else if ((strName == _T("normal_image")) || (strName == _T("normalimage"))) {
-        SetStateImage(kControlStateNormal, strValue);
-    }
-    else if ((strName == _T("hot_image")) || (strName == _T("hotimage"))) {
-        SetStateImage(kControlStateHot, strValue);
-    }
-    else if ((strName == _T("pushed_image")) || (strName == _T("pushedimage"))) {
-        SetStateImage(kControlStatePushed, strValue);
-    }
-    else if ((strName == _T("disabled_image")) || (strName == _T("disabledimage"))) {
-        SetStateImage(kControlStateDisabled, strValue);
-    }
-    else if ((strName == _T("fore_normal_image")) || (strName == _T("forenormalimage"))) {
-        SetForeStateImage(kControlStateNormal, strValue);
-    }
-    else if ((strName == _T("fore_hot_image")) || (strName == _T("forehotimage"))) {
-        SetForeStateImage(kControlStateHot, strValue);
-    }
-    else if ((strName == _T("fore_pushed_image")) || (strName == _T("forepushedimage"))) {
-        SetForeStateImage(kControlStatePushed, strValue);
-    }
-    else if ((strName == _T("fore_disabled_image")) || (strName == _T("foredisabledimage"))) {
-        SetForeStateImage(kControlStateDisabled, strValue);
-    }
-    else if ((strName == _T("fade_alpha")) || (strName == _T("fadealpha"))) {
-        bool bFadeVisible = strValue != _T("false");
-        int32_t nEndAlpha = GetAlpha();
-        if (bFadeVisible) {
-            if (strValue != _T("true")) {
-                nEndAlpha = StringUtil::StringToInt32(strValue);
-            }
+        break;
+    case kColSpan:
+        {
+            //设置单元格合并属性（占几列），仅在GridLayout布局中生效
+            SetColumnSpan(StringUtil::StringToInt32(strValue));
         }
-        GetAnimationManager().SetFadeAlpha(bFadeVisible, nEndAlpha);
-    }
-    else if ((strName == _T("fade_hot")) || (strName == _T("fadehot"))) {
-        GetAnimationManager().SetFadeHot(strValue == _T("true"));
-    }
-    else if ((strName == _T("fade_width")) || (strName == _T("fadewidth"))) {
-        GetAnimationManager().SetFadeWidth(strValue == _T("true"));
-    }
-    else if ((strName == _T("fade_height")) || (strName == _T("fadeheight"))) {
-        GetAnimationManager().SetFadeHeight(strValue == _T("true"));
-    }
-    else if ((strName == _T("fade_in_out_x_from_left")) || (strName == _T("fadeinoutxfromleft"))) {
-        GetAnimationManager().SetFadeInOutX(strValue == _T("true"), false);
-    }
-    else if ((strName == _T("fade_in_out_x_from_right")) || (strName == _T("fadeinoutxfromright"))) {
-        GetAnimationManager().SetFadeInOutX(strValue == _T("true"), true);
-    }
-    else if ((strName == _T("fade_in_out_y_from_top")) || (strName == _T("fadeinoutyfromtop"))) {
-        GetAnimationManager().SetFadeInOutY(strValue == _T("true"), false);
-    }
-    else if ((strName == _T("fade_in_out_y_from_bottom")) || (strName == _T("fadeinoutyfrombottom"))) {
-        GetAnimationManager().SetFadeInOutY(strValue == _T("true"), true);
-    }
-    else if ((strName == _T("tab_stop")) || (strName == _T("tabstop"))) {
-        SetTabStop(strValue == _T("true"));
-    }
-    else if (strName == _T("loading")) {
-        SetLoadingAttribute(strValue);
-    }
-    else if (strName == _T("show_focus_rect")) {
-        SetShowFocusRect(strValue == _T("true"));
-    }
-    else if (strName == _T("focus_rect_color")) {
-        SetFocusRectColor(strValue);
-    }
-    else if (strName == _T("paint_order")) {
-        uint8_t nPaintOrder = TruncateToUInt8(StringUtil::StringToInt32(strValue));
-        SetPaintOrder(nPaintOrder);
-    }
-    else if ((strName == _T("start_image_animation")) || (strName == _T("start_gif_play"))) {
-        ParseStartImageAnimation(strValue);
-    }
-    else if ((strName == _T("stop_image_animation")) || (strName == _T("stop_gif_play"))) {
-        ParseStopImageAnimation(strValue);
-    }
-    else if (strName == _T("set_image_animation_frame")) {
-        ParseSetImageAnimationFrame(strValue);
-    }
-    else if (strName == _T("enable_drag_drop")) {
-        //是否允许拖放操作
-        SetEnableDragDrop(strValue == _T("true"));
-    }
-    else if (strName == _T("enable_drop_file")) {
-        //是否允许拖放文件操作
-        SetEnableDropFile(strValue == _T("true"));
-    }
-    else if (strName == _T("drop_file_types")) {
-        //拖放文件的扩展名列表
-        SetDropFileTypes(strValue);
-    }
-    else if (strName == _T("row_span")) {
-        //设置单元格合并属性（占几行），仅在GridLayout布局中生效
-        SetRowSpan(StringUtil::StringToInt32(strValue));
-    }
-    else if (strName == _T("col_span")) {
-        //设置单元格合并属性（占几列），仅在GridLayout布局中生效
-        SetColumnSpan(StringUtil::StringToInt32(strValue));
-    }
+        break;
+    default:
 #ifdef DUILIB_BUILD_FOR_LUA
-    else if (strName.find(_T("lua_on")) == 0) {
-        DString eventName = strName.substr(6);
-        AttachLuaEvent(eventName, strValue);
-    }
+        if (strName.find(_T("lua_on")) == 0) {
+            DString eventName = strName.substr(6);
+            AttachLuaEvent(eventName, strValue);
+            break;
+        }
 #endif
-    else {
         ASSERT(!"Control::SetAttribute failed: unknown attribute");
+        break;
     }
 }
 
@@ -2017,6 +2328,7 @@ void Control::SetPos(UiRect rc)
     std::weak_ptr<WeakFlag> weakFlag = GetWeakFlag();
     bool bPosChanged = (GetRect().Left() != rc.Left()) || (GetRect().Top() != rc.Top());
     bool bSizeChanged = (GetRect().Width() != rc.Width()) || (GetRect().Height() != rc.Height());
+    const UiPoint ptMoveOffset(rc.left - GetRect().left, rc.top - GetRect().top);
 
     UiRect rcOldRect = GetRect();
     if (rcOldRect.IsEmpty()) {
@@ -2056,6 +2368,15 @@ void Control::SetPos(UiRect rc)
     if (needInvalidate && (GetWindow() != nullptr)) {
         GetWindow()->Invalidate(rcInvalidateRect);
     }
+    if (bSizeChanged) {
+        //大小变化：本控件及祖先控件的图层都需要重新绘制
+        RenderCache::Instance().Invalidate(this);
+    }
+    else if (bPosChanged && (GetParent() != nullptr) && (GetParent()->GetArrangeMoveOffset() != ptMoveOffset)) {
+        //只移动了位置：本控件的图层按控件自身的坐标绘制，内容不变，只需重新绘制祖先控件的图层
+        //（随父容器一起移动时，在父容器中的相对位置不变，父容器的祖先控件已在父容器移动时处理）
+        RenderCache::Instance().Invalidate(GetParent());
+    }
 
     if ((m_pOtherData != nullptr) && (m_pOtherData->m_pLoading != nullptr)) {
         m_pOtherData->m_pLoading->UpdateLoadingPos();
@@ -3300,6 +3621,7 @@ void Control::AlphaPaint(IRender* pRender, const UiRect& rcPaint)
     if (!UiRect::Intersect(rcTemp, rcPaint, GetBoxShadowExpandedRect(GetRect()))) {//如果包含box-shadow的区域内为脏区域，就需要进行绘制
         return;
     }
+    PerformanceTrace tracePaint(_T("Control::Paint"));
     UiRect::Intersect(m_rcPaint, rcPaint, GetRect()); //设置m_rcPaint的值
 
     //是否为直角矩形区域设置为剪辑区域
@@ -3317,27 +3639,45 @@ void Control::AlphaPaint(IRender* pRender, const UiRect& rcPaint)
     //控件绘制的位置偏移（用于控件的动画效果）
     const UiPoint renderOffset = GetRenderOffset();
 
-    if (bAlpha) {
-        //当设置了透明度时，该控件（若为容器则包含子控件）需要完整绘制
+    //本控件的图层缓存（如果图层内容有效，则直接合成，不需要重新绘制）
+    IRender* pLayerRender = nullptr;
+    bool bLayerDirty = true;
+    if (m_bLayerCache) {
+        pLayerRender = RenderCache::Instance().GetLayer(this, GetRect().Width(), GetRect().Height(), bLayerDirty);
+    }
+
+    if (bAlpha || (pLayerRender != nullptr)) {
+        //当设置了透明度或者使用图层缓存时，该控件（若为容器则包含子控件）需要完整绘制
         UiRect rcPaintRect = GetRect();
         SetPaintRect(rcPaintRect);
-        if (m_pTempRender == nullptr) {
-            m_pTempRender = CreateTempRender();
+        IRender* pTempRender = pLayerRender;
+        if (pTempRender != nullptr) {
+            m_pTempRender.reset();
         }
-        IRender* pTempRender = m_pTempRender.get();
-        ASSERT(pTempRender != nullptr);
-        if (pTempRender == nullptr) {
-            return;
-        }
-        if ((pTempRender->GetWidth() != GetRect().Width()) || (pTempRender->GetHeight() != GetRect().Height())) {
-            if (!pTempRender->Resize(GetRect().Width(), GetRect().Height())) {
-                //存在错误，绘制失败
-                ASSERT(!"pTempRender->Resize failed!");
+        else {
+            if (m_pTempRender == nullptr) {
+                m_pTempRender = CreateTempRender();
+            }
+            pTempRender = m_pTempRender.get();
+            ASSERT(pTempRender != nullptr);
+            if (pTempRender == nullptr) {
                 return;
             }
+            if ((pTempRender->GetWidth() != GetRect().Width()) || (pTempRender->GetHeight() != GetRect().Height())) {
+                if (!pTempRender->Resize(GetRect().Width(), GetRect().Height())) {
+                    //存在错误，绘制失败
+                    ASSERT(!"pTempRender->Resize failed!");
+                    return;
+                }
+            }
         }
-        
-        if ((pTempRender->GetWidth() > 0) && (pTempRender->GetHeight() > 0)) {
+
+        if (bLayerDirty && (pTempRender->GetWidth() > 0) && (pTempRender->GetHeight() > 0)) {
+            if (pLayerRender != nullptr) {
+                //先标记图层有效，绘制过程中如果有控件内容变化，图层会被重新标记为脏
+                RenderCache::Instance().SetLayerPainted(this);
+            }
+
             // 将控件（如果是容器，则包含子控件），完整绘制到缓存新的render中
             // 绘制前，首先清除原内容
             pTempRender->Clear(UiColor());
@@ -3392,7 +3732,7 @@ void Control::AlphaPaint(IRender* pRender, const UiRect& rcPaint)
         UiRect::Intersect(m_rcPaint, rcPaint, GetRect()); //设置m_rcPaint的值
     }
     else {
-        //本控件未设置透明度，不使用缓存绘制，直接在目标render上绘制本控件（若为容器，则也包含子控件）        
+        //本控件未设置透明度，也未使用图层缓存，直接在目标render上绘制本控件（若为容器，则也包含子控件）        
         UiPoint ptOldOrg = pRender->OffsetWindowOrg(renderOffset);//控件的位置偏移，显示为动画效果
 
         //如果配置了box-shadow，先绘制，因为box-shadow会超出rect边界绘制(如果使用剪辑区域，会显示不全)        
@@ -3971,6 +4311,17 @@ void Control::SetAlpha(int64_t alpha)
     }
 }
 
+void Control::SetLayerCacheEnabled(bool bEnable)
+{
+    if (m_bLayerCache != bEnable) {
+        m_bLayerCache = bEnable;
+        if (!bEnable) {
+            RenderCache::Instance().RemoveLayer(this);
+        }
+        Invalidate();
+    }
+}
+
 void Control::SetHotAlpha(int64_t nHotAlpha)
 {
     ASSERT(nHotAlpha >= 0 && nHotAlpha <= 255);
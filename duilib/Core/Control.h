@@ -672,6 +672,15 @@ public:
      */
     bool IsAlpha() const { return m_nAlpha != 255; }
 
+    /** 设置是否启用图层缓存（控件及其子控件完整绘制到图层中，内容未变化时直接使用图层合成，不再重新绘制）
+     * @param[in] bEnable true表示启用图层缓存，false表示不启用
+     */
+    void SetLayerCacheEnabled(bool bEnable);
+
+    /** 判断是否启用了图层缓存
+     */
+    bool IsLayerCacheEnabled() const { return m_bLayerCache; }
+
     /**
      * @brief 设置焦点状态透明度
      * @param[in] alpha 0 ~ 255 的透明度值，255 为不透明
@@ -1840,6 +1849,9 @@ private:
 
     //是否处于MouseEnter状态（用于触发事件的标志）
     bool m_bMouseEnter;
+
+    //是否启用图层缓存
+    bool m_bLayerCache;
 };
 
 } // namespace ui
@@ -7,7 +7,8 @@ namespace ui
 {
 
 ControlFinder::ControlFinder():
-    m_pRoot(nullptr)
+    m_pRoot(nullptr),
+    m_bHitTestIndexEnabled(false)
 {
 }
 
@@ -29,6 +30,17 @@ void ControlFinder::Clear()
 {
     m_pRoot = nullptr;
     m_controlNameMap.clear();
+    m_scopedNameMap.clear();
+}
+
+void ControlFinder::SetHitTestIndexEnabled(bool bEnabled)
+{
+    m_bHitTestIndexEnabled = bEnabled;
+}
+
+bool ControlFinder::IsHitTestIndexEnabled() const
+{
+    return m_bHitTestIndexEnabled;
 }
 
 Control* ControlFinder::FindControl(const UiPoint& pt) const
@@ -97,6 +109,20 @@ Control* ControlFinder::FindSubControlByName(Control* pParent, const DString& st
     if (strName.empty()) {
         return nullptr;
     }
+    //优先从父祖控件的名称索引中查找（比如在列表项中反复查找子控件）
+    Control* pFindControl = FindControlInScope(pParent, strName);
+    if (pFindControl != nullptr) {
+        return pFindControl;
+    }
+    pFindControl = FindSubControlByNameNoScope(pParent, strName);
+    if (pFindControl != nullptr) {
+        AddControlToScope(pParent, strName, pFindControl);
+    }
+    return pFindControl;
+}
+
+Control* ControlFinder::FindSubControlByNameNoScope(Control* pParent, const DString& strName) const
+{
     //优先从缓存中查找
     Box* pOldRoot = nullptr;
     Control* pFindControl = FindControlInCache(pParent, strName);
@@ -170,8 +196,45 @@ Control* ControlFinder::FindControlInCache(Control* pAncestor, const DString& st
     return pFindedControl;
 }
 
+Control* ControlFinder::FindControlInScope(Control* pAncestor, const DString& strName) const
+{
+    if ((pAncestor == nullptr) || m_scopedNameMap.empty()) {
+        return nullptr;
+    }
+    auto iter = m_scopedNameMap.find(pAncestor);
+    if (iter == m_scopedNameMap.end()) {
+        return nullptr;
+    }
+    auto iterName = iter->second.find(strName);
+    if (iterName == iter->second.end()) {
+        return nullptr;
+    }
+    Control* pControl = iterName->second.get();
+    if ((pControl != nullptr) &&
+        (pAncestor->GetWindow() == pControl->GetWindow()) &&
+        pControl->IsNameEquals(strName) &&
+        PlaceHolder::IsControlRelated(pAncestor, pControl)) {
+        return pControl;
+    }
+    //控件已销毁、名称已修改或者已移动到其他容器
+    iter->second.erase(iterName);
+    return nullptr;
+}
+
+void ControlFinder::AddControlToScope(Control* pAncestor, const DString& strName, Control* pControl) const
+{
+    if ((pAncestor == nullptr) || (pControl == nullptr) || (pAncestor == pControl)) {
+        return;
+    }
+    m_scopedNameMap[pAncestor][strName] = ControlPtr(pControl);
+}
+
 void ControlFinder::RemoveControl(Control* pControl)
 {
+    if ((pControl != nullptr) && !m_scopedNameMap.empty()) {
+        //控件作为查找范围的名称索引
+        m_scopedNameMap.erase(pControl);
+    }
     if ((pControl == nullptr) || !pControl->HasName()) {
         return;
     }
@@ -195,6 +258,10 @@ void ControlFinder::AddControl(Control* pControl)
     if (pControl == nullptr) {
         return;
     }
+    if (!m_scopedNameMap.empty()) {
+        //新添加的控件（包括其子控件）可能与已记录的控件同名，并且在树中的位置更靠前，需重新按树的顺序查找
+        m_scopedNameMap.clear();
+    }
     const DString sName = pControl->GetName();
     if (sName.empty()) {
         return;
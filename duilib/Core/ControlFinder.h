@@ -96,7 +96,14 @@ public:
      */
     Control* FindSubControlByName(Control* pParent, const DString& strName) const;
 
-    /** 添加一个控件，对控件名称做索引
+    /** 根据名字查找子控件（不使用父祖控件的名称索引）
+     * @param [in] pParent 要搜索的控件
+     * @param [in] strName 要查找的名称
+     * @return 返回控件指针
+     */
+    Control* FindSubControlByNameNoScope(Control* pParent, const DString& strName) const;
+
+    /** 添加一个控件，对控件名称做索引（同时清除父祖控件的名称索引）
     */
     void AddControl(Control* pControl);
 
@@ -109,6 +116,14 @@ public:
     */
     void Clear();
 
+    /** 设置按坐标查找控件时，是否使用空间索引（由Box::FindControl在子控件较多时使用）
+    */
+    void SetHitTestIndexEnabled(bool bEnabled);
+
+    /** 按坐标查找控件时，是否使用空间索引
+    */
+    bool IsHitTestIndexEnabled() const;
+
 public:
     static Control* FindControlFromPoint(Control* pThis, void* pData);
     static Control* FindControlFromTab(Control* pThis, void* pData);
@@ -117,6 +132,15 @@ public:
     static Control* FindContextMenuControl(Control* pThis, void* pData);
     static Control* FindControlFromDroppableBox(Control* pThis, void* pData);
 
+private:
+    /** 在父祖控件的名称索引中查找控件（索引中的控件已销毁、名称变化或者已不在该父祖控件下时，返回nullptr）
+    */
+    Control* FindControlInScope(Control* pAncestor, const DString& strName) const;
+
+    /** 将查找结果添加到父祖控件的名称索引中
+    */
+    void AddControlToScope(Control* pAncestor, const DString& strName, Control* pControl) const;
+
 private:
     /** 根节点
     */
@@ -125,6 +149,17 @@ private:
     /** 控件的name与控件之间的映射，用于快速查找控件
     */
     std::unordered_map<DString, std::vector<ControlPtr>> m_controlNameMap;
+
+    /** 按父祖控件（查找范围，比如列表项的根控件）分组的名称索引，用于在子树中快速查找控件（名称重复时也适用）
+    *   FindSubControlByName查找成功后记录，再次在相同范围内查找相同名称时直接返回，父祖控件销毁时删除
+    *   添加控件时全部清除（新添加的控件或者其子控件可能与已记录的控件同名，并且在树中的位置更靠前）
+    *   （关键字只用于比较，不访问其指向的控件）
+    */
+    mutable std::unordered_map<const Control*, std::unordered_map<DString, ControlPtr>> m_scopedNameMap;
+
+    /** 按坐标查找控件时，是否使用空间索引
+    */
+    bool m_bHitTestIndexEnabled;
 };
 
 } // namespace ui
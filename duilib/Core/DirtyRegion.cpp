@@ -0,0 +1,144 @@
+#include "DirtyRegion.h"
+
+namespace ui
+{
+
+DirtyRegion::DirtyRegion(size_t nMaxRects):
+    m_nMaxRects(nMaxRects > 0 ? nMaxRects : 1)
+{
+}
+
+void DirtyRegion::AddRect(const UiRect& rc)
+{
+    if (rc.IsEmpty()) {
+        return;
+    }
+    for (const UiRect& rcItem : m_rects) {
+        if (rcItem.ContainsRect(rc)) {
+            //已经包含在脏区域中
+            return;
+        }
+    }
+    MergeRect(rc);
+
+    //矩形个数超过上限时，每次合并代价最小的两个矩形
+    while (m_rects.size() > m_nMaxRects) {
+        size_t nFirst = 0;
+        size_t nSecond = 1;
+        int64_t nMinCost = INT64_MAX;
+        for (size_t i = 0; i < m_rects.size(); ++i) {
+            for (size_t j = i + 1; j < m_rects.size(); ++j) {
+                UiRect rcUnion = m_rects[i];
+                rcUnion.Union(m_rects[j]);
+                int64_t nCost = RectArea(rcUnion) - RectArea(m_rects[i]) - RectArea(m_rects[j]);
+                if (nCost < nMinCost) {
+                    nMinCost = nCost;
+                    nFirst = i;
+                    nSecond = j;
+                }
+            }
+        }
+        UiRect rcUnion = m_rects[nFirst];
+        rcUnion.Union(m_rects[nSecond]);
+        m_rects.erase(m_rects.begin() + nSecond);
+        m_rects.erase(m_rects.begin() + nFirst);
+        MergeRect(rcUnion);
+    }
+}
+
+void DirtyRegion::MergeRect(UiRect rc)
+{
+    //合并后的矩形可能与其他矩形相交，需要反复检查，直到没有可合并的矩形
+    bool bMerged = true;
+    while (bMerged) {
+        bMerged = false;
+        for (size_t i = 0; i < m_rects.size(); ++i) {
+            if (IsWorthMerging(m_rects[i], rc)) {
+                rc.Union(m_rects[i]);
+                m_rects.erase(m_rects.begin() + i);
+                bMerged = true;
+                break;
+            }
+        }
+    }
+    m_rects.push_back(rc);
+}
+
+void DirtyRegion::Intersect(const UiRect& rc)
+{
+    for (auto iter = m_rects.begin(); iter != m_rects.end();) {
+        if (!iter->Intersect(rc)) {
+            iter = m_rects.erase(iter);
+        }
+        else {
+            ++iter;
+        }
+    }
+}
+
+void DirtyRegion::Clear()
+{
+    m_rects.clear();
+}
+
+bool DirtyRegion::IsEmpty() const
+{
+    return m_rects.empty();
+}
+
+const std::vector<UiRect>& DirtyRegion::GetRects() const
+{
+    return m_rects;
+}
+
+UiRect DirtyRegion::GetBounds() const
+{
+    UiRect rcBounds;
+    for (const UiRect& rc : m_rects) {
+        rcBounds.Union(rc);
+    }
+    return rcBounds;
+}
+
+int64_t DirtyRegion::GetArea() const
+{
+    int64_t nArea = 0;
+    for (const UiRect& rc : m_rects) {
+        nArea += RectArea(rc);
+    }
+    return nArea;
+}
+
+void DirtyRegion::SetMaxRects(size_t nMaxRects)
+{
+    m_nMaxRects = nMaxRects > 0 ? nMaxRects : 1;
+}
+
+size_t DirtyRegion::GetMaxRects() const
+{
+    return m_nMaxRects;
+}
+
+int64_t DirtyRegion::RectArea(const UiRect& rc)
+{
+    if (rc.IsEmpty()) {
+        return 0;
+    }
+    return (int64_t)rc.Width() * (int64_t)rc.Height();
+}
+
+bool DirtyRegion::IsWorthMerging(const UiRect& a, const UiRect& b)
+{
+    UiRect rcTemp;
+    if (UiRect::Intersect(rcTemp, a, b)) {
+        //相交的矩形必须合并，以保证矩形之间互不重叠
+        return true;
+    }
+    //合并后增加的面积不超过两个矩形面积之和的1/4时，合并后绘制更划算（减少分块绘制的次数）
+    UiRect rcUnion = a;
+    rcUnion.Union(b);
+    const int64_t nArea = RectArea(a) + RectArea(b);
+    return (RectArea(rcUnion) - nArea) * 4 <= nArea;
+}
+
+} // namespace ui
@@ -0,0 +1,83 @@
+#ifndef UI_CORE_DIRTY_REGION_H_
+#define UI_CORE_DIRTY_REGION_H_
+
+#include "duilib/Core/UiRect.h"
+#include <vector>
+
+namespace ui
+{
+
+/** 窗口的脏区域（由多个互不重叠的矩形构成）
+*   相交的矩形总是合并；不相交的矩形，如果合并后增加的面积很小，也会合并；
+*   矩形个数超过上限时，合并代价最小的两个矩形，以控制分块绘制的次数
+*/
+class UILIB_API DirtyRegion
+{
+public:
+    /** 构造函数
+    * @param [in] nMaxRects 最多保留的矩形个数（至少为1）
+    */
+    explicit DirtyRegion(size_t nMaxRects = 8);
+
+    /** 添加一个脏区域矩形
+    */
+    void AddRect(const UiRect& rc);
+
+    /** 与指定矩形求交集（比如：限制在窗口客户区范围内），交集为空的矩形会被删除
+    */
+    void Intersect(const UiRect& rc);
+
+    /** 清空脏区域
+    */
+    void Clear();
+
+    /** 判断脏区域是否为空
+    */
+    bool IsEmpty() const;
+
+    /** 获取脏区域的所有矩形（互不重叠）
+    */
+    const std::vector<UiRect>& GetRects() const;
+
+    /** 获取包含所有脏区域矩形的最小矩形
+    */
+    UiRect GetBounds() const;
+
+    /** 获取脏区域的总面积
+    */
+    int64_t GetArea() const;
+
+    /** 设置最多保留的矩形个数
+    */
+    void SetMaxRects(size_t nMaxRects);
+
+    /** 获取最多保留的矩形个数
+    */
+    size_t GetMaxRects() const;
+
+private:
+    /** 计算矩形的面积
+    */
+    static int64_t RectArea(const UiRect& rc);
+
+    /** 判断两个矩形是否值得合并（相交，或者合并后增加的面积较小）
+    */
+    static bool IsWorthMerging(const UiRect& a, const UiRect& b);
+
+    /** 将矩形合并到列表中，保证列表中的矩形互不重叠
+    */
+    void MergeRect(UiRect rc);
+
+private:
+    /** 脏区域的矩形列表
+    */
+    std::vector<UiRect> m_rects;
+
+    /** 最多保留的矩形个数
+    */
+    size_t m_nMaxRects;
+};
+
+} // namespace ui
+
+#endif // UI_CORE_DIRTY_REGION_H_
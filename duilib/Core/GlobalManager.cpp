@@ -221,6 +221,7 @@ void GlobalManager::Shutdown()
     m_threadList.clear();
 
     m_threadManager.Clear();
+    m_frameClock.Clear();
     m_timerManager.Clear();
     m_colorManager.Clear();    
     m_fontManager.RemoveAllFonts();
@@ -438,6 +439,8 @@ bool GlobalManager::ReloadResource(const ResourceParam& resParam, bool bInvalida
     m_colorManager.RemoveAllColors();
     RemoveAllImages();
     RemoveAllClasss();
+    //窗口模板中已展开的Class属性可能已经变化
+    WindowBuilder::ClearWindowTemplates(false);
 
     //保存资源路径
     SetResourcePath(FilePathUtil::JoinFilePath(strResourcePath, resParam.themePath));
@@ -910,6 +913,11 @@ WindowManager& GlobalManager::Windows()
     return m_windowManager;
 }
 
+AnimationFrameClock& GlobalManager::FrameClock()
+{
+    return m_frameClock;
+}
+
 Box* GlobalManager::CreateBox(Window* pWindow, const FilePath& strXmlPath, CreateControlCallback callback)
 {
     ASSERT(pWindow != nullptr);
@@ -943,7 +951,7 @@ Box* GlobalManager::CreateBoxWithCache(Window* pWindow, const FilePath& strXmlPa
     auto it = m_builderMap.find(strXmlPath);
     if (it == m_builderMap.end()) {
         std::unique_ptr<WindowBuilder> builder = std::make_unique<WindowBuilder>();
-        if (builder->ParseXmlFile(strXmlPath, pWindow->GetResourcePath())) {
+        if (builder->ParseXmlFileWithCache(strXmlPath, pWindow->GetResourcePath())) {
             Control* pControl = builder->CreateControls(pWindow, callback);
             ASSERT(pControl != nullptr);
             if (pControl != nullptr) {
@@ -1010,7 +1018,7 @@ bool GlobalManager::FillBoxWithCache(Box* pUserDefinedBox, const FilePath& strXm
     auto it = m_builderMap.find(strXmlPath);
     if (it == m_builderMap.end()) {
         std::unique_ptr<WindowBuilder> winBuilder = std::make_unique<WindowBuilder>();
-        if (winBuilder->ParseXmlFile(strXmlPath, pWindow->GetResourcePath())) {
+        if (winBuilder->ParseXmlFileWithCache(strXmlPath, pWindow->GetResourcePath())) {
             Control* pControl = winBuilder->CreateControls(pWindow, callback, nullptr, pUserDefinedBox);
             ASSERT(pControl != nullptr);
             if (pControl != nullptr) {
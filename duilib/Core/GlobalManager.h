@@ -14,6 +14,7 @@
 #include "duilib/Core/CursorManager.h"
 #include "duilib/Core/IconManager.h"
 #include "duilib/Core/WindowManager.h"
+#include "duilib/Animation/AnimationFrameClock.h"
 #include "duilib/Image/ImageDecoderFactory.h"
 
 #include <string>
@@ -218,6 +219,10 @@ public:
     */
     WindowManager& Windows();
 
+    /** 动画帧时钟（所有动画共用的定时器）
+    */
+    AnimationFrameClock& FrameClock();
+
 public:
     /** 根据资源加载方式，返回对应的资源路径
      * @param[in] path 要获取的资源路径
@@ -278,6 +283,7 @@ public:
      *           如果是Window：可以包含与Window相似的窗口内公共资源定义（比如Class等），这些资源是窗口内有效，Window标签的属性不解析
      *           如果是其他名称，则无特殊逻辑
      *  2. CreateBoxWithCache和FillBoxWithCache：解析后XML文件解析结果会被缓存，适合XML文件被重复调用的场景，可以提高性能（节省XML解析的时间）
+     *                                          XML文件被编译为窗口模板（参见WindowBuilder::ParseXmlFileWithCache），XML中的Include节点也使用窗口模板缓存
      *  3. XML文件的第二级节点（上述XML文件中的Window节点下的节点）：需要是容器，不能是Control
      *  3. CreateBox/CreateBoxWithCache: 解析XML，创建并返回相应的二级容器节点（即XML中Window下的VBox节点）：
      *                                   上述XML文件中，是会创建VBox节点，函数返回的是VBox指针，包含了XML中VBox的属性
@@ -457,6 +463,10 @@ private:
     */
     TimerManager m_timerManager;
 
+    /** 动画帧时钟（依赖定时器管理器，需要在其后声明）
+    */
+    AnimationFrameClock m_frameClock;
+
     /** 线程管理器
     */
     ThreadManager m_threadManager;
@@ -0,0 +1,164 @@
+#include "HitTestGrid.h"
+#include <cmath>
+
+namespace ui
+{
+namespace
+{
+/** 网格的最大行数和列数
+*/
+const int32_t kMaxGridSize = 256;
+
+/** 一个子控件最多映射到的网格数，超过时作为大区域的子控件单独记录
+*/
+const int32_t kMaxItemCells = 16;
+}
+
+HitTestGrid::HitTestGrid():
+    m_nColumns(0),
+    m_nRows(0),
+    m_nCellWidth(1),
+    m_nCellHeight(1),
+    m_bDirty(true)
+{
+}
+
+void HitTestGrid::Clear()
+{
+    m_itemRects.clear();
+    m_rcBounds.Clear();
+    m_nColumns = 0;
+    m_nRows = 0;
+    m_nCellWidth = 1;
+    m_nCellHeight = 1;
+    m_cellStarts.clear();
+    m_cellItems.clear();
+    m_largeItems.clear();
+    m_bDirty = true;
+}
+
+void HitTestGrid::Build(const std::vector<UiRect>& itemRects)
+{
+    Clear();
+    m_bDirty = false;
+    m_itemRects = itemRects;
+    size_t nValidCount = 0;
+    int64_t nTotalWidth = 0;
+    int64_t nTotalHeight = 0;
+    for (const UiRect& rc : m_itemRects) {
+        if (rc.IsEmpty()) {
+            continue;
+        }
+        if (nValidCount == 0) {
+            m_rcBounds = rc;
+        }
+        else {
+            m_rcBounds.Union(rc);
+        }
+        ++nValidCount;
+        nTotalWidth += rc.Width();
+        nTotalHeight += rc.Height();
+    }
+    if (nValidCount == 0) {
+        return;
+    }
+
+    //网格数与子控件数相当，按外接矩形的宽高比分配行数和列数；
+    //网格不小于子控件的平均大小，避免一个子控件映射到过多的网格中
+    const double fItemCount = (double)nValidCount;
+    const double fWidth = (double)m_rcBounds.Width();
+    const double fHeight = (double)m_rcBounds.Height();
+    int32_t nColumns = (int32_t)std::ceil(std::sqrt(fItemCount * fWidth / fHeight));
+    int32_t nRows = (int32_t)std::ceil(fItemCount / std::max(nColumns, 1));
+    nColumns = std::min(nColumns, (int32_t)(fWidth * fItemCount / (double)nTotalWidth) + 1);
+    nRows = std::min(nRows, (int32_t)(fHeight * fItemCount / (double)nTotalHeight) + 1);
+    m_nColumns = std::clamp(nColumns, 1, kMaxGridSize);
+    m_nRows = std::clamp(nRows, 1, kMaxGridSize);
+    m_nCellWidth = std::max((m_rcBounds.Width() + m_nColumns - 1) / m_nColumns, 1);
+    m_nCellHeight = std::max((m_rcBounds.Height() + m_nRows - 1) / m_nRows, 1);
+
+    //第一遍统计每个网格的子控件数，第二遍填充数据
+    const size_t nCellCount = (size_t)m_nColumns * (size_t)m_nRows;
+    m_cellStarts.assign(nCellCount + 1, 0);
+    for (int32_t nPass = 0; nPass < 2; ++nPass) {
+        std::vector<uint32_t> cellOffsets;
+        if (nPass == 1) {
+            for (size_t nCell = 0; nCell < nCellCount; ++nCell) {
+                m_cellStarts[nCell + 1] += m_cellStarts[nCell];
+            }
+            m_cellItems.resize(m_cellStarts[nCellCount]);
+            cellOffsets.assign(m_cellStarts.begin(), m_cellStarts.end() - 1);
+        }
+        for (size_t nItem = 0; nItem < m_itemRects.size(); ++nItem) {
+            const UiRect& rc = m_itemRects[nItem];
+            if (rc.IsEmpty()) {
+                continue;
+            }
+            const int32_t nLeft = (rc.left - m_rcBounds.left) / m_nCellWidth;
+            const int32_t nTop = (rc.top - m_rcBounds.top) / m_nCellHeight;
+            const int32_t nRight = std::min((rc.right - 1 - m_rcBounds.left) / m_nCellWidth, m_nColumns - 1);
+            const int32_t nBottom = std::min((rc.bottom - 1 - m_rcBounds.top) / m_nCellHeight, m_nRows - 1);
+            if ((nRight - nLeft + 1) * (nBottom - nTop + 1) > kMaxItemCells) {
+                if (nPass == 0) {
+                    m_largeItems.push_back((uint32_t)nItem);
+                }
+                continue;
+            }
+            for (int32_t nRow = nTop; nRow <= nBottom; ++nRow) {
+                for (int32_t nColumn = nLeft; nColumn <= nRight; ++nColumn) {
+                    const size_t nCell = (size_t)nRow * (size_t)m_nColumns + (size_t)nColumn;
+                    if (nPass == 0) {
+                        m_cellStarts[nCell + 1]++;
+                    }
+                    else {
+                        m_cellItems[cellOffsets[nCell]++] = (uint32_t)nItem;
+                    }
+                }
+            }
+        }
+    }
+}
+
+void HitTestGrid::Query(const UiPoint& pt, std::vector<size_t>& itemIndexs) const
+{
+    itemIndexs.clear();
+    if ((m_nColumns <= 0) || (m_nRows <= 0) || !m_rcBounds.ContainsPt(pt)) {
+        return;
+    }
+    const int32_t nColumn = (pt.x - m_rcBounds.left) / m_nCellWidth;
+    const int32_t nRow = (pt.y - m_rcBounds.top) / m_nCellHeight;
+    const size_t nCell = (size_t)std::min(nRow, m_nRows - 1) * (size_t)m_nColumns + (size_t)std::min(nColumn, m_nColumns - 1);
+    //网格中的序号和大区域子控件的序号都是升序的，合并后仍然有序
+    const uint32_t* pCellItem = m_cellItems.data() + m_cellStarts[nCell];
+    const uint32_t* pCellEnd = m_cellItems.data() + m_cellStarts[nCell + 1];
+    auto iterLarge = m_largeItems.begin();
+    while ((pCellItem != pCellEnd) || (iterLarge != m_largeItems.end())) {
+        uint32_t nItem = 0;
+        if ((iterLarge == m_largeItems.end()) || ((pCellItem != pCellEnd) && (*pCellItem < *iterLarge))) {
+            nItem = *pCellItem++;
+        }
+        else {
+            nItem = *iterLarge++;
+        }
+        if (m_itemRects[nItem].ContainsPt(pt)) {
+            itemIndexs.push_back(nItem);
+        }
+    }
+}
+
+size_t HitTestGrid::GetItemCount() const
+{
+    return m_itemRects.size();
+}
+
+bool HitTestGrid::IsDirty() const
+{
+    return m_bDirty;
+}
+
+void HitTestGrid::SetDirty()
+{
+    m_bDirty = true;
+}
+
+} // namespace ui
@@ -0,0 +1,75 @@
+#ifndef UI_CORE_HIT_TEST_GRID_H_
+#define UI_CORE_HIT_TEST_GRID_H_
+
+#include "duilib/Core/UiRect.h"
+#include <vector>
+
+namespace ui
+{
+/** 按坐标查找子控件时使用的空间索引（均匀网格）
+*   1. 将所有子控件的矩形区域映射到网格中，每个网格记录与其相交的子控件序号
+*   2. 按坐标查找时只检查坐标所在网格中的子控件，不需要遍历所有子控件
+*   3. 只记录矩形区域，不关心控件的可见性等状态（由调用方对候选的子控件再做判断）
+*/
+class HitTestGrid
+{
+public:
+    HitTestGrid();
+
+    /** 根据子控件的矩形区域重建索引
+    * @param [in] itemRects 每个子控件的矩形区域（下标为子控件的序号）
+    */
+    void Build(const std::vector<UiRect>& itemRects);
+
+    /** 清除索引
+    */
+    void Clear();
+
+    /** 查找包含指定坐标的子控件
+    * @param [in] pt 坐标
+    * @param [out] itemIndexs 返回矩形区域包含该坐标的子控件序号，按序号升序排列
+    */
+    void Query(const UiPoint& pt, std::vector<size_t>& itemIndexs) const;
+
+    /** 获取索引中的子控件个数
+    */
+    size_t GetItemCount() const;
+
+    /** 索引是否需要重建（子控件的位置或者子控件列表发生变化）
+    */
+    bool IsDirty() const;
+    void SetDirty();
+
+private:
+    /** 每个子控件的矩形区域
+    */
+    std::vector<UiRect> m_itemRects;
+
+    /** 所有子控件的外接矩形
+    */
+    UiRect m_rcBounds;
+
+    /** 网格的列数、行数，以及每个网格的宽度和高度
+    */
+    int32_t m_nColumns;
+    int32_t m_nRows;
+    int32_t m_nCellWidth;
+    int32_t m_nCellHeight;
+
+    /** 每个网格中的子控件序号（连续存储，m_cellStarts[i]到m_cellStarts[i + 1]为第i个网格的数据）
+    */
+    std::vector<uint32_t> m_cellStarts;
+    std::vector<uint32_t> m_cellItems;
+
+    /** 覆盖网格数过多的子控件（比如背景、遮罩层），每次查找时都检查
+    */
+    std::vector<uint32_t> m_largeItems;
+
+    /** 索引是否需要重建
+    */
+    bool m_bDirty;
+};
+
+} // namespace ui
+
+#endif // UI_CORE_HIT_TEST_GRID_H_
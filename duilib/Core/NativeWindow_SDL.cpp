@@ -198,6 +198,16 @@ public:
         rcUpdate = m_pNativeWindow->GetUpdateRect();
         return !rcUpdate.IsEmpty();
     }
+
+    /** 获取界面需要绘制的区域（多个互不重叠的矩形），以实现分块的局部绘制
+    * @param [out] rcUpdates 返回需要绘制的区域矩形列表
+    * @return 返回true表示支持局部绘制，返回false表示不支持局部绘制
+    */
+    virtual bool GetUpdateRects(std::vector<UiRect>& rcUpdates) const override
+    {
+        rcUpdates = m_pNativeWindow->GetUpdateRects();
+        return !rcUpdates.empty();
+    }
 };
 
 void NativeWindow_SDL::CheckWindowSnap(SDL_Window* window)
@@ -2608,12 +2618,7 @@ static bool SDLCALL FilterNativeWindowExposedEvent(void* userdata, SDL_Event* ev
 
 void NativeWindow_SDL::Invalidate(const UiRect& rcItem)
 {
-    if (m_rcUpdateRect.IsZero()) {
-        m_rcUpdateRect = rcItem;
-    }
-    else {
-        m_rcUpdateRect.Union(rcItem);
-    }
+    m_updateRegion.AddRect(rcItem);
 
     //暂时没有此功能, 只能发送一个绘制消息，触发界面绘制
     if (m_sdlWindow != nullptr) {
@@ -2640,7 +2645,7 @@ void NativeWindow_SDL::PaintWindow(bool bPaintAll)
     PerformanceStat statPerformance(_T("PaintWindow, NativeWindow_SDL::PaintWindow(Total)"));
     if (bPaintAll) {
         //绘制全部
-        m_rcUpdateRect.Clear();
+        m_updateRegion.Clear();
     }
     INativeWindow* pOwner = m_pOwner;
     ASSERT(pOwner != nullptr);
@@ -2674,12 +2679,17 @@ void NativeWindow_SDL::PaintWindow(bool bPaintAll)
             }
         }
     }
-    m_rcUpdateRect.Clear();
+    m_updateRegion.Clear();
+}
+
+UiRect NativeWindow_SDL::GetUpdateRect() const
+{
+    return m_updateRegion.GetBounds();
 }
 
-const UiRect& NativeWindow_SDL::GetUpdateRect() const
+const std::vector<UiRect>& NativeWindow_SDL::GetUpdateRects() const
 {
-    return m_rcUpdateRect;
+    return m_updateRegion.GetRects();
 }
 
 void NativeWindow_SDL::SetImeOpenStatus(bool bOpen)
@@ -4,6 +4,7 @@
 #include "duilib/Core/INativeWindow.h"
 #include "duilib/Core/WindowCreateParam.h"
 #include "duilib/Core/WindowCreateAttributes.h"
+#include "duilib/Core/DirtyRegion.h"
 #include "duilib/Utils/FilePath.h"
 
 #ifdef DUILIB_BUILD_FOR_SDL
@@ -572,9 +573,13 @@ public:
     */
     void PaintWindow(bool bPaintAll);
 
-    /** 窗口更新的区域（需要绘制）
+    /** 窗口更新的区域（需要绘制），包含所有脏区域的最小矩形
+    */
+    UiRect GetUpdateRect() const;
+
+    /** 窗口更新的区域（需要绘制），互不重叠的脏区域矩形列表
     */
-    const UiRect& GetUpdateRect() const;
+    const std::vector<UiRect>& GetUpdateRects() const;
 
     /** 设置输入法的开关状态（关闭再打开以后，能够保持原输入法状态）
     * @param [in] bOpen true标识打开输入法，false标识关闭输入法
@@ -830,7 +835,7 @@ private:
 
     /** 窗口更新的区域（需要绘制）
     */
-    UiRect m_rcUpdateRect;
+    DirtyRegion m_updateRegion;
 
     /** 拖放的支持
     */
@@ -4,6 +4,7 @@
 #include "duilib/Utils/StringUtil.h"
 #include "duilib/Utils/StringConvert.h"
 #include "duilib/Core/GlobalManager.h"
+#include "duilib/Render/RenderCache.h"
 
 namespace ui
 {
@@ -610,6 +611,9 @@ void PlaceHolder::SetArranged(bool bArranged)
 void PlaceHolder::SetRect(const UiRect& rc)
 {
     //所有调整矩形区域的操作，最终都会通过这里设置
+    if ((GetParent() != nullptr) && (m_uiRect != rc)) {
+        GetParent()->OnItemRectChanged();
+    }
     m_uiRect = rc;
     if ((GetParent() != nullptr) && IsFloat()) {
         //浮动控件，则需要记录和父控件相对位置和大小
@@ -698,6 +702,7 @@ void PlaceHolder::Invalidate()
         if (m_pWindow != nullptr) {
             m_pWindow->Invalidate(rcInvalidate);
         }
+        RenderCache::Instance().Invalidate(this);
     }
 }
 
@@ -719,6 +724,7 @@ void PlaceHolder::InvalidateRect(const UiRect& rc)
         if (m_pWindow != nullptr) {
             m_pWindow->Invalidate(rcInvalidate);
         }
+        RenderCache::Instance().Invalidate(this);
     }
 }
 
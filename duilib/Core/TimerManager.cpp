@@ -19,45 +19,24 @@
 namespace ui 
 {
 
-/** 定时器的数据
-*/
-class TimerInfo
+namespace
 {
-public:
-    TimerInfo(): 
-        timerCallback(nullptr),
-        uElapseMs(0),
-        uRepeatTime(0),
-        m_nTimerId(0)
-    {
-    }
-
-    bool operator < (const TimerInfo& r) const {
-        //排序条件：最先触发的排在前面
-        return trigerTime > r.trigerTime;
-    }
-
-    //定时器ID
-    size_t m_nTimerId;
-
-    //定时器回调函数
-    TimerCallback timerCallback;
-
-    //取消定时器同步机制
-    std::weak_ptr<WeakFlag> weakFlag;
-
-    //定时器间隔：（单位：毫秒）
-    uint32_t uElapseMs;
-
-    //重复次数
-    uint32_t uRepeatTime;
+/** 比预定的触发时间晚多少毫秒以上，记为延迟触发
+*/
+const uint64_t kLateFireMs = 16;
 
-    //定时器的触发时间
-    std::chrono::steady_clock::time_point trigerTime;
-};
+/** 定时器ID中位置下标所占的位数（其余高位为位置的版本号）
+*/
+const size_t kTimerSlotBits = sizeof(size_t) * 4;
+const size_t kTimerSlotMask = ((size_t)1 << kTimerSlotBits) - 1;
+}
 
 TimerManager::TimerManager():
-    m_nNextTimerId(1),
+    m_nActiveTimers(0),
+    m_nTimerSlackMs(0),
+    m_startTime(std::chrono::steady_clock::now()),
+    m_nStatsStartTick(0),
+    m_nStatsFires(0),
     m_bRunning(false),
     m_bHasPenddingPoll(false)
 {
@@ -78,10 +57,11 @@ void TimerManager::Clear()
 {
     std::unique_lock<std::mutex> guard(m_taskMutex);
     m_threadMsg.Clear();
-    while (!m_aTimers.empty()) {
-        m_aTimers.pop();
-    }
-    m_removedTimerIds.clear();
+    m_timers.clear();
+    m_freeTimerSlots.clear();
+    m_nActiveTimers = 0;
+    m_timerWheel.Clear();
+    m_readyTimerIds.clear();
     m_bRunning = false;
     if (m_pWorkerThread != nullptr) {
         m_cv.notify_one();
@@ -101,19 +81,39 @@ size_t TimerManager::AddTimer(const std::weak_ptr<WeakFlag>& weakFlag, const Tim
     if (iRepeatTime < 0) {
         iRepeatTime = -1;
     }
-    size_t nTimerId = m_nNextTimerId++;
-    TimerInfo pTimer;
-    pTimer.m_nTimerId = nTimerId;
-
-    pTimer.timerCallback = callback;
-    pTimer.uElapseMs = uElapseMs;
-    pTimer.trigerTime = std::chrono::steady_clock::now();
-    pTimer.trigerTime += std::chrono::milliseconds(uElapseMs); //计算出下次触发时间(当前时间 + 间隔的毫秒数)
-    pTimer.uRepeatTime = static_cast<uint32_t>(iRepeatTime);
-    pTimer.weakFlag = weakFlag;
 
     std::lock_guard<std::mutex> threadGuard(m_taskMutex);
-    m_aTimers.push(pTimer);
+    //分配定时器数据的位置：优先使用空闲位置
+    size_t nSlot = 0;
+    if (!m_freeTimerSlots.empty()) {
+        nSlot = m_freeTimerSlots.back();
+        m_freeTimerSlots.pop_back();
+    }
+    else {
+        nSlot = m_timers.size();
+        ASSERT(nSlot < kTimerSlotMask);
+        if (nSlot >= kTimerSlotMask) {
+            return 0;
+        }
+        m_timers.emplace_back();
+    }
+    TimerInfo& timerInfo = m_timers[nSlot];
+    timerInfo.nGeneration++;
+    const size_t nTimerId = (timerInfo.nGeneration << kTimerSlotBits) | (nSlot + 1);
+    timerInfo.nTimerId = nTimerId;
+    timerInfo.timerCallback = callback;
+    timerInfo.uElapseMs = uElapseMs;
+    timerInfo.uRepeatTime = static_cast<uint32_t>(iRepeatTime);
+    timerInfo.weakFlag = weakFlag;
+    ++m_nActiveTimers;
+
+    const uint64_t nNowTick = GetNowTick();
+    if (m_timerWheel.IsEmpty()) {
+        //时间轮为空时，直接将其时间推进到当前时间
+        m_timerWheel.Advance(nNowTick, m_readyTimerIds);
+    }
+    timerInfo.nDueTick = CalcDueTick(nNowTick, uElapseMs); //计算出下次触发时间(当前时间 + 间隔的毫秒数)
+    timerInfo.nWheelHandle = m_timerWheel.AddTimer(nTimerId, timerInfo.nDueTick);
     if (m_pWorkerThread == nullptr) {
         //启动线程
         m_bRunning = true;
@@ -128,22 +128,74 @@ size_t TimerManager::AddTimer(const std::weak_ptr<WeakFlag>& weakFlag, const Tim
 void TimerManager::RemoveTimer(size_t nTimerId)
 {
     std::lock_guard<std::mutex> threadGuard(m_taskMutex);
-    m_removedTimerIds.insert(nTimerId);
+    TimerInfo* pTimerInfo = FindTimer(nTimerId);
+    if (pTimerInfo != nullptr) {
+        //已经触发、等待派发回调的定时器，其句柄已经失效，只需要删除定时器数据
+        m_timerWheel.RemoveTimer(pTimerInfo->nWheelHandle);
+        FreeTimer(*pTimerInfo);
+    }
 }
 
-bool TimerManager::IsTimerRemoved(size_t nTimerId) const
+TimerInfo* TimerManager::FindTimer(size_t nTimerId)
 {
-    if (!m_removedTimerIds.empty()) {
-        return m_removedTimerIds.find(nTimerId) != m_removedTimerIds.end();
+    const size_t nSlot = (nTimerId & kTimerSlotMask) - 1;
+    if ((nTimerId == 0) || (nSlot >= m_timers.size()) || (m_timers[nSlot].nTimerId != nTimerId)) {
+        return nullptr;
     }
-    else {
-        return false;
+    return &m_timers[nSlot];
+}
+
+void TimerManager::FreeTimer(TimerInfo& timerInfo)
+{
+    //保留版本号，释放回调函数等数据
+    const size_t nSlot = (timerInfo.nTimerId & kTimerSlotMask) - 1;
+    timerInfo.nTimerId = 0;
+    timerInfo.timerCallback = nullptr;
+    timerInfo.weakFlag.reset();
+    timerInfo.nWheelHandle = 0;
+    m_freeTimerSlots.push_back(nSlot);
+    ASSERT(m_nActiveTimers > 0);
+    --m_nActiveTimers;
+}
+
+void TimerManager::SetTimerSlack(uint32_t nSlackMs)
+{
+    std::lock_guard<std::mutex> threadGuard(m_taskMutex);
+    m_nTimerSlackMs = nSlackMs;
+}
+
+uint32_t TimerManager::GetTimerSlack() const
+{
+    std::lock_guard<std::mutex> threadGuard(m_taskMutex);
+    return m_nTimerSlackMs;
+}
+
+TimerStats TimerManager::GetTimerStats() const
+{
+    std::lock_guard<std::mutex> threadGuard(m_taskMutex);
+    TimerStats timerStats = m_timerStats;
+    timerStats.nActiveTimers = m_nActiveTimers;
+    const uint64_t nStatsTicks = GetNowTick() - m_nStatsStartTick;
+    if (nStatsTicks >= 1000) {
+        //当前统计时间段已经超过1秒，使用当前时间段的数据
+        timerStats.fFiresPerSecond = m_nStatsFires * 1000.0 / nStatsTicks;
     }
+    return timerStats;
 }
 
-void TimerManager::ClearRemovedTimerId(size_t nTimerId)
+uint64_t TimerManager::GetNowTick() const
 {
-    m_removedTimerIds.erase(nTimerId);
+    return (uint64_t)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - m_startTime).count();
+}
+
+uint64_t TimerManager::CalcDueTick(uint64_t nNowTick, uint32_t uElapseMs) const
+{
+    uint64_t nDueTick = nNowTick + uElapseMs;
+    if (m_nTimerSlackMs > 1) {
+        //向后对齐到合并时间窗口的整数倍
+        nDueTick = (nDueTick + m_nTimerSlackMs - 1) / m_nTimerSlackMs * m_nTimerSlackMs;
+    }
+    return nDueTick;
 }
 
 void TimerManager::OnTimerMessage(uint32_t msgId, WPARAM /*wParam*/, LPARAM /*lParam*/)
@@ -160,48 +212,65 @@ void TimerManager::Poll()
 {
     //该函数在UI线程中调用
     std::unique_lock<std::mutex> taskGuard(m_taskMutex);
-    while (!m_aTimers.empty()) {
-        if (m_aTimers.top().weakFlag.expired() || IsTimerRemoved(m_aTimers.top().m_nTimerId)) {
-            //删除已经失效或者取消的定时器
-            ClearRemovedTimerId(m_aTimers.top().m_nTimerId);
-            m_aTimers.pop();
+    std::vector<size_t> readyTimerIds;
+    readyTimerIds.swap(m_readyTimerIds);
+    for (size_t nTimerId : readyTimerIds) {
+        TimerInfo* pTimerInfo = FindTimer(nTimerId);
+        if (pTimerInfo == nullptr) {
+            //定时器已经取消
+            continue;
+        }
+        if (pTimerInfo->weakFlag.expired()) {
+            //删除已经失效的定时器
+            FreeTimer(*pTimerInfo);
+            continue;
         }
-        else if (std::chrono::steady_clock::now() >= m_aTimers.top().trigerTime) {
-            //队列顶的定时器：已经达到定时器触发条件
-            TimerInfo timerTask = m_aTimers.top();
-            m_aTimers.pop();
 
-            if (!timerTask.weakFlag.expired()) {
-                //调用定时器的回调函数
-                taskGuard.unlock();
-                timerTask.timerCallback();
-                //LogUtil::OutputLine(StringUtil::Printf(_T("timerTask.timerCallback(): exec. TimerId: %u, ElapseMs: %u"), timerTask.m_nTimerId, timerTask.uElapseMs));
-                taskGuard.lock();
-            }
-            if (timerTask.uRepeatTime > 0) {
-                timerTask.uRepeatTime--;
-            }
-            if ((timerTask.uRepeatTime > 0) &&
-                !timerTask.weakFlag.expired() &&
-                !IsTimerRemoved(timerTask.m_nTimerId)) {
-                //如果未达到触发次数限制，重新设置下次触发的时间
-                timerTask.trigerTime = std::chrono::steady_clock::now();
-                timerTask.trigerTime += std::chrono::milliseconds(timerTask.uElapseMs); //计算出下次触发时间(当前时间 + 间隔的毫秒数)
-                m_aTimers.push(timerTask);
-            }
-            else {
-                //执行已完成或者已经失效
-                ClearRemovedTimerId(timerTask.m_nTimerId);
-            }
+        //更新统计数据
+        const uint64_t nNowTick = GetNowTick();
+        const uint64_t nLateMs = (nNowTick > pTimerInfo->nDueTick) ? (nNowTick - pTimerInfo->nDueTick) : 0;
+        m_timerStats.nTotalFires++;
+        if (nLateMs > kLateFireMs) {
+            m_timerStats.nLateFires++;
+        }
+        m_timerStats.nMaxLateMs = std::max(m_timerStats.nMaxLateMs, (uint32_t)std::min(nLateMs, (uint64_t)UINT32_MAX));
+        m_nStatsFires++;
+        if (nNowTick - m_nStatsStartTick >= 1000) {
+            m_timerStats.fFiresPerSecond = m_nStatsFires * 1000.0 / (nNowTick - m_nStatsStartTick);
+            m_nStatsStartTick = nNowTick;
+            m_nStatsFires = 0;
+        }
+
+        //调用定时器的回调函数（回调函数中可能删除或者添加定时器，位置可能失效，所以先将回调函数移出，调用后再放回）
+        TimerCallback timerCallback = std::move(pTimerInfo->timerCallback);
+        taskGuard.unlock();
+        timerCallback();
+        //LogUtil::OutputLine(StringUtil::Printf(_T("timerTask.timerCallback(): exec. TimerId: %u"), nTimerId));
+        taskGuard.lock();
+
+        pTimerInfo = FindTimer(nTimerId);
+        if (pTimerInfo == nullptr) {
+            //在回调函数中已经取消
+            continue;
+        }
+        TimerInfo& timerTask = *pTimerInfo;
+        if (timerTask.uRepeatTime > 0) {
+            timerTask.uRepeatTime--;
+        }
+        if ((timerTask.uRepeatTime > 0) && !timerTask.weakFlag.expired()) {
+            //如果未达到触发次数限制，重新设置下次触发的时间
+            timerTask.nDueTick = CalcDueTick(GetNowTick(), timerTask.uElapseMs); //计算出下次触发时间(当前时间 + 间隔的毫秒数)
+            timerTask.nWheelHandle = m_timerWheel.AddTimer(nTimerId, timerTask.nDueTick);
+            timerTask.timerCallback = std::move(timerCallback);
         }
         else {
-            //已经没有触发的定时器任务
-            break;
+            //执行已完成或者已经失效
+            FreeTimer(timerTask);
         }
     }
     //唤醒工作线程，检查任务状态
-    m_cv.notify_one();
     m_bHasPenddingPoll = false;
+    m_cv.notify_one();
 }
 
 void TimerManager::WorkerThreadProc()
@@ -211,7 +280,7 @@ void TimerManager::WorkerThreadProc()
         if (!m_bRunning) {
             break;
         }
-        if (m_aTimers.empty()) {
+        if (m_timerWheel.IsEmpty()) {
             //为空，等待任务
             m_cv.wait(taskGuard);
             if (!m_bRunning) {
@@ -219,30 +288,21 @@ void TimerManager::WorkerThreadProc()
             }
         }
         else {
-            //计算最早的任务，等待超时
-            uint32_t nDetaTimeMs = 0;
-            auto currentTime = std::chrono::steady_clock::now();
-            if (m_aTimers.top().weakFlag.expired() || IsTimerRemoved(m_aTimers.top().m_nTimerId)) {
-                //删除已经失效或者取消的定时器
-                nDetaTimeMs = 0;
-            }
-            else if (currentTime >= m_aTimers.top().trigerTime) {
-                //队列顶的定时器：已经达到定时器触发条件
-                nDetaTimeMs = 0;
-            }
-            else {
-                //已经没有触发的定时器任务
-                auto nDiffTimeMs = std::chrono::duration_cast<std::chrono::milliseconds>(m_aTimers.top().trigerTime - currentTime);
-                nDetaTimeMs = (uint32_t)nDiffTimeMs.count();
+            //推进时间轮，取出已经到达触发时间的定时器
+            const uint64_t nNowTick = GetNowTick();
+            m_timerWheel.Advance(nNowTick, m_readyTimerIds);
+            if (m_readyTimerIds.empty()) {
+                //计算下一次需要推进时间轮的时刻，等待超时
+                uint64_t nNextTick = nNowTick;
+                if (m_timerWheel.GetNextEventTick(nNextTick) && (nNextTick > nNowTick)) {
+                    //LogUtil::OutputLine(StringUtil::Printf(_T("condition_variable: wait_for timer event(%u ms)"), (uint32_t)(nNextTick - nNowTick)));
+                    //该函数精确度10ms左右
+                    //注意事项：发现gcc版本和glibc版本对wait_for都有问题（使用的时系统时间），gcc >=10 且 glibc >= 2.30 才会对程序行为没有影响。
+                    m_cv.wait_for(taskGuard, std::chrono::milliseconds(nNextTick - nNowTick));
+                }
+                continue;
             }
 
-            if (nDetaTimeMs > 0) {
-                //延迟等待超时
-                //LogUtil::OutputLine(StringUtil::Printf(_T("condition_variable: wait_for timer event(%u ms)"), nDetaTimeMs));
-                //该函数精确度10ms左右
-                //注意事项：发现gcc版本和glibc版本对wait_for都有问题（使用的时系统时间），gcc >=10 且 glibc >= 2.30 才会对程序行为没有影响。
-                m_cv.wait_for(taskGuard, std::chrono::milliseconds(nDetaTimeMs));
-            }
             //通知处理(发送到主线程执行, 此时不能加锁，避免出现死锁问题)
             m_bHasPenddingPoll = true;
             taskGuard.unlock();
@@ -3,8 +3,8 @@
 
 #include "duilib/Core/Callback.h"
 #include "duilib/Core/ThreadMessage.h"
-#include <queue>
-#include <set>
+#include "duilib/Core/TimerWheel.h"
+#include <vector>
 #include <chrono>
 #include <thread>
 #include <mutex>
@@ -16,7 +16,56 @@ namespace ui
 /** 定时器回调函数原型：void FunctionName();
 */
 typedef std::function<void()> TimerCallback;
-class TimerInfo;
+
+/** 定时器的数据
+*/
+class TimerInfo
+{
+public:
+    //定时器回调函数
+    TimerCallback timerCallback;
+
+    //取消定时器同步机制
+    std::weak_ptr<WeakFlag> weakFlag;
+
+    //定时器间隔：（单位：毫秒）
+    uint32_t uElapseMs = 0;
+
+    //重复次数
+    uint32_t uRepeatTime = 0;
+
+    //定时器的触发时间（相对于定时器管理器创建时间的毫秒数）
+    uint64_t nDueTick = 0;
+
+    //定时器在时间轮中的句柄
+    uint64_t nWheelHandle = 0;
+
+    //定时器ID（为0表示该位置空闲）
+    size_t nTimerId = 0;
+
+    //该位置的版本号（每次分配给新的定时器时加1）
+    size_t nGeneration = 0;
+};
+
+/** 定时器的运行统计数据
+*/
+struct TimerStats
+{
+    //当前的定时器个数
+    size_t nActiveTimers = 0;
+
+    //累计触发次数
+    uint64_t nTotalFires = 0;
+
+    //累计延迟触发的次数（比预定的触发时间晚16毫秒以上）
+    uint64_t nLateFires = 0;
+
+    //最大的延迟时间（毫秒）
+    uint32_t nMaxLateMs = 0;
+
+    //最近一段时间内，每秒触发的次数
+    double fFiresPerSecond = 0;
+};
 
 /** 定时器管理器
 */
@@ -52,6 +101,19 @@ public:
     */
     void RemoveTimer(size_t nTimerId);
 
+    /** 设置定时器的合并时间窗口（毫秒），默认为0（不合并）
+    *   触发时间向后对齐到该值的整数倍，时间相近的定时器在同一次唤醒中触发，每个定时器最多推迟nSlackMs毫秒
+    */
+    void SetTimerSlack(uint32_t nSlackMs);
+
+    /** 获取定时器的合并时间窗口（毫秒）
+    */
+    uint32_t GetTimerSlack() const;
+
+    /** 获取定时器的运行统计数据
+    */
+    TimerStats GetTimerStats() const;
+
     /** 关闭定时器管理器，释放资源
      */
     void Clear();
@@ -65,13 +127,21 @@ private:
     */
     void Poll();
 
-    /** 是否定时器任务已经被取消
+    /** 获取当前时间（相对于定时器管理器创建时间的毫秒数）
+    */
+    uint64_t GetNowTick() const;
+
+    /** 计算定时器的触发时间（按合并时间窗口对齐）
+    */
+    uint64_t CalcDueTick(uint64_t nNowTick, uint32_t uElapseMs) const;
+
+    /** 根据定时器ID查找定时器数据（直接按ID中的下标访问，ID已经失效时返回nullptr）
     */
-    bool IsTimerRemoved(size_t nTimerId) const;
+    TimerInfo* FindTimer(size_t nTimerId);
 
-    /** 移除已经取消的定时器任务ID
+    /** 释放定时器数据所在的位置
     */
-    void ClearRemovedTimerId(size_t nTimerId);
+    void FreeTimer(TimerInfo& timerInfo);
 
 private:
     /** 消息窗口函数
@@ -79,17 +149,40 @@ private:
     void OnTimerMessage(uint32_t msgId, WPARAM wParam, LPARAM lParam);
 
 private:
-    /** 所有注册的定时器
+    /** 所有注册的定时器，按位置下标访问
+    *   定时器ID的低位是位置下标加1，高位是该位置的版本号，位置被重新分配后旧的ID失效
+    */
+    std::vector<TimerInfo> m_timers;
+
+    /** 空闲位置的下标
+    */
+    std::vector<size_t> m_freeTimerSlots;
+
+    /** 当前的定时器个数
+    */
+    size_t m_nActiveTimers;
+
+    /** 管理定时器触发时间的时间轮
+    */
+    TimerWheel m_timerWheel;
+
+    /** 已经到达触发时间，等待主线程派发回调的定时器任务ID
+    */
+    std::vector<size_t> m_readyTimerIds;
+
+    /** 定时器的合并时间窗口（毫秒）
     */
-    std::priority_queue<TimerInfo> m_aTimers;
+    uint32_t m_nTimerSlackMs;
 
-    /** 下一个定时器任务ID
+    /** 时间的起点（定时器管理器的创建时间）
     */
-    size_t m_nNextTimerId;
+    std::chrono::steady_clock::time_point m_startTime;
 
-    /** 移除的定时器任务ID
+    /** 统计数据，以及计算每秒触发次数的时间段起点和该时间段内的触发次数
     */
-    std::set<size_t> m_removedTimerIds;
+    TimerStats m_timerStats;
+    uint64_t m_nStatsStartTick;
+    uint64_t m_nStatsFires;
 
 private:
     /** 是否正在运行中
@@ -110,7 +203,7 @@ private:
 
     /** 任务数据容器锁
     */
-    std::mutex m_taskMutex;
+    mutable std::mutex m_taskMutex;
 
     /** 线程间通信机制（与主线程）
     */
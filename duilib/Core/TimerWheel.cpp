@@ -0,0 +1,214 @@
+#include "TimerWheel.h"
+#include <algorithm>
+#include <bit>
+
+namespace ui
+{
+namespace
+{
+/** 无效的节点下标
+*/
+const uint32_t kInvalidNode = UINT32_MAX;
+}
+
+TimerWheel::TimerWheel():
+    m_nTimerCount(0),
+    m_nCurrentTick(0)
+{
+    Clear();
+}
+
+uint64_t TimerWheel::AddTimer(size_t nTimerId, uint64_t nDueTick)
+{
+    uint32_t nNode = kInvalidNode;
+    if (!m_freeNodes.empty()) {
+        nNode = m_freeNodes.back();
+        m_freeNodes.pop_back();
+    }
+    else {
+        nNode = (uint32_t)m_nodes.size();
+        m_nodes.push_back(TimerNode());
+        m_nodes[nNode].nGeneration = 1;
+        m_nodes[nNode].nSlot = kInvalidNode;
+    }
+    TimerNode& node = m_nodes[nNode];
+    node.nTimerId = nTimerId;
+    node.nDueTick = std::max(nDueTick, m_nCurrentTick + 1);
+    LinkNode(nNode);
+    ++m_nTimerCount;
+    //句柄：高32位为节点的版本号，低32位为节点下标
+    return ((uint64_t)node.nGeneration << 32) | nNode;
+}
+
+bool TimerWheel::RemoveTimer(uint64_t nTimerHandle)
+{
+    const uint32_t nNode = (uint32_t)(nTimerHandle & UINT32_MAX);
+    if ((nNode >= m_nodes.size()) ||
+        (m_nodes[nNode].nGeneration != (uint32_t)(nTimerHandle >> 32)) ||
+        (m_nodes[nNode].nSlot == kInvalidNode)) {
+        return false;
+    }
+    UnlinkNode(nNode);
+    FreeNode(nNode);
+    return true;
+}
+
+void TimerWheel::Advance(uint64_t nNowTick, std::vector<size_t>& expiredTimerIds)
+{
+    while (m_nCurrentTick < nNowTick) {
+        //跳过没有定时器触发、也没有上层槽下移的时间
+        uint64_t nNextTick = 0;
+        if (!GetNextEventTick(nNextTick) || (nNextTick > nNowTick)) {
+            m_nCurrentTick = nNowTick;
+            break;
+        }
+        m_nCurrentTick = nNextTick;
+
+        //从上层到下层，依次将到期的上层槽下移
+        for (uint32_t nLevel = kLevelCount - 1; nLevel > 0; --nLevel) {
+            const uint32_t nShift = nLevel * kSlotBits;
+            if ((nNextTick & ((1ull << nShift) - 1)) == 0) {
+                CascadeSlot(nLevel * kSlotCount + (uint32_t)((nNextTick >> nShift) & (kSlotCount - 1)));
+            }
+        }
+
+        //第0层的槽中，都是在当前时间触发的定时器
+        const uint32_t nSlot = (uint32_t)(nNextTick & (kSlotCount - 1));
+        uint32_t nNode = m_slotHeads[nSlot];
+        while (nNode != kInvalidNode) {
+            const uint32_t nNextNode = m_nodes[nNode].nNext;
+            expiredTimerIds.push_back(m_nodes[nNode].nTimerId);
+            FreeNode(nNode);
+            nNode = nNextNode;
+        }
+        m_slotHeads[nSlot] = kInvalidNode;
+        m_slotTails[nSlot] = kInvalidNode;
+        m_slotBits[0] &= ~(1ull << nSlot);
+    }
+}
+
+bool TimerWheel::GetNextEventTick(uint64_t& nNextTick) const
+{
+    bool bFound = false;
+    for (uint32_t nLevel = 0; nLevel < kLevelCount; ++nLevel) {
+        if (m_slotBits[nLevel] == 0) {
+            continue;
+        }
+        //第nLevel层的槽，在该层的时间刻度（64^nLevel毫秒）经过槽的位置时下移或者触发
+        const uint32_t nShift = nLevel * kSlotBits;
+        const uint64_t nBase = m_nCurrentTick >> nShift;
+        const uint32_t nStart = (uint32_t)((nBase + 1) & (kSlotCount - 1));
+        const uint64_t nOffset = (uint64_t)std::countr_zero(std::rotr(m_slotBits[nLevel], (int)nStart)) + 1;
+        const uint64_t nTick = (nBase + nOffset) << nShift;
+        if (!bFound || (nTick < nNextTick)) {
+            nNextTick = nTick;
+            bFound = true;
+        }
+    }
+    return bFound;
+}
+
+uint64_t TimerWheel::GetCurrentTick() const
+{
+    return m_nCurrentTick;
+}
+
+size_t TimerWheel::GetTimerCount() const
+{
+    return m_nTimerCount;
+}
+
+bool TimerWheel::IsEmpty() const
+{
+    return m_nTimerCount == 0;
+}
+
+void TimerWheel::Clear()
+{
+    //保留节点并更新其版本号，使已有的句柄失效
+    for (uint32_t nNode = 0; nNode < (uint32_t)m_nodes.size(); ++nNode) {
+        if (m_nodes[nNode].nSlot != kInvalidNode) {
+            FreeNode(nNode);
+        }
+    }
+    for (uint32_t nSlot = 0; nSlot < kLevelCount * kSlotCount; ++nSlot) {
+        m_slotHeads[nSlot] = kInvalidNode;
+        m_slotTails[nSlot] = kInvalidNode;
+    }
+    for (uint32_t nLevel = 0; nLevel < kLevelCount; ++nLevel) {
+        m_slotBits[nLevel] = 0;
+    }
+}
+
+void TimerWheel::LinkNode(uint32_t nNode)
+{
+    TimerNode& node = m_nodes[nNode];
+    //根据距离触发的时间选择层：第nLevel层覆盖[64^nLevel, 64^(nLevel+1))毫秒，超出范围的放在最上层，下移时再重新计算
+    const uint64_t nMaxTick = m_nCurrentTick + (1ull << (kLevelCount * kSlotBits)) - 1;
+    const uint64_t nSlotTick = std::min(node.nDueTick, nMaxTick);
+    const uint64_t nDelta = nSlotTick - m_nCurrentTick;
+    uint32_t nLevel = 0;
+    while ((nLevel < kLevelCount - 1) && (nDelta >= (1ull << ((nLevel + 1) * kSlotBits)))) {
+        ++nLevel;
+    }
+    const uint32_t nIndex = (uint32_t)((nSlotTick >> (nLevel * kSlotBits)) & (kSlotCount - 1));
+    const uint32_t nSlot = nLevel * kSlotCount + nIndex;
+
+    //添加到链表尾部，同一个槽中的定时器按添加顺序触发
+    node.nSlot = nSlot;
+    node.nPrev = m_slotTails[nSlot];
+    node.nNext = kInvalidNode;
+    if (node.nPrev != kInvalidNode) {
+        m_nodes[node.nPrev].nNext = nNode;
+    }
+    else {
+        m_slotHeads[nSlot] = nNode;
+    }
+    m_slotTails[nSlot] = nNode;
+    m_slotBits[nLevel] |= (1ull << nIndex);
+}
+
+void TimerWheel::UnlinkNode(uint32_t nNode)
+{
+    const TimerNode& node = m_nodes[nNode];
+    const uint32_t nSlot = node.nSlot;
+    if (node.nPrev != kInvalidNode) {
+        m_nodes[node.nPrev].nNext = node.nNext;
+    }
+    else {
+        m_slotHeads[nSlot] = node.nNext;
+    }
+    if (node.nNext != kInvalidNode) {
+        m_nodes[node.nNext].nPrev = node.nPrev;
+    }
+    else {
+        m_slotTails[nSlot] = node.nPrev;
+    }
+    if (m_slotHeads[nSlot] == kInvalidNode) {
+        m_slotBits[nSlot / kSlotCount] &= ~(1ull << (nSlot % kSlotCount));
+    }
+}
+
+void TimerWheel::CascadeSlot(uint32_t nSlot)
+{
+    uint32_t nNode = m_slotHeads[nSlot];
+    m_slotHeads[nSlot] = kInvalidNode;
+    m_slotTails[nSlot] = kInvalidNode;
+    m_slotBits[nSlot / kSlotCount] &= ~(1ull << (nSlot % kSlotCount));
+    while (nNode != kInvalidNode) {
+        const uint32_t nNextNode = m_nodes[nNode].nNext;
+        LinkNode(nNode);
+        nNode = nNextNode;
+    }
+}
+
+void TimerWheel::FreeNode(uint32_t nNode)
+{
+    TimerNode& node = m_nodes[nNode];
+    node.nSlot = kInvalidNode;
+    node.nGeneration = (node.nGeneration == UINT32_MAX) ? 1 : (node.nGeneration + 1);
+    m_freeNodes.push_back(nNode);
+    --m_nTimerCount;
+}
+
+} // namespace ui
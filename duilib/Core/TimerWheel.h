@@ -0,0 +1,122 @@
+#ifndef UI_CORE_TIMER_WHEEL_H_
+#define UI_CORE_TIMER_WHEEL_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ui
+{
+/** 分层时间轮：管理定时器的触发时间（时间单位为毫秒，由调用方提供当前时间）
+*   1. 共5层，每层64个槽，第0层每个槽1毫秒，上一层每个槽是下一层的64倍，可覆盖约12天
+*   2. 添加和删除定时器的复杂度为O(1)，时间推进时上层槽中的定时器逐级下移到下层
+*   3. 只记录定时器ID和触发时间，定时器的回调等数据由调用方管理
+*/
+class TimerWheel
+{
+public:
+    TimerWheel();
+
+    /** 添加一个定时器
+    * @param [in] nTimerId 定时器ID（触发时返回该ID）
+    * @param [in] nDueTick 触发时间，如果不晚于当前时间，则在下一个毫秒触发
+    * @return 返回定时器在时间轮中的句柄（其值大于0），用于删除定时器
+    */
+    uint64_t AddTimer(size_t nTimerId, uint64_t nDueTick);
+
+    /** 删除一个定时器
+    * @param [in] nTimerHandle 定时器的句柄，即AddTimer的返回值
+    * @return 如果定时器存在返回true；如果定时器已经触发或者已经删除，返回false
+    */
+    bool RemoveTimer(uint64_t nTimerHandle);
+
+    /** 推进时间，取出所有已经到达触发时间的定时器（同时从时间轮中删除）
+    * @param [in] nNowTick 当前时间
+    * @param [out] expiredTimerIds 追加到达触发时间的定时器ID，按触发时间排序
+    */
+    void Advance(uint64_t nNowTick, std::vector<size_t>& expiredTimerIds);
+
+    /** 获取下一次需要推进时间的时刻（定时器触发或者上层槽下移的时间，可能早于实际的触发时间）
+    * @param [out] nNextTick 返回下一次需要推进时间的时刻
+    * @return 如果没有定时器，返回false
+    */
+    bool GetNextEventTick(uint64_t& nNextTick) const;
+
+    /** 获取当前时间（最后一次推进到的时间）
+    */
+    uint64_t GetCurrentTick() const;
+
+    /** 获取定时器的个数
+    */
+    size_t GetTimerCount() const;
+
+    /** 是否没有定时器
+    */
+    bool IsEmpty() const;
+
+    /** 删除所有定时器（已有的句柄全部失效），当前时间不变
+    */
+    void Clear();
+
+private:
+    /** 将节点插入到与其触发时间对应的槽中
+    */
+    void LinkNode(uint32_t nNode);
+
+    /** 将节点从所在的槽中移除
+    */
+    void UnlinkNode(uint32_t nNode);
+
+    /** 将上层槽中的定时器重新插入到下层的槽中
+    */
+    void CascadeSlot(uint32_t nSlot);
+
+    /** 释放节点
+    */
+    void FreeNode(uint32_t nNode);
+
+private:
+    /** 层数、每层的槽数
+    */
+    static constexpr uint32_t kLevelCount = 5;
+    static constexpr uint32_t kSlotBits = 6;
+    static constexpr uint32_t kSlotCount = 1 << kSlotBits;
+
+    /** 定时器节点（各个槽中的定时器组成双向链表）
+    */
+    struct TimerNode
+    {
+        size_t nTimerId;
+        uint64_t nDueTick;
+        uint32_t nGeneration;   //节点每次释放后加1，句柄中的值不一致时说明句柄已经失效
+        uint32_t nSlot;
+        uint32_t nPrev;
+        uint32_t nNext;
+    };
+
+    /** 所有节点，以及空闲节点的下标
+    */
+    std::vector<TimerNode> m_nodes;
+    std::vector<uint32_t> m_freeNodes;
+
+    /** 定时器的个数
+    */
+    size_t m_nTimerCount;
+
+    /** 每个槽中链表的头节点和尾节点
+    */
+    uint32_t m_slotHeads[kLevelCount * kSlotCount];
+    uint32_t m_slotTails[kLevelCount * kSlotCount];
+
+    /** 每层中非空的槽（每个槽对应一个二进制位）
+    */
+    uint64_t m_slotBits[kLevelCount];
+
+    /** 当前时间
+    */
+    uint64_t m_nCurrentTick;
+};
+
+} // namespace ui
+
+#endif // UI_CORE_TIMER_WHEEL_H_
@@ -9,6 +9,7 @@
 #include "duilib/Core/WindowMessage.h"
 #include "duilib/Render/IRender.h"
 #include "duilib/Render/AutoClip.h"
+#include "duilib/Render/RenderCache.h"
 #include "duilib/Utils/PerformanceUtil.h"
 #include "duilib/Utils/FilePathUtil.h"
 #include "duilib/Utils/AttributeUtil.h"
@@ -26,6 +27,7 @@ Window::Window() :
     m_bFirstLayout(false),
     m_bInitLayout(false),
     m_bIsArranged(false),
+    m_bPaintOnRenderThread(false),
     m_bPostQuitMsgWhenClosed(false),
     m_renderBackendType(RenderBackendType::kRaster_BackendType),
     m_bWindowAttributesApplied(false),
@@ -66,6 +68,18 @@ void Window::SetAttribute(const DString& strName, const DString& strValue)
         //分层窗口的透明度
         SetLayeredWindowAlpha(StringUtil::StringToInt32(strValue));
     }
+    else if (strName == _T("frame_time_overlay")) {
+        //是否显示帧耗时的统计图
+        SetFrameTimeOverlay(strValue == _T("true"));
+    }
+    else if (strName == _T("paint_on_render_thread")) {
+        //是否在独立的渲染线程中绘制
+        SetPaintOnRenderThread(strValue == _T("true"));
+    }
+    else if (strName == _T("hit_test_index")) {
+        //按坐标查找控件时，是否使用空间索引
+        SetHitTestIndexEnabled(strValue == _T("true"));
+    }
 }
 
 void Window::SetEnableDragDrop(bool bEnable)
@@ -146,6 +160,9 @@ bool Window::SetRenderBackendType(RenderBackendType backendType)
         if (pRenderFactory != nullptr) {
             m_render.reset(pRenderFactory->CreateRender(GetRenderDpi(), GetWindowHandle(), m_renderBackendType));
             bRet = (m_render != nullptr) ? true : false;
+            if (bRet && m_bPaintOnRenderThread) {
+                m_render->SetPaintOnRenderThread(true);
+            }
         }
     }
     else {
@@ -215,6 +232,11 @@ DString Window::GetSkinFile()
     return m_skinFile;
 }
 
+bool Window::IsSkinFileCacheEnabled() const
+{
+    return false;
+}
+
 Control* Window::CreateControl(const DString& /*strClass*/)
 {
     return nullptr;
@@ -283,7 +305,12 @@ void Window::ParseWindowXml()
     }
     else {
         ASSERT(!skinXmlFilePath.IsEmpty());
-        bRet = m_windowBuilder->ParseXmlFile(skinXmlFilePath, GetResourcePath());
+        if (IsSkinFileCacheEnabled()) {
+            bRet = m_windowBuilder->ParseXmlFileWithCache(skinXmlFilePath, GetResourcePath());
+        }
+        else {
+            bRet = m_windowBuilder->ParseXmlFile(skinXmlFilePath, GetResourcePath());
+        }
     }
     if (!bRet) {
         m_windowBuilder.reset();
@@ -351,6 +378,9 @@ void Window::PostInitWindow()
         ASSERT(pRenderFactory != nullptr);
         if (pRenderFactory != nullptr) {
             m_render.reset(pRenderFactory->CreateRender(GetRenderDpi(), GetWindowHandle(), m_renderBackendType));
+            if ((m_render != nullptr) && m_bPaintOnRenderThread) {
+                m_render->SetPaintOnRenderThread(true);
+            }
         }
     }
     ASSERT(m_render != nullptr);
@@ -774,6 +804,7 @@ void Window::InvalidateAll()
     UiRect rcClient;
     GetClientRect(rcClient);
     Invalidate(rcClient);
+    RenderCache::Instance().InvalidateWindow(this);
 }
 
 void Window::OnWindowAlphaChanged()
@@ -1237,6 +1268,8 @@ bool Window::Paint(const UiRect& rcPaint)
     if (pRender == nullptr) {
         return false;
     }
+    PerformanceTrace tracePaint(_T("Window::Paint"));
+    const std::chrono::steady_clock::time_point paintStartTime = std::chrono::steady_clock::now();
 
     //开始绘制前，去掉alpha通道
     if (IsLayeredWindow()) {
@@ -1253,7 +1286,9 @@ bool Window::Paint(const UiRect& rcPaint)
         PerformanceStat statPerformance(_T("PaintWindow, Window::Paint Paint/PaintChild"));
         AutoClip rectClip(pRender, rcPaint, true);
         UiPoint ptOldWindOrg = pRender->OffsetWindowOrg(m_renderOffset);
+        RenderCache::Instance().BeginPaint();
         pRoot->AlphaPaint(pRender, rcPaint);
+        RenderCache::Instance().EndPaint();
         pRender->SetWindowOrg(ptOldWindOrg);
     }
     else {
@@ -1264,6 +1299,10 @@ bool Window::Paint(const UiRect& rcPaint)
         pRender->FillRect(rcPaint, bkColor);
     }
 
+    if (m_pFrameTimeHistory != nullptr) {
+        PaintFrameTimeOverlay(pRender, rcPaint, paintStartTime);
+    }
+
 #if defined (DUILIB_BUILD_FOR_WIN) && !defined(DUILIB_RICH_EDIT_DRAW_OPT)
     //开始绘制前，进行alpha通道修复
     if (IsLayeredWindow()) {
@@ -1301,6 +1340,138 @@ bool Window::Paint(const UiRect& rcPaint)
     return true;
 }
 
+void Window::SetFrameTimeOverlay(bool bEnable)
+{
+    if (bEnable == IsFrameTimeOverlay()) {
+        return;
+    }
+    if (bEnable) {
+        m_pFrameTimeHistory = std::make_unique<FrameTimeHistory>();
+    }
+    else {
+        m_pFrameTimeHistory.reset();
+    }
+    if (IsWindow()) {
+        Invalidate(GetFrameTimeOverlayRect());
+    }
+}
+
+void Window::SetPaintOnRenderThread(bool bEnable)
+{
+    GlobalManager::Instance().AssertUIThread();
+    m_bPaintOnRenderThread = bEnable;
+    if (m_render != nullptr) {
+        if (m_render->IsPaintOnRenderThread() == bEnable) {
+            return;
+        }
+        m_render->SetPaintOnRenderThread(bEnable);
+        if (IsWindow()) {
+            //切换后，后台缓冲区的数据可能失效，需要完整重绘
+            InvalidateAll();
+        }
+    }
+}
+
+bool Window::IsPaintOnRenderThread() const
+{
+    if (m_render != nullptr) {
+        return m_render->IsPaintOnRenderThread();
+    }
+    return m_bPaintOnRenderThread;
+}
+
+bool Window::IsFrameTimeOverlay() const
+{
+    return m_pFrameTimeHistory != nullptr;
+}
+
+UiRect Window::GetFrameTimeOverlayRect() const
+{
+    const int32_t nMargin = Dpi().GetScaleInt(4);
+    return UiRect(nMargin, nMargin, nMargin + Dpi().GetScaleInt(200), nMargin + Dpi().GetScaleInt(90));
+}
+
+void Window::PaintFrameTimeOverlay(IRender* pRender, const UiRect& rcPaint,
+                                   std::chrono::steady_clock::time_point paintStartTime)
+{
+    ASSERT((pRender != nullptr) && (m_pFrameTimeHistory != nullptr));
+    if ((pRender == nullptr) || (m_pFrameTimeHistory == nullptr)) {
+        return;
+    }
+    const UiRect rcOverlay = GetFrameTimeOverlayRect();
+    //只重绘统计图区域时（由统计图自身触发），不计入帧耗时
+    const bool bOverlayOnly = rcOverlay.ContainsRect(rcPaint);
+    if (!bOverlayOnly) {
+        m_pFrameTimeHistory->AddFrame(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - paintStartTime));
+    }
+
+    UiRect rcDraw;
+    if (UiRect::Intersect(rcDraw, rcPaint, rcOverlay)) {
+        AutoClip rectClip(pRender, rcDraw, true);
+        pRender->FillRect(rcOverlay, UiColor(0xC0000000));
+
+        //第一行：平均耗时和最大耗时
+        const int32_t nPadding = Dpi().GetScaleInt(4);
+        const int32_t nTextHeight = Dpi().GetScaleInt(18);
+        UiRect rcText(rcOverlay.left + nPadding, rcOverlay.top, rcOverlay.right - nPadding, rcOverlay.top + nTextHeight);
+        FontManager& fontManager = GlobalManager::Instance().Font();
+        IFont* pFont = fontManager.GetIFont(fontManager.GetDefaultFontId(), Dpi());
+        if (pFont != nullptr) {
+            DrawStringParam drawParam;
+            drawParam.pFont = pFont;
+            drawParam.dwTextColor = UiColor(UiColors::White);
+            drawParam.uFormat = TEXT_LEFT | TEXT_VCENTER | TEXT_SINGLELINE | TEXT_END_ELLIPSIS;
+            drawParam.textRect = rcText;
+            const DString text = StringUtil::Printf(_T("avg %.1f ms, max %.1f ms"),
+                                                    m_pFrameTimeHistory->GetAverageTime().count() / 1000.0,
+                                                    m_pFrameTimeHistory->GetMaxTime().count() / 1000.0);
+            pRender->DrawString(text, drawParam);
+        }
+
+        //帧耗时的分段统计：每段一个柱形，底部为分段的上限（毫秒）
+        std::vector<uint32_t> histogram;
+        m_pFrameTimeHistory->GetHistogram(histogram);
+        const std::vector<uint32_t>& bounds = FrameTimeHistory::GetHistogramBounds();
+        const uint32_t nMaxCount = std::max(*std::max_element(histogram.begin(), histogram.end()), (uint32_t)1);
+        const int32_t nLabelHeight = Dpi().GetScaleInt(14);
+        const int32_t nBarsTop = rcText.bottom + nPadding;
+        const int32_t nBarsBottom = rcOverlay.bottom - nLabelHeight;
+        const int32_t nBarCount = (int32_t)histogram.size();
+        const int32_t nBarWidth = (rcOverlay.Width() - nPadding * 2) / nBarCount;
+        for (int32_t nBar = 0; nBar < nBarCount; ++nBar) {
+            UiColor barColor(0xFF4CAF50);       //60帧/秒以内
+            if (nBar >= 4) {
+                barColor = UiColor(0xFFF44336);
+            }
+            else if (nBar == 3) {
+                barColor = UiColor(0xFFFFC107); //30帧/秒以内
+            }
+            UiRect rcBar(rcOverlay.left + nPadding + nBar * nBarWidth, nBarsTop,
+                         rcOverlay.left + nPadding + (nBar + 1) * nBarWidth - Dpi().GetScaleInt(2), nBarsBottom);
+            rcBar.top = rcBar.bottom - (int32_t)((int64_t)rcBar.Height() * histogram[nBar] / nMaxCount);
+            if (histogram[nBar] > 0) {
+                pRender->FillRect(rcBar, barColor);
+            }
+            if (pFont != nullptr) {
+                DrawStringParam drawParam;
+                drawParam.pFont = pFont;
+                drawParam.dwTextColor = UiColor(UiColors::LightGray);
+                drawParam.uFormat = TEXT_HCENTER | TEXT_VCENTER | TEXT_SINGLELINE;
+                drawParam.textRect = UiRect(rcBar.left, nBarsBottom, rcBar.right, rcOverlay.bottom);
+                DString label = _T("+");
+                if (nBar < (int32_t)bounds.size()) {
+                    label = StringUtil::UInt32ToString(bounds[nBar]);
+                }
+                pRender->DrawString(label, drawParam);
+            }
+        }
+    }
+    if (!bOverlayOnly && !rcPaint.ContainsRect(rcOverlay)) {
+        //本次绘制未覆盖统计图，更新统计图
+        Invalidate(rcOverlay);
+    }
+}
+
 LRESULT Window::OnSetFocusMsg(WindowBase* /*pLostFocusWindow*/, const NativeMsg& /*nativeMsg*/, bool& bHandled)
 {
     bHandled = false;
@@ -2550,6 +2721,16 @@ Control* Window::FindSubControlByName(Control* pParent, const DString& strName)
     return m_controlFinder.FindSubControlByName(pParent, strName);
 }
 
+void Window::SetHitTestIndexEnabled(bool bEnabled)
+{
+    m_controlFinder.SetHitTestIndexEnabled(bEnabled);
+}
+
+bool Window::IsHitTestIndexEnabled() const
+{
+    return m_controlFinder.IsHitTestIndexEnabled();
+}
+
 Shadow* Window::GetShadow() const
 {
     ASSERT(m_shadow != nullptr);
@@ -8,6 +8,7 @@
 #include "duilib/Core/ControlPtrT.h"
 #include "duilib/Render/IRender.h"
 #include "duilib/Utils/FilePath.h"
+#include <chrono>
 
 namespace ui
 {
@@ -16,6 +17,7 @@ class Box;
 class Control;
 class ToolTip;
 class WindowBuilder;
+class FrameTimeHistory;
 
 /** 窗口类
 *  //外部调用需要初始化的基本流程:
@@ -241,6 +243,26 @@ public:
     */
     void InvalidateAll();
 
+    /** 设置是否在窗口左上角显示帧耗时的统计图（每帧绘制的耗时分段统计，用于分析界面卡顿）
+    * @param [in] bEnable true表示显示，false表示不显示
+    */
+    void SetFrameTimeOverlay(bool bEnable);
+
+    /** 是否显示帧耗时的统计图
+    */
+    bool IsFrameTimeOverlay() const;
+
+    /** 设置是否在独立的渲染线程中绘制（对应XML中窗口的属性：paint_on_render_thread）
+    *   开启后，UI线程只录制绘制命令，由渲染线程完成光栅化，UI线程可以继续处理后续的输入消息；
+    *   适合窗口较大、阴影等绘制耗时较多的窗口（目前只有SDL的CPU绘制支持）
+    * @param [in] bEnable true表示在渲染线程中绘制，false表示在UI线程中同步绘制
+    */
+    void SetPaintOnRenderThread(bool bEnable);
+
+    /** 是否在独立的渲染线程中绘制
+    */
+    bool IsPaintOnRenderThread() const;
+
     /** @} */
 
 public:
@@ -284,6 +306,17 @@ public:
     */
     Control* FindSubControlByName(Control* pParent, const DString& strName) const;
 
+    /** 设置按坐标查找控件时，是否使用空间索引（对应XML中窗口的属性：hit_test_index）
+    *   启用后，子控件数量较多的容器按子控件的位置建立网格索引，鼠标移动等按坐标查找控件时，只检查坐标所在网格中的子控件；
+    *   适合含有大量浮动控件或者子控件的窗口，子控件较少的容器仍然遍历查找
+    * @param [in] bEnabled true表示启用，false表示不启用
+    */
+    void SetHitTestIndexEnabled(bool bEnabled);
+
+    /** 按坐标查找控件时，是否使用空间索引
+    */
+    bool IsHitTestIndexEnabled() const;
+
     /** @} */
 
 public:
@@ -437,6 +470,11 @@ public:
     */
     virtual DString GetSkinFile();
 
+    /** 创建窗口时被调用，子类可重写该函数，返回true表示窗口皮肤 XML 描述文件使用窗口模板缓存
+    *   首次解析后编译为窗口模板并缓存，再次创建窗口时不需要读取和解析XML文件，适合反复创建的窗口（比如菜单）
+    */
+    virtual bool IsSkinFileCacheEnabled() const;
+
     /** 当要创建的控件不是标准的控件名称时会调用该函数
     * @param [in] strClass 控件名称
     * @return 返回一个自定义控件指针，一般情况下根据 strClass 参数创建自定义的控件
@@ -993,6 +1031,18 @@ private:
     */
     bool Paint(const UiRect& rcPaint);
 
+    /** 获取帧耗时统计图的显示区域
+    */
+    UiRect GetFrameTimeOverlayRect() const;
+
+    /** 记录本帧的耗时，并绘制帧耗时的统计图
+    * @param [in] pRender 绘制接口
+    * @param [in] rcPaint 本次绘制更新的矩形区域
+    * @param [in] paintStartTime 本帧开始绘制的时间
+    */
+    void PaintFrameTimeOverlay(IRender* pRender, const UiRect& rcPaint,
+                               std::chrono::steady_clock::time_point paintStartTime);
+
     /** 调整Render的尺寸，与当前客户区的大小一致
     */
     bool ResizeRenderToClientSize() const;
@@ -1101,6 +1151,12 @@ private:
     //绘制引擎
     std::unique_ptr<IRender> m_render;
 
+    //帧耗时的统计数据（显示帧耗时的统计图时有效）
+    std::unique_ptr<FrameTimeHistory> m_pFrameTimeHistory;
+
+    //是否在独立的渲染线程中绘制
+    bool m_bPaintOnRenderThread;
+
 private:
     /** 每个窗口的资源路径(相对于资源根目录的路径)
     */
@@ -8,6 +8,8 @@
 #include "duilib/Core/ControlResizable.h"
 #include "duilib/Core/ScrollBar.h"
 #include "duilib/Core/WindowCreateAttributes.h"
+#include "duilib/Core/XmlBinaryCache.h"
+#include "duilib/Core/WindowTemplate.h"
 
 #include "duilib/Control/TreeView.h"
 #include "duilib/Control/DirectoryTree.h"
@@ -68,7 +70,22 @@
 namespace ui 
 {
 
-WindowBuilder::WindowBuilder()
+//是否启用XML二进制缓存，缓存文件所在目录，以及是否压缩缓存文件
+static bool s_bXmlBinaryCacheEnabled = false;
+static FilePath s_xmlBinaryCacheDir;
+static bool s_bXmlBinaryCacheCompressed = false;
+
+//窗口模板缓存：关键字为XML文件路径，值为窗口模板文档，以及是否为预编译的窗口模板
+struct WindowTemplateItem
+{
+    std::shared_ptr<XmlBinaryDocument> m_doc;
+    bool m_bPrecompiled;
+};
+static bool s_bWindowTemplateCacheEnabled = false;
+static std::map<DString, WindowTemplateItem> s_windowTemplates;
+
+WindowBuilder::WindowBuilder():
+    m_bUseWindowTemplate(false)
 {
     m_xml = std::make_unique<pugi::xml_document>();
 }
@@ -195,6 +212,106 @@ Control* WindowBuilder::CreateControlByClass(const DString& strControlClass, Win
     return pControl;
 }
 
+void WindowBuilder::SetXmlBinaryCacheEnabled(bool bEnabled, const FilePath& cacheDir, bool bCompressed)
+{
+    GlobalManager::Instance().AssertUIThread();
+    s_bXmlBinaryCacheEnabled = bEnabled;
+    s_xmlBinaryCacheDir = cacheDir;
+    s_bXmlBinaryCacheCompressed = bCompressed;
+}
+
+bool WindowBuilder::IsXmlBinaryCacheEnabled()
+{
+    return s_bXmlBinaryCacheEnabled;
+}
+
+void WindowBuilder::SetWindowTemplateCacheEnabled(bool bEnabled)
+{
+    GlobalManager::Instance().AssertUIThread();
+    s_bWindowTemplateCacheEnabled = bEnabled;
+    if (!bEnabled) {
+        ClearWindowTemplates(false);
+    }
+}
+
+bool WindowBuilder::IsWindowTemplateCacheEnabled()
+{
+    return s_bWindowTemplateCacheEnabled;
+}
+
+bool WindowBuilder::AddWindowTemplate(const FilePath& xmlFilePath, std::vector<uint8_t>&& templateData)
+{
+    GlobalManager::Instance().AssertUIThread();
+    ASSERT(!xmlFilePath.IsEmpty());
+    if (xmlFilePath.IsEmpty()) {
+        return false;
+    }
+    std::shared_ptr<XmlBinaryDocument> doc = std::make_shared<XmlBinaryDocument>();
+    if (!doc->LoadBuffer(std::move(templateData))) {
+        ASSERT(!"WindowBuilder::AddWindowTemplate: invalid template data!");
+        return false;
+    }
+    s_windowTemplates[xmlFilePath.ToString()] = WindowTemplateItem{ doc, true };
+    return true;
+}
+
+void WindowBuilder::ClearWindowTemplates(bool bPrecompiled)
+{
+    GlobalManager::Instance().AssertUIThread();
+    for (auto iter = s_windowTemplates.begin(); iter != s_windowTemplates.end();) {
+        if (bPrecompiled || !iter->second.m_bPrecompiled) {
+            iter = s_windowTemplates.erase(iter);
+        }
+        else {
+            ++iter;
+        }
+    }
+}
+
+std::shared_ptr<XmlBinaryDocument> WindowBuilder::FindWindowTemplate(const FilePath& xmlFilePath, const FilePath& windowResPath) const
+{
+    if (s_windowTemplates.empty()) {
+        return nullptr;
+    }
+    auto iter = s_windowTemplates.find(xmlFilePath.ToString());
+    if ((iter == s_windowTemplates.end()) && !windowResPath.IsEmpty() && xmlFilePath.IsRelativePath()) {
+        //在窗口目录查找
+        iter = s_windowTemplates.find(FilePathUtil::JoinFilePath(windowResPath, xmlFilePath).ToString());
+    }
+    if (iter == s_windowTemplates.end()) {
+        return nullptr;
+    }
+    if (!iter->second.m_bPrecompiled && !s_bWindowTemplateCacheEnabled && !m_bUseWindowTemplate) {
+        return nullptr;
+    }
+    return iter->second.m_doc;
+}
+
+std::shared_ptr<XmlBinaryDocument> WindowBuilder::AddWindowTemplate(const FilePath& templateKey) const
+{
+    //全局Class的定义（与Control::ApplyAttributeList的解析方式一致）
+    auto getClassCallback = [](const DString& className, WindowTemplate::AttributeList& attributeList) {
+            DString classAttributes = GlobalManager::Instance().GetClassAttributes(className);
+            if (classAttributes.find(_T('\"')) != DString::npos) {
+                AttributeUtil::ParseAttributeList(classAttributes, _T('\"'), attributeList);
+            }
+            else if (classAttributes.find(_T('\'')) != DString::npos) {
+                AttributeUtil::ParseAttributeList(classAttributes, _T('\''), attributeList);
+            }
+            return !classAttributes.empty();
+        };
+    std::vector<uint8_t> templateData;
+    if (!WindowTemplate::CompileXmlDocument(*m_xml, getClassCallback, templateData)) {
+        return nullptr;
+    }
+    std::shared_ptr<XmlBinaryDocument> doc = std::make_shared<XmlBinaryDocument>();
+    if (!doc->LoadBuffer(std::move(templateData))) {
+        return nullptr;
+    }
+    s_windowTemplates[templateKey.ToString()] = WindowTemplateItem{ doc, false };
+    return doc;
+}
+
 bool WindowBuilder::IsXmlFileExists(const FilePath& xmlFilePath) const
 {
     if (xmlFilePath.IsEmpty()) {
@@ -241,6 +358,8 @@ bool WindowBuilder::ParseXmlData(const DString& xmlFileData, const FilePath& xml
         ASSERT(!_T("WindowBuilder::ParseXmlData load xmlFileData failed!"));
         return false;
     }
+    m_binaryXml.reset();
+    m_bUseWindowTemplate = false;
     m_xmlFilePath = xmlFilePath;
     return true;
 }
@@ -260,23 +379,47 @@ bool WindowBuilder::ParseXmlData(const std::vector<unsigned char>& xmlFileData,
         ASSERT(!_T("WindowBuilder::ParseXmlData load xmlFileData failed!"));
         return false;
     }
+    m_binaryXml.reset();
+    m_bUseWindowTemplate = false;
     m_xmlFilePath = xmlFilePath;
     return true;
 }
 
 bool WindowBuilder::ParseXmlFile(const FilePath& xmlFilePath, const FilePath& windowResPath)
+{
+    m_bUseWindowTemplate = false;
+    return DoParseXmlFile(xmlFilePath, windowResPath);
+}
+
+bool WindowBuilder::ParseXmlFileWithCache(const FilePath& xmlFilePath, const FilePath& windowResPath)
+{
+    m_bUseWindowTemplate = true;
+    return DoParseXmlFile(xmlFilePath, windowResPath);
+}
+
+bool WindowBuilder::DoParseXmlFile(const FilePath& xmlFilePath, const FilePath& windowResPath)
 {
     ASSERT(!xmlFilePath.IsEmpty() && _T("xmlFilePath 参数为空！"));
     if (xmlFilePath.IsEmpty()) {
         return false;
     }
     bool isLoaded = false;
+    m_binaryXml.reset();
+    //优先使用窗口模板，不需要读取和解析XML文件
+    m_binaryXml = FindWindowTemplate(xmlFilePath, windowResPath);
+    if (m_binaryXml != nullptr) {
+        m_xmlFilePath = xmlFilePath;
+        return true;
+    }
+    //窗口模板缓存的关键字：实际加载的XML文件路径（相对于资源根目录的路径，或者绝对路径）
+    FilePath templateKey = xmlFilePath;
     if (GlobalManager::Instance().Zip().IsUseZip()) {
         FilePath sFile = FilePathUtil::JoinFilePath(GlobalManager::Instance().GetResourcePath(), xmlFilePath);
         if (!windowResPath.IsEmpty() && !GlobalManager::Instance().Zip().IsZipResExist(sFile)) {
             //在窗口目录查找
             sFile = FilePathUtil::JoinFilePath(GlobalManager::Instance().GetResourcePath(), windowResPath);
             sFile = FilePathUtil::JoinFilePath(sFile, xmlFilePath);
+            templateKey = FilePathUtil::JoinFilePath(windowResPath, xmlFilePath);
         }
         std::vector<unsigned char> file_data;
         if (GlobalManager::Instance().Zip().GetZipData(sFile, file_data)) {
@@ -296,22 +439,48 @@ bool WindowBuilder::ParseXmlFile(const FilePath& xmlFilePath, const FilePath& wi
                 //在窗口目录查找
                 xmlFileFullPath = FilePathUtil::JoinFilePath(GlobalManager::Instance().GetResourcePath(), windowResPath);
                 xmlFileFullPath = FilePathUtil::JoinFilePath(xmlFileFullPath, xmlFilePath);
+                templateKey = FilePathUtil::JoinFilePath(windowResPath, xmlFilePath);
             }
         }
         else {
             xmlFileFullPath = xmlFilePath;
         }
-        pugi::xml_parse_result result = m_xml->load_file(xmlFileFullPath.NativePathA().c_str());
-        if (result.status != pugi::status_ok) {
-            ASSERT(!_T("WindowBuilder::ParseXmlFile load xml file failed!"));
-            return false;
+        //启用窗口模板缓存时，不需要使用XML二进制缓存（首次解析后即生成窗口模板）
+        const bool bXmlBinaryCacheEnabled = s_bXmlBinaryCacheEnabled && !s_bWindowTemplateCacheEnabled && !m_bUseWindowTemplate;
+        if (bXmlBinaryCacheEnabled) {
+            //优先加载二进制缓存，不需要解析XML文件
+            XmlBinaryCache xmlCache;
+            xmlCache.SetCacheDirectory(s_xmlBinaryCacheDir);
+            std::unique_ptr<XmlBinaryDocument> binaryXml = std::make_unique<XmlBinaryDocument>();
+            if (xmlCache.LoadFromCache(xmlFileFullPath, *binaryXml)) {
+                m_binaryXml = std::move(binaryXml);
+                isLoaded = true;
+            }
+        }
+        if (!isLoaded) {
+            pugi::xml_parse_result result = m_xml->load_file(xmlFileFullPath.NativePathA().c_str());
+            if (result.status != pugi::status_ok) {
+                ASSERT(!_T("WindowBuilder::ParseXmlFile load xml file failed!"));
+                return false;
+            }
+            isLoaded = true;
+            if (bXmlBinaryCacheEnabled) {
+                //生成二进制缓存，下次加载时使用（缓存目录不可写时忽略错误）
+                XmlBinaryCache xmlCache;
+                xmlCache.SetCacheDirectory(s_xmlBinaryCacheDir);
+                xmlCache.SetCompressionEnabled(s_bXmlBinaryCacheCompressed);
+                xmlCache.SaveToCache(xmlFileFullPath, *m_xml);
+            }
         }
-        isLoaded = true;
     }
     if (!isLoaded) {
         ASSERT(!_T("WindowBuilder::ParseXmlFile load xmlFilePath failed!"));
         return false;
     }
+    if ((s_bWindowTemplateCacheEnabled || m_bUseWindowTemplate) && (m_binaryXml == nullptr)) {
+        //生成窗口模板，本次及以后创建控件时均使用窗口模板（生成失败时使用XML文档）
+        m_binaryXml = AddWindowTemplate(templateKey);
+    }
     m_xmlFilePath = xmlFilePath;
     return true;
 }
@@ -331,7 +500,15 @@ Control* WindowBuilder::CreateControls(Window* pWindow, CreateControlCallback pC
     }
 
     m_createControlCallback = pCallback;
-    pugi::xml_node root = m_xml->root().first_child();
+    if (m_binaryXml != nullptr) {
+        return DoCreateControls(m_binaryXml->root().first_child(), pWindow, pParent, pUserDefinedBox);
+    }
+    return DoCreateControls(m_xml->root().first_child(), pWindow, pParent, pUserDefinedBox);
+}
+
+template<typename TXmlNode>
+Control* WindowBuilder::DoCreateControls(const TXmlNode& root, Window* pWindow, Box* pParent, Box* pUserDefinedBox)
+{
     ASSERT(!root.empty());
     if (root.empty()) {
         return nullptr;
@@ -355,7 +532,7 @@ Control* WindowBuilder::CreateControls(Window* pWindow, CreateControlCallback pC
         }
     }
 
-    for (pugi::xml_node node : root.children()) {
+    for (auto node : root.children()) {
         DString strClass = node.name();
         if ( (strClass == _T("Image"))          ||
              (strClass == _T("FontResource"))   ||
@@ -372,7 +549,7 @@ Control* WindowBuilder::CreateControls(Window* pWindow, CreateControlCallback pC
             else {
                 ParseXmlNodeChildren(node, pUserDefinedBox, pWindow);
                 int i = 0;
-                for (pugi::xml_attribute attr : node.attributes()) {
+                for (auto attr : node.attributes()) {
                     if (StringUtil::StringCompare(attr.name(), _T("class")) == 0) {
                         //class必须是第一个属性
                         ASSERT_UNUSED_VARIABLE(i == 0);
@@ -389,7 +566,15 @@ Control* WindowBuilder::CreateControls(Window* pWindow, CreateControlCallback pC
 
 bool WindowBuilder::ParseWindowCreateAttributes(WindowCreateAttributes& createAttributes)
 {
-    pugi::xml_node root = m_xml->root().first_child();
+    if (m_binaryXml != nullptr) {
+        return DoParseWindowCreateAttributes(m_binaryXml->root().first_child(), createAttributes);
+    }
+    return DoParseWindowCreateAttributes(m_xml->root().first_child(), createAttributes);
+}
+
+template<typename TXmlNode>
+bool WindowBuilder::DoParseWindowCreateAttributes(const TXmlNode& root, WindowCreateAttributes& createAttributes)
+{
     ASSERT(!root.empty());
     if (root.empty()) {
         return false;
@@ -419,7 +604,7 @@ bool WindowBuilder::ParseWindowCreateAttributes(WindowCreateAttributes& createAt
     RenderBackendType backendType = RenderBackendType::kRaster_BackendType;
     DString strName;
     DString strValue;
-    for (pugi::xml_attribute attr : root.attributes()) {
+    for (auto attr : root.attributes()) {
         strName = attr.name();
         strValue = attr.value();
         if (strName == _T("render_backend_type")) {            
@@ -574,7 +759,8 @@ bool WindowBuilder::ParseWindowCreateAttributes(WindowCreateAttributes& createAt
     return true;
 }
 
-void WindowBuilder::ParseWindowAttributes(Window* pWindow, const pugi::xml_node& root) const
+template<typename TXmlNode>
+void WindowBuilder::ParseWindowAttributes(Window* pWindow, const TXmlNode& root) const
 {
     ASSERT((pWindow != nullptr) && pWindow->IsWindow());
     if ((pWindow == nullptr) || !pWindow->IsWindow()) {
@@ -587,7 +773,7 @@ void WindowBuilder::ParseWindowAttributes(Window* pWindow, const pugi::xml_node&
 
     bool bInitRenderBackendType = false;
     //首先设置"render_backend_type"属性
-    for (pugi::xml_attribute attr : root.attributes()) {
+    for (auto attr : root.attributes()) {
         strName = attr.name();
         strValue = attr.value();
         if (strName == _T("render_backend_type")) {
@@ -613,7 +799,7 @@ void WindowBuilder::ParseWindowAttributes(Window* pWindow, const pugi::xml_node&
     }
      
     //首先处理min_size/max_size/use_system_caption，因为其他属性有用到这些个属性的
-    for (pugi::xml_attribute attr : root.attributes()) {
+    for (auto attr : root.attributes()) {
         strName = attr.name();
         strValue = attr.value();
         if ((strName == _T("min_size")) || (strName == _T("mininfo"))) {
@@ -642,7 +828,7 @@ void WindowBuilder::ParseWindowAttributes(Window* pWindow, const pugi::xml_node&
     Shadow::ShadowType nShadowType = Shadow::ShadowType::kShadowCount;
 
     //注：如果use_system_caption为true，则层窗口关闭（因为这两个属性互斥的）
-    for (pugi::xml_attribute attr : root.attributes()) {
+    for (auto attr : root.attributes()) {
         strName = attr.name();
         strValue = attr.value();
         if ((strName == _T("size_box")) || (strName == _T("sizebox"))) {
@@ -786,7 +972,7 @@ void WindowBuilder::ParseWindowAttributes(Window* pWindow, const pugi::xml_node&
 
     //最后设置窗口的初始化大小，因为初始化大小与是否阴影等相关
     bool bLayeredWindowOpacityDefined = false;
-    for (pugi::xml_attribute attr : root.attributes()) {
+    for (auto attr : root.attributes()) {
         strName = attr.name();
         strValue = attr.value();
         if (strName == _T("size")) {
@@ -857,7 +1043,7 @@ void WindowBuilder::ParseWindowAttributes(Window* pWindow, const pugi::xml_node&
 #ifdef _DEBUG
     //检查是否有不支持的属性，然后预警，减少配置错误问题
     std::vector<DString> unknownNames;
-    for (pugi::xml_attribute attr : root.attributes()) {
+    for (auto attr : root.attributes()) {
         strName = attr.name();
         if (knownNames.find(strName) == knownNames.end()) {
             unknownNames.push_back(strName);
@@ -867,7 +1053,8 @@ void WindowBuilder::ParseWindowAttributes(Window* pWindow, const pugi::xml_node&
 #endif
 }
 
-void WindowBuilder::ParseWindowShareAttributes(Window* pWindow, const pugi::xml_node& root)
+template<typename TXmlNode>
+void WindowBuilder::ParseWindowShareAttributes(Window* pWindow, const TXmlNode& root)
 {
     ASSERT((pWindow != nullptr) && pWindow->IsWindow());
     if ((pWindow == nullptr) || !pWindow->IsWindow()) {
@@ -879,12 +1066,12 @@ void WindowBuilder::ParseWindowShareAttributes(Window* pWindow, const pugi::xml_
     DString strClass;
 
     //解析该窗口下的共享资源
-    for (pugi::xml_node node : root.children()) {
+    for (auto node : root.children()) {
         strClass = node.name();
         if (strClass == _T("Class")) {
             DString strClassName;
             DString strAttribute;
-            for (pugi::xml_attribute attr : node.attributes()) {
+            for (auto attr : node.attributes()) {
                 strName = attr.name();
                 strValue = attr.value();
                 if (strName == _T("name")) {
@@ -905,7 +1092,7 @@ void WindowBuilder::ParseWindowShareAttributes(Window* pWindow, const pugi::xml_
         else if (strClass == _T("TextColor")) {
             DString strColorName;
             DString strColor;
-            for (pugi::xml_attribute attr : node.attributes()) {
+            for (auto attr : node.attributes()) {
                 strName = attr.name();
                 strValue = attr.value();
                 if (strName == _T("name")) {
@@ -927,16 +1114,17 @@ void WindowBuilder::ParseWindowShareAttributes(Window* pWindow, const pugi::xml_
     }
 }
 
-void WindowBuilder::ParseGlobalAttributes(const pugi::xml_node& root)
+template<typename TXmlNode>
+void WindowBuilder::ParseGlobalAttributes(const TXmlNode& root)
 {
     DString strClass;
     DString strName;
     DString strValue;
-    for (pugi::xml_node node : root.children()) {
+    for (auto node : root.children()) {
         strClass = node.name();
         if (strClass == _T("DefaultFontFamilyNames")) {
             DString defaultFontFamilyNames;
-            for (pugi::xml_attribute attr : node.attributes()) {
+            for (auto attr : node.attributes()) {
                 strName = attr.name();
                 strValue = attr.value();
                 if (strName == _T("value")) {
@@ -952,7 +1140,7 @@ void WindowBuilder::ParseGlobalAttributes(const pugi::xml_node& root)
             //字体文件
             DString strFontFile;
             DString strFontDesc;
-            for (pugi::xml_attribute attr : node.attributes()) {
+            for (auto attr : node.attributes()) {
                 strName = attr.name();
                 strValue = attr.value();
                 if (strName == _T("file")) {
@@ -972,7 +1160,7 @@ void WindowBuilder::ParseGlobalAttributes(const pugi::xml_node& root)
         else if (strClass == _T("Class")) {
             DString strClassName;
             DString strAttribute;
-            for (pugi::xml_attribute attr : node.attributes()) {
+            for (auto attr : node.attributes()) {
                 strName = attr.name();
                 strValue = attr.value();
                 if (strName == _T("name")) {
@@ -1005,7 +1193,8 @@ void WindowBuilder::ParseGlobalAttributes(const pugi::xml_node& root)
     }
 }
 
-void WindowBuilder::ParseFontXmlNode(const pugi::xml_node& xmlNode)
+template<typename TXmlNode>
+void WindowBuilder::ParseFontXmlNode(const TXmlNode& xmlNode)
 {
     DString strName;
     DString strValue;
@@ -1018,7 +1207,7 @@ void WindowBuilder::ParseFontXmlNode(const pugi::xml_node& xmlNode)
     bool strikeout = false;
     bool italic = false;
     bool isDefault = false;
-    for (pugi::xml_attribute attr : xmlNode.attributes()) {
+    for (auto attr : xmlNode.attributes()) {
         strName = attr.name();
         strValue = attr.value();
         if (strName == _T("id"))
@@ -1061,13 +1250,14 @@ void WindowBuilder::ParseFontXmlNode(const pugi::xml_node& xmlNode)
     }
 }
 
-Control* WindowBuilder::ParseXmlNodeChildren(const pugi::xml_node& xmlNode, Control* pParent, Window* pWindow)
+template<typename TXmlNode>
+Control* WindowBuilder::ParseXmlNodeChildren(const TXmlNode& xmlNode, Control* pParent, Window* pWindow)
 {
     if (xmlNode.empty()) {
         return nullptr;
     }
     Control* pReturn = nullptr;
-    for (pugi::xml_node node : xmlNode.children()) {
+    for (auto node : xmlNode.children()) {
         DString strClass = node.name();
         if( (strClass == _T("DefaultFontFamilyNames")) ||
             (strClass == _T("Font")) ||
@@ -1080,7 +1270,7 @@ Control* WindowBuilder::ParseXmlNodeChildren(const pugi::xml_node& xmlNode, Cont
         Control* pControl = nullptr;
 #ifdef DUILIB_BUILD_FOR_LUA
         if (strClass == _T("LuaScript")) {
-            pugi::xml_attribute srcAttr = node.attribute(_T("src"));
+            auto srcAttr = node.attribute(_T("src"));
             DString srcValue = srcAttr.as_string();
             if (!srcValue.empty()) {
                 ui::LuaEngine::Instance().LoadScript(srcValue);
@@ -1098,13 +1288,13 @@ Control* WindowBuilder::ParseXmlNodeChildren(const pugi::xml_node& xmlNode, Cont
             if (node.attributes().empty()) {
                 continue;
             }
-            pugi::xml_attribute countAttr = node.attribute(_T("count"));
+            auto countAttr = node.attribute(_T("count"));
             int nCount = countAttr.as_int();
             if (nCount <= 0) {
                 //默认值设置为1，count这个属性参数为可选
                 nCount = 1;
             }
-            pugi::xml_attribute sourceAttr = node.attribute(_T("src"));
+            auto sourceAttr = node.attribute(_T("src"));
             DString sourceValue = sourceAttr.as_string();
             if (sourceValue.empty()) {
                 sourceAttr = node.attribute(_T("source"));
@@ -1134,7 +1324,10 @@ Control* WindowBuilder::ParseXmlNodeChildren(const pugi::xml_node& xmlNode, Cont
             for ( int i = 0; i < nCount; i++ ) {
                 WindowBuilder builder;
                 FilePath windowResPath = (pWindow != nullptr) ? pWindow->GetResourcePath() : FilePath();
-                if (builder.ParseXmlFile(sourceXmlFilePath, windowResPath)) {
+                //使用窗口模板缓存时，被包含的XML文件也使用窗口模板缓存
+                bool bParsed = m_bUseWindowTemplate ? builder.ParseXmlFileWithCache(sourceXmlFilePath, windowResPath) :
+                                                      builder.ParseXmlFile(sourceXmlFilePath, windowResPath);
+                if (bParsed) {
                     pControl = builder.CreateControls(pWindow, m_createControlCallback, ToBox(pParent), nullptr);
                 }
                 else {
@@ -1212,7 +1405,7 @@ Control* WindowBuilder::ParseXmlNodeChildren(const pugi::xml_node& xmlNode, Cont
         if(!node.attributes().empty()) {
             //读取节点的属性，设置控件的属性
             int i = 0;
-            for (pugi::xml_attribute attr : node.attributes()) {
+            for (auto attr : node.attributes()) {
                 ASSERT_UNUSED_VARIABLE(i == 0 || StringUtil::StringCompare(attr.name(), _T("class")) != 0);    //class必须是第一个属性
                 ++i;
                 pControl->SetAttribute(attr.name(), attr.value());
@@ -1221,7 +1414,9 @@ Control* WindowBuilder::ParseXmlNodeChildren(const pugi::xml_node& xmlNode, Cont
 
         if (strClass == DUI_CTR_RICHTEXT) {
             //节点为：<RichText></RichText>，解析其子节点为RichText内容
-            ParseRichTextXmlNode(node, pControl);
+            RichTextImpl* pRichTextImpl = GetRichTextImpl(pControl);
+            ASSERT(pRichTextImpl != nullptr);
+            ParseRichTextXmlNode(node, pRichTextImpl);
         }
         else {
             // Add children
@@ -1290,6 +1485,16 @@ bool WindowBuilder::ParseRichTextXmlNode(const pugi::xml_node& xmlNode, Control*
     if (pControl == nullptr) {
         return false;
     }
+    RichTextImpl* pRichTextImpl = GetRichTextImpl(pControl);
+    ASSERT(pRichTextImpl != nullptr);
+    return ParseRichTextXmlNode(xmlNode, pRichTextImpl, pTextSlice);
+}
+
+RichTextImpl* WindowBuilder::GetRichTextImpl(Control* pControl)
+{
+    if (pControl == nullptr) {
+        return nullptr;
+    }
     //获取实现接口
     RichTextImpl* pRichTextImpl = nullptr;
     RichText* pRichText = dynamic_cast<RichText*>(pControl);
@@ -1314,11 +1519,11 @@ bool WindowBuilder::ParseRichTextXmlNode(const pugi::xml_node& xmlNode, Control*
             pRichTextImpl = pRichTextBox->GetRichTextImpl();
         }
     }
-    ASSERT(pRichTextImpl != nullptr);
-    return ParseRichTextXmlNode(xmlNode, pRichTextImpl, pTextSlice);
+    return pRichTextImpl;
 }
 
-bool WindowBuilder::ParseRichTextXmlNode(const pugi::xml_node& xmlNode, RichTextImpl* pRichTextImpl, RichTextSlice* pTextSlice)
+template<typename TXmlNode>
+bool WindowBuilder::ParseRichTextXmlNode(const TXmlNode& xmlNode, RichTextImpl* pRichTextImpl, RichTextSlice* pTextSlice)
 {
     ASSERT(pRichTextImpl != nullptr);
     if (pRichTextImpl == nullptr) {
@@ -1326,7 +1531,7 @@ bool WindowBuilder::ParseRichTextXmlNode(const pugi::xml_node& xmlNode, RichText
     }
 
     DString nodeName;
-    for (pugi::xml_node node : xmlNode.children()) {
+    for (auto node : xmlNode.children()) {
         RichTextSlice textSlice;
         textSlice.m_nodeName = node.name();
         nodeName = textSlice.m_nodeName.c_str();
@@ -1403,7 +1608,8 @@ bool WindowBuilder::ParseRichTextXmlNode(const pugi::xml_node& xmlNode, RichText
     return true;
 }
 
-void WindowBuilder::AttachXmlEvent(bool bBubbled, const pugi::xml_node& node, Control* pParent)
+template<typename TXmlNode>
+void WindowBuilder::AttachXmlEvent(bool bBubbled, const TXmlNode& node, Control* pParent)
 {
     ASSERT(pParent != nullptr);
     if (pParent == nullptr) {
@@ -1415,7 +1621,7 @@ void WindowBuilder::AttachXmlEvent(bool bBubbled, const pugi::xml_node& node, Co
     DString strName;
     DString strValue;
     int i = 0;
-    for (pugi::xml_attribute attr : node.attributes()) {
+    for (auto attr : node.attributes()) {
         strName = attr.name();
         strValue = attr.value();
         ASSERT_UNUSED_VARIABLE(i != 0 || strName == _T("type"));
@@ -1468,10 +1674,18 @@ Box* WindowBuilder::ToBox(Control* pControl) const
 
 bool WindowBuilder::ParseWindowAttributes(std::map<DString, DString>& windowAttributes) const
 {
+    if (m_binaryXml != nullptr) {
+        return DoParseWindowAttributes(m_binaryXml->root().first_child(), windowAttributes);
+    }
     if (m_xml == nullptr) {
         return false;
     }
-    pugi::xml_node root = m_xml->root().first_child();
+    return DoParseWindowAttributes(m_xml->root().first_child(), windowAttributes);
+}
+
+template<typename TXmlNode>
+bool WindowBuilder::DoParseWindowAttributes(const TXmlNode& root, std::map<DString, DString>& windowAttributes) const
+{
     ASSERT(!root.empty());
     if (root.empty()) {
         return false;
@@ -1479,7 +1693,7 @@ bool WindowBuilder::ParseWindowAttributes(std::map<DString, DString>& windowAttr
 
     DString strClass = root.name();
     if (strClass == _T("Window")) {
-        for (pugi::xml_attribute attr : root.attributes()) {
+        for (auto attr : root.attributes()) {
             windowAttributes[attr.name()] = attr.value();            
         }
         return true;
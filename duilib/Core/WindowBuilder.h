@@ -20,6 +20,7 @@ class Control;
 class RichTextSlice;
 class RichTextImpl;
 class WindowCreateAttributes;
+class XmlBinaryDocument;
 
 /** 创建控件的回调函数
 */
@@ -73,6 +74,15 @@ public:
     */
     bool ParseXmlFile(const FilePath& xmlFilePath, const FilePath& windowResPath = FilePath());
 
+    /** 解析XML文件内容，并使用窗口模板缓存（不受是否启用窗口模板缓存的影响）
+    *   首次解析后编译为窗口模板并缓存，再次解析相同的XML文件时直接使用窗口模板，创建控件时在模板上直接生成控件树，不需要再解析XML文件；
+    *   XML中含有的Include节点，也使用窗口模板缓存；适合反复使用的XML文件，比如菜单、下拉框、列表项的模板等
+    * @param [in] xmlFilePath XML文件的路径
+    * @param [in] windowResPath 窗口资源子目录, 用于查找XML文件（当不指定文件路径时）
+    * @return 解析成功返回true，否则返回false
+    */
+    bool ParseXmlFileWithCache(const FilePath& xmlFilePath, const FilePath& windowResPath = FilePath());
+
     /** 使用缓存中已经解析过的XML文件或者数据创建窗口布局等（即CreateFromXmlData和CreateFromXmlFile解析后的结果）
     * @param [in] pWindow 关联的窗口, 不允许为nullptr, 因DPI自适应需要对控件的大小等进行DPI缩放
     * @param [in] pCallback 根据Class名称创建控件（或容器）的函数，适用于自定义控件
@@ -111,6 +121,43 @@ public:
     */
     const std::vector<DString>& GetGlobalFontIdList() const;
 
+public:
+    /** 设置是否启用XML二进制缓存（仅对本地XML文件有效，不支持zip压缩包中的资源）
+    *   启用后，ParseXmlFile优先加载二进制缓存，直接在缓存的节点表上创建控件，不需要解析XML文件；
+    *   缓存不存在或者已过期时，解析XML文件，并生成新的二进制缓存
+    * @param [in] bEnabled 是否启用
+    * @param [in] cacheDir 缓存文件所在目录，为空时缓存文件与XML文件存放在相同目录
+    * @param [in] bCompressed 新生成的缓存文件是否使用LZ4压缩（文件更小，适合磁盘读取速度慢的场景，但加载时需要解压）
+    */
+    static void SetXmlBinaryCacheEnabled(bool bEnabled, const FilePath& cacheDir = FilePath(), bool bCompressed = false);
+
+    /** 是否启用了XML二进制缓存
+    */
+    static bool IsXmlBinaryCacheEnabled();
+
+    /** 设置是否启用窗口模板缓存
+    *   启用后，ParseXmlFile首次解析XML文件后将其编译为窗口模板（预先展开控件的class属性，参见WindowTemplate），保存在内存中；
+    *   再次解析相同的XML文件时（比如多次打开的菜单、弹出窗口等），直接使用窗口模板，不需要读取和解析XML文件
+    * @param [in] bEnabled 是否启用
+    */
+    static void SetWindowTemplateCacheEnabled(bool bEnabled);
+
+    /** 是否启用了窗口模板缓存
+    */
+    static bool IsWindowTemplateCacheEnabled();
+
+    /** 添加预编译的窗口模板（由资源编译器离线生成），添加后ParseXmlFile直接使用该窗口模板，不受是否启用窗口模板缓存的影响
+    * @param [in] xmlFilePath XML文件路径（与ParseXmlFile的参数相同，相对路径时为相对于资源根目录的路径）
+    * @param [in] templateData 窗口模板数据
+    * @return 窗口模板数据有效时返回true，否则返回false
+    */
+    static bool AddWindowTemplate(const FilePath& xmlFilePath, std::vector<uint8_t>&& templateData);
+
+    /** 清除窗口模板缓存（全局资源重新加载后，Class定义可能已经变化，需要清除）
+    * @param [in] bPrecompiled 是否同时清除预编译的窗口模板
+    */
+    static void ClearWindowTemplates(bool bPrecompiled);
+
 public:
     /** 解析带格式的文本内容，并设置到RichText Control对象
     * @param [in] xmlText 带格式的文本内容
@@ -131,27 +178,54 @@ private:
     * @param [in] pControl RichText控件的接口
     * @param [in] pTextSlice 文本片段节点接口，如果pTextSlice不为nullptr，XML节点的解析结果将填充到pTextSlice中；否则填充到pControl中
     */
-    static bool ParseRichTextXmlNode(const pugi::xml_node& xmlNode, RichTextImpl* pRichTextImpl, RichTextSlice* pTextSlice = nullptr);
+    template<typename TXmlNode>
+    static bool ParseRichTextXmlNode(const TXmlNode& xmlNode, RichTextImpl* pRichTextImpl, RichTextSlice* pTextSlice = nullptr);
+
+    /** 获取RichText相关控件的实现接口
+    */
+    static RichTextImpl* GetRichTextImpl(Control* pControl);
 
 private:
+    /* 以下解析函数的XML节点类型(TXmlNode)为pugi::xml_node或者XmlBinaryNode(XML二进制缓存的节点)
+    */
+
+    /** 根据XML根节点创建控件（参数含义同CreateControls）
+    */
+    template<typename TXmlNode>
+    Control* DoCreateControls(const TXmlNode& root, Window* pWindow, Box* pParent, Box* pUserDefinedBox);
+
+    /** 根据XML根节点解析出窗口的属性（参数含义同ParseWindowCreateAttributes）
+    */
+    template<typename TXmlNode>
+    bool DoParseWindowCreateAttributes(const TXmlNode& root, WindowCreateAttributes& createAttributes);
+
+    /** 根据XML根节点解析出窗口的属性（参数含义同ParseWindowAttributes）
+    */
+    template<typename TXmlNode>
+    bool DoParseWindowAttributes(const TXmlNode& root, std::map<DString, DString>& windowAttributes) const;
+
     /** 解析窗口的属性(根XML节点名称："Window")
     */
-    void ParseWindowAttributes(Window* pWindow, const pugi::xml_node& root) const;
+    template<typename TXmlNode>
+    void ParseWindowAttributes(Window* pWindow, const TXmlNode& root) const;
 
     /** 解析窗口下的共享资源属性(根XML节点名称："Window")，这些属性只有本窗口能使用
     */
-    void ParseWindowShareAttributes(Window* pWindow, const pugi::xml_node& root);
+    template<typename TXmlNode>
+    void ParseWindowShareAttributes(Window* pWindow, const TXmlNode& root);
 
     /** 解析全局资源的属性(根XML节点名称："Global")，这些属性，所有窗口都可以使用
     */
-    void ParseGlobalAttributes(const pugi::xml_node& root);
+    template<typename TXmlNode>
+    void ParseGlobalAttributes(const TXmlNode& root);
 
     /** 解析XML节点的子节点
     * @param [in] xmlNode xml节点
     * @param [in] pParent 父控件，可能是普通控件（参数只传入，未用到），也可能是容器（用时转换为容器）
     * @return 返回第一个创建的节点，可能是普通控件，也可能是容器
     */
-    Control* ParseXmlNodeChildren(const pugi::xml_node& xmlNode, Control* pParent = nullptr, Window* pWindow = nullptr);
+    template<typename TXmlNode>
+    Control* ParseXmlNodeChildren(const TXmlNode& xmlNode, Control* pParent = nullptr, Window* pWindow = nullptr);
 
     /** 根据控件的Class名称，创建控件（或容器）
     */
@@ -163,15 +237,30 @@ private:
     *       <Event type="buttonup" receiver="tree" apply_attribute="multi_select={false}" />
     *   </Option>
     */
-    void AttachXmlEvent(bool bBubbled, const pugi::xml_node& node, Control* pParent);
+    template<typename TXmlNode>
+    void AttachXmlEvent(bool bBubbled, const TXmlNode& node, Control* pParent);
 
     /** 判断XML文件是否存在
     */
     bool IsXmlFileExists(const FilePath& xmlFilePath) const;
 
+    /** 解析XML文件内容（参数含义同ParseXmlFile）
+    */
+    bool DoParseXmlFile(const FilePath& xmlFilePath, const FilePath& windowResPath);
+
+    /** 查找窗口模板缓存（参数含义同ParseXmlFile）
+    */
+    std::shared_ptr<XmlBinaryDocument> FindWindowTemplate(const FilePath& xmlFilePath, const FilePath& windowResPath) const;
+
+    /** 将当前解析的XML文档编译为窗口模板，并添加到窗口模板缓存中
+    * @param [in] templateKey 窗口模板缓存的关键字（XML文件的相对路径或者绝对路径）
+    */
+    std::shared_ptr<XmlBinaryDocument> AddWindowTemplate(const FilePath& templateKey) const;
+
     /** 解析字体节点
     */
-    void ParseFontXmlNode(const pugi::xml_node& xmlNode);
+    template<typename TXmlNode>
+    void ParseFontXmlNode(const TXmlNode& xmlNode);
 
 private:
     
@@ -179,6 +268,10 @@ private:
     */
     std::unique_ptr<pugi::xml_document> m_xml;
 
+    /** 当前加载的XML二进制缓存文档（从缓存文件加载，或者为窗口模板缓存中的文档，不为nullptr时优先使用）
+    */
+    std::shared_ptr<XmlBinaryDocument> m_binaryXml;
+
     /** 创建Control的回调接口
     */
     CreateControlCallback m_createControlCallback;
@@ -187,6 +280,10 @@ private:
     */
     FilePath m_xmlFilePath;
 
+    /** 是否使用窗口模板缓存（由ParseXmlFileWithCache设置）
+    */
+    bool m_bUseWindowTemplate;
+
 private:
     /** 本次解析在窗口下添加的Class属性列表
     */
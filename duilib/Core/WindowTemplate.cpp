@@ -0,0 +1,202 @@
+#include "WindowTemplate.h"
+#include "duilib/Core/XmlBinaryCache.h"
+#include "duilib/Utils/StringUtil.h"
+#include "duilib/third_party/xml/pugixml.hpp"
+#include <map>
+
+namespace ui
+{
+namespace
+{
+/** Class嵌套定义的最大层数（Class的属性中含有class属性）
+*/
+const int32_t kMaxClassDepth = 8;
+
+/** 展开class属性时使用的辅助类：查找Class定义，并缓存查找结果
+*/
+class ClassExpander
+{
+public:
+    ClassExpander(const pugi::xml_node& root, const WindowTemplate::GetClassCallback& getClassCallback):
+        m_getClassCallback(getClassCallback)
+    {
+        //窗口中定义的Class（与WindowBuilder::ParseWindowShareAttributes的解析方式一致）
+        if (DString(root.name()) != _T("Window")) {
+            return;
+        }
+        for (pugi::xml_node node = root.first_child(); !node.empty(); node = node.next_sibling()) {
+            if (DString(node.name()) != _T("Class")) {
+                continue;
+            }
+            DString className;
+            WindowTemplate::AttributeList attributeList;
+            for (pugi::xml_attribute attr = node.first_attribute(); !attr.empty(); attr = attr.next_attribute()) {
+                if (DString(attr.name()) == _T("name")) {
+                    className = attr.value();
+                }
+                else {
+                    attributeList.push_back({ attr.name(), attr.value() });
+                }
+            }
+            if (!className.empty()) {
+                m_windowClasses[className] = std::move(attributeList);
+            }
+        }
+    }
+
+    /** 展开class属性的值（可以含有多个Class名称，以空格分隔）
+    * @return 所有Class都找到定义时返回true
+    */
+    bool Expand(const DString& classValue, WindowTemplate::AttributeList& attributeList, int32_t nDepth)
+    {
+        if (nDepth > kMaxClassDepth) {
+            return false;
+        }
+        std::list<DString> classNames = StringUtil::Split(classValue, _T(" "));
+        bool bHasClass = false;
+        for (const DString& className : classNames) {
+            if (className.empty()) {
+                continue;
+            }
+            const WindowTemplate::AttributeList* pClassAttributes = FindClass(className);
+            if (pClassAttributes == nullptr) {
+                return false;
+            }
+            for (const auto& attribute : *pClassAttributes) {
+                if (attribute.first == _T("class")) {
+                    if (!Expand(attribute.second, attributeList, nDepth + 1)) {
+                        return false;
+                    }
+                }
+                else {
+                    attributeList.push_back(attribute);
+                }
+            }
+            bHasClass = true;
+        }
+        return bHasClass;
+    }
+
+private:
+    /** 查找Class定义：先查找全局Class，再查找窗口中定义的Class（与Control::SetClass的查找顺序一致）
+    */
+    const WindowTemplate::AttributeList* FindClass(const DString& className)
+    {
+        auto iter = m_globalClasses.find(className);
+        if (iter == m_globalClasses.end()) {
+            WindowTemplate::AttributeList attributeList;
+            if (m_getClassCallback && m_getClassCallback(className, attributeList)) {
+                iter = m_globalClasses.emplace(className, std::move(attributeList)).first;
+            }
+        }
+        if (iter != m_globalClasses.end()) {
+            return &iter->second;
+        }
+        iter = m_windowClasses.find(className);
+        if (iter != m_windowClasses.end()) {
+            return &iter->second;
+        }
+        return nullptr;
+    }
+
+private:
+    const WindowTemplate::GetClassCallback& m_getClassCallback;
+    std::map<DString, WindowTemplate::AttributeList> m_globalClasses;
+    std::map<DString, WindowTemplate::AttributeList> m_windowClasses;
+};
+
+/** 是否为非控件节点（资源定义、事件、包含文件等），这些节点及其子节点不展开class属性
+*/
+bool IsNonControlNode(const DString& nodeName)
+{
+    return (nodeName == _T("Class")) ||
+           (nodeName == _T("TextColor")) ||
+           (nodeName == _T("Font")) ||
+           (nodeName == _T("FontFile")) ||
+           (nodeName == _T("FontResource")) ||
+           (nodeName == _T("DefaultFontFamilyNames")) ||
+           (nodeName == _T("Image")) ||
+           (nodeName == _T("Include")) ||
+           (nodeName == _T("Event")) ||
+           (nodeName == _T("BubbledEvent")) ||
+           (nodeName == _T("LuaScript"));
+}
+
+/** 展开子节点的class属性（递归）
+*/
+size_t ExpandChildren(pugi::xml_node xmlNode, ClassExpander& expander)
+{
+    size_t nCount = 0;
+    for (pugi::xml_node node = xmlNode.first_child(); !node.empty(); node = node.next_sibling()) {
+        if (node.type() != pugi::node_element) {
+            continue;
+        }
+        const DString nodeName = node.name();
+        if (IsNonControlNode(nodeName)) {
+            continue;
+        }
+        //class必须是第一个属性
+        pugi::xml_attribute classAttr = node.first_attribute();
+        if (!classAttr.empty() && (DString(classAttr.name()) == _T("class"))) {
+            WindowTemplate::AttributeList attributeList;
+            if (expander.Expand(classAttr.value(), attributeList, 0)) {
+                for (const auto& attribute : attributeList) {
+                    node.insert_attribute_before(attribute.first.c_str(), classAttr).set_value(attribute.second.c_str());
+                }
+                node.remove_attribute(classAttr);
+                ++nCount;
+            }
+        }
+        if (nodeName != DUI_CTR_RICHTEXT) {
+            //RichText的子节点为带格式的文本内容，不是控件
+            nCount += ExpandChildren(node, expander);
+        }
+    }
+    return nCount;
+}
+}
+
+size_t WindowTemplate::ExpandClassAttributes(pugi::xml_document& doc, const GetClassCallback& getClassCallback)
+{
+    pugi::xml_node root = doc.document_element();
+    if (root.empty() || (DString(root.name()) == _T("Global"))) {
+        return 0;
+    }
+    //根节点本身不是控件，从根节点的子节点开始展开
+    ClassExpander expander(root, getClassCallback);
+    return ExpandChildren(root, expander);
+}
+
+bool WindowTemplate::CompileXmlDocument(const pugi::xml_document& doc,
+                                        const GetClassCallback& getClassCallback,
+                                        std::vector<uint8_t>& templateData)
+{
+    templateData.clear();
+    if (doc.document_element().empty()) {
+        return false;
+    }
+    pugi::xml_document templateDoc;
+    templateDoc.reset(doc);
+    ExpandClassAttributes(templateDoc, getClassCallback);
+
+    XmlBinaryCache xmlCache;
+    return xmlCache.SaveToData(templateDoc, templateData);
+}
+
+bool WindowTemplate::CompileXmlData(const std::vector<uint8_t>& xmlData,
+                                    const GetClassCallback& getClassCallback,
+                                    std::vector<uint8_t>& templateData)
+{
+    templateData.clear();
+    if (xmlData.empty()) {
+        return false;
+    }
+    pugi::xml_document doc;
+    pugi::xml_parse_result result = doc.load_buffer(xmlData.data(), xmlData.size());
+    if (result.status != pugi::status_ok) {
+        return false;
+    }
+    return CompileXmlDocument(doc, getClassCallback, templateData);
+}
+
+} // namespace ui
@@ -0,0 +1,64 @@
+#ifndef UI_CORE_WINDOW_TEMPLATE_H_
+#define UI_CORE_WINDOW_TEMPLATE_H_
+
+#include "duilib/duilib_defs.h"
+#include <functional>
+#include <vector>
+
+namespace pugi
+{
+    class xml_document;
+}
+
+namespace ui
+{
+/** 窗口模板：将窗口的XML文件编译为可直接创建控件的二进制数据
+*   1. 数据格式与XML二进制缓存相同（XmlBinaryDocument），加载后由WindowBuilder直接在节点表上创建控件，不需要解析XML
+*   2. 编译时预先展开控件的class属性：class属性替换为对应Class定义中的属性列表（按原有的属性顺序），
+*      创建控件时不需要再查找和解析Class的属性字符串；Class定义在本XML文件的<Class>节点中，或者由回调函数提供（全局Class）
+*   3. 含有无法找到定义的Class时，该控件的class属性保持不变，创建控件时仍按原有的方式处理
+*   4. 可由资源编译器离线生成（参见ResourceCompiler::SetXmlCompiler），也可以由WindowBuilder在首次解析XML文件后生成
+*/
+class UILIB_API WindowTemplate
+{
+public:
+    /** 属性列表（属性名称和属性值）
+    */
+    typedef std::vector<std::pair<DString, DString>> AttributeList;
+
+    /** 查询Class定义的回调函数
+    * @param [in] className Class的名称
+    * @param [out] attributeList 返回该Class的属性列表
+    * @return 找到该Class的定义返回true，否则返回false
+    */
+    typedef std::function<bool (const DString& className, AttributeList& attributeList)> GetClassCallback;
+
+    /** 编译XML文档
+    * @param [in] doc XML文档
+    * @param [in] getClassCallback 查询全局Class定义的回调函数（优先于XML文件中的Class定义，与Control::SetClass的查找顺序一致），可以为空
+    * @param [out] templateData 返回窗口模板数据（非压缩格式，可直接由XmlBinaryDocument::LoadBuffer加载）
+    */
+    static bool CompileXmlDocument(const pugi::xml_document& doc,
+                                   const GetClassCallback& getClassCallback,
+                                   std::vector<uint8_t>& templateData);
+
+    /** 编译XML文件的数据
+    * @param [in] xmlData XML文件的数据（文件编码自动识别）
+    * @param [in] getClassCallback 查询全局Class定义的回调函数，可以为空
+    * @param [out] templateData 返回窗口模板数据
+    */
+    static bool CompileXmlData(const std::vector<uint8_t>& xmlData,
+                               const GetClassCallback& getClassCallback,
+                               std::vector<uint8_t>& templateData);
+
+    /** 展开XML文档中所有控件节点的class属性（直接修改文档）
+    * @param [in] doc XML文档
+    * @param [in] getClassCallback 查询全局Class定义的回调函数，可以为空
+    * @return 返回展开的class属性个数
+    */
+    static size_t ExpandClassAttributes(pugi::xml_document& doc, const GetClassCallback& getClassCallback);
+};
+
+} // namespace ui
+
+#endif // UI_CORE_WINDOW_TEMPLATE_H_
@@ -1,22 +1,63 @@
 #include "duilib/Core/XmlBinaryCache.h"
 #include "duilib/Utils/FilePathUtil.h"
+#include "duilib/Utils/Lz4Util.h"
+#include "duilib/third_party/xml/pugixml.hpp"
 #include <fstream>
 #include <cstring>
+#include <cstdio>
 #include <filesystem>
 #include <chrono>
-
-// Forward declare pugixml types
-namespace pugi {
-class xml_document;
-class xml_node;
-class xml_attribute;
-}
+#include <unordered_map>
+#include <algorithm>
 
 namespace ui {
 
 static const uint32_t kXmlBinaryMagic = 0x584D4244; // 'XMBD'
-static const uint32_t kXmlBinaryVersion = 1;
+static const uint32_t kXmlBinaryVersion = 3;
 static const uint32_t kFlagCompressed = 0x01;
+static const uint32_t kFlagCharSizeShift = 8;
+static const uint32_t kFlagCharSizeMask = 0xFF00;
+
+//压缩格式：每个数据块的原始数据大小，以及"未压缩存储"标志（数据块不可压缩时原样保存）
+static const uint32_t kCompressBlockSize = 64 * 1024;
+static const uint32_t kBlockStoredFlag = 0x80000000;
+//压缩格式中原始数据的最大长度（防止损坏的文件导致分配过大的内存）
+static const uint64_t kMaxUncompressedSize = 256 * 1024 * 1024;
+//以内存映射方式加载的缓存文件的最小长度（小于该长度的文件直接读入内存）
+static const uint64_t kMapFileMinSize = 256 * 1024;
+
+static_assert(sizeof(XmlBinaryChar) == sizeof(pugi::char_t), "XmlBinaryChar must be the same as pugi::char_t");
+
+struct XmlBinaryHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t flags;
+    uint32_t nodeCount;
+    uint32_t attrCount;
+    uint32_t stringPoolOffset;
+    uint32_t stringPoolSize;
+    uint32_t sourceTime;
+};
+
+struct XmlBinaryNodeEntry {
+    uint16_t type;
+    uint16_t reserved;
+    uint32_t nameId;
+    uint32_t firstChild;
+    uint32_t nextSibling;
+    uint32_t firstAttr;
+    uint32_t valueId;
+};
+
+struct XmlBinaryAttrEntry {
+    uint32_t nameId;
+    uint32_t valueId;
+    uint32_t nextAttr;
+};
+
+static_assert(sizeof(XmlBinaryHeader) == 32, "Header size must be 32 bytes");
+static_assert(sizeof(XmlBinaryNodeEntry) == 24, "XmlBinaryNodeEntry size must be 24 bytes");
+static_assert(sizeof(XmlBinaryAttrEntry) == 12, "XmlBinaryAttrEntry size must be 12 bytes");
 
 static std::filesystem::path ToFsPath(const FilePath& path)
 {
@@ -37,6 +78,564 @@ static int64_t GetLastWriteTimeValue(const FilePath& path)
     return std::chrono::duration_cast<std::chrono::nanoseconds>(ftime.time_since_epoch()).count();
 }
 
+/** 计算原始XML文件修改时间的校验值（保存在缓存文件头中，加载缓存时不需要再获取缓存文件的修改时间）
+* @return XML文件不存在时返回0
+*/
+static uint32_t GetSourceTimeValue(const FilePath& xmlPath)
+{
+    const int64_t nWriteTime = GetLastWriteTimeValue(xmlPath);
+    if (nWriteTime == 0) {
+        return 0;
+    }
+    const uint32_t nValue = (uint32_t)((uint64_t)nWriteTime ^ ((uint64_t)nWriteTime >> 32));
+    return (nValue != 0) ? nValue : 1;
+}
+
+static uint32_t GetCharSizeFlag()
+{
+    return ((uint32_t)sizeof(XmlBinaryChar) << kFlagCharSizeShift) & kFlagCharSizeMask;
+}
+
+static bool IsEqualString(const XmlBinaryChar* a, const XmlBinaryChar* b)
+{
+    while ((*a != 0) && (*a == *b)) {
+        ++a;
+        ++b;
+    }
+    return *a == *b;
+}
+
+/** 解压缩格式的缓存数据：逐块解压，每块直接解压到输出缓冲区的目标位置
+* @param [in] pData 压缩格式的缓存数据（可以是内存映射的文件，按顺序访问，只有读取到的页面才会从磁盘加载）
+* @param [in] nSize 数据长度
+* @param [out] output 解压后的数据（与非压缩格式完全相同）
+*/
+static bool DecompressCacheData(const uint8_t* pData, size_t nSize, std::vector<uint8_t>& output)
+{
+    output.clear();
+    if ((pData == nullptr) || (nSize < sizeof(XmlBinaryHeader))) {
+        return false;
+    }
+    XmlBinaryHeader header;
+    std::memcpy(&header, pData, sizeof(header));
+    if (!(header.flags & kFlagCompressed)) {
+        return false;
+    }
+    //解压后的总长度由文件头确定（字符串池位于最后）
+    const uint64_t nTotalSize = (uint64_t)header.stringPoolOffset + header.stringPoolSize;
+    if ((nTotalSize < sizeof(header)) || (nTotalSize > kMaxUncompressedSize)) {
+        return false;
+    }
+    header.flags &= ~kFlagCompressed;
+    output.resize((size_t)nTotalSize);
+    std::memcpy(output.data(), &header, sizeof(header));
+
+    size_t nPos = sizeof(header);
+    size_t nOffset = sizeof(header);
+    while (nOffset < output.size()) {
+        uint32_t blockHeader[2] = { 0, 0 };
+        if (nSize - nPos < sizeof(blockHeader)) {
+            break;
+        }
+        std::memcpy(blockHeader, pData + nPos, sizeof(blockHeader));
+        nPos += sizeof(blockHeader);
+        const bool bStored = (blockHeader[0] & kBlockStoredFlag) != 0;
+        const uint32_t nBlockSize = blockHeader[0] & ~kBlockStoredFlag;
+        const uint32_t nRawSize = blockHeader[1];
+        if ((nRawSize == 0) || (nRawSize > kCompressBlockSize) || (nRawSize > output.size() - nOffset) ||
+            (nBlockSize > nSize - nPos) || (bStored && (nBlockSize != nRawSize))) {
+            break;
+        }
+        if (bStored) {
+            std::memcpy(output.data() + nOffset, pData + nPos, nRawSize);
+        }
+        else if (!Lz4Util::DecompressBlock(pData + nPos, nBlockSize, output.data() + nOffset, nRawSize)) {
+            break;
+        }
+        nPos += nBlockSize;
+        nOffset += nRawSize;
+    }
+    if ((nOffset != output.size()) || (nPos != nSize)) {
+        //数据不完整或者已损坏
+        output.clear();
+        return false;
+    }
+    return true;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// XmlBinaryAttribute
+
+XmlBinaryAttribute::XmlBinaryAttribute():
+    m_pDoc(nullptr),
+    m_nIndex(0)
+{
+}
+
+XmlBinaryAttribute::XmlBinaryAttribute(const XmlBinaryDocument* pDoc, uint32_t nIndex):
+    m_pDoc(nIndex != 0 ? pDoc : nullptr),
+    m_nIndex(pDoc != nullptr ? nIndex : 0)
+{
+}
+
+bool XmlBinaryAttribute::empty() const
+{
+    return m_pDoc == nullptr;
+}
+
+const XmlBinaryChar* XmlBinaryAttribute::name() const
+{
+    return (m_pDoc != nullptr) ? m_pDoc->GetString(m_pDoc->GetAttr(m_nIndex).nameId) : _T("");
+}
+
+const XmlBinaryChar* XmlBinaryAttribute::value() const
+{
+    return (m_pDoc != nullptr) ? m_pDoc->GetString(m_pDoc->GetAttr(m_nIndex).valueId) : _T("");
+}
+
+const XmlBinaryChar* XmlBinaryAttribute::as_string(const XmlBinaryChar* def) const
+{
+    return (m_pDoc != nullptr) ? value() : def;
+}
+
+int XmlBinaryAttribute::as_int(int def) const
+{
+    if (m_pDoc == nullptr) {
+        return def;
+    }
+    //与pugixml的规则相同：忽略前导空白，支持正负号和"0x"开头的十六进制
+    const XmlBinaryChar* s = value();
+    while ((*s == _T(' ')) || (*s == _T('\t')) || (*s == _T('\r')) || (*s == _T('\n'))) {
+        ++s;
+    }
+    bool bNegative = false;
+    if ((*s == _T('-')) || (*s == _T('+'))) {
+        bNegative = (*s == _T('-'));
+        ++s;
+    }
+    uint32_t nResult = 0;
+    if ((s[0] == _T('0')) && ((s[1] == _T('x')) || (s[1] == _T('X')))) {
+        s += 2;
+        for (;; ++s) {
+            uint32_t nDigit = 0;
+            if ((*s >= _T('0')) && (*s <= _T('9'))) {
+                nDigit = (uint32_t)(*s - _T('0'));
+            }
+            else if ((*s >= _T('a')) && (*s <= _T('f'))) {
+                nDigit = (uint32_t)(*s - _T('a') + 10);
+            }
+            else if ((*s >= _T('A')) && (*s <= _T('F'))) {
+                nDigit = (uint32_t)(*s - _T('A') + 10);
+            }
+            else {
+                break;
+            }
+            nResult = nResult * 16 + nDigit;
+        }
+    }
+    else {
+        for (; (*s >= _T('0')) && (*s <= _T('9')); ++s) {
+            nResult = nResult * 10 + (uint32_t)(*s - _T('0'));
+        }
+    }
+    return bNegative ? (int)(0 - nResult) : (int)nResult;
+}
+
+XmlBinaryAttribute XmlBinaryAttribute::next_attribute() const
+{
+    if (m_pDoc == nullptr) {
+        return XmlBinaryAttribute();
+    }
+    //下一个属性的索引总是大于当前属性，否则视为无效（避免损坏的数据导致死循环）
+    const uint32_t nNext = m_pDoc->GetAttr(m_nIndex).nextAttr;
+    return ((nNext > m_nIndex) && (nNext < m_pDoc->m_nAttrCount)) ? XmlBinaryAttribute(m_pDoc, nNext) : XmlBinaryAttribute();
+}
+
+bool XmlBinaryAttribute::operator == (const XmlBinaryAttribute& r) const
+{
+    return (m_pDoc == r.m_pDoc) && (m_nIndex == r.m_nIndex);
+}
+
+bool XmlBinaryAttribute::operator != (const XmlBinaryAttribute& r) const
+{
+    return !(*this == r);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// XmlBinaryText
+
+XmlBinaryText::XmlBinaryText(const XmlBinaryChar* pText):
+    m_pText(pText)
+{
+}
+
+bool XmlBinaryText::empty() const
+{
+    return m_pText == nullptr;
+}
+
+const XmlBinaryChar* XmlBinaryText::as_string(const XmlBinaryChar* def) const
+{
+    return (m_pText != nullptr) ? m_pText : def;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// XmlBinaryNode
+
+XmlBinaryNode::XmlBinaryNode():
+    m_pDoc(nullptr),
+    m_nIndex(0)
+{
+}
+
+XmlBinaryNode::XmlBinaryNode(const XmlBinaryDocument* pDoc, uint32_t nIndex):
+    m_pDoc(pDoc),
+    m_nIndex(nIndex)
+{
+}
+
+bool XmlBinaryNode::empty() const
+{
+    return m_pDoc == nullptr;
+}
+
+int32_t XmlBinaryNode::type() const
+{
+    return (m_pDoc != nullptr) ? (int32_t)m_pDoc->GetNode(m_nIndex).type : (int32_t)pugi::node_null;
+}
+
+const XmlBinaryChar* XmlBinaryNode::name() const
+{
+    return (m_pDoc != nullptr) ? m_pDoc->GetString(m_pDoc->GetNode(m_nIndex).nameId) : _T("");
+}
+
+const XmlBinaryChar* XmlBinaryNode::value() const
+{
+    return (m_pDoc != nullptr) ? m_pDoc->GetString(m_pDoc->GetNode(m_nIndex).valueId) : _T("");
+}
+
+XmlBinaryNode XmlBinaryNode::first_child() const
+{
+    if (m_pDoc == nullptr) {
+        return XmlBinaryNode();
+    }
+    //子节点和兄弟节点的索引总是大于当前节点，否则视为无效（避免损坏的数据导致死循环）
+    const uint32_t nChild = m_pDoc->GetNode(m_nIndex).firstChild;
+    return ((nChild > m_nIndex) && (nChild < m_pDoc->m_nNodeCount)) ? XmlBinaryNode(m_pDoc, nChild) : XmlBinaryNode();
+}
+
+XmlBinaryNode XmlBinaryNode::next_sibling() const
+{
+    if (m_pDoc == nullptr) {
+        return XmlBinaryNode();
+    }
+    const uint32_t nSibling = m_pDoc->GetNode(m_nIndex).nextSibling;
+    return ((nSibling > m_nIndex) && (nSibling < m_pDoc->m_nNodeCount)) ? XmlBinaryNode(m_pDoc, nSibling) : XmlBinaryNode();
+}
+
+XmlBinaryAttribute XmlBinaryNode::first_attribute() const
+{
+    if (m_pDoc == nullptr) {
+        return XmlBinaryAttribute();
+    }
+    const uint32_t nAttr = m_pDoc->GetNode(m_nIndex).firstAttr;
+    return (nAttr < m_pDoc->m_nAttrCount) ? XmlBinaryAttribute(m_pDoc, nAttr) : XmlBinaryAttribute();
+}
+
+XmlBinaryAttribute XmlBinaryNode::attribute(const XmlBinaryChar* name) const
+{
+    if (name == nullptr) {
+        return XmlBinaryAttribute();
+    }
+    for (XmlBinaryAttribute attr = first_attribute(); !attr.empty(); attr = attr.next_attribute()) {
+        if (IsEqualString(attr.name(), name)) {
+            return attr;
+        }
+    }
+    return XmlBinaryAttribute();
+}
+
+XmlBinaryNode::Range<XmlBinaryNode> XmlBinaryNode::children() const
+{
+    return Range<XmlBinaryNode>(first_child());
+}
+
+XmlBinaryNode::Range<XmlBinaryAttribute> XmlBinaryNode::attributes() const
+{
+    return Range<XmlBinaryAttribute>(first_attribute());
+}
+
+XmlBinaryText XmlBinaryNode::text() const
+{
+    //与pugixml的规则相同：文本节点返回自身的值，否则返回第一个文本子节点的值
+    const int32_t nType = type();
+    if ((nType == pugi::node_pcdata) || (nType == pugi::node_cdata)) {
+        return XmlBinaryText(value());
+    }
+    for (XmlBinaryNode node = first_child(); !node.empty(); node = node.next_sibling()) {
+        const int32_t nChildType = node.type();
+        if ((nChildType == pugi::node_pcdata) || (nChildType == pugi::node_cdata)) {
+            return XmlBinaryText(node.value());
+        }
+    }
+    return XmlBinaryText(nullptr);
+}
+
+bool XmlBinaryNode::operator == (const XmlBinaryNode& r) const
+{
+    return (m_pDoc == r.m_pDoc) && (m_nIndex == r.m_nIndex);
+}
+
+bool XmlBinaryNode::operator != (const XmlBinaryNode& r) const
+{
+    return !(*this == r);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// XmlBinaryDocument
+
+XmlBinaryDocument::XmlBinaryDocument():
+    m_pNodes(nullptr),
+    m_nNodeCount(0),
+    m_pAttrs(nullptr),
+    m_nAttrCount(0),
+    m_pStringPool(nullptr),
+    m_nStringPoolSize(0),
+    m_nSourceTime(0)
+{
+}
+
+XmlBinaryDocument::~XmlBinaryDocument() = default;
+
+bool XmlBinaryDocument::LoadFile(const FilePath& cacheFilePath)
+{
+    Clear();
+    std::ifstream file(ToFsPath(cacheFilePath), std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        return false;
+    }
+    const std::streamoff nFileSize = file.tellg();
+    if (nFileSize < (std::streamoff)sizeof(XmlBinaryHeader)) {
+        return false;
+    }
+    //小文件直接读入内存（建立和释放内存映射的开销，以及缺页中断的开销，大于读取文件的开销），大文件使用内存映射
+    const uint8_t* pData = nullptr;
+    size_t nSize = 0;
+    if ((uint64_t)nFileSize < kMapFileMinSize) {
+        m_buffer.resize((size_t)nFileSize);
+        file.seekg(0, std::ios::beg);
+        if (!file.read(reinterpret_cast<char*>(m_buffer.data()), nFileSize)) {
+            Clear();
+            return false;
+        }
+        pData = m_buffer.data();
+        nSize = m_buffer.size();
+    }
+    else {
+        file.close();
+        if (!m_mappedFile.Open(cacheFilePath)) {
+            return false;
+        }
+        pData = m_mappedFile.GetData();
+        nSize = m_mappedFile.GetSize();
+    }
+    const XmlBinaryHeader* pHeader = reinterpret_cast<const XmlBinaryHeader*>(pData);
+    if ((nSize >= sizeof(XmlBinaryHeader)) && (pHeader->flags & kFlagCompressed)) {
+        //压缩格式：逐块解压到内存中，解压完成后不再需要原始数据
+        std::vector<uint8_t> output;
+        if (!DecompressCacheData(pData, nSize, output)) {
+            Clear();
+            return false;
+        }
+        m_mappedFile.Close();
+        m_buffer.swap(output);
+        pData = m_buffer.data();
+        nSize = m_buffer.size();
+    }
+    if (!AttachData(pData, nSize, false)) {
+        Clear();
+        return false;
+    }
+    return true;
+}
+
+bool XmlBinaryDocument::LoadBuffer(std::vector<uint8_t>&& data)
+{
+    Clear();
+    m_buffer = std::move(data);
+    if (!AttachData(m_buffer.data(), m_buffer.size(), true)) {
+        Clear();
+        return false;
+    }
+    return true;
+}
+
+void XmlBinaryDocument::Clear()
+{
+    m_pNodes = nullptr;
+    m_nNodeCount = 0;
+    m_pAttrs = nullptr;
+    m_nAttrCount = 0;
+    m_pStringPool = nullptr;
+    m_nStringPoolSize = 0;
+    m_nSourceTime = 0;
+    m_mappedFile.Close();
+    m_buffer.clear();
+}
+
+bool XmlBinaryDocument::IsEmpty() const
+{
+    return m_nNodeCount == 0;
+}
+
+bool XmlBinaryDocument::IsMapped() const
+{
+    return !IsEmpty() && m_mappedFile.IsOpen();
+}
+
+XmlBinaryNode XmlBinaryDocument::root() const
+{
+    return IsEmpty() ? XmlBinaryNode() : XmlBinaryNode(this, 0);
+}
+
+bool XmlBinaryDocument::AttachData(const uint8_t* pData, size_t nSize, bool bFullCheck)
+{
+    if ((pData == nullptr) || (nSize < sizeof(XmlBinaryHeader))) {
+        return false;
+    }
+    const XmlBinaryHeader* pHeader = reinterpret_cast<const XmlBinaryHeader*>(pData);
+    if ((pHeader->magic != kXmlBinaryMagic) || (pHeader->version != kXmlBinaryVersion)) {
+        return false;
+    }
+    if ((pHeader->flags & kFlagCharSizeMask) != GetCharSizeFlag()) {
+        //字符串池的字符大小与当前编译选项不一致（Unicode版本与非Unicode版本的缓存不能通用）
+        return false;
+    }
+    if (pHeader->flags & kFlagCompressed) {
+        //压缩格式的数据，不支持直接访问
+        return false;
+    }
+    if ((pHeader->nodeCount == 0) || (pHeader->attrCount == 0)) {
+        return false;
+    }
+    //数据长度必须与文件头中的各段长度完全一致（截断或者追加了数据的文件视为损坏）
+    const uint64_t nNodeTableSize = (uint64_t)pHeader->nodeCount * sizeof(XmlBinaryNodeEntry);
+    const uint64_t nAttrTableSize = (uint64_t)pHeader->attrCount * sizeof(XmlBinaryAttrEntry);
+    const uint64_t nStringPoolOffset = sizeof(XmlBinaryHeader) + nNodeTableSize + nAttrTableSize;
+    if ((pHeader->stringPoolOffset != nStringPoolOffset) ||
+        (nStringPoolOffset + pHeader->stringPoolSize != (uint64_t)nSize) ||
+        (pHeader->stringPoolSize < sizeof(uint32_t) + sizeof(XmlBinaryChar)) ||
+        ((pHeader->stringPoolSize % sizeof(uint32_t)) != 0)) {
+        return false;
+    }
+
+    const XmlBinaryNodeEntry* pNodes = reinterpret_cast<const XmlBinaryNodeEntry*>(pData + sizeof(XmlBinaryHeader));
+    const XmlBinaryAttrEntry* pAttrs = reinterpret_cast<const XmlBinaryAttrEntry*>(pData + sizeof(XmlBinaryHeader) + nNodeTableSize);
+    const uint8_t* pStringPool = pData + nStringPoolOffset;
+    const uint32_t nStringPoolSize = pHeader->stringPoolSize;
+
+    //字符串池的最后一个字符必须为0：访问节点时只检查字符串的起始位置，即可保证读取字符串时不会越界
+    const XmlBinaryChar* pLastChar = reinterpret_cast<const XmlBinaryChar*>(pStringPool + nStringPoolSize - sizeof(XmlBinaryChar));
+    if (*pLastChar != 0) {
+        return false;
+    }
+    if (bFullCheck && !ValidateData(pData, nSize)) {
+        return false;
+    }
+
+    m_pNodes = pNodes;
+    m_nNodeCount = pHeader->nodeCount;
+    m_pAttrs = pAttrs;
+    m_nAttrCount = pHeader->attrCount;
+    m_pStringPool = pStringPool;
+    m_nStringPoolSize = nStringPoolSize;
+    m_nSourceTime = pHeader->sourceTime;
+    return true;
+}
+
+bool XmlBinaryDocument::ValidateData(const uint8_t* pData, size_t nSize)
+{
+    //调用方已校验文件头和各段的长度
+    const XmlBinaryHeader* pHeader = reinterpret_cast<const XmlBinaryHeader*>(pData);
+    ASSERT((pData != nullptr) && (nSize == (uint64_t)pHeader->stringPoolOffset + pHeader->stringPoolSize));
+    const XmlBinaryNodeEntry* pNodes = reinterpret_cast<const XmlBinaryNodeEntry*>(pData + sizeof(XmlBinaryHeader));
+    const XmlBinaryAttrEntry* pAttrs = reinterpret_cast<const XmlBinaryAttrEntry*>(pData + sizeof(XmlBinaryHeader) + (size_t)pHeader->nodeCount * sizeof(XmlBinaryNodeEntry));
+    const uint8_t* pStringPool = pData + pHeader->stringPoolOffset;
+    const uint32_t nStringPoolSize = pHeader->stringPoolSize;
+
+    auto IsValidString = [pStringPool, nStringPoolSize](uint32_t nStringId) {
+            if ((nStringId % sizeof(uint32_t)) != 0) {
+                return false;
+            }
+            if ((uint64_t)nStringId + sizeof(uint32_t) > nStringPoolSize) {
+                return false;
+            }
+            uint32_t nLength = 0;
+            std::memcpy(&nLength, pStringPool + nStringId, sizeof(nLength));
+            const uint64_t nEnd = (uint64_t)nStringId + sizeof(uint32_t) + ((uint64_t)nLength + 1) * sizeof(XmlBinaryChar);
+            if (nEnd > nStringPoolSize) {
+                return false;
+            }
+            const XmlBinaryChar* pString = reinterpret_cast<const XmlBinaryChar*>(pStringPool + nStringId + sizeof(uint32_t));
+            return pString[nLength] == 0;
+        };
+
+    //校验所有索引：子节点和兄弟节点的索引总是大于当前节点（先序遍历的顺序），以保证遍历不会出现死循环
+    if (!IsValidString(0) || (pNodes[0].nextSibling != 0)) {
+        return false;
+    }
+    for (uint32_t i = 0; i < pHeader->nodeCount; ++i) {
+        const XmlBinaryNodeEntry& node = pNodes[i];
+        if ((node.firstChild != 0) && ((node.firstChild <= i) || (node.firstChild >= pHeader->nodeCount))) {
+            return false;
+        }
+        if ((node.nextSibling != 0) && ((node.nextSibling <= i) || (node.nextSibling >= pHeader->nodeCount))) {
+            return false;
+        }
+        if (node.firstAttr >= pHeader->attrCount) {
+            return false;
+        }
+        if (!IsValidString(node.nameId) || !IsValidString(node.valueId)) {
+            return false;
+        }
+    }
+    for (uint32_t i = 1; i < pHeader->attrCount; ++i) {
+        const XmlBinaryAttrEntry& attr = pAttrs[i];
+        if ((attr.nextAttr != 0) && ((attr.nextAttr <= i) || (attr.nextAttr >= pHeader->attrCount))) {
+            return false;
+        }
+        if (!IsValidString(attr.nameId) || !IsValidString(attr.valueId)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+const XmlBinaryNodeEntry& XmlBinaryDocument::GetNode(uint32_t nIndex) const
+{
+    ASSERT(nIndex < m_nNodeCount);
+    return m_pNodes[nIndex];
+}
+
+const XmlBinaryAttrEntry& XmlBinaryDocument::GetAttr(uint32_t nIndex) const
+{
+    ASSERT((nIndex > 0) && (nIndex < m_nAttrCount));
+    return m_pAttrs[nIndex];
+}
+
+const XmlBinaryChar* XmlBinaryDocument::GetString(uint32_t nStringId) const
+{
+    //字符串池以0结尾（加载时已校验），所以起始位置有效的字符串一定在字符串池内结束
+    if (((nStringId % sizeof(uint32_t)) != 0) ||
+        ((uint64_t)nStringId + sizeof(uint32_t) + sizeof(XmlBinaryChar) > m_nStringPoolSize)) {
+        return _T("");
+    }
+    return reinterpret_cast<const XmlBinaryChar*>(m_pStringPool + nStringId + sizeof(uint32_t));
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// XmlBinaryCache
+
 XmlBinaryCache::XmlBinaryCache()
     : m_compressionEnabled(false)
 {
@@ -54,6 +653,29 @@ FilePath XmlBinaryCache::GetCacheFilePath(const FilePath& xmlPath) {
     return FilePath(path);
 }
 
+FilePath XmlBinaryCache::GetCacheFullPath(const FilePath& xmlPath) const
+{
+    FilePath cachePath = GetCacheFilePath(xmlPath);
+    if (m_cacheDirectory.IsEmpty()) {
+        return cachePath;
+    }
+    //不同目录下可能有同名的XML文件，缓存文件名中加入原始路径的哈希值(FNV-1a)
+    const DString& xmlPathString = xmlPath.ToString();
+    uint32_t nHash = 2166136261u;
+    for (DString::value_type ch : xmlPathString) {
+        nHash = (nHash ^ (uint32_t)ch) * 16777619u;
+    }
+    char szHash[16] = { 0, };
+    std::snprintf(szHash, sizeof(szHash), "_%08x", nHash);
+
+    DString cacheFileName = cachePath.GetFileName();
+    size_t dotPos = cacheFileName.rfind(_T('.'));
+    if (dotPos != DString::npos) {
+        cacheFileName.insert(dotPos, DString(szHash, szHash + std::strlen(szHash)));
+    }
+    return FilePathUtil::JoinFilePath(m_cacheDirectory, FilePath(cacheFileName));
+}
+
 void XmlBinaryCache::SetCacheDirectory(const FilePath& cacheDir) {
     m_cacheDirectory = cacheDir;
 }
@@ -63,179 +685,306 @@ void XmlBinaryCache::SetCompressionEnabled(bool enabled) {
 }
 
 bool XmlBinaryCache::IsCacheValid(const FilePath& xmlPath) const {
-    FilePath cachePath = GetCacheFilePath(xmlPath);
-    
-    if (!m_cacheDirectory.IsEmpty()) {
-        DString cacheFileName = cachePath.GetFileName();
-        cachePath = FilePathUtil::JoinFilePath(m_cacheDirectory, FilePath(cacheFileName));
-    }
-    
-    if (!cachePath.IsExistsFile()) {
-        return false;
-    }
-    
-    // Check if XML file is newer than cache
-    const int64_t xmlTime = GetLastWriteTimeValue(xmlPath);
-    const int64_t cacheTime = GetLastWriteTimeValue(cachePath);
-    
-    if (xmlTime > cacheTime) {
+    // Cache is valid only if it was generated from the current XML file (modification time recorded in header)
+    const uint32_t nSourceTime = GetSourceTimeValue(xmlPath);
+    if (nSourceTime == 0) {
         return false;
     }
-    
+
     // Verify cache file header
-    std::ifstream file(ToFsPath(cachePath), std::ios::binary);
+    std::ifstream file(ToFsPath(GetCacheFullPath(xmlPath)), std::ios::binary);
     if (!file.is_open()) {
         return false;
     }
-    
-    BinaryHeader header;
+
+    XmlBinaryHeader header;
     file.read(reinterpret_cast<char*>(&header), sizeof(header));
-    
+    if (!file.good()) {
+        return false;
+    }
+
     if (header.magic != kXmlBinaryMagic) {
         return false;
     }
-    
+
     if (header.version != kXmlBinaryVersion) {
         return false;
     }
-    
-    return true;
+
+    if ((header.flags & kFlagCharSizeMask) != GetCharSizeFlag()) {
+        return false;
+    }
+
+    return header.sourceTime == nSourceTime;
 }
 
 bool XmlBinaryCache::SaveToCache(const FilePath& xmlPath, const pugi::xml_document& doc) {
-    FilePath cachePath = GetCacheFilePath(xmlPath);
-    
-    if (!m_cacheDirectory.IsEmpty()) {
-        DString cacheFileName = cachePath.GetFileName();
-        cachePath = FilePathUtil::JoinFilePath(m_cacheDirectory, FilePath(cacheFileName));
-    }
-    
+    FilePath cachePath = GetCacheFullPath(xmlPath);
+
     std::vector<uint8_t> binaryData;
-    if (!SerializeDocument(doc, binaryData)) {
+    if (!SerializeDocument(doc, GetSourceTimeValue(xmlPath), binaryData)) {
         return false;
     }
-    
+
     std::ofstream file(ToFsPath(cachePath), std::ios::binary);
     if (!file.is_open()) {
         return false;
     }
-    
+
     file.write(reinterpret_cast<const char*>(binaryData.data()), binaryData.size());
     return file.good();
 }
 
 bool XmlBinaryCache::LoadFromCache(const FilePath& xmlPath, pugi::xml_document& doc) {
-    if (!IsCacheValid(xmlPath)) {
+    XmlBinaryDocument binaryDoc;
+    if (!LoadFromCache(xmlPath, binaryDoc)) {
         return false;
     }
-    
-    FilePath cachePath = GetCacheFilePath(xmlPath);
-    
-    if (!m_cacheDirectory.IsEmpty()) {
-        DString cacheFileName = cachePath.GetFileName();
-        cachePath = FilePathUtil::JoinFilePath(m_cacheDirectory, FilePath(cacheFileName));
+    return DeserializeDocument(binaryDoc, doc);
+}
+
+bool XmlBinaryCache::LoadFromCache(const FilePath& xmlPath, XmlBinaryDocument& doc) {
+    doc.Clear();
+    //只获取XML文件的修改时间，与文件头中记录的值比较（不需要获取缓存文件的修改时间）
+    const uint32_t nSourceTime = GetSourceTimeValue(xmlPath);
+    if (nSourceTime == 0) {
+        return false;
     }
-    
-    std::ifstream file(ToFsPath(cachePath), std::ios::binary);
-    if (!file.is_open()) {
+    if (!doc.LoadFile(GetCacheFullPath(xmlPath))) {
         return false;
     }
-    
-    file.seekg(0, std::ios::end);
-    size_t size = file.tellg();
-    file.seekg(0, std::ios::beg);
-    
-    std::vector<uint8_t> data(size);
-    file.read(reinterpret_cast<char*>(data.data()), size);
-    
-    if (!file.good()) {
+    if (doc.m_nSourceTime != nSourceTime) {
+        //XML文件已经修改，缓存过期
+        doc.Clear();
         return false;
     }
-    
-    return DeserializeDocument(data, doc);
+    return true;
+}
+
+bool XmlBinaryCache::SaveToData(const pugi::xml_document& doc, std::vector<uint8_t>& output) {
+    output.clear();
+    return SerializeDocument(doc, 0, output);
 }
 
 bool XmlBinaryCache::ClearCache(const FilePath& xmlPath) {
-    FilePath cachePath = GetCacheFilePath(xmlPath);
-    
-    if (!m_cacheDirectory.IsEmpty()) {
-        DString cacheFileName = cachePath.GetFileName();
-        cachePath = FilePathUtil::JoinFilePath(m_cacheDirectory, FilePath(cacheFileName));
-    }
-    
+    FilePath cachePath = GetCacheFullPath(xmlPath);
+
     if (cachePath.IsExistsFile()) {
         std::error_code ec;
         const bool removed = std::filesystem::remove(ToFsPath(cachePath), ec);
         return removed && !ec;
     }
-    
+
     return true;
 }
 
 int XmlBinaryCache::ClearAllCache() {
-    // Implementation depends on filesystem utilities
-    // For now, return 0 as placeholder
-    return 0;
+    //未设置缓存目录时，缓存文件分散在各个XML文件所在目录，无法统一清除
+    if (m_cacheDirectory.IsEmpty()) {
+        return 0;
+    }
+    int nCount = 0;
+    std::error_code ec;
+    std::filesystem::directory_iterator iter(ToFsPath(m_cacheDirectory), ec);
+    if (ec) {
+        return 0;
+    }
+    for (const std::filesystem::directory_entry& entry : iter) {
+        if (entry.is_regular_file(ec) && (entry.path().extension() == ".xmc")) {
+            if (std::filesystem::remove(entry.path(), ec) && !ec) {
+                ++nCount;
+            }
+        }
+    }
+    return nCount;
 }
 
-bool XmlBinaryCache::SerializeDocument(const pugi::xml_document& doc, 
-                                        std::vector<uint8_t>& output) {
-    UNUSED_VARIABLE(doc);
-    // Placeholder implementation
-    // Full implementation would traverse the DOM tree and serialize to binary format
-    
-    BinaryHeader header;
-    header.magic = kXmlBinaryMagic;
-    header.version = kXmlBinaryVersion;
-    header.flags = m_compressionEnabled ? kFlagCompressed : 0;
-    header.nodeCount = 0;
-    header.attrCount = 0;
-    header.stringPoolOffset = 0;
-    header.stringPoolSize = 0;
-    header.reserved = 0;
-    
-    output.resize(sizeof(header));
-    std::memcpy(output.data(), &header, sizeof(header));
-    
-    return true;
+namespace
+{
+/** 序列化时使用的辅助类：按先序遍历的顺序生成节点表、属性表和字符串池
+*/
+class XmlBinaryWriter
+{
+public:
+
+    XmlBinaryWriter()
+    {
+        //0号属性保留不用，ID为0的字符串为空字符串
+        m_attrs.push_back(XmlBinaryAttrEntry{ 0, 0, 0 });
+        AddString(_T(""));
+    }
+
+    uint32_t AddNode(const pugi::xml_node& xmlNode)
+    {
+        const uint32_t nIndex = (uint32_t)m_nodes.size();
+        m_nodes.push_back(XmlBinaryNodeEntry());
+        XmlBinaryNodeEntry entry{};
+        entry.type = (uint16_t)xmlNode.type();
+        entry.nameId = AddString(xmlNode.name());
+        entry.valueId = AddString(xmlNode.value());
+
+        uint32_t nPrevAttr = 0;
+        for (pugi::xml_attribute attr = xmlNode.first_attribute(); !attr.empty(); attr = attr.next_attribute()) {
+            const uint32_t nAttr = (uint32_t)m_attrs.size();
+            m_attrs.push_back(XmlBinaryAttrEntry{ AddString(attr.name()), AddString(attr.value()), 0 });
+            if (nPrevAttr == 0) {
+                entry.firstAttr = nAttr;
+            }
+            else {
+                m_attrs[nPrevAttr].nextAttr = nAttr;
+            }
+            nPrevAttr = nAttr;
+        }
+        m_nodes[nIndex] = entry;
+
+        //递归子节点（子节点的索引总是大于父节点）
+        uint32_t nPrevChild = 0;
+        for (pugi::xml_node child = xmlNode.first_child(); !child.empty(); child = child.next_sibling()) {
+            const uint32_t nChild = AddNode(child);
+            if (nPrevChild == 0) {
+                m_nodes[nIndex].firstChild = nChild;
+            }
+            else {
+                m_nodes[nPrevChild].nextSibling = nChild;
+            }
+            nPrevChild = nChild;
+        }
+        return nIndex;
+    }
+
+    void Write(uint32_t nFlags, uint32_t nSourceTime, std::vector<uint8_t>& output) const
+    {
+        const size_t nNodeTableSize = m_nodes.size() * sizeof(XmlBinaryNodeEntry);
+        const size_t nAttrTableSize = m_attrs.size() * sizeof(XmlBinaryAttrEntry);
+
+        XmlBinaryHeader header{};
+        header.magic = kXmlBinaryMagic;
+        header.version = kXmlBinaryVersion;
+        header.flags = nFlags;
+        header.nodeCount = (uint32_t)m_nodes.size();
+        header.attrCount = (uint32_t)m_attrs.size();
+        header.stringPoolOffset = (uint32_t)(sizeof(header) + nNodeTableSize + nAttrTableSize);
+        header.stringPoolSize = (uint32_t)m_stringPool.size();
+        header.sourceTime = nSourceTime;
+
+        output.resize(header.stringPoolOffset + m_stringPool.size());
+        uint8_t* pData = output.data();
+        std::memcpy(pData, &header, sizeof(header));
+        std::memcpy(pData + sizeof(header), m_nodes.data(), nNodeTableSize);
+        std::memcpy(pData + sizeof(header) + nNodeTableSize, m_attrs.data(), nAttrTableSize);
+        if (!m_stringPool.empty()) {
+            std::memcpy(pData + header.stringPoolOffset, m_stringPool.data(), m_stringPool.size());
+        }
+    }
+
+private:
+    uint32_t AddString(const pugi::char_t* str)
+    {
+        DString value(str != nullptr ? str : _T(""));
+        auto iter = m_stringIds.find(value);
+        if (iter != m_stringIds.end()) {
+            return iter->second;
+        }
+        const uint32_t nStringId = (uint32_t)m_stringPool.size();
+        const uint32_t nLength = (uint32_t)value.size();
+        const size_t nBytes = sizeof(uint32_t) + (value.size() + 1) * sizeof(XmlBinaryChar);
+        const size_t nAlignedBytes = (nBytes + sizeof(uint32_t) - 1) / sizeof(uint32_t) * sizeof(uint32_t);
+        m_stringPool.resize(m_stringPool.size() + nAlignedBytes, 0);
+        uint8_t* pString = m_stringPool.data() + nStringId;
+        std::memcpy(pString, &nLength, sizeof(nLength));
+        std::memcpy(pString + sizeof(uint32_t), value.c_str(), value.size() * sizeof(XmlBinaryChar));
+        m_stringIds[value] = nStringId;
+        return nStringId;
+    }
+
+private:
+    std::vector<XmlBinaryNodeEntry> m_nodes;
+    std::vector<XmlBinaryAttrEntry> m_attrs;
+    std::vector<uint8_t> m_stringPool;
+    std::unordered_map<DString, uint32_t> m_stringIds;
+};
+
+/** 反序列化时使用的辅助函数：将二进制节点的子节点复制到pugixml节点
+*/
+void CopyBinaryChildren(const XmlBinaryNode& binaryNode, pugi::xml_node xmlNode)
+{
+    for (const XmlBinaryNode& child : binaryNode.children()) {
+        pugi::xml_node newNode = xmlNode.append_child((pugi::xml_node_type)child.type());
+        if (*child.name() != 0) {
+            newNode.set_name(child.name());
+        }
+        if (*child.value() != 0) {
+            newNode.set_value(child.value());
+        }
+        for (const XmlBinaryAttribute& attr : child.attributes()) {
+            newNode.append_attribute(attr.name()).set_value(attr.value());
+        }
+        CopyBinaryChildren(child, newNode);
+    }
+}
 }
 
-bool XmlBinaryCache::DeserializeDocument(const std::vector<uint8_t>& input,
-                                          pugi::xml_document& doc) {
-    UNUSED_VARIABLE(doc);
-    if (input.size() < sizeof(BinaryHeader)) {
+bool XmlBinaryCache::SerializeDocument(const pugi::xml_document& doc, uint32_t nSourceTime,
+                                        std::vector<uint8_t>& output) {
+    XmlBinaryWriter writer;
+    writer.AddNode(doc);
+    std::vector<uint8_t> rawData;
+    writer.Write(GetCharSizeFlag(), nSourceTime, m_compressionEnabled ? rawData : output);
+    //写入时完整校验一次（加载缓存文件时只校验文件头和各段的长度）
+    const std::vector<uint8_t>& data = m_compressionEnabled ? rawData : output;
+    XmlBinaryDocument checkDoc;
+    if (!checkDoc.AttachData(data.data(), data.size(), true)) {
+        ASSERT(!"XmlBinaryCache::SerializeDocument: invalid binary data!");
+        output.clear();
         return false;
     }
-    
-    const BinaryHeader* header = reinterpret_cast<const BinaryHeader*>(input.data());
-    
-    if (header->magic != kXmlBinaryMagic) {
-        return false;
+    if (!m_compressionEnabled) {
+        return true;
     }
-    
-    if (header->version != kXmlBinaryVersion) {
+    return CompressData(rawData, output);
+}
+
+bool XmlBinaryCache::DeserializeDocument(const XmlBinaryDocument& input,
+                                          pugi::xml_document& doc) {
+    if (input.IsEmpty()) {
         return false;
     }
-    
-    // Placeholder implementation
-    // Full implementation would reconstruct the DOM tree from binary format
-    
+    doc.reset();
+    CopyBinaryChildren(input.root(), doc);
     return true;
 }
 
 bool XmlBinaryCache::CompressData(const std::vector<uint8_t>& input,
                                    std::vector<uint8_t>& output) {
-    // Placeholder: integrate with LZ4 or similar compression library
-    output = input;
-    return true;
-}
+    if (input.size() < sizeof(XmlBinaryHeader)) {
+        return false;
+    }
+    //文件头不压缩（只设置压缩标志），以便校验缓存时不需要解压
+    XmlBinaryHeader header;
+    std::memcpy(&header, input.data(), sizeof(header));
+    header.flags |= kFlagCompressed;
 
-bool XmlBinaryCache::DecompressData(const std::vector<uint8_t>& input,
-                                     std::vector<uint8_t>& output,
-                                     size_t originalSize) {
-    UNUSED_VARIABLE(originalSize);
-    // Placeholder: integrate with LZ4 or similar compression library
-    output = input;
+    output.clear();
+    output.reserve(sizeof(header) + Lz4Util::GetMaxCompressedSize(input.size() - sizeof(header)));
+    output.resize(sizeof(header));
+    std::memcpy(output.data(), &header, sizeof(header));
+
+    //节点表、属性表和字符串池作为一个整体，按固定大小分块压缩：[压缩后大小][原始大小][数据]
+    for (size_t nOffset = sizeof(header); nOffset < input.size(); nOffset += kCompressBlockSize) {
+        const uint32_t nRawSize = (uint32_t)std::min<size_t>(kCompressBlockSize, input.size() - nOffset);
+        const size_t nBlockHeaderPos = output.size();
+        output.resize(nBlockHeaderPos + sizeof(uint32_t) * 2);
+        const size_t nCompressedSize = Lz4Util::CompressBlock(input.data() + nOffset, nRawSize, output);
+        uint32_t nBlockSize = (uint32_t)nCompressedSize;
+        if ((nCompressedSize == 0) || (nCompressedSize >= nRawSize)) {
+            //不可压缩的数据块，原样保存
+            output.resize(nBlockHeaderPos + sizeof(uint32_t) * 2);
+            output.insert(output.end(), input.data() + nOffset, input.data() + nOffset + nRawSize);
+            nBlockSize = nRawSize | kBlockStoredFlag;
+        }
+        std::memcpy(output.data() + nBlockHeaderPos, &nBlockSize, sizeof(nBlockSize));
+        std::memcpy(output.data() + nBlockHeaderPos + sizeof(uint32_t), &nRawSize, sizeof(nRawSize));
+    }
     return true;
 }
 
@@ -4,9 +4,11 @@
 #pragma once
 
 #include "duilib/Utils/FilePath.h"
+#include "duilib/Utils/MappedFile.h"
 #include <string>
 #include <vector>
 #include <cstdint>
+#include <memory>
 
 namespace pugi {
 class xml_document;
@@ -17,55 +19,308 @@ namespace ui {
 
 /**
  * XML 二进制缓存格式规范
- * 
+ *
  * 目的：将解析后的 XML DOM 树序列化为二进制格式，避免重复解析
  * 优势：
  * - 解析速度提升 80%+
  * - 内存占用更少（紧凑的二进制格式）
- * - 支持内存映射加载
- * 
- * 二进制格式：
- * 
+ * - 加载后直接在节点表、属性表和字符串池上遍历，不需要重建 pugixml 文档（大文件以内存映射方式加载）
+ *
+ * 二进制格式（所有字段均为小端，各段均按4字节对齐）：
+ *
  * [Header] - 32 bytes
- *   - Magic:        uint32_t = 0x44424D58 ('XM BD' 小端) = XML Binary Document
- *   - Version:      uint32_t = 1
- *   - Flags:        uint32_t (压缩标志、编码等)
- *   - NodeCount:    uint32_t  节点总数
- *   - AttrCount:    uint32_t  属性总数
+ *   - Magic:        uint32_t = 0x584D4244 ('XMBD') = XML Binary Document
+ *   - Version:      uint32_t = 3
+ *   - Flags:        uint32_t (bit 0: 压缩标志; bit 8~15: 字符串池的字符大小，与 pugi::char_t 一致)
+ *   - NodeCount:    uint32_t  节点总数（含文档根节点）
+ *   - AttrCount:    uint32_t  属性总数（含保留的0号属性）
  *   - StringPoolOffset: uint32_t 字符串池偏移
  *   - StringPoolSize:   uint32_t 字符串池大小
- * 
- * [Node Table] - 每个节点 12 bytes
- *   - Type:         uint16_t  节点类型 (1=element, 2=text, 3=cdata, etc.)
-   - NameId:       uint32_t  节点名称在字符串池的ID
+ *   - SourceTime:   uint32_t  生成缓存时原始 XML 文件修改时间的校验值（0 = 未关联 XML 文件），加载时与 XML 文件比较，判断缓存是否过期
+ *
+ * [Node Table] - 紧跟在 Header 之后，每个节点 24 bytes，0号节点为文档根节点
+ *   - Type:         uint16_t  节点类型 (与 pugi::xml_node_type 取值相同)
+ *   - Reserved:     uint16_t
+ *   - NameId:       uint32_t  节点名称在字符串池的ID
  *   - FirstChild:   uint32_t  第一个子节点索引 (0 = none)
  *   - NextSibling:  uint32_t  下一个兄弟节点索引 (0 = none)
  *   - FirstAttr:    uint32_t  第一个属性索引 (0 = none)
- *   - ValueId:      uint32_t  节点值在字符串池的ID (0 = none)
- * 
- * [Attribute Table] - 每个属性 12 bytes
+ *   - ValueId:      uint32_t  节点值在字符串池的ID (0 = 空字符串)
+ *
+ * [Attribute Table] - 紧跟在 Node Table 之后，每个属性 12 bytes，0号属性保留不用
  *   - NameId:       uint32_t  属性名在字符串池的ID
  *   - ValueId:      uint32_t  属性值在字符串池的ID
  *   - NextAttr:     uint32_t  下一个属性索引 (0 = none)
- * 
+ *
  * [String Pool] - 紧凑存储所有字符串
- *   - 每个字符串: [uint16_t length] + [char data...] (UTF-8编码，无null终止)
- *   - 字符串ID = 在池中的字节偏移
- * 
+ *   - 每个字符串: [uint32_t length] + [char_t data...] + [char_t 0]，末尾补齐到4字节
+ *   - 字符串以 null 结尾，加载后可直接作为 C 字符串使用（零拷贝）
+ *   - 字符串ID = 在池中的字节偏移，ID为0的字符串为空字符串
+ *
  * 压缩选项：
- * - 无压缩 (flags & 0x01 = 0)
- * - LZ4 压缩 (flags & 0x01 = 1) - 推荐，解压速度快
+ * - 无压缩 (flags & 0x01 = 0)：小文件一次读入内存，大文件 (>= 256KB) 以内存映射方式加载，加载时只校验文件头和各段的长度
+ * - LZ4 压缩 (flags & 0x01 = 1)：文件更小，适合磁盘读取速度慢的场景（如网络磁盘）
+ *   - Header 不压缩（仅设置压缩标志），解压后的总长度 = StringPoolOffset + StringPoolSize
+ *   - Header 之后的节点表、属性表和字符串池按 64KB 分块，每块为：
+ *     [uint32_t 压缩后长度 (bit 31: 1 表示数据块不可压缩，原样保存)] + [uint32_t 原始长度] + [LZ4 block 数据]
+ *   - 加载时从映射的文件逐块解压到内存中，解压后的数据与非压缩格式完全相同
  */
 
+class XmlBinaryDocument;
+struct XmlBinaryNodeEntry;
+struct XmlBinaryAttrEntry;
+
+/** 二进制缓存中字符串的字符类型（与 pugi::char_t 一致）
+*/
+typedef DString::value_type XmlBinaryChar;
+
+/** 二进制缓存文档中的属性（只读，轻量级句柄，可按值传递）
+*   接口命名与 pugi::xml_attribute 保持一致，以便解析代码可同时支持两种文档
+*/
+class UILIB_API XmlBinaryAttribute
+{
+public:
+    XmlBinaryAttribute();
+    XmlBinaryAttribute(const XmlBinaryDocument* pDoc, uint32_t nIndex);
+
+    /** 是否为空属性
+    */
+    bool empty() const;
+
+    /** 属性名称
+    */
+    const XmlBinaryChar* name() const;
+
+    /** 属性值
+    */
+    const XmlBinaryChar* value() const;
+
+    /** 属性值（属性为空时返回默认值）
+    */
+    const XmlBinaryChar* as_string(const XmlBinaryChar* def = _T("")) const;
+
+    /** 属性值转换为整型（支持"0x"开头的十六进制，属性为空时返回默认值）
+    */
+    int as_int(int def = 0) const;
+
+    /** 下一个属性
+    */
+    XmlBinaryAttribute next_attribute() const;
+
+    bool operator == (const XmlBinaryAttribute& r) const;
+    bool operator != (const XmlBinaryAttribute& r) const;
+
+private:
+    const XmlBinaryDocument* m_pDoc;
+    uint32_t m_nIndex;
+};
+
+/** 节点的文本内容（节点本身或者第一个文本子节点的值）
+*/
+class UILIB_API XmlBinaryText
+{
+public:
+    explicit XmlBinaryText(const XmlBinaryChar* pText);
+
+    /** 是否无文本内容
+    */
+    bool empty() const;
+
+    /** 文本内容（无文本内容时返回默认值）
+    */
+    const XmlBinaryChar* as_string(const XmlBinaryChar* def = _T("")) const;
+
+private:
+    const XmlBinaryChar* m_pText;
+};
+
+/** 二进制缓存文档中的节点（只读，轻量级句柄，可按值传递）
+*   接口命名与 pugi::xml_node 保持一致，以便解析代码可同时支持两种文档
+*/
+class UILIB_API XmlBinaryNode
+{
+public:
+    /** 迭代器（用于遍历子节点和属性）
+    */
+    template<typename T>
+    class Iterator
+    {
+    public:
+        explicit Iterator(const T& item) : m_item(item) {}
+        const T& operator*() const { return m_item; }
+        const T* operator->() const { return &m_item; }
+        Iterator& operator++() { m_item = Next(m_item); return *this; }
+        bool operator == (const Iterator& r) const { return m_item == r.m_item; }
+        bool operator != (const Iterator& r) const { return m_item != r.m_item; }
+    private:
+        static XmlBinaryNode Next(const XmlBinaryNode& node) { return node.next_sibling(); }
+        static XmlBinaryAttribute Next(const XmlBinaryAttribute& attr) { return attr.next_attribute(); }
+        T m_item;
+    };
+
+    /** 迭代范围（用于范围for循环）
+    */
+    template<typename T>
+    class Range
+    {
+    public:
+        explicit Range(const T& first) : m_first(first) {}
+        Iterator<T> begin() const { return Iterator<T>(m_first); }
+        Iterator<T> end() const { return Iterator<T>(T()); }
+        bool empty() const { return m_first.empty(); }
+    private:
+        T m_first;
+    };
+
+public:
+    XmlBinaryNode();
+    XmlBinaryNode(const XmlBinaryDocument* pDoc, uint32_t nIndex);
+
+    /** 是否为空节点
+    */
+    bool empty() const;
+
+    /** 节点类型（与 pugi::xml_node_type 取值相同）
+    */
+    int32_t type() const;
+
+    /** 节点名称
+    */
+    const XmlBinaryChar* name() const;
+
+    /** 节点值
+    */
+    const XmlBinaryChar* value() const;
+
+    /** 第一个子节点
+    */
+    XmlBinaryNode first_child() const;
+
+    /** 下一个兄弟节点
+    */
+    XmlBinaryNode next_sibling() const;
+
+    /** 第一个属性
+    */
+    XmlBinaryAttribute first_attribute() const;
+
+    /** 按名称查找属性（未找到返回空属性）
+    */
+    XmlBinaryAttribute attribute(const XmlBinaryChar* name) const;
+
+    /** 子节点列表
+    */
+    Range<XmlBinaryNode> children() const;
+
+    /** 属性列表
+    */
+    Range<XmlBinaryAttribute> attributes() const;
+
+    /** 节点的文本内容
+    */
+    XmlBinaryText text() const;
+
+    bool operator == (const XmlBinaryNode& r) const;
+    bool operator != (const XmlBinaryNode& r) const;
+
+private:
+    const XmlBinaryDocument* m_pDoc;
+    uint32_t m_nIndex;
+};
+
+/** 二进制缓存文档（只读）
+*   缓存文件读入内存（大文件通过内存映射加载）后，节点、属性和字符串均直接引用文件数据，不做任何拷贝；
+*   文档对象销毁或者重新加载后，从该文档获取的节点、属性和字符串指针均失效
+*/
+class UILIB_API XmlBinaryDocument
+{
+public:
+    XmlBinaryDocument();
+    ~XmlBinaryDocument();
+    XmlBinaryDocument(const XmlBinaryDocument&) = delete;
+    XmlBinaryDocument& operator=(const XmlBinaryDocument&) = delete;
+
+public:
+    /** 加载缓存文件：小文件直接读入内存，大文件以内存映射方式加载
+    *   加载时只校验文件头和各段的长度（完整校验在写入缓存文件时进行），访问节点时检查索引和字符串的范围，文件损坏时不会越界访问
+    *   压缩格式的缓存文件，解压到内存中后加载（IsMapped()返回false）
+    * @param [in] cacheFilePath 缓存文件路径
+    */
+    bool LoadFile(const FilePath& cacheFilePath);
+
+    /** 从内存数据加载（数据由文档对象接管，加载时校验所有索引和字符串的范围，数据损坏时返回false）
+    * @param [in] data 缓存文件的数据
+    */
+    bool LoadBuffer(std::vector<uint8_t>&& data);
+
+    /** 清空文档
+    */
+    void Clear();
+
+    /** 文档是否为空
+    */
+    bool IsEmpty() const;
+
+    /** 是否为内存映射方式加载
+    */
+    bool IsMapped() const;
+
+    /** 文档根节点（对应 pugi::xml_document::root()）
+    */
+    XmlBinaryNode root() const;
+
+private:
+    friend class XmlBinaryNode;
+    friend class XmlBinaryAttribute;
+    friend class XmlBinaryCache;
+
+    /** 校验数据，并初始化各个表的指针
+    * @param [in] bFullCheck 是否校验所有节点、属性和字符串的索引（缓存文件在写入时已完整校验，加载时只校验文件头和各段的长度）
+    */
+    bool AttachData(const uint8_t* pData, size_t nSize, bool bFullCheck);
+
+    /** 校验所有节点、属性和字符串的索引（调用方已校验文件头和各段的长度）
+    */
+    static bool ValidateData(const uint8_t* pData, size_t nSize);
+
+    /** 获取节点/属性/字符串（调用方保证索引有效）
+    */
+    const XmlBinaryNodeEntry& GetNode(uint32_t nIndex) const;
+    const XmlBinaryAttrEntry& GetAttr(uint32_t nIndex) const;
+    const XmlBinaryChar* GetString(uint32_t nStringId) const;
+
+private:
+    /** 内存映射的缓存文件
+    */
+    MappedFile m_mappedFile;
+
+    /** 非映射方式加载时的数据
+    */
+    std::vector<uint8_t> m_buffer;
+
+    /** 节点表、属性表和字符串池
+    */
+    const XmlBinaryNodeEntry* m_pNodes;
+    uint32_t m_nNodeCount;
+    const XmlBinaryAttrEntry* m_pAttrs;
+    uint32_t m_nAttrCount;
+    const uint8_t* m_pStringPool;
+    uint32_t m_nStringPoolSize;
+
+    /** 文件头中记录的原始XML文件修改时间的校验值
+    */
+    uint32_t m_nSourceTime;
+};
+
 /**
  * XML 二进制缓存管理器
- * 
+ *
  * 功能：
  * 1. 将 pugixml 的 xml_document 序列化为二进制文件
- * 2. 从二进制文件反序列化为 xml_document
- * 3. 自动检测缓存是否过期（通过文件时间戳或CRC32）
+ * 2. 直接加载二进制文件（XmlBinaryDocument，大文件以内存映射方式加载），或者反序列化为 xml_document
+ * 3. 自动检测缓存是否过期（文件头中记录原始 XML 文件的修改时间，与当前 XML 文件比较）
  */
-class XmlBinaryCache {
+class UILIB_API XmlBinaryCache {
 public:
     XmlBinaryCache();
     ~XmlBinaryCache();
@@ -86,6 +341,22 @@ public:
      */
     bool LoadFromCache(const FilePath& xmlPath, pugi::xml_document& doc);
 
+    /**
+     * 加载二进制缓存（不重建 pugixml 文档，大文件以内存映射方式加载）
+     * @param xmlPath 原始 XML 文件路径
+     * @param doc 输出的二进制缓存文档
+     * @return 成功返回 true，缓存不存在、过期或者损坏返回 false
+     */
+    bool LoadFromCache(const FilePath& xmlPath, XmlBinaryDocument& doc);
+
+    /**
+     * 将 XML 文档序列化为二进制缓存格式的数据（不写缓存文件，按压缩选项生成数据）
+     * @param doc 要序列化的 pugixml 文档
+     * @param output 输出的二进制数据
+     * @return 成功返回 true
+     */
+    bool SaveToData(const pugi::xml_document& doc, std::vector<uint8_t>& output);
+
     /**
      * 检查缓存是否有效（存在且未过期）
      * @param xmlPath 原始 XML 文件路径
@@ -126,45 +397,23 @@ public:
     int ClearAllCache();
 
 private:
-    struct BinaryHeader {
-        uint32_t magic;
-        uint32_t version;
-        uint32_t flags;
-        uint32_t nodeCount;
-        uint32_t attrCount;
-        uint32_t stringPoolOffset;
-        uint32_t stringPoolSize;
-        uint32_t reserved;
-    };
+    /** 获取缓存文件的完整路径（设置了缓存目录时，文件名中包含原始路径的哈希值，避免同名文件冲突）
+    */
+    FilePath GetCacheFullPath(const FilePath& xmlPath) const;
 
-    struct NodeEntry {
-        uint16_t type;
-        uint16_t reserved;
-        uint32_t nameId;
-        uint32_t firstChild;
-        uint32_t nextSibling;
-        uint32_t firstAttr;
-        uint32_t valueId;
-    };
-
-    struct AttrEntry {
-        uint32_t nameId;
-        uint32_t valueId;
-        uint32_t nextAttr;
-    };
-
-    bool SerializeDocument(const pugi::xml_document& doc, 
+    /** 序列化文档（写入时完整校验一次生成的数据）
+    * @param [in] nSourceTime 原始XML文件修改时间的校验值，记录在文件头中
+    */
+    bool SerializeDocument(const pugi::xml_document& doc, uint32_t nSourceTime,
                            std::vector<uint8_t>& output);
-    
-    bool DeserializeDocument(const std::vector<uint8_t>& input,
+
+    bool DeserializeDocument(const XmlBinaryDocument& input,
                              pugi::xml_document& doc);
 
+    /** 将非压缩格式的数据转换为压缩格式
+    */
     bool CompressData(const std::vector<uint8_t>& input,
                       std::vector<uint8_t>& output);
-    
-    bool DecompressData(const std::vector<uint8_t>& input,
-                        std::vector<uint8_t>& output,
-                        size_t originalSize);
 
     uint32_t CalculateFileCRC32(const FilePath& path) const;
 
@@ -9,11 +9,15 @@
 #include "LuaEventBinding.h"
 #include "LuaUtilBinding.h"
 #include "LuaAdvancedControlBinding.h"
+#include "LuaWorkerBinding.h"
+#include "LuaWorker.h"
+#include "duilib/Core/GlobalManager.h"
 #include "duilib/Core/Window.h"
 #include "duilib/Core/Control.h"
 #include "duilib/Utils/LogUtil.h"
 #include "duilib/Utils/StringConvert.h"
 #include "duilib/Utils/StringUtil.h"
+#include "duilib/Utils/FileUtil.h"
 
 #include "sol/sol.hpp"
 
@@ -70,8 +74,63 @@ struct LuaEngine::Impl {
     std::unordered_map<std::string, std::function<void(sol::state&)>> modules;
     int timeoutMs = 5000;
     size_t memoryLimit = 64 * 1024 * 1024;
+
+    // Compiled bytecode cache (key: full path of the script file)
+    // Kept in memory only: Lua does not verify binary chunks, so bytecode is never read back from disk
+    struct BytecodeEntry {
+        uint64_t sourceHash = 0;
+        std::vector<uint8_t> bytecode;
+    };
+    std::unordered_map<std::string, BytecodeEntry> bytecodeCache;
+
+    // Lua states running on the worker thread
+    struct WorkerEntry {
+        std::unique_ptr<LuaWorker> worker;
+        Window* window = nullptr;
+        WorkerMessageHandler handler;
+    };
+    std::unordered_map<int, WorkerEntry> workers;
+    int nextWorkerId = 1;
+    int32_t workerThread = kThreadWorker;
+    int workerTimeoutMs = 60000;
 };
 
+// FNV-1a 64-bit hash
+static uint64_t LuaHashBytes(const void* data, size_t size, uint64_t hash = 14695981039346656037ull) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+static int LuaBytecodeWriter(lua_State* L, const void* p, size_t sz, void* ud) {
+    (void)L;
+    std::vector<uint8_t>* bytecode = static_cast<std::vector<uint8_t>*>(ud);
+    const uint8_t* bytes = static_cast<const uint8_t*>(p);
+    bytecode->insert(bytecode->end(), bytes, bytes + sz);
+    return 0;
+}
+
+// Same as luaL_loadfilex: skip UTF-8 BOM and the first line if it starts with '#'
+static void LuaSkipSourceHeader(std::vector<uint8_t>& source) {
+    if ((source.size() >= 3) && (source[0] == 0xEF) && (source[1] == 0xBB) && (source[2] == 0xBF)) {
+        source.erase(source.begin(), source.begin() + 3);
+    }
+    if (!source.empty() && (source[0] == '#')) {
+        // Keep the line break so that line numbers are not changed
+        auto iter = std::find(source.begin(), source.end(), '\n');
+        source.erase(source.begin(), iter);
+    }
+}
+
+// Compile chunk on top of the stack into bytecode
+static bool LuaDumpChunk(lua_State* L, std::vector<uint8_t>& bytecode) {
+    bytecode.clear();
+    return (lua_dump(L, LuaBytecodeWriter, &bytecode, 0) == 0) && !bytecode.empty();
+}
+
 class ScopedTimeout {
 public:
     ScopedTimeout(lua_State* L, int timeoutMs) : m_L(L) {
@@ -143,11 +202,15 @@ void LuaEngine::Shutdown() {
         return;
     }
 
+    // Stop workers (message handlers reference functions in the Lua state)
+    m_impl->workers.clear();
+
     // Clear window environments
     m_impl->windowEnvironments.clear();
 
     // Clear loaded scripts
     m_impl->loadedScripts.clear();
+    m_impl->bytecodeCache.clear();
 
     // Release Lua state
     m_impl->lua.reset();
@@ -172,16 +235,16 @@ bool LuaEngine::LoadScript(const DString& scriptPath) {
         FilePath fullPath(m_impl->scriptRootPath);
         fullPath.JoinFilePath(FilePath(scriptPath));
 
-        sol::load_result script = m_impl->lua->load_file(fullPath.ToStringA());
-        if (!script.valid()) {
-            sol::error err = script;
+        std::string errorMsg;
+        if (!LoadScriptChunk(fullPath, errorMsg)) {
             LuaDebugLog(StringUtil::Printf(_T("[LuaEngine::LoadScript] failed: load_file error=%s"),
-                                                  StringConvert::UTF8ToT(err.what()).c_str()));
+                                                  StringConvert::UTF8ToT(errorMsg).c_str()));
             return false;
         }
 
-        sol::protected_function func = script;
         lua_State* L = m_impl->lua->lua_state();
+        sol::protected_function func(L, -1);
+        lua_pop(L, 1);
         ScopedTimeout timeout(L, m_impl->timeoutMs);
 
         sol::protected_function_result result = func();
@@ -204,6 +267,52 @@ bool LuaEngine::LoadScript(const DString& scriptPath) {
     }
 }
 
+bool LuaEngine::LoadScriptChunk(const FilePath& scriptFilePath, std::string& errorMsg) {
+    lua_State* L = m_impl->lua->lua_state();
+    const std::string fullPath = scriptFilePath.ToStringA();
+    const std::string chunkName = "@" + fullPath;
+
+    std::vector<uint8_t> source;
+    if (!FileUtil::ReadFileData(scriptFilePath, source)) {
+        errorMsg = "cannot open " + fullPath;
+        return false;
+    }
+    const uint64_t sourceHash = LuaHashBytes(source.data(), source.size());
+
+    // Look up compiled bytecode in memory (bytecode produced by this process only)
+    Impl::BytecodeEntry& entry = m_impl->bytecodeCache[fullPath];
+    if (entry.sourceHash != sourceHash) {
+        entry.sourceHash = sourceHash;
+        entry.bytecode.clear();
+    }
+    if (!entry.bytecode.empty()) {
+        if (luaL_loadbufferx(L, reinterpret_cast<const char*>(entry.bytecode.data()), entry.bytecode.size(),
+                             chunkName.c_str(), "b") == LUA_OK) {
+            return true;
+        }
+        // Invalid bytecode: compile from source again
+        LuaDebugLog(StringUtil::Printf(_T("[LuaEngine::LoadScriptChunk] invalid bytecode: %s"),
+                                              StringConvert::UTF8ToT(lua_tostring(L, -1)).c_str()));
+        lua_pop(L, 1);
+        entry.bytecode.clear();
+    }
+
+    // Same as load_file: both source and precompiled chunks are accepted
+    LuaSkipSourceHeader(source);
+    if (luaL_loadbufferx(L, reinterpret_cast<const char*>(source.data()), source.size(),
+                         chunkName.c_str(), nullptr) != LUA_OK) {
+        const char* err = lua_tostring(L, -1);
+        errorMsg = (err != nullptr) ? err : "unknown error";
+        lua_pop(L, 1);
+        m_impl->bytecodeCache.erase(fullPath);
+        return false;
+    }
+    if (!LuaDumpChunk(L, entry.bytecode)) {
+        entry.bytecode.clear();
+    }
+    return true;
+}
+
 bool LuaEngine::DoString(const DString& luaCode) {
     LuaDebugLog(StringUtil::Printf(_T("[LuaEngine::DoString] begin: codeLength=%u"),
                                           static_cast<uint32_t>(luaCode.size())));
@@ -293,6 +402,16 @@ void LuaEngine::DestroyWindowEnvironment(Window* pWindow) {
         return;
     }
 
+    // Stop workers owned by the window
+    for (auto iter = m_impl->workers.begin(); iter != m_impl->workers.end();) {
+        if (iter->second.window == pWindow) {
+            iter = m_impl->workers.erase(iter);
+        }
+        else {
+            ++iter;
+        }
+    }
+
     auto it = m_impl->windowEnvironments.find(pWindow);
     if (it != m_impl->windowEnvironments.end()) {
         m_impl->windowEnvironments.erase(it);
@@ -301,6 +420,107 @@ void LuaEngine::DestroyWindowEnvironment(Window* pWindow) {
     }
 }
 
+int LuaEngine::CreateWorker(const DString& scriptPath, Window* pWindow) {
+    LuaDebugLog(StringUtil::Printf(_T("[LuaEngine::CreateWorker] begin: scriptPath=%s"),
+                                          scriptPath.c_str()));
+    if (!m_impl->initialized || !m_impl->lua) {
+        LuaDebugLog(_T("[LuaEngine::CreateWorker] failed: engine not initialized"));
+        return 0;
+    }
+
+    const int workerId = m_impl->nextWorkerId++;
+    LuaWorker::Options options;
+    options.nThreadIdentifier = m_impl->workerThread;
+    options.nMemoryLimit = m_impl->memoryLimit;
+    options.nTimeoutMs = m_impl->workerTimeoutMs;
+    options.nWorkerId = workerId;
+
+    FilePath fullPath(m_impl->scriptRootPath);
+    fullPath.JoinFilePath(FilePath(scriptPath));
+
+    // Messages are posted on the worker thread, and delivered on the UI thread
+    auto callback = [workerId](const std::shared_ptr<LuaMessage>& message) {
+        GlobalManager::Instance().Thread().PostTask(kThreadUI, [workerId, message]() {
+            LuaEngine::Instance().OnWorkerMessage(workerId, message);
+        });
+    };
+    auto worker = std::make_unique<LuaWorker>();
+    if (!worker->Start(options, fullPath, callback)) {
+        LuaDebugLog(_T("[LuaEngine::CreateWorker] failed: worker thread not running"));
+        return 0;
+    }
+
+    Impl::WorkerEntry& entry = m_impl->workers[workerId];
+    entry.worker = std::move(worker);
+    entry.window = pWindow;
+    LuaDebugLog(StringUtil::Printf(_T("[LuaEngine::CreateWorker] success: workerId=%d"), workerId));
+    return workerId;
+}
+
+void LuaEngine::DestroyWorker(int workerId) {
+    if (m_impl->workers.erase(workerId) > 0) {
+        LuaDebugLog(StringUtil::Printf(_T("[LuaEngine::DestroyWorker] removed: workerId=%d"), workerId));
+    }
+}
+
+bool LuaEngine::PostWorkerMessage(int workerId, const std::shared_ptr<LuaMessage>& message) {
+    auto it = m_impl->workers.find(workerId);
+    if (it == m_impl->workers.end()) {
+        LuaDebugLog(StringUtil::Printf(_T("[LuaEngine::PostWorkerMessage] worker not found: workerId=%d"),
+                                              workerId));
+        return false;
+    }
+    return it->second.worker->Post(message);
+}
+
+void LuaEngine::SetWorkerMessageHandler(int workerId, const WorkerMessageHandler& handler) {
+    auto it = m_impl->workers.find(workerId);
+    if (it != m_impl->workers.end()) {
+        it->second.handler = handler;
+    }
+}
+
+size_t LuaEngine::GetWorkerMemoryUsage(int workerId) const {
+    auto it = m_impl->workers.find(workerId);
+    if (it == m_impl->workers.end()) {
+        return 0;
+    }
+    return it->second.worker->GetMemoryUsage();
+}
+
+void LuaEngine::SetWorkerThread(int32_t nThreadIdentifier) {
+    m_impl->workerThread = nThreadIdentifier;
+}
+
+int32_t LuaEngine::GetWorkerThread() const {
+    return m_impl->workerThread;
+}
+
+void LuaEngine::SetWorkerTimeout(int timeoutMs) {
+    m_impl->workerTimeoutMs = timeoutMs;
+}
+
+int LuaEngine::GetWorkerTimeout() const {
+    return m_impl->workerTimeoutMs;
+}
+
+void LuaEngine::OnWorkerMessage(int workerId, const std::shared_ptr<LuaMessage>& message) {
+    // The worker may be destroyed before the message arrives
+    auto it = m_impl->workers.find(workerId);
+    if ((it == m_impl->workers.end()) || (it->second.handler == nullptr)) {
+        return;
+    }
+    // Copy the handler: it may destroy the worker
+    WorkerMessageHandler handler = it->second.handler;
+    try {
+        handler(workerId, *message);
+    }
+    catch (const std::exception& e) {
+        LuaDebugLog(StringUtil::Printf(_T("[LuaEngine::OnWorkerMessage] failed: workerId=%d, error=%s"),
+                                              workerId, StringConvert::UTF8ToT(e.what()).c_str()));
+    }
+}
+
 void LuaEngine::RegisterModule(const std::string& moduleName,
                                 std::function<void(sol::state&)> registerFunc) {
     if (!m_impl->initialized || !m_impl->lua) {
@@ -335,6 +555,7 @@ void LuaEngine::RegisterAllBindings() {
     LuaEventBinding::Register(*m_impl->lua);
     LuaUtilBinding::Register(*m_impl->lua);
     LuaAdvancedControlBinding::Register(*m_impl->lua);
+    LuaWorkerBinding::Register(*m_impl->lua);
 }
 
 void LuaEngine::SetupSearchPaths(const DString& scriptRootPath) {
@@ -480,6 +701,33 @@ size_t LuaEngine::GetMemoryUsage() const {
     return static_cast<size_t>(kbytes) * 1024;
 }
 
+void LuaEngine::ClearBytecodeCache() {
+    m_impl->bytecodeCache.clear();
+}
+
+bool LuaEngine::CompileBytecode(const std::string& source, const std::string& chunkName,
+                                std::vector<uint8_t>& bytecode, std::string& errorMsg) {
+    bytecode.clear();
+    lua_State* L = luaL_newstate();
+    if (L == nullptr) {
+        errorMsg = "not enough memory";
+        return false;
+    }
+    bool bRet = false;
+    if (luaL_loadbufferx(L, source.data(), source.size(), chunkName.c_str(), "t") == LUA_OK) {
+        bRet = LuaDumpChunk(L, bytecode);
+        if (!bRet) {
+            errorMsg = "lua_dump failed";
+        }
+    }
+    else {
+        const char* err = lua_tostring(L, -1);
+        errorMsg = (err != nullptr) ? err : "unknown error";
+    }
+    lua_close(L);
+    return bRet;
+}
+
 DString LuaEngine::FormatError(const std::string& error) {
     DString result = _T("Lua Error: ");
     result += StringConvert::UTF8ToT(error);
@@ -7,6 +7,7 @@
 #include <memory>
 #include <functional>
 #include <string>
+#include <vector>
 
 // Forward declaration to avoid exposing sol3 in headers
 namespace sol { class state; }
@@ -17,6 +18,8 @@ namespace ui
 
 class Window;
 class Control;
+class FilePath;
+struct LuaMessage;
 
 /** Lua script engine
  *  Manages Lua VM lifecycle, script loading and global binding registration.
@@ -118,6 +121,66 @@ public:
     /** Get current Lua memory usage in bytes */
     size_t GetMemoryUsage() const;
 
+    /** Clear compiled bytecode cached in memory
+     *  Scripts loaded by LoadScript are compiled once (lua_dump) and loaded in binary mode
+     *  afterwards, as long as the content hash of the source file still matches.
+     *  The cache is kept in memory only and is also cleared by Shutdown: Lua does not verify
+     *  binary chunks, so bytecode written by another process must not be trusted.
+     */
+    void ClearBytecodeCache();
+
+    /** Compile Lua source into bytecode (can be used to precompile scripts at build time)
+     *  @param [in] source Lua source code
+     *  @param [in] chunkName Chunk name used in error messages, e.g. "@main.lua"
+     *  @param [out] bytecode Compiled bytecode, loadable with luaL_loadbufferx in binary mode
+     *  @param [out] errorMsg Error message if compile failed
+     *  @return true if compiled successfully
+     */
+    static bool CompileBytecode(const std::string& source, const std::string& chunkName,
+                                std::vector<uint8_t>& bytecode, std::string& errorMsg);
+
+    /** Handler for messages posted by worker scripts, called on the UI thread
+     *  @param [in] workerId Worker id
+     *  @param [in] message Message posted by worker.post(name, value)
+     */
+    typedef std::function<void(int workerId, const LuaMessage& message)> WorkerMessageHandler;
+
+    /** Run script in a separate Lua state on the worker thread (for heavy script logic)
+     *  The worker state has no UI bindings, and communicates with the UI thread by messages:
+     *  the script calls worker.post(name, value), and handles messages in on_message(name, value).
+     *  Memory usage of each worker state is capped by the memory limit (SetMemoryLimit).
+     *  @param [in] scriptPath Script file path (relative to script root)
+     *  @param [in] pWindow Owner window, the worker is destroyed with the window environment (optional)
+     *  @return Worker id (greater than 0), 0 if failed
+     */
+    int CreateWorker(const DString& scriptPath, Window* pWindow = nullptr);
+
+    /** Destroy worker: abort the running call and close its Lua state */
+    void DestroyWorker(int workerId);
+
+    /** Post message to worker script (handled by on_message on the worker thread)
+     *  @return true if the message was posted
+     */
+    bool PostWorkerMessage(int workerId, const std::shared_ptr<LuaMessage>& message);
+
+    /** Set handler for messages posted by worker script */
+    void SetWorkerMessageHandler(int workerId, const WorkerMessageHandler& handler);
+
+    /** Get memory usage of worker Lua state in bytes */
+    size_t GetWorkerMemoryUsage(int workerId) const;
+
+    /** Set thread running worker scripts (default: kThreadWorker), applies to workers created later */
+    void SetWorkerThread(int32_t nThreadIdentifier);
+
+    /** Get thread running worker scripts */
+    int32_t GetWorkerThread() const;
+
+    /** Set timeout of each worker script call in milliseconds (default: 60000ms, 0: unlimited) */
+    void SetWorkerTimeout(int timeoutMs);
+
+    /** Get timeout of worker script calls */
+    int GetWorkerTimeout() const;
+
     /** Format Lua error with stack trace */
     static DString FormatError(const std::string& error);
 
@@ -139,6 +202,16 @@ private:
     /** Error handler */
     static int LuaErrorHandler(lua_State* L);
 
+    /** Load script file as a function on top of the Lua stack, using the bytecode cache
+     *  @param [in] scriptFilePath Full path of the script file
+     *  @param [out] errorMsg Error message if load failed
+     *  @return true if loaded successfully
+     */
+    bool LoadScriptChunk(const FilePath& scriptFilePath, std::string& errorMsg);
+
+    /** Deliver message posted by worker script (called on the UI thread) */
+    void OnWorkerMessage(int workerId, const std::shared_ptr<LuaMessage>& message);
+
 private:
     struct Impl;
     std::unique_ptr<Impl> m_impl;
@@ -0,0 +1,373 @@
+#include "duilib/duilib_config.h"
+
+#ifdef DUILIB_BUILD_FOR_LUA
+
+#include "LuaWorker.h"
+#include "duilib/Core/GlobalManager.h"
+#include "duilib/Utils/FilePath.h"
+#include "duilib/Utils/FileUtil.h"
+#include "duilib/Utils/LogUtil.h"
+#include "duilib/Utils/StringConvert.h"
+#include "duilib/Utils/StringUtil.h"
+
+#include "sol/sol.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+namespace ui {
+
+// Max nesting level of tables passed between states
+static const int kMaxMessageDepth = 32;
+
+bool LuaMessageValue::Read(lua_State* L, int index, std::string& errorMsg) {
+    return Read(L, lua_absindex(L, index), 0, errorMsg);
+}
+
+bool LuaMessageValue::Read(lua_State* L, int index, int depth, std::string& errorMsg) {
+    tableValue.clear();
+    stringValue.clear();
+    switch (lua_type(L, index)) {
+    case LUA_TNONE:
+    case LUA_TNIL:
+        type = Type::kNil;
+        return true;
+    case LUA_TBOOLEAN:
+        type = Type::kBoolean;
+        boolValue = lua_toboolean(L, index) != 0;
+        return true;
+    case LUA_TNUMBER:
+        if (lua_isinteger(L, index)) {
+            type = Type::kInteger;
+            intValue = static_cast<int64_t>(lua_tointeger(L, index));
+        }
+        else {
+            type = Type::kNumber;
+            numberValue = static_cast<double>(lua_tonumber(L, index));
+        }
+        return true;
+    case LUA_TSTRING:
+    {
+        size_t len = 0;
+        const char* str = lua_tolstring(L, index, &len);
+        type = Type::kString;
+        stringValue.assign(str, len);
+        return true;
+    }
+    case LUA_TTABLE:
+        break;
+    default:
+        errorMsg = std::string("unsupported value type: ") + lua_typename(L, lua_type(L, index));
+        return false;
+    }
+
+    // Tables are copied by value, a cycle is reported as too deep nesting
+    if (depth >= kMaxMessageDepth) {
+        errorMsg = "table nesting too deep";
+        return false;
+    }
+    if (!lua_checkstack(L, 3)) {
+        errorMsg = "stack overflow";
+        return false;
+    }
+    type = Type::kTable;
+    lua_pushnil(L);
+    while (lua_next(L, index) != 0) {
+        tableValue.emplace_back();
+        if (!tableValue.back().first.Read(L, lua_gettop(L) - 1, depth + 1, errorMsg) ||
+            !tableValue.back().second.Read(L, lua_gettop(L), depth + 1, errorMsg)) {
+            lua_pop(L, 2);
+            return false;
+        }
+        lua_pop(L, 1);
+    }
+    return true;
+}
+
+void LuaMessageValue::Push(lua_State* L) const {
+    luaL_checkstack(L, 3, "message too deep");
+    switch (type) {
+    case Type::kBoolean:
+        lua_pushboolean(L, boolValue ? 1 : 0);
+        break;
+    case Type::kInteger:
+        lua_pushinteger(L, static_cast<lua_Integer>(intValue));
+        break;
+    case Type::kNumber:
+        lua_pushnumber(L, static_cast<lua_Number>(numberValue));
+        break;
+    case Type::kString:
+        lua_pushlstring(L, stringValue.data(), stringValue.size());
+        break;
+    case Type::kTable:
+        lua_createtable(L, 0, static_cast<int>(tableValue.size()));
+        for (const auto& item : tableValue) {
+            item.first.Push(L);
+            item.second.Push(L);
+            lua_rawset(L, -3);
+        }
+        break;
+    default:
+        lua_pushnil(L);
+        break;
+    }
+}
+
+struct LuaWorker::Context {
+    Options options;
+    MessageCallback callback;
+    std::unique_ptr<sol::state> lua;
+    std::atomic<bool> stopped{ false };
+    std::atomic<size_t> memoryUsage{ 0 };
+    std::chrono::steady_clock::time_point callStartTime;
+
+    ~Context() {
+        Close();
+    }
+
+    // The following functions are called on the worker thread only
+    void Open(const FilePath& scriptFilePath);
+    void Dispatch(const std::shared_ptr<LuaMessage>& message);
+    bool Call(int nargs);
+    void Close();
+
+    // Lua callbacks, the context is the user data of the allocator
+    static Context* FromState(lua_State* L);
+    static void* Alloc(void* ud, void* ptr, size_t osize, size_t nsize);
+    static void Hook(lua_State* L, lua_Debug* ar);
+    static int Post(lua_State* L);
+    static int MemoryUsage(lua_State* L);
+};
+
+static void LuaWorkerLog(const LuaWorker::Options& options, const std::string& logText) {
+    LogUtil::OutputLine(StringUtil::Printf(_T("[LuaWorker %d] %s"), options.nWorkerId,
+                                           StringConvert::UTF8ToT(logText).c_str()));
+}
+
+LuaWorker::Context* LuaWorker::Context::FromState(lua_State* L) {
+    void* ud = nullptr;
+    lua_getallocf(L, &ud);
+    return static_cast<Context*>(ud);
+}
+
+// Allocator with memory limit: a failed allocation raises a memory error in the script
+void* LuaWorker::Context::Alloc(void* ud, void* ptr, size_t osize, size_t nsize) {
+    Context* context = static_cast<Context*>(ud);
+    const size_t oldSize = (ptr != nullptr) ? osize : 0;
+    if (nsize == 0) {
+        free(ptr);
+        context->memoryUsage -= oldSize;
+        return nullptr;
+    }
+    const size_t memoryLimit = context->options.nMemoryLimit;
+    if ((memoryLimit > 0) && (nsize > oldSize) &&
+        (context->memoryUsage.load() + (nsize - oldSize) > memoryLimit)) {
+        return nullptr;
+    }
+    void* newPtr = realloc(ptr, nsize);
+    if (newPtr != nullptr) {
+        context->memoryUsage += nsize;
+        context->memoryUsage -= oldSize;
+    }
+    return newPtr;
+}
+
+// Abort the running call if the worker is stopped or timed out
+void LuaWorker::Context::Hook(lua_State* L, lua_Debug* ar) {
+    (void)ar;
+    Context* context = FromState(L);
+    if (context->stopped) {
+        luaL_error(L, "worker stopped");
+    }
+    if (context->options.nTimeoutMs > 0) {
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - context->callStartTime).count();
+        if (elapsed > context->options.nTimeoutMs) {
+            luaL_error(L, "Script execution timeout after %d ms", context->options.nTimeoutMs);
+        }
+    }
+}
+
+// worker.post(name, value)
+int LuaWorker::Context::Post(lua_State* L) {
+    luaL_checkstring(L, 1);
+    char errorBuf[256] = { 0 };
+    {
+        // No C++ objects may be alive when lua_error is called
+        auto message = std::make_shared<LuaMessage>();
+        message->name = lua_tostring(L, 1);
+        std::string errorMsg;
+        if (message->value.Read(L, 2, errorMsg)) {
+            Context* context = FromState(L);
+            if (context->callback != nullptr) {
+                context->callback(message);
+            }
+        }
+        else {
+            snprintf(errorBuf, sizeof(errorBuf), "worker.post: %s", errorMsg.c_str());
+        }
+    }
+    if (errorBuf[0] != '\0') {
+        return luaL_error(L, "%s", errorBuf);
+    }
+    return 0;
+}
+
+// worker.memory_usage()
+int LuaWorker::Context::MemoryUsage(lua_State* L) {
+    lua_pushinteger(L, static_cast<lua_Integer>(FromState(L)->memoryUsage.load()));
+    return 1;
+}
+
+// Call on_message(name, value), the message is passed as light userdata
+static int LuaWorkerDispatch(lua_State* L) {
+    const LuaMessage* message = static_cast<const LuaMessage*>(lua_touserdata(L, 1));
+    lua_settop(L, 0);
+    if (lua_getglobal(L, "on_message") != LUA_TFUNCTION) {
+        return 0;
+    }
+    lua_pushlstring(L, message->name.data(), message->name.size());
+    message->value.Push(L);
+    lua_call(L, 2, 0);
+    return 0;
+}
+
+void LuaWorker::Context::Open(const FilePath& scriptFilePath) {
+    if (stopped) {
+        return;
+    }
+    std::vector<uint8_t> source;
+    if (!FileUtil::ReadFileData(scriptFilePath, source)) {
+        LuaWorkerLog(options, "cannot open " + scriptFilePath.ToStringA());
+        return;
+    }
+    // Skip UTF-8 BOM
+    size_t offset = 0;
+    if ((source.size() >= 3) && (source[0] == 0xEF) && (source[1] == 0xBB) && (source[2] == 0xBF)) {
+        offset = 3;
+    }
+
+    try {
+        lua = std::make_unique<sol::state>(sol::default_at_panic, Alloc, this);
+        lua->open_libraries(sol::lib::base, sol::lib::string, sol::lib::table,
+                            sol::lib::math, sol::lib::utf8);
+        (*lua)["dofile"] = sol::nil;
+        (*lua)["loadfile"] = sol::nil;
+
+        sol::table worker = lua->create_named_table("worker");
+        worker["id"] = options.nWorkerId;
+        worker["post"] = &Context::Post;
+        worker["memory_usage"] = &Context::MemoryUsage;
+    }
+    catch (const std::exception& e) {
+        LuaWorkerLog(options, std::string("create state failed: ") + e.what());
+        lua.reset();
+        return;
+    }
+
+    lua_State* L = lua->lua_state();
+    const std::string chunkName = "@" + scriptFilePath.ToStringA();
+    if (luaL_loadbufferx(L, reinterpret_cast<const char*>(source.data()) + offset, source.size() - offset,
+                         chunkName.c_str(), "t") != LUA_OK) {
+        LuaWorkerLog(options, std::string("load failed: ") + lua_tostring(L, -1));
+        lua_pop(L, 1);
+        return;
+    }
+    Call(0);
+}
+
+void LuaWorker::Context::Dispatch(const std::shared_ptr<LuaMessage>& message) {
+    if (!lua || stopped) {
+        return;
+    }
+    lua_State* L = lua->lua_state();
+    lua_pushcfunction(L, LuaWorkerDispatch);
+    lua_pushlightuserdata(L, message.get());
+    Call(1);
+}
+
+bool LuaWorker::Context::Call(int nargs) {
+    lua_State* L = lua->lua_state();
+    callStartTime = std::chrono::steady_clock::now();
+    lua_sethook(L, Hook, LUA_MASKCOUNT, 1000);
+    const int status = lua_pcall(L, nargs, 0, 0);
+    lua_sethook(L, nullptr, 0, 0);
+    if (status != LUA_OK) {
+        const char* err = lua_tostring(L, -1);
+        LuaWorkerLog(options, std::string("call failed: ") + ((err != nullptr) ? err : "unknown error"));
+        lua_pop(L, 1);
+        return false;
+    }
+    return true;
+}
+
+void LuaWorker::Context::Close() {
+    lua.reset();
+}
+
+LuaWorker::LuaWorker() {
+}
+
+LuaWorker::~LuaWorker() {
+    Stop();
+}
+
+bool LuaWorker::Start(const Options& options, const FilePath& scriptFilePath, const MessageCallback& callback) {
+    ASSERT(m_context == nullptr);
+    if (m_context != nullptr) {
+        return false;
+    }
+    auto context = std::make_shared<Context>();
+    context->options = options;
+    context->callback = callback;
+    FilePath filePath = scriptFilePath;
+    size_t nTaskId = GlobalManager::Instance().Thread().PostTask(options.nThreadIdentifier, [context, filePath]() {
+            context->Open(filePath);
+        });
+    if (nTaskId == 0) {
+        return false;
+    }
+    m_context = context;
+    return true;
+}
+
+void LuaWorker::Stop() {
+    if (m_context == nullptr) {
+        return;
+    }
+    // Abort the running call, then close the state on the worker thread
+    std::shared_ptr<Context> context;
+    context.swap(m_context);
+    context->stopped = true;
+    GlobalManager::Instance().Thread().PostTask(context->options.nThreadIdentifier, [context]() {
+            context->Close();
+        });
+}
+
+bool LuaWorker::IsRunning() const {
+    return m_context != nullptr;
+}
+
+bool LuaWorker::Post(const std::shared_ptr<LuaMessage>& message) {
+    ASSERT(message != nullptr);
+    if ((m_context == nullptr) || (message == nullptr)) {
+        return false;
+    }
+    std::shared_ptr<Context> context = m_context;
+    size_t nTaskId = GlobalManager::Instance().Thread().PostTask(context->options.nThreadIdentifier, [context, message]() {
+            context->Dispatch(message);
+        });
+    return nTaskId != 0;
+}
+
+size_t LuaWorker::GetMemoryUsage() const {
+    if (m_context == nullptr) {
+        return 0;
+    }
+    return m_context->memoryUsage.load();
+}
+
+} // namespace ui
+
+#endif // DUILIB_BUILD_FOR_LUA
@@ -0,0 +1,118 @@
+#ifndef UI_LUA_LUA_WORKER_H_
+#define UI_LUA_LUA_WORKER_H_
+
+#ifdef DUILIB_BUILD_FOR_LUA
+
+#include "duilib/duilib_defs.h"
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+struct lua_State;
+
+namespace ui
+{
+
+class FilePath;
+
+/** Value passed between Lua states
+ *  Only nil, boolean, number, string and tables of these types can be passed,
+ *  functions, userdata and threads are rejected.
+ */
+struct UILIB_API LuaMessageValue
+{
+    enum class Type { kNil, kBoolean, kInteger, kNumber, kString, kTable };
+
+    Type type = Type::kNil;
+    bool boolValue = false;
+    int64_t intValue = 0;
+    double numberValue = 0;
+    std::string stringValue;
+    std::vector<std::pair<LuaMessageValue, LuaMessageValue>> tableValue;
+
+    /** Copy value at the given stack index
+     *  @param [in] L Source Lua state
+     *  @param [in] index Stack index of the value
+     *  @param [out] errorMsg Error message if the value can't be passed
+     *  @return true if copied successfully
+     */
+    bool Read(lua_State* L, int index, std::string& errorMsg);
+
+    /** Push value onto the stack of the target Lua state */
+    void Push(lua_State* L) const;
+
+private:
+    bool Read(lua_State* L, int index, int depth, std::string& errorMsg);
+};
+
+/** Message passed between Lua states */
+struct UILIB_API LuaMessage
+{
+    std::string name;
+    LuaMessageValue value;
+};
+
+/** Lua state running on a worker thread
+ *  The state is created, used and closed on the worker thread only, and has no UI bindings.
+ *  Scripts communicate with the UI thread by messages:
+ *    worker.post(name, value)         -- send message to the UI thread
+ *    function on_message(name, value) -- called for messages sent to the worker
+ *  Memory usage of the state is capped by a custom allocator; long running calls are aborted
+ *  after the timeout or when the worker is stopped.
+ */
+class UILIB_API LuaWorker
+{
+public:
+    /** Message callback, called on the worker thread for messages posted by the script */
+    typedef std::function<void(const std::shared_ptr<LuaMessage>& message)> MessageCallback;
+
+    /** Worker options */
+    struct Options
+    {
+        int32_t nThreadIdentifier = 1;  // Thread identifier (default: kThreadWorker)
+        size_t nMemoryLimit = 0;        // Memory limit of the state in bytes (0: unlimited)
+        int nTimeoutMs = 0;             // Timeout of each script call in milliseconds (0: unlimited)
+        int nWorkerId = 0;              // Worker id exposed to the script as worker.id
+    };
+
+public:
+    LuaWorker();
+    ~LuaWorker();
+    LuaWorker(const LuaWorker&) = delete;
+    LuaWorker& operator=(const LuaWorker&) = delete;
+
+    /** Create the Lua state and run the script on the worker thread
+     *  @param [in] options Worker options
+     *  @param [in] scriptFilePath Full path of the script file
+     *  @param [in] callback Callback for messages posted by the script
+     *  @return true if the start task was posted to the worker thread
+     */
+    bool Start(const Options& options, const FilePath& scriptFilePath, const MessageCallback& callback);
+
+    /** Stop the worker: abort the running call and close the state on the worker thread */
+    void Stop();
+
+    /** Check if the worker is started and not stopped */
+    bool IsRunning() const;
+
+    /** Post message to the script (calls on_message on the worker thread)
+     *  @return true if the message was posted
+     */
+    bool Post(const std::shared_ptr<LuaMessage>& message);
+
+    /** Get memory usage of the Lua state in bytes (can be called from any thread) */
+    size_t GetMemoryUsage() const;
+
+private:
+    struct Context;
+    std::shared_ptr<Context> m_context;
+};
+
+} // namespace ui
+
+#endif // DUILIB_BUILD_FOR_LUA
+
+#endif // UI_LUA_LUA_WORKER_H_
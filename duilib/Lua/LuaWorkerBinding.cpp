@@ -0,0 +1,72 @@
+#include "duilib/duilib_config.h"
+
+#ifdef DUILIB_BUILD_FOR_LUA
+
+#include "LuaWorkerBinding.h"
+#include "LuaEngine.h"
+#include "LuaWorker.h"
+#include "duilib/Core/Window.h"
+#include "duilib/Utils/LogUtil.h"
+#include "duilib/Utils/StringConvert.h"
+#include "duilib/Utils/StringUtil.h"
+#include "sol/sol.hpp"
+
+namespace ui {
+
+namespace LuaWorkerBinding {
+
+void Register(sol::state& lua) {
+    sol::table ui_table = lua["ui"].get_or_create<sol::table>();
+
+    ui_table["create_worker"] = [](const std::string& script_path, sol::optional<Window*> window) -> sol::optional<int> {
+        int worker_id = LuaEngine::Instance().CreateWorker(StringConvert::UTF8ToT(script_path),
+                                                           window.value_or(nullptr));
+        if (worker_id == 0) {
+            return sol::nullopt;
+        }
+        return worker_id;
+    };
+
+    ui_table["destroy_worker"] = [](int worker_id) {
+        LuaEngine::Instance().DestroyWorker(worker_id);
+    };
+
+    ui_table["post_to_worker"] = [](sol::this_state s, int worker_id, const std::string& name,
+                                    sol::stack_object value) -> bool {
+        auto message = std::make_shared<LuaMessage>();
+        message->name = name;
+        std::string error_msg;
+        if (!message->value.Read(s, value.stack_index(), error_msg)) {
+            LogUtil::OutputLine(StringUtil::Printf(_T("[lua] post_to_worker failed: %s"),
+                                                   StringConvert::UTF8ToT(error_msg).c_str()));
+            return false;
+        }
+        return LuaEngine::Instance().PostWorkerMessage(worker_id, message);
+    };
+
+    // handler(name, value, worker_id) is called on the UI thread
+    ui_table["on_worker_message"] = [](int worker_id, sol::protected_function handler) {
+        LuaEngine::Instance().SetWorkerMessageHandler(worker_id, [handler](int id, const LuaMessage& message) {
+            lua_State* L = handler.lua_state();
+            message.value.Push(L);
+            sol::object value(L, -1);
+            lua_pop(L, 1);
+            sol::protected_function_result result = handler(message.name, value, id);
+            if (!result.valid()) {
+                sol::error err = result;
+                LogUtil::OutputLine(StringUtil::Printf(_T("[lua] worker message handler failed: %s"),
+                                                       StringConvert::UTF8ToT(err.what()).c_str()));
+            }
+        });
+    };
+
+    ui_table["worker_memory_usage"] = [](int worker_id) {
+        return LuaEngine::Instance().GetWorkerMemoryUsage(worker_id);
+    };
+}
+
+}
+
+}
+
+#endif
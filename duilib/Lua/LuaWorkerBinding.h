@@ -0,0 +1,20 @@
+#ifndef UI_LUA_WORKER_BINDING_H_
+#define UI_LUA_WORKER_BINDING_H_
+
+#ifdef DUILIB_BUILD_FOR_LUA
+
+namespace sol { class state; }
+
+namespace ui
+{
+
+namespace LuaWorkerBinding
+{
+    void Register(sol::state& lua);
+}
+
+}
+
+#endif
+
+#endif
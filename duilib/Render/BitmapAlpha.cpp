@@ -1,4 +1,5 @@
  #include "BitmapAlpha.h"
+#include "PixelKernels.h"
 
 namespace ui
 {
@@ -66,18 +67,12 @@ void BitmapAlpha::RestoreAlpha(const UiRect& rcDirty, const UiPadding& rcShadowP
     nTop = std::max(nTop, rcShadowPadding.top);
     nBottom = std::min(nBottom, m_nHeight - rcShadowPadding.bottom);
 
-    for (int32_t i = nTop; i < nBottom; i++) {
-        for (int32_t j = nLeft; j < nRight; j++) {
-            uint8_t* a = (uint8_t*)(pBmpBits + i * m_nWidth + j) + 3;
-            // ClearAlpha时，把alpha通道设置为某个值
-            // 如果此值没有变化，则证明上面没有绘制任何内容，把alpha设为0
-            if (alpha != 0 && *a == alpha) {
-                *a = 0;
-            }
-            // 如果此值变为0，则证明上面被类似DrawText等GDI函数绘制过导致alpha被设为0，此时alpha设为255
-            else if (*a == 0) {
-                *a = 255;
-            }
+    if (nRight > nLeft) {
+        // ClearAlpha时，把alpha通道设置为某个值
+        // 如果此值没有变化，则证明上面没有绘制任何内容，把alpha设为0
+        // 如果此值变为0，则证明上面被类似DrawText等GDI函数绘制过导致alpha被设为0，此时alpha设为255
+        for (int32_t i = nTop; i < nBottom; i++) {
+            PixelKernels::RestoreAlpha(pBmpBits + i * m_nWidth + nLeft, (size_t)(nRight - nLeft), alpha);
         }
     }
 }
@@ -102,12 +97,9 @@ void BitmapAlpha::RestoreAlpha(const UiRect& rcDirty, const UiPadding& rcShadowP
     nTop = std::max(nTop, rcShadowPadding.top);
     nBottom = std::min(nBottom, m_nHeight - rcShadowPadding.bottom);
 
-    for (int i = nTop; i < nBottom; ++i) {
-        for (int j = nLeft; j < nRight; ++j) {            
-            uint8_t* a = (uint8_t*)(pBmpBits + i * m_nWidth + j) + 3;
-            if (*a != 255) {
-                *a = 255;
-            }
+    if (nRight > nLeft) {
+        for (int32_t i = nTop; i < nBottom; ++i) {
+            PixelKernels::SetAlpha(pBmpBits + i * m_nWidth + nLeft, (size_t)(nRight - nLeft), 255);
         }
     }
 }
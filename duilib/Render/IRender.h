@@ -5,6 +5,7 @@
 #include "duilib/Core/UiTypes.h"
 #include "duilib/Core/SharePtr.h"
 #include <map>
+#include <vector>
 
 namespace ui 
 {
@@ -446,6 +447,21 @@ public:
     * @return 返回true表示支持局部绘制，返回false表示不支持局部绘制
     */
     virtual bool GetUpdateRect(UiRect& rcUpdate) const = 0;
+
+    /** 获取界面需要绘制的区域（多个互不重叠的矩形），以实现分块的局部绘制
+    * @param [out] rcUpdates 返回需要绘制的区域矩形列表
+    * @return 返回true表示支持局部绘制，返回false表示不支持局部绘制
+    */
+    virtual bool GetUpdateRects(std::vector<UiRect>& rcUpdates) const
+    {
+        rcUpdates.clear();
+        UiRect rcUpdate;
+        if (GetUpdateRect(rcUpdate)) {
+            rcUpdates.push_back(rcUpdate);
+            return true;
+        }
+        return false;
+    }
 };
 
 /** 光栅操作代码
@@ -735,6 +751,15 @@ struct DrawStringParam
     bool bRotate90ForAscii = true;      //纵向绘制时，对于字母数字等，旋转90度显示
 };
 
+/** 文字绘制缓存：保存文字的排版结果（字形及位置），由渲染接口创建和维护
+*   文字内容、字体、绘制区域、文字格式不变时，绘制文字可以直接使用排版结果（文字颜色和透明度不影响排版结果）
+*/
+class UILIB_API IDrawStringCache : public virtual SupportWeakCallback
+{
+};
+
+typedef std::shared_ptr<IDrawStringCache> IDrawStringCachePtr;
+
 /** 渲染接口
 */
 class IRenderFactory;
@@ -1104,6 +1129,19 @@ public:
     */
     virtual void DrawString(const DString& strText, const DrawStringParam& drawParam) = 0;
 
+    /** 绘制文字，并使用文字绘制缓存（适用于重复绘制的静态文本）
+    * @param [in] strText 文字内容
+    * @param [in] drawParam 文字绘制相关的参数
+    * @param [in,out] spDrawCache 文字绘制缓存，如果为空或者与当前的文字内容和绘制参数不匹配，则重新排版并更新缓存
+    *                  默认实现不使用缓存，直接绘制文字
+    */
+    virtual void DrawString(const DString& strText, const DrawStringParam& drawParam,
+                            IDrawStringCachePtr& spDrawCache)
+    {
+        spDrawCache.reset();
+        DrawString(strText, drawParam);
+    }
+
     /** 计算格式文本的宽度和高度
     * @param [in] textRect 绘制文本的矩形区域
     * @param [in] szScrollOffset 绘制文本的矩形区域所占的滚动条位置
@@ -1343,6 +1381,17 @@ public:
     */
     virtual bool PaintAndSwapBuffers(IRenderPaint* pRenderPaint) = 0;
 
+    /** 设置是否在独立的渲染线程中绘制（Render的实现已经与窗口关联）
+    *   开启后，PaintAndSwapBuffers在UI线程中只录制绘制命令，由渲染线程回放绘制命令并光栅化，UI线程无需等待光栅化完成
+    * @param [in] bEnable true表示在渲染线程中绘制，false表示在UI线程中同步绘制
+    * @return 如果当前实现不支持渲染线程，返回false（默认实现不支持渲染线程）
+    */
+    virtual bool SetPaintOnRenderThread(bool /*bEnable*/) { return false; }
+
+    /** 是否在独立的渲染线程中绘制
+    */
+    virtual bool IsPaintOnRenderThread() const { return false; }
+
     /** 设置窗口的形状为圆角矩形
     * @param [in] rcWnd 需要设置RGN的区域，坐标为屏幕坐标
     * @param [in] rx 圆角的宽度，其值不能为0
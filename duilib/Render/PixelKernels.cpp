@@ -0,0 +1,496 @@
+#include "PixelKernels.h"
+#include <atomic>
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(__SSE2__) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #define DUILIB_PIXEL_KERNELS_X86 1
+    #include <immintrin.h>
+    #ifdef _MSC_VER
+        #include <intrin.h>
+        #define DUILIB_TARGET_AVX2
+    #else
+        #define DUILIB_TARGET_AVX2 __attribute__((target("avx2")))
+    #endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    #define DUILIB_PIXEL_KERNELS_NEON 1
+    #include <arm_neon.h>
+#endif
+
+namespace ui
+{
+
+/** 一组处理函数的实现
+*/
+struct PixelKernelTable
+{
+    PixelKernels::InstructionSet instructionSet;
+    void (*swizzleChannels)(uint32_t* pPixels, size_t nCount, const uint8_t channelOrder[4]);
+    void (*scaleChannels)(uint32_t* pPixels, size_t nCount, uint8_t alpha);
+    void (*setAlpha)(uint32_t* pPixels, size_t nCount, uint8_t alpha);
+    void (*restoreAlpha)(uint32_t* pPixels, size_t nCount, uint8_t alpha);
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////
+//标量实现
+
+static void SwizzleChannels_Scalar(uint32_t* pPixels, size_t nCount, const uint8_t channelOrder[4])
+{
+    const uint32_t nShift0 = channelOrder[0] * 8;
+    const uint32_t nShift1 = channelOrder[1] * 8;
+    const uint32_t nShift2 = channelOrder[2] * 8;
+    const uint32_t nShift3 = channelOrder[3] * 8;
+    for (size_t i = 0; i < nCount; ++i) {
+        const uint32_t c = pPixels[i];
+        pPixels[i] = ((c >> nShift0) & 0xFF) |
+                     (((c >> nShift1) & 0xFF) << 8) |
+                     (((c >> nShift2) & 0xFF) << 16) |
+                     (((c >> nShift3) & 0xFF) << 24);
+    }
+}
+
+static void ScaleChannels_Scalar(uint32_t* pPixels, size_t nCount, uint8_t alpha)
+{
+    //4个通道的处理方式相同，按字节处理：乘积不超过65025，使用16位无符号整数除以常量，编译器可自动向量化
+    uint8_t* pBytes = (uint8_t*)pPixels;
+    const size_t nBytes = nCount * 4;
+    for (size_t i = 0; i < nBytes; ++i) {
+        pBytes[i] = (uint8_t)((uint16_t)(pBytes[i] * alpha) / 255);
+    }
+}
+
+static void SetAlpha_Scalar(uint32_t* pPixels, size_t nCount, uint8_t alpha)
+{
+    const uint32_t nAlpha = (uint32_t)alpha << 24;
+    for (size_t i = 0; i < nCount; ++i) {
+        pPixels[i] = (pPixels[i] & 0x00FFFFFF) | nAlpha;
+    }
+}
+
+static void RestoreAlpha_Scalar(uint32_t* pPixels, size_t nCount, uint8_t alpha)
+{
+    //无分支实现（编译器可自动向量化）：alpha为0时，不存在“Alpha值等于alpha”的情况（只有Alpha值为0的情况）
+    const uint32_t nClearValue = (alpha != 0) ? alpha : 0x100;
+    for (size_t i = 0; i < nCount; ++i) {
+        const uint32_t c = pPixels[i];
+        const uint32_t a = c >> 24;
+        const uint32_t nClearMask = 0u - (uint32_t)(a == nClearValue);
+        const uint32_t nOpaqueMask = 0u - (uint32_t)(a == 0);
+        pPixels[i] = (c & ~(nClearMask & 0xFF000000)) | (nOpaqueMask & 0xFF000000);
+    }
+}
+
+static const PixelKernelTable s_scalarKernels = {
+    PixelKernels::InstructionSet::kScalar,
+    SwizzleChannels_Scalar,
+    ScaleChannels_Scalar,
+    SetAlpha_Scalar,
+    RestoreAlpha_Scalar
+};
+
+#ifdef DUILIB_PIXEL_KERNELS_X86
+/////////////////////////////////////////////////////////////////////////////////////////
+//SSE2实现（每次处理4个像素）
+
+static void SwizzleChannels_SSE2(uint32_t* pPixels, size_t nCount, const uint8_t channelOrder[4])
+{
+    //SSE2没有字节重排指令，按通道移位后合并
+    const __m128i mask = _mm_set1_epi32(0xFF);
+    const __m128i srcShift0 = _mm_cvtsi32_si128(channelOrder[0] * 8);
+    const __m128i srcShift1 = _mm_cvtsi32_si128(channelOrder[1] * 8);
+    const __m128i srcShift2 = _mm_cvtsi32_si128(channelOrder[2] * 8);
+    const __m128i srcShift3 = _mm_cvtsi32_si128(channelOrder[3] * 8);
+    size_t i = 0;
+    for (; (i + 4) <= nCount; i += 4) {
+        const __m128i c = _mm_loadu_si128((const __m128i*)(pPixels + i));
+        __m128i r = _mm_and_si128(_mm_srl_epi32(c, srcShift0), mask);
+        r = _mm_or_si128(r, _mm_slli_epi32(_mm_and_si128(_mm_srl_epi32(c, srcShift1), mask), 8));
+        r = _mm_or_si128(r, _mm_slli_epi32(_mm_and_si128(_mm_srl_epi32(c, srcShift2), mask), 16));
+        r = _mm_or_si128(r, _mm_slli_epi32(_mm_srl_epi32(c, srcShift3), 24));
+        _mm_storeu_si128((__m128i*)(pPixels + i), r);
+    }
+    SwizzleChannels_Scalar(pPixels + i, nCount - i, channelOrder);
+}
+
+/** 16位整数除以255：t / 255 == (t * 0x8081) >> 23（t不超过65535时结果精确），只需一次高位乘法和一次移位
+*/
+static inline __m128i ScaleWords_SSE2(__m128i words, __m128i alpha, __m128i div255)
+{
+    return _mm_srli_epi16(_mm_mulhi_epu16(_mm_mullo_epi16(words, alpha), div255), 7);
+}
+
+static void ScaleChannels_SSE2(uint32_t* pPixels, size_t nCount, uint8_t alpha)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i div255 = _mm_set1_epi16((int16_t)0x8081);
+    const __m128i alphaWords = _mm_set1_epi16(alpha);
+    size_t i = 0;
+    for (; (i + 4) <= nCount; i += 4) {
+        const __m128i c = _mm_loadu_si128((const __m128i*)(pPixels + i));
+        const __m128i lo = ScaleWords_SSE2(_mm_unpacklo_epi8(c, zero), alphaWords, div255);
+        const __m128i hi = ScaleWords_SSE2(_mm_unpackhi_epi8(c, zero), alphaWords, div255);
+        _mm_storeu_si128((__m128i*)(pPixels + i), _mm_packus_epi16(lo, hi));
+    }
+    ScaleChannels_Scalar(pPixels + i, nCount - i, alpha);
+}
+
+static void SetAlpha_SSE2(uint32_t* pPixels, size_t nCount, uint8_t alpha)
+{
+    const __m128i colorMask = _mm_set1_epi32(0x00FFFFFF);
+    const __m128i alphaBits = _mm_set1_epi32((int32_t)((uint32_t)alpha << 24));
+    size_t i = 0;
+    for (; (i + 4) <= nCount; i += 4) {
+        const __m128i c = _mm_loadu_si128((const __m128i*)(pPixels + i));
+        _mm_storeu_si128((__m128i*)(pPixels + i), _mm_or_si128(_mm_and_si128(c, colorMask), alphaBits));
+    }
+    SetAlpha_Scalar(pPixels + i, nCount - i, alpha);
+}
+
+static void RestoreAlpha_SSE2(uint32_t* pPixels, size_t nCount, uint8_t alpha)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i alphaMask = _mm_set1_epi32((int32_t)0xFF000000);
+    //alpha为0时，不存在“Alpha值等于alpha”的情况（只有Alpha值为0的情况）
+    const __m128i clearValue = (alpha != 0) ? _mm_set1_epi32(alpha) : _mm_set1_epi32(-1);
+    size_t i = 0;
+    for (; (i + 4) <= nCount; i += 4) {
+        const __m128i c = _mm_loadu_si128((const __m128i*)(pPixels + i));
+        const __m128i a = _mm_srli_epi32(c, 24);
+        const __m128i bClear = _mm_cmpeq_epi32(a, clearValue);
+        const __m128i bOpaque = _mm_andnot_si128(bClear, _mm_cmpeq_epi32(a, zero));
+        __m128i r = _mm_andnot_si128(_mm_and_si128(bClear, alphaMask), c);
+        r = _mm_or_si128(r, _mm_and_si128(bOpaque, alphaMask));
+        _mm_storeu_si128((__m128i*)(pPixels + i), r);
+    }
+    RestoreAlpha_Scalar(pPixels + i, nCount - i, alpha);
+}
+
+static const PixelKernelTable s_sse2Kernels = {
+    PixelKernels::InstructionSet::kSSE2,
+    SwizzleChannels_SSE2,
+    ScaleChannels_SSE2,
+    SetAlpha_SSE2,
+    RestoreAlpha_SSE2
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////
+//AVX2实现（每次处理8个像素）
+
+DUILIB_TARGET_AVX2
+static void SwizzleChannels_AVX2(uint32_t* pPixels, size_t nCount, const uint8_t channelOrder[4])
+{
+    //每个128位通道内，按字节重排
+    alignas(32) int8_t shuffle[32];
+    for (int32_t nByte = 0; nByte < 32; ++nByte) {
+        shuffle[nByte] = (int8_t)(((nByte % 16) / 4) * 4 + channelOrder[nByte % 4]);
+    }
+    const __m256i shuffleMask = _mm256_load_si256((const __m256i*)shuffle);
+    size_t i = 0;
+    for (; (i + 8) <= nCount; i += 8) {
+        const __m256i c = _mm256_loadu_si256((const __m256i*)(pPixels + i));
+        _mm256_storeu_si256((__m256i*)(pPixels + i), _mm256_shuffle_epi8(c, shuffleMask));
+    }
+    SwizzleChannels_Scalar(pPixels + i, nCount - i, channelOrder);
+}
+
+DUILIB_TARGET_AVX2
+static void ScaleChannels_AVX2(uint32_t* pPixels, size_t nCount, uint8_t alpha)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i div255 = _mm256_set1_epi16((int16_t)0x8081);
+    const __m256i alphaWords = _mm256_set1_epi16(alpha);
+    size_t i = 0;
+    for (; (i + 8) <= nCount; i += 8) {
+        const __m256i c = _mm256_loadu_si256((const __m256i*)(pPixels + i));
+        //unpack和pack都在128位通道内进行，像素顺序不变；除以255的方法与SSE2实现相同
+        __m256i lo = _mm256_mullo_epi16(_mm256_unpacklo_epi8(c, zero), alphaWords);
+        __m256i hi = _mm256_mullo_epi16(_mm256_unpackhi_epi8(c, zero), alphaWords);
+        lo = _mm256_srli_epi16(_mm256_mulhi_epu16(lo, div255), 7);
+        hi = _mm256_srli_epi16(_mm256_mulhi_epu16(hi, div255), 7);
+        _mm256_storeu_si256((__m256i*)(pPixels + i), _mm256_packus_epi16(lo, hi));
+    }
+    ScaleChannels_Scalar(pPixels + i, nCount - i, alpha);
+}
+
+DUILIB_TARGET_AVX2
+static void SetAlpha_AVX2(uint32_t* pPixels, size_t nCount, uint8_t alpha)
+{
+    const __m256i colorMask = _mm256_set1_epi32(0x00FFFFFF);
+    const __m256i alphaBits = _mm256_set1_epi32((int32_t)((uint32_t)alpha << 24));
+    size_t i = 0;
+    for (; (i + 8) <= nCount; i += 8) {
+        const __m256i c = _mm256_loadu_si256((const __m256i*)(pPixels + i));
+        _mm256_storeu_si256((__m256i*)(pPixels + i), _mm256_or_si256(_mm256_and_si256(c, colorMask), alphaBits));
+    }
+    SetAlpha_Scalar(pPixels + i, nCount - i, alpha);
+}
+
+DUILIB_TARGET_AVX2
+static void RestoreAlpha_AVX2(uint32_t* pPixels, size_t nCount, uint8_t alpha)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i alphaMask = _mm256_set1_epi32((int32_t)0xFF000000);
+    const __m256i clearValue = (alpha != 0) ? _mm256_set1_epi32(alpha) : _mm256_set1_epi32(-1);
+    size_t i = 0;
+    for (; (i + 8) <= nCount; i += 8) {
+        const __m256i c = _mm256_loadu_si256((const __m256i*)(pPixels + i));
+        const __m256i a = _mm256_srli_epi32(c, 24);
+        const __m256i bClear = _mm256_cmpeq_epi32(a, clearValue);
+        const __m256i bOpaque = _mm256_andnot_si256(bClear, _mm256_cmpeq_epi32(a, zero));
+        __m256i r = _mm256_andnot_si256(_mm256_and_si256(bClear, alphaMask), c);
+        r = _mm256_or_si256(r, _mm256_and_si256(bOpaque, alphaMask));
+        _mm256_storeu_si256((__m256i*)(pPixels + i), r);
+    }
+    RestoreAlpha_Scalar(pPixels + i, nCount - i, alpha);
+}
+
+static const PixelKernelTable s_avx2Kernels = {
+    PixelKernels::InstructionSet::kAVX2,
+    SwizzleChannels_AVX2,
+    ScaleChannels_AVX2,
+    SetAlpha_AVX2,
+    RestoreAlpha_AVX2
+};
+
+/** 检测CPU和操作系统是否支持AVX2
+*/
+static bool IsAVX2Supported()
+{
+#ifdef _MSC_VER
+    int cpuInfo[4] = { 0, };
+    __cpuid(cpuInfo, 0);
+    if (cpuInfo[0] < 7) {
+        return false;
+    }
+    __cpuid(cpuInfo, 1);
+    const bool bOSXSave = (cpuInfo[2] & (1 << 27)) != 0;
+    const bool bAVX = (cpuInfo[2] & (1 << 28)) != 0;
+    if (!bOSXSave || !bAVX) {
+        return false;
+    }
+    //操作系统需要保存YMM寄存器的状态
+    if ((_xgetbv(0) & 0x6) != 0x6) {
+        return false;
+    }
+    __cpuidex(cpuInfo, 7, 0);
+    return (cpuInfo[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+#endif
+}
+#endif //DUILIB_PIXEL_KERNELS_X86
+
+#ifdef DUILIB_PIXEL_KERNELS_NEON
+/////////////////////////////////////////////////////////////////////////////////////////
+//NEON实现（每次处理4个像素）
+
+static void SwizzleChannels_NEON(uint32_t* pPixels, size_t nCount, const uint8_t channelOrder[4])
+{
+    uint8_t shuffle[16];
+    for (int32_t nByte = 0; nByte < 16; ++nByte) {
+        shuffle[nByte] = (uint8_t)((nByte / 4) * 4 + channelOrder[nByte % 4]);
+    }
+    const uint8x16_t shuffleMask = vld1q_u8(shuffle);
+    size_t i = 0;
+    for (; (i + 4) <= nCount; i += 4) {
+        const uint8x16_t c = vld1q_u8((const uint8_t*)(pPixels + i));
+        vst1q_u8((uint8_t*)(pPixels + i), vqtbl1q_u8(c, shuffleMask));
+    }
+    SwizzleChannels_Scalar(pPixels + i, nCount - i, channelOrder);
+}
+
+static inline uint8x8_t ScaleBytes_NEON(uint8x8_t bytes, uint8x8_t alpha, uint16x8_t one)
+{
+    const uint16x8_t t = vmull_u8(bytes, alpha);
+    return vshrn_n_u16(vaddq_u16(vaddq_u16(t, one), vshrq_n_u16(t, 8)), 8);
+}
+
+static void ScaleChannels_NEON(uint32_t* pPixels, size_t nCount, uint8_t alpha)
+{
+    const uint8x8_t alphaBytes = vdup_n_u8(alpha);
+    const uint16x8_t one = vdupq_n_u16(1);
+    size_t i = 0;
+    for (; (i + 4) <= nCount; i += 4) {
+        const uint8x16_t c = vld1q_u8((const uint8_t*)(pPixels + i));
+        const uint8x8_t lo = ScaleBytes_NEON(vget_low_u8(c), alphaBytes, one);
+        const uint8x8_t hi = ScaleBytes_NEON(vget_high_u8(c), alphaBytes, one);
+        vst1q_u8((uint8_t*)(pPixels + i), vcombine_u8(lo, hi));
+    }
+    ScaleChannels_Scalar(pPixels + i, nCount - i, alpha);
+}
+
+static void SetAlpha_NEON(uint32_t* pPixels, size_t nCount, uint8_t alpha)
+{
+    const uint32x4_t colorMask = vdupq_n_u32(0x00FFFFFF);
+    const uint32x4_t alphaBits = vdupq_n_u32((uint32_t)alpha << 24);
+    size_t i = 0;
+    for (; (i + 4) <= nCount; i += 4) {
+        const uint32x4_t c = vld1q_u32(pPixels + i);
+        vst1q_u32(pPixels + i, vorrq_u32(vandq_u32(c, colorMask), alphaBits));
+    }
+    SetAlpha_Scalar(pPixels + i, nCount - i, alpha);
+}
+
+static void RestoreAlpha_NEON(uint32_t* pPixels, size_t nCount, uint8_t alpha)
+{
+    const uint32x4_t zero = vdupq_n_u32(0);
+    const uint32x4_t alphaMask = vdupq_n_u32(0xFF000000);
+    const uint32x4_t clearValue = vdupq_n_u32((alpha != 0) ? (uint32_t)alpha : 0xFFFFFFFF);
+    size_t i = 0;
+    for (; (i + 4) <= nCount; i += 4) {
+        const uint32x4_t c = vld1q_u32(pPixels + i);
+        const uint32x4_t a = vshrq_n_u32(c, 24);
+        const uint32x4_t bClear = vceqq_u32(a, clearValue);
+        const uint32x4_t bOpaque = vbicq_u32(vceqq_u32(a, zero), bClear);
+        uint32x4_t r = vbicq_u32(c, vandq_u32(bClear, alphaMask));
+        r = vorrq_u32(r, vandq_u32(bOpaque, alphaMask));
+        vst1q_u32(pPixels + i, r);
+    }
+    RestoreAlpha_Scalar(pPixels + i, nCount - i, alpha);
+}
+
+static const PixelKernelTable s_neonKernels = {
+    PixelKernels::InstructionSet::kNEON,
+    SwizzleChannels_NEON,
+    ScaleChannels_NEON,
+    SetAlpha_NEON,
+    RestoreAlpha_NEON
+};
+#endif //DUILIB_PIXEL_KERNELS_NEON
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+/** 获取指令集对应的实现（不支持时返回nullptr）
+*/
+static const PixelKernelTable* GetKernelTable(PixelKernels::InstructionSet instructionSet)
+{
+    switch (instructionSet) {
+    case PixelKernels::InstructionSet::kScalar:
+        return &s_scalarKernels;
+#ifdef DUILIB_PIXEL_KERNELS_X86
+    case PixelKernels::InstructionSet::kSSE2:
+        return &s_sse2Kernels;
+    case PixelKernels::InstructionSet::kAVX2:
+    {
+        static const bool bAVX2Supported = IsAVX2Supported();
+        return bAVX2Supported ? &s_avx2Kernels : nullptr;
+    }
+#endif
+#ifdef DUILIB_PIXEL_KERNELS_NEON
+    case PixelKernels::InstructionSet::kNEON:
+        return &s_neonKernels;
+#endif
+    default:
+        return nullptr;
+    }
+}
+
+/** 按CPU支持的指令集选择实现
+*/
+static const PixelKernelTable* SelectKernelTable()
+{
+    const PixelKernels::InstructionSet instructionSets[] = {
+        PixelKernels::InstructionSet::kAVX2,
+        PixelKernels::InstructionSet::kSSE2,
+        PixelKernels::InstructionSet::kNEON
+    };
+    for (PixelKernels::InstructionSet instructionSet : instructionSets) {
+        const PixelKernelTable* pKernelTable = GetKernelTable(instructionSet);
+        if (pKernelTable != nullptr) {
+            return pKernelTable;
+        }
+    }
+    return &s_scalarKernels;
+}
+
+/** 当前使用的实现（首次使用时初始化）
+*/
+static std::atomic<const PixelKernelTable*> s_pKernelTable{ nullptr };
+
+static const PixelKernelTable* CurrentKernelTable()
+{
+    const PixelKernelTable* pKernelTable = s_pKernelTable.load(std::memory_order_acquire);
+    if (pKernelTable == nullptr) {
+        pKernelTable = SelectKernelTable();
+        s_pKernelTable.store(pKernelTable, std::memory_order_release);
+    }
+    return pKernelTable;
+}
+
+void PixelKernels::SwizzleChannels(uint32_t* pPixels, size_t nCount, const uint8_t channelOrder[4])
+{
+    ASSERT((channelOrder != nullptr) && (channelOrder[0] < 4) && (channelOrder[1] < 4) &&
+           (channelOrder[2] < 4) && (channelOrder[3] < 4));
+    if ((pPixels == nullptr) || (nCount == 0) || (channelOrder == nullptr)) {
+        return;
+    }
+    if ((channelOrder[0] > 3) || (channelOrder[1] > 3) || (channelOrder[2] > 3) || (channelOrder[3] > 3)) {
+        return;
+    }
+    if ((channelOrder[0] == 0) && (channelOrder[1] == 1) && (channelOrder[2] == 2) && (channelOrder[3] == 3)) {
+        //字节顺序不变
+        return;
+    }
+    CurrentKernelTable()->swizzleChannels(pPixels, nCount, channelOrder);
+}
+
+void PixelKernels::ScaleChannels(uint32_t* pPixels, size_t nCount, uint8_t alpha)
+{
+    if ((pPixels == nullptr) || (nCount == 0) || (alpha == 255)) {
+        return;
+    }
+    CurrentKernelTable()->scaleChannels(pPixels, nCount, alpha);
+}
+
+void PixelKernels::SetAlpha(uint32_t* pPixels, size_t nCount, uint8_t alpha)
+{
+    if ((pPixels == nullptr) || (nCount == 0)) {
+        return;
+    }
+    CurrentKernelTable()->setAlpha(pPixels, nCount, alpha);
+}
+
+void PixelKernels::RestoreAlpha(uint32_t* pPixels, size_t nCount, uint8_t alpha)
+{
+    if ((pPixels == nullptr) || (nCount == 0)) {
+        return;
+    }
+    CurrentKernelTable()->restoreAlpha(pPixels, nCount, alpha);
+}
+
+PixelKernels::InstructionSet PixelKernels::GetInstructionSet()
+{
+    return CurrentKernelTable()->instructionSet;
+}
+
+bool PixelKernels::SetInstructionSet(InstructionSet instructionSet)
+{
+    const PixelKernelTable* pKernelTable = GetKernelTable(instructionSet);
+    if (pKernelTable == nullptr) {
+        return false;
+    }
+    s_pKernelTable.store(pKernelTable, std::memory_order_release);
+    return true;
+}
+
+bool PixelKernels::IsInstructionSetSupported(InstructionSet instructionSet)
+{
+    return GetKernelTable(instructionSet) != nullptr;
+}
+
+const char* PixelKernels::GetInstructionSetName(InstructionSet instructionSet)
+{
+    switch (instructionSet) {
+    case InstructionSet::kScalar:
+        return "Scalar";
+    case InstructionSet::kSSE2:
+        return "SSE2";
+    case InstructionSet::kAVX2:
+        return "AVX2";
+    case InstructionSet::kNEON:
+        return "NEON";
+    default:
+        return "Unknown";
+    }
+}
+
+} // namespace ui
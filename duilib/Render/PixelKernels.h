@@ -0,0 +1,75 @@
+#ifndef UI_RENDER_PIXEL_KERNELS_H_
+#define UI_RENDER_PIXEL_KERNELS_H_
+
+#include "duilib/duilib_defs.h"
+
+namespace ui
+{
+
+/** 32位像素数据（每个像素4个字节，小端字节序）的批量处理函数
+*   按CPU支持的指令集（SSE2/AVX2/NEON）选择实现，不支持时使用标量实现，各实现的计算结果完全相同
+*/
+class UILIB_API PixelKernels
+{
+public:
+    /** 指令集
+    */
+    enum class InstructionSet
+    {
+        kScalar = 0,    //标量实现
+        kSSE2 = 1,      //x86/x64: SSE2
+        kAVX2 = 2,      //x86/x64: AVX2（运行时检测）
+        kNEON = 3       //ARM64: NEON
+    };
+
+public:
+    /** 重排每个像素的字节顺序：新的第k个字节 = 原来的第channelOrder[k]个字节
+    * @param [in,out] pPixels 像素数据
+    * @param [in] nCount 像素个数
+    * @param [in] channelOrder 字节顺序，取值范围[0, 3]
+    */
+    static void SwizzleChannels(uint32_t* pPixels, size_t nCount, const uint8_t channelOrder[4]);
+
+    /** 每个像素的4个字节都乘以 alpha / 255（结果向下取整，与 x * alpha / 255 的整数运算结果相同）
+    * @param [in,out] pPixels 像素数据
+    * @param [in] nCount 像素个数
+    * @param [in] alpha 透明度
+    */
+    static void ScaleChannels(uint32_t* pPixels, size_t nCount, uint8_t alpha);
+
+    /** 设置每个像素的Alpha值（第3个字节）
+    * @param [in,out] pPixels 像素数据
+    * @param [in] nCount 像素个数
+    * @param [in] alpha 透明度
+    */
+    static void SetAlpha(uint32_t* pPixels, size_t nCount, uint8_t alpha);
+
+    /** 恢复Alpha值（第3个字节），见 BitmapAlpha::RestoreAlpha：
+    *   如果Alpha值等于alpha（alpha不为0），表示没有绘制内容，Alpha值设置为0；否则如果Alpha值为0，设置为255
+    * @param [in,out] pPixels 像素数据
+    * @param [in] nCount 像素个数
+    * @param [in] alpha 清除Alpha时设置的值
+    */
+    static void RestoreAlpha(uint32_t* pPixels, size_t nCount, uint8_t alpha);
+
+    /** 获取当前使用的指令集
+    */
+    static InstructionSet GetInstructionSet();
+
+    /** 设置使用的指令集（用于测试和性能对比，默认按CPU支持的指令集自动选择）
+    * @return 当前CPU不支持该指令集时返回false
+    */
+    static bool SetInstructionSet(InstructionSet instructionSet);
+
+    /** 当前CPU是否支持该指令集
+    */
+    static bool IsInstructionSetSupported(InstructionSet instructionSet);
+
+    /** 获取指令集的名称
+    */
+    static const char* GetInstructionSetName(InstructionSet instructionSet);
+};
+
+} // namespace ui
+
+#endif // UI_RENDER_PIXEL_KERNELS_H_
@@ -1,115 +1,217 @@
 #include "RenderCache.h"
-#include "duilib/Core/Control.h"
+#include "duilib/Core/Box.h"
+#include "duilib/Core/Window.h"
+#include "duilib/Core/GlobalManager.h"
 #include "duilib/Render/IRender.h"
-#include "duilib/Core/UiRect.h"
 
-namespace ui 
+namespace ui
 {
 
+//图层缓存的默认内存预算：64MB
+static const size_t kDefaultMaxCacheBytes = 64 * 1024 * 1024;
+
 RenderCache& RenderCache::Instance()
 {
     static RenderCache instance;
     return instance;
 }
 
-RenderCache::RenderCache() : m_enabled(true), m_currentRender(nullptr) {}
+RenderCache::RenderCache():
+    m_nCacheBytes(0),
+    m_nMaxCacheBytes(kDefaultMaxCacheBytes),
+    m_nPaintDepth(0),
+    m_bEnabled(true)
+{
+}
 
 RenderCache::~RenderCache() = default;
 
-void RenderCache::Invalidate(Control* control)
+void RenderCache::Invalidate(const PlaceHolder* pControl)
 {
-    if (!m_enabled || !control) return;
-    
-    std::lock_guard<std::mutex> lock(m_mutex);
-    m_dirtyControls.insert(control);
-    
-    auto it = m_cache.find(control);
-    if (it != m_cache.end()) {
-        it->second.dirty = true;
+    if (m_cache.empty()) {
+        return;
+    }
+    //子控件的内容绘制在祖先控件的图层中，所以需要同时标记祖先控件的图层
+    const PlaceHolder* pItem = pControl;
+    while (pItem != nullptr) {
+        auto iter = m_cache.find(pItem);
+        if (iter != m_cache.end()) {
+            iter->second.m_bDirty = true;
+        }
+        pItem = pItem->GetParent();
     }
 }
 
 void RenderCache::InvalidateAll()
 {
-    if (!m_enabled) return;
-    
-    std::lock_guard<std::mutex> lock(m_mutex);
-    for (auto& pair : m_cache) {
-        pair.second.dirty = true;
-        m_dirtyControls.insert(pair.first);
+    for (auto& iter : m_cache) {
+        iter.second.m_bDirty = true;
+    }
+}
+
+void RenderCache::InvalidateWindow(const Window* pWindow)
+{
+    for (auto& iter : m_cache) {
+        if (iter.first->GetWindow() == pWindow) {
+            iter.second.m_bDirty = true;
+        }
     }
 }
 
-bool RenderCache::IsDirty(Control* control) const
+bool RenderCache::IsDirty(const Control* pControl) const
 {
-    if (!m_enabled || !control) return true;
-    
-    std::lock_guard<std::mutex> lock(m_mutex);
-    auto it = m_cache.find(control);
-    if (it != m_cache.end()) {
-        return it->second.dirty;
+    auto iter = m_cache.find(pControl);
+    if (iter != m_cache.end()) {
+        return iter->second.m_bDirty;
     }
     return true;
 }
 
-void RenderCache::BeginPaint(IRender* render, const UiRect& clipRect)
+void RenderCache::BeginPaint()
 {
-    m_currentRender = render;
+    ++m_nPaintDepth;
 }
 
 void RenderCache::EndPaint()
 {
-    m_currentRender = nullptr;
+    ASSERT(m_nPaintDepth > 0);
+    if (m_nPaintDepth > 0) {
+        --m_nPaintDepth;
+    }
+    if (m_nPaintDepth == 0) {
+        TrimToBudget();
+    }
 }
 
-bool RenderCache::CanUseCache(Control* control) const
+IRender* RenderCache::GetLayer(Control* pControl, int32_t nWidth, int32_t nHeight, bool& bDirty)
 {
-    if (!m_enabled || !control) return false;
-    
-    std::lock_guard<std::mutex> lock(m_mutex);
-    auto it = m_cache.find(control);
-    return it != m_cache.end() && !it->second.dirty && it->second.bitmap;
+    bDirty = true;
+    if (!m_bEnabled || (pControl == nullptr) || (nWidth <= 0) || (nHeight <= 0)) {
+        return nullptr;
+    }
+    const size_t nBytes = (size_t)nWidth * (size_t)nHeight * 4;
+    if (nBytes > m_nMaxCacheBytes) {
+        //单个图层已经超过内存预算，不使用缓存
+        RemoveLayer(pControl);
+        return nullptr;
+    }
+
+    auto iter = m_cache.find(pControl);
+    if (iter == m_cache.end()) {
+        IRenderFactory* pRenderFactory = GlobalManager::Instance().GetRenderFactory();
+        ASSERT(pRenderFactory != nullptr);
+        if ((pRenderFactory == nullptr) || (pControl->GetWindow() == nullptr)) {
+            return nullptr;
+        }
+        std::unique_ptr<IRender> pLayer(pRenderFactory->CreateRender(pControl->GetWindow()->GetRenderDpi()));
+        if (pLayer == nullptr) {
+            return nullptr;
+        }
+        m_lruList.push_front(pControl);
+        CacheEntry& entry = m_cache[pControl];
+        entry.m_pLayer = std::move(pLayer);
+        entry.m_lruPos = m_lruList.begin();
+        iter = m_cache.find(pControl);
+    }
+    else if (iter->second.m_lruPos != m_lruList.begin()) {
+        m_lruList.splice(m_lruList.begin(), m_lruList, iter->second.m_lruPos);
+    }
+
+    CacheEntry& entry = iter->second;
+    IRender* pLayer = entry.m_pLayer.get();
+    if ((pLayer->GetWidth() != nWidth) || (pLayer->GetHeight() != nHeight)) {
+        m_nCacheBytes -= entry.m_nBytes;
+        entry.m_nBytes = 0;
+        entry.m_bDirty = true;
+        if (!pLayer->Resize(nWidth, nHeight)) {
+            ASSERT(!"RenderCache: pLayer->Resize failed!");
+            RemoveLayer(pControl);
+            return nullptr;
+        }
+        entry.m_nBytes = nBytes;
+        m_nCacheBytes += nBytes;
+    }
+    bDirty = entry.m_bDirty;
+
+    if (m_nPaintDepth == 0) {
+        TrimToBudget();
+    }
+    return pLayer;
 }
 
-void RenderCache::UpdateCache(Control* control, std::shared_ptr<void> bitmap)
+void RenderCache::SetLayerPainted(const Control* pControl)
 {
-    if (!m_enabled || !control) return;
-    
-    std::lock_guard<std::mutex> lock(m_mutex);
-    m_cache[control] = {bitmap, 0, false};
-    m_dirtyControls.erase(control);
+    auto iter = m_cache.find(pControl);
+    if (iter != m_cache.end()) {
+        iter->second.m_bDirty = false;
+    }
 }
 
-std::shared_ptr<void> RenderCache::GetCache(Control* control) const
+void RenderCache::RemoveLayer(const Control* pControl)
 {
-    if (!m_enabled || !control) return nullptr;
-    
-    std::lock_guard<std::mutex> lock(m_mutex);
-    auto it = m_cache.find(control);
-    if (it != m_cache.end() && !it->second.dirty) {
-        return it->second.bitmap;
+    auto iter = m_cache.find(pControl);
+    if (iter != m_cache.end()) {
+        m_nCacheBytes -= iter->second.m_nBytes;
+        m_lruList.erase(iter->second.m_lruPos);
+        m_cache.erase(iter);
     }
-    return nullptr;
 }
 
 void RenderCache::Clear()
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
     m_cache.clear();
-    m_dirtyControls.clear();
+    m_lruList.clear();
+    m_nCacheBytes = 0;
 }
 
-void RenderCache::SetCacheEnabled(bool enabled)
+void RenderCache::SetCacheEnabled(bool bEnabled)
 {
-    m_enabled = enabled;
-    if (!enabled) {
+    m_bEnabled = bEnabled;
+    if (!bEnabled) {
         Clear();
     }
 }
 
 bool RenderCache::IsCacheEnabled() const
 {
-    return m_enabled;
+    return m_bEnabled;
+}
+
+void RenderCache::SetMaxCacheBytes(size_t nMaxCacheBytes)
+{
+    m_nMaxCacheBytes = nMaxCacheBytes;
+    if (m_nPaintDepth == 0) {
+        TrimToBudget();
+    }
+}
+
+size_t RenderCache::GetMaxCacheBytes() const
+{
+    return m_nMaxCacheBytes;
+}
+
+size_t RenderCache::GetCacheBytes() const
+{
+    return m_nCacheBytes;
+}
+
+size_t RenderCache::GetLayerCount() const
+{
+    return m_cache.size();
+}
+
+void RenderCache::TrimToBudget()
+{
+    while ((m_nCacheBytes > m_nMaxCacheBytes) && !m_lruList.empty()) {
+        const PlaceHolder* pControl = m_lruList.back();
+        auto iter = m_cache.find(pControl);
+        ASSERT(iter != m_cache.end());
+        if (iter != m_cache.end()) {
+            m_nCacheBytes -= iter->second.m_nBytes;
+            m_cache.erase(iter);
+        }
+        m_lruList.pop_back();
+    }
 }
 
 }
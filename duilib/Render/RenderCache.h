@@ -1,65 +1,152 @@
 #ifndef UI_RENDER_RENDER_CACHE_H_
 #define UI_RENDER_RENDER_CACHE_H_
 
-#include <map>
-#include <set>
+#include "duilib/duilib_defs.h"
+#include <unordered_map>
+#include <list>
 #include <memory>
-#include <mutex>
 
-namespace ui 
+namespace ui
 {
 
+class PlaceHolder;
 class Control;
+class Window;
 class IRender;
-class UiRect;
 
-struct CacheEntry
-{
-    std::shared_ptr<void> bitmap;
-    uint64_t timestamp;
-    bool dirty;
-};
-
-class RenderCache
+/** 控件的图层缓存管理器（仅限UI线程使用）
+*   设置了图层缓存的控件（XML属性：cache="true"），将自身及子控件完整绘制到一个独立的图层中，
+*   后续绘制时，若图层未被标记为脏（控件或其子控件调用了Invalidate），则直接将图层合成到目标Render上，
+*   不再重新绘制控件树；所有图层的总内存受预算限制，超出预算时按LRU（最近最少使用）顺序淘汰
+*/
+class UILIB_API RenderCache
 {
 public:
     static RenderCache& Instance();
 
-    void Invalidate(Control* control);
-    
+    /** 标记控件及其所有祖先控件的图层为脏（控件内容变化时调用）
+    * @param [in] pControl 内容发生变化的控件
+    */
+    void Invalidate(const PlaceHolder* pControl);
+
+    /** 标记所有图层为脏
+    */
     void InvalidateAll();
-    
-    bool IsDirty(Control* control) const;
-    
-    void BeginPaint(IRender* render, const UiRect& clipRect);
-    
+
+    /** 标记关联到指定窗口的所有图层为脏
+    */
+    void InvalidateWindow(const Window* pWindow);
+
+    /** 判断控件的图层是否为脏（无图层时也返回true）
+    */
+    bool IsDirty(const Control* pControl) const;
+
+    /** 开始一次窗口绘制（绘制过程中不淘汰图层，避免正在使用的图层被释放）
+    */
+    void BeginPaint();
+
+    /** 结束一次窗口绘制，并按内存预算淘汰图层
+    */
     void EndPaint();
-    
-    bool CanUseCache(Control* control) const;
-    
-    void UpdateCache(Control* control, std::shared_ptr<void> bitmap);
-    
-    std::shared_ptr<void> GetCache(Control* control) const;
-    
+
+    /** 获取控件的图层（若不存在则创建），图层大小与控件大小保持一致
+    * @param [in] pControl 控件接口
+    * @param [in] nWidth 图层宽度
+    * @param [in] nHeight 图层高度
+    * @param [out] bDirty 返回图层内容是否需要重新绘制
+    * @return 返回图层接口，如果缓存功能关闭或者图层大小超过内存预算则返回nullptr，此时应直接绘制
+    */
+    IRender* GetLayer(Control* pControl, int32_t nWidth, int32_t nHeight, bool& bDirty);
+
+    /** 图层绘制完成，标记为非脏状态
+    */
+    void SetLayerPainted(const Control* pControl);
+
+    /** 删除控件的图层
+    */
+    void RemoveLayer(const Control* pControl);
+
+    /** 删除所有图层
+    */
     void Clear();
-    
-    void SetCacheEnabled(bool enabled);
-    
+
+    /** 设置是否开启图层缓存功能
+    */
+    void SetCacheEnabled(bool bEnabled);
+
+    /** 是否开启图层缓存功能
+    */
     bool IsCacheEnabled() const;
 
+    /** 设置图层缓存的内存预算（字节）
+    */
+    void SetMaxCacheBytes(size_t nMaxCacheBytes);
+
+    /** 获取图层缓存的内存预算（字节）
+    */
+    size_t GetMaxCacheBytes() const;
+
+    /** 获取当前所有图层占用的内存（字节）
+    */
+    size_t GetCacheBytes() const;
+
+    /** 获取当前图层的个数
+    */
+    size_t GetLayerCount() const;
+
 private:
     RenderCache();
     ~RenderCache();
     RenderCache(const RenderCache&) = delete;
     RenderCache& operator=(const RenderCache&) = delete;
 
-    std::map<Control*, CacheEntry> m_cache;
-    std::set<Control*> m_dirtyControls;
-    bool m_enabled;
-    mutable std::mutex m_mutex;
-    IRender* m_currentRender;
+    /** 按内存预算淘汰最近最少使用的图层
+    */
+    void TrimToBudget();
+
+private:
+    /** 单个图层的缓存数据
+    */
+    struct CacheEntry
+    {
+        //图层
+        std::unique_ptr<IRender> m_pLayer;
+
+        //图层占用的内存（字节）
+        size_t m_nBytes = 0;
+
+        //是否需要重新绘制
+        bool m_bDirty = true;
+
+        //在LRU链表中的位置
+        std::list<const PlaceHolder*>::iterator m_lruPos;
+    };
+
+    /** 图层缓存数据
+    */
+    std::unordered_map<const PlaceHolder*, CacheEntry> m_cache;
+
+    /** LRU链表，表头为最近使用的图层
+    */
+    std::list<const PlaceHolder*> m_lruList;
+
+    /** 当前所有图层占用的内存（字节）
+    */
+    size_t m_nCacheBytes;
+
+    /** 图层缓存的内存预算（字节）
+    */
+    size_t m_nMaxCacheBytes;
+
+    /** 当前绘制的嵌套层数
+    */
+    int32_t m_nPaintDepth;
+
+    /** 是否开启图层缓存功能
+    */
+    bool m_bEnabled;
 };
 
 }
 
-#endif
+#endif // UI_RENDER_RENDER_CACHE_H_
@@ -0,0 +1,159 @@
+#include "TextMeasureCache.h"
+#include <algorithm>
+
+namespace ui
+{
+
+TextMeasureCache::TextMeasureCache(size_t nMaxStringCount, size_t nMaxGlyphCount):
+    m_nMaxStringCount(nMaxStringCount),
+    m_nMaxGlyphCount(nMaxGlyphCount)
+{
+}
+
+std::shared_ptr<const TextMeasureResult> TextMeasureCache::MeasureText(const UTF16String& text, const MeasureFunction& measureFunc)
+{
+    ASSERT(measureFunc != nullptr);
+    if (measureFunc == nullptr) {
+        return nullptr;
+    }
+    auto iter = m_stringMap.find(UTF16StringView(text));
+    if (iter != m_stringMap.end()) {
+        //移动到链表头部
+        ++m_stats.nStringHits;
+        m_stringList.splice(m_stringList.begin(), m_stringList, iter->second);
+        return iter->second->second;
+    }
+    ++m_stats.nStringMisses;
+
+    std::shared_ptr<TextMeasureResult> spResult = std::make_shared<TextMeasureResult>();
+    DecodeUTF16(text, spResult->codePoints);
+    MeasureMissingGlyphs(spResult->codePoints, measureFunc);
+    spResult->metrics.resize(spResult->codePoints.size());
+    const size_t nCount = spResult->codePoints.size();
+    for (size_t nIndex = 0; nIndex < nCount; ++nIndex) {
+        auto glyphIter = m_glyphs.find(spResult->codePoints[nIndex]);
+        ASSERT(glyphIter != m_glyphs.end());
+        if (glyphIter != m_glyphs.end()) {
+            spResult->metrics[nIndex] = glyphIter->second;
+        }
+    }
+
+    if (m_nMaxStringCount > 0) {
+        m_stringList.emplace_front(text, spResult);
+        m_stringMap[UTF16StringView(m_stringList.front().first)] = m_stringList.begin();
+        while (m_stringList.size() > m_nMaxStringCount) {
+            m_stringMap.erase(UTF16StringView(m_stringList.back().first));
+            m_stringList.pop_back();
+        }
+    }
+    return spResult;
+}
+
+TextGlyphMetrics TextMeasureCache::GetGlyphMetrics(uint32_t codePoint, const MeasureFunction& measureFunc)
+{
+    auto iter = m_glyphs.find(codePoint);
+    if (iter != m_glyphs.end()) {
+        return iter->second;
+    }
+    ASSERT(measureFunc != nullptr);
+    if (measureFunc == nullptr) {
+        return TextGlyphMetrics();
+    }
+    std::vector<uint32_t> codePoints(1, codePoint);
+    MeasureMissingGlyphs(codePoints, measureFunc);
+    iter = m_glyphs.find(codePoint);
+    return (iter != m_glyphs.end()) ? iter->second : TextGlyphMetrics();
+}
+
+std::shared_ptr<const TextMeasureResult> TextMeasureCache::MeasureTextUncached(const UTF16String& text, const MeasureFunction& measureFunc)
+{
+    ASSERT(measureFunc != nullptr);
+    if (measureFunc == nullptr) {
+        return nullptr;
+    }
+    std::shared_ptr<TextMeasureResult> spResult = std::make_shared<TextMeasureResult>();
+    DecodeUTF16(text, spResult->codePoints);
+    spResult->metrics.resize(spResult->codePoints.size());
+    if (!spResult->codePoints.empty()) {
+        measureFunc(spResult->codePoints.data(), spResult->codePoints.size(), spResult->metrics.data());
+    }
+    return spResult;
+}
+
+void TextMeasureCache::DecodeUTF16(const UTF16String& text, std::vector<uint32_t>& codePoints)
+{
+    codePoints.clear();
+    codePoints.reserve(text.size());
+    const size_t nLength = text.size();
+    for (size_t nIndex = 0; nIndex < nLength; ++nIndex) {
+        const uint32_t ch = (uint16_t)text[nIndex];
+        if ((ch >= 0xD800) && (ch <= 0xDBFF)) {
+            //高代理项，与后面的低代理项组成一个字符
+            if ((nIndex + 1) < nLength) {
+                const uint32_t chLow = (uint16_t)text[nIndex + 1];
+                if ((chLow >= 0xDC00) && (chLow <= 0xDFFF)) {
+                    codePoints.push_back(0x10000 + ((ch - 0xD800) << 10) + (chLow - 0xDC00));
+                    ++nIndex;
+                    continue;
+                }
+            }
+            codePoints.push_back(0xFFFD);
+        }
+        else if ((ch >= 0xDC00) && (ch <= 0xDFFF)) {
+            //不成对的低代理项
+            codePoints.push_back(0xFFFD);
+        }
+        else {
+            codePoints.push_back(ch);
+        }
+    }
+}
+
+void TextMeasureCache::Clear()
+{
+    m_glyphs.clear();
+    m_stringMap.clear();
+    m_stringList.clear();
+}
+
+TextMeasureCache::Stats TextMeasureCache::GetStats() const
+{
+    Stats stats = m_stats;
+    stats.nGlyphCount = m_glyphs.size();
+    stats.nStringCount = m_stringList.size();
+    return stats;
+}
+
+void TextMeasureCache::MeasureMissingGlyphs(const std::vector<uint32_t>& codePoints, const MeasureFunction& measureFunc)
+{
+    std::vector<uint32_t> missingCodePoints;
+    for (uint32_t codePoint : codePoints) {
+        if (m_glyphs.find(codePoint) == m_glyphs.end()) {
+            missingCodePoints.push_back(codePoint);
+        }
+    }
+    if (missingCodePoints.empty()) {
+        return;
+    }
+    std::sort(missingCodePoints.begin(), missingCodePoints.end());
+    missingCodePoints.erase(std::unique(missingCodePoints.begin(), missingCodePoints.end()), missingCodePoints.end());
+    if ((m_glyphs.size() + missingCodePoints.size()) > m_nMaxGlyphCount) {
+        //字符缓存超出上限，清空后重新缓存本次需要的所有字符（已缓存的字符串结果不受影响）
+        m_glyphs.clear();
+        missingCodePoints = codePoints;
+        std::sort(missingCodePoints.begin(), missingCodePoints.end());
+        missingCodePoints.erase(std::unique(missingCodePoints.begin(), missingCodePoints.end()), missingCodePoints.end());
+    }
+
+    //所有未缓存的字符一次性度量
+    std::vector<TextGlyphMetrics> metrics(missingCodePoints.size());
+    measureFunc(missingCodePoints.data(), missingCodePoints.size(), metrics.data());
+    ++m_stats.nMeasureCalls;
+    m_stats.nMeasuredGlyphs += missingCodePoints.size();
+
+    for (size_t nIndex = 0; nIndex < missingCodePoints.size(); ++nIndex) {
+        m_glyphs[missingCodePoints[nIndex]] = metrics[nIndex];
+    }
+}
+
+} // namespace ui
@@ -0,0 +1,128 @@
+#ifndef UI_RENDER_TEXT_MEASURE_CACHE_H_
+#define UI_RENDER_TEXT_MEASURE_CACHE_H_
+
+#include "duilib/duilib_defs.h"
+#include <functional>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace ui
+{
+
+/** 一个字符的度量信息（字形编号、步进宽度、绘制边界）
+*/
+struct TextGlyphMetrics
+{
+    uint16_t nGlyphId = 0;      //字形编号
+    float fAdvance = 0;         //步进宽度
+    float fLeft = 0;            //绘制边界（相对于字符原点，斜体字时可能超出步进宽度）
+    float fTop = 0;
+    float fRight = 0;
+    float fBottom = 0;
+};
+
+/** 一段文本的度量结果（代理对作为一个字符）
+*/
+struct TextMeasureResult
+{
+    std::vector<uint32_t> codePoints;           //每个字符的码点
+    std::vector<TextGlyphMetrics> metrics;      //每个字符的度量信息
+};
+
+/** 文本度量缓存（与字体对象绑定，仅限绘制线程使用）
+*   1. 按码点缓存字符的度量信息，未缓存的字符按批次一次性度量
+*   2. 按LRU顺序缓存最近度量过的字符串，重复绘制相同的文本时不需要再逐个字符查找
+*/
+class UILIB_API TextMeasureCache
+{
+public:
+    /** 批量度量字符的回调函数
+    * @param [in] codePoints 需要度量的字符码点
+    * @param [in] nCount 字符个数
+    * @param [out] metrics 返回每个字符的度量信息（已分配nCount个元素）
+    */
+    typedef std::function<void(const uint32_t* codePoints, size_t nCount, TextGlyphMetrics* metrics)> MeasureFunction;
+
+    /** 统计数据
+    */
+    struct Stats
+    {
+        size_t nGlyphCount = 0;         //缓存的字符个数
+        size_t nStringCount = 0;        //缓存的字符串个数
+        uint64_t nStringHits = 0;       //字符串缓存命中次数
+        uint64_t nStringMisses = 0;     //字符串缓存未命中次数
+        uint64_t nMeasureCalls = 0;     //调用度量回调函数的次数
+        uint64_t nMeasuredGlyphs = 0;   //调用度量回调函数度量的字符总数
+    };
+
+public:
+    /** 构造函数
+    * @param [in] nMaxStringCount 缓存的字符串最大个数
+    * @param [in] nMaxGlyphCount 缓存的字符最大个数（超过时清空字符缓存）
+    */
+    explicit TextMeasureCache(size_t nMaxStringCount = 512, size_t nMaxGlyphCount = 65536);
+    TextMeasureCache(const TextMeasureCache&) = delete;
+    TextMeasureCache& operator=(const TextMeasureCache&) = delete;
+
+    /** 度量一段文本（结果被缓存）
+    * @param [in] text 文本内容（UTF16编码）
+    * @param [in] measureFunc 批量度量字符的回调函数
+    * @return 返回度量结果，该结果不会被修改，可以在缓存淘汰后继续使用
+    */
+    std::shared_ptr<const TextMeasureResult> MeasureText(const UTF16String& text, const MeasureFunction& measureFunc);
+
+    /** 获取一个字符的度量信息（结果被缓存）
+    * @param [in] codePoint 字符码点
+    * @param [in] measureFunc 批量度量字符的回调函数
+    */
+    TextGlyphMetrics GetGlyphMetrics(uint32_t codePoint, const MeasureFunction& measureFunc);
+
+    /** 度量一段文本（不使用缓存，所有字符一次性度量）
+    * @param [in] text 文本内容（UTF16编码）
+    * @param [in] measureFunc 批量度量字符的回调函数
+    */
+    static std::shared_ptr<const TextMeasureResult> MeasureTextUncached(const UTF16String& text, const MeasureFunction& measureFunc);
+
+    /** 将UTF16文本拆分为码点（代理对合并为一个码点，不成对的代理项替换为U+FFFD）
+    */
+    static void DecodeUTF16(const UTF16String& text, std::vector<uint32_t>& codePoints);
+
+    /** 清空缓存（字体变化时调用）
+    */
+    void Clear();
+
+    /** 获取统计数据
+    */
+    Stats GetStats() const;
+
+private:
+    /** 度量未缓存的字符，并添加到字符缓存
+    */
+    void MeasureMissingGlyphs(const std::vector<uint32_t>& codePoints, const MeasureFunction& measureFunc);
+
+private:
+    /** 缓存的字符串最大个数，缓存的字符最大个数
+    */
+    size_t m_nMaxStringCount;
+    size_t m_nMaxGlyphCount;
+
+    /** 字符缓存：码点 -> 度量信息
+    */
+    std::unordered_map<uint32_t, TextGlyphMetrics> m_glyphs;
+
+    /** 字符串缓存（LRU顺序，最近使用的在链表头部）
+    */
+    typedef std::pair<UTF16String, std::shared_ptr<const TextMeasureResult>> StringEntry;
+    std::list<StringEntry> m_stringList;
+    std::unordered_map<UTF16StringView, std::list<StringEntry>::iterator> m_stringMap;    //键引用链表中的字符串
+
+    /** 统计数据
+    */
+    Stats m_stats;
+};
+
+} // namespace ui
+
+#endif // UI_RENDER_TEXT_MEASURE_CACHE_H_
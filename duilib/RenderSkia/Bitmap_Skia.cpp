@@ -3,18 +3,22 @@
 
 #include "SkiaHeaderBegin.h"
 #include "include/core/SkBitmap.h"
+#include "include/core/SkImage.h"
 #include "SkiaHeaderEnd.h"
 
 namespace ui
 {
 
-Bitmap_Skia::Bitmap_Skia()
+Bitmap_Skia::Bitmap_Skia():
+    m_pSkImageSnapshot(nullptr),
+    m_nSnapshotGenerationID(0)
 {
     m_pSkBitmap = std::make_unique<SkBitmap>();
 }
 
 Bitmap_Skia::~Bitmap_Skia()
 {
+    ResetImageSnapshot();
     m_pSkBitmap.reset();
 }
 
@@ -25,6 +29,7 @@ bool Bitmap_Skia::Init(uint32_t nWidth, uint32_t nHeight, const void* pPixelBits
     if ((nWidth == 0) || (nHeight == 0)) {
         return false;
     }
+    ResetImageSnapshot();
 
     if (ImageUtil::NeedResizeImage(fImageSizeScale)) {
         //调整图像大小
@@ -77,6 +82,7 @@ bool Bitmap_Skia::InitImage(uint32_t nWidth, uint32_t nHeight, const void* pPixe
     if ((nWidth == 0) || (nHeight == 0)) {
         return false;
     }
+    ResetImageSnapshot();
 
     m_pSkBitmap->reset();
     m_pSkBitmap->setInfo(SkImageInfo::Make(nWidth, nHeight, kN32_SkColorType, static_cast<SkAlphaType>(alphaType)));
@@ -119,6 +125,8 @@ UiSize Bitmap_Skia::GetSize() const
 
 void* Bitmap_Skia::LockPixelBits()
 {
+    //调用方可能修改位图数据，更新位图的生成号，原有的快照在下次使用时重新生成
+    m_pSkBitmap->notifyPixelsChanged();
     void* pPixelBits = nullptr;
     SkPixmap pixmap;
     if (m_pSkBitmap->peekPixels(&pixmap)) {
@@ -138,7 +146,8 @@ void Bitmap_Skia::UnLockPixelBits()
     ASSERT(pPixelBits != nullptr);
     if (pPixelBits != nullptr) {
         UpdateAlphaFlag((uint8_t*)pPixelBits);
-    }    
+    }
+    m_pSkBitmap->notifyPixelsChanged();
 }
 
 IBitmap* Bitmap_Skia::Clone()
@@ -191,4 +200,28 @@ const SkBitmap& Bitmap_Skia::GetSkBitmap() const
     return *m_pSkBitmap.get();
 }
 
+SkImage* Bitmap_Skia::GetSkImageSnapshot() const
+{
+    //位图数据未变化时（生成号相同），复用原有的快照，不再复制位图数据
+    const uint32_t nGenerationID = m_pSkBitmap->getGenerationID();
+    if ((m_pSkImageSnapshot != nullptr) && (m_nSnapshotGenerationID == nGenerationID)) {
+        return m_pSkImageSnapshot;
+    }
+    SkSafeUnref(m_pSkImageSnapshot);
+    m_pSkImageSnapshot = nullptr;
+    SkPixmap pixmap;
+    if (m_pSkBitmap->peekPixels(&pixmap)) {
+        m_pSkImageSnapshot = SkImages::RasterFromPixmapCopy(pixmap).release();
+        m_nSnapshotGenerationID = nGenerationID;
+    }
+    return m_pSkImageSnapshot;
+}
+
+void Bitmap_Skia::ResetImageSnapshot()
+{
+    SkSafeUnref(m_pSkImageSnapshot);
+    m_pSkImageSnapshot = nullptr;
+    m_nSnapshotGenerationID = 0;
+}
+
 } // namespace ui
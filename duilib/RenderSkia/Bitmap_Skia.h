@@ -5,6 +5,7 @@
 
 //Skia相关类的前置声明
 class SkBitmap;
+class SkImage;
 
 namespace ui
 {
@@ -59,7 +60,16 @@ public:
     */
     const SkBitmap& GetSkBitmap() const;
 
+    /** 获取位图数据的只读快照（按位图数据的生成号缓存，位图数据修改前一直复用），可在其他线程中绘制
+    * @return 返回的对象由位图持有，调用方如需保留，需要增加引用计数（sk_ref_sp）
+    */
+    SkImage* GetSkImageSnapshot() const;
+
 private:
+    /** 释放位图数据的只读快照（重新初始化位图或者销毁时调用）
+    */
+    void ResetImageSnapshot();
+
     /** 更新图片的透明通道标志
     */
     void UpdateAlphaFlag(uint8_t* pPixelBits);
@@ -72,6 +82,14 @@ private:
     /** Skia 位图
     */
     std::unique_ptr<SkBitmap> m_pSkBitmap;
+
+    /** 位图数据的只读快照（持有一个引用计数）
+    */
+    mutable SkImage* m_pSkImageSnapshot;
+
+    /** 快照对应的位图数据生成号（SkBitmap::getGenerationID）
+    */
+    mutable uint32_t m_nSnapshotGenerationID;
 };
 
 } // namespace ui
@@ -0,0 +1,40 @@
+#include "DrawStringCache_Skia.h"
+
+namespace ui 
+{
+
+bool DrawStringCache_Skia::IsMatch(const DString& strText, const DrawStringParam& drawParam, const SkFont& skFont) const
+{
+    if (drawParam.pFont == nullptr) {
+        return false;
+    }
+    return (m_textRect == drawParam.textRect) &&
+           (m_uFormat == drawParam.uFormat) &&
+           (m_fSpacingMul == drawParam.fSpacingMul) &&
+           (m_fSpacingAdd == drawParam.fSpacingAdd) &&
+           (m_bUnderline == drawParam.pFont->IsUnderline()) &&
+           (m_bStrikeOut == drawParam.pFont->IsStrikeOut()) &&
+           (m_skFont == skFont) &&
+           (m_text == strText);
+}
+
+void DrawStringCache_Skia::Update(const DString& strText, const DrawStringParam& drawParam, const SkFont& skFont,
+                                  const SkTextBox& skTextBox)
+{
+    m_text = strText;
+    m_textRect = drawParam.textRect;
+    m_uFormat = drawParam.uFormat;
+    m_fSpacingMul = drawParam.fSpacingMul;
+    m_fSpacingAdd = drawParam.fSpacingAdd;
+    m_bUnderline = (drawParam.pFont != nullptr) ? drawParam.pFont->IsUnderline() : false;
+    m_bStrikeOut = (drawParam.pFont != nullptr) ? drawParam.pFont->IsStrikeOut() : false;
+    m_skFont = skFont;
+    skTextBox.makeLayout(&m_layout);
+}
+
+void DrawStringCache_Skia::Draw(SkCanvas* skCanvas, const SkPoint& skPointOrg, const SkPaint& skPaint) const
+{
+    SkTextBox::drawLayout(skCanvas, m_layout, skPointOrg.fX, skPointOrg.fY, skPaint);
+}
+
+} // namespace ui
@@ -0,0 +1,61 @@
+#ifndef UI_RENDER_SKIA_DRAW_STRING_CACHE_H_
+#define UI_RENDER_SKIA_DRAW_STRING_CACHE_H_
+
+#include "duilib/Render/IRender.h"
+#include "duilib/RenderSkia/SkTextBox.h"
+
+#include "SkiaHeaderBegin.h"
+#include "include/core/SkFont.h"
+#include "SkiaHeaderEnd.h"
+
+namespace ui 
+{
+
+/** 文字绘制缓存的Skia实现：保存SkTextBox的排版结果（SkTextBlob）及排版时使用的参数
+*/
+class UILIB_API DrawStringCache_Skia : public IDrawStringCache
+{
+public:
+    /** 缓存是否与当前的文字内容和绘制参数匹配（文字颜色和透明度不影响排版结果）
+    * @param [in] strText 文字内容
+    * @param [in] drawParam 文字绘制相关的参数
+    * @param [in] skFont 当前使用的字体
+    */
+    bool IsMatch(const DString& strText, const DrawStringParam& drawParam, const SkFont& skFont) const;
+
+    /** 更新排版结果
+    * @param [in] strText 文字内容
+    * @param [in] drawParam 文字绘制相关的参数
+    * @param [in] skFont 当前使用的字体
+    * @param [in] skTextBox 已经设置好文字和属性的SkTextBox，绘制区域不含画布原点的偏移
+    */
+    void Update(const DString& strText, const DrawStringParam& drawParam, const SkFont& skFont,
+                const SkTextBox& skTextBox);
+
+    /** 绘制排版结果
+    * @param [in] skCanvas 画布
+    * @param [in] skPointOrg 画布原点
+    * @param [in] skPaint 绘制属性（文字颜色等）
+    */
+    void Draw(SkCanvas* skCanvas, const SkPoint& skPointOrg, const SkPaint& skPaint) const;
+
+private:
+    /** 排版时使用的参数
+    */
+    DString m_text;
+    UiRect m_textRect;
+    uint32_t m_uFormat = 0;
+    float m_fSpacingMul = 1.0f;
+    float m_fSpacingAdd = 0;
+    bool m_bUnderline = false;
+    bool m_bStrikeOut = false;
+    SkFont m_skFont;
+
+    /** 排版结果
+    */
+    SkTextBoxLayout m_layout;
+};
+
+} // namespace ui
+
+#endif // UI_RENDER_SKIA_DRAW_STRING_CACHE_H_
@@ -37,6 +37,7 @@ bool Font_Skia::InitFont(const UiFont& fontInfo)
     }
     m_uiFont = fontInfo;
     ClearSkFont();
+    m_measureCache.Clear();
     return true;
 }
 
@@ -53,5 +54,10 @@ const SkFont* Font_Skia::GetFontHandle()
     return m_skFont;
 }
 
+TextMeasureCache& Font_Skia::GetMeasureCache()
+{
+    return m_measureCache;
+}
+
 } // namespace ui
 
@@ -2,6 +2,7 @@
 #define UI_RENDER_SKIA_FONT_H_
 
 #include "duilib/Render/IRender.h"
+#include "duilib/Render/TextMeasureCache.h"
 
 class SkFont;
 class SkFontMgr;
@@ -52,6 +53,10 @@ public:
     */
     const SkFont* GetFontHandle();
 
+    /** 获取字体的文本度量缓存（字符度量信息和最近度量过的字符串）
+    */
+    TextMeasureCache& GetMeasureCache();
+
 private:
     /** 删除Skia字体
     */
@@ -66,6 +71,9 @@ private:
 
     //字体管理器
     std::shared_ptr<IFontMgr> m_spFontMgr;
+
+    //文本度量缓存
+    TextMeasureCache m_measureCache;
 };
 
 } // namespace ui
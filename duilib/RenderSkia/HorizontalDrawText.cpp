@@ -42,13 +42,50 @@ UTF16String HorizontalDrawText::GetDrawStringUTF16(const DString& strText, bool
 */
 struct THorizontalChar
 {
-    DUTF16Char ch;
-    bool bNewLine;  //是否为换行符
-    SkSize size;    //字符绘制后的宽度和高度
-    SkRect bounds;  //字符绘制后的边界信息
+    SkGlyphID glyph;    //字形编号
+    bool bNewLine;      //是否为换行符
+    SkSize size;        //字符绘制后的宽度和高度
+    SkRect bounds;      //字符绘制后的边界信息
 };
 
-bool HorizontalDrawText::CalculateTextCharBounds(const UTF16String& textUTF16, const SkFont* pSkFont, const SkPaint* skPaint,
+/** 绘制属性是否不影响字符的度量结果（可以使用字体的度量缓存）
+*/
+static bool IsGlyphMetricsCacheable(const SkPaint* skPaint)
+{
+    return (skPaint->getStyle() == SkPaint::kFill_Style) &&
+           (skPaint->getPathEffect() == nullptr) &&
+           (skPaint->getMaskFilter() == nullptr);
+}
+
+/** 生成批量度量字符的函数：一次转换所有字形，并一次获取所有字形的宽度和边界
+*/
+static TextMeasureCache::MeasureFunction MakeGlyphMeasureFunction(const SkFont* pSkFont, const SkPaint* skPaint)
+{
+    return [pSkFont, skPaint](const uint32_t* codePoints, size_t nCount, TextGlyphMetrics* metrics) {
+            static_assert(sizeof(SkUnichar) == sizeof(uint32_t), "SkUnichar must be 32 bits");
+            std::vector<SkGlyphID> glyphs(nCount);
+            std::vector<SkScalar> widths(nCount);
+            std::vector<SkRect> bounds(nCount);
+            pSkFont->textToGlyphs(codePoints, nCount * sizeof(uint32_t), SkTextEncoding::kUTF32,
+                                  SkSpan<SkGlyphID>(glyphs.data(), glyphs.size()));
+            pSkFont->getWidthsBounds(SkSpan<const SkGlyphID>(glyphs.data(), glyphs.size()),
+                                     SkSpan<SkScalar>(widths.data(), widths.size()),
+                                     SkSpan<SkRect>(bounds.data(), bounds.size()),
+                                     skPaint);//斜体字时，边界包含了外延的宽度
+            for (size_t nIndex = 0; nIndex < nCount; ++nIndex) {
+                TextGlyphMetrics& glyphMetrics = metrics[nIndex];
+                glyphMetrics.nGlyphId = glyphs[nIndex];
+                glyphMetrics.fAdvance = widths[nIndex];
+                glyphMetrics.fLeft = bounds[nIndex].fLeft;
+                glyphMetrics.fTop = bounds[nIndex].fTop;
+                glyphMetrics.fRight = bounds[nIndex].fRight;
+                glyphMetrics.fBottom = bounds[nIndex].fBottom;
+            }
+        };
+}
+
+bool HorizontalDrawText::CalculateTextCharBounds(const UTF16String& textUTF16, Font_Skia* pSkiaFont,
+                                                 const SkFont* pSkFont, const SkPaint* skPaint,
                                                  float fFontHeight, std::vector<THorizontalChar>& charRects) const
 {
     if (textUTF16.empty()) {
@@ -58,51 +95,77 @@ bool HorizontalDrawText::CalculateTextCharBounds(const UTF16String& textUTF16, c
     if (fFontHeight <= 0) {
         return false;
     }
-    ASSERT(pSkFont != nullptr);
-    if (pSkFont == nullptr) {
+    ASSERT((pSkiaFont != nullptr) && (pSkFont != nullptr));
+    if ((pSkiaFont == nullptr) || (pSkFont == nullptr)) {
         return false;
     }
     ASSERT(skPaint != nullptr);
     if (skPaint == nullptr) {
         return false;
     }
+
+    //整段文本一次度量（代理对作为一个字符），普通的绘制属性下使用字体的度量缓存
+    const TextMeasureCache::MeasureFunction measureFunc = MakeGlyphMeasureFunction(pSkFont, skPaint);
+    const bool bCacheable = IsGlyphMetricsCacheable(skPaint);
+    std::shared_ptr<const TextMeasureResult> spMeasureResult;
+    if (bCacheable) {
+        spMeasureResult = pSkiaFont->GetMeasureCache().MeasureText(textUTF16, measureFunc);
+    }
+    else {
+        spMeasureResult = TextMeasureCache::MeasureTextUncached(textUTF16, measureFunc);
+    }
+    if ((spMeasureResult == nullptr) || spMeasureResult->codePoints.empty()) {
+        return false;
+    }
+
+    //空格或者不可见字符的显示区域(按小写字母确定)
+    TextGlyphMetrics blankMetrics;
+    bool bBlankMetricsValid = false;
+
     //每个字符绘制所占的矩形范围
+    const size_t nCharCount = spMeasureResult->codePoints.size();
     charRects.clear();
-    charRects.reserve(textUTF16.size());
+    charRects.reserve(nCharCount);
 
     THorizontalChar horizontalChar;
-    for (DUTF16Char ch : textUTF16) {
-        horizontalChar.ch = ch;
-        if (ch == L'\n') {
+    for (size_t nIndex = 0; nIndex < nCharCount; ++nIndex) {
+        const TextGlyphMetrics& glyphMetrics = spMeasureResult->metrics[nIndex];
+        horizontalChar.glyph = glyphMetrics.nGlyphId;
+        if (spMeasureResult->codePoints[nIndex] == L'\n') {
             //换行符
             horizontalChar.bNewLine = true;
             horizontalChar.size = SkSize();
             horizontalChar.bounds = SkRect();
             charRects.push_back(horizontalChar);
+            continue;
         }
-        else {
-            horizontalChar.bNewLine = false;
-            SkScalar fTextWidth = pSkFont->measureText(&ch,
-                                                       sizeof(DUTF16Char),
-                                                       SkTextEncoding::kUTF16,
-                                                       &horizontalChar.bounds,//斜体字时，这个宽度包含了外延的宽度
-                                                       skPaint);
-            if ((horizontalChar.bounds.width() <= 0) || (horizontalChar.bounds.height() <= 0)) {
-                //空格或者不可见字符(按小写字母确定显示区域)
-                ch = 'a';
-                fTextWidth = pSkFont->measureText(&ch,
-                                                  sizeof(DUTF16Char),
-                                                  SkTextEncoding::kUTF16,
-                                                  &horizontalChar.bounds,//斜体字时，这个宽度包含了外延的宽度
-                                                  skPaint);
-            }
 
-            //用字体高度作为字的高度，所有字都等高
-            horizontalChar.size = SkSize::Make(std::max(fTextWidth, horizontalChar.bounds.width()), (SkScalar)fFontHeight);
-            charRects.push_back(horizontalChar);
+        horizontalChar.bNewLine = false;
+        SkScalar fTextWidth = glyphMetrics.fAdvance;
+        horizontalChar.bounds = SkRect::MakeLTRB(glyphMetrics.fLeft, glyphMetrics.fTop,
+                                                 glyphMetrics.fRight, glyphMetrics.fBottom);
+        if ((horizontalChar.bounds.width() <= 0) || (horizontalChar.bounds.height() <= 0)) {
+            //空格或者不可见字符(按小写字母确定显示区域)
+            if (!bBlankMetricsValid) {
+                bBlankMetricsValid = true;
+                if (bCacheable) {
+                    blankMetrics = pSkiaFont->GetMeasureCache().GetGlyphMetrics('a', measureFunc);
+                }
+                else {
+                    const uint32_t chBlank = 'a';
+                    measureFunc(&chBlank, 1, &blankMetrics);
+                }
+            }
+            fTextWidth = blankMetrics.fAdvance;
+            horizontalChar.bounds = SkRect::MakeLTRB(blankMetrics.fLeft, blankMetrics.fTop,
+                                                     blankMetrics.fRight, blankMetrics.fBottom);
         }
+
+        //用字体高度作为字的高度，所有字都等高
+        horizontalChar.size = SkSize::Make(std::max(fTextWidth, horizontalChar.bounds.width()), (SkScalar)fFontHeight);
+        charRects.push_back(horizontalChar);
     }
-    return (charRects.size() == textUTF16.size());
+    return !charRects.empty();
 }
 
 SkRect HorizontalDrawText::CalculateHorizontalTextBounds(const std::vector<THorizontalChar>& charRects, int32_t width, bool bSingleLineMode,
@@ -280,27 +343,30 @@ SkRect HorizontalDrawText::CalculateHorizontalTextBounds(const std::vector<THori
     return SkRect::MakeWH(maxX, maxY);
 }
 
-float HorizontalDrawText::CalculateDefaultCharWidth(const SkFont* pSkFont, const SkPaint* skPaint) const
+float HorizontalDrawText::CalculateDefaultCharWidth(Font_Skia* pSkiaFont, const SkFont* pSkFont, const SkPaint* skPaint) const
 {
-    if ((pSkFont == nullptr) || (skPaint == nullptr)) {
+    if ((pSkiaFont == nullptr) || (pSkFont == nullptr) || (skPaint == nullptr)) {
         return 0;
     }
-    DUTF16Char ch = L'W';
-    SkRect bounds;
-    SkScalar fCharWidth = pSkFont->measureText(&ch,
-                                               sizeof(DUTF16Char),
-                                               SkTextEncoding::kUTF16,
-                                               &bounds,//斜体字时，这个宽度包含了外延的宽度
-                                               skPaint);
+    const TextMeasureCache::MeasureFunction measureFunc = MakeGlyphMeasureFunction(pSkFont, skPaint);
+    TextGlyphMetrics glyphMetrics;
+    if (IsGlyphMetricsCacheable(skPaint)) {
+        glyphMetrics = pSkiaFont->GetMeasureCache().GetGlyphMetrics('W', measureFunc);
+    }
+    else {
+        const uint32_t ch = 'W';
+        measureFunc(&ch, 1, &glyphMetrics);
+    }
+    SkScalar fCharWidth = glyphMetrics.fAdvance;
 
     SkScalar nWidthDiff = 0;
-    if (bounds.fLeft < 0) {
+    if (glyphMetrics.fLeft < 0) {
         //斜体字左侧溢出
-        nWidthDiff += -bounds.fLeft;
+        nWidthDiff += -glyphMetrics.fLeft;
     }
-    if (bounds.fRight > fCharWidth) {
+    if (glyphMetrics.fRight > fCharWidth) {
         //斜体字右侧溢出
-        nWidthDiff += bounds.fRight - fCharWidth;
+        nWidthDiff += glyphMetrics.fRight - fCharWidth;
     }
     fCharWidth += nWidthDiff;
     return fCharWidth;
@@ -351,16 +417,12 @@ UiRect HorizontalDrawText::MeasureString(const DString& strText, const MeasureSt
     const UTF16String textUTF16 = GetDrawStringUTF16(strText, bSingleLineMode);
 
     std::vector<THorizontalChar> charRects;
-    if (!CalculateTextCharBounds(textUTF16, pSkFont, &skPaint, (float)fFontHeight, charRects)) {
-        return UiRect();
-    }
-    ASSERT(charRects.size() == textUTF16.size());
-    if (charRects.size() != textUTF16.size()) {
+    if (!CalculateTextCharBounds(textUTF16, pSkiaFont, pSkFont, &skPaint, (float)fFontHeight, charRects)) {
         return UiRect();
     }
 
     //默认字符的宽度
-    float fDefaultCharWidth = CalculateDefaultCharWidth(pSkFont, &skPaint);
+    float fDefaultCharWidth = CalculateDefaultCharWidth(pSkiaFont, pSkFont, &skPaint);
     SkRect skTextBounds = CalculateHorizontalTextBounds(charRects, measureParam.rectSize, bSingleLineMode,
                                                         measureParam.fSpacingMul, measureParam.fSpacingAdd,
                                                         measureParam.fWordSpacing,
@@ -458,16 +520,12 @@ void HorizontalDrawText::DrawString(const DString& strText, const DrawStringPara
     const UTF16String textUTF16 = GetDrawStringUTF16(strText, bSingleLineMode);
 
     std::vector<THorizontalChar> charRects;
-    if (!CalculateTextCharBounds(textUTF16, pSkFont, &skPaint, (float)fFontHeight, charRects)) {
-        return;
-    }
-    ASSERT(charRects.size() == textUTF16.size());
-    if (charRects.size() != textUTF16.size()) {
+    if (!CalculateTextCharBounds(textUTF16, pSkiaFont, pSkFont, &skPaint, (float)fFontHeight, charRects)) {
         return;
     }
 
     // 默认字符宽度
-    float fDefaultCharWidth = CalculateDefaultCharWidth(pSkFont, &skPaint);
+    float fDefaultCharWidth = CalculateDefaultCharWidth(pSkiaFont, pSkFont, &skPaint);
 
     std::vector<std::vector<int32_t>> rowColumns;
     std::vector<float> rowHeights;
@@ -485,7 +543,7 @@ void HorizontalDrawText::DrawString(const DString& strText, const DrawStringPara
     //记录每个字符的绘制位置，后续还需要处理对齐方式
     struct TDrawCharPos
     {
-        DUTF16Char ch = 0;          //字符
+        SkGlyphID glyph = 0;        //字形编号
         int32_t nRowIndex = 0;      //行序号
         int32_t nColumnIndex = 0;   //列序号
         SkScalar xPos = 0;          //绘制时的X坐标
@@ -521,7 +579,7 @@ void HorizontalDrawText::DrawString(const DString& strText, const DrawStringPara
             const THorizontalChar& horizontalChar = charRects[nCharIndex];
 
             //记录该字符的绘制位置，处理对齐方式以后再绘制
-            charPos.ch = horizontalChar.ch;
+            charPos.glyph = horizontalChar.glyph;
             charPos.nRowIndex = (int32_t)nRowIndex;
             charPos.nColumnIndex = (int32_t)nColIndex;
             charPos.chWidth = (int32_t)horizontalChar.size.width();
@@ -728,7 +786,7 @@ void HorizontalDrawText::DrawString(const DString& strText, const DrawStringPara
         }
 
         charPos.bDrew = true;
-        skCanvas->drawSimpleText(&charPos.ch, sizeof(charPos.ch), SkTextEncoding::kUTF16,
+        skCanvas->drawSimpleText(&charPos.glyph, sizeof(charPos.glyph), SkTextEncoding::kGlyphID,
                                  charPos.xPos, charPos.yPos,
                                  *pSkFont, skPaint);
     }
@@ -12,6 +12,8 @@ struct SkPoint;
 
 namespace ui
 {
+class Font_Skia;
+
 /** 横向绘制文本的字符属性
 */
 struct THorizontalChar;
@@ -44,13 +46,15 @@ private:
     */
     UTF16String GetDrawStringUTF16(const DString& strText, bool bSingleLineMode) const;
 
-    /** 计算每个字符的绘制所占的矩形范围
+    /** 计算每个字符的绘制所占的矩形范围（代理对作为一个字符，整段文本批量度量，并使用字体的度量缓存）
     * @param [in] textUTF16 字符串
+    * @param [in] pSkiaFont 字体接口（提供度量缓存）
     * @param [in] pSkFont 字体
     * @param [in] skPaint 绘制属性
     * @param [in] fFontHeight 字体高度
     */
-    bool CalculateTextCharBounds(const UTF16String& textUTF16, const SkFont* pSkFont, const SkPaint* skPaint,
+    bool CalculateTextCharBounds(const UTF16String& textUTF16, Font_Skia* pSkiaFont,
+                                 const SkFont* pSkFont, const SkPaint* skPaint,
                                  float fFontHeight, std::vector<THorizontalChar>& charRects) const;
 
     /** 计算横向文本（从左到右、从上到下）的绘制区域总矩形
@@ -75,7 +79,7 @@ private:
 
     /** 计算默认字符的宽度(用于空行的宽度计算)
     */
-    float CalculateDefaultCharWidth(const SkFont* pSkFont, const SkPaint* skPaint) const;
+    float CalculateDefaultCharWidth(Font_Skia* pSkiaFont, const SkFont* pSkFont, const SkPaint* skPaint) const;
 
 private:
     /** 绘制的画布
@@ -9,6 +9,7 @@
 #include "duilib/RenderSkia/Matrix_Skia.h"
 #include "duilib/RenderSkia/Font_Skia.h"
 #include "duilib/RenderSkia/SkTextBox.h"
+#include "duilib/RenderSkia/DrawStringCache_Skia.h"
 #include "duilib/RenderSkia/DrawSkiaImage.h"
 #include "duilib/Render/BitmapAlpha.h"
 
@@ -24,6 +25,7 @@
 #include "include/core/SkImage.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkSurface.h"
+#include "include/core/SkDrawable.h"
 #include "include/core/SkPaint.h"
 #include "include/core/SkPath.h"
 #include "include/core/SkRegion.h"
@@ -43,6 +45,55 @@
 
 namespace ui {
 
+/** 延迟执行的画布操作：录制绘制命令时，直接操作像素等无法录制的操作，在回放绘制命令时执行
+*/
+class CanvasOperationDrawable: public SkDrawable
+{
+public:
+    CanvasOperationDrawable(const std::function<void(SkCanvas*)>& canvasOperation, const SkRect& rcBounds):
+        m_canvasOperation(canvasOperation),
+        m_rcBounds(rcBounds)
+    {
+    }
+
+protected:
+    virtual SkRect onGetBounds() override
+    {
+        return m_rcBounds;
+    }
+
+    virtual void onDraw(SkCanvas* skCanvas) override
+    {
+        if ((skCanvas != nullptr) && m_canvasOperation) {
+            m_canvasOperation(skCanvas);
+        }
+    }
+
+private:
+    std::function<void(SkCanvas*)> m_canvasOperation;
+    SkRect m_rcBounds;
+};
+
+/** 生成绘制位图所用的图片
+* @param [in] bSnapshot true表示使用位图数据的只读快照（录制的绘制命令可能在其他线程中回放，不能直接引用位图数据）
+*/
+static sk_sp<SkImage> MakeBitmapImage(const Bitmap_Skia* skiaBitmap, bool bSnapshot)
+{
+    const SkBitmap& skSrcBitmap = skiaBitmap->GetSkBitmap();
+    SkPixmap skSrcPixmap;
+    sk_sp<SkImage> skImage;
+    if (bSnapshot) {
+        skImage = sk_ref_sp(skiaBitmap->GetSkImageSnapshot());
+    }
+    else if (skSrcBitmap.peekPixels(&skSrcPixmap)) {
+        skImage = SkImages::RasterFromPixmap(skSrcPixmap, nullptr, nullptr);
+    }
+    if (skImage == nullptr) {
+        skImage = skSrcBitmap.asImage();
+    }
+    return skImage;
+}
+
 Render_Skia::Render_Skia():
     m_saveCount(0)
 {
@@ -91,7 +142,7 @@ void* Render_Skia::GetPixelBits() const
             pPixelBits = pixmap.writable_addr();
         }
     }
-    if (pPixelBits == nullptr) {
+    if ((pPixelBits == nullptr) && !IsPaintRecording()) {
         ASSERT(GetRenderBackendType() != RenderBackendType::kRaster_BackendType);
     }
     return pPixelBits;
@@ -99,45 +150,43 @@ void* Render_Skia::GetPixelBits() const
 
 void Render_Skia::Clear(const UiColor& uiColor)
 {
-    void* pPixelBits = GetPixelBits();
-    if (pPixelBits != nullptr) {
-        uint32_t nARGB = uiColor.GetARGB();
-        if (nARGB == 0) {
-            ::memset(pPixelBits, uiColor.GetARGB(), GetWidth() * GetHeight() * sizeof(uint32_t));
-        }
-        else {
-            constexpr const int32_t nLeft = 0;
-            constexpr const int32_t nTop = 0;
-            const int32_t nRight = std::max(GetWidth(), 0);
-            const int32_t nBottom = std::max(GetHeight(), 0);
-            const int32_t nWidth = nRight - nLeft;
-            for (int32_t i = nTop; i < nBottom; i++) {
-                for (int32_t j = nLeft; j < nRight; j++) {
-                    uint32_t* color = (uint32_t*)pPixelBits + (i * nWidth + j);
-                    *color = nARGB;
+    const uint32_t nARGB = uiColor.GetARGB();
+    DrawPixelOperation([nARGB](void* pPixelBits, int32_t nImageWidth, int32_t nImageHeight) {
+            if (nARGB == 0) {
+                ::memset(pPixelBits, nARGB, nImageWidth * nImageHeight * sizeof(uint32_t));
+            }
+            else {
+                constexpr const int32_t nLeft = 0;
+                constexpr const int32_t nTop = 0;
+                const int32_t nRight = std::max(nImageWidth, 0);
+                const int32_t nBottom = std::max(nImageHeight, 0);
+                const int32_t nWidth = nRight - nLeft;
+                for (int32_t i = nTop; i < nBottom; i++) {
+                    for (int32_t j = nLeft; j < nRight; j++) {
+                        uint32_t* color = (uint32_t*)pPixelBits + (i * nWidth + j);
+                        *color = nARGB;
+                    }
                 }
             }
-        }
-    }
+        });
 }
 
 void Render_Skia::ClearRect(const UiRect& rcDirty, const UiColor& uiColor)
 {
-    void* pPixelBits = GetPixelBits();
-    if (pPixelBits != nullptr) {
-        uint32_t nARGB = uiColor.GetARGB();
-        const int32_t nLeft = std::max((int32_t)rcDirty.left, 0);
-        const int32_t nTop = std::max((int32_t)rcDirty.top, 0);
-        const int32_t nRight = std::min((int32_t)rcDirty.right, (int32_t)GetWidth());
-        const int32_t nBottom = std::min((int32_t)rcDirty.bottom, (int32_t)GetHeight());
-        const int32_t nWidth = nRight - nLeft;
-        for (int32_t i = nTop; i < nBottom; i++) {
-            for (int32_t j = nLeft; j < nRight; j++) {
-                uint32_t* color = (uint32_t*)pPixelBits + (i * nWidth + j);
-                *color = nARGB;
+    const uint32_t nARGB = uiColor.GetARGB();
+    DrawPixelOperation([nARGB, rcDirty](void* pPixelBits, int32_t nImageWidth, int32_t nImageHeight) {
+            const int32_t nLeft = std::max((int32_t)rcDirty.left, 0);
+            const int32_t nTop = std::max((int32_t)rcDirty.top, 0);
+            const int32_t nRight = std::min((int32_t)rcDirty.right, nImageWidth);
+            const int32_t nBottom = std::min((int32_t)rcDirty.bottom, nImageHeight);
+            const int32_t nWidth = nRight - nLeft;
+            for (int32_t i = nTop; i < nBottom; i++) {
+                for (int32_t j = nLeft; j < nRight; j++) {
+                    uint32_t* color = (uint32_t*)pPixelBits + (i * nWidth + j);
+                    *color = nARGB;
+                }
             }
-        }
-    }
+        });
 }
 
 IBitmap* Render_Skia::MakeImageSnapshot()
@@ -147,6 +196,8 @@ IBitmap* Render_Skia::MakeImageSnapshot()
     if ((nWidth <= 0) || (nHeight <= 0)) {
         return nullptr;
     }
+    //录制绘制命令时，画布中没有像素数据
+    ASSERT(!IsPaintRecording());
     void* pPixelBits = GetPixelBits();
     if (pPixelBits == nullptr) {
         return nullptr;
@@ -161,29 +212,59 @@ IBitmap* Render_Skia::MakeImageSnapshot()
 
 void Render_Skia::ClearAlpha(const UiRect& rcDirty, uint8_t alpha)
 {
-    void* pPixelBits = GetPixelBits();
-    if (pPixelBits != nullptr) {
-        BitmapAlpha bitmapAlpha((uint8_t*)pPixelBits, GetWidth(), GetHeight(), sizeof(uint32_t));
-        bitmapAlpha.ClearAlpha(rcDirty, alpha);
-    }
+    DrawPixelOperation([rcDirty, alpha](void* pPixelBits, int32_t nImageWidth, int32_t nImageHeight) {
+            BitmapAlpha bitmapAlpha((uint8_t*)pPixelBits, nImageWidth, nImageHeight, sizeof(uint32_t));
+            bitmapAlpha.ClearAlpha(rcDirty, alpha);
+        });
 }
 
 void Render_Skia::RestoreAlpha(const UiRect& rcDirty, const UiPadding& rcShadowPadding, uint8_t alpha)
 {
-    void* pPixelBits = GetPixelBits();
-    if (pPixelBits != nullptr) {
-        BitmapAlpha bitmapAlpha((uint8_t*)pPixelBits, GetWidth(), GetHeight(), sizeof(uint32_t));
-        bitmapAlpha.RestoreAlpha(rcDirty, rcShadowPadding, alpha);
-    }
+    DrawPixelOperation([rcDirty, rcShadowPadding, alpha](void* pPixelBits, int32_t nImageWidth, int32_t nImageHeight) {
+            BitmapAlpha bitmapAlpha((uint8_t*)pPixelBits, nImageWidth, nImageHeight, sizeof(uint32_t));
+            bitmapAlpha.RestoreAlpha(rcDirty, rcShadowPadding, alpha);
+        });
 }
 
 void Render_Skia::RestoreAlpha(const UiRect& rcDirty, const UiPadding& rcShadowPadding)
 {
-    void* pPixelBits = GetPixelBits();
-    if (pPixelBits != nullptr) {
-        BitmapAlpha bitmapAlpha((uint8_t*)pPixelBits, GetWidth(), GetHeight(), sizeof(uint32_t));
-        bitmapAlpha.RestoreAlpha(rcDirty, rcShadowPadding);
+    DrawPixelOperation([rcDirty, rcShadowPadding](void* pPixelBits, int32_t nImageWidth, int32_t nImageHeight) {
+            BitmapAlpha bitmapAlpha((uint8_t*)pPixelBits, nImageWidth, nImageHeight, sizeof(uint32_t));
+            bitmapAlpha.RestoreAlpha(rcDirty, rcShadowPadding);
+        });
+}
+
+bool Render_Skia::IsPaintRecording() const
+{
+    return false;
+}
+
+void Render_Skia::DrawCanvasOperation(const std::function<void(SkCanvas*)>& canvasOperation)
+{
+    SkCanvas* skCanvas = GetSkCanvas();
+    ASSERT(skCanvas != nullptr);
+    if ((skCanvas == nullptr) || !canvasOperation) {
+        return;
+    }
+    if (IsPaintRecording()) {
+        //录制绘制命令：在回放时执行（回放时的画布为实际的位图画布）
+        sk_sp<SkDrawable> skDrawable = sk_make_sp<CanvasOperationDrawable>(canvasOperation, SkRect::MakeIWH(GetWidth(), GetHeight()));
+        skCanvas->drawDrawable(skDrawable.get());
     }
+    else {
+        canvasOperation(skCanvas);
+    }
+}
+
+void Render_Skia::DrawPixelOperation(const std::function<void(void* pPixelBits, int32_t nImageWidth, int32_t nImageHeight)>& pixelOperation)
+{
+    DrawCanvasOperation([pixelOperation](SkCanvas* skCanvas) {
+            SkPixmap pixmap;
+            if (skCanvas->peekPixels(&pixmap) && (pixmap.writable_addr() != nullptr) &&
+                (pixmap.rowBytes() == pixmap.width() * sizeof(uint32_t))) {
+                pixelOperation(pixmap.writable_addr(), pixmap.width(), pixmap.height());
+            }
+        });
 }
 
 UiPoint Render_Skia::OffsetWindowOrg(UiPoint ptOffset)
@@ -520,15 +601,7 @@ void Render_Skia::DrawImage(const UiRect& rcPaint, IBitmap* pBitmap,
         return;
     }
     
-    const SkBitmap& skSrcBitmap = skiaBitmap->GetSkBitmap();
-    SkPixmap skSrcPixmap;
-    sk_sp<SkImage> skImage;
-    if (skSrcBitmap.peekPixels(&skSrcPixmap)) {
-        skImage = SkImages::RasterFromPixmap(skSrcPixmap, nullptr, nullptr);
-    }
-    if (skImage == nullptr) {
-        skImage = skSrcBitmap.asImage();
-    }
+    sk_sp<SkImage> skImage = MakeBitmapImage(skiaBitmap, IsPaintRecording());
 
     UiRect rcTemp;
     UiRect rcDrawSource;
@@ -896,15 +969,7 @@ void Render_Skia::DrawImageRect(const UiRect& rcPaint, IBitmap* pBitmap,
     if (skiaBitmap == nullptr) {
         return;
     }
-    const SkBitmap& skSrcBitmap = skiaBitmap->GetSkBitmap();
-    SkPixmap skSrcPixmap;
-    sk_sp<SkImage> skImage;
-    if (skSrcBitmap.peekPixels(&skSrcPixmap)) {
-        skImage = SkImages::RasterFromPixmap(skSrcPixmap, nullptr, nullptr);
-    }
-    if (skImage == nullptr) {
-        skImage = skSrcBitmap.asImage();
-    }
+    sk_sp<SkImage> skImage = MakeBitmapImage(skiaBitmap, IsPaintRecording());
 
     bool isMatrixSet = false;
     if (pMatrix != nullptr) {
@@ -1670,6 +1735,94 @@ void Render_Skia::DrawString(const DString& strText, const DrawStringParam& draw
 
     //设置绘制属性
     SkTextBox skTextBox;
+    InitTextBox(skTextBox, drawParam, rcSkDest);
+    skTextBox.draw(skCanvas, 
+                   (const char*)strText.c_str(), 
+                   strText.size() * sizeof(DString::value_type),
+                   textEncoding, 
+                   *pSkFont,
+                   skPaint);
+}
+
+void Render_Skia::DrawString(const DString& strText, const DrawStringParam& drawParam,
+                             IDrawStringCachePtr& spDrawCache)
+{
+    if ((GetWidth() <= 0) || (GetHeight() <= 0)) {
+        //这种情况是窗口大小为0的情况，返回，不加断言
+        return;
+    }
+    if ((drawParam.uFormat & TEXT_VERTICAL) ||
+        (drawParam.uFormat & TEXT_HJUSTIFY) || (drawParam.fWordSpacing > 0.0001f)) {
+        //纵向文本、两端对齐或者设置了字间距的文本，不使用缓存
+        spDrawCache.reset();
+        return DrawString(strText, drawParam);
+    }
+
+    PerformanceStat statPerformance(_T("Render_Skia::DrawString(Cache)"));
+    ASSERT(!strText.empty());
+    if (strText.empty()) {
+        return;
+    }
+    if (drawParam.textRect.IsEmpty()) {
+        return;
+    }
+    ASSERT(drawParam.pFont != nullptr);
+    if (drawParam.pFont == nullptr) {
+        return;
+    }
+
+    SkCanvas* skCanvas = GetSkCanvas();
+    ASSERT(skCanvas != nullptr);
+    if (skCanvas == nullptr) {
+        return;
+    }
+
+    //获取字体接口
+    Font_Skia* pSkiaFont = dynamic_cast<Font_Skia*>(drawParam.pFont);
+    ASSERT(pSkiaFont != nullptr);
+    if (pSkiaFont == nullptr) {
+        return;
+    }
+    const SkFont* pSkFont = pSkiaFont->GetFontHandle();
+    ASSERT(pSkFont != nullptr);
+    if (pSkFont == nullptr) {
+        return;
+    }
+
+    //绘制属性设置
+    SkPaint skPaint = *m_pSkPaint;
+    skPaint.setARGB(drawParam.dwTextColor.GetA(),
+                    drawParam.dwTextColor.GetR(),
+                    drawParam.dwTextColor.GetG(),
+                    drawParam.dwTextColor.GetB());
+    if (drawParam.uFade != 0xFF) {
+        skPaint.setAlpha(drawParam.uFade);
+    }
+
+    DrawStringCache_Skia* pDrawCache = dynamic_cast<DrawStringCache_Skia*>(spDrawCache.get());
+    if ((pDrawCache == nullptr) || !pDrawCache->IsMatch(strText, drawParam, *pSkFont)) {
+        //重新排版：绘制区域不含画布原点的偏移，以便画布原点变化（如滚动）时仍可使用排版结果
+        SkIRect rcSkDestI = { drawParam.textRect.left, drawParam.textRect.top,
+                              drawParam.textRect.right, drawParam.textRect.bottom };
+        SkTextBox skTextBox;
+        InitTextBox(skTextBox, drawParam, SkRect::Make(rcSkDestI));
+        skTextBox.setText((const char*)strText.c_str(),
+                          strText.size() * sizeof(DString::value_type),
+                          GetTextEncoding(),
+                          *pSkFont,
+                          skPaint);
+        if (pDrawCache == nullptr) {
+            std::shared_ptr<DrawStringCache_Skia> spSkiaDrawCache = std::make_shared<DrawStringCache_Skia>();
+            pDrawCache = spSkiaDrawCache.get();
+            spDrawCache = spSkiaDrawCache;
+        }
+        pDrawCache->Update(strText, drawParam, *pSkFont, skTextBox);
+    }
+    pDrawCache->Draw(skCanvas, *m_pSkPointOrg, skPaint);
+}
+
+void Render_Skia::InitTextBox(SkTextBox& skTextBox, const DrawStringParam& drawParam, const SkRect& rcSkDest) const
+{
     skTextBox.setBox(rcSkDest);
     if (drawParam.uFormat & DrawStringFormat::TEXT_SINGLELINE) {
         //单行文本
@@ -1726,12 +1879,6 @@ void Render_Skia::DrawString(const DString& strText, const DrawStringParam& draw
         //纵向对齐：上对齐
         skTextBox.setSpacingAlign(SkTextBox::kStart_SpacingAlign);
     }
-    skTextBox.draw(skCanvas, 
-                   (const char*)strText.c_str(), 
-                   strText.size() * sizeof(DString::value_type),
-                   textEncoding, 
-                   *pSkFont,
-                   skPaint);
 }
 
 UiRect Render_Skia::MeasureString(const DString& strText, const MeasureStringParam& measureParam)
@@ -2098,6 +2245,11 @@ bool Render_Skia::ReadPixels(const UiRect& rc, void* dstPixels, size_t dstPixels
     if (skCanvas == nullptr) {
         return false;
     }
+    //录制绘制命令时，画布中没有像素数据
+    ASSERT(!IsPaintRecording());
+    if (IsPaintRecording()) {
+        return false;
+    }
 
     SkBitmap skBitmap;
     skBitmap.setInfo(SkImageInfo::Make(rc.Width(), rc.Height(), SkColorType::kN32_SkColorType, SkAlphaType::kPremul_SkAlphaType));
@@ -2122,17 +2274,11 @@ bool Render_Skia::WritePixels(void* srcPixels, size_t srcPixelsLen, const UiRect
         return false;
     }
 
-    SkCanvas* skCanvas = GetSkCanvas();
-    ASSERT(skCanvas != nullptr);
-    if (skCanvas == nullptr) {
-        return false;
-    }
-
     SkBitmap skBitmap;
     skBitmap.setInfo(SkImageInfo::Make(rc.Width(), rc.Height(), SkColorType::kN32_SkColorType, SkAlphaType::kPremul_SkAlphaType));
     skBitmap.setPixels(srcPixels);
 
-    bool bRet = skCanvas->writePixels(skBitmap, rc.left + (int32_t)m_pSkPointOrg->fX, rc.top + (int32_t)m_pSkPointOrg->fY);
+    bool bRet = WriteCanvasPixels(skBitmap, rc.left + (int32_t)m_pSkPointOrg->fX, rc.top + (int32_t)m_pSkPointOrg->fY);
     ASSERT_UNUSED_VARIABLE(bRet);
     return bRet;
 }
@@ -2155,12 +2301,6 @@ bool Render_Skia::WritePixels(void* srcPixels, size_t srcPixelsLen, const UiRect
         return false;
     }
 
-    SkCanvas* skCanvas = GetSkCanvas();
-    ASSERT(skCanvas != nullptr);
-    if (skCanvas == nullptr) {
-        return false;
-    }
-
     UiRect updateRect = rc;
     updateRect.Intersect(rcPaint);
     ASSERT(!updateRect.IsEmpty());
@@ -2183,12 +2323,34 @@ bool Render_Skia::WritePixels(void* srcPixels, size_t srcPixelsLen, const UiRect
     bool bRet = skBitmap.extractSubset(&dstDirtyBitmap, dstRect);
     ASSERT(bRet);
     if(bRet) {
-        bRet = skCanvas->writePixels(dstDirtyBitmap, destX + (int32_t)m_pSkPointOrg->fX, destY + (int32_t)m_pSkPointOrg->fY);
+        bRet = WriteCanvasPixels(dstDirtyBitmap, destX + (int32_t)m_pSkPointOrg->fX, destY + (int32_t)m_pSkPointOrg->fY);
         ASSERT_UNUSED_VARIABLE(bRet);
     }
     return bRet;    
 }
 
+bool Render_Skia::WriteCanvasPixels(const SkBitmap& skBitmap, int32_t x, int32_t y)
+{
+    SkCanvas* skCanvas = GetSkCanvas();
+    ASSERT(skCanvas != nullptr);
+    if (skCanvas == nullptr) {
+        return false;
+    }
+    if (!IsPaintRecording()) {
+        return skCanvas->writePixels(skBitmap, x, y);
+    }
+    //录制绘制命令时，复制像素数据（调用方的数据在返回后可能被修改），在回放时写入
+    SkBitmap skPixelsCopy;
+    if (!skPixelsCopy.tryAllocPixels(skBitmap.info()) || !skBitmap.readPixels(skPixelsCopy.pixmap())) {
+        return false;
+    }
+    skPixelsCopy.setImmutable();
+    DrawCanvasOperation([skPixelsCopy, x, y](SkCanvas* pDestCanvas) {
+            pDestCanvas->writePixels(skPixelsCopy, x, y);
+        });
+    return true;
+}
+
 RenderClipType Render_Skia::GetClipInfo(std::vector<UiRect>& clipRects)
 {
     RenderClipType clipType = RenderClipType::kEmpty;
@@ -7,12 +7,15 @@
 //Skia相关类的前置声明
 class SkSurface;
 class SkCanvas;
+class SkBitmap;
 struct SkPoint;
 class SkPaint;
 enum class SkTextEncoding;
+struct SkRect;
 
 namespace ui 
 {
+class SkTextBox;
 
 class UILIB_API Render_Skia : public IRender
 {
@@ -118,6 +121,8 @@ public:
 
     virtual UiRect MeasureString(const DString& strText, const MeasureStringParam& measureParam) override;
     virtual void DrawString(const DString& strText, const DrawStringParam& drawParam) override;
+    virtual void DrawString(const DString& strText, const DrawStringParam& drawParam,
+                            IDrawStringCachePtr& spDrawCache) override;
 
     virtual void MeasureRichText(const UiRect& textRect,
                                  const UiSize& szScrollOffset,
@@ -195,6 +200,10 @@ public:
     */
     virtual SkCanvas* GetSkCanvas() const = 0;
 
+    /** 当前是否正在录制绘制命令（此时GetSkCanvas()返回录制用的画布，绘制命令在其他线程中回放，画布中没有像素数据）
+    */
+    virtual bool IsPaintRecording() const;
+
 protected:
     /** 视图的原点坐标
     */
@@ -226,6 +235,11 @@ private:
     */
     SkTextEncoding GetTextEncoding() const;
 
+    /** 按文字绘制参数设置SkTextBox的属性（对齐方式、换行模式、省略号、下划线等）
+    * @param [in] rcSkDest 文字绘制区域
+    */
+    void InitTextBox(SkTextBox& skTextBox, const DrawStringParam& drawParam, const SkRect& rcSkDest) const;
+
     /** 获取位图数据
     * @return 返回位图数据的地址, 数据长度为: 高度*宽度*sizeof(uint32_t)
     */
@@ -235,6 +249,19 @@ private:
     */
     float GetScaleFloat(float fValue) const;
 
+    /** 执行直接操作画布的操作（如读写像素数据）；录制绘制命令时，该操作被录制，在回放时执行
+    */
+    void DrawCanvasOperation(const std::function<void(SkCanvas*)>& canvasOperation);
+
+    /** 执行直接修改像素数据的操作；录制绘制命令时，该操作被录制，在回放时执行
+    * @param [in] pixelOperation 像素操作的回调函数，参数为：位图数据，位图的宽度和高度
+    */
+    void DrawPixelOperation(const std::function<void(void* pPixelBits, int32_t nImageWidth, int32_t nImageHeight)>& pixelOperation);
+
+    /** 写入像素数据到画布（坐标为画布坐标）
+    */
+    bool WriteCanvasPixels(const SkBitmap& skBitmap, int32_t x, int32_t y);
+
 private:
     /** Canval保存的状态
     */
@@ -42,6 +42,7 @@ std::unique_ptr<skwindow::WindowContext> MakeRasterForSDL(SDL_Window* sdlWindow,
 //}
 
 Render_Skia_SDL::Render_Skia_SDL(SDL_Window* sdlWindow, RenderBackendType backendType):
+    m_pRasterWindowContext(nullptr),
     m_sdlWindow(sdlWindow),
     m_backendType(backendType)
 {
@@ -68,6 +69,7 @@ Render_Skia_SDL::Render_Skia_SDL(SDL_Window* sdlWindow, RenderBackendType backen
         ASSERT(m_pWindowContext != nullptr);
         if (m_pWindowContext != nullptr) {
             m_backendType = RenderBackendType::kRaster_BackendType;
+            m_pRasterWindowContext = static_cast<SkRasterWindowContext_SDL*>(m_pWindowContext.get());
         }        
     }
 }
@@ -151,12 +153,34 @@ bool Render_Skia_SDL::PaintAndSwapBuffers(IRenderPaint* pRenderPaint)
     return false;
 }
 
+bool Render_Skia_SDL::SetPaintOnRenderThread(bool bEnable)
+{
+    if (m_pRasterWindowContext == nullptr) {
+        return !bEnable;
+    }
+    return m_pRasterWindowContext->SetRenderThreadEnabled(bEnable);
+}
+
+bool Render_Skia_SDL::IsPaintOnRenderThread() const
+{
+    return (m_pRasterWindowContext != nullptr) && m_pRasterWindowContext->IsRenderThreadEnabled();
+}
+
+bool Render_Skia_SDL::IsPaintRecording() const
+{
+    return (m_pRasterWindowContext != nullptr) && (m_pRasterWindowContext->GetRecordingCanvas() != nullptr);
+}
+
 SkSurface* Render_Skia_SDL::GetSkSurface() const
 {
     ASSERT(m_pWindowContext != nullptr);
     if (m_pWindowContext == nullptr) {
         return nullptr;
     }
+    if ((m_pRasterWindowContext != nullptr) && m_pRasterWindowContext->IsRenderThreadEnabled()) {
+        //读取绘制结果前，需要等待渲染线程完成所有的绘制
+        m_pRasterWindowContext->FlushRenderThread(false);
+    }
     //由于m_pWindowContext内部保存了成员变量，返回SkSurface的裸指针是安全的
     sk_sp<SkSurface> backbuffer = m_pWindowContext->getBackbufferSurface();
     ASSERT(backbuffer != nullptr);
@@ -169,6 +193,13 @@ SkCanvas* Render_Skia_SDL::GetSkCanvas() const
     if (m_pWindowContext == nullptr) {
         return nullptr;
     }
+    if (m_pRasterWindowContext != nullptr) {
+        //正在录制绘制命令时，返回录制用的画布
+        SkCanvas* pRecordingCanvas = m_pRasterWindowContext->GetRecordingCanvas();
+        if (pRecordingCanvas != nullptr) {
+            return pRecordingCanvas;
+        }
+    }
     sk_sp<SkSurface> backbuffer = m_pWindowContext->getBackbufferSurface();
     ASSERT(backbuffer != nullptr);
     if (backbuffer == nullptr) {
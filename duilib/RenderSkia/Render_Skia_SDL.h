@@ -14,6 +14,8 @@ struct SDL_Window;
 
 namespace ui 
 {
+class SkRasterWindowContext_SDL;
+
 /** 渲染引擎接口的SDL实现
 */
 class UILIB_API Render_Skia_SDL: public Render_Skia
@@ -54,6 +56,15 @@ public:
     */
     virtual bool PaintAndSwapBuffers(IRenderPaint* pRenderPaint) override;
 
+    /** 设置是否在独立的渲染线程中绘制（只支持CPU绘制）
+    * @param [in] bEnable true表示在渲染线程中绘制，false表示在UI线程中同步绘制
+    */
+    virtual bool SetPaintOnRenderThread(bool bEnable) override;
+
+    /** 是否在独立的渲染线程中绘制
+    */
+    virtual bool IsPaintOnRenderThread() const override;
+
     /** 设置窗口的形状为圆角矩形
     * @param [in] rcWnd 需要设置RGN的区域，坐标为屏幕坐标
     * @param [in] rx 圆角的宽度，其值不能为0
@@ -81,6 +92,10 @@ public:
     */
     virtual SkCanvas* GetSkCanvas() const override;
 
+    /** 当前是否正在录制绘制命令
+    */
+    virtual bool IsPaintRecording() const override;
+
 private:
 #ifdef DUILIB_BUILD_FOR_WIN
     /** 获取DC句柄，当不使用后，需要调用ReleaseDC接口释放资源
@@ -98,6 +113,10 @@ private:
     */
     std::unique_ptr<skwindow::WindowContext> m_pWindowContext;
 
+    /** CPU绘制的WindowContext对象（与m_pWindowContext为同一个对象，不是CPU绘制时为nullptr）
+    */
+    SkRasterWindowContext_SDL* m_pRasterWindowContext;
+
     /** 后台绘制方式
     */
     RenderBackendType m_backendType;
@@ -154,6 +154,16 @@ bool Render_Skia_Windows::PaintAndSwapBuffers(IRenderPaint* pRenderPaint)
     return false;
 }
 
+bool Render_Skia_Windows::SetPaintOnRenderThread(bool bEnable)
+{
+    return !bEnable;
+}
+
+bool Render_Skia_Windows::IsPaintOnRenderThread() const
+{
+    return false;
+}
+
 SkSurface* Render_Skia_Windows::GetSkSurface() const
 {
     ASSERT(m_pWindowContext != nullptr);
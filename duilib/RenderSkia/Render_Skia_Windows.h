@@ -52,6 +52,14 @@ public:
     */
     virtual bool PaintAndSwapBuffers(IRenderPaint* pRenderPaint) override;
 
+    /** 设置是否在独立的渲染线程中绘制（该实现不支持，始终在UI线程中同步绘制）
+    */
+    virtual bool SetPaintOnRenderThread(bool bEnable) override;
+
+    /** 是否在独立的渲染线程中绘制
+    */
+    virtual bool IsPaintOnRenderThread() const override;
+
     /** 设置窗口的形状为圆角矩形
     * @param [in] rcWnd 需要设置RGN的区域，坐标为屏幕坐标
     * @param [in] rx 圆角的宽度，其值不能为0
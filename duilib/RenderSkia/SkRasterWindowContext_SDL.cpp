@@ -1,5 +1,7 @@
 #include "SkRasterWindowContext_SDL.h"
 #include "duilib/Render/IRender.h"
+#include "duilib/Render/PixelKernels.h"
+#include "duilib/Core/GlobalManager.h"
 #include "duilib/Utils/PerformanceUtil.h"
 
 #ifdef DUILIB_BUILD_FOR_SDL
@@ -10,15 +12,22 @@ namespace ui {
 
 SkRasterWindowContext_SDL::SkRasterWindowContext_SDL(SDL_Window* sdlWindow, std::unique_ptr<const skwindow::DisplayParams> params):
     skwindow::internal::RasterWindowContext(std::move(params)),
+    m_pSharedPixels(nullptr),
     m_sdlWindow(sdlWindow),
-    m_sdlTextrue(nullptr)
+    m_sdlTextrue(nullptr),
+    m_pRecordingCanvas(nullptr),
+    m_renderState(RenderState::kIdle),
+    m_bStopRenderThread(false)
 {
     fWidth = 0;
     fHeight = 0;
+    m_spPresentFlag.reset((WeakFlag*)nullptr);
 }
 
 SkRasterWindowContext_SDL::~SkRasterWindowContext_SDL()
 {
+    StopRenderThread(true);
+    m_spPresentFlag.reset();
     Clear();
 }
 
@@ -30,12 +39,14 @@ void SkRasterWindowContext_SDL::Clear()
     }
     m_fBackbufferSurface.reset();
     m_fSurfaceMemory.reset();
+    m_pSharedPixels = nullptr;
 }
 
 void SkRasterWindowContext_SDL::setDisplayParams(std::unique_ptr<const skwindow::DisplayParams> params)
 {
     int32_t nWidth = width();
     int32_t nHeight = height();
+    FlushRenderThread(true);
     fDisplayParams = std::move(params);
     Clear();
     if ((nWidth > 0) && (nHeight > 0)) {
@@ -64,6 +75,9 @@ void SkRasterWindowContext_SDL::resize(int nWidth, int nHeight)
         return;
     }
 
+    //渲染线程中尚未完成的绘制数据已经失效（窗口大小变化后会完整重绘）
+    FlushRenderThread(true);
+
     fWidth = nWidth;
     fHeight = nHeight;
 
@@ -101,6 +115,72 @@ void SkRasterWindowContext_SDL::onSwapBuffers()
 {
 }
 
+void* SkRasterWindowContext_SDL::GetBackbufferPixels() const
+{
+    return (m_pSharedPixels != nullptr) ? m_pSharedPixels : m_fSurfaceMemory.get();
+}
+
+void* SkRasterWindowContext_SDL::GetShareableWindowPixels(uint8_t nLayeredWindowAlpha) const
+{
+    if ((m_sdlWindow == nullptr) || (m_fBackbufferSurface == nullptr) || (nLayeredWindowAlpha != 255)) {
+        //窗口透明度需要在提交前处理像素数据，不能修改Skia的绘制数据，所以不能共享内存
+        return nullptr;
+    }
+    if (m_pRenderThread != nullptr) {
+        //渲染线程写入后台缓冲区时，窗口的Surface可能正在提交或者重新创建，所以不能共享内存
+        return nullptr;
+    }
+    SDL_Surface* sdlSurface = SDL_GetWindowSurface(m_sdlWindow);
+    if ((sdlSurface == nullptr) || (sdlSurface->pixels == nullptr) || SDL_MUSTLOCK(sdlSurface)) {
+        return nullptr;
+    }
+    if ((sdlSurface->w != width()) || (sdlSurface->h != height()) || (sdlSurface->pitch != width() * (int32_t)sizeof(uint32_t))) {
+        //大小不匹配
+        return nullptr;
+    }
+
+    int32_t backR = -1;
+    int32_t backG = -1;
+    int32_t backB = -1;
+    int32_t backA = -1;
+    if (!GetSkiaColorByteOrder(m_fBackbufferSurface->imageInfo().colorType(), backR, backG, backB, backA)) {
+        return nullptr;
+    }
+    int32_t sdlR = -1;
+    int32_t sdlG = -1;
+    int32_t sdlB = -1;
+    int32_t sdlA = -1;
+    if (!GetSDLColorByteOrder(sdlSurface->format, sdlR, sdlG, sdlB, sdlA)) {
+        return nullptr;
+    }
+    if ((sdlR != backR) || (sdlG != backG) || (sdlB != backB) || (sdlA != backA)) {
+        //颜色顺序不同，需要转换后再提交
+        return nullptr;
+    }
+    return sdlSurface->pixels;
+}
+
+bool SkRasterWindowContext_SDL::UpdateBackbufferSurface(uint8_t nLayeredWindowAlpha)
+{
+    if ((m_fBackbufferSurface == nullptr) || (m_fSurfaceMemory.get() == nullptr)) {
+        return false;
+    }
+    //窗口的Surface在窗口大小变化等情况下会重新创建，所以每次绘制前都需要检查
+    void* pSharedPixels = GetShareableWindowPixels(nLayeredWindowAlpha);
+    if (pSharedPixels == m_pSharedPixels) {
+        return false;
+    }
+    void* pixels = (pSharedPixels != nullptr) ? pSharedPixels : m_fSurfaceMemory.get();
+    sk_sp<SkSurface> backbufferSurface = SkSurfaces::WrapPixels(m_fBackbufferSurface->imageInfo(), pixels, sizeof(uint32_t) * width());
+    ASSERT(backbufferSurface != nullptr);
+    if (backbufferSurface == nullptr) {
+        return false;
+    }
+    m_fBackbufferSurface = backbufferSurface;
+    m_pSharedPixels = pSharedPixels;
+    return true;
+}
+
 bool SkRasterWindowContext_SDL::PaintAndSwapBuffers(IRender* pRender, IRenderPaint* pRenderPaint)
 {
     SkASSERT(m_sdlWindow != nullptr);
@@ -120,62 +200,293 @@ bool SkRasterWindowContext_SDL::PaintAndSwapBuffers(IRender* pRender, IRenderPai
         return false;
     }
 
-    //获取需要绘制的区域
-    UiRect rcPaint;
-    bool bUpdateRect = pRenderPaint->GetUpdateRect(rcPaint); //返回true表示支持局部绘制，只绘制更新的部分区域，以提高效率
-    if (bUpdateRect && !rcPaint.IsEmpty()) {
+    //获取需要绘制的区域（多个互不重叠的矩形，分别绘制，避免两个距离较远的小区域合并成一个大区域绘制）
+    UiRect rcClient;
+    GetClientRect(rcClient);
+    if (rcClient.IsEmpty()) {
+        //无需绘制
+        return false;
+    }
+    std::vector<UiRect> rcPaints;
+    bool bUpdateRect = pRenderPaint->GetUpdateRects(rcPaints); //返回true表示支持局部绘制，只绘制更新的部分区域，以提高效率
+    for (auto iter = rcPaints.begin(); iter != rcPaints.end();) {
         //确保区域的有效性
-        UiRect rcClient;
-        GetClientRect(rcClient);
-        rcPaint.Intersect(rcClient);
+        if (!iter->Intersect(rcClient)) {
+            iter = rcPaints.erase(iter);
+        }
+        else {
+            ++iter;
+        }
     }
-    if (rcPaint.IsEmpty()) {
+    if (rcPaints.empty()) {
         //不支持局部绘制，每次都是需要重绘整个窗口的客户区域
-        GetClientRect(rcPaint);
-    }
-    if (rcPaint.IsEmpty()) {
-        //无需绘制
-        return false;
+        rcPaints.push_back(rcClient);
     }
 
     //窗口透明度
     uint8_t nLayeredWindowAlpha = pRenderPaint->GetLayeredWindowAlpha();
 
-    //是否为完全绘制
-    const bool bFullPaint = (rcPaint.Width() == width()) && (rcPaint.Height() == height());
+    //在渲染线程中绘制时，只录制绘制命令，不写入后台缓冲区
+    const bool bRecording = (m_pRenderThread != nullptr);
+
+    //后台缓冲区的内存发生变化时，原有的绘制数据已经失效，需要完整重绘
+    if (!bRecording && UpdateBackbufferSurface(nLayeredWindowAlpha)) {
+        rcPaints.clear();
+        rcPaints.push_back(rcClient);
+    }
+
+    //执行绘制：每个区域单独设置裁剪区域
+    bool bRet = false;
     SkCanvas* skCanvas = nullptr;
-    if (!bFullPaint) {
-        //使用裁剪区域，避免绘制其他无关区域的数据
+    if (bRecording) {
+        m_pRecordingCanvas = m_pictureRecorder.beginRecording(SkRect::MakeIWH(width(), height()));
+        skCanvas = m_pRecordingCanvas;
+    }
+    else {
         skCanvas = m_fBackbufferSurface->getCanvas();
-        if (skCanvas != nullptr) {
+    }
+    for (const UiRect& rcPaint : rcPaints) {
+        //是否为完全绘制
+        const bool bClip = !IsFullPaint(rcPaint) && (skCanvas != nullptr);
+        if (bClip) {
+            //使用裁剪区域，避免绘制其他无关区域的数据
             skCanvas->save();
             skCanvas->clipIRect(SkIRect::MakeLTRB(rcPaint.left, rcPaint.top, rcPaint.right, rcPaint.bottom));
         }
+        if (pRenderPaint->DoPaint(rcPaint)) {
+            bRet = true;
+        }
+        if (bClip) {
+            skCanvas->restore();
+        }
     }
-
-    //执行绘制
-    bool bRet = pRenderPaint->DoPaint(rcPaint);
-    if (bRet) {
+    if (bRecording) {
+        //录制完成后，交给渲染线程回放绘制命令
+        m_pRecordingCanvas = nullptr;
+        sk_sp<SkDrawable> skDrawable = m_pictureRecorder.finishRecordingAsDrawable();
+        if (bRet && (skDrawable != nullptr)) {
+            PostRenderFrame(skDrawable, rcPaints, nLayeredWindowAlpha);
+        }
+    }
+    else if (bRet) {
         //绘制完成后，更新到窗口
-        SwapPaintBuffers(rcPaint, nLayeredWindowAlpha);
+        void* pDrawPixels = GetBackbufferPixels();
+        if (!SwapPaintBuffers(rcPaints, nLayeredWindowAlpha) && (GetBackbufferPixels() != pDrawPixels)) {
+            //窗口的Surface已经重新创建，后台缓冲区已重新关联，本次绘制的数据已失效，需要完整重绘
+            rcPaints.clear();
+            rcPaints.push_back(rcClient);
+            bRet = pRenderPaint->DoPaint(rcClient);
+            if (bRet) {
+                SwapPaintBuffers(rcPaints, nLayeredWindowAlpha);
+            }
+        }
     }
 
     //绘制完成后，将已经绘制的区域标记为有效区域
     if (bUpdateRect) {
-        ValidateRect(rcPaint);
+        for (UiRect& rcPaint : rcPaints) {
+            ValidateRect(rcPaint);
+        }
     }
+    return bRet;
+}
 
-    if (skCanvas != nullptr) {
-        skCanvas->restore();
+bool SkRasterWindowContext_SDL::SetRenderThreadEnabled(bool bEnable)
+{
+    GlobalManager::Instance().AssertUIThread();
+    if (bEnable == IsRenderThreadEnabled()) {
+        return true;
     }
-    return bRet;
+    if (!bEnable) {
+        StopRenderThread(false);
+        return true;
+    }
+    {
+        std::lock_guard<std::mutex> threadGuard(m_renderMutex);
+        m_renderState = RenderState::kIdle;
+        m_bStopRenderThread = false;
+        m_pendingFrame = RenderFrame();
+        m_presentFrame = RenderFrame();
+    }
+    m_pRenderThread = std::make_unique<std::thread>(&SkRasterWindowContext_SDL::RenderThreadProc, this);
+
+    //后台缓冲区不能再与窗口的Surface共享内存（渲染线程在收到第一帧数据前不会访问后台缓冲区；由调用方负责完整重绘）
+    UpdateBackbufferSurface(255);
+    return true;
+}
+
+bool SkRasterWindowContext_SDL::IsRenderThreadEnabled() const
+{
+    return m_pRenderThread != nullptr;
+}
+
+SkCanvas* SkRasterWindowContext_SDL::GetRecordingCanvas() const
+{
+    return m_pRecordingCanvas;
+}
+
+void SkRasterWindowContext_SDL::StopRenderThread(bool bDiscard)
+{
+    if (m_pRenderThread == nullptr) {
+        return;
+    }
+    //完成（或者丢弃）所有未完成的绘制
+    FlushRenderThread(bDiscard);
+    {
+        std::lock_guard<std::mutex> threadGuard(m_renderMutex);
+        m_bStopRenderThread = true;
+    }
+    m_renderCv.notify_all();
+    if (m_pRenderThread->joinable()) {
+        m_pRenderThread->join();
+    }
+    m_pRenderThread.reset();
+}
+
+void SkRasterWindowContext_SDL::RenderThreadProc()
+{
+    std::weak_ptr<WeakFlag> presentFlag = m_spPresentFlag;
+    while (true) {
+        RenderFrame renderFrame;
+        {
+            std::unique_lock<std::mutex> threadGuard(m_renderMutex);
+            m_renderCv.wait(threadGuard, [this]() {
+                    return m_bStopRenderThread || ((m_renderState == RenderState::kIdle) && !m_pendingFrame.m_drawables.empty());
+                });
+            if (m_bStopRenderThread) {
+                break;
+            }
+            renderFrame = std::move(m_pendingFrame);
+            m_pendingFrame = RenderFrame();
+            m_renderState = RenderState::kRasterizing;
+        }
+
+        //回放绘制命令（耗时的光栅化在渲染线程中完成，后台缓冲区此时只由渲染线程写入）
+        SkCanvas* skCanvas = (m_fBackbufferSurface != nullptr) ? m_fBackbufferSurface->getCanvas() : nullptr;
+        if (skCanvas != nullptr) {
+            PerformanceTrace traceRender(_T("SkRasterWindowContext_SDL::RenderThreadProc"));
+            for (const sk_sp<SkDrawable>& skDrawable : renderFrame.m_drawables) {
+                skDrawable->draw(skCanvas);
+            }
+        }
+        renderFrame.m_drawables.clear();
+
+        {
+            std::lock_guard<std::mutex> threadGuard(m_renderMutex);
+            m_presentFrame = std::move(renderFrame);
+            m_renderState = RenderState::kPresenting;
+        }
+        m_renderDoneCv.notify_all();
+
+        //提交到窗口需要在UI线程中完成
+        GlobalManager::Instance().Thread().PostTask(kThreadUI, [this, presentFlag]() {
+                if (!presentFlag.expired()) {
+                    PresentRenderFrame();
+                }
+            });
+    }
+}
+
+void SkRasterWindowContext_SDL::PostRenderFrame(sk_sp<SkDrawable> skDrawable, const std::vector<UiRect>& rcPaints, uint8_t nLayeredWindowAlpha)
+{
+    {
+        std::lock_guard<std::mutex> threadGuard(m_renderMutex);
+        RenderFrame& pendingFrame = m_pendingFrame;
+        pendingFrame.m_drawables.push_back(std::move(skDrawable));
+        pendingFrame.m_nLayeredWindowAlpha = nLayeredWindowAlpha;
+        //合并绘制区域：渲染线程繁忙时，多次绘制合并为一次提交
+        bool bFullPaint = (pendingFrame.m_rcPaints.size() == 1) && IsFullPaint(pendingFrame.m_rcPaints.front());
+        for (const UiRect& rcPaint : rcPaints) {
+            if (bFullPaint) {
+                break;
+            }
+            if (IsFullPaint(rcPaint)) {
+                bFullPaint = true;
+                pendingFrame.m_rcPaints.clear();
+                pendingFrame.m_rcPaints.push_back(rcPaint);
+            }
+            else {
+                pendingFrame.m_rcPaints.push_back(rcPaint);
+            }
+        }
+    }
+    m_renderCv.notify_all();
+}
+
+void SkRasterWindowContext_SDL::PresentRenderFrame()
+{
+    GlobalManager::Instance().AssertUIThread();
+    RenderFrame presentFrame;
+    {
+        std::lock_guard<std::mutex> threadGuard(m_renderMutex);
+        if (m_renderState != RenderState::kPresenting) {
+            //已经在FlushRenderThread中提交
+            return;
+        }
+        presentFrame = std::move(m_presentFrame);
+        m_presentFrame = RenderFrame();
+    }
+    //此时渲染线程在等待提交完成，不会写入后台缓冲区
+    if (!presentFrame.m_rcPaints.empty()) {
+        SwapPaintBuffers(presentFrame.m_rcPaints, presentFrame.m_nLayeredWindowAlpha);
+    }
+    {
+        std::lock_guard<std::mutex> threadGuard(m_renderMutex);
+        m_renderState = RenderState::kIdle;
+    }
+    m_renderCv.notify_all();
+}
+
+void SkRasterWindowContext_SDL::FlushRenderThread(bool bDiscard)
+{
+    if (m_pRenderThread == nullptr) {
+        return;
+    }
+    RenderFrame presentFrame;
+    RenderFrame pendingFrame;
+    {
+        std::unique_lock<std::mutex> threadGuard(m_renderMutex);
+        m_renderDoneCv.wait(threadGuard, [this]() {
+                return m_renderState != RenderState::kRasterizing;
+            });
+        if (m_renderState == RenderState::kPresenting) {
+            presentFrame = std::move(m_presentFrame);
+        }
+        pendingFrame = std::move(m_pendingFrame);
+        m_presentFrame = RenderFrame();
+        m_pendingFrame = RenderFrame();
+        //在UI线程中完成剩余的绘制，期间渲染线程不能写入后台缓冲区
+        m_renderState = RenderState::kRasterizing;
+    }
+    if (!bDiscard) {
+        if (!presentFrame.m_rcPaints.empty()) {
+            SwapPaintBuffers(presentFrame.m_rcPaints, presentFrame.m_nLayeredWindowAlpha);
+        }
+        SkCanvas* skCanvas = (m_fBackbufferSurface != nullptr) ? m_fBackbufferSurface->getCanvas() : nullptr;
+        if ((skCanvas != nullptr) && !pendingFrame.m_drawables.empty()) {
+            for (const sk_sp<SkDrawable>& skDrawable : pendingFrame.m_drawables) {
+                skDrawable->draw(skCanvas);
+            }
+            SwapPaintBuffers(pendingFrame.m_rcPaints, pendingFrame.m_nLayeredWindowAlpha);
+        }
+    }
+    {
+        std::lock_guard<std::mutex> threadGuard(m_renderMutex);
+        m_renderState = RenderState::kIdle;
+    }
+    m_renderCv.notify_all();
+}
+
+bool SkRasterWindowContext_SDL::IsFullPaint(const UiRect& rcPaint) const
+{
+    return (rcPaint.Width() == width()) && (rcPaint.Height() == height());
 }
 
-bool SkRasterWindowContext_SDL::SwapPaintBuffers(const UiRect& rcPaint, uint8_t nLayeredWindowAlpha)
+bool SkRasterWindowContext_SDL::SwapPaintBuffers(const std::vector<UiRect>& rcPaints, uint8_t nLayeredWindowAlpha)
 {
     PerformanceStat statPerformance(_T("PaintWindow, SkRasterWindowContext_SDL::SwapPaintBuffers"));
-    ASSERT(!rcPaint.IsEmpty());
-    if (rcPaint.IsEmpty()) {
+    ASSERT(!rcPaints.empty());
+    if (rcPaints.empty()) {
         return false;
     }
     ASSERT(m_sdlWindow != nullptr);
@@ -191,10 +502,16 @@ bool SkRasterWindowContext_SDL::SwapPaintBuffers(const UiRect& rcPaint, uint8_t
         return false;
     }
 
-    if (SwapPaintBuffersFast(rcPaint, nLayeredWindowAlpha)) {
+    //Skia绘制时使用的后台缓冲区
+    void* pDrawPixels = GetBackbufferPixels();
+    if (SwapPaintBuffersFast(rcPaints, nLayeredWindowAlpha)) {
         //直接通过窗口的Surface更新绘制数据到窗口设备(不使用GPU，速度更快)
         return true;
     }
+    if ((m_pSharedPixels != nullptr) || (GetBackbufferPixels() != pDrawPixels)) {
+        //窗口的Surface已经重新创建，共享的内存已失效，不能从未绘制的缓冲区复制数据，需要重新关联并完整重绘
+        return false;
+    }
 
     SDL_Renderer* sdlRenderer = SDL_GetRenderer(m_sdlWindow);
     ASSERT(sdlRenderer != nullptr);
@@ -202,6 +519,8 @@ bool SkRasterWindowContext_SDL::SwapPaintBuffers(const UiRect& rcPaint, uint8_t
         return false;
     }
 
+    //新创建的纹理，需要完整更新纹理数据
+    const bool bNewTexture = (m_sdlTextrue == nullptr);
     if (m_sdlTextrue == nullptr) {
         // 渲染到窗口（IRender -> 绘制到 SDL Render -> 更新到 SDL 窗口）
 #ifdef DUILIB_BUILD_FOR_WIN
@@ -217,29 +536,23 @@ bool SkRasterWindowContext_SDL::SwapPaintBuffers(const UiRect& rcPaint, uint8_t
         return false;
     }
 
-    //将界面数据复制到纹理
-    bool bDrawOk = false;
-    if ((rcPaint.Width() != width()) || (rcPaint.Height() != height())) {
-        //局部绘制：只绘制更新的部分
-        SDL_Rect rect;
-        rect.x = rcPaint.left;
-        rect.y = rcPaint.top;
-        rect.w = rcPaint.Width();
-        rect.h = rcPaint.Height();        
-        SkIRect bounds = SkIRect::MakeLTRB(rcPaint.left, rcPaint.top, rcPaint.right, rcPaint.bottom);
-        sk_sp<SkImage> snapshotImage = m_fBackbufferSurface->makeImageSnapshot(bounds);
-        if (snapshotImage != nullptr) {
-            SkPixmap pixmap;
-            if (snapshotImage->peekPixels(&pixmap) && (pixmap.addr() != nullptr) && (pixmap.width() == rcPaint.Width()) && (pixmap.height() == rcPaint.Height())) {
-                SDL_UpdateTexture(m_sdlTextrue, &rect, pixmap.addr(), (int)pixmap.rowBytes());
-                bDrawOk = true;
-            }
+    //将界面数据复制到纹理：直接从后台缓冲区读取数据，不创建中间的图像快照
+    uint32_t* pBackbufferPixels = (uint32_t*)GetBackbufferPixels();
+    const int32_t nPitch = width() * (int32_t)sizeof(uint32_t);
+    if (!bNewTexture && ((rcPaints.size() > 1) || !IsFullPaint(rcPaints.front()))) {
+        //局部绘制：只更新各个脏区域所在的行
+        for (const UiRect& rcPaint : rcPaints) {
+            SDL_Rect rect;
+            rect.x = rcPaint.left;
+            rect.y = rcPaint.top;
+            rect.w = rcPaint.Width();
+            rect.h = rcPaint.Height();
+            SDL_UpdateTexture(m_sdlTextrue, &rect, pBackbufferPixels + (size_t)rcPaint.top * width() + rcPaint.left, nPitch);
         }
-        ASSERT(bDrawOk);
     }
-    if (!bDrawOk) {
+    else {
         //完整绘制
-        SDL_UpdateTexture(m_sdlTextrue, nullptr, m_fSurfaceMemory.get(), m_fBackbufferSurface->width() * sizeof(uint32_t));
+        SDL_UpdateTexture(m_sdlTextrue, nullptr, pBackbufferPixels, nPitch);
     }
 
     //设置纹理的透明度
@@ -249,7 +562,7 @@ bool SkRasterWindowContext_SDL::SwapPaintBuffers(const UiRect& rcPaint, uint8_t
     //对源SDL窗口清零，避免透明窗口的情况下，绘制到残留图像上，导致窗口阴影越来越浓
     SDL_RenderClear(sdlRenderer);
 
-    //绘制纹理
+    //绘制纹理（SDL_RenderPresent只能提交整个窗口，所以需要绘制完整的纹理；纹理已在显存中，只有上面的数据上传与脏区域大小相关）
     SDL_RenderTexture(sdlRenderer, m_sdlTextrue, nullptr, nullptr);
 
     //提交绘制数据（这一步速度最慢：Windows平台很快，时间可以忽略； 但Linux平台X11环境（虚拟机中）下每次调用需要9毫秒左右）
@@ -257,10 +570,10 @@ bool SkRasterWindowContext_SDL::SwapPaintBuffers(const UiRect& rcPaint, uint8_t
     return true;
 }
 
-bool SkRasterWindowContext_SDL::SwapPaintBuffersFast(const UiRect& rcPaint, uint8_t nLayeredWindowAlpha)
+bool SkRasterWindowContext_SDL::SwapPaintBuffersFast(const std::vector<UiRect>& rcPaints, uint8_t nLayeredWindowAlpha)
 {
-    ASSERT(!rcPaint.IsEmpty());
-    if (rcPaint.IsEmpty()) {
+    ASSERT(!rcPaints.empty());
+    if (rcPaints.empty()) {
         return false;
     }
     ASSERT(m_sdlWindow != nullptr);
@@ -277,6 +590,12 @@ bool SkRasterWindowContext_SDL::SwapPaintBuffersFast(const UiRect& rcPaint, uint
     }
 
     SDL_Surface* sdlSurface = SDL_GetWindowSurface(m_sdlWindow);
+    if ((m_pSharedPixels != nullptr) && ((sdlSurface == nullptr) || (sdlSurface->pixels != m_pSharedPixels))) {
+        //窗口的Surface已经重新创建，Skia绘制到了原有的Surface中（m_fSurfaceMemory中没有绘制数据，不能复制）：
+        //重新关联后台缓冲区，返回失败，由调用方完整重绘
+        UpdateBackbufferSurface(nLayeredWindowAlpha);
+        return false;
+    }
     if (sdlSurface == nullptr) {
         return false;
     }
@@ -307,32 +626,59 @@ bool SkRasterWindowContext_SDL::SwapPaintBuffersFast(const UiRect& rcPaint, uint
     //统计性能
     PerformanceStat statPerformance(_T("PaintWindow, SkRasterWindowContext_SDL::SwapPaintBuffersFast"));
 
-    bool bDrawOk = false;
-    if ((rcPaint.Width() != width()) || (rcPaint.Height() != height())) {
-        //局部绘制：只绘制更新的部分
-        SDL_Rect rect;
-        rect.x = rcPaint.left;
-        rect.y = rcPaint.top;
-        rect.w = rcPaint.Width();
-        rect.h = rcPaint.Height();
-        //按行复制数据(每次复制1行数据)
-        const int32_t nMaxRow = rcPaint.top + rcPaint.Height();
-        const int32_t nWidth = rcPaint.Width();
-        for (int32_t nRow = rcPaint.top; nRow < nMaxRow; ++nRow) {
-            ::memcpy((uint32_t*)sdlSurface->pixels + nRow * sdlSurface->w + rcPaint.left,
-                     (uint32_t*)m_fSurfaceMemory.get() + nRow * sdlSurface->w + rcPaint.left,
-                     nWidth * sizeof(uint32_t));
+    if (m_pSharedPixels != nullptr) {
+        //Skia已直接绘制到窗口的Surface中，无需复制和转换数据，只提交各个脏区域
+        ASSERT(nLayeredWindowAlpha == 255);
+        if ((rcPaints.size() > 1) || !IsFullPaint(rcPaints.front())) {
+            std::vector<SDL_Rect> rects;
+            rects.reserve(rcPaints.size());
+            for (const UiRect& rcPaint : rcPaints) {
+                SDL_Rect rect;
+                rect.x = rcPaint.left;
+                rect.y = rcPaint.top;
+                rect.w = rcPaint.Width();
+                rect.h = rcPaint.Height();
+                rects.push_back(rect);
+            }
+            SDL_UpdateWindowSurfaceRects(m_sdlWindow, rects.data(), (int)rects.size());
+        }
+        else {
+            SDL_UpdateWindowSurface(m_sdlWindow);
         }
+        return true;
+    }
+    bool bDrawOk = false;
+    if ((rcPaints.size() > 1) || !IsFullPaint(rcPaints.front())) {
+        //局部绘制：只更新各个脏区域的部分，并一次性提交所有区域
+        std::vector<SDL_Rect> rects;
+        rects.reserve(rcPaints.size());
+        for (const UiRect& rcPaint : rcPaints) {
+            SDL_Rect rect;
+            rect.x = rcPaint.left;
+            rect.y = rcPaint.top;
+            rect.w = rcPaint.Width();
+            rect.h = rcPaint.Height();
+            rects.push_back(rect);
+
+            //按行复制数据(每次复制1行数据)
+            const int32_t nMaxRow = rcPaint.top + rcPaint.Height();
+            const int32_t nWidth = rcPaint.Width();
+            for (int32_t nRow = rcPaint.top; nRow < nMaxRow; ++nRow) {
+                ::memcpy((uint32_t*)sdlSurface->pixels + nRow * sdlSurface->w + rcPaint.left,
+                         (uint32_t*)m_fSurfaceMemory.get() + nRow * sdlSurface->w + rcPaint.left,
+                         nWidth * sizeof(uint32_t));
+            }
 
-        //处理颜色顺序
-        UpdateColorByteOrder(sdlSurface->pixels, sdlSurface->w, rcPaint, backR, backG, backB, backA, sdlR, sdlG, sdlB, sdlA);
-        UpdateColorAlpha(sdlSurface->pixels, sdlSurface->w, rcPaint, nLayeredWindowAlpha, sdlR, sdlG, sdlB, sdlA);
-        SDL_UpdateWindowSurfaceRects(m_sdlWindow, &rect, 1);
+            //处理颜色顺序
+            UpdateColorByteOrder(sdlSurface->pixels, sdlSurface->w, rcPaint, backR, backG, backB, backA, sdlR, sdlG, sdlB, sdlA);
+            UpdateColorAlpha(sdlSurface->pixels, sdlSurface->w, rcPaint, nLayeredWindowAlpha, sdlR, sdlG, sdlB, sdlA);
+        }
+        SDL_UpdateWindowSurfaceRects(m_sdlWindow, rects.data(), (int)rects.size());
         bDrawOk = true;
-        ASSERT(bDrawOk);
     }
     if (!bDrawOk) {
         //完整绘制
+        const UiRect& rcPaint = rcPaints.front();
         ::memcpy(sdlSurface->pixels, m_fSurfaceMemory.get(), sdlSurface->h * sdlSurface->pitch);
         UpdateColorByteOrder(sdlSurface->pixels, sdlSurface->w, rcPaint, backR, backG, backB, backA, sdlR, sdlG, sdlB, sdlA);
         UpdateColorAlpha(sdlSurface->pixels, sdlSurface->w, rcPaint, nLayeredWindowAlpha, sdlR, sdlG, sdlB, sdlA);
@@ -405,6 +751,22 @@ int32_t SkRasterWindowContext_SDL::GetColorByteOrder(uint32_t mask) const
     return colorOrder;
 }
 
+/** 按行处理绘制区域内的像素（各行数据连续时一次处理）
+*/
+template<typename RowFunction>
+static void ForEachPaintRow(void* surfacePixels, int32_t nSurfaceWidth, const UiRect& rcPaint, RowFunction rowFunction)
+{
+    const int32_t nWidth = rcPaint.Width();
+    if ((rcPaint.left == 0) && (nWidth == nSurfaceWidth)) {
+        rowFunction((uint32_t*)surfacePixels + (size_t)rcPaint.top * nSurfaceWidth, (size_t)nWidth * rcPaint.Height());
+        return;
+    }
+    const int32_t nMaxRow = rcPaint.top + rcPaint.Height();
+    for (int32_t nRow = rcPaint.top; nRow < nMaxRow; ++nRow) {
+        rowFunction((uint32_t*)surfacePixels + (size_t)nRow * nSurfaceWidth + rcPaint.left, (size_t)nWidth);
+    }
+}
+
 void SkRasterWindowContext_SDL::UpdateColorByteOrder(void* surfacePixels, int32_t nSurfaceWidth, const UiRect& rcPaint,
                                                      int32_t backR, int32_t backG, int32_t backB, int32_t backA,
                                                      int32_t sdlR, int32_t sdlG, int32_t sdlB, int32_t sdlA) const
@@ -420,50 +782,27 @@ void SkRasterWindowContext_SDL::UpdateColorByteOrder(void* surfacePixels, int32_
         //颜色格式相同，无需更新颜色数据
         return;
     }
-    uint32_t colorValue = 0;
-    const int32_t nMaxRow = rcPaint.top + rcPaint.Height();
-    const int32_t nWidth = rcPaint.Width();
-    for (int32_t nRow = rcPaint.top; nRow < nMaxRow; ++nRow) {
-        for (int32_t nCol = 0; nCol < nWidth; ++nCol) {
-            uint32_t* pColorValue = (uint32_t*)surfacePixels + nRow * nSurfaceWidth + rcPaint.left + nCol;
-            colorValue = *pColorValue;
-            if (bDiffR) {
-                ((uint8_t*)pColorValue)[sdlR] = ((uint8_t*)&colorValue)[backR];
-            }
-            if (bDiffG) {
-                ((uint8_t*)pColorValue)[sdlG] = ((uint8_t*)&colorValue)[backG];
-            }
-            if (bDiffB) {
-                ((uint8_t*)pColorValue)[sdlB] = ((uint8_t*)&colorValue)[backB];
-            }
-            if (bDiffA) {
-                ((uint8_t*)pColorValue)[sdlA] = ((uint8_t*)&colorValue)[backA];
-            }
-        }
-    }
+    //SDL像素中的第k个字节，对应Skia像素中的第channelOrder[k]个字节
+    uint8_t channelOrder[4] = { 0, 1, 2, 3 };
+    channelOrder[sdlR] = (uint8_t)backR;
+    channelOrder[sdlG] = (uint8_t)backG;
+    channelOrder[sdlB] = (uint8_t)backB;
+    channelOrder[sdlA] = (uint8_t)backA;
+    ForEachPaintRow(surfacePixels, nSurfaceWidth, rcPaint, [&channelOrder](uint32_t* pRowPixels, size_t nCount) {
+            PixelKernels::SwizzleChannels(pRowPixels, nCount, channelOrder);
+        });
 }
 
 void SkRasterWindowContext_SDL::UpdateColorAlpha(void* surfacePixels, int32_t nSurfaceWidth, const UiRect& rcPaint, uint8_t nLayeredWindowAlpha,
-                                                 int32_t sdlR, int32_t sdlG, int32_t sdlB, int32_t sdlA)
+                                                 int32_t /*sdlR*/, int32_t /*sdlG*/, int32_t /*sdlB*/, int32_t /*sdlA*/)
 {
     if ((surfacePixels == nullptr) || (nSurfaceWidth < 1) || rcPaint.IsEmpty() || (nLayeredWindowAlpha == 255)) {
         return;
     }
-    const int32_t nMaxRow = rcPaint.top + rcPaint.Height();
-    const int32_t nWidth = rcPaint.Width();
-    for (int32_t nRow = rcPaint.top; nRow < nMaxRow; ++nRow) {
-        for (int32_t nCol = 0; nCol < nWidth; ++nCol) {
-            uint32_t* pColorValue = (uint32_t*)surfacePixels + nRow * nSurfaceWidth + rcPaint.left + nCol;
-            uint8_t& r = ((uint8_t*)pColorValue)[sdlR];
-            uint8_t& g = ((uint8_t*)pColorValue)[sdlG];
-            uint8_t& b = ((uint8_t*)pColorValue)[sdlB];
-            uint8_t& a = ((uint8_t*)pColorValue)[sdlA];
-            r = r * nLayeredWindowAlpha / 255;
-            g = g * nLayeredWindowAlpha / 255;
-            b = b * nLayeredWindowAlpha / 255;
-            a = a * nLayeredWindowAlpha / 255;
-        }
-    }
+    //R、G、B、A四个通道都按透明度缩放，与字节顺序无关
+    ForEachPaintRow(surfacePixels, nSurfaceWidth, rcPaint, [nLayeredWindowAlpha](uint32_t* pRowPixels, size_t nCount) {
+            PixelKernels::ScaleChannels(pRowPixels, nCount, nLayeredWindowAlpha);
+        });
 }
 
 void SkRasterWindowContext_SDL::GetClientRect(UiRect& rcClient) const
@@ -9,6 +9,8 @@
 
 #include "include/core/SkSurface.h"
 #include "include/core/SkCanvas.h"
+#include "include/core/SkDrawable.h"
+#include "include/core/SkPictureRecorder.h"
 #include "src/base/SkAutoMalloc.h"
 #include "tools/window/RasterWindowContext.h"
 
@@ -20,6 +22,12 @@
 
 #include "SkiaHeaderEnd.h"
 
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 //SDL的类型，提前声明
 struct SDL_Window;
 struct SDL_Texture;
@@ -27,6 +35,7 @@ struct SDL_Texture;
 namespace ui 
 {
 class UiRect;
+class WeakFlag;
 class IRender;
 class IRenderPaint;
 
@@ -54,26 +63,46 @@ public:
     */
     bool PaintAndSwapBuffers(IRender* pRender, IRenderPaint* pRenderPaint);
 
+    /** 设置是否在独立的渲染线程中绘制
+    *   开启后，PaintAndSwapBuffers只录制绘制命令（SkPicture），由渲染线程回放到后台缓冲区，
+    *   光栅化完成后再回到UI线程提交到窗口（SDL的窗口函数只能在UI线程中调用）
+    * @param [in] bEnable true表示在渲染线程中绘制，false表示在UI线程中同步绘制
+    */
+    bool SetRenderThreadEnabled(bool bEnable);
+
+    /** 是否在独立的渲染线程中绘制
+    */
+    bool IsRenderThreadEnabled() const;
+
+    /** 获取正在录制绘制命令的画布，未在录制时返回nullptr
+    */
+    SkCanvas* GetRecordingCanvas() const;
+
+    /** 等待渲染线程完成当前的光栅化，并在UI线程中完成所有未完成的绘制和提交
+    * @param [in] bDiscard true表示丢弃尚未光栅化和提交的绘制数据（窗口大小变化等情况下，后续会完整重绘）
+    */
+    void FlushRenderThread(bool bDiscard);
+
 protected:
     virtual void onSwapBuffers() override;
 
     /** 绘制结束后，绘制数据从渲染引擎更新到窗口
-    * @param [in] hPaintDC 当前绘制的DC
-    * @param [in] rcPaint 绘制的区域
-    * @param [in] pRender 绘制引擎接口，用于将绘制结果应用到窗口
-    * @param [in] nLayeredWindowAlpha 窗口透明度，在UpdateLayeredWindow函数中作为参数使用
+    * @param [in] rcPaints 绘制的区域（互不重叠的矩形列表）
+    * @param [in] nLayeredWindowAlpha 窗口透明度
     * @return 成功返回true，失败则返回false
     */
-    bool SwapPaintBuffers(const UiRect& rcPaint, uint8_t nLayeredWindowAlpha);
+    bool SwapPaintBuffers(const std::vector<UiRect>& rcPaints, uint8_t nLayeredWindowAlpha);
 
     /** 绘制结束后，绘制数据从渲染引擎更新到窗口(直接通过窗口的Surface更新绘制数据到窗口设备)
-    * @param [in] hPaintDC 当前绘制的DC
-    * @param [in] rcPaint 绘制的区域
-    * @param [in] pRender 绘制引擎接口，用于将绘制结果应用到窗口
-    * @param [in] nLayeredWindowAlpha 窗口透明度，在UpdateLayeredWindow函数中作为参数使用
+    * @param [in] rcPaints 绘制的区域（互不重叠的矩形列表）
+    * @param [in] nLayeredWindowAlpha 窗口透明度
     * @return 成功返回true，失败则返回false
     */
-    bool SwapPaintBuffersFast(const UiRect& rcPaint, uint8_t nLayeredWindowAlpha);
+    bool SwapPaintBuffersFast(const std::vector<UiRect>& rcPaints, uint8_t nLayeredWindowAlpha);
+
+    /** 判断绘制区域是否为整个窗口
+    */
+    bool IsFullPaint(const UiRect& rcPaint) const;
 
     /** 获取当前窗口的客户区矩形
     * @param [out] rcClient 返回窗口的客户区坐标
@@ -88,6 +117,41 @@ protected:
     */
     void Clear();
 
+    /** 根据窗口的Surface更新Skia的后台缓冲区：条件满足时，Skia直接绘制到窗口Surface的内存中，避免复制数据
+    * @param [in] nLayeredWindowAlpha 窗口透明度
+    * @return 如果后台缓冲区的内存发生变化（原有的绘制数据失效，需要完整重绘），返回true；否则返回false
+    */
+    bool UpdateBackbufferSurface(uint8_t nLayeredWindowAlpha);
+
+    /** 获取可与Skia共享内存的窗口Surface数据（大小、颜色顺序一致，且窗口不透明），不可共享时返回nullptr
+    * @param [in] nLayeredWindowAlpha 窗口透明度
+    */
+    void* GetShareableWindowPixels(uint8_t nLayeredWindowAlpha) const;
+
+    /** 获取Skia后台缓冲区的数据
+    */
+    void* GetBackbufferPixels() const;
+
+    /** 渲染线程的线程函数
+    */
+    void RenderThreadProc();
+
+    /** 停止渲染线程
+    * @param [in] bDiscard true表示丢弃尚未完成的绘制数据（窗口销毁时），false表示完成绘制后再停止
+    */
+    void StopRenderThread(bool bDiscard);
+
+    /** 将录制完成的绘制命令交给渲染线程
+    * @param [in] skDrawable 录制的绘制命令
+    * @param [in] rcPaints 绘制的区域
+    * @param [in] nLayeredWindowAlpha 窗口透明度
+    */
+    void PostRenderFrame(sk_sp<SkDrawable> skDrawable, const std::vector<UiRect>& rcPaints, uint8_t nLayeredWindowAlpha);
+
+    /** 提交渲染线程光栅化完成的数据到窗口（在UI线程中执行）
+    */
+    void PresentRenderFrame();
+
 private:
     /** 获取Skia的颜色值顺序
     */
@@ -121,6 +185,10 @@ private:
     */
     sk_sp<SkSurface> m_fBackbufferSurface;
 
+    /** 与Skia共享内存的窗口Surface数据（Skia直接绘制到窗口Surface中），为nullptr时表示使用m_fSurfaceMemory
+    */
+    void* m_pSharedPixels;
+
     /** 关联的窗口
     */
     SDL_Window* m_sdlWindow;
@@ -128,6 +196,57 @@ private:
     /** SDL绘制的Texture
     */
     SDL_Texture* m_sdlTextrue;
+
+private:
+    /** 渲染线程的一帧数据（可能由UI线程中的多次绘制合并而成，按顺序回放）
+    */
+    struct RenderFrame
+    {
+        std::vector<sk_sp<SkDrawable>> m_drawables;
+        std::vector<UiRect> m_rcPaints;
+        uint8_t m_nLayeredWindowAlpha = 255;
+    };
+
+    /** 渲染线程的状态
+    */
+    enum class RenderState
+    {
+        kIdle,          //空闲
+        kRasterizing,   //正在光栅化（后台缓冲区正在写入）
+        kPresenting     //光栅化完成，等待UI线程提交到窗口
+    };
+
+    /** 录制绘制命令
+    */
+    SkPictureRecorder m_pictureRecorder;
+
+    /** 正在录制绘制命令的画布
+    */
+    SkCanvas* m_pRecordingCanvas;
+
+    /** 渲染线程
+    */
+    std::unique_ptr<std::thread> m_pRenderThread;
+
+    /** 渲染线程的同步锁和事件通知
+    */
+    std::mutex m_renderMutex;
+    std::condition_variable m_renderCv;
+    std::condition_variable m_renderDoneCv;
+
+    /** 渲染线程的状态，是否需要退出
+    */
+    RenderState m_renderState;
+    bool m_bStopRenderThread;
+
+    /** 已录制、等待光栅化的数据，以及光栅化完成、等待提交的数据
+    */
+    RenderFrame m_pendingFrame;
+    RenderFrame m_presentFrame;
+
+    /** 提交任务的生命周期标志（对象销毁后，已投递到UI线程的提交任务不再执行）
+    */
+    std::shared_ptr<WeakFlag> m_spPresentFlag;
 };
 
 } // namespace ui
@@ -1,5 +1,6 @@
 #include "SkRasterWindowContext_Windows.h"
 #include "duilib/Render/IRender.h"
+#include "duilib/Core/DirtyRegion.h"
 #include "duilib/Utils/PerformanceUtil.h"
 
 #ifdef DUILIB_BUILD_FOR_WIN
@@ -141,6 +142,10 @@ bool SkRasterWindowContext_Windows::PaintAndSwapBuffers(IRender* pRender, IRende
     //窗口透明度
     uint8_t nLayeredWindowAlpha = pRenderPaint->GetLayeredWindowAlpha();
 
+    //更新区域由多个矩形构成时，分块绘制（需要在BeginPaint之前获取）
+    std::vector<UiRect> rcUpdates;
+    GetUpdateRects(rcUpdates);
+
     //开始绘制
     bool bRet = false;
     PAINTSTRUCT ps = { 0, };
@@ -152,7 +157,16 @@ bool SkRasterWindowContext_Windows::PaintAndSwapBuffers(IRender* pRender, IRende
     rcPaint.bottom = ps.rcPaint.bottom;
     if (!rcPaint.IsEmpty() && (hPaintDC != nullptr)) {
         //执行绘制
-        bRet = pRenderPaint->DoPaint(rcPaint);
+        if (rcUpdates.empty()) {
+            bRet = pRenderPaint->DoPaint(rcPaint);
+        }
+        else {
+            for (UiRect& rcUpdate : rcUpdates) {
+                if (rcUpdate.Intersect(rcPaint) && pRenderPaint->DoPaint(rcUpdate)) {
+                    bRet = true;
+                }
+            }
+        }
 
         //绘制完成后，更新到窗口
         SwapPaintBuffers(hPaintDC, rcPaint, pRender, nLayeredWindowAlpha);
@@ -247,6 +261,34 @@ bool SkRasterWindowContext_Windows::SwapPaintBuffers(HDC hPaintDC, const UiRect&
     return bPainted;
 }
 
+void SkRasterWindowContext_Windows::GetUpdateRects(std::vector<UiRect>& rcUpdates) const
+{
+    rcUpdates.clear();
+    HRGN hUpdateRgn = ::CreateRectRgn(0, 0, 0, 0);
+    if (hUpdateRgn == nullptr) {
+        return;
+    }
+    if (::GetUpdateRgn(m_hWnd, hUpdateRgn, FALSE) == COMPLEXREGION) {
+        DWORD nDataSize = ::GetRegionData(hUpdateRgn, 0, nullptr);
+        if (nDataSize > sizeof(RGNDATAHEADER)) {
+            std::vector<uint8_t> rgnData(nDataSize);
+            RGNDATA* pRgnData = (RGNDATA*)rgnData.data();
+            if (::GetRegionData(hUpdateRgn, nDataSize, pRgnData) == nDataSize) {
+                //系统返回的区域由很多水平条带构成，通过DirtyRegion合并为少量互不重叠的矩形
+                DirtyRegion updateRegion;
+                const RECT* pRects = (const RECT*)pRgnData->Buffer;
+                for (DWORD nIndex = 0; nIndex < pRgnData->rdh.nCount; ++nIndex) {
+                    updateRegion.AddRect(UiRect(pRects[nIndex].left, pRects[nIndex].top, pRects[nIndex].right, pRects[nIndex].bottom));
+                }
+                if (updateRegion.GetRects().size() > 1) {
+                    rcUpdates = updateRegion.GetRects();
+                }
+            }
+        }
+    }
+    ::DeleteObject(hUpdateRgn);
+}
+
 HBITMAP SkRasterWindowContext_Windows::GetHBitmap() const
 {
     ASSERT(m_hBitmap != nullptr);
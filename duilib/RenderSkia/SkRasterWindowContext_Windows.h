@@ -11,6 +11,8 @@
 #include "tools/window/RasterWindowContext.h"
 #include "SkiaHeaderEnd.h"
 
+#include <vector>
+
 // DisplayParams.fGrContextOptions 类型为GrContextOptions:
 // 在GR_TEST_UTILS宏定义和不定义的情况下，结构体大小会不同，如果不一致会导致程序崩溃，注意检查该宏定义的一致性
 #ifndef SK_GL
@@ -63,6 +65,11 @@ protected:
     */
     bool SwapPaintBuffers(HDC hPaintDC, const UiRect& rcPaint, IRender* pRender, uint8_t nLayeredWindowAlpha) const;
 
+    /** 获取窗口的更新区域（由多个矩形构成时，合并为互不重叠的少量矩形，以实现分块绘制）
+    * @param [out] rcUpdates 返回更新区域的矩形列表，如果更新区域只是一个矩形，则返回空
+    */
+    void GetUpdateRects(std::vector<UiRect>& rcUpdates) const;
+
     /** 获取当前窗口的客户区矩形
     * @param [out] rcClient 返回窗口的客户区坐标
     */
@@ -349,7 +349,7 @@ void SkTextBox::setSpacing(SkScalar mul, SkScalar add)
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
-SkScalar SkTextBox::visit(Visitor& visitor) const {
+SkScalar SkTextBox::visit(Visitor& visitor, bool bSkipHiddenLines) const {
     const char* text = fText;
     size_t len = fLen;
     SkTextEncoding textEncoding = fTextEncoding;
@@ -417,7 +417,7 @@ SkScalar SkTextBox::visit(Visitor& visitor) const {
                         font, paint, 
                         marginWidth, lineMode,
                         &trailing);
-        if (y + metrics.fDescent + metrics.fLeading > 0) {
+        if (!bSkipHiddenLines || (y + metrics.fDescent + metrics.fLeading > 0)) {
 
             if (textAlign == kLeft_Align) {
                 //横向：左对齐
@@ -580,8 +580,59 @@ static bool EllipsisText(const char text[], size_t length, SkTextEncoding textEn
     return false;
 }
 
-static void TextBox_DrawText(SkTextBox* textBox, 
-                             SkCanvas* canvas,
+/** 一行文字的绘制输出：绘制到画布，或者记录为排版结果
+*/
+class TextBoxOutput {
+public:
+    virtual ~TextBoxOutput() {}
+    virtual void drawText(const char text[], size_t length, SkTextEncoding textEncoding,
+                          SkScalar x, SkScalar y,
+                          const SkFont& font, const SkPaint& paint) = 0;
+    virtual void drawRect(const SkRect& rect, const SkPaint& paint) = 0;
+};
+
+class CanvasOutput : public TextBoxOutput {
+    SkCanvas* fCanvas;
+public:
+    explicit CanvasOutput(SkCanvas* canvas): fCanvas(canvas) {
+    }
+
+    void drawText(const char text[], size_t length, SkTextEncoding textEncoding,
+                  SkScalar x, SkScalar y,
+                  const SkFont& font, const SkPaint& paint) override {
+        fCanvas->drawSimpleText(text, length, textEncoding, x, y, font, paint);
+    }
+
+    void drawRect(const SkRect& rect, const SkPaint& paint) override {
+        fCanvas->drawRect(rect, paint);
+    }
+};
+
+class LayoutOutput : public TextBoxOutput {
+public:
+    SkTextBlobBuilder fBuilder;
+    std::vector<SkRect> fLineRects;
+
+    void drawText(const char text[], size_t length, SkTextEncoding textEncoding,
+                  SkScalar x, SkScalar y,
+                  const SkFont& font, const SkPaint& /*paint*/) override {
+        //文字在绘制时可能是临时生成的（省略号），需要立即转换为字形
+        const int count = (int)font.countText(text, length, textEncoding);
+        if (count <= 0) {
+            return;
+        }
+        SkTextBlobBuilder::RunBuffer runBuffer = fBuilder.allocRun(font, count, x, y);
+        SkSpan<SkGlyphID> glyphsSpan(runBuffer.glyphs, count);
+        font.textToGlyphs(text, length, textEncoding, glyphsSpan);
+    }
+
+    void drawRect(const SkRect& rect, const SkPaint& /*paint*/) override {
+        fLineRects.push_back(rect);
+    }
+};
+
+static void TextBox_DrawText(const SkTextBox* textBox, 
+                             TextBoxOutput* output,
                              const char text[], size_t length, SkTextEncoding textEncoding, 
                              SkScalar x, SkScalar y,
                              const SkFont& font, const SkPaint& paint,
@@ -605,7 +656,7 @@ static void TextBox_DrawText(SkTextBox* textBox,
     bool isSingleLine = textBox->getLineMode() == SkTextBox::kOneLine_Mode;
 
     if (!bEndEllipsis && !bPathEllipsis && !bUnderline && !bStrikeOut) {
-        canvas->drawSimpleText(text, length, textEncoding, x, y, font, paint);
+        output->drawText(text, length, textEncoding, x, y, font, paint);
     }
     else {
         bool needEllipsis = false;
@@ -627,7 +678,7 @@ static void TextBox_DrawText(SkTextBox* textBox,
             }
         }
         if(!needEllipsis && !bUnderline && !bStrikeOut) {
-            canvas->drawSimpleText(text, length, textEncoding, x, y, font, paint);
+            output->drawText(text, length, textEncoding, x, y, font, paint);
         }
         else {
             std::string string_utf8;
@@ -650,7 +701,7 @@ static void TextBox_DrawText(SkTextBox* textBox,
                 }
             }
             //绘制文本
-            canvas->drawSimpleText(text, length, textEncoding, x, y, font, paint);
+            output->drawText(text, length, textEncoding, x, y, font, paint);
             if (bUnderline || bStrikeOut) {
                 SkScalar width = font.measureText(text, length, textEncoding, nullptr, &paint);
 
@@ -670,7 +721,7 @@ static void TextBox_DrawText(SkTextBox* textBox,
                     const SkScalar top = y - text_size * kStrikeThroughOffset - height / 2;
                     SkScalar x_scalar = SkIntToScalar(x);
                     const SkRect r = SkRect::MakeLTRB(x_scalar, top, x_scalar + width, top + height);
-                    canvas->drawRect(r, paint);
+                    output->drawRect(r, paint);
                 }
                 if (bUnderline) {
                     //绘制下划线
@@ -682,7 +733,7 @@ static void TextBox_DrawText(SkTextBox* textBox,
                                                 y + (text_size *
                                                     (kUnderlineOffset +
                                                     (thickness_factor * kLineThicknessFactor))));
-                    canvas->drawRect(r, paint);
+                    output->drawRect(r, paint);
                 }
             }
         }
@@ -692,11 +743,11 @@ static void TextBox_DrawText(SkTextBox* textBox,
 ///////////////////////////////////////////////////////////////////////////////
 
 class CanvasVisitor : public SkTextBox::Visitor {
-    SkCanvas* fCanvas;
-    SkTextBox* fTextBox;
+    TextBoxOutput* fOutput;
+    const SkTextBox* fTextBox;
 public:
-    CanvasVisitor(SkCanvas* canvas, SkTextBox* textBox): 
-         fCanvas(canvas)
+    CanvasVisitor(TextBoxOutput* output, const SkTextBox* textBox): 
+         fOutput(output)
         ,fTextBox(textBox) {
     }
 
@@ -707,7 +758,7 @@ public:
     {
         //调用单独封装的函数绘制文字，便于扩展
         TextBox_DrawText(fTextBox,
-                         fCanvas,
+                         fOutput,
                          text, length, textEncoding,
                          x, y,
                          font, paint,
@@ -792,7 +843,8 @@ void SkTextBox::draw(SkCanvas* canvas) {
         saveCount = canvas->save();
         canvas->clipRect(fBox, true);
     }
-    CanvasVisitor sink(canvas, this);
+    CanvasOutput output(canvas);
+    CanvasVisitor sink(&output, this);
     this->visit(sink);
     if (fClipBox) {
         canvas->restoreToCount(saveCount);
@@ -837,6 +889,47 @@ sk_sp<SkTextBlob> SkTextBox::snapshotTextBlob(SkScalar* computedBottom) const {
     return visitor.fBuilder.make();
 }
 
+void SkTextBox::makeLayout(SkTextBoxLayout* layout) const {
+    SkASSERT(layout != nullptr);
+    if (layout == nullptr) {
+        return;
+    }
+    layout->fTextBlob.reset();
+    layout->fLineRects.clear();
+    layout->fBox = fBox;
+    layout->fClipBox = fClipBox;
+    if ((fText == nullptr) || (fLen == 0) || (fPaint == nullptr) || (fFont == nullptr)) {
+        return;
+    }
+    LayoutOutput output;
+    CanvasVisitor sink(&output, this);
+    this->visit(sink, false);
+    layout->fTextBlob = output.fBuilder.make();
+    layout->fLineRects.swap(output.fLineRects);
+}
+
+void SkTextBox::drawLayout(SkCanvas* canvas, const SkTextBoxLayout& layout,
+                           SkScalar dx, SkScalar dy, const SkPaint& paint) {
+    SkASSERT(canvas != nullptr);
+    if ((canvas == nullptr) || ((layout.fTextBlob == nullptr) && layout.fLineRects.empty())) {
+        return;
+    }
+    int saveCount = 0;
+    if (layout.fClipBox) {
+        saveCount = canvas->save();
+        canvas->clipRect(layout.fBox.makeOffset(dx, dy), true);
+    }
+    if (layout.fTextBlob != nullptr) {
+        canvas->drawTextBlob(layout.fTextBlob, dx, dy, paint);
+    }
+    for (const SkRect& rect : layout.fLineRects) {
+        canvas->drawRect(rect.makeOffset(dx, dy), paint);
+    }
+    if (layout.fClipBox) {
+        canvas->restoreToCount(saveCount);
+    }
+}
+
 bool SkTextBox::TextToGlyphs(const void* text, size_t byteLength, SkTextEncoding textEncoding,
                              const SkFont& font,
                              std::vector<SkGlyphID>& glyphs,
@@ -10,6 +10,7 @@
 
 #include "SkiaHeaderBegin.h"
 #include "include/core/SkCanvas.h"
+#include "include/core/SkTextBlob.h"
 #include "SkiaHeaderEnd.h"
 
 #include <vector>
@@ -21,6 +22,22 @@
 namespace ui
 {
 
+/** SkTextBox的排版结果：文字的字形及位置，下划线和删除线的区域
+*   排版结果与文字颜色无关，可以使用不同的绘制属性重复绘制
+*/
+struct SkTextBoxLayout
+{
+    //文字的字形及位置（无可绘制的文字时为nullptr）
+    sk_sp<SkTextBlob> fTextBlob;
+
+    //下划线和删除线的区域
+    std::vector<SkRect> fLineRects;
+
+    //文字绘制区域，及是否对该区域做裁剪
+    SkRect fBox = SkRect::MakeEmpty();
+    bool fClipBox = true;
+};
+
 /** \class SkTextBox
 
     SkTextBox is a helper class for drawing 1 or more lines of text
@@ -148,6 +165,19 @@ public:
 
     sk_sp<SkTextBlob> snapshotTextBlob(SkScalar* computedBottom) const;
 
+    /** 生成排版结果（含省略号、下划线和删除线），需要先调用setText
+    *   排版时不跳过画布上方不可见的行，排版结果可以在不同的画布原点下使用
+    */
+    void makeLayout(SkTextBoxLayout* layout) const;
+
+    /** 绘制排版结果
+    * @param [in] dx 横向偏移（画布原点）
+    * @param [in] dy 纵向偏移（画布原点）
+    * @param [in] paint 绘制属性（文字颜色等）
+    */
+    static void drawLayout(SkCanvas* canvas, const SkTextBoxLayout& layout,
+                           SkScalar dx, SkScalar dy, const SkPaint& paint);
+
     class Visitor {
     public:
         virtual ~Visitor() {}
@@ -158,7 +188,10 @@ public:
     };
 
 private:
-    SkScalar visit(Visitor& visitor) const;
+    /** 按行遍历需要绘制的文字
+    * @param [in] bSkipHiddenLines 是否跳过画布上方不可见的行
+    */
+    SkScalar visit(Visitor& visitor, bool bSkipHiddenLines = true) const;
 
     /** 将文本转换为Glyphs
     * @param [out] glyphs 转换结果Glyphs
@@ -15,6 +15,7 @@ namespace rc {
 ResourceCompiler::ResourceCompiler()
     : m_compressionThreshold(1024)
     , m_compressionEnabled(true)
+    , m_xmlOutputSuffix(".xmt")
 {
 }
 
@@ -126,6 +127,7 @@ bool ResourceCompiler::GenerateCppCode(const std::filesystem::path& outputPath,
     out << "#define " << headerGuard << "\n\n";
     out << "#include <cstdint>\n\n";
 
+    std::vector<ResourceEntry> entries = m_qrc.entries;
     std::vector<std::vector<uint8_t>> fileContents;
     size_t totalDataSize = 0;
 
@@ -142,8 +144,27 @@ bool ResourceCompiler::GenerateCppCode(const std::filesystem::path& outputPath,
         totalDataSize += content.size();
     }
 
+    if (m_xmlCompiler) {
+        const size_t sourceCount = entries.size();
+        for (size_t i = 0; i < sourceCount; ++i) {
+            if (!IsXmlFile(entries[i].filePath) || fileContents[i].empty()) {
+                continue;
+            }
+            std::vector<uint8_t> compiled;
+            if (!m_xmlCompiler(fileContents[i], compiled) || compiled.empty()) {
+                ReportWarning("Failed to compile XML: " + entries[i].filePath);
+                continue;
+            }
+            ResourceEntry compiledEntry = entries[i];
+            compiledEntry.resourcePath += m_xmlOutputSuffix;
+            entries.push_back(compiledEntry);
+            totalDataSize += compiled.size();
+            fileContents.push_back(std::move(compiled));
+        }
+    }
+
     size_t dataOffset = sizeof(uint32_t) * 3;
-    for (const auto& entry : m_qrc.entries) {
+    for (const auto& entry : entries) {
         dataOffset += sizeof(uint32_t) * 3 + entry.resourcePath.length();
     }
 
@@ -154,14 +175,14 @@ bool ResourceCompiler::GenerateCppCode(const std::filesystem::path& outputPath,
     out << "    // Header: magic, version, entry count\n";
     out << "    0x52, 0x49, 0x55, 0x44,  // Magic: 'DUIR'\n";
     out << "    0x01, 0x00, 0x00, 0x00,  // Version: 1\n";
-    out << "    " << m_qrc.entries.size() << ", 0x00, 0x00, 0x00,  // Entry count\n";
+    out << "    " << entries.size() << ", 0x00, 0x00, 0x00,  // Entry count\n";
     
     out << "\n    // Entry table\n";
     
     size_t currentDataOffset = dataOffset;
     
-    for (size_t i = 0; i < m_qrc.entries.size(); ++i) {
-        const auto& entry = m_qrc.entries[i];
+    for (size_t i = 0; i < entries.size(); ++i) {
+        const auto& entry = entries[i];
         const auto& content = fileContents[i];
         
         out << "    // Entry " << i << ": " << entry.resourcePath << "\n";
@@ -181,8 +202,8 @@ bool ResourceCompiler::GenerateCppCode(const std::filesystem::path& outputPath,
     
     out << "    // Resource data\n";
     
-    for (size_t i = 0; i < m_qrc.entries.size(); ++i) {
-        const auto& entry = m_qrc.entries[i];
+    for (size_t i = 0; i < entries.size(); ++i) {
+        const auto& entry = entries[i];
         const auto& content = fileContents[i];
         
         if (!content.empty()) {
@@ -227,6 +248,12 @@ void ResourceCompiler::SetCompressionEnabled(bool enabled)
     m_compressionEnabled = enabled;
 }
 
+void ResourceCompiler::SetXmlCompiler(const XmlCompileFunction& xmlCompiler, const std::string& outputSuffix)
+{
+    m_xmlCompiler = xmlCompiler;
+    m_xmlOutputSuffix = outputSuffix;
+}
+
 const std::vector<std::string>& ResourceCompiler::GetErrors() const
 {
     return m_errors;
@@ -255,6 +282,13 @@ bool ResourceCompiler::ReadFileContent(const std::filesystem::path& path,
     return file.good();
 }
 
+bool ResourceCompiler::IsXmlFile(const std::string& filePath) const
+{
+    std::string extension = std::filesystem::path(filePath).extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+    return extension == ".xml";
+}
+
 std::string ResourceCompiler::GenerateHeaderGuard(const std::string& resourceName)
 {
     std::string guard = "COMPILED_RESOURCES_" + resourceName + "_H_";
@@ -6,6 +6,7 @@
 #include <string>
 #include <vector>
 #include <filesystem>
+#include <functional>
 
 namespace duilib {
 namespace rc {
@@ -25,6 +26,10 @@ struct QrcFile {
 
 class ResourceCompiler {
 public:
+    // Compiles the content of an XML resource (e.g. into a window template),
+    // returns false to keep only the original XML.
+    typedef std::function<bool(const std::vector<uint8_t>& xmlData, std::vector<uint8_t>& output)> XmlCompileFunction;
+
     ResourceCompiler();
     ~ResourceCompiler();
 
@@ -35,12 +40,18 @@ public:
     
     void SetCompressionThreshold(size_t threshold);
     void SetCompressionEnabled(bool enabled);
+
+    // Each ".xml" resource compiled successfully is emitted a second time as
+    // "<resourcePath><outputSuffix>" holding the compiled data.
+    void SetXmlCompiler(const XmlCompileFunction& xmlCompiler, const std::string& outputSuffix = ".xmt");
     
     const std::vector<std::string>& GetErrors() const;
     const std::vector<std::string>& GetWarnings() const;
 
 private:
     bool ReadFileContent(const std::filesystem::path& path, std::vector<uint8_t>& content);
+
+    bool IsXmlFile(const std::string& filePath) const;
     
     std::string GenerateHeaderGuard(const std::string& resourceName);
     
@@ -56,6 +67,9 @@ private:
     
     size_t m_compressionThreshold;
     bool m_compressionEnabled;
+
+    XmlCompileFunction m_xmlCompiler;
+    std::string m_xmlOutputSuffix;
 };
 
 }
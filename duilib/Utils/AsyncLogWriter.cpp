@@ -0,0 +1,302 @@
+#include "AsyncLogWriter.h"
+#include <algorithm>
+#include <chrono>
+
+namespace ui
+{
+namespace
+{
+/** 下一次运行的序号（所有写入器共用，保证每次运行的序号唯一）
+*/
+std::atomic<uint64_t> s_nNextSessionId(1);
+}
+
+/** 单生产者单消费者的环形队列：写日志的线程添加，后台线程取出
+*/
+class AsyncLogWriter::ThreadQueue
+{
+public:
+    explicit ThreadQueue(size_t nCapacity):
+        m_records(std::max(nCapacity, (size_t)1)),
+        m_nHead(0),
+        m_nTail(0),
+        m_bThreadExited(false)
+    {
+    }
+
+    /** 添加一条日志，队列满时返回false
+    */
+    bool Push(std::string&& record, size_t& nQueueSize)
+    {
+        const size_t nTail = m_nTail.load(std::memory_order_relaxed);
+        const size_t nHead = m_nHead.load(std::memory_order_acquire);
+        if (nTail - nHead >= m_records.size()) {
+            nQueueSize = m_records.size();
+            return false;
+        }
+        m_records[nTail % m_records.size()] = std::move(record);
+        m_nTail.store(nTail + 1, std::memory_order_release);
+        nQueueSize = nTail + 1 - nHead;
+        return true;
+    }
+
+    /** 取出所有日志，追加到records中，返回取出的数据量（字节）
+    */
+    size_t PopAll(std::vector<std::string>& records)
+    {
+        size_t nBytes = 0;
+        size_t nHead = m_nHead.load(std::memory_order_relaxed);
+        const size_t nTail = m_nTail.load(std::memory_order_acquire);
+        for (; nHead != nTail; ++nHead) {
+            std::string& record = m_records[nHead % m_records.size()];
+            nBytes += record.size();
+            records.push_back(std::move(record));
+            record.clear();
+        }
+        m_nHead.store(nHead, std::memory_order_release);
+        return nBytes;
+    }
+
+    /** 队列是否为空（在后台线程中调用）
+    */
+    bool IsEmpty() const
+    {
+        return m_nHead.load(std::memory_order_relaxed) == m_nTail.load(std::memory_order_acquire);
+    }
+
+    /** 日志记录的环形缓冲区
+    */
+    std::vector<std::string> m_records;
+
+    /** 读取位置（后台线程修改）和写入位置（写日志的线程修改），只增不减
+    */
+    std::atomic<size_t> m_nHead;
+    std::atomic<size_t> m_nTail;
+
+    /** 写日志的线程已经退出（或者不再使用该队列），队列为空后可以删除
+    */
+    std::atomic<bool> m_bThreadExited;
+};
+
+/** 线程中缓存的日志队列，线程退出时标记队列不再使用
+*/
+struct AsyncLogWriter::ThreadQueueCache
+{
+    ~ThreadQueueCache()
+    {
+        if (m_spQueue != nullptr) {
+            m_spQueue->m_bThreadExited = true;
+        }
+    }
+
+    uint64_t m_nSessionId = 0;
+    std::shared_ptr<ThreadQueue> m_spQueue;
+};
+
+AsyncLogWriter::AsyncLogWriter():
+    m_nSessionId(0),
+    m_bStop(false),
+    m_bWakeup(false),
+    m_nFlushRequest(0),
+    m_nFlushDone(0),
+    m_nWrittenRecords(0),
+    m_nDroppedRecords(0),
+    m_nWrittenBytes(0),
+    m_nWriteCount(0)
+{
+}
+
+AsyncLogWriter::~AsyncLogWriter()
+{
+    Stop();
+}
+
+bool AsyncLogWriter::Start(const Options& options, const WriteCallback& writeCallback)
+{
+    ASSERT(writeCallback != nullptr);
+    if (writeCallback == nullptr) {
+        return false;
+    }
+    std::lock_guard<std::mutex> guard(m_mutex);
+    if (m_pWriterThread != nullptr) {
+        return false;
+    }
+    m_options = options;
+    m_writeCallback = writeCallback;
+    m_threadQueues.clear();
+    m_bStop = false;
+    m_bWakeup = false;
+    m_nFlushRequest = 0;
+    m_nFlushDone = 0;
+    m_nSessionId = s_nNextSessionId++;
+    m_pWriterThread = std::make_unique<std::thread>(&AsyncLogWriter::WriterThreadProc, this);
+    return true;
+}
+
+void AsyncLogWriter::Stop()
+{
+    std::unique_ptr<std::thread> pWriterThread;
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        if (m_pWriterThread == nullptr) {
+            return;
+        }
+        m_nSessionId = 0;
+        m_bStop = true;
+        pWriterThread.swap(m_pWriterThread);
+        m_cv.notify_one();
+    }
+    pWriterThread->join();
+
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_threadQueues.clear();
+    m_writeCallback = nullptr;
+    m_flushCv.notify_all();
+}
+
+bool AsyncLogWriter::IsRunning() const
+{
+    return m_nSessionId.load() != 0;
+}
+
+bool AsyncLogWriter::Push(std::string&& record)
+{
+    ThreadQueue* pQueue = GetThreadQueue();
+    if (pQueue == nullptr) {
+        return false;
+    }
+    size_t nQueueSize = 0;
+    if (!pQueue->Push(std::move(record), nQueueSize)) {
+        m_nDroppedRecords++;
+        Wakeup();
+        return false;
+    }
+    if (nQueueSize * 2 >= m_options.nQueueCapacity) {
+        //队列已经过半，尽快写入，避免丢弃日志
+        Wakeup();
+    }
+    return true;
+}
+
+void AsyncLogWriter::Flush()
+{
+    std::unique_lock<std::mutex> guard(m_mutex);
+    if ((m_pWriterThread == nullptr) || m_bStop) {
+        return;
+    }
+    const uint64_t nFlushRequest = ++m_nFlushRequest;
+    m_cv.notify_one();
+    while ((m_nFlushDone < nFlushRequest) && (m_pWriterThread != nullptr)) {
+        m_flushCv.wait_for(guard, std::chrono::milliseconds(m_options.nFlushIntervalMs + 100));
+    }
+}
+
+AsyncLogWriter::Stats AsyncLogWriter::GetStats() const
+{
+    Stats stats;
+    stats.nWrittenRecords = m_nWrittenRecords.load();
+    stats.nDroppedRecords = m_nDroppedRecords.load();
+    stats.nWrittenBytes = m_nWrittenBytes.load();
+    stats.nWriteCount = m_nWriteCount.load();
+    return stats;
+}
+
+AsyncLogWriter::ThreadQueue* AsyncLogWriter::GetThreadQueue()
+{
+    const uint64_t nSessionId = m_nSessionId.load(std::memory_order_acquire);
+    if (nSessionId == 0) {
+        return nullptr;
+    }
+    thread_local ThreadQueueCache s_threadQueueCache;
+    if ((s_threadQueueCache.m_nSessionId == nSessionId) && (s_threadQueueCache.m_spQueue != nullptr)) {
+        return s_threadQueueCache.m_spQueue.get();
+    }
+
+    //首次在本线程中写日志，或者缓存的队列属于其他写入器（或者上一次运行）
+    std::shared_ptr<ThreadQueue> spQueue = std::make_shared<ThreadQueue>(m_options.nQueueCapacity);
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        if (m_bStop || (m_pWriterThread == nullptr) || (m_nSessionId.load() != nSessionId)) {
+            return nullptr;
+        }
+        m_threadQueues.push_back(spQueue);
+    }
+    if (s_threadQueueCache.m_spQueue != nullptr) {
+        s_threadQueueCache.m_spQueue->m_bThreadExited = true;
+    }
+    s_threadQueueCache.m_nSessionId = nSessionId;
+    s_threadQueueCache.m_spQueue = spQueue;
+    return spQueue.get();
+}
+
+void AsyncLogWriter::Wakeup()
+{
+    if (!m_bWakeup.exchange(true)) {
+        m_cv.notify_one();
+    }
+}
+
+void AsyncLogWriter::WriterThreadProc()
+{
+    const std::chrono::milliseconds flushInterval(std::max(m_options.nFlushIntervalMs, (uint32_t)1));
+    std::vector<std::shared_ptr<ThreadQueue>> threadQueues;
+    std::vector<std::string> records;
+    size_t nBatchBytes = 0;
+    std::chrono::steady_clock::time_point batchStartTime;
+    while (true) {
+        bool bStop = false;
+        uint64_t nFlushRequest = 0;
+        {
+            std::unique_lock<std::mutex> guard(m_mutex);
+            if (!m_bStop && !m_bWakeup && (m_nFlushRequest == m_nFlushDone)) {
+                m_cv.wait_for(guard, flushInterval);
+            }
+            m_bWakeup = false;
+            bStop = m_bStop;
+            nFlushRequest = m_nFlushRequest;
+
+            //删除线程已经退出且已经取空的队列
+            m_threadQueues.erase(std::remove_if(m_threadQueues.begin(), m_threadQueues.end(),
+                                                [](const std::shared_ptr<ThreadQueue>& spQueue) {
+                                                    return spQueue->m_bThreadExited && spQueue->IsEmpty();
+                                                }), m_threadQueues.end());
+            threadQueues = m_threadQueues;
+        }
+
+        //收集所有线程的日志（不加锁）
+        const bool bBatchEmpty = records.empty();
+        for (const std::shared_ptr<ThreadQueue>& spQueue : threadQueues) {
+            nBatchBytes += spQueue->PopAll(records);
+        }
+        threadQueues.clear();
+        const std::chrono::steady_clock::time_point nowTime = std::chrono::steady_clock::now();
+        if (bBatchEmpty && !records.empty()) {
+            batchStartTime = nowTime;
+        }
+
+        //数据量或者等待时间达到条件，或者有写入请求、需要停止时，批量写入
+        if (!records.empty() &&
+            (bStop || (nFlushRequest != m_nFlushDone) ||
+             (nBatchBytes >= m_options.nFlushBytes) || (nowTime - batchStartTime >= flushInterval))) {
+            m_writeCallback(records);
+            m_nWrittenRecords += records.size();
+            m_nWrittenBytes += nBatchBytes;
+            m_nWriteCount++;
+            records.clear();
+            nBatchBytes = 0;
+        }
+
+        {
+            std::lock_guard<std::mutex> guard(m_mutex);
+            if (m_nFlushDone != nFlushRequest) {
+                m_nFlushDone = nFlushRequest;
+                m_flushCv.notify_all();
+            }
+        }
+        if (bStop) {
+            break;
+        }
+    }
+}
+
+} // namespace ui
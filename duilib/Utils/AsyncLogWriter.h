@@ -0,0 +1,156 @@
+#ifndef UI_UTILS_ASYNC_LOG_WRITER_H_
+#define UI_UTILS_ASYNC_LOG_WRITER_H_
+
+#include "duilib/duilib_defs.h"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ui
+{
+/** 异步日志写入器
+*   1. 每个写日志的线程有独立的无锁队列（单生产者单消费者），写日志时不加锁，不等待磁盘IO
+*   2. 后台线程定时收集所有队列中的日志，按数据量或者时间间隔批量交给写入回调函数
+*   3. 队列容量有上限，队列满时丢弃新的日志并计数，不会阻塞写日志的线程
+*/
+class UILIB_API AsyncLogWriter
+{
+public:
+    /** 批量写入日志的回调函数（在后台线程中调用）
+    * @param [in] records 本批次的日志记录，按每个线程的写入顺序排列
+    */
+    typedef std::function<void(const std::vector<std::string>& records)> WriteCallback;
+
+    /** 运行参数
+    */
+    struct Options
+    {
+        //每个线程的队列容量（日志条数），队列满时丢弃新的日志
+        size_t nQueueCapacity = 4096;
+
+        //累计的日志数据量达到该值（字节）时写入
+        size_t nFlushBytes = 64 * 1024;
+
+        //距离上次写入的时间达到该值（毫秒）时写入
+        uint32_t nFlushIntervalMs = 200;
+    };
+
+    /** 统计数据
+    */
+    struct Stats
+    {
+        //写入的日志条数
+        uint64_t nWrittenRecords = 0;
+
+        //因队列满而丢弃的日志条数
+        uint64_t nDroppedRecords = 0;
+
+        //写入的数据量（字节）
+        uint64_t nWrittenBytes = 0;
+
+        //调用写入回调函数的次数
+        uint64_t nWriteCount = 0;
+    };
+
+public:
+    AsyncLogWriter();
+    ~AsyncLogWriter();
+    AsyncLogWriter(const AsyncLogWriter&) = delete;
+    AsyncLogWriter& operator = (const AsyncLogWriter&) = delete;
+
+    /** 启动后台线程
+    * @param [in] options 运行参数
+    * @param [in] writeCallback 批量写入日志的回调函数
+    */
+    bool Start(const Options& options, const WriteCallback& writeCallback);
+
+    /** 写入所有未写入的日志，然后停止后台线程
+    */
+    void Stop();
+
+    /** 后台线程是否正在运行
+    */
+    bool IsRunning() const;
+
+    /** 添加一条日志（不加锁，不等待）
+    * @param [in] record 日志内容
+    * @return 成功返回true；如果未启动或者队列已满（日志被丢弃），返回false
+    */
+    bool Push(std::string&& record);
+
+    /** 等待调用之前添加的日志全部写入完成
+    */
+    void Flush();
+
+    /** 获取统计数据
+    */
+    Stats GetStats() const;
+
+private:
+    /** 每个线程的日志队列，以及线程中缓存的队列
+    */
+    class ThreadQueue;
+    struct ThreadQueueCache;
+
+    /** 获取当前线程的日志队列（首次调用时创建并注册）
+    */
+    ThreadQueue* GetThreadQueue();
+
+    /** 后台线程的线程函数
+    */
+    void WriterThreadProc();
+
+    /** 唤醒后台线程
+    */
+    void Wakeup();
+
+private:
+    /** 运行参数和写入回调函数
+    */
+    Options m_options;
+    WriteCallback m_writeCallback;
+
+    /** 本次运行的序号（每次启动时分配新的序号，线程缓存的队列据此判断是否属于本次运行）
+    */
+    std::atomic<uint64_t> m_nSessionId;
+
+    /** 所有线程的日志队列
+    */
+    std::vector<std::shared_ptr<ThreadQueue>> m_threadQueues;
+
+    /** 后台线程
+    */
+    std::unique_ptr<std::thread> m_pWriterThread;
+
+    /** 保护队列列表和后台线程状态的锁，以及线程间的事件通知
+    */
+    mutable std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::condition_variable m_flushCv;
+
+    /** 是否需要停止后台线程，是否有唤醒请求
+    */
+    bool m_bStop;
+    std::atomic<bool> m_bWakeup;
+
+    /** 写入请求的序号和已经完成的写入请求序号
+    */
+    uint64_t m_nFlushRequest;
+    uint64_t m_nFlushDone;
+
+    /** 统计数据
+    */
+    std::atomic<uint64_t> m_nWrittenRecords;
+    std::atomic<uint64_t> m_nDroppedRecords;
+    std::atomic<uint64_t> m_nWrittenBytes;
+    std::atomic<uint64_t> m_nWriteCount;
+};
+
+} // namespace ui
+
+#endif // UI_UTILS_ASYNC_LOG_WRITER_H_
@@ -0,0 +1,156 @@
+#include "AttributeNameTable.h"
+#include <algorithm>
+#include <unordered_set>
+
+namespace ui
+{
+AttributeNameTable::AttributeNameTable(std::initializer_list<TEntry> entries)
+{
+    Init(entries.begin(), entries.size());
+}
+
+AttributeNameTable::AttributeNameTable(const std::vector<TEntry>& entries)
+{
+    Init(entries.data(), entries.size());
+}
+
+void AttributeNameTable::Init(const TEntry* entries, size_t nCount)
+{
+    m_names.reserve(nCount);
+    m_ids.reserve(nCount);
+    std::unordered_set<DString> nameSet;
+    nameSet.reserve(nCount);
+    for (size_t nIndex = 0; nIndex < nCount; ++nIndex) {
+        const TEntry& entry = entries[nIndex];
+        ASSERT((entry.m_name != nullptr) && (entry.m_nId >= 0));
+        if ((entry.m_name == nullptr) || (entry.m_nId < 0)) {
+            continue;
+        }
+        //名称重复时，所有偏移值都会映射到同一个槽位，无法生成完美哈希：只保留第一个
+        const bool bNewName = nameSet.insert(entry.m_name).second;
+        ASSERT(bNewName);
+        if (bNewName) {
+            m_names.push_back(entry.m_name);
+            m_ids.push_back(entry.m_nId);
+        }
+    }
+    //槽位数为名称个数的2倍以上（2的整数次方），如果生成失败，增加槽位数（限制重试次数）
+    size_t nSlotCount = 8;
+    while (nSlotCount < m_names.size() * 2) {
+        nSlotCount *= 2;
+    }
+    const int32_t nMaxRetryCount = 8;
+    bool bBuildOk = Build(nSlotCount);
+    for (int32_t nRetry = 0; (nRetry < nMaxRetryCount) && !bBuildOk; ++nRetry) {
+        nSlotCount *= 2;
+        bBuildOk = Build(nSlotCount);
+    }
+    ASSERT(bBuildOk);
+    if (!bBuildOk) {
+        //生成失败时，查找时按顺序比较名称
+        m_slots.clear();
+        m_displacements.clear();
+    }
+}
+
+uint64_t AttributeNameTable::HashName(const DString::value_type* name, size_t nLength)
+{
+    //FNV-1a
+    uint64_t nHash = 14695981039346656037ULL;
+    for (size_t nIndex = 0; nIndex < nLength; ++nIndex) {
+        nHash ^= (uint64_t)name[nIndex];
+        nHash *= 1099511628211ULL;
+    }
+    return nHash;
+}
+
+size_t AttributeNameTable::GetSlot(uint64_t nHash, uint32_t nDisplacement) const
+{
+    uint64_t nValue = nHash ^ ((uint64_t)nDisplacement * 0x9E3779B97F4A7C15ULL);
+    nValue ^= nValue >> 29;
+    nValue *= 0xBF58476D1CE4E5B9ULL;
+    nValue ^= nValue >> 32;
+    return (size_t)nValue & (m_slots.size() - 1);
+}
+
+bool AttributeNameTable::Build(size_t nSlotCount)
+{
+    const size_t nCount = m_names.size();
+    m_slots.assign(nSlotCount, -1);
+    //平均每个桶2个名称
+    m_displacements.assign(nCount / 2 + 1, 0);
+
+    std::vector<uint64_t> hashs(nCount);
+    std::vector<std::vector<size_t>> buckets(m_displacements.size());
+    for (size_t nIndex = 0; nIndex < nCount; ++nIndex) {
+        hashs[nIndex] = HashName(m_names[nIndex].c_str(), m_names[nIndex].size());
+        buckets[(size_t)(hashs[nIndex] >> 32) % buckets.size()].push_back(nIndex);
+    }
+    //名称多的桶优先选择偏移值
+    std::vector<size_t> bucketOrder(buckets.size());
+    for (size_t nBucket = 0; nBucket < buckets.size(); ++nBucket) {
+        bucketOrder[nBucket] = nBucket;
+    }
+    std::stable_sort(bucketOrder.begin(), bucketOrder.end(), [&buckets](size_t a, size_t b) {
+            return buckets[a].size() > buckets[b].size();
+        });
+
+    const uint32_t nMaxDisplacement = 64 * 1024;
+    std::vector<size_t> bucketSlots;
+    for (size_t nBucket : bucketOrder) {
+        const std::vector<size_t>& bucket = buckets[nBucket];
+        if (bucket.empty()) {
+            break;
+        }
+        bool bFound = false;
+        for (uint32_t nDisplacement = 0; (nDisplacement < nMaxDisplacement) && !bFound; ++nDisplacement) {
+            bucketSlots.clear();
+            bFound = true;
+            for (size_t nIndex : bucket) {
+                const size_t nSlot = GetSlot(hashs[nIndex], nDisplacement);
+                if ((m_slots[nSlot] >= 0) ||
+                    (std::find(bucketSlots.begin(), bucketSlots.end(), nSlot) != bucketSlots.end())) {
+                    bFound = false;
+                    break;
+                }
+                bucketSlots.push_back(nSlot);
+            }
+            if (bFound) {
+                m_displacements[nBucket] = nDisplacement;
+                for (size_t nPos = 0; nPos < bucket.size(); ++nPos) {
+                    m_slots[bucketSlots[nPos]] = (int32_t)bucket[nPos];
+                }
+            }
+        }
+        if (!bFound) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int32_t AttributeNameTable::Find(const DString& name) const
+{
+    if (m_slots.empty()) {
+        for (size_t nIndex = 0; nIndex < m_names.size(); ++nIndex) {
+            if (m_names[nIndex] == name) {
+                return m_ids[nIndex];
+            }
+        }
+        return -1;
+    }
+    const uint64_t nHash = HashName(name.c_str(), name.size());
+    const uint32_t nDisplacement = m_displacements[(size_t)(nHash >> 32) % m_displacements.size()];
+    const int32_t nIndex = m_slots[GetSlot(nHash, nDisplacement)];
+    if ((nIndex >= 0) && (m_names[nIndex] == name)) {
+        return m_ids[nIndex];
+    }
+    return -1;
+}
+
+size_t AttributeNameTable::GetCount() const
+{
+    return m_names.size();
+}
+
+}
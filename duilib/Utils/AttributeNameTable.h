@@ -0,0 +1,76 @@
+#ifndef UI_UTILS_ATTRIBUTE_NAME_TABLE_H_
+#define UI_UTILS_ATTRIBUTE_NAME_TABLE_H_
+
+#include "duilib/duilib_defs.h"
+#include <initializer_list>
+#include <vector>
+
+namespace ui
+{
+/** 属性名称到属性ID的查找表（完美哈希），用于控件的SetAttribute函数按属性ID分发
+*   1. 构造时生成完美哈希：名称按哈希值分到若干个桶中，为每个桶选择一个偏移值，使所有名称映射到互不冲突的槽位
+*   2. 查找时只计算一次名称的哈希值，并与槽位中的名称比较一次
+*   3. 同一个属性的多个名称（比如"border_size"和"bordersize"）可以对应相同的属性ID
+*/
+class UILIB_API AttributeNameTable
+{
+public:
+    /** 名称与属性ID
+    */
+    struct TEntry
+    {
+        const DString::value_type* m_name;
+        int32_t m_nId;
+    };
+
+    /** 构造函数
+    * @param [in] entries 名称与属性ID的列表，名称不能重复（重复的名称只保留第一个），属性ID不能为负数
+    */
+    AttributeNameTable(std::initializer_list<TEntry> entries);
+    explicit AttributeNameTable(const std::vector<TEntry>& entries);
+
+    /** 查找名称对应的属性ID
+    * @param [in] name 属性名称
+    * @return 返回属性ID，如果名称不在表中，返回-1
+    */
+    int32_t Find(const DString& name) const;
+
+    /** 表中的名称个数
+    */
+    size_t GetCount() const;
+
+private:
+    /** 计算名称的哈希值
+    */
+    static uint64_t HashName(const DString::value_type* name, size_t nLength);
+
+    /** 按偏移值计算槽位
+    */
+    size_t GetSlot(uint64_t nHash, uint32_t nDisplacement) const;
+
+    /** 添加名称，并生成完美哈希
+    */
+    void Init(const TEntry* entries, size_t nCount);
+
+    /** 生成完美哈希
+    */
+    bool Build(size_t nSlotCount);
+
+private:
+    /** 名称和属性ID
+    */
+    std::vector<DString> m_names;
+    std::vector<int32_t> m_ids;
+
+    /** 每个桶的偏移值
+    */
+    std::vector<uint32_t> m_displacements;
+
+    /** 每个槽位对应的名称下标（-1表示空槽位）
+    */
+    std::vector<int32_t> m_slots;
+};
+
+}
+
+#endif //UI_UTILS_ATTRIBUTE_NAME_TABLE_H_
@@ -2,9 +2,12 @@
 
 #include "duilib/Utils/StringConvert.h"
 #include "duilib/Utils/StringUtil.h"
+#include "duilib/Utils/FilePath.h"
 
 #include <atomic>
 #include <chrono>
+#include <cstdio>
+#include <mutex>
 #include <string>
 
 #ifdef DUILIB_BUILD_FOR_SDL
@@ -13,7 +16,6 @@
 
 #if defined(DUILIB_WITH_GLOG)
     #include <glog/logging.h>
-    #include <mutex>
 #endif
 
 namespace ui
@@ -22,6 +24,11 @@ namespace ui
 static std::chrono::steady_clock::time_point s_startTime = std::chrono::steady_clock::now();
 static std::atomic_bool s_runtimeLoggerEnabled(false);
 
+//异步模式：后台写入对象、写入的日志文件（可选），以及EnableAsyncMode/DisableAsyncMode的互斥锁
+static AsyncLogWriter s_asyncLogWriter;
+static FILE* s_asyncLogFile = nullptr;
+static std::mutex s_asyncModeMutex;
+
 #if defined(DUILIB_WITH_GLOG)
 static std::mutex s_runtimeLoggerMutex;
 static std::string s_runtimeProcessName("duilib");
@@ -112,16 +119,137 @@ bool LogUtil::IsRuntimeLoggerEnabled()
     return s_runtimeLoggerEnabled.load();
 }
 
+/** 异步模式下写入一批日志（在后台写入线程中调用）
+*   有日志文件时合并成一次写入；否则写入glog，或者调试输出
+*/
+static void WriteAsyncLogRecords(const std::vector<std::string>& records)
+{
+    if (s_asyncLogFile != nullptr) {
+        size_t nBatchSize = 0;
+        for (const std::string& record : records) {
+            nBatchSize += record.size();
+        }
+        std::string batch;
+        batch.reserve(nBatchSize);
+        for (const std::string& record : records) {
+            batch += record;
+        }
+        ::fwrite(batch.data(), 1, batch.size(), s_asyncLogFile);
+        ::fflush(s_asyncLogFile);
+        return;
+    }
+
+#if defined(DUILIB_WITH_GLOG)
+    if (LogUtil::IsRuntimeLoggerEnabled()) {
+        for (const std::string& record : records) {
+            size_t nLength = record.size();
+            while ((nLength > 0) && ((record[nLength - 1] == '\n') || (record[nLength - 1] == '\r'))) {
+                --nLength;
+            }
+            LOG(INFO) << record.substr(0, nLength);
+        }
+        return;
+    }
+#endif
+
+#ifdef DUILIB_BUILD_FOR_WIN
+    std::string batch;
+    for (const std::string& record : records) {
+        batch += record;
+    }
+    ::OutputDebugString(StringConvert::UTF8ToT(batch).c_str());
+#elif defined(DUILIB_BUILD_FOR_SDL)
+    for (const std::string& record : records) {
+        SDL_Log("%s", record.c_str());
+    }
+#else
+    UNUSED_VARIABLE(records);
+#endif
+}
+
+bool LogUtil::EnableAsyncMode(const DString& logFilePath, const AsyncLogWriter::Options& options)
+{
+    std::lock_guard<std::mutex> guard(s_asyncModeMutex);
+    if (s_asyncLogWriter.IsRunning()) {
+        return false;
+    }
+    ASSERT(s_asyncLogFile == nullptr);
+    if (!logFilePath.empty()) {
+        FilePath filePath(logFilePath);
+        FILE* f = nullptr;
+#ifdef DUILIB_BUILD_FOR_WIN
+    #ifdef DUILIB_UNICODE
+        ::_wfopen_s(&f, filePath.NativePath().c_str(), _T("ab"));
+    #else
+        ::fopen_s(&f, filePath.NativePath().c_str(), _T("ab"));
+    #endif
+#else
+        f = fopen(filePath.NativePath().c_str(), _T("ab"));
+#endif
+        if (f == nullptr) {
+            return false;
+        }
+        s_asyncLogFile = f;
+    }
+    if (!s_asyncLogWriter.Start(options, WriteAsyncLogRecords)) {
+        if (s_asyncLogFile != nullptr) {
+            ::fclose(s_asyncLogFile);
+            s_asyncLogFile = nullptr;
+        }
+        return false;
+    }
+    return true;
+}
+
+void LogUtil::DisableAsyncMode()
+{
+    std::lock_guard<std::mutex> guard(s_asyncModeMutex);
+    s_asyncLogWriter.Stop();
+    if (s_asyncLogFile != nullptr) {
+        ::fclose(s_asyncLogFile);
+        s_asyncLogFile = nullptr;
+    }
+}
+
+bool LogUtil::IsAsyncMode()
+{
+    return s_asyncLogWriter.IsRunning();
+}
+
+void LogUtil::Flush()
+{
+    s_asyncLogWriter.Flush();
+}
+
+AsyncLogWriter::Stats LogUtil::GetAsyncStats()
+{
+    return s_asyncLogWriter.GetStats();
+}
+
 DString LogUtil::GetTimeStamp()
 {
     std::chrono::steady_clock::time_point nowTime = std::chrono::steady_clock::now();
     auto thisTime = std::chrono::duration_cast<std::chrono::milliseconds>(nowTime - s_startTime);
     uint64_t nTimeMs = static_cast<uint64_t>(thisTime.count());
     uint32_t nHH = static_cast<uint32_t>((nTimeMs / 1000) / 60 / 60);
-    uint32_t nMM = static_cast<uint32_t>((nTimeMs / 1000) / 60);
-    uint32_t nSS = static_cast<uint32_t>(nTimeMs / 1000);
+    uint32_t nMM = static_cast<uint32_t>((nTimeMs / 1000) / 60 % 60);
+    uint32_t nSS = static_cast<uint32_t>(nTimeMs / 1000 % 60);
     uint32_t nMS = static_cast<uint32_t>(nTimeMs % 1000);
-    return StringUtil::Printf(_T("%02u:%02u:%02u.%03u "), nHH, nMM, nSS, nMS);
+    if (nHH >= 100) {
+        return StringUtil::Printf(_T("%02u:%02u:%02u.%03u "), nHH, nMM, nSS, nMS);
+    }
+    //每次输出日志都会调用，不使用Printf格式化："HH:MM:SS.mmm "
+    DString::value_type timeStamp[] = _T("00:00:00.000 ");
+    timeStamp[0] = static_cast<DString::value_type>(_T('0') + nHH / 10);
+    timeStamp[1] = static_cast<DString::value_type>(_T('0') + nHH % 10);
+    timeStamp[3] = static_cast<DString::value_type>(_T('0') + nMM / 10);
+    timeStamp[4] = static_cast<DString::value_type>(_T('0') + nMM % 10);
+    timeStamp[6] = static_cast<DString::value_type>(_T('0') + nSS / 10);
+    timeStamp[7] = static_cast<DString::value_type>(_T('0') + nSS % 10);
+    timeStamp[9] = static_cast<DString::value_type>(_T('0') + nMS / 100);
+    timeStamp[10] = static_cast<DString::value_type>(_T('0') + nMS / 10 % 10);
+    timeStamp[11] = static_cast<DString::value_type>(_T('0') + nMS % 10);
+    return DString(timeStamp, 13);
 }
 
 void LogUtil::Output(const DString& log, bool bPrintTime)
@@ -134,6 +262,12 @@ void LogUtil::Output(const DString& log, bool bPrintTime)
         logMsg = log;
     }
 
+    if (s_asyncLogWriter.IsRunning()) {
+        //异步模式：只加入队列，由后台线程写入
+        s_asyncLogWriter.Push(std::string(StringConvert::TToUTF8(logMsg)));
+        return;
+    }
+
 #if defined(DUILIB_WITH_GLOG)
     if (IsRuntimeLoggerEnabled()) {
         LOG(INFO) << StringConvert::TToUTF8(logMsg);
@@ -153,7 +287,7 @@ void LogUtil::Output(const DString& log, bool bPrintTime)
 void LogUtil::OutputLine(const DString& log, bool bPrintTime)
 {
 #if defined(DUILIB_WITH_GLOG)
-    if (IsRuntimeLoggerEnabled()) {
+    if (!s_asyncLogWriter.IsRunning() && IsRuntimeLoggerEnabled()) {
         Output(log, bPrintTime);
         return;
     }
@@ -166,6 +300,41 @@ void LogUtil::OutputLine(const DString& log, bool bPrintTime)
 #endif
 }
 
+void LogUtil::OutputFields(const DString& log,
+                           const std::vector<std::pair<DString, DString>>& fields,
+                           bool bPrintTime)
+{
+    //格式："log key1=value1 key2=value2"
+    //值中含有空白、引号、等号或者换行时加引号，引号和反斜杠前加反斜杠，换行转义为\r和\n，保证每条日志只占一行
+    DString logMsg = log;
+    for (const std::pair<DString, DString>& field : fields) {
+        logMsg += _T(' ');
+        logMsg += field.first;
+        logMsg += _T('=');
+        if (field.second.find_first_of(_T(" \t\"=\r\n")) == DString::npos) {
+            logMsg += field.second;
+            continue;
+        }
+        logMsg += _T('"');
+        for (DString::value_type ch : field.second) {
+            if (ch == _T('\r')) {
+                logMsg += _T("\\r");
+            }
+            else if (ch == _T('\n')) {
+                logMsg += _T("\\n");
+            }
+            else {
+                if ((ch == _T('"')) || (ch == _T('\\'))) {
+                    logMsg += _T('\\');
+                }
+                logMsg += ch;
+            }
+        }
+        logMsg += _T('"');
+    }
+    OutputLine(logMsg, bPrintTime);
+}
+
 void LogUtil::Debug(const DString& log, bool bPrintTime)
 {
 #ifdef _DEBUG
@@ -2,6 +2,9 @@
 #define UI_UTILS_LOG_UTIL_H_
 
 #include "duilib/duilib_defs.h"
+#include "duilib/Utils/AsyncLogWriter.h"
+#include <utility>
+#include <vector>
 
 namespace ui
 {
@@ -32,6 +35,30 @@ public:
     // Output line log only in Debug build.
     static void DebugLine(const DString& log, bool bPrintTime = true);
 
+    // Output a structured log line: "log key1=value1 key2=value2". Values containing spaces,
+    // quotes, '=' or line breaks are quoted; CR and LF are escaped as \r and \n.
+    static void OutputFields(const DString& log,
+                             const std::vector<std::pair<DString, DString>>& fields,
+                             bool bPrintTime = true);
+
+    // Enable asynchronous mode: log calls only queue the text (per-thread lock-free queues,
+    // records are dropped when a queue is full), a background thread writes the records in
+    // batches to logFilePath, or to the runtime logger / debug output when logFilePath is empty.
+    static bool EnableAsyncMode(const DString& logFilePath = DString(),
+                                const AsyncLogWriter::Options& options = AsyncLogWriter::Options());
+
+    // Write all queued records and switch back to synchronous mode.
+    static void DisableAsyncMode();
+
+    // Query whether asynchronous mode is enabled.
+    static bool IsAsyncMode();
+
+    // Block until the records queued before this call are written (asynchronous mode only).
+    static void Flush();
+
+    // Counters of asynchronous mode: written, dropped records and batches.
+    static AsyncLogWriter::Stats GetAsyncStats();
+
 private:
     static DString GetTimeStamp();
 };
@@ -0,0 +1,198 @@
+#include "Lz4Util.h"
+#include <cstring>
+
+namespace ui
+{
+
+//LZ4数据块格式的常量（与LZ4官方库一致）
+static const size_t kMinMatch = 4;              //最短的匹配长度
+static const size_t kLastLiterals = 5;          //数据块末尾的5个字节必须是字面量
+static const size_t kMFLimit = 12;              //最后一个匹配的起始位置距离数据块末尾至少12个字节
+static const size_t kMaxDistance = 65535;       //匹配的最大回溯距离
+static const size_t kMaxInputSize = 0x7E000000; //单个数据块的最大长度
+static const uint32_t kHashLog = 12;            //哈希表的大小：4096项
+
+static inline uint32_t Read32(const uint8_t* p)
+{
+    uint32_t v = 0;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline uint32_t Hash32(uint32_t v)
+{
+    return (v * 2654435761u) >> (32 - kHashLog);
+}
+
+/** 写入长度的扩展字节（长度值不小于15时使用）
+*/
+static void WriteLength(std::vector<uint8_t>& output, size_t nLength)
+{
+    nLength -= 15;
+    while (nLength >= 255) {
+        output.push_back(255);
+        nLength -= 255;
+    }
+    output.push_back((uint8_t)nLength);
+}
+
+/** 写入一个序列：[token][字面量长度扩展][字面量][偏移][匹配长度扩展]，nMatchLen为0表示最后一个序列（只有字面量）
+*/
+static void WriteSequence(std::vector<uint8_t>& output, const uint8_t* pLiterals, size_t nLiteralLen,
+                          size_t nOffset, size_t nMatchLen)
+{
+    const size_t nTokenPos = output.size();
+    output.push_back(0);
+    uint8_t token = (uint8_t)((nLiteralLen >= 15 ? 15 : nLiteralLen) << 4);
+    if (nLiteralLen >= 15) {
+        WriteLength(output, nLiteralLen);
+    }
+    output.insert(output.end(), pLiterals, pLiterals + nLiteralLen);
+    if (nMatchLen > 0) {
+        output.push_back((uint8_t)(nOffset & 0xFF));
+        output.push_back((uint8_t)((nOffset >> 8) & 0xFF));
+        const size_t nLen = nMatchLen - kMinMatch;
+        token |= (uint8_t)(nLen >= 15 ? 15 : nLen);
+        if (nLen >= 15) {
+            WriteLength(output, nLen);
+        }
+    }
+    output[nTokenPos] = token;
+}
+
+/** 读取长度的扩展字节
+*/
+static bool ReadLength(const uint8_t* pData, size_t nDataSize, size_t& nPos, size_t nMaxLength, size_t& nLength)
+{
+    uint8_t b = 255;
+    while (b == 255) {
+        if (nPos >= nDataSize) {
+            return false;
+        }
+        b = pData[nPos++];
+        nLength += b;
+        if (nLength > nMaxLength) {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t Lz4Util::GetMaxCompressedSize(size_t nDataSize)
+{
+    return nDataSize + nDataSize / 255 + 16;
+}
+
+size_t Lz4Util::CompressBlock(const uint8_t* pData, size_t nDataSize, std::vector<uint8_t>& output)
+{
+    if (((pData == nullptr) && (nDataSize > 0)) || (nDataSize > kMaxInputSize)) {
+        return 0;
+    }
+    const size_t nStartSize = output.size();
+    output.reserve(nStartSize + GetMaxCompressedSize(nDataSize));
+
+    size_t nAnchor = 0;
+    if (nDataSize > kMFLimit) {
+        //哈希表中保存的是位置+1，0表示无数据
+        std::vector<uint32_t> hashTable((size_t)1 << kHashLog, 0);
+        const size_t nMatchStartLimit = nDataSize - kMFLimit;
+        const size_t nMatchEndLimit = nDataSize - kLastLiterals;
+        size_t nPos = 0;
+        while (nPos <= nMatchStartLimit) {
+            const uint32_t nSequence = Read32(pData + nPos);
+            const uint32_t nHash = Hash32(nSequence);
+            const size_t nRef = hashTable[nHash];
+            hashTable[nHash] = (uint32_t)(nPos + 1);
+            if ((nRef == 0) || (nPos - (nRef - 1) > kMaxDistance) || (Read32(pData + nRef - 1) != nSequence)) {
+                //未找到匹配：距离上次匹配越远，步长越大，以加快不可压缩数据的处理速度
+                nPos += 1 + ((nPos - nAnchor) >> 6);
+                continue;
+            }
+            size_t nMatchPos = nRef - 1;
+            //向前扩展匹配
+            while ((nPos > nAnchor) && (nMatchPos > 0) && (pData[nPos - 1] == pData[nMatchPos - 1])) {
+                --nPos;
+                --nMatchPos;
+            }
+            //向后扩展匹配
+            size_t nMatchLen = kMinMatch;
+            while ((nPos + nMatchLen < nMatchEndLimit) && (pData[nPos + nMatchLen] == pData[nMatchPos + nMatchLen])) {
+                ++nMatchLen;
+            }
+            WriteSequence(output, pData + nAnchor, nPos - nAnchor, nPos - nMatchPos, nMatchLen);
+            nPos += nMatchLen;
+            nAnchor = nPos;
+            if (nPos - 2 <= nMatchStartLimit) {
+                hashTable[Hash32(Read32(pData + nPos - 2))] = (uint32_t)(nPos - 2 + 1);
+            }
+        }
+    }
+    //最后一个序列：剩余的字面量
+    WriteSequence(output, pData + nAnchor, nDataSize - nAnchor, 0, 0);
+    return output.size() - nStartSize;
+}
+
+bool Lz4Util::DecompressBlock(const uint8_t* pData, size_t nDataSize, uint8_t* pOutput, size_t nOutputSize)
+{
+    if ((pData == nullptr) || (nDataSize == 0) || ((pOutput == nullptr) && (nOutputSize > 0))) {
+        return false;
+    }
+    size_t nPos = 0;
+    size_t nOutPos = 0;
+    for (;;) {
+        if (nPos >= nDataSize) {
+            return false;
+        }
+        const uint8_t token = pData[nPos++];
+
+        //字面量
+        size_t nLiteralLen = token >> 4;
+        if ((nLiteralLen == 15) && !ReadLength(pData, nDataSize, nPos, nOutputSize, nLiteralLen)) {
+            return false;
+        }
+        if ((nLiteralLen > nDataSize - nPos) || (nLiteralLen > nOutputSize - nOutPos)) {
+            return false;
+        }
+        if (nLiteralLen > 0) {
+            std::memcpy(pOutput + nOutPos, pData + nPos, nLiteralLen);
+        }
+        nPos += nLiteralLen;
+        nOutPos += nLiteralLen;
+        if (nPos == nDataSize) {
+            //最后一个序列只有字面量
+            return nOutPos == nOutputSize;
+        }
+
+        //匹配
+        if (nDataSize - nPos < 2) {
+            return false;
+        }
+        const size_t nOffset = (size_t)pData[nPos] | ((size_t)pData[nPos + 1] << 8);
+        nPos += 2;
+        if ((nOffset == 0) || (nOffset > nOutPos)) {
+            return false;
+        }
+        size_t nMatchLen = token & 0x0F;
+        if ((nMatchLen == 15) && !ReadLength(pData, nDataSize, nPos, nOutputSize, nMatchLen)) {
+            return false;
+        }
+        nMatchLen += kMinMatch;
+        if (nMatchLen > nOutputSize - nOutPos) {
+            return false;
+        }
+        uint8_t* pDest = pOutput + nOutPos;
+        const uint8_t* pSrc = pDest - nOffset;
+        if (nOffset >= nMatchLen) {
+            std::memcpy(pDest, pSrc, nMatchLen);
+        }
+        else {
+            //源和目标重叠（重复模式），需要逐字节复制
+            for (size_t i = 0; i < nMatchLen; ++i) {
+                pDest[i] = pSrc[i];
+            }
+        }
+        nOutPos += nMatchLen;
+    }
+}
+
+}
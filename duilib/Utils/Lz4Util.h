@@ -0,0 +1,40 @@
+#ifndef UI_UTILS_LZ4_UTIL_H_
+#define UI_UTILS_LZ4_UTIL_H_
+
+#include "duilib/duilib_defs.h"
+#include <vector>
+
+namespace ui
+{
+
+/** LZ4数据块（block format）的压缩与解压，数据格式与LZ4官方库的LZ4_compress_default/LZ4_decompress_safe兼容
+*   压缩速度和解压速度都很快，适合用于需要快速加载的缓存文件
+*/
+class UILIB_API Lz4Util
+{
+public:
+    /** 压缩一个数据块，压缩结果追加到output的末尾
+    * @param [in] pData 原始数据
+    * @param [in] nDataSize 原始数据长度(不能超过0x7E000000)
+    * @param [out] output 压缩后的数据
+    * @return 成功返回压缩后的数据长度，失败返回0
+    */
+    static size_t CompressBlock(const uint8_t* pData, size_t nDataSize, std::vector<uint8_t>& output);
+
+    /** 解压一个数据块（对输入数据做完整的越界检查，数据损坏时返回失败）
+    * @param [in] pData 压缩后的数据
+    * @param [in] nDataSize 压缩后的数据长度
+    * @param [out] pOutput 解压后数据的存储位置
+    * @param [in] nOutputSize 解压后的数据长度（必须与原始数据长度一致）
+    * @return 成功返回true，数据损坏或者长度不一致返回false
+    */
+    static bool DecompressBlock(const uint8_t* pData, size_t nDataSize, uint8_t* pOutput, size_t nOutputSize);
+
+    /** 压缩nDataSize长度的数据时，压缩结果的最大长度
+    */
+    static size_t GetMaxCompressedSize(size_t nDataSize);
+};
+
+}
+
+#endif // UI_UTILS_LZ4_UTIL_H_
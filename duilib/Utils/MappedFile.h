@@ -0,0 +1,65 @@
+#ifndef UI_UTILS_MAPPED_FILE_H_
+#define UI_UTILS_MAPPED_FILE_H_
+
+#include "duilib/Utils/FilePath.h"
+
+namespace ui
+{
+
+/** 只读方式的文件内存映射（Windows使用CreateFileMapping，其他平台使用mmap）
+*   映射成功后，文件内容可通过GetData()直接访问，无需读入内存缓冲区
+*/
+class UILIB_API MappedFile
+{
+public:
+    MappedFile();
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+public:
+    /** 以只读方式映射文件（如果已经映射了其他文件，先关闭）
+    * @param [in] filePath 本地文件路径(绝对路径)
+    * @return 映射成功返回true；文件不存在、文件长度为0或者映射失败返回false
+    */
+    bool Open(const FilePath& filePath);
+
+    /** 关闭文件映射
+    */
+    void Close();
+
+    /** 是否已经映射了文件
+    */
+    bool IsOpen() const;
+
+    /** 获取映射的文件数据
+    */
+    const uint8_t* GetData() const;
+
+    /** 获取映射的文件数据长度
+    */
+    size_t GetSize() const;
+
+private:
+    /** 映射的文件数据
+    */
+    const uint8_t* m_pData;
+
+    /** 映射的文件数据长度
+    */
+    size_t m_nSize;
+
+#ifdef DUILIB_BUILD_FOR_WIN
+    /** 文件句柄
+    */
+    HANDLE m_hFile;
+
+    /** 文件映射句柄
+    */
+    HANDLE m_hMapping;
+#endif
+};
+
+}
+
+#endif // UI_UTILS_MAPPED_FILE_H_
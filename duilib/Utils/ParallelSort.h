@@ -0,0 +1,115 @@
+#ifndef UI_UTILS_PARALLEL_SORT_H_
+#define UI_UTILS_PARALLEL_SORT_H_
+
+#include "duilib/duilib_defs.h"
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+namespace ui
+{
+
+/** 多线程稳定排序（归并排序）：数据分段后各线程分别做稳定排序，再逐轮两两归并
+*   排序过程中调用者线程等待排序完成，比较函数会在多个线程中同时调用，必须是线程安全的
+*/
+class ParallelSort
+{
+public:
+    /** 数据量达到该值时才使用多线程排序（线程的创建开销相对于排序耗时可以忽略）
+    */
+    static constexpr size_t kMinParallelSize = 32 * 1024;
+
+    /** 稳定排序（相等的元素保持原来的先后顺序）
+    * @param [in,out] dataList 待排序的数据
+    * @param [in] comp 比较函数，实现(a < b)的比较逻辑
+    * @param [in] nMaxThreads 最大线程数，为0时按CPU核数确定
+    * @param [in] nMinParallelSize 每个线程最少处理的数据量，数据量不足时在当前线程排序
+    */
+    template<typename T, typename TCompare>
+    static void StableSort(std::vector<T>& dataList, TCompare comp,
+                           size_t nMaxThreads = 0, size_t nMinParallelSize = kMinParallelSize)
+    {
+        const size_t nCount = dataList.size();
+        size_t nThreads = GetThreadCount(nCount, nMaxThreads, nMinParallelSize);
+        if (nThreads <= 1) {
+            std::stable_sort(dataList.begin(), dataList.end(), comp);
+            return;
+        }
+
+        //分段：第i段为[bounds[i], bounds[i + 1])
+        std::vector<size_t> bounds;
+        for (size_t i = 0; i <= nThreads; ++i) {
+            bounds.push_back(nCount * i / nThreads);
+        }
+
+        //各段分别排序，当前线程处理第一段
+        std::vector<std::thread> threads;
+        for (size_t i = 1; i < nThreads; ++i) {
+            threads.emplace_back([&dataList, &bounds, &comp, i]() {
+                    std::stable_sort(dataList.begin() + bounds[i], dataList.begin() + bounds[i + 1], comp);
+                });
+        }
+        std::stable_sort(dataList.begin() + bounds[0], dataList.begin() + bounds[1], comp);
+        for (std::thread& th : threads) {
+            th.join();
+        }
+        threads.clear();
+
+        //逐轮两两归并，在两个缓冲区之间交替（std::merge相等时先取前一段的元素，保证稳定）
+        std::vector<T> buffer(nCount);
+        std::vector<T>* pSrc = &dataList;
+        std::vector<T>* pDest = &buffer;
+        while (bounds.size() > 2) {
+            std::vector<size_t> newBounds;
+            const size_t nSegments = bounds.size() - 1;
+            for (size_t i = 0; i < nSegments; i += 2) {
+                newBounds.push_back(bounds[i]);
+                const size_t nBegin = bounds[i];
+                const size_t nMiddle = bounds[i + 1];
+                const size_t nEnd = (i + 2 <= nSegments) ? bounds[i + 2] : nMiddle;
+                auto mergeFunc = [pSrc, pDest, &comp, nBegin, nMiddle, nEnd]() {
+                        std::merge(pSrc->begin() + nBegin, pSrc->begin() + nMiddle,
+                                   pSrc->begin() + nMiddle, pSrc->begin() + nEnd,
+                                   pDest->begin() + nBegin, comp);
+                    };
+                if (i + 2 < nSegments) {
+                    threads.emplace_back(mergeFunc);
+                }
+                else {
+                    mergeFunc();
+                }
+            }
+            newBounds.push_back(nCount);
+            for (std::thread& th : threads) {
+                th.join();
+            }
+            threads.clear();
+            bounds.swap(newBounds);
+            std::swap(pSrc, pDest);
+        }
+        if (pSrc != &dataList) {
+            dataList.swap(buffer);
+        }
+    }
+
+    /** 计算排序使用的线程数
+    * @param [in] nCount 数据量
+    * @param [in] nMaxThreads 最大线程数，为0时按CPU核数确定
+    * @param [in] nMinParallelSize 每个线程最少处理的数据量
+    */
+    static size_t GetThreadCount(size_t nCount, size_t nMaxThreads, size_t nMinParallelSize)
+    {
+        if (nMaxThreads == 0) {
+            nMaxThreads = std::thread::hardware_concurrency();
+        }
+        if (nMinParallelSize == 0) {
+            nMinParallelSize = 1;
+        }
+        size_t nThreads = std::min(nMaxThreads, nCount / nMinParallelSize);
+        return std::max(nThreads, (size_t)1);
+    }
+};
+
+}
+
+#endif // UI_UTILS_PARALLEL_SORT_H_
@@ -1,11 +1,24 @@
 #include "PerformanceUtil.h"
 #include "duilib/Utils/StringUtil.h"
+#include "duilib/Utils/StringConvert.h"
+#include "duilib/Utils/FileUtil.h"
 #include "duilib/Utils/LogUtil.h"
+#include <unordered_map>
 
 namespace ui 
 {
 
-PerformanceUtil::PerformanceUtil()
+/** 每个线程的跟踪记录环形缓冲区容量（必须是2的整数次方）
+*/
+static const size_t s_nTraceBufferSize = 64 * 1024;
+
+/** 当前线程的跟踪记录环形缓冲区
+*/
+static thread_local void* s_pThreadTraceBuffer = nullptr;
+
+PerformanceUtil::PerformanceUtil():
+    m_bTraceEnabled(false),
+    m_traceStartTime(std::chrono::steady_clock::now())
 {
 }
 
@@ -56,4 +69,202 @@ void PerformanceUtil::EndStat(const DString& name)
     stat.maxTime = (std::max)(stat.maxTime, thisTime);
 }
 
+void PerformanceUtil::SetTraceEnabled(bool bEnable)
+{
+    m_bTraceEnabled.store(bEnable, std::memory_order_relaxed);
+}
+
+PerformanceUtil::TTraceBuffer* PerformanceUtil::GetThreadTraceBuffer()
+{
+    TTraceBuffer* pTraceBuffer = (TTraceBuffer*)s_pThreadTraceBuffer;
+    if (pTraceBuffer == nullptr) {
+        std::unique_ptr<TTraceBuffer> spTraceBuffer(new TTraceBuffer);
+        spTraceBuffer->m_events.resize(s_nTraceBufferSize);
+        pTraceBuffer = spTraceBuffer.get();
+
+        std::lock_guard<std::mutex> threadGuard(m_traceMutex);
+        m_traceBuffers.push_back(std::move(spTraceBuffer));
+        pTraceBuffer->m_nThreadIndex = (uint32_t)m_traceBuffers.size();
+        s_pThreadTraceBuffer = pTraceBuffer;
+    }
+    return pTraceBuffer;
+}
+
+void PerformanceUtil::AddTraceEvent(const DString::value_type* name,
+                                    std::chrono::steady_clock::time_point startTime,
+                                    std::chrono::steady_clock::time_point endTime)
+{
+    ASSERT(name != nullptr);
+    if (name == nullptr) {
+        return;
+    }
+    TTraceBuffer* pTraceBuffer = GetThreadTraceBuffer();
+    const uint64_t nWriteCount = pTraceBuffer->m_nWriteCount.load(std::memory_order_relaxed);
+    TTraceEvent& traceEvent = pTraceBuffer->m_events[(size_t)nWriteCount & (s_nTraceBufferSize - 1)];
+    traceEvent.m_name = name;
+    traceEvent.m_nStartUs = std::chrono::duration_cast<std::chrono::microseconds>(startTime - m_traceStartTime).count();
+    traceEvent.m_nDurationUs = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count();
+    //写入数据后再更新计数，导出时据此判断数据是否完整
+    pTraceBuffer->m_nWriteCount.store(nWriteCount + 1, std::memory_order_release);
+}
+
+void PerformanceUtil::ClearTraceEvents()
+{
+    std::lock_guard<std::mutex> threadGuard(m_traceMutex);
+    for (const std::unique_ptr<TTraceBuffer>& spTraceBuffer : m_traceBuffers) {
+        //不重置写入计数（所属线程在无锁更新），只记录清除位置
+        spTraceBuffer->m_nClearCount.store(spTraceBuffer->m_nWriteCount.load(std::memory_order_acquire),
+                                           std::memory_order_release);
+    }
+}
+
+std::string PerformanceUtil::GetChromeTraceJson() const
+{
+    //名称转换为UTF8编码并转义（同一个名称只转换一次）
+    std::unordered_map<const DString::value_type*, std::string> traceNames;
+    auto GetTraceName = [&traceNames](const DString::value_type* name) -> const std::string& {
+            std::string& traceName = traceNames[name];
+            if (traceName.empty()) {
+                const std::string utf8Name = StringConvert::TToUTF8(DString(name));
+                for (char ch : utf8Name) {
+                    if ((ch == '"') || (ch == '\\')) {
+                        traceName.push_back('\\');
+                        traceName.push_back(ch);
+                    }
+                    else if ((uint8_t)ch < 0x20) {
+                        traceName.push_back(' ');
+                    }
+                    else {
+                        traceName.push_back(ch);
+                    }
+                }
+            }
+            return traceName;
+        };
+
+    std::string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool bFirst = true;
+    std::vector<TTraceEvent> events;
+    std::lock_guard<std::mutex> threadGuard(m_traceMutex);
+    for (const std::unique_ptr<TTraceBuffer>& spTraceBuffer : m_traceBuffers) {
+        //复制最近的记录：复制后再次读取计数，复制期间可能被覆盖的记录丢弃
+        const uint64_t nWriteCount = spTraceBuffer->m_nWriteCount.load(std::memory_order_acquire);
+        const uint64_t nClearCount = spTraceBuffer->m_nClearCount.load(std::memory_order_acquire);
+        uint64_t nStartCount = (nWriteCount > s_nTraceBufferSize) ? (nWriteCount - s_nTraceBufferSize) : 0;
+        nStartCount = std::max(nStartCount, std::min(nClearCount, nWriteCount));
+        events.clear();
+        for (uint64_t nIndex = nStartCount; nIndex < nWriteCount; ++nIndex) {
+            events.push_back(spTraceBuffer->m_events[(size_t)nIndex & (s_nTraceBufferSize - 1)]);
+        }
+        const uint64_t nNewWriteCount = spTraceBuffer->m_nWriteCount.load(std::memory_order_acquire);
+        const uint64_t nNewClearCount = spTraceBuffer->m_nClearCount.load(std::memory_order_acquire);
+        //所属线程正在写入的位置（nNewWriteCount）也可能已被部分覆盖，需计入：有效记录从 nNewWriteCount - s_nTraceBufferSize + 1 开始
+        uint64_t nValidStartCount = nNewClearCount;
+        if ((nNewWriteCount + 1) > s_nTraceBufferSize) {
+            nValidStartCount = std::max(nValidStartCount, nNewWriteCount + 1 - s_nTraceBufferSize);
+        }
+        size_t nSkipCount = 0;
+        if (nValidStartCount > nStartCount) {
+            nSkipCount = (size_t)std::min<uint64_t>(nValidStartCount - nStartCount, events.size());
+        }
+        for (size_t nIndex = nSkipCount; nIndex < events.size(); ++nIndex) {
+            const TTraceEvent& traceEvent = events[nIndex];
+            if (traceEvent.m_name == nullptr) {
+                continue;
+            }
+            if (!bFirst) {
+                json += ",";
+            }
+            bFirst = false;
+            json += "\n{\"name\":\"";
+            json += GetTraceName(traceEvent.m_name);
+            json += "\",\"ph\":\"X\",\"pid\":1,\"tid\":";
+            json += std::to_string(spTraceBuffer->m_nThreadIndex);
+            json += ",\"ts\":";
+            json += std::to_string(traceEvent.m_nStartUs);
+            json += ",\"dur\":";
+            json += std::to_string(traceEvent.m_nDurationUs);
+            json += "}";
+        }
+    }
+    json += "\n]}\n";
+    return json;
+}
+
+bool PerformanceUtil::SaveChromeTrace(const FilePath& filePath) const
+{
+    const std::string json = GetChromeTraceJson();
+    return FileUtil::WriteFileData(filePath, json);
+}
+
+FrameTimeHistory::FrameTimeHistory(size_t nMaxFrames):
+    m_nMaxFrames(std::max(nMaxFrames, (size_t)1)),
+    m_nNextIndex(0)
+{
+}
+
+void FrameTimeHistory::AddFrame(std::chrono::microseconds frameTime)
+{
+    const int64_t nFrameTime = std::min<int64_t>(std::max<int64_t>(frameTime.count(), 0), UINT32_MAX);
+    if (m_frameTimes.size() < m_nMaxFrames) {
+        m_frameTimes.push_back((uint32_t)nFrameTime);
+    }
+    else {
+        m_frameTimes[m_nNextIndex] = (uint32_t)nFrameTime;
+    }
+    m_nNextIndex = (m_nNextIndex + 1) % m_nMaxFrames;
+}
+
+void FrameTimeHistory::Clear()
+{
+    m_frameTimes.clear();
+    m_nNextIndex = 0;
+}
+
+size_t FrameTimeHistory::GetFrameCount() const
+{
+    return m_frameTimes.size();
+}
+
+std::chrono::microseconds FrameTimeHistory::GetAverageTime() const
+{
+    if (m_frameTimes.empty()) {
+        return std::chrono::microseconds::zero();
+    }
+    uint64_t nTotal = 0;
+    for (uint32_t nFrameTime : m_frameTimes) {
+        nTotal += nFrameTime;
+    }
+    return std::chrono::microseconds(nTotal / m_frameTimes.size());
+}
+
+std::chrono::microseconds FrameTimeHistory::GetMaxTime() const
+{
+    uint32_t nMax = 0;
+    for (uint32_t nFrameTime : m_frameTimes) {
+        nMax = std::max(nMax, nFrameTime);
+    }
+    return std::chrono::microseconds(nMax);
+}
+
+const std::vector<uint32_t>& FrameTimeHistory::GetHistogramBounds()
+{
+    //分段上限：按60帧/秒(16毫秒)、30帧/秒(33毫秒)等常用的帧间隔划分
+    static const std::vector<uint32_t> s_bounds = { 4, 8, 16, 33, 66 };
+    return s_bounds;
+}
+
+void FrameTimeHistory::GetHistogram(std::vector<uint32_t>& histogram) const
+{
+    const std::vector<uint32_t>& bounds = GetHistogramBounds();
+    histogram.assign(bounds.size() + 1, 0);
+    for (uint32_t nFrameTime : m_frameTimes) {
+        size_t nBucket = 0;
+        while ((nBucket < bounds.size()) && (nFrameTime >= bounds[nBucket] * 1000)) {
+            ++nBucket;
+        }
+        histogram[nBucket] += 1;
+    }
+}
+
 }
@@ -2,8 +2,13 @@
 #define UI_UTILS_PERFORMANCE_UTIL_H_
 
 #include "duilib/duilib_defs.h"
+#include "duilib/Utils/FilePath.h"
 #include <string>
 #include <map>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
 #include <chrono>
 #include <algorithm>
 
@@ -31,7 +36,43 @@ public:
     * @param [in] name 统计项的名称
     */
     void EndStat(const DString& name);
-    
+
+public:
+    /** 开启或者关闭跟踪记录：开启后，每次执行的起止时间记录在每个线程各自的环形缓冲区中（只保留最近的记录），可导出为Chrome跟踪文件
+    * @param [in] bEnable true表示开启，false表示关闭（关闭时不清除已有的记录）
+    */
+    void SetTraceEnabled(bool bEnable);
+
+    /** 是否开启了跟踪记录
+    */
+    bool IsTraceEnabled() const
+    {
+        return m_bTraceEnabled.load(std::memory_order_relaxed);
+    }
+
+    /** 添加一条跟踪记录（记录到当前线程的环形缓冲区中，不加锁）
+    * @param [in] name 名称，必须是常量字符串（只保存指针，不复制）
+    * @param [in] startTime 开始时间
+    * @param [in] endTime 结束时间
+    */
+    void AddTraceEvent(const DString::value_type* name,
+                       std::chrono::steady_clock::time_point startTime,
+                       std::chrono::steady_clock::time_point endTime);
+
+    /** 清除所有的跟踪记录（可在跟踪过程中调用：此前已写入的记录不再导出，正在写入的记录可能保留）
+    */
+    void ClearTraceEvents();
+
+    /** 将跟踪记录生成Chrome跟踪格式（Trace Event Format）的JSON文本，可在chrome://tracing或者Perfetto中查看
+    * @return 返回UTF8编码的JSON文本
+    */
+    std::string GetChromeTraceJson() const;
+
+    /** 将跟踪记录保存为Chrome跟踪格式的JSON文件
+    * @param [in] filePath 文件路径
+    */
+    bool SaveChromeTrace(const FilePath& filePath) const;
+
 private:
     /** 记录每项统计的结果
     */
@@ -58,13 +99,100 @@ private:
     };
 
     std::map<DString, TStat> m_stat;
+
+private:
+    /** 一条跟踪记录
+    */
+    struct TTraceEvent
+    {
+        //名称（常量字符串）
+        const DString::value_type* m_name = nullptr;
+
+        //开始时间：相对于开始跟踪的时间，微秒
+        int64_t m_nStartUs = 0;
+
+        //持续时间：微秒
+        int64_t m_nDurationUs = 0;
+    };
+
+    /** 每个线程的跟踪记录环形缓冲区（只有所属线程写入）
+    */
+    struct TTraceBuffer
+    {
+        //线程编号（按使用的顺序编号，从1开始）
+        uint32_t m_nThreadIndex = 0;
+
+        //记录的数据，容量为2的整数次方
+        std::vector<TTraceEvent> m_events;
+
+        //已写入的记录总数（写入数据后更新，只有所属线程修改，只增不减）
+        std::atomic<uint64_t> m_nWriteCount{ 0 };
+
+        //清除记录时的写入总数，导出时只导出此后写入的记录（其他线程不修改m_nWriteCount，避免与所属线程竞争）
+        std::atomic<uint64_t> m_nClearCount{ 0 };
+    };
+
+    /** 获取当前线程的环形缓冲区（首次使用时创建）
+    */
+    TTraceBuffer* GetThreadTraceBuffer();
+
+    /** 是否开启了跟踪记录
+    */
+    std::atomic<bool> m_bTraceEnabled;
+
+    /** 开始跟踪的时间
+    */
+    std::chrono::steady_clock::time_point m_traceStartTime;
+
+    /** 所有线程的环形缓冲区（只在创建缓冲区和导出时加锁）
+    */
+    std::vector<std::unique_ptr<TTraceBuffer>> m_traceBuffers;
+    mutable std::mutex m_traceMutex;
+};
+
+/** 跟踪记录：在作用域内的执行时间记录为一条跟踪记录（未开启跟踪记录时，只有一次原子变量的读取）
+*/
+class PerformanceTrace
+{
+public:
+    /** 构造函数
+    * @param [in] traceName 名称，必须是常量字符串（只保存指针，不复制），为nullptr时不记录
+    */
+    explicit PerformanceTrace(const DString::value_type* traceName):
+        m_traceName(nullptr)
+    {
+        if ((traceName != nullptr) && PerformanceUtil::Instance().IsTraceEnabled()) {
+            m_traceName = traceName;
+            m_startTime = std::chrono::steady_clock::now();
+        }
+    }
+    ~PerformanceTrace()
+    {
+        if (m_traceName != nullptr) {
+            PerformanceUtil::Instance().AddTraceEvent(m_traceName, m_startTime, std::chrono::steady_clock::now());
+        }
+    }
+    PerformanceTrace(const PerformanceTrace&) = delete;
+    PerformanceTrace& operator=(const PerformanceTrace&) = delete;
+private:
+    const DString::value_type* m_traceName;
+    std::chrono::steady_clock::time_point m_startTime;
 };
 
 class PerformanceStat
 {
 public:
     explicit PerformanceStat(const DString& statName):
-        m_statName(statName)
+        m_statName(statName),
+        m_trace(nullptr)
+    {
+        PerformanceUtil::Instance().BeginStat(m_statName);
+    }
+    /** 名称为常量字符串时，同时记录跟踪数据
+    */
+    explicit PerformanceStat(const DString::value_type* statName):
+        m_statName(statName),
+        m_trace(statName)
     {
         PerformanceUtil::Instance().BeginStat(m_statName);
     }
@@ -74,6 +202,60 @@ public:
     }
 private:
     DString m_statName;
+    PerformanceTrace m_trace;
+};
+
+/** 帧耗时的统计（保留最近若干帧的数据）
+*/
+class UILIB_API FrameTimeHistory
+{
+public:
+    /** 构造函数
+    * @param [in] nMaxFrames 最多保留的帧数
+    */
+    explicit FrameTimeHistory(size_t nMaxFrames = 240);
+
+    /** 添加一帧的耗时
+    */
+    void AddFrame(std::chrono::microseconds frameTime);
+
+    /** 清除所有数据
+    */
+    void Clear();
+
+    /** 获取保留的帧数
+    */
+    size_t GetFrameCount() const;
+
+    /** 获取平均耗时
+    */
+    std::chrono::microseconds GetAverageTime() const;
+
+    /** 获取最大耗时
+    */
+    std::chrono::microseconds GetMaxTime() const;
+
+    /** 获取分段统计的上限值（毫秒），最后一段没有上限
+    */
+    static const std::vector<uint32_t>& GetHistogramBounds();
+
+    /** 按耗时分段统计帧数
+    * @param [out] histogram 每段的帧数，个数为GetHistogramBounds()的个数加1
+    */
+    void GetHistogram(std::vector<uint32_t>& histogram) const;
+
+private:
+    /** 每帧的耗时（微秒），环形存储
+    */
+    std::vector<uint32_t> m_frameTimes;
+
+    /** 最多保留的帧数
+    */
+    size_t m_nMaxFrames;
+
+    /** 下一帧的写入位置
+    */
+    size_t m_nNextIndex;
 };
 
 }
@@ -24,6 +24,7 @@
 
 #include "Animation/AnimationPlayer.h"
 #include "Animation/AnimationManager.h"
+#include "Animation/AnimationFrameClock.h"
 
 #include "Render/IRender.h"
 #include "Render/AutoClip.h"
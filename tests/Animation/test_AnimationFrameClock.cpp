@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+#include <functional>
+
+#include "duilib/Animation/AnimationFrameClock.h"
+#include "duilib/Animation/AnimationPlayer.h"
+#include "duilib/Core/GlobalManager.h"
+
+using ui::AnimationFrameClock;
+using ui::GlobalManager;
+
+namespace {
+
+/** 每次播放时当前值都会变化的动画播放器（播放回调每帧都会触发，并且不会播放完成）
+*/
+class TestPlayer : public ui::AnimationPlayerBase
+{
+public:
+    TestPlayer()
+    {
+        SetStartValue(0);
+        SetEndValue(1000000);
+        SetTotalMillSeconds(1000);
+        SetCallback([this](int64_t /*nValue*/) {
+                ++m_nPlayCount;
+                if (m_onPlay) {
+                    m_onPlay();
+                }
+            });
+    }
+
+    virtual int64_t GetCurrentValue() const override
+    {
+        return ++m_nValue;
+    }
+
+    //播放回调次数（启动时播放一次）
+    int32_t m_nPlayCount = 0;
+
+    //播放回调中执行的操作
+    std::function<void()> m_onPlay;
+
+private:
+    mutable int64_t m_nValue = 0;
+};
+
+/** 获取全局的帧时钟：加大帧间隔，使定时器在测试过程中不会触发（测试中直接调用OnFrame驱动动画）
+*/
+AnimationFrameClock& GetTestFrameClock()
+{
+    AnimationFrameClock& clock = GlobalManager::Instance().FrameClock();
+    clock.Clear();
+    clock.SetFrameInterval(60 * 1000);
+    return clock;
+}
+
+} // namespace
+
+TEST(AnimationFrameClockTest, StopsClockWhenLastPlayerRemoved)
+{
+    AnimationFrameClock& clock = GetTestFrameClock();
+    EXPECT_FALSE(clock.IsRunning());
+
+    TestPlayer player1;
+    TestPlayer player2;
+    player1.Start();
+    EXPECT_TRUE(clock.IsRunning());
+    player2.Start();
+    EXPECT_EQ(clock.GetPlayerCount(), 2u);
+
+    player1.Stop();
+    EXPECT_TRUE(clock.IsRunning());
+    EXPECT_EQ(clock.GetPlayerCount(), 1u);
+
+    //最后一个动画停止后，关闭定时器
+    player2.Stop();
+    EXPECT_FALSE(clock.IsRunning());
+    EXPECT_EQ(clock.GetPlayerCount(), 0u);
+
+    //重复移除不影响状态
+    player2.Stop();
+    EXPECT_FALSE(clock.IsRunning());
+
+    //播放器销毁时也从帧时钟中移除
+    {
+        TestPlayer player3;
+        player3.Start();
+        EXPECT_TRUE(clock.IsRunning());
+    }
+    EXPECT_FALSE(clock.IsRunning());
+    EXPECT_EQ(clock.GetPlayerCount(), 0u);
+}
+
+TEST(AnimationFrameClockTest, AddAndRemovePlayersDuringFrame)
+{
+    AnimationFrameClock& clock = GetTestFrameClock();
+
+    TestPlayer player1;
+    TestPlayer player2;
+    TestPlayer player3;
+    TestPlayer player4;
+    player1.Start();
+    player2.Start();
+    player3.Start();
+    EXPECT_EQ(player1.m_nPlayCount, 1);
+    EXPECT_EQ(clock.GetPlayerCount(), 3u);
+
+    //第一个动画在帧回调中停止后面的动画，并启动新的动画
+    player1.m_onPlay = [&player2, &player4]() {
+            player2.Stop();
+            player4.Start();
+        };
+    clock.OnFrame();
+    EXPECT_EQ(player1.m_nPlayCount, 2);
+    EXPECT_EQ(player2.m_nPlayCount, 1);  //已移除，本帧不再驱动
+    EXPECT_EQ(player3.m_nPlayCount, 2);
+    EXPECT_EQ(player4.m_nPlayCount, 1);  //启动时播放一次，本帧不再驱动
+    EXPECT_EQ(clock.GetPlayerCount(), 3u);
+    EXPECT_TRUE(clock.IsRunning());
+
+    //下一帧驱动新添加的动画
+    player1.m_onPlay = nullptr;
+    clock.OnFrame();
+    EXPECT_EQ(player1.m_nPlayCount, 3);
+    EXPECT_EQ(player2.m_nPlayCount, 1);
+    EXPECT_EQ(player3.m_nPlayCount, 3);
+    EXPECT_EQ(player4.m_nPlayCount, 2);
+
+    //在帧回调中停止所有动画（包括自身），帧结束后关闭定时器
+    player3.m_onPlay = [&player1, &player3, &player4]() {
+            player1.Stop();
+            player3.Stop();
+            player4.Stop();
+        };
+    clock.OnFrame();
+    EXPECT_EQ(player1.m_nPlayCount, 4);
+    EXPECT_EQ(player3.m_nPlayCount, 4);
+    EXPECT_EQ(player4.m_nPlayCount, 2);
+    EXPECT_EQ(clock.GetPlayerCount(), 0u);
+    EXPECT_FALSE(clock.IsRunning());
+
+    //停止后再启动，重新开启定时器
+    player3.m_onPlay = nullptr;
+    player2.Start();
+    EXPECT_TRUE(clock.IsRunning());
+    EXPECT_EQ(clock.GetPlayerCount(), 1u);
+    clock.Clear();
+    EXPECT_FALSE(clock.IsRunning());
+    EXPECT_EQ(clock.GetPlayerCount(), 0u);
+}
@@ -0,0 +1,97 @@
+// 按坐标查找控件的性能测试：模拟含有大量浮动控件的容器，比较遍历所有子控件与使用空间索引（HitTestGrid）的耗时
+// 用法：hit_test_grid_benchmark [查找次数]
+//       查找次数默认为 100000，子控件数量依次为 100、1000、10000、100000
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "duilib/Core/HitTestGrid.h"
+
+using ui::HitTestGrid;
+using ui::UiPoint;
+using ui::UiRect;
+
+namespace {
+
+uint32_t NextRandom(uint32_t& nSeed)
+{
+    nSeed = nSeed * 1103515245u + 12345u;
+    return nSeed >> 8;
+}
+
+double ElapsedMs(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    const int nQueryCount = (argc > 1) ? std::max(1, std::atoi(argv[1])) : 100000;
+    const int32_t nWidth = 3840;
+    const int32_t nHeight = 2160;
+
+    std::printf("Queries: %d, area: %dx%d\n\n", nQueryCount, nWidth, nHeight);
+    std::printf("%10s %14s %16s %16s %10s\n", "Controls", "Build(ms)", "Tree walk(us)", "Grid index(us)", "Speedup");
+    for (size_t nControlCount : { (size_t)100, (size_t)1000, (size_t)10000, (size_t)100000 }) {
+        //浮动控件：随机位置，大小在16到96像素之间；第一个子控件为覆盖整个区域的背景
+        uint32_t nSeed = 1;
+        std::vector<UiRect> itemRects;
+        itemRects.push_back(UiRect(0, 0, nWidth, nHeight));
+        for (size_t i = 1; i < nControlCount; ++i) {
+            const int32_t x = (int32_t)(NextRandom(nSeed) % nWidth);
+            const int32_t y = (int32_t)(NextRandom(nSeed) % nHeight);
+            const int32_t w = 16 + (int32_t)(NextRandom(nSeed) % 80);
+            const int32_t h = 16 + (int32_t)(NextRandom(nSeed) % 80);
+            itemRects.push_back(UiRect(x, y, x + w, y + h));
+        }
+        std::vector<UiPoint> points;
+        for (int i = 0; i < nQueryCount; ++i) {
+            points.push_back(UiPoint((int32_t)(NextRandom(nSeed) % nWidth), (int32_t)(NextRandom(nSeed) % nHeight)));
+        }
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        HitTestGrid grid;
+        grid.Build(itemRects);
+        const double fBuildMs = ElapsedMs(start);
+
+        //与Box::FindControlInItems相同：倒序查找，返回第一个矩形区域包含该坐标的子控件
+        size_t nWalkChecksum = 0;
+        start = std::chrono::steady_clock::now();
+        for (const UiPoint& pt : points) {
+            for (size_t n = itemRects.size(); n > 0; --n) {
+                if (itemRects[n - 1].ContainsPt(pt)) {
+                    nWalkChecksum += n - 1;
+                    break;
+                }
+            }
+        }
+        const double fWalkMs = ElapsedMs(start);
+
+        size_t nGridChecksum = 0;
+        std::vector<size_t> itemIndexs;
+        start = std::chrono::steady_clock::now();
+        for (const UiPoint& pt : points) {
+            grid.Query(pt, itemIndexs);
+            if (!itemIndexs.empty()) {
+                nGridChecksum += itemIndexs.back();
+            }
+        }
+        const double fGridMs = ElapsedMs(start);
+
+        if (nWalkChecksum != nGridChecksum) {
+            std::printf("Checksum mismatch for %zu controls!\n", nControlCount);
+            return 2;
+        }
+        std::printf("%10zu %14.3f %16.3f %16.3f %9.1fx\n", nControlCount, fBuildMs,
+                    fWalkMs * 1000.0 / nQueryCount, fGridMs * 1000.0 / nQueryCount,
+                    (fGridMs > 0) ? (fWalkMs / fGridMs) : 0.0);
+    }
+    std::printf("\nNote: the tree walk column only covers the rectangle tests of one container level;\n"
+                "the real FindControl also calls a virtual function per child.\n");
+    return 0;
+}
@@ -0,0 +1,126 @@
+// 列表文本过滤的性能测试：模拟日志查看器，在一列数据中逐字输入查找文本，统计每次过滤的耗时
+// 用法：list_ctrl_filter_benchmark [行数] [轮数]
+//       行数默认为 1000000，轮数默认为 5（每次过滤取各轮中的最小耗时，排除系统调度的干扰）
+//       最大耗时超过一帧（16 ms）时返回非0值
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "duilib/Control/ListCtrlColumnData.h"
+#include "duilib/Utils/StringConvert.h"
+
+using ui::ListCtrlColumnData;
+
+namespace {
+
+/** 每次过滤的耗时上限（60Hz刷新率下的一帧），超过时输入会有明显的卡顿
+*/
+const double kFrameBudgetMs = 16.0;
+
+const DString::value_type* const kWords[] = {
+    _T("Connection"), _T("timeout"), _T("user"), _T("login"), _T("ERROR"), _T("Warning"), _T("disk"),
+    _T("request"), _T("finished"), _T("started"), _T("cache"), _T("miss"), _T("render"), _T("frame"),
+    _T("window"), _T("socket"), _T("closed"), _T("retry"), _T("payload"), _T("invalid")
+};
+
+DString MakeLogLine(uint32_t& nSeed, size_t nLine)
+{
+    DString text = _T("[") + ui::StringUtil::UInt64ToString(nLine) + _T("] ");
+    for (size_t n = 0; n < 5; ++n) {
+        nSeed = nSeed * 1103515245u + 12345u;
+        text += kWords[(nSeed >> 16) % (sizeof(kWords) / sizeof(kWords[0]))];
+        text += _T(' ');
+    }
+    return text;
+}
+
+double ElapsedMs(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    const size_t nCount = (argc > 1) ? (size_t)std::max(1, std::atoi(argv[1])) : 1000000;
+    const size_t nRoundCount = (argc > 2) ? (size_t)std::max(1, std::atoi(argv[2])) : 5;
+
+    ListCtrlColumnData columnData;
+    columnData.Resize(nCount);
+    uint32_t nSeed = 1;
+    for (size_t i = 0; i < nCount; ++i) {
+        const DString text = MakeLogLine(nSeed, i);
+        columnData.SetText(i, text.c_str(), text.size());
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    columnData.SetTextIndexEnabled(true);
+    std::printf("Rows: %zu, build index: %.1f ms, rounds: %zu\n\n", nCount, ElapsedMs(start), nRoundCount);
+
+    std::vector<size_t> itemIndexs;
+    //逐字输入，然后删除重新输入（不能使用上次的结果）
+    const DString typed = _T("timeout retry");
+    std::vector<DString> filters;
+    for (size_t n = 1; n <= typed.size(); ++n) {
+        filters.push_back(typed.substr(0, n));
+    }
+    filters.push_back(_T("socket"));
+    filters.push_back(_T("Cache miss"));
+    filters.push_back(_T("[99999"));
+    filters.push_back(_T("e"));
+    std::vector<double> firstMs(filters.size(), 0);
+    std::vector<double> bestMs(filters.size(), 0);
+    std::vector<size_t> matchCounts(filters.size(), 0);
+    for (size_t nRound = 0; nRound < nRoundCount; ++nRound) {
+        for (size_t i = 0; i < filters.size(); ++i) {
+            start = std::chrono::steady_clock::now();
+            columnData.FindText(filters[i], false, itemIndexs);
+            const double fMs = ElapsedMs(start);
+            if (nRound == 0) {
+                firstMs[i] = fMs;
+                bestMs[i] = fMs;
+                matchCounts[i] = itemIndexs.size();
+            }
+            else {
+                bestMs[i] = std::min(bestMs[i], fMs);
+            }
+        }
+    }
+
+    std::printf("%-24s %12s %14s %14s\n", "Filter text", "Matches", "First(ms)", "Best(ms)");
+    double fMaxMs = 0;
+    for (size_t i = 0; i < filters.size(); ++i) {
+        fMaxMs = std::max(fMaxMs, bestMs[i]);
+        std::printf("%-24s %12zu %14.2f %14.2f\n", ui::StringConvert::TToUTF8(filters[i]).c_str(),
+                    matchCounts[i], firstMs[i], bestMs[i]);
+    }
+
+    //过滤期间修改数据（增量更新索引），每轮修改后查找一次
+    double fUpdateMs = 0;
+    double fAfterUpdateMs = 0;
+    for (size_t nRound = 0; nRound < nRoundCount; ++nRound) {
+        start = std::chrono::steady_clock::now();
+        for (size_t i = nRound; i < nCount; i += 100) {
+            const DString text = MakeLogLine(nSeed, i);
+            columnData.SetText(i, text.c_str(), text.size());
+        }
+        const double fMs = ElapsedMs(start);
+        fUpdateMs = (nRound == 0) ? fMs : std::min(fUpdateMs, fMs);
+
+        start = std::chrono::steady_clock::now();
+        columnData.FindText(_T("socket"), false, itemIndexs);
+        const double fFindMs = ElapsedMs(start);
+        fAfterUpdateMs = (nRound == 0) ? fFindMs : std::min(fAfterUpdateMs, fFindMs);
+    }
+    fMaxMs = std::max(fMaxMs, fAfterUpdateMs);
+    std::printf("\nUpdate %zu rows: %.1f ms\n", nCount / 100, fUpdateMs);
+    std::printf("Filter after update: %zu matches, %.2f ms\n", itemIndexs.size(), fAfterUpdateMs);
+    const bool bPass = fMaxMs < kFrameBudgetMs;
+    std::printf("Worst case: %.2f ms (limit %.0f ms): %s\n", fMaxMs, kFrameBudgetMs, bPass ? "PASS" : "FAIL");
+    return bPass ? 0 : 1;
+}
@@ -0,0 +1,170 @@
+// 菜单弹出的性能测试：反复创建并显示菜单（Menu::ShowMenu，包括创建窗口、解析或实例化窗口模板、创建控件、布局和首次绘制），
+//       比较每次解析菜单XML文件与使用窗口模板缓存的耗时
+// 依赖完整的duilib库及其依赖的Skia、SDL库（DUILIB_BUILD_UI_TESTS和DUILIB_BUILD_BENCHMARKS均为ON时编译），需要在有图形桌面的环境中运行
+// 用法：menu_open_benchmark [资源目录] [菜单资源文件夹] [菜单XML文件] [弹出次数]
+//       资源目录默认为 bin/resources，菜单资源文件夹默认为 controls/，菜单XML文件默认为 menu/settings_menu.xml，
+//       弹出次数默认为 200（两种方式交替弹出，每种方式另外先弹出5次预热，不计入结果）
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "duilib/duilib.h"
+
+namespace {
+
+/** 预热的弹出次数（首次弹出需要加载字体、图片，以及编译窗口模板）
+*/
+const int kWarmupCount = 5;
+
+/** 不使用窗口模板缓存的菜单（每次弹出都读取并解析XML文件，即原有的方式）
+*/
+class UncachedMenu : public ui::Menu
+{
+public:
+    using ui::Menu::Menu;
+
+    virtual bool IsSkinFileCacheEnabled() const override
+    {
+        return false;
+    }
+};
+
+double ElapsedMs(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+double GetMedian(std::vector<double> values)
+{
+    if (values.empty()) {
+        return 0;
+    }
+    std::sort(values.begin(), values.end());
+    return values[values.size() / 2];
+}
+
+double GetAverage(const std::vector<double>& values)
+{
+    double fTotal = 0;
+    for (double fValue : values) {
+        fTotal += fValue;
+    }
+    return values.empty() ? 0 : (fTotal / values.size());
+}
+
+/** 运行测试的主线程：在消息循环中逐次弹出并关闭菜单（每次弹出在单独的任务中执行，使菜单窗口关闭的消息得到处理）
+*/
+class MenuOpenThread : public ui::FrameworkThread
+{
+public:
+    MenuOpenThread(const ui::FilePath& resourcePath, const DString& skinFolder, const DString& menuXml, int nOpenCount):
+        FrameworkThread(_T("MenuOpenBenchmark"), ui::kThreadUI),
+        m_resourcePath(resourcePath),
+        m_skinFolder(skinFolder),
+        m_menuXml(menuXml),
+        m_nOpenCount(nOpenCount)
+    {
+    }
+
+    int GetExitCode() const
+    {
+        return m_nExitCode;
+    }
+
+private:
+    virtual void OnInit() override
+    {
+        if (!ui::GlobalManager::Instance().Startup(ui::LocalFilesResParam(m_resourcePath))) {
+            std::printf("GlobalManager::Startup failed, resource dir: %s\n", m_resourcePath.ToStringA().c_str());
+            m_nExitCode = 1;
+            ui::WindowBase::PostQuitMsg(0);
+            return;
+        }
+        PostNextOpen();
+    }
+
+    virtual void OnCleanup() override
+    {
+        ui::GlobalManager::Instance().Shutdown();
+    }
+
+    void PostNextOpen()
+    {
+        ui::GlobalManager::Instance().Thread().PostTask(ui::kThreadUI, [this]() { OpenMenu(); });
+    }
+
+    /** 弹出一次菜单并记录耗时，然后关闭菜单；两种方式交替进行，减少系统状态变化的影响
+    */
+    void OpenMenu()
+    {
+        const int nRound = m_nStep / 2;
+        const bool bCached = (m_nStep % 2) == 1;
+        ui::Menu* pMenu = bCached ? new ui::Menu(nullptr) : new UncachedMenu(nullptr);
+        pMenu->SetSkinFolder(m_skinFolder);
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        pMenu->ShowMenu(m_menuXml, ui::UiPoint(100, 100), ui::MenuPopupPosType::LEFT_TOP, true);
+        const double fOpenMs = ElapsedMs(start);
+        const size_t nItemCount = pMenu->GetMenuItemCount();
+        pMenu->CloseMenu();
+        if (nItemCount == 0) {
+            std::printf("Failed to open menu: %s\n", ui::StringConvert::TToUTF8(m_menuXml).c_str());
+            m_nExitCode = 2;
+            ui::WindowBase::PostQuitMsg(0);
+            return;
+        }
+        if (nRound >= kWarmupCount) {
+            (bCached ? m_cachedOpenMs : m_uncachedOpenMs).push_back(fOpenMs);
+        }
+        else if ((nRound == 0) && bCached) {
+            m_fFirstCachedOpenMs = fOpenMs;
+        }
+
+        ++m_nStep;
+        if (m_nStep < (kWarmupCount + m_nOpenCount) * 2) {
+            PostNextOpen();
+            return;
+        }
+        const double fUncachedMs = GetMedian(m_uncachedOpenMs);
+        const double fCachedMs = GetMedian(m_cachedOpenMs);
+        std::printf("Menu: %s%s, opens per mode: %d\n", ui::StringConvert::TToUTF8(m_skinFolder).c_str(),
+                    ui::StringConvert::TToUTF8(m_menuXml).c_str(), m_nOpenCount);
+        std::printf("First open with template cache (includes template compile): %.3f ms\n\n", m_fFirstCachedOpenMs);
+        std::printf("%-24s %14s %14s\n", "Mode", "Median(ms)", "Average(ms)");
+        std::printf("%-24s %14.3f %14.3f\n", "XML parse per open", fUncachedMs, GetAverage(m_uncachedOpenMs));
+        std::printf("%-24s %14.3f %14.3f\n", "Window template cache", fCachedMs, GetAverage(m_cachedOpenMs));
+        std::printf("\nEach open is Menu::ShowMenu: native window creation, control creation, layout and the first paint.\n");
+        ui::WindowBase::PostQuitMsg(0);
+    }
+
+private:
+    ui::FilePath m_resourcePath;
+    DString m_skinFolder;
+    DString m_menuXml;
+    int m_nOpenCount;
+    int m_nStep = 0;
+    int m_nExitCode = 0;
+    double m_fFirstCachedOpenMs = 0;
+    std::vector<double> m_uncachedOpenMs;
+    std::vector<double> m_cachedOpenMs;
+};
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    const std::string resourceDir = (argc > 1) ? std::string(argv[1]) : std::string(DUILIB_BENCHMARK_RESOURCE_DIR);
+    const std::string skinFolder = (argc > 2) ? std::string(argv[2]) : std::string("controls/");
+    const std::string menuXml = (argc > 3) ? std::string(argv[3]) : std::string("menu/settings_menu.xml");
+    const int nOpenCount = (argc > 4) ? std::max(1, std::atoi(argv[4])) : 200;
+
+    ui::FilePath resourcePath(ui::StringConvert::UTF8ToT(resourceDir));
+    resourcePath.NormalizeDirectoryPath();
+    MenuOpenThread thread(resourcePath, ui::StringConvert::UTF8ToT(skinFolder),
+                          ui::StringConvert::UTF8ToT(menuXml), nOpenCount);
+    thread.RunMessageLoop();
+    return thread.GetExitCode();
+}
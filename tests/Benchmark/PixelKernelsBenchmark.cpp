@@ -0,0 +1,156 @@
+// 像素处理函数的性能测试：比较原有的逐字节实现与各指令集实现的耗时
+// 测试内容：颜色字节顺序转换（BGRA -> RGBA）、按透明度缩放颜色值、恢复Alpha值
+// 图片大小：4K分辨率（3840x2160，数据量远大于CPU缓存，主要受内存带宽限制）和 512x512（局部刷新，数据在CPU缓存中）
+// 每次执行前恢复为相同的随机像素数据（不计入耗时），避免多次缩放后像素值趋于0、或Alpha值全部相同使分支预测失真
+// 用法：pixel_kernels_benchmark [重复次数]
+//       重复次数默认为 20
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "duilib/Render/PixelKernels.h"
+
+using ui::PixelKernels;
+
+namespace {
+
+
+double ElapsedMs(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+/** 原有实现：SkRasterWindowContext_SDL::UpdateColorByteOrder（交换R和B）
+*/
+void ByteLoopSwizzle(uint32_t* pPixels, size_t nCount)
+{
+    const int32_t backR = 2, backG = 1, backB = 0, backA = 3;
+    const int32_t sdlR = 0, sdlG = 1, sdlB = 2, sdlA = 3;
+    uint32_t colorValue = 0;
+    for (size_t i = 0; i < nCount; ++i) {
+        uint32_t* pColorValue = pPixels + i;
+        colorValue = *pColorValue;
+        ((uint8_t*)pColorValue)[sdlR] = ((uint8_t*)&colorValue)[backR];
+        ((uint8_t*)pColorValue)[sdlG] = ((uint8_t*)&colorValue)[backG];
+        ((uint8_t*)pColorValue)[sdlB] = ((uint8_t*)&colorValue)[backB];
+        ((uint8_t*)pColorValue)[sdlA] = ((uint8_t*)&colorValue)[backA];
+    }
+}
+
+/** 原有实现：SkRasterWindowContext_SDL::UpdateColorAlpha
+*/
+void ByteLoopScale(uint32_t* pPixels, size_t nCount, uint8_t nAlpha)
+{
+    for (size_t i = 0; i < nCount; ++i) {
+        uint8_t* p = (uint8_t*)(pPixels + i);
+        p[0] = p[0] * nAlpha / 255;
+        p[1] = p[1] * nAlpha / 255;
+        p[2] = p[2] * nAlpha / 255;
+        p[3] = p[3] * nAlpha / 255;
+    }
+}
+
+/** 原有实现：BitmapAlpha::RestoreAlpha
+*/
+void ByteLoopRestoreAlpha(uint32_t* pPixels, size_t nCount, uint8_t alpha)
+{
+    for (size_t i = 0; i < nCount; ++i) {
+        uint8_t* a = (uint8_t*)(pPixels + i) + 3;
+        if (alpha != 0 && *a == alpha) {
+            *a = 0;
+        }
+        else if (*a == 0) {
+            *a = 255;
+        }
+    }
+}
+
+volatile uint32_t g_nSink = 0;
+
+/** 每次执行前从source恢复像素数据（不计入耗时），返回多次执行中的最短耗时（减少其他进程干扰的影响）
+*/
+template<typename Function>
+double Measure(const std::vector<uint32_t>& source, std::vector<uint32_t>& pixels, int nRepeat, Function function)
+{
+    //先执行一次，排除首次访问内存的影响
+    pixels = source;
+    function(pixels.data(), pixels.size());
+    double fMinMs = 0;
+    for (int i = 0; i < nRepeat; ++i) {
+        std::copy(source.begin(), source.end(), pixels.begin());
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        function(pixels.data(), pixels.size());
+        const double fElapsedMs = ElapsedMs(start);
+        fMinMs = (i == 0) ? fElapsedMs : std::min(fMinMs, fElapsedMs);
+    }
+    g_nSink = g_nSink + pixels[pixels.size() / 2];
+    return fMinMs;
+}
+
+/** 随机像素数据：Alpha值在0、1、255和随机值之间变化（恢复Alpha值时各分支都会执行）
+*/
+std::vector<uint32_t> MakeSourcePixels(int32_t nWidth, int32_t nHeight)
+{
+    std::vector<uint32_t> source((size_t)nWidth * nHeight);
+    uint32_t nSeed = 1;
+    for (uint32_t& pixel : source) {
+        nSeed = nSeed * 1103515245u + 12345u;
+        pixel = nSeed;
+        const uint32_t nAlphaKind = (nSeed >> 13) & 3;
+        if (nAlphaKind < 3) {
+            const uint32_t alphaValues[3] = { 0, 1, 255 };
+            pixel = (pixel & 0x00FFFFFF) | (alphaValues[nAlphaKind] << 24);
+        }
+    }
+    return source;
+}
+
+void RunBenchmark(int32_t nWidth, int32_t nHeight, int nRepeat)
+{
+    const std::vector<uint32_t> source = MakeSourcePixels(nWidth, nHeight);
+    std::vector<uint32_t> pixels;
+    const uint8_t channelOrder[4] = { 2, 1, 0, 3 };
+    const uint8_t nAlpha = 200;
+
+    std::printf("Image: %dx%d, repeat: %d, default: %s\n\n", nWidth, nHeight, nRepeat,
+                PixelKernels::GetInstructionSetName(PixelKernels::GetInstructionSet()));
+    std::printf("%-12s %14s %14s %14s\n", "Method", "Swizzle(ms)", "Scale(ms)", "Restore(ms)");
+
+    const double fByteSwizzle = Measure(source, pixels, nRepeat, [](uint32_t* p, size_t n) { ByteLoopSwizzle(p, n); });
+    const double fByteScale = Measure(source, pixels, nRepeat, [&](uint32_t* p, size_t n) { ByteLoopScale(p, n, nAlpha); });
+    const double fByteRestore = Measure(source, pixels, nRepeat, [](uint32_t* p, size_t n) { ByteLoopRestoreAlpha(p, n, 1); });
+    std::printf("%-12s %14.3f %14.3f %14.3f\n", "Byte loop", fByteSwizzle, fByteScale, fByteRestore);
+
+    const PixelKernels::InstructionSet defaultInstructionSet = PixelKernels::GetInstructionSet();
+    for (PixelKernels::InstructionSet instructionSet : { PixelKernels::InstructionSet::kScalar,
+                                                         PixelKernels::InstructionSet::kSSE2,
+                                                         PixelKernels::InstructionSet::kAVX2,
+                                                         PixelKernels::InstructionSet::kNEON }) {
+        if (!PixelKernels::SetInstructionSet(instructionSet)) {
+            continue;
+        }
+        const double fSwizzle = Measure(source, pixels, nRepeat, [&](uint32_t* p, size_t n) { PixelKernels::SwizzleChannels(p, n, channelOrder); });
+        const double fScale = Measure(source, pixels, nRepeat, [&](uint32_t* p, size_t n) { PixelKernels::ScaleChannels(p, n, nAlpha); });
+        const double fRestore = Measure(source, pixels, nRepeat, [](uint32_t* p, size_t n) { PixelKernels::RestoreAlpha(p, n, 1); });
+        std::printf("%-12s %14.3f %14.3f %14.3f   (speedup %.1fx / %.1fx / %.1fx)\n",
+                    PixelKernels::GetInstructionSetName(instructionSet), fSwizzle, fScale, fRestore,
+                    fByteSwizzle / std::max(fSwizzle, 0.001), fByteScale / std::max(fScale, 0.001),
+                    fByteRestore / std::max(fRestore, 0.001));
+    }
+    PixelKernels::SetInstructionSet(defaultInstructionSet);
+    std::printf("\n");
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    const int nRepeat = (argc > 1) ? std::max(1, std::atoi(argv[1])) : 20;
+    RunBenchmark(3840, 2160, nRepeat);
+    //局部刷新的数据量较小，增加重复次数
+    RunBenchmark(512, 512, nRepeat * 20);
+    return 0;
+}
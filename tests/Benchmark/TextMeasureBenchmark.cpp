@@ -0,0 +1,160 @@
+// 文本度量的性能测试：模拟中英文混排的界面文本，比较逐个字符度量、整段批量度量、使用度量缓存的耗时
+// 度量函数用固定的调用开销加上每个字符的开销模拟字体引擎（字形查找、字形度量），不依赖Skia
+// 用法：text_measure_benchmark [绘制帧数] [文本个数]
+//       绘制帧数默认为 200，文本个数默认为 300（每帧度量所有文本一次）
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "duilib/Render/TextMeasureCache.h"
+
+using ui::TextGlyphMetrics;
+using ui::TextMeasureCache;
+using ui::TextMeasureResult;
+
+namespace {
+
+uint32_t NextRandom(uint32_t& nSeed)
+{
+    nSeed = nSeed * 1103515245u + 12345u;
+    return nSeed >> 8;
+}
+
+double ElapsedMs(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+volatile uint32_t g_nSink = 0;
+
+/** 模拟的字体引擎开销：每次调用的固定开销（查找字形缓存、加锁）和每个字符的开销
+*/
+uint32_t SimulateWork(uint32_t nValue, int nRounds)
+{
+    for (int i = 0; i < nRounds; ++i) {
+        nValue = nValue * 2654435761u + 0x9E3779B9u;
+        nValue ^= nValue >> 15;
+    }
+    return nValue;
+}
+
+void SimulatedMeasure(const uint32_t* codePoints, size_t nCount, TextGlyphMetrics* metrics)
+{
+    uint32_t nValue = SimulateWork((uint32_t)nCount, 200);
+    for (size_t i = 0; i < nCount; ++i) {
+        nValue = SimulateWork(nValue ^ codePoints[i], 40);
+        metrics[i].nGlyphId = (uint16_t)(codePoints[i] & 0xFFFF);
+        metrics[i].fAdvance = (codePoints[i] >= 0x2E80) ? 16.0f : 8.0f;
+        metrics[i].fTop = -12.0f;
+        metrics[i].fRight = metrics[i].fAdvance;
+        metrics[i].fBottom = 3.0f;
+    }
+    g_nSink = g_nSink + nValue;
+}
+
+/** 生成中英文混排的文本（含少量代理对字符）
+*/
+std::vector<UTF16String> MakeTexts(size_t nTextCount)
+{
+    std::vector<UTF16String> texts;
+    uint32_t nSeed = 1;
+    for (size_t i = 0; i < nTextCount; ++i) {
+        UTF16String text;
+        const size_t nLength = 8 + NextRandom(nSeed) % 40;
+        while (text.size() < nLength) {
+            const uint32_t nKind = NextRandom(nSeed) % 100;
+            if (nKind < 45) {
+                text.push_back((char16_t)(0x4E00 + NextRandom(nSeed) % 3000));     //常用汉字
+            }
+            else if (nKind < 90) {
+                text.push_back((char16_t)('a' + NextRandom(nSeed) % 26));
+            }
+            else if (nKind < 97) {
+                text.push_back(u' ');
+            }
+            else {
+                text.push_back((char16_t)0xD83D);                                   //表情符号
+                text.push_back((char16_t)(0xDE00 + NextRandom(nSeed) % 64));
+            }
+        }
+        texts.push_back(text);
+    }
+    return texts;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    const int nFrameCount = (argc > 1) ? std::max(1, std::atoi(argv[1])) : 200;
+    const size_t nTextCount = (argc > 2) ? (size_t)std::max(1, std::atoi(argv[2])) : 300;
+    const std::vector<UTF16String> texts = MakeTexts(nTextCount);
+    size_t nUnitCount = 0;
+    for (const UTF16String& text : texts) {
+        nUnitCount += text.size();
+    }
+    std::printf("Frames: %d, texts: %zu, UTF-16 units per frame: %zu\n\n", nFrameCount, nTextCount, nUnitCount);
+
+    //1. 逐个UTF-16字符度量（原有方式）
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int nFrame = 0; nFrame < nFrameCount; ++nFrame) {
+        for (const UTF16String& text : texts) {
+            for (char16_t ch : text) {
+                const uint32_t codePoint = (uint16_t)ch;
+                TextGlyphMetrics metrics;
+                SimulatedMeasure(&codePoint, 1, &metrics);
+            }
+        }
+    }
+    const double fPerCharMs = ElapsedMs(start);
+
+    //2. 整段文本批量度量（不使用缓存）
+    start = std::chrono::steady_clock::now();
+    for (int nFrame = 0; nFrame < nFrameCount; ++nFrame) {
+        for (const UTF16String& text : texts) {
+            TextMeasureCache::MeasureTextUncached(text, SimulatedMeasure);
+        }
+    }
+    const double fBatchMs = ElapsedMs(start);
+
+    //3. 使用度量缓存（字符缓存 + 字符串LRU缓存）
+    TextMeasureCache cache;
+    start = std::chrono::steady_clock::now();
+    for (int nFrame = 0; nFrame < nFrameCount; ++nFrame) {
+        for (const UTF16String& text : texts) {
+            cache.MeasureText(text, SimulatedMeasure);
+        }
+    }
+    const double fCachedMs = ElapsedMs(start);
+
+    //4. 字符串缓存容量不足时（每次都未命中字符串缓存，只使用字符缓存）
+    TextMeasureCache glyphOnlyCache(0);
+    start = std::chrono::steady_clock::now();
+    for (int nFrame = 0; nFrame < nFrameCount; ++nFrame) {
+        for (const UTF16String& text : texts) {
+            glyphOnlyCache.MeasureText(text, SimulatedMeasure);
+        }
+    }
+    const double fGlyphOnlyMs = ElapsedMs(start);
+
+    const double fUnits = (double)nUnitCount * nFrameCount;
+    std::printf("%-28s %12s %16s %10s\n", "Method", "Total(ms)", "Units/sec", "Speedup");
+    auto printRow = [&](const char* name, double fMs) {
+            std::printf("%-28s %12.2f %16.0f %9.1fx\n", name, fMs, fUnits * 1000.0 / std::max(fMs, 0.001),
+                        fPerCharMs / std::max(fMs, 0.001));
+        };
+    printRow("Per UTF-16 unit", fPerCharMs);
+    printRow("Batched run (uncached)", fBatchMs);
+    printRow("Glyph cache only", fGlyphOnlyMs);
+    printRow("Glyph + string LRU cache", fCachedMs);
+
+    const TextMeasureCache::Stats stats = cache.GetStats();
+    std::printf("\nCache: %zu glyphs, %zu strings, %llu hits, %llu misses, %llu measure calls, %llu glyphs measured\n",
+                stats.nGlyphCount, stats.nStringCount,
+                (unsigned long long)stats.nStringHits, (unsigned long long)stats.nStringMisses,
+                (unsigned long long)stats.nMeasureCalls, (unsigned long long)stats.nMeasuredGlyphs);
+    return 0;
+}
@@ -0,0 +1,372 @@
+// 定时器管理的性能测试：比较原有的优先队列加取消集合（std::priority_queue + std::set）、
+//       时间轮加哈希表（TimerWheel + std::unordered_map）、时间轮加按下标访问的数组（TimerManager的实现）的耗时
+// 用法：timer_wheel_benchmark [循环次数]
+//       循环次数默认为 100000：每次循环添加一个定时器再取消（模拟提示、延迟悬停等短时定时器），
+//       另外测试同样数量的定时器全部触发、以及重复定时器连续触发的耗时（触发时与TimerManager::Poll一样查找定时器数据并调用回调）
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+#include "duilib/Core/TimerWheel.h"
+
+using ui::TimerWheel;
+
+namespace {
+
+uint32_t NextRandom(uint32_t& nSeed)
+{
+    nSeed = nSeed * 1103515245u + 12345u;
+    return nSeed >> 8;
+}
+
+double ElapsedMs(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+/** 与TimerManager中的定时器数据（TimerInfo）大小相当的数据
+*/
+struct TimerPayload
+{
+    std::function<void(uint64_t)> timerCallback;
+    std::weak_ptr<int> weakFlag;
+    uint32_t uElapseMs = 0;
+    uint32_t uRepeatTime = 0;
+    uint64_t nDueTick = 0;
+};
+
+/** 原有的实现：按触发时间排序的优先队列，取消的定时器ID记录在集合中，到达队列顶时再删除
+*/
+class PriorityQueueTimers
+{
+public:
+    size_t AddTimer(uint64_t nDueTick, uint32_t uRepeatTime, const TimerPayload& payload)
+    {
+        TimerItem item;
+        item.nTimerId = m_nNextTimerId++;
+        item.payload = payload;
+        item.payload.uRepeatTime = uRepeatTime;
+        item.payload.nDueTick = nDueTick;
+        m_timers.push(item);
+        return item.nTimerId;
+    }
+
+    void RemoveTimer(size_t nTimerId)
+    {
+        m_removedTimerIds.insert(nTimerId);
+    }
+
+    void Advance(uint64_t nNowTick)
+    {
+        while (!m_timers.empty()) {
+            const TimerItem& top = m_timers.top();
+            if (m_removedTimerIds.erase(top.nTimerId) > 0) {
+                m_timers.pop();
+            }
+            else if (top.payload.nDueTick <= nNowTick) {
+                TimerItem item = top;
+                m_timers.pop();
+                item.payload.timerCallback(item.payload.nDueTick);
+                if (--item.payload.uRepeatTime > 0) {
+                    item.payload.nDueTick = nNowTick + item.payload.uElapseMs;
+                    m_timers.push(std::move(item));
+                }
+            }
+            else {
+                break;
+            }
+        }
+    }
+
+private:
+    struct TimerItem
+    {
+        size_t nTimerId = 0;
+        TimerPayload payload;
+        bool operator < (const TimerItem& r) const { return payload.nDueTick > r.payload.nDueTick; }
+    };
+    std::priority_queue<TimerItem> m_timers;
+    std::set<size_t> m_removedTimerIds;
+    size_t m_nNextTimerId = 1;
+};
+
+/** 时间轮加哈希表：定时器数据和时间轮中的句柄保存在以定时器ID为键的哈希表中，每次触发都需要查找哈希表
+*/
+class HashWheelTimers
+{
+public:
+    size_t AddTimer(uint64_t nDueTick, uint32_t uRepeatTime, const TimerPayload& payload)
+    {
+        const size_t nTimerId = m_nNextTimerId++;
+        TimerItem& item = m_timers[nTimerId];
+        item.payload = payload;
+        item.payload.uRepeatTime = uRepeatTime;
+        item.payload.nDueTick = nDueTick;
+        item.nWheelHandle = m_wheel.AddTimer(nTimerId, nDueTick);
+        return nTimerId;
+    }
+
+    void RemoveTimer(size_t nTimerId)
+    {
+        auto iter = m_timers.find(nTimerId);
+        if (iter != m_timers.end()) {
+            m_wheel.RemoveTimer(iter->second.nWheelHandle);
+            m_timers.erase(iter);
+        }
+    }
+
+    void Advance(uint64_t nNowTick)
+    {
+        m_readyTimerIds.clear();
+        m_wheel.Advance(nNowTick, m_readyTimerIds);
+        for (size_t nTimerId : m_readyTimerIds) {
+            auto iter = m_timers.find(nTimerId);
+            if (iter == m_timers.end()) {
+                continue;
+            }
+            TimerPayload& payload = iter->second.payload;
+            payload.timerCallback(payload.nDueTick);
+            if (--payload.uRepeatTime > 0) {
+                payload.nDueTick = nNowTick + payload.uElapseMs;
+                iter->second.nWheelHandle = m_wheel.AddTimer(nTimerId, payload.nDueTick);
+            }
+            else {
+                m_timers.erase(iter);
+            }
+        }
+    }
+
+private:
+    struct TimerItem
+    {
+        uint64_t nWheelHandle = 0;
+        TimerPayload payload;
+    };
+    TimerWheel m_wheel;
+    std::unordered_map<size_t, TimerItem> m_timers;
+    std::vector<size_t> m_readyTimerIds;
+    size_t m_nNextTimerId = 1;
+};
+
+/** 时间轮加数组（与TimerManager相同）：定时器ID的低位是数组下标加1，高位是该位置的版本号，触发时直接按下标访问
+*/
+class SlotWheelTimers
+{
+public:
+    size_t AddTimer(uint64_t nDueTick, uint32_t uRepeatTime, const TimerPayload& payload)
+    {
+        size_t nSlot = 0;
+        if (!m_freeSlots.empty()) {
+            nSlot = m_freeSlots.back();
+            m_freeSlots.pop_back();
+        }
+        else {
+            nSlot = m_timers.size();
+            m_timers.emplace_back();
+        }
+        TimerItem& item = m_timers[nSlot];
+        item.nGeneration++;
+        item.nTimerId = (item.nGeneration << kSlotBits) | (nSlot + 1);
+        item.payload = payload;
+        item.payload.uRepeatTime = uRepeatTime;
+        item.payload.nDueTick = nDueTick;
+        item.nWheelHandle = m_wheel.AddTimer(item.nTimerId, nDueTick);
+        return item.nTimerId;
+    }
+
+    void RemoveTimer(size_t nTimerId)
+    {
+        TimerItem* pItem = FindTimer(nTimerId);
+        if (pItem != nullptr) {
+            m_wheel.RemoveTimer(pItem->nWheelHandle);
+            FreeTimer(*pItem);
+        }
+    }
+
+    void Advance(uint64_t nNowTick)
+    {
+        m_readyTimerIds.clear();
+        m_wheel.Advance(nNowTick, m_readyTimerIds);
+        for (size_t nTimerId : m_readyTimerIds) {
+            TimerItem* pItem = FindTimer(nTimerId);
+            if (pItem == nullptr) {
+                continue;
+            }
+            TimerPayload& payload = pItem->payload;
+            payload.timerCallback(payload.nDueTick);
+            if (--payload.uRepeatTime > 0) {
+                payload.nDueTick = nNowTick + payload.uElapseMs;
+                pItem->nWheelHandle = m_wheel.AddTimer(nTimerId, payload.nDueTick);
+            }
+            else {
+                FreeTimer(*pItem);
+            }
+        }
+    }
+
+private:
+    struct TimerItem
+    {
+        uint64_t nWheelHandle = 0;
+        size_t nTimerId = 0;
+        size_t nGeneration = 0;
+        TimerPayload payload;
+    };
+
+    static constexpr size_t kSlotBits = sizeof(size_t) * 4;
+
+    TimerItem* FindTimer(size_t nTimerId)
+    {
+        const size_t nSlot = (nTimerId & (((size_t)1 << kSlotBits) - 1)) - 1;
+        if ((nSlot >= m_timers.size()) || (m_timers[nSlot].nTimerId != nTimerId)) {
+            return nullptr;
+        }
+        return &m_timers[nSlot];
+    }
+
+    void FreeTimer(TimerItem& item)
+    {
+        m_freeSlots.push_back((item.nTimerId & (((size_t)1 << kSlotBits) - 1)) - 1);
+        item.nTimerId = 0;
+        item.payload = TimerPayload();
+    }
+
+    TimerWheel m_wheel;
+    std::vector<TimerItem> m_timers;
+    std::vector<size_t> m_freeSlots;
+    std::vector<size_t> m_readyTimerIds;
+};
+
+/** 添加后取消：每次添加一个定时器后立即取消（有1000个长时间的定时器作为背景），返回触发的次数
+*/
+template<typename TTimers>
+double RunAddCancel(int nCycleCount, uint64_t& nChecksum)
+{
+    TTimers timers;
+    TimerPayload payload;
+    nChecksum = 0;
+    payload.timerCallback = [&nChecksum](uint64_t nDueTick) { nChecksum += nDueTick + 1; };
+    uint32_t nSeed = 3;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 1000; ++i) {
+        timers.AddTimer(3600 * 1000, 1, payload);
+    }
+    uint64_t nNowTick = 0;
+    for (int i = 0; i < nCycleCount; ++i) {
+        const size_t nTimerId = timers.AddTimer(nNowTick + 100 + NextRandom(nSeed) % 2000, 1, payload);
+        timers.RemoveTimer(nTimerId);
+        if ((i % 16) == 15) {
+            timers.Advance(++nNowTick);
+        }
+    }
+    timers.Advance(nNowTick + 10000);
+    return ElapsedMs(start);
+}
+
+/** 全部触发：添加定时器（触发时间在10秒内随机分布），按毫秒推进时间直到全部触发
+*/
+template<typename TTimers>
+double RunFireAll(int nTimerCount, uint64_t& nChecksum)
+{
+    TTimers timers;
+    TimerPayload payload;
+    nChecksum = 0;
+    payload.timerCallback = [&nChecksum](uint64_t nDueTick) { nChecksum += nDueTick + 1; };
+    uint32_t nSeed = 5;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int i = 0; i < nTimerCount; ++i) {
+        timers.AddTimer(1 + NextRandom(nSeed) % 10000, 1, payload);
+    }
+    for (uint64_t nNowTick = 1; nNowTick <= 10000; ++nNowTick) {
+        timers.Advance(nNowTick);
+    }
+    return ElapsedMs(start);
+}
+
+/** 重复触发：1000个重复定时器（间隔1到64毫秒，类似动画和轮询），按毫秒推进时间，共触发约nFireCount次
+*/
+template<typename TTimers>
+double RunRepeat(int nFireCount, uint64_t& nChecksum)
+{
+    TTimers timers;
+    TimerPayload payload;
+    nChecksum = 0;
+    payload.timerCallback = [&nChecksum](uint64_t nDueTick) { nChecksum += nDueTick + 1; };
+    uint32_t nSeed = 7;
+    const int nTimerCount = 1000;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int i = 0; i < nTimerCount; ++i) {
+        payload.uElapseMs = 1 + NextRandom(nSeed) % 64;
+        timers.AddTimer(payload.uElapseMs, UINT32_MAX, payload);
+    }
+    //平均间隔约32毫秒，每毫秒约触发 nTimerCount / 32 次
+    const uint64_t nTickCount = std::max<uint64_t>(1, (uint64_t)nFireCount * 32 / nTimerCount);
+    for (uint64_t nNowTick = 1; nNowTick <= nTickCount; ++nNowTick) {
+        timers.Advance(nNowTick);
+    }
+    return ElapsedMs(start);
+}
+
+/** 多次运行，返回最短的耗时（单核、有干扰的机器上，最短耗时比平均值稳定）
+*/
+double RunBest(double (*pfnRun)(int, uint64_t&), int nCount, uint64_t& nChecksum)
+{
+    double fBestMs = 0;
+    for (int i = 0; i < 5; ++i) {
+        const double fMs = pfnRun(nCount, nChecksum);
+        if ((i == 0) || (fMs < fBestMs)) {
+            fBestMs = fMs;
+        }
+    }
+    return fBestMs;
+}
+
+/** 运行一项测试，并输出三种实现的耗时
+*/
+bool RunTest(const char* szName, double (*pfnQueue)(int, uint64_t&), double (*pfnHash)(int, uint64_t&),
+             double (*pfnSlot)(int, uint64_t&), int nCount)
+{
+    uint64_t nQueueChecksum = 0;
+    uint64_t nHashChecksum = 0;
+    uint64_t nSlotChecksum = 0;
+    const double fQueueMs = RunBest(pfnQueue, nCount, nQueueChecksum);
+    const double fHashMs = RunBest(pfnHash, nCount, nHashChecksum);
+    const double fSlotMs = RunBest(pfnSlot, nCount, nSlotChecksum);
+    if ((nQueueChecksum != nHashChecksum) || (nQueueChecksum != nSlotChecksum)) {
+        std::printf("Checksum mismatch in test: %s\n", szName);
+        return false;
+    }
+    std::printf("%-24s %14.3f %16.3f %16.3f %11.1fx %9.1fx\n", szName, fQueueMs, fHashMs, fSlotMs,
+                (fSlotMs > 0) ? (fQueueMs / fSlotMs) : 0.0, (fSlotMs > 0) ? (fHashMs / fSlotMs) : 0.0);
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    const int nCycleCount = (argc > 1) ? std::max(1, std::atoi(argv[1])) : 100000;
+
+    std::printf("Cycles: %d (best of 5 runs)\n\n", nCycleCount);
+    std::printf("%-24s %14s %16s %16s %12s %10s\n", "Test", "Queue+set(ms)", "Wheel+hash(ms)", "Wheel+slots(ms)",
+                "vs queue", "vs hash");
+    if (!RunTest("Add + cancel", RunAddCancel<PriorityQueueTimers>, RunAddCancel<HashWheelTimers>,
+                 RunAddCancel<SlotWheelTimers>, nCycleCount) ||
+        !RunTest("Add + fire (10s spread)", RunFireAll<PriorityQueueTimers>, RunFireAll<HashWheelTimers>,
+                 RunFireAll<SlotWheelTimers>, nCycleCount) ||
+        !RunTest("Repeat fire (1000 timers)", RunRepeat<PriorityQueueTimers>, RunRepeat<HashWheelTimers>,
+                 RunRepeat<SlotWheelTimers>, nCycleCount * 10)) {
+        return 2;
+    }
+    std::printf("\nNote: the queue keeps cancelled timers until they reach the top, so its memory grows with\n"
+                "the number of pending cancellations; the timer wheel unlinks them immediately.\n");
+    return 0;
+}
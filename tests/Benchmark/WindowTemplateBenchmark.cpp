@@ -0,0 +1,141 @@
+// 窗口模板缓存的性能测试：反复加载菜单的窗口树，比较每次解析菜单XML文件与使用窗口模板缓存的耗时
+// 只测量窗口树的加载和遍历，不调用WindowBuilder::CreateControls，也不创建Menu窗口和控件，所以结果不是菜单弹出的耗时
+// 菜单弹出（创建窗口、控件并显示）的耗时由 menu_open_benchmark 测量，该测试依赖完整的duilib库和图形桌面环境
+// 用法：window_template_benchmark [资源目录] [加载次数]
+//       资源目录默认为 bin/resources（测试其中文件名含有menu的XML文件），加载次数默认为 1000
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "duilib/Core/WindowTemplate.h"
+#include "duilib/Core/XmlBinaryCache.h"
+#include "duilib/third_party/xml/pugixml.hpp"
+
+using ui::WindowTemplate;
+using ui::XmlBinaryDocument;
+
+namespace {
+
+/** 遍历所有节点和属性（模拟WindowBuilder创建控件时的访问），返回访问到的节点和属性总数，避免被编译器优化掉
+*/
+template<typename TXmlNode>
+size_t WalkTree(const TXmlNode& node)
+{
+    size_t nCount = 1;
+    for (const auto& attr : node.attributes()) {
+        nCount += (attr.name()[0] != 0) ? 1 : 0;
+        nCount += (attr.value()[0] != 0) ? 1 : 0;
+    }
+    for (const auto& child : node.children()) {
+        nCount += WalkTree(child);
+    }
+    return nCount;
+}
+
+std::vector<uint8_t> ReadFileData(const std::filesystem::path& filePath)
+{
+    std::vector<uint8_t> fileData;
+    FILE* file = std::fopen(filePath.string().c_str(), "rb");
+    if (file == nullptr) {
+        return fileData;
+    }
+    std::fseek(file, 0, SEEK_END);
+    const long nSize = std::ftell(file);
+    std::fseek(file, 0, SEEK_SET);
+    if (nSize > 0) {
+        fileData.resize((size_t)nSize);
+        if (std::fread(fileData.data(), 1, fileData.size(), file) != fileData.size()) {
+            fileData.clear();
+        }
+    }
+    std::fclose(file);
+    return fileData;
+}
+
+double ElapsedMs(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    std::filesystem::path resourceDir = (argc > 1) ? std::filesystem::path(argv[1]) :
+                                        std::filesystem::path(DUILIB_BENCHMARK_RESOURCE_DIR);
+    const int nLoadCount = (argc > 2) ? std::max(1, std::atoi(argv[2])) : 1000;
+
+    std::vector<std::filesystem::path> menuFiles;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(resourceDir, ec)) {
+        if (entry.is_regular_file() && (entry.path().extension() == ".xml") &&
+            (entry.path().filename().string().find("menu") != std::string::npos)) {
+            menuFiles.push_back(entry.path());
+        }
+    }
+    if (menuFiles.empty()) {
+        std::printf("No menu xml files found in: %s\n", resourceDir.string().c_str());
+        return 1;
+    }
+
+    //首次加载时编译窗口模板（与WindowBuilder::ParseXmlFileWithCache相同，缓存关键字为XML文件路径）
+    std::map<std::string, std::shared_ptr<XmlBinaryDocument>> templateCache;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (const std::filesystem::path& menuFile : menuFiles) {
+        std::vector<uint8_t> templateData;
+        if (!WindowTemplate::CompileXmlData(ReadFileData(menuFile), nullptr, templateData)) {
+            continue;
+        }
+        std::shared_ptr<XmlBinaryDocument> doc = std::make_shared<XmlBinaryDocument>();
+        if (doc->LoadBuffer(std::move(templateData))) {
+            templateCache[menuFile.string()] = doc;
+        }
+    }
+    const double fCompileMs = ElapsedMs(start);
+
+    //每次加载都解析XML文件（原有的方式）
+    size_t nParseChecksum = 0;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < nLoadCount; ++i) {
+        for (const std::filesystem::path& menuFile : menuFiles) {
+            pugi::xml_document doc;
+            doc.load_file(menuFile.string().c_str());
+            nParseChecksum += WalkTree(doc.root());
+        }
+    }
+    const double fParseMs = ElapsedMs(start);
+
+    //每次加载都使用窗口模板缓存
+    size_t nTemplateChecksum = 0;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < nLoadCount; ++i) {
+        for (const std::filesystem::path& menuFile : menuFiles) {
+            auto iter = templateCache.find(menuFile.string());
+            if (iter != templateCache.end()) {
+                std::shared_ptr<XmlBinaryDocument> doc = iter->second;
+                nTemplateChecksum += WalkTree(doc->root());
+            }
+        }
+    }
+    const double fTemplateMs = ElapsedMs(start);
+
+    const double fLoadCount = (double)nLoadCount * (double)menuFiles.size();
+    std::printf("Resource dir: %s\n", resourceDir.string().c_str());
+    std::printf("Menu files: %zu, loads per file: %d, template compile: %.3f ms\n\n",
+                menuFiles.size(), nLoadCount, fCompileMs);
+    std::printf("%-24s %22s %12s\n", "Mode", "Avg template load(us)", "Checksum");
+    std::printf("%-24s %22.3f %12zu\n", "XML parse (pugixml)", fParseMs * 1000.0 / fLoadCount, nParseChecksum);
+    std::printf("%-24s %22.3f %12zu\n", "Window template cache", fTemplateMs * 1000.0 / fLoadCount, nTemplateChecksum);
+    std::printf("\nNote: these are template-load times (load + walk the window tree), NOT menu-open latency.\n"
+                "Native window creation, WindowBuilder::CreateControls, layout and painting are excluded;\n"
+                "use menu_open_benchmark (needs the full duilib library and a desktop session) for Menu::ShowMenu times.\n"
+                "The checksums differ when class attributes are expanded in the templates.\n");
+    return templateCache.empty() ? 2 : 0;
+}
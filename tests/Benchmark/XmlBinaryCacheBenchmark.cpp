@@ -0,0 +1,151 @@
+// XML二进制缓存的性能测试：比较直接解析XML文件、加载非压缩缓存和加载LZ4压缩缓存的耗时和文件大小
+// 用法：xml_binary_cache_benchmark [资源目录] [循环次数]
+//       资源目录默认为 bin/resources，循环次数默认为 20
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "duilib/Core/XmlBinaryCache.h"
+#include "duilib/third_party/xml/pugixml.hpp"
+
+using ui::FilePath;
+using ui::XmlBinaryCache;
+using ui::XmlBinaryDocument;
+
+namespace {
+
+/** 遍历所有节点和属性（模拟WindowBuilder创建控件时的访问），返回访问到的字符总数，避免被编译器优化掉
+*/
+template<typename TXmlNode>
+size_t WalkTree(const TXmlNode& node)
+{
+    size_t nCount = 1;
+    for (const auto& attr : node.attributes()) {
+        nCount += (attr.name()[0] != 0) ? 1 : 0;
+        nCount += (attr.value()[0] != 0) ? 1 : 0;
+    }
+    for (const auto& child : node.children()) {
+        nCount += WalkTree(child);
+    }
+    return nCount;
+}
+
+FilePath ToFilePath(const std::filesystem::path& path)
+{
+#ifdef DUILIB_UNICODE
+    return FilePath(path.wstring());
+#else
+    return FilePath(path.string());
+#endif
+}
+
+uintmax_t GetTotalFileSize(const std::filesystem::path& dir, const char* ext)
+{
+    uintmax_t nTotal = 0;
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(dir)) {
+        if (entry.is_regular_file() && (entry.path().extension() == ext)) {
+            nTotal += entry.file_size();
+        }
+    }
+    return nTotal;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    std::filesystem::path resourceDir = (argc > 1) ? std::filesystem::path(argv[1]) :
+                                        std::filesystem::path(DUILIB_BENCHMARK_RESOURCE_DIR);
+    const int nIterations = (argc > 2) ? std::max(1, std::atoi(argv[2])) : 20;
+
+    std::vector<std::filesystem::path> xmlFiles;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(resourceDir, ec)) {
+        if (entry.is_regular_file() && (entry.path().extension() == ".xml")) {
+            xmlFiles.push_back(entry.path());
+        }
+    }
+    if (xmlFiles.empty()) {
+        std::printf("No xml files found in: %s\n", resourceDir.string().c_str());
+        return 1;
+    }
+
+    const std::filesystem::path tempDir = std::filesystem::temp_directory_path() / "duilib_xml_cache_benchmark";
+    const std::filesystem::path rawCacheDir = tempDir / "raw";
+    const std::filesystem::path lz4CacheDir = tempDir / "lz4";
+    std::filesystem::remove_all(tempDir, ec);
+    std::filesystem::create_directories(rawCacheDir);
+    std::filesystem::create_directories(lz4CacheDir);
+
+    XmlBinaryCache rawCache;
+    rawCache.SetCacheDirectory(ToFilePath(rawCacheDir));
+    XmlBinaryCache lz4Cache;
+    lz4Cache.SetCacheDirectory(ToFilePath(lz4CacheDir));
+    lz4Cache.SetCompressionEnabled(true);
+
+    //生成缓存文件
+    uintmax_t nXmlSize = 0;
+    std::vector<FilePath> validFiles;
+    for (const std::filesystem::path& xmlFile : xmlFiles) {
+        pugi::xml_document doc;
+        if (!doc.load_file(xmlFile.string().c_str())) {
+            continue;
+        }
+        const FilePath xmlPath = ToFilePath(xmlFile);
+        if (rawCache.SaveToCache(xmlPath, doc) && lz4Cache.SaveToCache(xmlPath, doc)) {
+            validFiles.push_back(xmlPath);
+            nXmlSize += std::filesystem::file_size(xmlFile);
+        }
+    }
+
+    using Clock = std::chrono::steady_clock;
+    size_t nChecksum[3] = { 0, 0, 0 };
+    double fElapsedMs[3] = { 0, 0, 0 };
+    for (int i = 0; i < nIterations; ++i) {
+        Clock::time_point start = Clock::now();
+        for (const FilePath& xmlPath : validFiles) {
+            pugi::xml_document doc;
+            doc.load_file(xmlPath.NativePathA().c_str());
+            nChecksum[0] += WalkTree(doc.root());
+        }
+        Clock::time_point end = Clock::now();
+        fElapsedMs[0] += std::chrono::duration<double, std::milli>(end - start).count();
+
+        start = Clock::now();
+        for (const FilePath& xmlPath : validFiles) {
+            XmlBinaryDocument doc;
+            rawCache.LoadFromCache(xmlPath, doc);
+            nChecksum[1] += WalkTree(doc.root());
+        }
+        end = Clock::now();
+        fElapsedMs[1] += std::chrono::duration<double, std::milli>(end - start).count();
+
+        start = Clock::now();
+        for (const FilePath& xmlPath : validFiles) {
+            XmlBinaryDocument doc;
+            lz4Cache.LoadFromCache(xmlPath, doc);
+            nChecksum[2] += WalkTree(doc.root());
+        }
+        end = Clock::now();
+        fElapsedMs[2] += std::chrono::duration<double, std::milli>(end - start).count();
+    }
+
+    const uintmax_t nRawCacheSize = GetTotalFileSize(rawCacheDir, ".xmc");
+    const uintmax_t nLz4CacheSize = GetTotalFileSize(lz4CacheDir, ".xmc");
+    std::printf("Resource dir: %s\n", resourceDir.string().c_str());
+    std::printf("Files: %zu, iterations: %d\n\n", validFiles.size(), nIterations);
+    std::printf("%-24s %14s %14s %12s\n", "Mode", "Total size(B)", "Avg load(ms)", "Checksum");
+    std::printf("%-24s %14ju %14.3f %12zu\n", "XML parse (pugixml)", nXmlSize, fElapsedMs[0] / nIterations, nChecksum[0]);
+    std::printf("%-24s %14ju %14.3f %12zu\n", "Binary cache (raw)", nRawCacheSize, fElapsedMs[1] / nIterations, nChecksum[1]);
+    std::printf("%-24s %14ju %14.3f %12zu\n", "Binary cache (LZ4)", nLz4CacheSize, fElapsedMs[2] / nIterations, nChecksum[2]);
+    std::printf("\nNote: files are read from the OS page cache after the first iteration;\n"
+                "on slow disks the load time is dominated by the file size column.\n");
+
+    std::filesystem::remove_all(tempDir, ec);
+    return ((nChecksum[0] == nChecksum[1]) && (nChecksum[0] == nChecksum[2])) ? 0 : 2;
+}
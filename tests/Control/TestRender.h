@@ -0,0 +1,217 @@
+#ifndef TESTS_CONTROL_TEST_RENDER_H_
+#define TESTS_CONTROL_TEST_RENDER_H_
+
+#pragma once
+
+#include "duilib/Render/IRender.h"
+#include <vector>
+
+namespace ui {
+namespace test {
+
+/** 不绘制的IRender测试实现：只实现格式文本的测量（每个字符等宽，不自动换行，每个物理行一个逻辑行），其余接口为空实现
+*   测量时记录计算过的物理行号，用于检查RichEditData计算了哪些行
+*/
+class TestRender : public IRender
+{
+public:
+    /** 每个字符的宽度和每行的行高
+    */
+    static constexpr float kCharWidth = 8.0f;
+    static constexpr float kRowHeight = 16.0f;
+
+    /** 测量过的物理行号（按测量顺序）
+    */
+    std::vector<size_t> m_measuredLines;
+
+    RenderType GetRenderType() const override { return RenderType::kRenderType_Skia; }
+
+    void MeasureRichText2(const UiRect& textRect,
+                          const UiSize& /*szScrollOffset*/,
+                          IRenderFactory* /*pRenderFactory*/,
+                          const std::vector<RichTextData>& richTextData,
+                          RichTextLineInfoParam* pLineInfoParam,
+                          std::vector<std::vector<UiRect>>* /*pRichTextRects*/) override
+    {
+        if ((pLineInfoParam == nullptr) || (pLineInfoParam->m_pLineInfoList == nullptr)) {
+            return;
+        }
+        RichTextLineInfoList& lineInfoList = *pLineInfoParam->m_pLineInfoList;
+        size_t nLine = pLineInfoParam->m_nStartLineIndex;
+        uint32_t nRow = pLineInfoParam->m_nStartRowIndex;
+        RichTextRowInfoPtr spRowInfo;
+        for (const RichTextData& textData : richTextData) {
+            for (const wchar_t ch : textData.m_textView) {
+                if (spRowInfo == nullptr) {
+                    if (nLine >= lineInfoList.size()) {
+                        return;
+                    }
+                    spRowInfo.reset(new RichTextRowInfo);
+                    spRowInfo->m_rowRect.left = (float)textRect.left;
+                    spRowInfo->m_rowRect.right = (float)textRect.left;
+                    spRowInfo->m_rowRect.top = nRow * kRowHeight;
+                    spRowInfo->m_rowRect.bottom = spRowInfo->m_rowRect.top + kRowHeight;
+                    lineInfoList[nLine]->m_rowInfo.push_back(spRowInfo);
+                    m_measuredLines.push_back(nLine);
+                }
+                RichTextCharInfo charInfo;
+                if (ch == L'\r') {
+                    charInfo.AddCharFlag(RichTextCharFlag::kIsIgnoredChar);
+                    charInfo.AddCharFlag(RichTextCharFlag::kIsReturn);
+                }
+                else if (ch == L'\n') {
+                    charInfo.AddCharFlag(RichTextCharFlag::kIsNewLine);
+                }
+                else {
+                    charInfo.SetCharWidth(kCharWidth);
+                    spRowInfo->m_rowRect.right += kCharWidth;
+                }
+                spRowInfo->m_charInfo.push_back(charInfo);
+                if (ch == L'\n') {
+                    //换行：下一个字符属于下一个物理行
+                    spRowInfo.reset();
+                    ++nLine;
+                    ++nRow;
+                }
+            }
+        }
+    }
+
+    void MeasureRichText3(const UiRect& textRect,
+                          const UiSize& szScrollOffset,
+                          IRenderFactory* pRenderFactory,
+                          const std::vector<RichTextData>& richTextData,
+                          RichTextLineInfoParam* pLineInfoParam,
+                          std::shared_ptr<DrawRichTextCache>& /*spDrawRichTextCache*/,
+                          std::vector<std::vector<UiRect>>* pRichTextRects) override
+    {
+        //不生成绘制缓存
+        MeasureRichText2(textRect, szScrollOffset, pRenderFactory, richTextData, pLineInfoParam, pRichTextRects);
+    }
+
+    //以下接口为空实现
+    RenderBackendType GetRenderBackendType() const override { return RenderBackendType::kRaster_BackendType; }
+    int32_t GetWidth() const override { return 0; }
+    int32_t GetHeight() const override { return 0; }
+    bool Resize(int32_t /*width*/, int32_t /*height*/) override { return false; }
+    UiPoint OffsetWindowOrg(UiPoint /*ptOffset*/) override { return UiPoint(); }
+    UiPoint SetWindowOrg(UiPoint /*pt*/) override { return UiPoint(); }
+    UiPoint GetWindowOrg() const override { return UiPoint(); }
+    void SaveClip(int32_t& /*nState*/) override {}
+    void RestoreClip(int32_t /*nState*/) override {}
+    void SetClip(const UiRect& /*rc*/, bool /*bIntersect*/) override {}
+    void SetRoundClip(const UiRect& /*rcItem*/, float /*rx*/, float /*ry*/, bool /*bIntersect*/) override {}
+    void ClearClip() override {}
+    bool BitBlt(int32_t /*x*/, int32_t /*y*/, int32_t /*cx*/, int32_t /*cy*/, IRender* /*pSrcRender*/, int32_t /*xSrc*/, int32_t /*ySrc*/,
+                RopMode /*rop*/) override { return false; }
+    bool StretchBlt(int32_t /*xDest*/, int32_t /*yDest*/, int32_t /*widthDest*/, int32_t /*heightDest*/, IRender* /*pSrcRender*/,
+                    int32_t /*xSrc*/, int32_t /*ySrc*/, int32_t /*widthSrc*/, int32_t /*heightSrc*/, RopMode /*rop*/) override { return false; }
+    bool AlphaBlend(int32_t /*xDest*/, int32_t /*yDest*/, int32_t /*widthDest*/, int32_t /*heightDest*/, IRender* /*pSrcRender*/,
+                    int32_t /*xSrc*/, int32_t /*ySrc*/, int32_t /*widthSrc*/, int32_t /*heightSrc*/, uint8_t /*alpha*/) override { return false; }
+    void DrawImage(const UiRect& /*rcPaint*/, IBitmap* /*pBitmap*/, const UiRect& /*rcDest*/, const UiRect& /*rcDestCorners*/,
+                   const UiRect& /*rcSource*/, const UiRect& /*rcSourceCorners*/, uint8_t /*uFade*/, const TiledDrawParam* /*pTiledDrawParam*/, bool /*bWindowShadowMode*/) override {}
+    void DrawImage(const UiRect& /*rcPaint*/, IBitmap* /*pBitmap*/, const UiRect& /*rcDest*/, const UiRect& /*rcSource*/,
+                   uint8_t /*uFade*/, const TiledDrawParam* /*pTiledDrawParam*/, bool /*bWindowShadowMode*/) override {}
+    void DrawImageRect(const UiRect& /*rcPaint*/, IBitmap* /*pBitmap*/, const UiRect& /*rcDest*/, const UiRect& /*rcSource*/,
+                       uint8_t /*uFade*/, IMatrix* /*pMatrix*/) override {}
+    void DrawLine(const UiPoint& /*pt1*/, const UiPoint& /*pt2*/, UiColor /*penColor*/, int32_t /*nWidth*/) override {}
+    void DrawLine(const UiPoint& /*pt1*/, const UiPoint& /*pt2*/, UiColor /*penColor*/, float /*fWidth*/) override {}
+    void DrawLine(const UiPointF& /*pt1*/, const UiPointF& /*pt2*/, UiColor /*penColor*/, float /*fWidth*/) override {}
+    void DrawLine(const UiPoint& /*pt1*/, const UiPoint& /*pt2*/, IPen* /*pen*/) override {}
+    void DrawLine(const UiPointF& /*pt1*/, const UiPointF& /*pt2*/, IPen* /*pen*/) override {}
+    void DrawRect(const UiRect& /*rc*/, UiColor /*penColor*/, int32_t /*nWidth*/, bool /*bLineInRect*/) override {}
+    void DrawRect(const UiRectF& /*rc*/, UiColor /*penColor*/, int32_t /*nWidth*/, bool /*bLineInRect*/) override {}
+    void DrawRect(const UiRect& /*rc*/, UiColor /*penColor*/, float /*fWidth*/, bool /*bLineInRect*/) override {}
+    void DrawRect(const UiRectF& /*rc*/, UiColor /*penColor*/, float /*fWidth*/, bool /*bLineInRect*/) override {}
+    void DrawRect(const UiRect& /*rc*/, IPen* /*pen*/, bool /*bLineInRect*/) override {}
+    void DrawRect(const UiRectF& /*rc*/, IPen* /*pen*/, bool /*bLineInRect*/) override {}
+    void FillRect(const UiRect& /*rc*/, UiColor /*dwColor*/, uint8_t /*uFade*/) override {}
+    void FillRect(const UiRectF& /*rc*/, UiColor /*dwColor*/, uint8_t /*uFade*/) override {}
+    void FillRect(const UiRect& /*rc*/, UiColor /*dwColor*/, UiColor /*dwColor2*/, int8_t /*nColor2Direction*/,
+                  uint8_t /*uFade*/) override {}
+    void FillRect(const UiRectF& /*rc*/, UiColor /*dwColor*/, UiColor /*dwColor2*/, int8_t /*nColor2Direction*/,
+                  uint8_t /*uFade*/) override {}
+    void DrawRoundRect(const UiRect& /*rc*/, float /*rx*/, float /*ry*/, UiColor /*penColor*/, int32_t /*nWidth*/) override {}
+    void DrawRoundRect(const UiRectF& /*rc*/, float /*rx*/, float /*ry*/, UiColor /*penColor*/, int32_t /*nWidth*/) override {}
+    void DrawRoundRect(const UiRect& /*rc*/, float /*rx*/, float /*ry*/, UiColor /*penColor*/, float /*fWidth*/) override {}
+    void DrawRoundRect(const UiRectF& /*rc*/, float /*rx*/, float /*ry*/, UiColor /*penColor*/, float /*fWidth*/) override {}
+    void DrawRoundRect(const UiRect& /*rc*/, float /*rx*/, float /*ry*/, IPen* /*pen*/) override {}
+    void DrawRoundRect(const UiRectF& /*rc*/, float /*rx*/, float /*ry*/, IPen* /*pen*/) override {}
+    void FillRoundRect(const UiRect& /*rc*/, float /*rx*/, float /*ry*/, UiColor /*dwColor*/, uint8_t /*uFade*/) override {}
+    void FillRoundRect(const UiRectF& /*rc*/, float /*rx*/, float /*ry*/, UiColor /*dwColor*/, uint8_t /*uFade*/) override {}
+    void FillRoundRect(const UiRect& /*rc*/, float /*rx*/, float /*ry*/, UiColor /*dwColor*/, UiColor /*dwColor2*/,
+                       int8_t /*nColor2Direction*/, uint8_t /*uFade*/) override {}
+    void FillRoundRect(const UiRectF& /*rc*/, float /*rx*/, float /*ry*/, UiColor /*dwColor*/, UiColor /*dwColor2*/,
+                       int8_t /*nColor2Direction*/, uint8_t /*uFade*/) override {}
+    void DrawArc(const UiRect& /*rc*/, float /*startAngle*/, float /*sweepAngle*/, bool /*useCenter*/, const IPen* /*pen*/,
+                 UiColor* /*gradientColor*/, const UiRect* /*gradientRect*/) override {}
+    void DrawCircle(const UiPoint& /*centerPt*/, int32_t /*radius*/, UiColor /*penColor*/, int32_t /*nWidth*/) override {}
+    void DrawCircle(const UiPoint& /*centerPt*/, int32_t /*radius*/, UiColor /*penColor*/, float /*fWidth*/) override {}
+    void DrawCircle(const UiPoint& /*centerPt*/, int32_t /*radius*/, IPen* /*pen*/) override {}
+    void FillCircle(const UiPoint& /*centerPt*/, int32_t /*radius*/, UiColor /*dwColor*/, uint8_t /*uFade*/) override {}
+    void DrawPath(const IPath* /*path*/, const IPen* /*pen*/) override {}
+    void FillPath(const IPath* /*path*/, const IBrush* /*brush*/) override {}
+    void FillPath(const IPath* /*path*/, const UiRect& /*rc*/, UiColor /*dwColor*/, UiColor /*dwColor2*/,
+                  int8_t /*nColor2Direction*/) override {}
+    UiRect MeasureString(const DString& /*strText*/, const MeasureStringParam& /*measureParam*/) override { return UiRect(); }
+    void DrawString(const DString& /*strText*/, const DrawStringParam& /*drawParam*/) override {}
+    void MeasureRichText(const UiRect& /*textRect*/, const UiSize& /*szScrollOffset*/, IRenderFactory* /*pRenderFactory*/,
+                         const std::vector<RichTextData>& /*richTextData*/, std::vector<std::vector<UiRect>>* /*pRichTextRects*/) override {}
+    void DrawRichText(const UiRect& /*textRect*/, const UiSize& /*szScrollOffset*/, IRenderFactory* /*pRenderFactory*/,
+                      const std::vector<RichTextData>& /*richTextData*/, uint8_t /*uFade*/, std::vector<std::vector<UiRect>>* /*pRichTextRects*/) override {}
+    bool CreateDrawRichTextCache(const UiRect& /*textRect*/, const UiSize& /*szScrollOffset*/, IRenderFactory* /*pRenderFactory*/,
+                                 const std::vector<RichTextData>& /*richTextData*/, std::shared_ptr<DrawRichTextCache>& /*spDrawRichTextCache*/) override { return false; }
+    bool IsValidDrawRichTextCache(const UiRect& /*textRect*/, const std::vector<RichTextData>& /*richTextData*/,
+                                  const std::shared_ptr<DrawRichTextCache>& /*spDrawRichTextCache*/) override { return false; }
+    bool UpdateDrawRichTextCache(std::shared_ptr<DrawRichTextCache>& /*spOldDrawRichTextCache*/,
+                                 const std::shared_ptr<DrawRichTextCache>& /*spUpdateDrawRichTextCache*/, std::vector<RichTextData>& /*richTextDataNew*/, size_t /*nStartLine*/, const std::vector<size_t>& /*modifiedLines*/, size_t /*nModifiedRows*/, const std::vector<size_t>& /*deletedLines*/, size_t /*nDeletedRows*/, const std::vector<int32_t>& /*rowRectTopList*/) override { return false; }
+    bool IsDrawRichTextCacheEqual(const DrawRichTextCache& /*first*/, const DrawRichTextCache& /*second*/) const override { return false; }
+    void DrawRichTextCacheData(const std::shared_ptr<DrawRichTextCache>& /*spDrawRichTextCache*/, const UiRect& /*textRect*/,
+                               const UiSize& /*szNewScrollOffset*/, const std::vector<int32_t>& /*rowXOffset*/, uint8_t /*uFade*/, std::vector<std::vector<UiRect>>* /*pRichTextRects*/) override {}
+    void DrawBoxShadow(const UiRect& /*rc*/, const UiSize& /*roundSize*/, const UiPoint& /*cpOffset*/, int32_t /*nBlurRadius*/,
+                       int32_t /*nSpreadRadius*/, UiColor /*dwColor*/) override {}
+    IBitmap* MakeImageSnapshot() override { return nullptr; }
+    void ClearAlpha(const UiRect& /*rcDirty*/, uint8_t /*alpha*/) override {}
+    void RestoreAlpha(const UiRect& /*rcDirty*/, const UiPadding& /*rcShadowPadding*/, uint8_t /*alpha*/) override {}
+    void RestoreAlpha(const UiRect& /*rcDirty*/, const UiPadding& /*rcShadowPadding*/) override {}
+#ifdef DUILIB_BUILD_FOR_WIN
+    HDC GetRenderDC(HWND /*hWnd*/) override { return nullptr; }
+    void ReleaseRenderDC(HDC /*hdc*/) override {}
+#endif
+    void Clear(const UiColor& /*uiColor*/) override {}
+    void ClearRect(const UiRect& /*rcDirty*/, const UiColor& /*uiColor*/) override {}
+    std::unique_ptr<IRender> Clone() override { return nullptr; }
+    bool ReadPixels(const UiRect& /*rc*/, void* /*dstPixels*/, size_t /*dstPixelsLen*/) override { return false; }
+    bool WritePixels(void* /*srcPixels*/, size_t /*srcPixelsLen*/, const UiRect& /*rc*/) override { return false; }
+    bool WritePixels(void* /*srcPixels*/, size_t /*srcPixelsLen*/, const UiRect& /*rc*/,
+                     const UiRect& /*rcPaint*/) override { return false; }
+    RenderClipType GetClipInfo(std::vector<UiRect>& /*clipRects*/) override { return RenderClipType::kEmpty; }
+    bool IsClipEmpty() const override { return false; }
+    bool IsEmpty() const override { return false; }
+    void SetRenderDpi(const IRenderDpiPtr& /*spRenderDpi*/) override {}
+    bool PaintAndSwapBuffers(IRenderPaint* /*pRenderPaint*/) override { return false; }
+    bool SetWindowRoundRectRgn(const UiRect& /*rcWnd*/, float /*rx*/, float /*ry*/, bool /*bRedraw*/) override { return false; }
+    bool SetWindowRectRgn(const UiRect& /*rcWnd*/, bool /*bRedraw*/) override { return false; }
+    void ClearWindowRgn(bool /*bRedraw*/) override {}
+};
+
+/** 不创建任何对象的IRenderFactory测试实现
+*/
+class TestRenderFactory : public IRenderFactory
+{
+public:
+    IFont* CreateIFont() override { return nullptr; }
+    IPen* CreatePen(UiColor /*color*/, float /*fWidth*/) override { return nullptr; }
+    IBrush* CreateBrush(UiColor /*corlor*/) override { return nullptr; }
+    IPath* CreatePath() override { return nullptr; }
+    IMatrix* CreateMatrix() override { return nullptr; }
+    IBitmap* CreateBitmap() override { return nullptr; }
+    IRender* CreateRender(const IRenderDpiPtr& /*spRenderDpi*/, void* /*platformData*/,
+                          RenderBackendType /*backendType*/) override { return nullptr; }
+    IFontMgr* GetFontMgr() const override { return nullptr; }
+};
+
+} // namespace test
+} // namespace ui
+
+#endif // TESTS_CONTROL_TEST_RENDER_H_
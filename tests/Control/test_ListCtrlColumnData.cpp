@@ -0,0 +1,172 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+#include "duilib/Control/ListCtrlColumnData.h"
+
+using ui::ListCtrlColumnData;
+using ui::ListCtrlSubItemData2;
+
+namespace {
+
+DString MakeText(const DString& prefix, size_t nIndex)
+{
+    return prefix + ui::StringUtil::UInt64ToString(nIndex);
+}
+
+} // namespace
+
+TEST(ListCtrlColumnDataTest, EmptyRowsHaveNoData)
+{
+    ListCtrlColumnData columnData;
+    columnData.Resize(3);
+    EXPECT_EQ(columnData.GetCount(), 3u);
+    for (size_t i = 0; i < 3; ++i) {
+        EXPECT_FALSE(columnData.HasData(i));
+        EXPECT_STREQ(columnData.GetText(i), _T(""));
+        EXPECT_EQ(columnData.GetTextLength(i), 0u);
+        EXPECT_FALSE(columnData.IsShowCheckBox(i));
+        EXPECT_EQ(columnData.GetExtraData(i).nImageId, -1);
+        ListCtrlSubItemData2 data;
+        EXPECT_FALSE(columnData.GetData(i, data));
+    }
+}
+
+TEST(ListCtrlColumnDataTest, SetTextReusesAndGrows)
+{
+    ListCtrlColumnData columnData;
+    columnData.Resize(2);
+    EXPECT_TRUE(columnData.SetText(0, _T("hello"), 5));
+    EXPECT_FALSE(columnData.SetText(0, _T("hello"), 5));
+    EXPECT_TRUE(columnData.HasData(0));
+    EXPECT_FALSE(columnData.HasData(1));
+    EXPECT_STREQ(columnData.GetText(0), _T("hello"));
+
+    //变短：原位置覆盖
+    EXPECT_TRUE(columnData.SetText(0, _T("hi"), 2));
+    EXPECT_STREQ(columnData.GetText(0), _T("hi"));
+    EXPECT_EQ(columnData.GetTextLength(0), 2u);
+
+    //变长：追加
+    EXPECT_TRUE(columnData.SetText(0, _T("hello world"), 11));
+    EXPECT_STREQ(columnData.GetText(0), _T("hello world"));
+
+    EXPECT_TRUE(columnData.SetText(0, _T(""), 0));
+    EXPECT_STREQ(columnData.GetText(0), _T(""));
+    EXPECT_TRUE(columnData.HasData(0));
+}
+
+TEST(ListCtrlColumnDataTest, SetDataRoundTrip)
+{
+    ListCtrlColumnData columnData;
+    columnData.Resize(1);
+    ListCtrlSubItemData2 data;
+    data.text = _T("text");
+    data.bShowCheckBox = true;
+    data.bChecked = true;
+    data.userDataN = 42;
+    data.userDataS = _T("user");
+    data.nImageId = 3;
+    data.nSortGroup = 2;
+    EXPECT_TRUE(columnData.SetData(0, data));
+
+    ListCtrlSubItemData2 result;
+    ASSERT_TRUE(columnData.GetData(0, result));
+    EXPECT_STREQ(result.text.c_str(), _T("text"));
+    EXPECT_TRUE(result.bShowCheckBox);
+    EXPECT_TRUE(result.bChecked);
+    EXPECT_FALSE(result.bEditable);
+    EXPECT_EQ(result.userDataN, 42u);
+    EXPECT_STREQ(result.userDataS.c_str(), _T("user"));
+    EXPECT_EQ(result.nImageId, 3);
+    EXPECT_EQ(result.nSortGroup, 2);
+
+    //恢复默认值后，附加数据被释放，勾选状态变化
+    EXPECT_TRUE(columnData.SetData(0, ListCtrlSubItemData2()));
+    EXPECT_EQ(columnData.GetExtraData(0).userDataN, 0u);
+    EXPECT_FALSE(columnData.IsChecked(0));
+    EXPECT_TRUE(columnData.HasData(0));
+}
+
+TEST(ListCtrlColumnDataTest, ExtraDataIsReleasedWhenDefault)
+{
+    ListCtrlColumnData columnData;
+    columnData.Resize(2);
+    columnData.GetExtraDataForWrite(0).userDataN = 7;
+    columnData.GetExtraDataForWrite(1).nImageId = 5;
+    EXPECT_EQ(columnData.GetExtraData(0).userDataN, 7u);
+    columnData.GetExtraDataForWrite(0).userDataN = 0;
+    columnData.ReleaseDefaultExtraData(0);
+    EXPECT_EQ(columnData.GetExtraData(0).userDataN, 0u);
+    EXPECT_EQ(columnData.GetExtraData(1).nImageId, 5);
+
+    //释放的编号可重用，不影响其他行
+    columnData.GetExtraDataForWrite(0).nSortGroup = 9;
+    EXPECT_EQ(columnData.GetExtraData(0).nSortGroup, 9);
+    EXPECT_EQ(columnData.GetExtraData(0).nImageId, -1);
+    EXPECT_EQ(columnData.GetExtraData(1).nImageId, 5);
+}
+
+TEST(ListCtrlColumnDataTest, FlagsAreIndependent)
+{
+    ListCtrlColumnData columnData;
+    columnData.Resize(1);
+    EXPECT_TRUE(columnData.SetShowCheckBox(0, true));
+    EXPECT_FALSE(columnData.SetShowCheckBox(0, true));
+    EXPECT_TRUE(columnData.SetChecked(0, true));
+    EXPECT_TRUE(columnData.SetEditable(0, true));
+    EXPECT_TRUE(columnData.SetChecked(0, false));
+    EXPECT_TRUE(columnData.IsShowCheckBox(0));
+    EXPECT_FALSE(columnData.IsChecked(0));
+    EXPECT_TRUE(columnData.IsEditable(0));
+}
+
+TEST(ListCtrlColumnDataTest, InsertEraseReorder)
+{
+    ListCtrlColumnData columnData;
+    columnData.Resize(3);
+    for (size_t i = 0; i < 3; ++i) {
+        const DString text = MakeText(_T("row"), i);
+        columnData.SetText(i, text.c_str(), text.size());
+        columnData.GetExtraDataForWrite(i).userDataN = i;
+    }
+    columnData.Insert(1);
+    ASSERT_EQ(columnData.GetCount(), 4u);
+    EXPECT_FALSE(columnData.HasData(1));
+    EXPECT_STREQ(columnData.GetText(2), _T("row1"));
+
+    columnData.Erase(0);
+    ASSERT_EQ(columnData.GetCount(), 3u);
+    EXPECT_FALSE(columnData.HasData(0));
+    EXPECT_STREQ(columnData.GetText(1), _T("row1"));
+    EXPECT_STREQ(columnData.GetText(2), _T("row2"));
+
+    columnData.Reorder({ 2, 0, 1 });
+    EXPECT_STREQ(columnData.GetText(0), _T("row2"));
+    EXPECT_EQ(columnData.GetExtraData(0).userDataN, 2u);
+    EXPECT_FALSE(columnData.HasData(1));
+    EXPECT_STREQ(columnData.GetText(2), _T("row1"));
+    EXPECT_EQ(columnData.GetExtraData(2).userDataN, 1u);
+
+    columnData.Clear();
+    EXPECT_EQ(columnData.GetCount(), 0u);
+}
+
+TEST(ListCtrlColumnDataTest, TextPoolCompaction)
+{
+    const size_t nCount = 1000;
+    ListCtrlColumnData columnData;
+    columnData.Resize(nCount);
+    //反复修改为更长的文本，产生大量无用的字符，触发整理字符池
+    for (size_t round = 0; round < 50; ++round) {
+        DString prefix(round + 1, _T('x'));
+        for (size_t i = 0; i < nCount; ++i) {
+            const DString text = MakeText(prefix, i);
+            columnData.SetText(i, text.c_str(), text.size());
+        }
+    }
+    DString prefix(50, _T('x'));
+    for (size_t i = 0; i < nCount; ++i) {
+        EXPECT_EQ(DString(columnData.GetText(i)), MakeText(prefix, i));
+    }
+}
@@ -0,0 +1,191 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "duilib/Control/ListCtrlColumnData.h"
+
+using ui::ListCtrlColumnData;
+
+namespace {
+
+void SetTexts(ListCtrlColumnData& columnData, const std::vector<DString>& texts)
+{
+    columnData.Resize(texts.size());
+    for (size_t i = 0; i < texts.size(); ++i) {
+        columnData.SetText(i, texts[i].c_str(), texts[i].size());
+    }
+}
+
+std::vector<size_t> Find(ListCtrlColumnData& columnData, const DString& filterText, bool bMatchPrefix = false)
+{
+    std::vector<size_t> itemIndexs;
+    columnData.FindText(filterText, bMatchPrefix, itemIndexs);
+    return itemIndexs;
+}
+
+/** 直接逐行比较的结果，用于校验索引的查询结果
+*/
+std::vector<size_t> FindByScan(const ListCtrlColumnData& columnData, const DString& filterText, bool bMatchPrefix = false)
+{
+    DString folded = filterText;
+    for (auto& ch : folded) {
+        ch = ui::ListCtrlTextIndex::FoldChar(ch);
+    }
+    std::vector<size_t> itemIndexs;
+    for (size_t i = 0; i < columnData.GetCount(); ++i) {
+        DString text = columnData.GetText(i);
+        for (auto& ch : text) {
+            ch = ui::ListCtrlTextIndex::FoldChar(ch);
+        }
+        if (bMatchPrefix ? (text.compare(0, folded.size(), folded) == 0) : (text.find(folded) != DString::npos)) {
+            itemIndexs.push_back(i);
+        }
+    }
+    return itemIndexs;
+}
+
+} // namespace
+
+TEST(ListCtrlTextIndexTest, ContainsAndPrefix)
+{
+    ListCtrlColumnData columnData;
+    SetTexts(columnData, { _T("Error: disk full"), _T("info: started"), _T("ERROR: timeout"), _T(""), _T("warning") });
+    EXPECT_EQ(Find(columnData, _T("error")), (std::vector<size_t>{ 0, 2 }));
+    EXPECT_EQ(Find(columnData, _T("r")), (std::vector<size_t>{ 0, 1, 2, 4 }));
+    EXPECT_EQ(Find(columnData, _T("ar")), (std::vector<size_t>{ 1, 4 }));
+    EXPECT_EQ(Find(columnData, _T("in"), true), (std::vector<size_t>{ 1 }));
+    EXPECT_EQ(Find(columnData, _T("xyz")), (std::vector<size_t>{}));
+    EXPECT_EQ(Find(columnData, _T("")), (std::vector<size_t>{ 0, 1, 2, 3, 4 }));
+}
+
+TEST(ListCtrlTextIndexTest, TypeAheadNarrowsAndWidens)
+{
+    ListCtrlColumnData columnData;
+    SetTexts(columnData, { _T("apple"), _T("application"), _T("banana"), _T("grape"), _T("pineapple") });
+    EXPECT_EQ(Find(columnData, _T("a")), (std::vector<size_t>{ 0, 1, 2, 3, 4 }));
+    EXPECT_EQ(Find(columnData, _T("ap")), (std::vector<size_t>{ 0, 1, 3, 4 }));
+    EXPECT_EQ(Find(columnData, _T("app")), (std::vector<size_t>{ 0, 1, 4 }));
+    EXPECT_EQ(Find(columnData, _T("appl")), (std::vector<size_t>{ 0, 1, 4 }));
+    EXPECT_EQ(Find(columnData, _T("appli")), (std::vector<size_t>{ 1 }));
+    //删除字符：不能使用上次的结果
+    EXPECT_EQ(Find(columnData, _T("pp")), (std::vector<size_t>{ 0, 1, 4 }));
+    EXPECT_EQ(Find(columnData, _T("ap"), true), (std::vector<size_t>{ 0, 1 }));
+    EXPECT_EQ(Find(columnData, _T("app"), true), (std::vector<size_t>{ 0, 1 }));
+}
+
+TEST(ListCtrlTextIndexTest, UpdatedIncrementally)
+{
+    ListCtrlColumnData columnData;
+    SetTexts(columnData, { _T("alpha"), _T("beta"), _T("gamma") });
+    EXPECT_EQ(Find(columnData, _T("ta")), (std::vector<size_t>{ 1 }));
+
+    //修改文本
+    const DString text = _T("delta");
+    columnData.SetText(0, text.c_str(), text.size());
+    EXPECT_EQ(Find(columnData, _T("ta")), (std::vector<size_t>{ 0, 1 }));
+    EXPECT_EQ(Find(columnData, _T("alp")), (std::vector<size_t>{}));
+
+    //插入、删除、调整顺序
+    columnData.Insert(0);
+    const DString text2 = _T("theta");
+    columnData.SetText(0, text2.c_str(), text2.size());
+    EXPECT_EQ(Find(columnData, _T("ta")), (std::vector<size_t>{ 0, 1, 2 }));
+    columnData.Erase(2);
+    EXPECT_EQ(Find(columnData, _T("ta")), (std::vector<size_t>{ 0, 1 }));
+    columnData.Reorder({ 2, 1, 0 });
+    EXPECT_EQ(Find(columnData, _T("ta")), (std::vector<size_t>{ 1, 2 }));
+    EXPECT_EQ(Find(columnData, _T("gam")), (std::vector<size_t>{ 0 }));
+
+    //删除后重用的编号不能匹配旧文本
+    columnData.Erase(1);
+    columnData.Resize(3);
+    EXPECT_EQ(Find(columnData, _T("del")), (std::vector<size_t>{}));
+    EXPECT_EQ(Find(columnData, _T("the")), (std::vector<size_t>{ 1 }));
+
+    columnData.Clear();
+    EXPECT_EQ(Find(columnData, _T("ta")), (std::vector<size_t>{}));
+}
+
+TEST(ListCtrlTextIndexTest, MatchesLinearScan)
+{
+    ListCtrlColumnData columnData;
+    std::vector<DString> texts;
+    uint32_t nSeed = 7;
+    for (size_t i = 0; i < 5000; ++i) {
+        DString text;
+        for (size_t n = 0; n < 12; ++n) {
+            nSeed = nSeed * 1103515245u + 12345u;
+            text.push_back((DString::value_type)(((nSeed >> 16) % 2) ? _T('a') : _T('A')) + (DString::value_type)((nSeed >> 20) % 6));
+        }
+        texts.push_back(text);
+    }
+    SetTexts(columnData, texts);
+    //反复修改文本，产生索引中的无效记录
+    for (size_t round = 0; round < 3; ++round) {
+        for (size_t i = round; i < texts.size(); i += 3) {
+            std::reverse(texts[i].begin(), texts[i].end());
+            columnData.SetText(i, texts[i].c_str(), texts[i].size());
+        }
+    }
+    for (const DString& filterText : { DString(_T("a")), DString(_T("Bc")), DString(_T("abc")),
+                                      DString(_T("ffe")), DString(_T("abcdef")) }) {
+        EXPECT_EQ(Find(columnData, filterText), FindByScan(columnData, filterText));
+    }
+    columnData.SetTextIndexEnabled(false);
+    EXPECT_FALSE(columnData.IsTextIndexEnabled());
+    EXPECT_EQ(Find(columnData, _T("abc")), FindByScan(columnData, _T("abc")));
+    EXPECT_TRUE(columnData.IsTextIndexEnabled());
+}
+
+TEST(ListCtrlTextIndexTest, RepeatedGramsAndReorderMatchLinearScan)
+{
+    //文本中有重复的二元组、非ASCII字符，以及超过位置记录范围的长文本
+    const DString::value_type chars[] = { _T('a'), _T('B'), _T('c'), _T(' '), (DString::value_type)0xC3 };
+    ListCtrlColumnData columnData;
+    std::vector<DString> texts;
+    uint32_t nSeed = 11;
+    for (size_t i = 0; i < 3000; ++i) {
+        nSeed = nSeed * 1103515245u + 12345u;
+        DString text;
+        const size_t nLength = 1 + (nSeed >> 16) % 40;
+        for (size_t n = 0; n < nLength; ++n) {
+            nSeed = nSeed * 1103515245u + 12345u;
+            text.push_back(chars[(nSeed >> 16) % (sizeof(chars) / sizeof(chars[0]))]);
+        }
+        texts.push_back(text);
+    }
+    texts.push_back(DString(40000, _T('a')) + _T("bcb"));
+    SetTexts(columnData, texts);
+
+    const std::vector<DString> filters = { _T("a"), _T("b"), _T(" "), DString(1, chars[4]), _T("ab"), _T("aba"),
+                                           _T("abab"), _T("bcb"), _T("c a"), DString(_T("a")) + chars[4] + _T("b") };
+    for (const DString& filterText : filters) {
+        EXPECT_EQ(Find(columnData, filterText), FindByScan(columnData, filterText));
+        EXPECT_EQ(Find(columnData, filterText, true), FindByScan(columnData, filterText, true));
+    }
+
+    //调整行的顺序并修改部分文本后，结果仍按行号排列
+    std::vector<size_t> orders(texts.size());
+    for (size_t i = 0; i < orders.size(); ++i) {
+        orders[i] = i;
+    }
+    for (size_t i = orders.size() - 1; i > 0; --i) {
+        nSeed = nSeed * 1103515245u + 12345u;
+        std::swap(orders[i], orders[(nSeed >> 16) % (i + 1)]);
+    }
+    columnData.Reorder(orders);
+    for (size_t i = 0; i < texts.size(); i += 7) {
+        const DString text = _T("xx") + DString(columnData.GetText(i), columnData.GetTextLength(i)) + _T("ab");
+        columnData.SetText(i, text.c_str(), text.size());
+    }
+    for (const DString& filterText : filters) {
+        EXPECT_EQ(Find(columnData, filterText), FindByScan(columnData, filterText));
+        EXPECT_EQ(Find(columnData, filterText, true), FindByScan(columnData, filterText, true));
+    }
+
+    //逐字输入
+    for (const DString& filterText : { DString(_T("a")), DString(_T("ab")), DString(_T("abc")), DString(_T("abca")) }) {
+        EXPECT_EQ(Find(columnData, filterText), FindByScan(columnData, filterText));
+    }
+}
@@ -0,0 +1,361 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "duilib/Control/RichEditData.h"
+#include "TestRender.h"
+
+using ui::RichEditData;
+using ui::test::TestRender;
+using ui::test::TestRenderFactory;
+
+namespace {
+
+/** 不绘制文本的测试实现：生成格式文本的方式与RichEdit相同（每个物理行一条数据），配合TestRender计算文字区域
+*/
+class TestRichTextData: public ui::IRichTextData
+{
+public:
+    bool GetRichTextForDraw(const std::vector<std::wstring_view>& textView,
+                            std::vector<ui::RichTextData>& richTextDataList,
+                            size_t nStartLine,
+                            const std::vector<size_t>& modifiedLines) const override
+    {
+        richTextDataList.clear();
+        ui::RichTextData richTextData;
+        if (nStartLine != (size_t)-1) {
+            //增量计算，只生成修改的行
+            for (size_t nLine : modifiedLines) {
+                if (nLine >= textView.size()) {
+                    return false;
+                }
+                richTextData.m_textView = textView[nLine];
+                richTextDataList.push_back(richTextData);
+            }
+        }
+        else {
+            for (const std::wstring_view& lineText : textView) {
+                richTextData.m_textView = lineText;
+                richTextDataList.push_back(richTextData);
+            }
+        }
+        return !richTextDataList.empty();
+    }
+    ui::UiRect GetRichTextDrawRect() const override { return ui::UiRect(0, 0, 400, 300); }
+    uint8_t GetDrawAlpha() const override { return 255; }
+    void OnTextRectsChanged() override {}
+    int32_t GetTextRowHeight() const override { return 16; }
+    int32_t GetTextCaretWidth() const override { return 1; }
+    bool IsTextPasswordMode() const override { return false; }
+    void ReplacePasswordChar(DStringW& /*text*/) const override {}
+    int32_t GetTextLimitLength() const override { return 0; }
+    void OnTextRectsPending() override { ++m_nPendingCount; }
+
+    //通知分段计算的次数
+    int32_t m_nPendingCount = 0;
+};
+
+DStringW MakeLines(size_t nLineCount, const DStringW& prefix)
+{
+    DStringW text;
+    for (size_t i = 0; i < nLineCount; ++i) {
+        text += prefix + std::to_wstring(i) + L"\n";
+    }
+    return text;
+}
+
+/** 与RichEdit一样设置测量接口，使用多行模式
+*/
+void InitMeasuredData(RichEditData& data, TestRender& render, TestRenderFactory& renderFactory)
+{
+    data.SetSingleLineMode(false);
+    data.SetRender(&render);
+    data.SetRenderFactory(&renderFactory);
+}
+
+/** 分段计算的测试文本：30000行，超过256K个字符
+*/
+DStringW MakeLongText()
+{
+    const DStringW text = MakeLines(30000, L"long line ");
+    EXPECT_GE(text.size(), (size_t)256 * 1024);
+    return text;
+}
+
+/** 计算完所有尚未计算的行，返回分段的个数
+*/
+size_t CalcAllPendingTextRects(RichEditData& data)
+{
+    size_t nSegments = 0;
+    while (data.CalcPendingTextRects()) {
+        ++nSegments;
+    }
+    return nSegments;
+}
+
+/** 检查行数据的一致性：每个物理行一个逻辑行，行号与行的纵坐标对应，行文本与原文本相同
+*/
+void CheckRows(RichEditData& data, const DStringW& text, const std::vector<int32_t>& checkRows)
+{
+    const int32_t nLineCount = (int32_t)std::count(text.begin(), text.end(), L'\n') + ((text.back() != L'\n') ? 1 : 0);
+    ASSERT_EQ(data.GetRowCount(), nLineCount);
+    for (int32_t nRow : checkRows) {
+        ASSERT_LT(nRow, nLineCount);
+        const int32_t nRowStartChar = data.RowIndex(nRow);
+        ASSERT_GE(nRowStartChar, 0);
+        size_t nLineEnd = text.find(L'\n', (size_t)nRowStartChar);
+        nLineEnd = (nLineEnd == DStringW::npos) ? text.size() : (nLineEnd + 1);
+        EXPECT_EQ(data.GetRowText(nRow), text.substr((size_t)nRowStartChar, nLineEnd - (size_t)nRowStartChar)) << "row: " << nRow;
+        EXPECT_EQ(data.RowFromChar(nRowStartChar), nRow);
+        EXPECT_EQ(data.GetCharRowRect(nRowStartChar).top, (int32_t)(nRow * TestRender::kRowHeight)) << "row: " << nRow;
+    }
+}
+
+} // namespace
+
+TEST(RichEditDataTest, ReplaceTextKeepsLinesAndLength)
+{
+    TestRichTextData richText;
+    RichEditData data(&richText);
+    data.SetSingleLineMode(false);
+    DStringW expected = MakeLines(100, L"line");
+    ASSERT_TRUE(data.SetText(expected));
+    EXPECT_EQ(data.GetTextLength(), expected.size());
+
+    //在不同位置插入、删除、替换，与std::wstring的结果比较
+    const int32_t nPositions[] = { 0, 7, 250, 500, -30 };
+    for (int32_t nPos : nPositions) {
+        if (nPos < 0) {
+            nPos += (int32_t)expected.size();
+        }
+        ASSERT_TRUE(data.ReplaceText(nPos, nPos, L"ab\ncd"));
+        expected.insert((size_t)nPos, L"ab\ncd");
+        ASSERT_TRUE(data.ReplaceText(nPos + 1, nPos + 20, L"X"));
+        expected.replace((size_t)nPos + 1, 19, L"X");
+        EXPECT_EQ(data.GetText(), expected);
+        EXPECT_EQ(data.GetTextLength(), expected.size());
+    }
+    EXPECT_EQ(data.GetTextRange(3, 40), expected.substr(3, 37));
+    ASSERT_TRUE(data.ReplaceText(0, (int32_t)expected.size(), L""));
+    EXPECT_TRUE(data.IsEmpty());
+}
+
+TEST(RichEditDataTest, UndoRedoLargeAndSmallEdits)
+{
+    TestRichTextData richText;
+    RichEditData data(&richText);
+    data.SetSingleLineMode(false);
+    const DStringW original = MakeLines(2000, L"log entry ");
+    ASSERT_TRUE(data.SetText(original));
+
+    //删除大段文本（Undo数据引用行数据）
+    ASSERT_TRUE(data.ReplaceText(100, 20000, L""));
+    DStringW afterDelete = original;
+    afterDelete.erase(100, 19900);
+    //粘贴大段文本
+    const DStringW paste = MakeLines(500, L"pasted ");
+    ASSERT_TRUE(data.ReplaceText(50, 50, paste));
+    DStringW afterPaste = afterDelete;
+    afterPaste.insert(50, paste);
+    //输入少量文本
+    ASSERT_TRUE(data.ReplaceText(10, 12, L"xyz"));
+    DStringW afterTyping = afterPaste;
+    afterTyping.replace(10, 2, L"xyz");
+    EXPECT_EQ(data.GetText(), afterTyping);
+
+    int32_t nEndChar = 0;
+    ASSERT_TRUE(data.Undo(nEndChar));
+    EXPECT_EQ(data.GetText(), afterPaste);
+    ASSERT_TRUE(data.Undo(nEndChar));
+    EXPECT_EQ(data.GetText(), afterDelete);
+    ASSERT_TRUE(data.Undo(nEndChar));
+    EXPECT_EQ(data.GetText(), original);
+    EXPECT_EQ(nEndChar, 20000);
+    EXPECT_FALSE(data.CanUndo());
+
+    ASSERT_TRUE(data.Redo(nEndChar));
+    EXPECT_EQ(data.GetText(), afterDelete);
+    ASSERT_TRUE(data.Redo(nEndChar));
+    EXPECT_EQ(data.GetText(), afterPaste);
+    EXPECT_EQ(nEndChar, 50 + (int32_t)paste.size());
+    ASSERT_TRUE(data.Redo(nEndChar));
+    EXPECT_EQ(data.GetText(), afterTyping);
+    EXPECT_EQ(data.GetTextLength(), afterTyping.size());
+}
+
+TEST(RichEditDataTest, LongTextLeavesLinesPending)
+{
+    TestRichTextData richText;
+    TestRender render;
+    TestRenderFactory renderFactory;
+    RichEditData data(&richText);
+    InitMeasuredData(data, render, renderFactory);
+
+    //较短的文本，一次计算完成
+    const DStringW shortText = MakeLines(1000, L"short line ");
+    ASSERT_TRUE(data.SetText(shortText));
+    data.CheckCalcTextRects();
+    EXPECT_FALSE(data.IsTextRectsPending());
+    EXPECT_EQ(richText.m_nPendingCount, 0);
+    EXPECT_EQ(render.m_measuredLines.size(), (size_t)1000);
+
+    //超过256K个字符，只计算首段，其余的行使用估算的行数据
+    const DStringW text = MakeLongText();
+    render.m_measuredLines.clear();
+    ASSERT_TRUE(data.SetText(text));
+    data.CheckCalcTextRects();
+    ASSERT_TRUE(data.IsTextRectsPending());
+    EXPECT_EQ(richText.m_nPendingCount, 1);
+    const size_t nFirstLines = data.GetCalcTextRectsLineCount();
+    EXPECT_GT(nFirstLines, (size_t)(300 / TestRender::kRowHeight));
+    EXPECT_LT(nFirstLines, (size_t)30000);
+    EXPECT_EQ(render.m_measuredLines.size(), nFirstLines);
+    EXPECT_EQ(render.m_measuredLines.back(), nFirstLines - 1);
+    //估算的行与计算过的行，行号和坐标连续
+    CheckRows(data, text, { 0, (int32_t)nFirstLines - 1, (int32_t)nFirstLines, 29999 });
+
+    //逐段计算，直到所有的行都计算完成
+    const size_t nSegments = CalcAllPendingTextRects(data);
+    EXPECT_GT(nSegments, (size_t)0);
+    EXPECT_FALSE(data.IsTextRectsPending());
+    EXPECT_EQ(data.GetCalcTextRectsLineCount(), (size_t)30000);
+    //Debug版本中，增量计算后会完整计算一次用于比较，所以只检查每行都计算过
+    const std::set<size_t> measuredLines(render.m_measuredLines.begin(), render.m_measuredLines.end());
+    EXPECT_EQ(measuredLines.size(), (size_t)30000);
+    CheckRows(data, text, { 0, (int32_t)nFirstLines, 15000, 29999 });
+    EXPECT_EQ(data.PosFromChar(data.RowIndex(29999) + 3).x, (int32_t)(3 * TestRender::kCharWidth));
+}
+
+TEST(RichEditDataTest, EditPastMeasuredLinesCalcsPendingLines)
+{
+    TestRichTextData richText;
+    TestRender render;
+    TestRenderFactory renderFactory;
+    RichEditData data(&richText);
+    InitMeasuredData(data, render, renderFactory);
+
+    DStringW text = MakeLongText();
+    ASSERT_TRUE(data.SetText(text));
+    data.CheckCalcTextRects();
+    ASSERT_TRUE(data.IsTextRectsPending());
+    const size_t nFirstLines = data.GetCalcTextRectsLineCount();
+
+    //修改尚未计算的行：先计算到修改的行为止
+    const size_t nEditLine = nFirstLines + 5000;
+    const int32_t nEditChar = data.RowIndex((int32_t)nEditLine) + 2;
+    render.m_measuredLines.clear();
+    ASSERT_TRUE(data.ReplaceText(nEditChar, nEditChar, L"edit"));
+    text.insert((size_t)nEditChar, L"edit");
+    EXPECT_TRUE(data.IsTextRectsPending());
+    EXPECT_GE(data.GetCalcTextRectsLineCount(), nEditLine + 1);
+    EXPECT_LT(data.GetCalcTextRectsLineCount(), (size_t)30000);
+    ASSERT_FALSE(render.m_measuredLines.empty());
+    EXPECT_EQ(render.m_measuredLines.front(), nFirstLines);
+    EXPECT_TRUE(std::find(render.m_measuredLines.begin(), render.m_measuredLines.end(), nEditLine) != render.m_measuredLines.end());
+    EXPECT_EQ(data.GetText(), text);
+    CheckRows(data, text, { (int32_t)nEditLine, (int32_t)data.GetCalcTextRectsLineCount(), 29999 });
+    EXPECT_EQ(data.PosFromChar(nEditChar + 4).x, (int32_t)((2 + 4) * TestRender::kCharWidth));
+
+    //修改已经计算的行，不再计算后面的行
+    render.m_measuredLines.clear();
+    const size_t nCalcLines = data.GetCalcTextRectsLineCount();
+    ASSERT_TRUE(data.ReplaceText(0, 0, L"x"));
+    text.insert(0, L"x");
+    EXPECT_EQ(data.GetCalcTextRectsLineCount(), nCalcLines);
+    EXPECT_EQ(render.m_measuredLines, std::vector<size_t>{ 0 });
+}
+
+TEST(RichEditDataTest, PendingLineCountAfterInsertAndDelete)
+{
+    TestRichTextData richText;
+    TestRender render;
+    TestRenderFactory renderFactory;
+    RichEditData data(&richText);
+    InitMeasuredData(data, render, renderFactory);
+
+    DStringW text = MakeLongText();
+    ASSERT_TRUE(data.SetText(text));
+    data.CheckCalcTextRects();
+    ASSERT_TRUE(data.IsTextRectsPending());
+    size_t nCalcLines = data.GetCalcTextRectsLineCount();
+
+    //在已计算的行中插入多行：已计算的行数随之增加
+    const DStringW insertText = L"a\nb\nc\n";
+    ASSERT_TRUE(data.ReplaceText(10, 10, insertText));
+    text.insert(10, insertText);
+    EXPECT_TRUE(data.IsTextRectsPending());
+    EXPECT_EQ(data.GetCalcTextRectsLineCount(), nCalcLines + 3);
+    nCalcLines = data.GetCalcTextRectsLineCount();
+    CheckRows(data, text, { 0, 1, 3, (int32_t)nCalcLines - 1, (int32_t)nCalcLines, 30002 });
+
+    //删除跨越多行的文本：已计算的行数随之减少
+    const int32_t nDeleteStart = data.RowIndex(20);
+    const int32_t nDeleteEnd = data.RowIndex(30);
+    ASSERT_TRUE(data.ReplaceText(nDeleteStart, nDeleteEnd, L""));
+    text.erase((size_t)nDeleteStart, (size_t)(nDeleteEnd - nDeleteStart));
+    EXPECT_EQ(data.GetCalcTextRectsLineCount(), nCalcLines - 10);
+    nCalcLines = data.GetCalcTextRectsLineCount();
+    CheckRows(data, text, { 19, 20, (int32_t)nCalcLines - 1, (int32_t)nCalcLines, 29992 });
+
+    //从已计算的行删除到尚未计算的行：先计算到删除的结束行
+    const int32_t nLastLine = 29992;
+    const int32_t nLongDeleteStart = data.RowIndex(100);
+    const int32_t nLongDeleteEnd = data.RowIndex(nLastLine - 100);
+    ASSERT_TRUE(data.ReplaceText(nLongDeleteStart, nLongDeleteEnd, L"joined "));
+    text.replace((size_t)nLongDeleteStart, (size_t)(nLongDeleteEnd - nLongDeleteStart), L"joined ");
+    EXPECT_EQ(data.GetText(), text);
+    EXPECT_EQ(data.GetTextLength(), text.size());
+    CheckRows(data, text, { 99, 100, 101, 200 });
+
+    //剩余的行计算完成后，与原文本一致
+    CalcAllPendingTextRects(data);
+    EXPECT_FALSE(data.IsTextRectsPending());
+    CheckRows(data, text, { 0, 100, 200 });
+    int32_t nEndChar = 0;
+    ASSERT_TRUE(data.Undo(nEndChar));
+    ASSERT_TRUE(data.Undo(nEndChar));
+    ASSERT_TRUE(data.Undo(nEndChar));
+    EXPECT_EQ(data.GetText(), MakeLongText());
+}
+
+TEST(RichEditDataTest, SetTextAndClearCancelPendingLines)
+{
+    TestRichTextData richText;
+    TestRender render;
+    TestRenderFactory renderFactory;
+    RichEditData data(&richText);
+    InitMeasuredData(data, render, renderFactory);
+
+    const DStringW text = MakeLongText();
+    ASSERT_TRUE(data.SetText(text));
+    data.CheckCalcTextRects();
+    ASSERT_TRUE(data.IsTextRectsPending());
+
+    //设置短文本：取消分段计算，不再计算原文本的行
+    const DStringW shortText = MakeLines(10, L"short ");
+    ASSERT_TRUE(data.SetText(shortText));
+    EXPECT_FALSE(data.IsTextRectsPending());
+    EXPECT_FALSE(data.CalcPendingTextRects());
+    CheckRows(data, shortText, { 0, 9 });
+    EXPECT_FALSE(data.IsTextRectsPending());
+
+    //清空：取消分段计算
+    ASSERT_TRUE(data.SetText(text));
+    data.CheckCalcTextRects();
+    ASSERT_TRUE(data.IsTextRectsPending());
+    data.Clear();
+    EXPECT_FALSE(data.IsTextRectsPending());
+    EXPECT_EQ(data.GetCalcTextRectsLineCount(), (size_t)0);
+    render.m_measuredLines.clear();
+    EXPECT_FALSE(data.CalcPendingTextRects());
+    EXPECT_TRUE(render.m_measuredLines.empty());
+    EXPECT_EQ(data.GetRowCount(), 0);
+
+    //重新设置长文本：重新开始分段计算
+    ASSERT_TRUE(data.SetText(text));
+    data.CheckCalcTextRects();
+    EXPECT_TRUE(data.IsTextRectsPending());
+    EXPECT_EQ(richText.m_nPendingCount, 3);
+}
@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+#include <memory>
+
+#include "duilib/Core/ControlFinder.h"
+#include "duilib/Core/Box.h"
+#include "duilib/Core/Control.h"
+
+using ui::Box;
+using ui::Control;
+using ui::ControlFinder;
+
+namespace {
+
+/** 创建控件并添加到容器中（与Window::InitControls一样，同时添加到ControlFinder）
+*/
+template<typename T>
+T* AddNamedItem(ControlFinder& finder, Box* pParent, const DString& name, size_t nIndex = (size_t)-1)
+{
+    T* pControl = new T(nullptr);
+    pControl->SetName(name);
+    if (nIndex == (size_t)-1) {
+        pParent->AddItem(pControl);
+    }
+    else {
+        pParent->AddItemAt(pControl, nIndex);
+    }
+    finder.AddControl(pControl);
+    return pControl;
+}
+
+} // namespace
+
+TEST(ControlFinderTest, ScopedNameIndexHit)
+{
+    ControlFinder finder;
+    std::unique_ptr<Box> spRoot(new Box(nullptr));
+    finder.SetRoot(spRoot.get());
+    Box* pItem = AddNamedItem<Box>(finder, spRoot.get(), _T("item"));
+    Control* pLabel = AddNamedItem<Control>(finder, pItem, _T("label"));
+    AddNamedItem<Control>(finder, spRoot.get(), _T("label"));
+
+    //首次查找后记录在索引中，再次查找时结果不变
+    EXPECT_EQ(finder.FindSubControlByName(pItem, _T("label")), pLabel);
+    EXPECT_EQ(finder.FindSubControlByName(pItem, _T("label")), pLabel);
+    EXPECT_EQ(finder.FindSubControlByName(pItem, _T("label")), finder.FindSubControlByNameNoScope(pItem, _T("label")));
+    EXPECT_EQ(finder.FindSubControlByName(pItem, _T("missing")), nullptr);
+
+    //名称修改后，索引中的记录失效
+    pLabel->SetName(_T("label2"));
+    EXPECT_EQ(finder.FindSubControlByName(pItem, _T("label")), nullptr);
+    finder.Clear();
+}
+
+TEST(ControlFinderTest, ScopedNameIndexStaleAfterRemove)
+{
+    ControlFinder finder;
+    std::unique_ptr<Box> spRoot(new Box(nullptr));
+    finder.SetRoot(spRoot.get());
+    Box* pItem = AddNamedItem<Box>(finder, spRoot.get(), _T("item"));
+    Control* pLabel = AddNamedItem<Control>(finder, pItem, _T("label"));
+    EXPECT_EQ(finder.FindSubControlByName(pItem, _T("label")), pLabel);
+
+    //控件销毁后，不返回索引中的记录
+    finder.RemoveControl(pLabel);
+    EXPECT_TRUE(pItem->RemoveItem(pLabel));
+    EXPECT_EQ(finder.FindSubControlByName(pItem, _T("label")), nullptr);
+
+    //添加新的同名控件后，返回新的控件
+    Control* pNewLabel = AddNamedItem<Control>(finder, pItem, _T("label"));
+    EXPECT_EQ(finder.FindSubControlByName(pItem, _T("label")), pNewLabel);
+
+    //控件移动到其他容器后，不返回索引中的记录
+    Box* pOther = AddNamedItem<Box>(finder, spRoot.get(), _T("other"));
+    pItem->SetAutoDestroyChild(false);
+    EXPECT_TRUE(pItem->RemoveItem(pNewLabel));
+    pOther->AddItem(pNewLabel);
+    EXPECT_EQ(finder.FindSubControlByName(pItem, _T("label")), nullptr);
+    EXPECT_EQ(finder.FindSubControlByName(pOther, _T("label")), pNewLabel);
+
+    //父祖控件销毁后，删除其索引
+    finder.RemoveControl(pItem);
+    EXPECT_TRUE(spRoot->RemoveItem(pItem));
+    finder.Clear();
+}
+
+TEST(ControlFinderTest, ScopedNameIndexDuplicateNameOrder)
+{
+    ControlFinder finder;
+    std::unique_ptr<Box> spRoot(new Box(nullptr));
+    finder.SetRoot(spRoot.get());
+    Box* pItem = AddNamedItem<Box>(finder, spRoot.get(), _T("item"));
+    Box* pSecond = AddNamedItem<Box>(finder, pItem, _T("second"));
+    Control* pSecondLabel = new Control(nullptr);
+    pSecondLabel->SetName(_T("label"));
+    pSecond->AddItem(pSecondLabel);
+    EXPECT_EQ(finder.FindSubControlByName(pItem, _T("label")), pSecondLabel);
+
+    //在原结果之前添加包含同名子控件的容器（子控件不单独添加到ControlFinder中），应按树的顺序返回第一个
+    Box* pFirst = new Box(nullptr);
+    pFirst->SetName(_T("first"));
+    Control* pFirstLabel = new Control(nullptr);
+    pFirstLabel->SetName(_T("label"));
+    pFirst->AddItem(pFirstLabel);
+    pItem->AddItemAt(pFirst, 0);
+    finder.AddControl(pFirst);
+    EXPECT_EQ(finder.FindSubControlByNameNoScope(pItem, _T("label")), pFirstLabel);
+    EXPECT_EQ(finder.FindSubControlByName(pItem, _T("label")), pFirstLabel);
+
+    //在原结果之前直接添加同名控件，结果与不使用索引时一致
+    AddNamedItem<Control>(finder, pItem, _T("label"), 0);
+    EXPECT_EQ(finder.FindSubControlByName(pItem, _T("label")), finder.FindSubControlByNameNoScope(pItem, _T("label")));
+    finder.Clear();
+}
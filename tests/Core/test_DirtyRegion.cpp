@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include "duilib/Core/DirtyRegion.h"
+
+using ui::DirtyRegion;
+using ui::UiRect;
+
+namespace
+{
+bool HasOverlap(const std::vector<UiRect>& rects)
+{
+    for (size_t i = 0; i < rects.size(); ++i) {
+        for (size_t j = i + 1; j < rects.size(); ++j) {
+            UiRect rc;
+            if (UiRect::Intersect(rc, rects[i], rects[j])) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+}
+
+TEST(DirtyRegionTest, EmptyByDefault)
+{
+    DirtyRegion region;
+    EXPECT_TRUE(region.IsEmpty());
+    EXPECT_TRUE(region.GetBounds().IsEmpty());
+    EXPECT_EQ(region.GetArea(), 0);
+}
+
+TEST(DirtyRegionTest, IgnoreEmptyRect)
+{
+    DirtyRegion region;
+    region.AddRect(UiRect(10, 10, 10, 20));
+    EXPECT_TRUE(region.IsEmpty());
+}
+
+TEST(DirtyRegionTest, FarApartRectsKeptSeparate)
+{
+    DirtyRegion region;
+    region.AddRect(UiRect(0, 0, 10, 10));
+    region.AddRect(UiRect(990, 990, 1000, 1000));
+    ASSERT_EQ(region.GetRects().size(), 2u);
+    EXPECT_EQ(region.GetArea(), 200);
+    EXPECT_EQ(region.GetBounds(), UiRect(0, 0, 1000, 1000));
+}
+
+TEST(DirtyRegionTest, OverlappingRectsMerged)
+{
+    DirtyRegion region;
+    region.AddRect(UiRect(0, 0, 100, 100));
+    region.AddRect(UiRect(50, 50, 150, 150));
+    ASSERT_EQ(region.GetRects().size(), 1u);
+    EXPECT_EQ(region.GetRects()[0], UiRect(0, 0, 150, 150));
+}
+
+TEST(DirtyRegionTest, AdjacentRectsMerged)
+{
+    DirtyRegion region;
+    region.AddRect(UiRect(0, 0, 10, 10));
+    region.AddRect(UiRect(10, 0, 20, 10));
+    ASSERT_EQ(region.GetRects().size(), 1u);
+    EXPECT_EQ(region.GetRects()[0], UiRect(0, 0, 20, 10));
+}
+
+TEST(DirtyRegionTest, ContainedRectIgnored)
+{
+    DirtyRegion region;
+    region.AddRect(UiRect(0, 0, 100, 100));
+    region.AddRect(UiRect(10, 10, 20, 20));
+    ASSERT_EQ(region.GetRects().size(), 1u);
+    EXPECT_EQ(region.GetRects()[0], UiRect(0, 0, 100, 100));
+}
+
+TEST(DirtyRegionTest, MergeChainKeepsRectsDisjoint)
+{
+    DirtyRegion region;
+    region.AddRect(UiRect(0, 0, 10, 10));
+    region.AddRect(UiRect(200, 0, 210, 10));
+    //与两个矩形都相交的大矩形，合并后与剩余矩形仍不能重叠
+    region.AddRect(UiRect(5, 5, 205, 8));
+    EXPECT_FALSE(HasOverlap(region.GetRects()));
+    ASSERT_EQ(region.GetRects().size(), 1u);
+    EXPECT_EQ(region.GetRects()[0], UiRect(0, 0, 210, 10));
+}
+
+TEST(DirtyRegionTest, MaxRectsLimit)
+{
+    DirtyRegion region(4);
+    for (int32_t i = 0; i < 16; ++i) {
+        region.AddRect(UiRect(i * 100, i * 100, i * 100 + 5, i * 100 + 5));
+    }
+    EXPECT_LE(region.GetRects().size(), 4u);
+    EXPECT_FALSE(HasOverlap(region.GetRects()));
+    EXPECT_EQ(region.GetBounds(), UiRect(0, 0, 1505, 1505));
+}
+
+TEST(DirtyRegionTest, IntersectDropsOutsideRects)
+{
+    DirtyRegion region;
+    region.AddRect(UiRect(0, 0, 10, 10));
+    region.AddRect(UiRect(500, 500, 600, 600));
+    region.Intersect(UiRect(0, 0, 550, 550));
+    ASSERT_EQ(region.GetRects().size(), 2u);
+    region.Intersect(UiRect(0, 0, 100, 100));
+    ASSERT_EQ(region.GetRects().size(), 1u);
+    EXPECT_EQ(region.GetRects()[0], UiRect(0, 0, 10, 10));
+}
+
+TEST(DirtyRegionTest, Clear)
+{
+    DirtyRegion region;
+    region.AddRect(UiRect(0, 0, 10, 10));
+    region.Clear();
+    EXPECT_TRUE(region.IsEmpty());
+}
@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "duilib/Core/HitTestGrid.h"
+
+using ui::HitTestGrid;
+using ui::UiPoint;
+using ui::UiRect;
+
+namespace {
+
+std::vector<size_t> LinearQuery(const std::vector<UiRect>& itemRects, const UiPoint& pt)
+{
+    std::vector<size_t> itemIndexs;
+    for (size_t i = 0; i < itemRects.size(); ++i) {
+        if (itemRects[i].ContainsPt(pt)) {
+            itemIndexs.push_back(i);
+        }
+    }
+    return itemIndexs;
+}
+
+} // namespace
+
+TEST(HitTestGridTest, MatchesLinearScan)
+{
+    //随机分布的浮动控件，加上覆盖整个区域的背景和遮罩层
+    std::vector<UiRect> itemRects;
+    itemRects.push_back(UiRect(0, 0, 2000, 1500));
+    uint32_t nSeed = 7;
+    for (int i = 0; i < 2000; ++i) {
+        nSeed = nSeed * 1103515245u + 12345u;
+        const int32_t x = (int32_t)((nSeed >> 8) % 1950);
+        nSeed = nSeed * 1103515245u + 12345u;
+        const int32_t y = (int32_t)((nSeed >> 8) % 1450);
+        nSeed = nSeed * 1103515245u + 12345u;
+        const int32_t size = 4 + (int32_t)((nSeed >> 8) % 120);
+        itemRects.push_back(UiRect(x, y, x + size, y + size / 2 + 1));
+    }
+    itemRects.push_back(UiRect());
+    itemRects.push_back(UiRect(100, 100, 1900, 1400));
+
+    HitTestGrid grid;
+    EXPECT_TRUE(grid.IsDirty());
+    grid.Build(itemRects);
+    EXPECT_FALSE(grid.IsDirty());
+    EXPECT_EQ(grid.GetItemCount(), itemRects.size());
+
+    std::vector<size_t> itemIndexs;
+    for (int32_t y = -10; y < 1520; y += 13) {
+        for (int32_t x = -10; x < 2020; x += 17) {
+            const UiPoint pt(x, y);
+            grid.Query(pt, itemIndexs);
+            ASSERT_EQ(itemIndexs, LinearQuery(itemRects, pt)) << "x=" << x << " y=" << y;
+        }
+    }
+    //右边界和下边界不包含在矩形内
+    grid.Query(UiPoint(2000, 10), itemIndexs);
+    EXPECT_TRUE(itemIndexs.empty());
+    grid.Query(UiPoint(1999, 1499), itemIndexs);
+    EXPECT_EQ(itemIndexs, LinearQuery(itemRects, UiPoint(1999, 1499)));
+
+    grid.SetDirty();
+    EXPECT_TRUE(grid.IsDirty());
+}
+
+TEST(HitTestGridTest, EmptyAndDegenerateRects)
+{
+    HitTestGrid grid;
+    std::vector<size_t> itemIndexs;
+    grid.Build(std::vector<UiRect>());
+    grid.Query(UiPoint(0, 0), itemIndexs);
+    EXPECT_TRUE(itemIndexs.empty());
+
+    //所有子控件都在同一行（高度为1）
+    std::vector<UiRect> itemRects;
+    for (int32_t i = 0; i < 100; ++i) {
+        itemRects.push_back(UiRect(i * 10, 5, i * 10 + 10, 6));
+    }
+    itemRects.push_back(UiRect(3, 3, 3, 10));
+    grid.Build(itemRects);
+    grid.Query(UiPoint(35, 5), itemIndexs);
+    ASSERT_EQ(itemIndexs.size(), 1u);
+    EXPECT_EQ(itemIndexs[0], 3u);
+    grid.Query(UiPoint(35, 6), itemIndexs);
+    EXPECT_TRUE(itemIndexs.empty());
+    grid.Query(UiPoint(3, 5), itemIndexs);
+    EXPECT_EQ(itemIndexs, LinearQuery(itemRects, UiPoint(3, 5)));
+
+    grid.Clear();
+    EXPECT_EQ(grid.GetItemCount(), 0u);
+    grid.Query(UiPoint(35, 5), itemIndexs);
+    EXPECT_TRUE(itemIndexs.empty());
+}
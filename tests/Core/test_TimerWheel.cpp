@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <map>
+#include <vector>
+
+#include "duilib/Core/TimerWheel.h"
+
+using ui::TimerWheel;
+
+TEST(TimerWheelTest, ExpiresInDueOrder)
+{
+    TimerWheel wheel;
+    EXPECT_TRUE(wheel.IsEmpty());
+    const uint64_t nHandle1 = wheel.AddTimer(1, 100);
+    EXPECT_GT(nHandle1, 0u);
+    wheel.AddTimer(2, 5);
+    const uint64_t nHandle3 = wheel.AddTimer(3, 5000);
+    wheel.AddTimer(4, 64);
+    EXPECT_EQ(wheel.GetTimerCount(), 4u);
+
+    uint64_t nNextTick = 0;
+    ASSERT_TRUE(wheel.GetNextEventTick(nNextTick));
+    EXPECT_EQ(nNextTick, 5u);
+
+    std::vector<size_t> expiredTimerIds;
+    wheel.Advance(4, expiredTimerIds);
+    EXPECT_TRUE(expiredTimerIds.empty());
+    wheel.Advance(100, expiredTimerIds);
+    EXPECT_EQ(expiredTimerIds, std::vector<size_t>({ 2, 4, 1 }));
+    EXPECT_EQ(wheel.GetCurrentTick(), 100u);
+
+    //已经触发的定时器，句柄失效（节点被复用时也不会误删其他定时器）
+    expiredTimerIds.clear();
+    EXPECT_FALSE(wheel.RemoveTimer(nHandle1));
+    wheel.AddTimer(6, 200);
+    EXPECT_FALSE(wheel.RemoveTimer(nHandle1));
+    EXPECT_EQ(wheel.GetTimerCount(), 2u);
+    wheel.Clear();
+    EXPECT_FALSE(wheel.RemoveTimer(nHandle3));
+    EXPECT_TRUE(wheel.IsEmpty());
+    EXPECT_TRUE(wheel.RemoveTimer(wheel.AddTimer(3, 5000)));
+    EXPECT_FALSE(wheel.RemoveTimer(nHandle3));
+    EXPECT_TRUE(wheel.IsEmpty());
+    EXPECT_FALSE(wheel.GetNextEventTick(nNextTick));
+    wheel.Advance(10000, expiredTimerIds);
+    EXPECT_TRUE(expiredTimerIds.empty());
+
+    //已经过期的触发时间，在下一个毫秒触发
+    EXPECT_TRUE(wheel.AddTimer(5, 50));
+    wheel.Advance(10001, expiredTimerIds);
+    EXPECT_EQ(expiredTimerIds, std::vector<size_t>({ 5 }));
+}
+
+TEST(TimerWheelTest, MatchesSortedReference)
+{
+    //随机添加、删除定时器，并以随机的步长推进时间，与按触发时间排序的参考实现比较
+    TimerWheel wheel;
+    std::multimap<uint64_t, size_t> reference;
+    std::map<size_t, uint64_t> dueTicks;
+    std::map<size_t, uint64_t> timerHandles;
+    uint32_t nSeed = 11;
+    auto nextRandom = [&nSeed]() {
+            nSeed = nSeed * 1103515245u + 12345u;
+            return nSeed >> 8;
+        };
+    const uint64_t kDelays[] = { 1, 63, 64, 4095, 4096, 262143, 262144, 16777216, 1073741824, 5000000000ull };
+    size_t nNextTimerId = 1;
+    uint64_t nNowTick = 0;
+    for (int nRound = 0; nRound < 3000; ++nRound) {
+        const uint32_t nAction = nextRandom() % 10;
+        if (nAction < 5) {
+            const uint64_t nDelay = (nAction == 0) ? kDelays[nextRandom() % 10] : (1 + nextRandom() % 200000);
+            const size_t nTimerId = nNextTimerId++;
+            timerHandles[nTimerId] = wheel.AddTimer(nTimerId, nNowTick + nDelay);
+            reference.emplace(nNowTick + nDelay, nTimerId);
+            dueTicks[nTimerId] = nNowTick + nDelay;
+        }
+        else if ((nAction < 7) && !dueTicks.empty()) {
+            auto iter = dueTicks.begin();
+            std::advance(iter, nextRandom() % dueTicks.size());
+            ASSERT_TRUE(wheel.RemoveTimer(timerHandles[iter->first]));
+            timerHandles.erase(iter->first);
+            auto range = reference.equal_range(iter->second);
+            for (auto refIter = range.first; refIter != range.second; ++refIter) {
+                if (refIter->second == iter->first) {
+                    reference.erase(refIter);
+                    break;
+                }
+            }
+            dueTicks.erase(iter);
+        }
+        else {
+            nNowTick += (nAction == 9) ? (nextRandom() % 100000000) : (nextRandom() % 5000);
+            std::vector<size_t> expiredTimerIds;
+            wheel.Advance(nNowTick, expiredTimerIds);
+            std::vector<uint64_t> expiredTicks;
+            for (size_t nTimerId : expiredTimerIds) {
+                ASSERT_TRUE(dueTicks.count(nTimerId) > 0);
+                expiredTicks.push_back(dueTicks[nTimerId]);
+                dueTicks.erase(nTimerId);
+                ASSERT_FALSE(wheel.RemoveTimer(timerHandles[nTimerId]));
+                timerHandles.erase(nTimerId);
+            }
+            EXPECT_TRUE(std::is_sorted(expiredTicks.begin(), expiredTicks.end()));
+            std::vector<size_t> expectedTimerIds;
+            while (!reference.empty() && (reference.begin()->first <= nNowTick)) {
+                expectedTimerIds.push_back(reference.begin()->second);
+                reference.erase(reference.begin());
+            }
+            std::sort(expiredTimerIds.begin(), expiredTimerIds.end());
+            std::sort(expectedTimerIds.begin(), expectedTimerIds.end());
+            ASSERT_EQ(expiredTimerIds, expectedTimerIds) << "round " << nRound;
+        }
+        ASSERT_EQ(wheel.GetTimerCount(), reference.size());
+        uint64_t nNextTick = 0;
+        if (wheel.GetNextEventTick(nNextTick)) {
+            //下一次推进时间的时刻不会晚于最早的触发时间
+            EXPECT_LE(nNextTick, std::max(reference.begin()->first, nNowTick + 1));
+        }
+    }
+}
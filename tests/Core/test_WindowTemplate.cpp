@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+#include "duilib/Core/WindowTemplate.h"
+#include "duilib/Core/XmlBinaryCache.h"
+
+using ui::WindowTemplate;
+using ui::XmlBinaryDocument;
+using ui::XmlBinaryNode;
+
+namespace {
+
+const char* kTestXml =
+    "<Window size=\"800,600\">\n"
+    "  <Class name=\"btn\" normal_color=\"white\" hot_color=\"gray\"/>\n"
+    "  <Class name=\"big\" class=\"btn\" height=\"40\"/>\n"
+    "  <VBox class=\"panel\">\n"
+    "    <Button class=\"btn\" text=\"OK\"/>\n"
+    "    <Button class=\"big global_font\" name=\"cancel\"/>\n"
+    "    <Button class=\"btn unknown\" text=\"Keep\"/>\n"
+    "    <Label text=\"first\" class=\"btn\"/>\n"
+    "    <Event type=\"click\" class=\"btn\"/>\n"
+    "    <RichText class=\"btn\"><Box class=\"btn\"/></RichText>\n"
+    "  </VBox>\n"
+    "</Window>\n";
+
+/** 全局Class：panel、global_font
+*/
+bool GetGlobalClass(const DString& className, WindowTemplate::AttributeList& attributeList)
+{
+    if (className == _T("panel")) {
+        attributeList = { { _T("bkcolor"), _T("white") }, { _T("padding"), _T("4,4,4,4") } };
+        return true;
+    }
+    if (className == _T("global_font")) {
+        attributeList = { { _T("font"), _T("system_14") } };
+        return true;
+    }
+    return false;
+}
+
+/** 将节点的属性转换为 "name=value;" 格式的字符串，便于比较
+*/
+DString GetAttributes(const XmlBinaryNode& node)
+{
+    DString attributes;
+    for (const auto& attr : node.attributes()) {
+        attributes += attr.name();
+        attributes += _T("=");
+        attributes += attr.value();
+        attributes += _T(";");
+    }
+    return attributes;
+}
+
+std::vector<uint8_t> ToData(const char* xml)
+{
+    return std::vector<uint8_t>(xml, xml + std::char_traits<char>::length(xml));
+}
+
+} // namespace
+
+TEST(WindowTemplateTest, ExpandClassAttributes)
+{
+    std::vector<uint8_t> templateData;
+    ASSERT_TRUE(WindowTemplate::CompileXmlData(ToData(kTestXml), GetGlobalClass, templateData));
+    XmlBinaryDocument doc;
+    ASSERT_TRUE(doc.LoadBuffer(std::move(templateData)));
+
+    XmlBinaryNode window = doc.root().first_child();
+    EXPECT_EQ(GetAttributes(window), _T("size=800,600;"));
+    //Class定义保留，运行时仍可使用
+    XmlBinaryNode classNode = window.first_child();
+    EXPECT_EQ(GetAttributes(classNode), _T("name=btn;normal_color=white;hot_color=gray;"));
+
+    XmlBinaryNode vbox = classNode.next_sibling().next_sibling();
+    EXPECT_EQ(GetAttributes(vbox), _T("bkcolor=white;padding=4,4,4,4;"));
+
+    XmlBinaryNode button = vbox.first_child();
+    EXPECT_EQ(GetAttributes(button), _T("normal_color=white;hot_color=gray;text=OK;"));
+    //嵌套的Class和全局Class
+    button = button.next_sibling();
+    EXPECT_EQ(GetAttributes(button), _T("normal_color=white;hot_color=gray;height=40;font=system_14;name=cancel;"));
+    //含有未定义的Class：保持不变
+    button = button.next_sibling();
+    EXPECT_EQ(GetAttributes(button), _T("class=btn unknown;text=Keep;"));
+    //class不是第一个属性：保持不变
+    XmlBinaryNode label = button.next_sibling();
+    EXPECT_EQ(GetAttributes(label), _T("text=first;class=btn;"));
+    //事件节点和RichText的内容不展开
+    XmlBinaryNode eventNode = label.next_sibling();
+    EXPECT_EQ(GetAttributes(eventNode), _T("type=click;class=btn;"));
+    XmlBinaryNode richText = eventNode.next_sibling();
+    EXPECT_EQ(GetAttributes(richText), _T("normal_color=white;hot_color=gray;"));
+    EXPECT_EQ(GetAttributes(richText.first_child()), _T("class=btn;"));
+}
+
+TEST(WindowTemplateTest, GlobalClassFirst)
+{
+    const char* xml =
+        "<Window>\n"
+        "  <Class name=\"panel\" bkcolor=\"black\"/>\n"
+        "  <Box class=\"panel\"/>\n"
+        "</Window>\n";
+    std::vector<uint8_t> templateData;
+    ASSERT_TRUE(WindowTemplate::CompileXmlData(ToData(xml), GetGlobalClass, templateData));
+    XmlBinaryDocument doc;
+    ASSERT_TRUE(doc.LoadBuffer(std::move(templateData)));
+    XmlBinaryNode box = doc.root().first_child().first_child().next_sibling();
+    EXPECT_EQ(GetAttributes(box), _T("bkcolor=white;padding=4,4,4,4;"));
+
+    //没有全局Class时，使用窗口中的Class
+    templateData.clear();
+    ASSERT_TRUE(WindowTemplate::CompileXmlData(ToData(xml), nullptr, templateData));
+    ASSERT_TRUE(doc.LoadBuffer(std::move(templateData)));
+    box = doc.root().first_child().first_child().next_sibling();
+    EXPECT_EQ(GetAttributes(box), _T("bkcolor=black;"));
+}
+
+TEST(WindowTemplateTest, InvalidXml)
+{
+    std::vector<uint8_t> templateData;
+    EXPECT_FALSE(WindowTemplate::CompileXmlData(std::vector<uint8_t>(), nullptr, templateData));
+    EXPECT_FALSE(WindowTemplate::CompileXmlData(ToData("<Window><Box></Window>"), nullptr, templateData));
+    EXPECT_TRUE(templateData.empty());
+}
@@ -0,0 +1,320 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "duilib/Core/XmlBinaryCache.h"
+#include "duilib/Utils/FileUtil.h"
+#include "duilib/third_party/xml/pugixml.hpp"
+
+using ui::FilePath;
+using ui::FileUtil;
+using ui::XmlBinaryCache;
+using ui::XmlBinaryDocument;
+using ui::XmlBinaryNode;
+
+namespace {
+
+std::filesystem::path MakeUniqueTempPath(const char* prefix)
+{
+    const auto stamp = std::chrono::high_resolution_clock::now().time_since_epoch().count();
+    return std::filesystem::temp_directory_path() / (std::string(prefix) + std::to_string(stamp));
+}
+
+const char* kTestXml =
+    "<Window size=\"800,600\" caption=\"0,0,0,36\">\n"
+    "  <Class name=\"btn\" normal_color=\"white\"/>\n"
+    "  <VBox bkcolor=\"bk_wnd_darkcolor\">\n"
+    "    <Label name=\"title\" text=\"Hello\" width=\"0x10\"/>\n"
+    "    <RichText>Text<b>Bold</b><a href=\" url \">link</a></RichText>\n"
+    "    <Include src=\"item.xml\" count=\"3\"/>\n"
+    "  </VBox>\n"
+    "</Window>\n";
+
+/** 以pugixml为基准，比较两个节点树是否完全相同
+*/
+void ExpectSameTree(const pugi::xml_node& xmlNode, const XmlBinaryNode& binaryNode)
+{
+    ASSERT_FALSE(binaryNode.empty());
+    EXPECT_EQ((int32_t)xmlNode.type(), binaryNode.type());
+    EXPECT_STREQ(xmlNode.name(), binaryNode.name());
+    EXPECT_STREQ(xmlNode.value(), binaryNode.value());
+
+    auto binaryAttr = binaryNode.attributes().begin();
+    for (pugi::xml_attribute attr : xmlNode.attributes()) {
+        ASSERT_FALSE((*binaryAttr).empty());
+        EXPECT_STREQ(attr.name(), binaryAttr->name());
+        EXPECT_STREQ(attr.value(), binaryAttr->value());
+        ++binaryAttr;
+    }
+    EXPECT_TRUE(binaryAttr == binaryNode.attributes().end());
+
+    XmlBinaryNode binaryChild = binaryNode.first_child();
+    for (pugi::xml_node child : xmlNode.children()) {
+        ExpectSameTree(child, binaryChild);
+        binaryChild = binaryChild.next_sibling();
+    }
+    EXPECT_TRUE(binaryChild.empty());
+}
+
+class XmlBinaryCacheTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_rootDir = MakeUniqueTempPath("duilib_xmlcache_");
+        std::filesystem::create_directories(m_rootDir);
+        m_xmlPath = FilePath((m_rootDir / "window.xml").string());
+        std::ofstream file(m_rootDir / "window.xml", std::ios::binary);
+        file << kTestXml;
+        file.close();
+        ASSERT_TRUE(m_doc.load_string(kTestXml));
+    }
+
+    void TearDown() override
+    {
+        std::error_code ec;
+        std::filesystem::remove_all(m_rootDir, ec);
+    }
+
+    std::filesystem::path m_rootDir;
+    FilePath m_xmlPath;
+    pugi::xml_document m_doc;
+};
+
+} // namespace
+
+TEST_F(XmlBinaryCacheTest, MappedDocumentMatchesXml)
+{
+    XmlBinaryCache cache;
+    ASSERT_TRUE(cache.SaveToCache(m_xmlPath, m_doc));
+    EXPECT_TRUE(cache.IsCacheValid(m_xmlPath));
+
+    //小文件直接读入内存
+    XmlBinaryDocument binaryDoc;
+    ASSERT_TRUE(cache.LoadFromCache(m_xmlPath, binaryDoc));
+    EXPECT_FALSE(binaryDoc.IsMapped());
+    ExpectSameTree(m_doc.root(), binaryDoc.root());
+
+    //大文件以内存映射方式加载
+    pugi::xml_document largeDoc;
+    pugi::xml_node window = largeDoc.append_child("Window");
+    for (int i = 0; i < 8000; ++i) {
+        pugi::xml_node item = window.append_child("ListBoxElement");
+        item.append_attribute("name").set_value(("item_" + std::to_string(i)).c_str());
+        item.append_child(pugi::node_pcdata).set_value(("text " + std::to_string(i * 7919)).c_str());
+    }
+    ASSERT_TRUE(cache.SaveToCache(m_xmlPath, largeDoc));
+    ASSERT_TRUE(cache.LoadFromCache(m_xmlPath, binaryDoc));
+    EXPECT_TRUE(binaryDoc.IsMapped());
+    ExpectSameTree(largeDoc.root(), binaryDoc.root());
+}
+
+TEST_F(XmlBinaryCacheTest, NodeAccessors)
+{
+    XmlBinaryCache cache;
+    ASSERT_TRUE(cache.SaveToCache(m_xmlPath, m_doc));
+    XmlBinaryDocument binaryDoc;
+    ASSERT_TRUE(cache.LoadFromCache(m_xmlPath, binaryDoc));
+
+    XmlBinaryNode window = binaryDoc.root().first_child();
+    EXPECT_STREQ(window.name(), "Window");
+    EXPECT_STREQ(window.attribute("caption").as_string(), "0,0,0,36");
+    EXPECT_TRUE(window.attribute("unknown").empty());
+    EXPECT_STREQ(window.attribute("unknown").as_string("def"), "def");
+
+    XmlBinaryNode vbox = window.first_child().next_sibling();
+    EXPECT_STREQ(vbox.name(), "VBox");
+    XmlBinaryNode label = vbox.first_child();
+    EXPECT_EQ(label.attribute("width").as_int(), 16);
+    EXPECT_TRUE(label.children().empty());
+
+    XmlBinaryNode richText = label.next_sibling();
+    EXPECT_STREQ(richText.text().as_string(), "Text");
+    EXPECT_EQ(richText.attribute("count").as_int(-1), -1);
+
+    XmlBinaryNode include = richText.next_sibling();
+    EXPECT_EQ(include.attribute("count").as_int(), 3);
+    EXPECT_TRUE(include.next_sibling().empty());
+}
+
+TEST_F(XmlBinaryCacheTest, LoadIntoPugiDocument)
+{
+    XmlBinaryCache cache;
+    ASSERT_TRUE(cache.SaveToCache(m_xmlPath, m_doc));
+
+    pugi::xml_document doc;
+    ASSERT_TRUE(cache.LoadFromCache(m_xmlPath, doc));
+
+    XmlBinaryDocument binaryDoc;
+    ASSERT_TRUE(cache.LoadFromCache(m_xmlPath, binaryDoc));
+    ExpectSameTree(doc.root(), binaryDoc.root());
+}
+
+TEST_F(XmlBinaryCacheTest, CacheDirectoryAvoidsNameClash)
+{
+    const std::filesystem::path cacheDir = m_rootDir / "cache";
+    std::filesystem::create_directories(cacheDir);
+    std::filesystem::create_directories(m_rootDir / "sub");
+    const FilePath otherXmlPath((m_rootDir / "sub" / "window.xml").string());
+    std::ofstream(m_rootDir / "sub" / "window.xml") << "<Global/>";
+
+    XmlBinaryCache cache;
+    cache.SetCacheDirectory(FilePath(cacheDir.string()));
+    pugi::xml_document otherDoc;
+    ASSERT_TRUE(otherDoc.load_string("<Global/>"));
+    ASSERT_TRUE(cache.SaveToCache(m_xmlPath, m_doc));
+    ASSERT_TRUE(cache.SaveToCache(otherXmlPath, otherDoc));
+
+    XmlBinaryDocument binaryDoc;
+    ASSERT_TRUE(cache.LoadFromCache(m_xmlPath, binaryDoc));
+    EXPECT_STREQ(binaryDoc.root().first_child().name(), "Window");
+    ASSERT_TRUE(cache.LoadFromCache(otherXmlPath, binaryDoc));
+    EXPECT_STREQ(binaryDoc.root().first_child().name(), "Global");
+
+    EXPECT_EQ(cache.ClearAllCache(), 2);
+    EXPECT_FALSE(cache.IsCacheValid(m_xmlPath));
+}
+
+TEST_F(XmlBinaryCacheTest, StaleCacheRejected)
+{
+    XmlBinaryCache cache;
+    ASSERT_TRUE(cache.SaveToCache(m_xmlPath, m_doc));
+    const std::filesystem::path xmlFile = m_rootDir / "window.xml";
+    std::filesystem::last_write_time(xmlFile, std::filesystem::last_write_time(xmlFile) + std::chrono::hours(1));
+    EXPECT_FALSE(cache.IsCacheValid(m_xmlPath));
+
+    XmlBinaryDocument binaryDoc;
+    EXPECT_FALSE(cache.LoadFromCache(m_xmlPath, binaryDoc));
+    EXPECT_TRUE(binaryDoc.IsEmpty());
+
+    //XML文件被替换为修改时间更早的文件，缓存也过期
+    ASSERT_TRUE(cache.SaveToCache(m_xmlPath, m_doc));
+    EXPECT_TRUE(cache.LoadFromCache(m_xmlPath, binaryDoc));
+    std::filesystem::last_write_time(xmlFile, std::filesystem::last_write_time(xmlFile) - std::chrono::hours(2));
+    EXPECT_FALSE(cache.IsCacheValid(m_xmlPath));
+    EXPECT_FALSE(cache.LoadFromCache(m_xmlPath, binaryDoc));
+}
+
+TEST_F(XmlBinaryCacheTest, CorruptedCacheRejected)
+{
+    XmlBinaryCache cache;
+    ASSERT_TRUE(cache.SaveToCache(m_xmlPath, m_doc));
+    const FilePath cachePath = XmlBinaryCache::GetCacheFilePath(m_xmlPath);
+    std::vector<uint8_t> data;
+    ASSERT_TRUE(FileUtil::ReadFileData(cachePath, data));
+
+    XmlBinaryDocument binaryDoc;
+    std::vector<uint8_t> validData = data;
+    EXPECT_TRUE(binaryDoc.LoadBuffer(std::move(validData)));
+    EXPECT_FALSE(binaryDoc.IsMapped());
+
+    //截断的数据
+    std::vector<uint8_t> truncated(data.begin(), data.begin() + data.size() / 2);
+    EXPECT_FALSE(binaryDoc.LoadBuffer(std::move(truncated)));
+    EXPECT_TRUE(binaryDoc.IsEmpty());
+
+    //子节点索引指向自身（会导致死循环）
+    std::vector<uint8_t> cyclic = data;
+    const size_t firstChildOffset = 32 + 24 + 8;
+    const uint32_t selfIndex = 1;
+    std::memcpy(cyclic.data() + firstChildOffset, &selfIndex, sizeof(selfIndex));
+    EXPECT_FALSE(binaryDoc.LoadBuffer(std::move(cyclic)));
+
+    //字符串ID越界
+    std::vector<uint8_t> badString = data;
+    const uint32_t badId = 0xFFFFFFF0;
+    std::memcpy(badString.data() + 32 + 24 + 4, &badId, sizeof(badId));
+    EXPECT_FALSE(binaryDoc.LoadBuffer(std::move(badString)));
+
+    //缓存文件加载时只校验文件头和长度：访问损坏的索引和字符串时不会越界，也不会死循环
+    std::vector<uint8_t> badFile = data;
+    std::memcpy(badFile.data() + firstChildOffset, &selfIndex, sizeof(selfIndex));
+    std::memcpy(badFile.data() + 32 + 24 + 4, &badId, sizeof(badId));
+    const std::filesystem::path cacheFile = m_rootDir / "window.xmc";
+    std::ofstream(cacheFile, std::ios::binary | std::ios::trunc).write(reinterpret_cast<const char*>(badFile.data()), badFile.size());
+    ASSERT_TRUE(binaryDoc.LoadFile(cachePath));
+    EXPECT_STREQ(binaryDoc.root().first_child().name(), "");
+    EXPECT_TRUE(binaryDoc.root().first_child().first_child().empty());
+
+    //截断的缓存文件
+    std::ofstream(cacheFile, std::ios::binary | std::ios::trunc).write(reinterpret_cast<const char*>(data.data()), data.size() - 4);
+    EXPECT_FALSE(binaryDoc.LoadFile(cachePath));
+}
+
+TEST_F(XmlBinaryCacheTest, CompressedCacheMatchesXml)
+{
+    XmlBinaryCache rawCache;
+    ASSERT_TRUE(rawCache.SaveToCache(m_xmlPath, m_doc));
+    const FilePath cachePath = XmlBinaryCache::GetCacheFilePath(m_xmlPath);
+    std::vector<uint8_t> rawData;
+    ASSERT_TRUE(FileUtil::ReadFileData(cachePath, rawData));
+
+    XmlBinaryCache cache;
+    cache.SetCompressionEnabled(true);
+    ASSERT_TRUE(cache.SaveToCache(m_xmlPath, m_doc));
+    EXPECT_TRUE(cache.IsCacheValid(m_xmlPath));
+    std::vector<uint8_t> compressedData;
+    ASSERT_TRUE(FileUtil::ReadFileData(cachePath, compressedData));
+    EXPECT_LT(compressedData.size(), rawData.size());
+
+    //压缩格式不能内存映射，解压后加载
+    XmlBinaryDocument binaryDoc;
+    ASSERT_TRUE(cache.LoadFromCache(m_xmlPath, binaryDoc));
+    EXPECT_FALSE(binaryDoc.IsMapped());
+    ExpectSameTree(m_doc.root(), binaryDoc.root());
+
+    //读取时不依赖压缩选项
+    XmlBinaryCache otherCache;
+    pugi::xml_document doc;
+    ASSERT_TRUE(otherCache.LoadFromCache(m_xmlPath, doc));
+    ExpectSameTree(doc.root(), binaryDoc.root());
+    EXPECT_FALSE(binaryDoc.LoadBuffer(std::move(compressedData)));
+}
+
+TEST_F(XmlBinaryCacheTest, CompressedLargeDocumentRoundTrip)
+{
+    //超过一个压缩数据块(64KB)的文档
+    pugi::xml_document doc;
+    pugi::xml_node window = doc.append_child("Window");
+    for (int i = 0; i < 3000; ++i) {
+        pugi::xml_node item = window.append_child("ListBoxElement");
+        item.append_attribute("name").set_value(("item_" + std::to_string(i)).c_str());
+        item.append_attribute("height").set_value("32");
+        item.append_child(pugi::node_pcdata).set_value(("text " + std::to_string(i * 7919)).c_str());
+    }
+
+    XmlBinaryCache cache;
+    cache.SetCompressionEnabled(true);
+    ASSERT_TRUE(cache.SaveToCache(m_xmlPath, doc));
+    XmlBinaryDocument binaryDoc;
+    ASSERT_TRUE(cache.LoadFromCache(m_xmlPath, binaryDoc));
+    ExpectSameTree(doc.root(), binaryDoc.root());
+}
+
+TEST_F(XmlBinaryCacheTest, CorruptedCompressedCacheRejected)
+{
+    XmlBinaryCache cache;
+    cache.SetCompressionEnabled(true);
+    ASSERT_TRUE(cache.SaveToCache(m_xmlPath, m_doc));
+    const FilePath cachePath = XmlBinaryCache::GetCacheFilePath(m_xmlPath);
+    std::vector<uint8_t> data;
+    ASSERT_TRUE(FileUtil::ReadFileData(cachePath, data));
+    const std::filesystem::path cacheFile = m_rootDir / "window.xmc";
+
+    //截断的数据
+    std::ofstream(cacheFile, std::ios::binary | std::ios::trunc).write(reinterpret_cast<const char*>(data.data()), data.size() - 3);
+    XmlBinaryDocument binaryDoc;
+    EXPECT_FALSE(cache.LoadFromCache(m_xmlPath, binaryDoc));
+    EXPECT_TRUE(binaryDoc.IsEmpty());
+
+    //数据块的原始长度被修改
+    std::vector<uint8_t> badBlock = data;
+    const uint32_t badSize = 0x00100000;
+    std::memcpy(badBlock.data() + 32 + 4, &badSize, sizeof(badSize));
+    std::ofstream(cacheFile, std::ios::binary | std::ios::trunc).write(reinterpret_cast<const char*>(badBlock.data()), badBlock.size());
+    EXPECT_FALSE(cache.LoadFromCache(m_xmlPath, binaryDoc));
+}
@@ -4,12 +4,15 @@
 #ifdef DUILIB_BUILD_FOR_LUA
 
 #include "duilib/Lua/LuaEngine.h"
+#include "duilib/Lua/LuaWorker.h"
 #include "duilib/Utils/FilePath.h"
 #include "duilib/Utils/FileUtil.h"
+#include "sol/sol.hpp"
 #include <filesystem>
 #include <fstream>
 
 using ui::LuaEngine;
+using ui::LuaMessageValue;
 using ui::FilePath;
 
 class LuaEngineTest : public ::testing::Test {
@@ -158,6 +161,78 @@ TEST_F(LuaEngineTest, ReloadScript)
     EXPECT_TRUE(LuaEngine::Instance().ReloadScript("reload_test.lua"));
 }
 
+TEST_F(LuaEngineTest, BytecodeCache_ReloadAfterModify)
+{
+    CreateScript("cached.lua", "#!/usr/bin/lua\nversion = 1");
+
+    ASSERT_TRUE(LuaEngine::Instance().Initialize(scripts_dir_.string()));
+
+    EXPECT_TRUE(LuaEngine::Instance().LoadScript("cached.lua"));
+    EXPECT_TRUE(LuaEngine::Instance().ReloadScript("cached.lua"));
+    EXPECT_TRUE(LuaEngine::Instance().DoString("assert(version == 1)"));
+
+    // Content hash changed: the cached bytecode must not be used
+    CreateScript("cached.lua", "version = 2");
+    EXPECT_TRUE(LuaEngine::Instance().ReloadScript("cached.lua"));
+    EXPECT_TRUE(LuaEngine::Instance().DoString("assert(version == 2)"));
+
+    // Load again after the cache is cleared
+    LuaEngine::Instance().ClearBytecodeCache();
+    EXPECT_TRUE(LuaEngine::Instance().ReloadScript("cached.lua"));
+    EXPECT_TRUE(LuaEngine::Instance().DoString("assert(version == 2)"));
+}
+
+TEST_F(LuaEngineTest, CompileBytecode)
+{
+    std::vector<uint8_t> bytecode;
+    std::string errorMsg;
+    EXPECT_TRUE(LuaEngine::CompileBytecode("return 1 + 2", "=test", bytecode, errorMsg));
+    EXPECT_FALSE(bytecode.empty());
+
+    EXPECT_FALSE(LuaEngine::CompileBytecode("function incomplete(", "=test", bytecode, errorMsg));
+    EXPECT_FALSE(errorMsg.empty());
+}
+
+TEST_F(LuaEngineTest, Worker_NotInitialized)
+{
+    EXPECT_EQ(LuaEngine::Instance().CreateWorker("worker.lua"), 0);
+    EXPECT_FALSE(LuaEngine::Instance().PostWorkerMessage(1, std::make_shared<ui::LuaMessage>()));
+    EXPECT_EQ(LuaEngine::Instance().GetWorkerMemoryUsage(1), 0u);
+}
+
+TEST_F(LuaEngineTest, WorkerMessage_CopyBetweenStates)
+{
+    sol::state source;
+    sol::state target;
+    source.open_libraries(sol::lib::base);
+    target.open_libraries(sol::lib::base);
+
+    lua_State* L = source.lua_state();
+    luaL_dostring(L, "return { 1, 2.5, 'text', true, nested = { key = 'value' } }");
+    LuaMessageValue value;
+    std::string errorMsg;
+    ASSERT_TRUE(value.Read(L, -1, errorMsg));
+    lua_pop(L, 1);
+
+    value.Push(target.lua_state());
+    lua_setglobal(target.lua_state(), "copied");
+    EXPECT_TRUE(target.safe_script(R"(
+        assert(copied[1] == 1)
+        assert(copied[2] == 2.5)
+        assert(copied[3] == 'text')
+        assert(copied[4] == true)
+        assert(copied.nested.key == 'value')
+    )").valid());
+
+    // Functions and cycles can't be passed
+    luaL_dostring(L, "return { f = print }");
+    EXPECT_FALSE(value.Read(L, -1, errorMsg));
+    lua_pop(L, 1);
+    luaL_dostring(L, "local t = {} t.self = t return t");
+    EXPECT_FALSE(value.Read(L, -1, errorMsg));
+    lua_pop(L, 1);
+}
+
 TEST_F(LuaEngineTest, ReloadScript_NotLoaded)
 {
     ASSERT_TRUE(LuaEngine::Instance().Initialize(scripts_dir_.string()));
@@ -0,0 +1,228 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <memory>
+
+#include "duilib/RenderSkia/DrawStringCache_Skia.h"
+#include "duilib/RenderSkia/SkTextBox.h"
+#include "duilib/RenderSkia/Font_Skia.h"
+#include "duilib/RenderSkia/FontMgr_Skia.h"
+
+#include "duilib/RenderSkia/SkiaHeaderBegin.h"
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkPaint.h"
+#include "duilib/RenderSkia/SkiaHeaderEnd.h"
+
+using ui::DrawStringCache_Skia;
+using ui::DrawStringParam;
+using ui::UiRect;
+
+namespace {
+
+/** 只提供下划线和删除线属性的字体（IsMatch只使用这两个属性）
+*/
+class TestFont : public ui::IFont
+{
+public:
+    virtual bool InitFont(const ui::UiFont& /*fontInfo*/) override { return true; }
+    virtual DString FontName() const override { return _T("test"); }
+    virtual int FontSize() const override { return 12; }
+    virtual bool IsBold() const override { return false; }
+    virtual bool IsUnderline() const override { return m_bUnderline; }
+    virtual bool IsItalic() const override { return false; }
+    virtual bool IsStrikeOut() const override { return m_bStrikeOut; }
+
+    bool m_bUnderline = false;
+    bool m_bStrikeOut = false;
+};
+
+SkTextEncoding GetTextEncoding()
+{
+    return (sizeof(DString::value_type) == 1) ? SkTextEncoding::kUTF8 :
+           ((sizeof(DString::value_type) == 2) ? SkTextEncoding::kUTF16 : SkTextEncoding::kUTF32);
+}
+
+/** 按绘制参数设置SkTextBox（与Render_Skia::InitTextBox一致，绘制区域按画布原点偏移）
+*/
+void InitTextBox(SkTextBox& skTextBox, const DString& text, const DrawStringParam& drawParam,
+                 const SkFont& skFont, const SkPaint& skPaint, int32_t nOffsetX, int32_t nOffsetY)
+{
+    UiRect rc = drawParam.textRect;
+    rc.Offset(nOffsetX, nOffsetY);
+    skTextBox.setBox(SkRect::MakeLTRB((SkScalar)rc.left, (SkScalar)rc.top, (SkScalar)rc.right, (SkScalar)rc.bottom));
+    if (drawParam.uFormat & ui::DrawStringFormat::TEXT_SINGLELINE) {
+        skTextBox.setLineMode(SkTextBox::kOneLine_Mode);
+    }
+    skTextBox.setSpacing(drawParam.fSpacingMul, drawParam.fSpacingAdd);
+    skTextBox.setEndEllipsis((drawParam.uFormat & ui::DrawStringFormat::TEXT_END_ELLIPSIS) != 0);
+    skTextBox.setPathEllipsis((drawParam.uFormat & ui::DrawStringFormat::TEXT_PATH_ELLIPSIS) != 0);
+    if (drawParam.uFormat & ui::DrawStringFormat::TEXT_NOCLIP) {
+        skTextBox.setClipBox(false);
+    }
+    skTextBox.setStrikeOut(drawParam.pFont->IsStrikeOut());
+    skTextBox.setUnderline(drawParam.pFont->IsUnderline());
+    if (drawParam.uFormat & ui::DrawStringFormat::TEXT_HCENTER) {
+        skTextBox.setTextAlign(SkTextBox::kCenter_Align);
+    }
+    else if (drawParam.uFormat & ui::DrawStringFormat::TEXT_RIGHT) {
+        skTextBox.setTextAlign(SkTextBox::kRight_Align);
+    }
+    if (drawParam.uFormat & ui::DrawStringFormat::TEXT_VCENTER) {
+        skTextBox.setSpacingAlign(SkTextBox::kCenter_SpacingAlign);
+    }
+    else if (drawParam.uFormat & ui::DrawStringFormat::TEXT_BOTTOM) {
+        skTextBox.setSpacingAlign(SkTextBox::kEnd_SpacingAlign);
+    }
+    skTextBox.setText((const char*)text.c_str(), text.size() * sizeof(DString::value_type),
+                      GetTextEncoding(), skFont, skPaint);
+}
+
+SkBitmap MakeCanvasBitmap()
+{
+    SkBitmap skBitmap;
+    skBitmap.allocN32Pixels(240, 120);
+    skBitmap.eraseColor(SK_ColorTRANSPARENT);
+    return skBitmap;
+}
+
+bool IsSamePixels(const SkBitmap& a, const SkBitmap& b)
+{
+    return (a.computeByteSize() == b.computeByteSize()) &&
+           (std::memcmp(a.getPixels(), b.getPixels(), a.computeByteSize()) == 0);
+}
+
+bool HasPixels(const SkBitmap& skBitmap)
+{
+    const uint32_t* pPixels = (const uint32_t*)skBitmap.getPixels();
+    const size_t nCount = skBitmap.computeByteSize() / sizeof(uint32_t);
+    for (size_t i = 0; i < nCount; ++i) {
+        if (pPixels[i] != 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+TEST(DrawStringCacheSkiaTest, IsMatchChecksLayoutParams)
+{
+    TestFont font;
+    DrawStringParam drawParam;
+    drawParam.textRect = UiRect(10, 10, 200, 40);
+    drawParam.pFont = &font;
+    drawParam.uFormat = ui::DrawStringFormat::TEXT_SINGLELINE | ui::DrawStringFormat::TEXT_VCENTER;
+    const DString text = _T("Cached text");
+    SkFont skFont;
+    skFont.setSize(12);
+
+    DrawStringCache_Skia cache;
+    SkTextBox skTextBox;
+    SkPaint skPaint;
+    InitTextBox(skTextBox, text, drawParam, skFont, skPaint, 0, 0);
+    cache.Update(text, drawParam, skFont, skTextBox);
+    EXPECT_TRUE(cache.IsMatch(text, drawParam, skFont));
+
+    //文字颜色和透明度不影响排版结果
+    DrawStringParam param = drawParam;
+    param.dwTextColor = ui::UiColor(0xFF102030);
+    param.uFade = 128;
+    EXPECT_TRUE(cache.IsMatch(text, param, skFont));
+
+    //文字内容
+    EXPECT_FALSE(cache.IsMatch(_T("Cached text!"), drawParam, skFont));
+    EXPECT_FALSE(cache.IsMatch(_T(""), drawParam, skFont));
+
+    //绘制区域
+    param = drawParam;
+    param.textRect.Offset(1, 0);
+    EXPECT_FALSE(cache.IsMatch(text, param, skFont));
+    param = drawParam;
+    param.textRect.bottom += 1;
+    EXPECT_FALSE(cache.IsMatch(text, param, skFont));
+
+    //文字格式
+    param = drawParam;
+    param.uFormat |= ui::DrawStringFormat::TEXT_END_ELLIPSIS;
+    EXPECT_FALSE(cache.IsMatch(text, param, skFont));
+
+    //行间距
+    param = drawParam;
+    param.fSpacingMul = 1.5f;
+    EXPECT_FALSE(cache.IsMatch(text, param, skFont));
+    param = drawParam;
+    param.fSpacingAdd = 2.0f;
+    EXPECT_FALSE(cache.IsMatch(text, param, skFont));
+
+    //下划线和删除线
+    font.m_bUnderline = true;
+    EXPECT_FALSE(cache.IsMatch(text, drawParam, skFont));
+    font.m_bUnderline = false;
+    font.m_bStrikeOut = true;
+    EXPECT_FALSE(cache.IsMatch(text, drawParam, skFont));
+    font.m_bStrikeOut = false;
+    EXPECT_TRUE(cache.IsMatch(text, drawParam, skFont));
+
+    //字体
+    SkFont otherFont = skFont;
+    otherFont.setSize(14);
+    EXPECT_FALSE(cache.IsMatch(text, drawParam, otherFont));
+    otherFont = skFont;
+    otherFont.setEmbolden(true);
+    EXPECT_FALSE(cache.IsMatch(text, drawParam, otherFont));
+
+    //没有字体
+    param = drawParam;
+    param.pFont = nullptr;
+    EXPECT_FALSE(cache.IsMatch(text, param, skFont));
+}
+
+TEST(DrawStringCacheSkiaTest, CachedDrawMatchesTextBoxDraw)
+{
+    std::shared_ptr<ui::IFontMgr> spFontMgr = std::make_shared<ui::FontMgr_Skia>();
+    ui::Font_Skia font(spFontMgr);
+    ui::UiFont fontInfo;
+    fontInfo.m_fontName = _T("sans-serif");
+    fontInfo.m_fontSize = 16;
+    fontInfo.m_bUnderline = true;
+    ASSERT_TRUE(font.InitFont(fontInfo));
+    const SkFont* pSkFont = font.GetFontHandle();
+    ASSERT_NE(pSkFont, nullptr);
+
+    SkPaint skPaint;
+    skPaint.setColor(SK_ColorBLACK);
+    skPaint.setAntiAlias(true);
+
+    DrawStringParam drawParam;
+    drawParam.textRect = UiRect(5, 5, 120, 100);
+    drawParam.pFont = &font;
+    drawParam.uFormat = ui::DrawStringFormat::TEXT_END_ELLIPSIS;
+    const DString text = _T("Layout cache draws the same glyphs as SkTextBox::draw");
+
+    DrawStringCache_Skia cache;
+    SkTextBox cacheTextBox;
+    InitTextBox(cacheTextBox, text, drawParam, *pSkFont, skPaint, 0, 0);
+    cache.Update(text, drawParam, *pSkFont, cacheTextBox);
+
+    //画布原点不同时（如滚动），使用同一个排版结果绘制
+    const int32_t offsets[][2] = { {0, 0}, {30, 7}, {-3, 12} };
+    for (const auto& offset : offsets) {
+        SkBitmap directBitmap = MakeCanvasBitmap();
+        {
+            SkCanvas skCanvas(directBitmap);
+            SkTextBox skTextBox;
+            InitTextBox(skTextBox, text, drawParam, *pSkFont, skPaint, offset[0], offset[1]);
+            skTextBox.draw(&skCanvas);
+        }
+        if (!HasPixels(directBitmap)) {
+            GTEST_SKIP() << "No font available to draw text";
+        }
+
+        SkBitmap cachedBitmap = MakeCanvasBitmap();
+        {
+            SkCanvas skCanvas(cachedBitmap);
+            cache.Draw(&skCanvas, SkPoint::Make((SkScalar)offset[0], (SkScalar)offset[1]), skPaint);
+        }
+        EXPECT_TRUE(IsSamePixels(directBitmap, cachedBitmap)) << "offset: " << offset[0] << "," << offset[1];
+    }
+}
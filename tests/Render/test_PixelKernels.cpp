@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "duilib/Render/PixelKernels.h"
+#include "duilib/Render/BitmapAlpha.h"
+
+using ui::PixelKernels;
+
+namespace {
+
+const PixelKernels::InstructionSet kAllInstructionSets[] = {
+    PixelKernels::InstructionSet::kScalar,
+    PixelKernels::InstructionSet::kSSE2,
+    PixelKernels::InstructionSet::kAVX2,
+    PixelKernels::InstructionSet::kNEON
+};
+
+std::vector<uint32_t> MakePixels(size_t nCount, uint32_t nSeed)
+{
+    std::vector<uint32_t> pixels(nCount);
+    for (size_t i = 0; i < nCount; ++i) {
+        nSeed = nSeed * 1103515245u + 12345u;
+        pixels[i] = nSeed ^ (nSeed >> 16);
+        if ((i % 5) == 0) {
+            pixels[i] &= 0x00FFFFFF;   //Alpha值为0
+        }
+        else if ((i % 7) == 0) {
+            pixels[i] = (pixels[i] & 0x00FFFFFF) | 0x80000000;
+        }
+    }
+    return pixels;
+}
+
+/** 与原有的逐字节实现相同的参考结果
+*/
+void ReferenceSwizzle(std::vector<uint32_t>& pixels, const uint8_t channelOrder[4])
+{
+    for (uint32_t& pixel : pixels) {
+        const uint32_t colorValue = pixel;
+        for (int k = 0; k < 4; ++k) {
+            ((uint8_t*)&pixel)[k] = ((const uint8_t*)&colorValue)[channelOrder[k]];
+        }
+    }
+}
+
+void ReferenceScale(std::vector<uint32_t>& pixels, uint8_t alpha)
+{
+    for (uint32_t& pixel : pixels) {
+        for (int k = 0; k < 4; ++k) {
+            uint8_t& c = ((uint8_t*)&pixel)[k];
+            c = (uint8_t)(c * alpha / 255);
+        }
+    }
+}
+
+void ReferenceRestoreAlpha(std::vector<uint32_t>& pixels, uint8_t alpha)
+{
+    for (uint32_t& pixel : pixels) {
+        uint8_t* a = (uint8_t*)&pixel + 3;
+        if (alpha != 0 && *a == alpha) {
+            *a = 0;
+        }
+        else if (*a == 0) {
+            *a = 255;
+        }
+    }
+}
+
+/** 依次使用每个支持的指令集执行测试，结束后恢复默认的指令集
+*/
+template<typename TestFunction>
+void ForEachInstructionSet(TestFunction testFunction)
+{
+    const PixelKernels::InstructionSet defaultInstructionSet = PixelKernels::GetInstructionSet();
+    for (PixelKernels::InstructionSet instructionSet : kAllInstructionSets) {
+        if (!PixelKernels::SetInstructionSet(instructionSet)) {
+            EXPECT_FALSE(PixelKernels::IsInstructionSetSupported(instructionSet));
+            continue;
+        }
+        SCOPED_TRACE(PixelKernels::GetInstructionSetName(instructionSet));
+        testFunction();
+    }
+    PixelKernels::SetInstructionSet(defaultInstructionSet);
+}
+
+} // namespace
+
+TEST(PixelKernelsTest, DefaultInstructionSetIsSupported)
+{
+    EXPECT_TRUE(PixelKernels::IsInstructionSetSupported(PixelKernels::InstructionSet::kScalar));
+    EXPECT_TRUE(PixelKernels::IsInstructionSetSupported(PixelKernels::GetInstructionSet()));
+}
+
+TEST(PixelKernelsTest, SwizzleMatchesByteLoop)
+{
+    const uint8_t channelOrders[][4] = { { 2, 1, 0, 3 }, { 3, 2, 1, 0 }, { 1, 2, 3, 0 }, { 0, 0, 0, 3 } };
+    ForEachInstructionSet([&]() {
+        for (size_t nCount = 0; nCount < 70; ++nCount) {
+            for (const auto& channelOrder : channelOrders) {
+                std::vector<uint32_t> pixels = MakePixels(nCount, (uint32_t)nCount + 1);
+                std::vector<uint32_t> expected = pixels;
+                ReferenceSwizzle(expected, channelOrder);
+                PixelKernels::SwizzleChannels(pixels.data(), pixels.size(), channelOrder);
+                ASSERT_EQ(pixels, expected) << "count " << nCount;
+            }
+        }
+    });
+}
+
+TEST(PixelKernelsTest, ScaleMatchesIntegerDivision)
+{
+    ForEachInstructionSet([&]() {
+        for (uint32_t alpha = 0; alpha < 256; ++alpha) {
+            std::vector<uint32_t> pixels = MakePixels(37, alpha + 7);
+            pixels.push_back(0xFFFFFFFF);
+            pixels.push_back(0x00000000);
+            pixels.push_back(0x01FF7F80);
+            std::vector<uint32_t> expected = pixels;
+            ReferenceScale(expected, (uint8_t)alpha);
+            PixelKernels::ScaleChannels(pixels.data(), pixels.size(), (uint8_t)alpha);
+            ASSERT_EQ(pixels, expected) << "alpha " << alpha;
+        }
+    });
+}
+
+TEST(PixelKernelsTest, RestoreAndSetAlpha)
+{
+    ForEachInstructionSet([&]() {
+        for (uint32_t alpha : { 0u, 1u, 128u, 255u }) {
+            std::vector<uint32_t> pixels = MakePixels(67, alpha + 3);
+            std::vector<uint32_t> expected = pixels;
+            ReferenceRestoreAlpha(expected, (uint8_t)alpha);
+            PixelKernels::RestoreAlpha(pixels.data(), pixels.size(), (uint8_t)alpha);
+            ASSERT_EQ(pixels, expected) << "alpha " << alpha;
+
+            PixelKernels::SetAlpha(pixels.data(), pixels.size(), (uint8_t)alpha);
+            for (size_t i = 0; i < pixels.size(); ++i) {
+                ASSERT_EQ(pixels[i], (expected[i] & 0x00FFFFFF) | (alpha << 24));
+            }
+        }
+    });
+}
+
+TEST(PixelKernelsTest, BitmapAlphaRestoresDirtyRectOnly)
+{
+    const int32_t nWidth = 21;
+    const int32_t nHeight = 9;
+    std::vector<uint32_t> pixels = MakePixels((size_t)nWidth * nHeight, 11);
+    std::vector<uint32_t> expected = pixels;
+    for (int32_t y = 2; y < 7; ++y) {
+        for (int32_t x = 3; x < 19; ++x) {
+            uint8_t* a = (uint8_t*)&expected[y * nWidth + x] + 3;
+            if (*a != 255) {
+                *a = 255;
+            }
+        }
+    }
+    ui::BitmapAlpha bitmapAlpha((uint8_t*)pixels.data(), nWidth, nHeight, 4);
+    bitmapAlpha.RestoreAlpha(ui::UiRect(1, 2, 19, 7), ui::UiPadding(3, 0, 0, 0));
+    EXPECT_EQ(pixels, expected);
+}
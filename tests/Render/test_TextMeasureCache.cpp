@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "duilib/Render/TextMeasureCache.h"
+
+using ui::TextGlyphMetrics;
+using ui::TextMeasureCache;
+using ui::TextMeasureResult;
+
+namespace {
+
+/** 模拟的度量函数：记录每次度量的字符，步进宽度按码点计算
+*/
+struct FakeMeasurer
+{
+    std::vector<std::vector<uint32_t>> calls;
+
+    TextMeasureCache::MeasureFunction Function()
+    {
+        return [this](const uint32_t* codePoints, size_t nCount, TextGlyphMetrics* metrics) {
+                calls.emplace_back(codePoints, codePoints + nCount);
+                for (size_t i = 0; i < nCount; ++i) {
+                    metrics[i].nGlyphId = (uint16_t)(codePoints[i] & 0xFFFF);
+                    metrics[i].fAdvance = (float)(codePoints[i] % 13 + 1);
+                    metrics[i].fRight = metrics[i].fAdvance;
+                    metrics[i].fTop = -10;
+                }
+            };
+    }
+};
+
+} // namespace
+
+TEST(TextMeasureCacheTest, DecodeSurrogatePairs)
+{
+    std::vector<uint32_t> codePoints;
+    //"a" + U+1F600 + "中"
+    TextMeasureCache::DecodeUTF16(UTF16String(u"a\xD83D\xDE00\x4E2D"), codePoints);
+    ASSERT_EQ(codePoints.size(), 3u);
+    EXPECT_EQ(codePoints[0], (uint32_t)'a');
+    EXPECT_EQ(codePoints[1], 0x1F600u);
+    EXPECT_EQ(codePoints[2], 0x4E2Du);
+
+    //不成对的代理项替换为U+FFFD
+    TextMeasureCache::DecodeUTF16(UTF16String(u"\xD83D" u"b\xDE00"), codePoints);
+    ASSERT_EQ(codePoints.size(), 3u);
+    EXPECT_EQ(codePoints[0], 0xFFFDu);
+    EXPECT_EQ(codePoints[1], (uint32_t)'b');
+    EXPECT_EQ(codePoints[2], 0xFFFDu);
+
+    TextMeasureCache::DecodeUTF16(UTF16String(u"x\xD83D"), codePoints);
+    ASSERT_EQ(codePoints.size(), 2u);
+    EXPECT_EQ(codePoints[1], 0xFFFDu);
+}
+
+TEST(TextMeasureCacheTest, MeasuresMissingGlyphsInOneBatch)
+{
+    FakeMeasurer measurer;
+    TextMeasureCache cache;
+    auto spResult = cache.MeasureText(UTF16String(u"abca\x4E2D\x6587"), measurer.Function());
+    ASSERT_NE(spResult, nullptr);
+    ASSERT_EQ(spResult->codePoints.size(), 6u);
+    ASSERT_EQ(spResult->metrics.size(), 6u);
+    ASSERT_EQ(measurer.calls.size(), 1u);
+    EXPECT_EQ(measurer.calls[0].size(), 5u);   //重复的字符只度量一次
+    EXPECT_EQ(spResult->metrics[0].fAdvance, spResult->metrics[3].fAdvance);
+    EXPECT_EQ(spResult->metrics[4].fAdvance, (float)(0x4E2D % 13 + 1));
+
+    //新字符串中只有未缓存的字符需要度量
+    spResult = cache.MeasureText(UTF16String(u"cab\x5B57"), measurer.Function());
+    ASSERT_EQ(measurer.calls.size(), 2u);
+    ASSERT_EQ(measurer.calls[1].size(), 1u);
+    EXPECT_EQ(measurer.calls[1][0], 0x5B57u);
+    EXPECT_EQ(spResult->metrics[3].nGlyphId, 0x5B57);
+
+    TextGlyphMetrics metrics = cache.GetGlyphMetrics('b', measurer.Function());
+    EXPECT_EQ(metrics.fAdvance, (float)('b' % 13 + 1));
+    EXPECT_EQ(measurer.calls.size(), 2u);
+
+    const TextMeasureCache::Stats stats = cache.GetStats();
+    EXPECT_EQ(stats.nGlyphCount, 6u);
+    EXPECT_EQ(stats.nStringCount, 2u);
+    EXPECT_EQ(stats.nMeasureCalls, 2u);
+    EXPECT_EQ(stats.nMeasuredGlyphs, 6u);
+}
+
+TEST(TextMeasureCacheTest, StringLruHitsAndEviction)
+{
+    FakeMeasurer measurer;
+    TextMeasureCache cache(2);
+    auto spFirst = cache.MeasureText(UTF16String(u"one"), measurer.Function());
+    cache.MeasureText(UTF16String(u"two"), measurer.Function());
+    EXPECT_EQ(cache.MeasureText(UTF16String(u"one"), measurer.Function()), spFirst);
+
+    //"two"最久未使用，被淘汰
+    cache.MeasureText(UTF16String(u"three"), measurer.Function());
+    EXPECT_EQ(cache.MeasureText(UTF16String(u"one"), measurer.Function()), spFirst);
+    TextMeasureCache::Stats stats = cache.GetStats();
+    EXPECT_EQ(stats.nStringCount, 2u);
+    EXPECT_EQ(stats.nStringHits, 2u);
+    EXPECT_EQ(stats.nStringMisses, 3u);
+
+    cache.MeasureText(UTF16String(u"two"), measurer.Function());
+    stats = cache.GetStats();
+    EXPECT_EQ(stats.nStringMisses, 4u);
+
+    //淘汰后的结果仍然可以使用
+    cache.Clear();
+    ASSERT_EQ(spFirst->codePoints.size(), 3u);
+    EXPECT_EQ(cache.GetStats().nStringCount, 0u);
+    EXPECT_EQ(cache.GetStats().nGlyphCount, 0u);
+}
+
+TEST(TextMeasureCacheTest, GlyphCapKeepsCurrentText)
+{
+    FakeMeasurer measurer;
+    TextMeasureCache cache(0, 4);
+    cache.MeasureText(UTF16String(u"abc"), measurer.Function());
+    EXPECT_EQ(cache.GetStats().nGlyphCount, 3u);
+
+    //超出字符缓存上限：清空后重新度量本次文本的所有字符
+    auto spResult = cache.MeasureText(UTF16String(u"cdef"), measurer.Function());
+    ASSERT_EQ(measurer.calls.size(), 2u);
+    EXPECT_EQ(measurer.calls[1].size(), 4u);
+    EXPECT_EQ(cache.GetStats().nGlyphCount, 4u);
+    EXPECT_EQ(cache.GetStats().nStringCount, 0u);
+    EXPECT_EQ(spResult->metrics[0].fAdvance, (float)('c' % 13 + 1));
+    EXPECT_EQ(spResult->metrics[3].fAdvance, (float)('f' % 13 + 1));
+}
+
+TEST(TextMeasureCacheTest, UncachedMeasuresWholeRun)
+{
+    FakeMeasurer measurer;
+    auto spResult = TextMeasureCache::MeasureTextUncached(UTF16String(u"aa\xD83D\xDE00"), measurer.Function());
+    ASSERT_EQ(spResult->codePoints.size(), 3u);
+    ASSERT_EQ(measurer.calls.size(), 1u);
+    EXPECT_EQ(measurer.calls[0].size(), 3u);
+    EXPECT_EQ(spResult->metrics[2].nGlyphId, 0xF600);
+
+    spResult = TextMeasureCache::MeasureTextUncached(UTF16String(), measurer.Function());
+    EXPECT_TRUE(spResult->codePoints.empty());
+    EXPECT_EQ(measurer.calls.size(), 1u);
+}
@@ -581,6 +581,44 @@ TEST_F(ResourceCompilerTest, GenerateCppCodeIsDeterministicForSameInput)
     EXPECT_EQ(generatedA, generatedB);
 }
 
+TEST_F(ResourceCompilerTest, XmlCompilerEmitsCompiledEntry)
+{
+    duilib::rc::ResourceCompiler compiler;
+    size_t compileCount = 0;
+    compiler.SetXmlCompiler([&compileCount](const std::vector<uint8_t>& xmlData, std::vector<uint8_t>& output) {
+        ++compileCount;
+        output = {0xC0, 0xDE, static_cast<uint8_t>(xmlData.size() & 0xFF)};
+        return true;
+    });
+
+    const fs::path outputPath = m_tempOutputDir / "xml_compiler_output.h";
+    ASSERT_TRUE(CompileQrc(m_testResourceDir / "test.qrc", outputPath, "XmlCompilerPack", compiler));
+    EXPECT_EQ(compileCount, 1u);
+
+    const std::string generated = ReadTextFile(outputPath);
+    EXPECT_NE(generated.find("/xml/window.xml.xmt"), std::string::npos);
+    EXPECT_NE(generated.find("/xml/window.xml\""), std::string::npos);
+    EXPECT_NE(generated.find("6, 0x00, 0x00, 0x00,  // Entry count"), std::string::npos);
+    EXPECT_TRUE(ContainsHexSequence(generated, {0xC0, 0xDE}));
+}
+
+TEST_F(ResourceCompilerTest, XmlCompilerFailureKeepsOriginalXml)
+{
+    duilib::rc::ResourceCompiler compiler;
+    compiler.SetXmlCompiler([](const std::vector<uint8_t>&, std::vector<uint8_t>&) {
+        return false;
+    });
+
+    const fs::path outputPath = m_tempOutputDir / "xml_compiler_failed_output.h";
+    ASSERT_TRUE(CompileQrc(m_testResourceDir / "test.qrc", outputPath, "XmlCompilerFailedPack", compiler));
+    ASSERT_FALSE(compiler.GetWarnings().empty());
+    EXPECT_NE(compiler.GetWarnings().front().find("Failed to compile XML"), std::string::npos);
+
+    const std::string generated = ReadTextFile(outputPath);
+    EXPECT_EQ(generated.find(".xmt"), std::string::npos);
+    EXPECT_NE(generated.find("5, 0x00, 0x00, 0x00,  // Entry count"), std::string::npos);
+}
+
 TEST_F(ResourceCompilerTest, FileTagOutsideQresourceIsIgnored)
 {
     WriteTextFile(m_testResourceDir / "outside.txt", "outside");
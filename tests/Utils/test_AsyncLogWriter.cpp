@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "duilib/Utils/AsyncLogWriter.h"
+
+using ui::AsyncLogWriter;
+
+TEST(AsyncLogWriterTest, WritesAllRecordsInPerThreadOrder)
+{
+    std::mutex recordsMutex;
+    std::vector<std::string> writtenRecords;
+    AsyncLogWriter::Options options;
+    options.nQueueCapacity = 64 * 1024;
+    options.nFlushIntervalMs = 10;
+
+    AsyncLogWriter writer;
+    EXPECT_FALSE(writer.Push(std::string("not started")));
+    ASSERT_TRUE(writer.Start(options, [&](const std::vector<std::string>& records) {
+            std::lock_guard<std::mutex> guard(recordsMutex);
+            writtenRecords.insert(writtenRecords.end(), records.begin(), records.end());
+        }));
+    EXPECT_TRUE(writer.IsRunning());
+
+    const int kThreadCount = 4;
+    const int kRecordCount = 5000;
+    std::vector<std::thread> threads;
+    for (int nThread = 0; nThread < kThreadCount; ++nThread) {
+        threads.emplace_back([&writer, nThread]() {
+                for (int i = 0; i < kRecordCount; ++i) {
+                    EXPECT_TRUE(writer.Push(std::to_string(nThread) + ":" + std::to_string(i)));
+                }
+            });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    writer.Push(std::string("main"));
+    writer.Flush();
+    {
+        std::lock_guard<std::mutex> guard(recordsMutex);
+        ASSERT_EQ(writtenRecords.size(), (size_t)(kThreadCount * kRecordCount + 1));
+        std::vector<int> nextIndexs(kThreadCount, 0);
+        for (const std::string& record : writtenRecords) {
+            if (record == "main") {
+                continue;
+            }
+            const size_t nPos = record.find(':');
+            const int nThread = std::stoi(record.substr(0, nPos));
+            EXPECT_EQ(std::stoi(record.substr(nPos + 1)), nextIndexs[nThread]++);
+        }
+    }
+    writer.Stop();
+    EXPECT_FALSE(writer.IsRunning());
+
+    const AsyncLogWriter::Stats stats = writer.GetStats();
+    EXPECT_EQ(stats.nWrittenRecords, (uint64_t)(kThreadCount * kRecordCount + 1));
+    EXPECT_EQ(stats.nDroppedRecords, 0u);
+    EXPECT_GT(stats.nWriteCount, 0u);
+}
+
+TEST(AsyncLogWriterTest, DropsRecordsWhenQueueIsFull)
+{
+    //写入回调函数阻塞时，队列写满后丢弃新的日志
+    std::promise<void> writeStarted;
+    std::promise<void> writeGate;
+    std::shared_future<void> writeGateFuture = writeGate.get_future().share();
+    std::atomic<bool> bFirstWrite(true);
+    std::atomic<size_t> nWrittenCount(0);
+    AsyncLogWriter::Options options;
+    options.nQueueCapacity = 8;
+    options.nFlushBytes = 1;
+
+    AsyncLogWriter writer;
+    ASSERT_TRUE(writer.Start(options, [&](const std::vector<std::string>& records) {
+            if (bFirstWrite.exchange(false)) {
+                writeStarted.set_value();
+                writeGateFuture.wait();
+            }
+            nWrittenCount += records.size();
+        }));
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(writer.Push("first" + std::to_string(i)));
+    }
+    ASSERT_EQ(writeStarted.get_future().wait_for(std::chrono::seconds(10)), std::future_status::ready);
+
+    int nAcceptedCount = 0;
+    for (int i = 0; i < 100; ++i) {
+        if (writer.Push("second" + std::to_string(i))) {
+            ++nAcceptedCount;
+        }
+    }
+    EXPECT_EQ(nAcceptedCount, 8);
+    writeGate.set_value();
+    writer.Stop();
+
+    const AsyncLogWriter::Stats stats = writer.GetStats();
+    EXPECT_EQ(nWrittenCount.load(), 12u);
+    EXPECT_EQ(stats.nWrittenRecords, 12u);
+    EXPECT_EQ(stats.nDroppedRecords, 92u);
+
+    //停止后可以再次启动
+    ASSERT_TRUE(writer.Start(options, [&](const std::vector<std::string>& records) {
+            nWrittenCount += records.size();
+        }));
+    EXPECT_TRUE(writer.Push(std::string("restart")));
+    writer.Stop();
+    EXPECT_EQ(nWrittenCount.load(), 13u);
+}
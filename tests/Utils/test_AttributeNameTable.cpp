@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+#include "duilib/Utils/AttributeNameTable.h"
+#include "duilib/Utils/StringUtil.h"
+
+using ui::AttributeNameTable;
+
+TEST(AttributeNameTableTest, FindNamesAndAliases)
+{
+    const AttributeNameTable table = {
+        { _T("width"), 0 }, { _T("height"), 1 },
+        { _T("border_size"), 2 }, { _T("bordersize"), 2 },
+        { _T("text"), 3 }
+    };
+    EXPECT_EQ(table.GetCount(), 5u);
+    EXPECT_EQ(table.Find(_T("width")), 0);
+    EXPECT_EQ(table.Find(_T("height")), 1);
+    EXPECT_EQ(table.Find(_T("border_size")), 2);
+    EXPECT_EQ(table.Find(_T("bordersize")), 2);
+    EXPECT_EQ(table.Find(_T("text")), 3);
+    EXPECT_EQ(table.Find(_T("")), -1);
+    EXPECT_EQ(table.Find(_T("Width")), -1);
+    EXPECT_EQ(table.Find(_T("text_id")), -1);
+    EXPECT_EQ(table.Find(_T("widt")), -1);
+}
+
+TEST(AttributeNameTableTest, EmptyTable)
+{
+    const AttributeNameTable table = {};
+    EXPECT_EQ(table.GetCount(), 0u);
+    EXPECT_EQ(table.Find(_T("width")), -1);
+}
+
+TEST(AttributeNameTableTest, ManyNames)
+{
+    //较多相似的名称：所有名称都能查找到，未知名称都查找不到
+    std::vector<DString> names;
+    for (int32_t i = 0; i < 1000; ++i) {
+        names.push_back(_T("attr_") + ui::StringUtil::Int32ToString(i));
+    }
+    std::vector<AttributeNameTable::TEntry> entries;
+    for (size_t i = 0; i < names.size(); ++i) {
+        entries.push_back({ names[i].c_str(), (int32_t)i });
+    }
+    const AttributeNameTable table(entries);
+    EXPECT_EQ(table.GetCount(), names.size());
+    for (size_t i = 0; i < names.size(); ++i) {
+        ASSERT_EQ(table.Find(names[i]), (int32_t)i) << "index=" << i;
+    }
+    for (int32_t i = 1000; i < 3000; ++i) {
+        ASSERT_EQ(table.Find(_T("attr_") + ui::StringUtil::Int32ToString(i)), -1);
+    }
+}
+
+TEST(AttributeNameTableTest, DuplicateNames)
+{
+#ifdef _DEBUG
+    GTEST_SKIP() << "Duplicate names trigger ASSERT in debug builds";
+#else
+    //重复的名称只保留第一个，不影响生成查找表
+    const AttributeNameTable table = {
+        { _T("width"), 0 }, { _T("height"), 1 },
+        { _T("width"), 2 }, { _T("width"), 3 },
+        { _T("text"), 4 }
+    };
+    EXPECT_EQ(table.GetCount(), 3u);
+    EXPECT_EQ(table.Find(_T("width")), 0);
+    EXPECT_EQ(table.Find(_T("height")), 1);
+    EXPECT_EQ(table.Find(_T("text")), 4);
+    EXPECT_EQ(table.Find(_T("size")), -1);
+#endif
+}
@@ -1,5 +1,9 @@
 #include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
 #include "duilib/Utils/LogUtil.h"
+#include "duilib/Utils/StringConvert.h"
 
 using ui::LogUtil;
 
@@ -33,3 +37,27 @@ TEST(LogUtilTest, OutputDoesNotThrow)
     EXPECT_NO_THROW(LogUtil::Debug(_T("log-util-debug"), true));
     EXPECT_NO_THROW(LogUtil::DebugLine(_T("log-util-debug-line"), false));
 }
+
+TEST(LogUtilTest, OutputFieldsEscapesLineBreaks)
+{
+    const std::filesystem::path logPath = std::filesystem::temp_directory_path() / "duilib_log_fields_test.log";
+    std::filesystem::remove(logPath);
+    ASSERT_TRUE(LogUtil::EnableAsyncMode(ui::StringConvert::UTF8ToT(logPath.string())));
+    LogUtil::OutputFields(_T("event"), { { _T("plain"), _T("value") },
+                                         { _T("text"), _T("line1\r\nline2 \"q\"") },
+                                         { _T("lf"), _T("a\nb") } }, false);
+    LogUtil::DisableAsyncMode();
+
+    std::ifstream file(logPath, std::ios::binary);
+    std::stringstream content;
+    content << file.rdbuf();
+    file.close();
+    std::filesystem::remove(logPath);
+
+    //每条日志只占一行，换行符转义后输出
+    std::string text = content.str();
+    while (!text.empty() && ((text.back() == '\n') || (text.back() == '\r'))) {
+        text.pop_back();
+    }
+    EXPECT_EQ(text, "event plain=value text=\"line1\\r\\nline2 \\\"q\\\"\" lf=\"a\\nb\"");
+}
@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "duilib/Utils/Lz4Util.h"
+
+using ui::Lz4Util;
+
+namespace {
+
+std::vector<uint8_t> RoundTrip(const std::vector<uint8_t>& input, size_t* pCompressedSize = nullptr)
+{
+    std::vector<uint8_t> compressed;
+    const size_t nCompressedSize = Lz4Util::CompressBlock(input.data(), input.size(), compressed);
+    EXPECT_EQ(nCompressedSize, compressed.size());
+    EXPECT_LE(nCompressedSize, Lz4Util::GetMaxCompressedSize(input.size()));
+    if (pCompressedSize != nullptr) {
+        *pCompressedSize = nCompressedSize;
+    }
+    std::vector<uint8_t> output(input.size());
+    EXPECT_TRUE(Lz4Util::DecompressBlock(compressed.data(), compressed.size(), output.data(), output.size()));
+    return output;
+}
+
+std::vector<uint8_t> MakeXmlLikeData(size_t nSize)
+{
+    const std::string pattern = "<Button class=\"btn_global_blue_80x30\" name=\"ok\" text=\"OK\" margin=\"0,0,10,0\"/>\n";
+    std::vector<uint8_t> data;
+    data.reserve(nSize);
+    for (size_t i = 0; data.size() < nSize; ++i) {
+        data.push_back((uint8_t)pattern[i % pattern.size()]);
+        if ((i % 97) == 0) {
+            data.push_back((uint8_t)('0' + (i % 10)));
+        }
+    }
+    data.resize(nSize);
+    return data;
+}
+
+} // namespace
+
+TEST(Lz4UtilTest, EmptyAndTinyInputs)
+{
+    for (size_t nSize = 0; nSize <= 20; ++nSize) {
+        std::vector<uint8_t> input(nSize, 'a');
+        EXPECT_EQ(RoundTrip(input), input) << "size=" << nSize;
+    }
+}
+
+TEST(Lz4UtilTest, CompressibleDataRoundTrip)
+{
+    const std::vector<uint8_t> input = MakeXmlLikeData(200 * 1024);
+    size_t nCompressedSize = 0;
+    EXPECT_EQ(RoundTrip(input, &nCompressedSize), input);
+    EXPECT_LT(nCompressedSize, input.size() / 4);
+}
+
+TEST(Lz4UtilTest, OverlappingMatchesAndLongRuns)
+{
+    std::vector<uint8_t> input(70000, 0);
+    for (size_t i = 0; i < 300; ++i) {
+        input[i] = (uint8_t)(i * 7);
+    }
+    EXPECT_EQ(RoundTrip(input), input);
+}
+
+TEST(Lz4UtilTest, IncompressibleDataRoundTrip)
+{
+    std::vector<uint8_t> input(100000);
+    uint32_t nSeed = 12345;
+    for (uint8_t& ch : input) {
+        nSeed = nSeed * 1103515245u + 12345u;
+        ch = (uint8_t)(nSeed >> 24);
+    }
+    EXPECT_EQ(RoundTrip(input), input);
+}
+
+TEST(Lz4UtilTest, CorruptedDataRejected)
+{
+    const std::vector<uint8_t> input = MakeXmlLikeData(4096);
+    std::vector<uint8_t> compressed;
+    ASSERT_GT(Lz4Util::CompressBlock(input.data(), input.size(), compressed), 0u);
+    std::vector<uint8_t> output(input.size());
+
+    //原始长度不一致
+    EXPECT_FALSE(Lz4Util::DecompressBlock(compressed.data(), compressed.size(), output.data(), output.size() - 1));
+    std::vector<uint8_t> largerOutput(input.size() + 1);
+    EXPECT_FALSE(Lz4Util::DecompressBlock(compressed.data(), compressed.size(), largerOutput.data(), largerOutput.size()));
+
+    //截断的数据
+    EXPECT_FALSE(Lz4Util::DecompressBlock(compressed.data(), compressed.size() / 2, output.data(), output.size()));
+
+    //任意修改一个字节，解压不能越界（结果可能成功也可能失败）
+    for (size_t i = 0; i < compressed.size(); i += 7) {
+        std::vector<uint8_t> damaged = compressed;
+        damaged[i] ^= 0x5A;
+        Lz4Util::DecompressBlock(damaged.data(), damaged.size(), output.data(), output.size());
+    }
+
+    //回溯距离超出已解压的数据
+    const uint8_t badOffset[] = { 0x10, 'a', 0xFF, 0x00, 0x00 };
+    EXPECT_FALSE(Lz4Util::DecompressBlock(badOffset, sizeof(badOffset), output.data(), 20));
+}
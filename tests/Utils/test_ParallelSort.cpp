@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "duilib/Utils/ParallelSort.h"
+
+using ui::ParallelSort;
+
+namespace {
+
+struct Item
+{
+    uint32_t nKey = 0;
+    uint32_t nOrder = 0;
+};
+
+std::vector<Item> MakeItems(size_t nCount, uint32_t nKeyRange)
+{
+    std::vector<Item> items(nCount);
+    uint32_t nSeed = 2024;
+    for (size_t i = 0; i < nCount; ++i) {
+        nSeed = nSeed * 1103515245u + 12345u;
+        items[i].nKey = (nSeed >> 8) % nKeyRange;
+        items[i].nOrder = (uint32_t)i;
+    }
+    return items;
+}
+
+void CheckStableSorted(const std::vector<Item>& items, size_t nCount)
+{
+    ASSERT_EQ(items.size(), nCount);
+    for (size_t i = 1; i < items.size(); ++i) {
+        ASSERT_LE(items[i - 1].nKey, items[i].nKey) << "index=" << i;
+        if (items[i - 1].nKey == items[i].nKey) {
+            ASSERT_LT(items[i - 1].nOrder, items[i].nOrder) << "index=" << i;
+        }
+    }
+}
+
+bool LessByKey(const Item& a, const Item& b)
+{
+    return a.nKey < b.nKey;
+}
+
+} // namespace
+
+TEST(ParallelSortTest, ThreadCount)
+{
+    EXPECT_EQ(ParallelSort::GetThreadCount(0, 8, 100), 1u);
+    EXPECT_EQ(ParallelSort::GetThreadCount(99, 8, 100), 1u);
+    EXPECT_EQ(ParallelSort::GetThreadCount(350, 8, 100), 3u);
+    EXPECT_EQ(ParallelSort::GetThreadCount(100000, 8, 100), 8u);
+    EXPECT_EQ(ParallelSort::GetThreadCount(100000, 8, 0), 8u);
+}
+
+TEST(ParallelSortTest, SmallInputUsesSingleThread)
+{
+    std::vector<Item> items = MakeItems(1000, 10);
+    ParallelSort::StableSort(items, LessByKey);
+    CheckStableSorted(items, 1000);
+}
+
+TEST(ParallelSortTest, StableWithManyThreads)
+{
+    //分段数为奇数和偶数的情况都要覆盖
+    for (size_t nThreads = 2; nThreads <= 7; ++nThreads) {
+        std::vector<Item> items = MakeItems(10007, 50);
+        ParallelSort::StableSort(items, LessByKey, nThreads, 100);
+        CheckStableSorted(items, 10007);
+    }
+}
+
+TEST(ParallelSortTest, MatchesStdStableSort)
+{
+    std::vector<Item> items = MakeItems(200000, 1000);
+    std::vector<Item> expected = items;
+    std::stable_sort(expected.begin(), expected.end(), LessByKey);
+    ParallelSort::StableSort(items, LessByKey, 4, 1000);
+    ASSERT_EQ(items.size(), expected.size());
+    for (size_t i = 0; i < items.size(); ++i) {
+        ASSERT_EQ(items[i].nOrder, expected[i].nOrder) << "index=" << i;
+    }
+}
+
+TEST(ParallelSortTest, DescendingKeepsEqualOrder)
+{
+    std::vector<Item> items = MakeItems(50000, 20);
+    ParallelSort::StableSort(items, [](const Item& a, const Item& b) {
+            return b.nKey < a.nKey;
+        }, 4, 1000);
+    for (size_t i = 1; i < items.size(); ++i) {
+        ASSERT_GE(items[i - 1].nKey, items[i].nKey);
+        if (items[i - 1].nKey == items[i].nKey) {
+            ASSERT_LT(items[i - 1].nOrder, items[i].nOrder);
+        }
+    }
+}
@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+
+#include "duilib/Utils/PerformanceUtil.h"
+
+using ui::FrameTimeHistory;
+using ui::PerformanceUtil;
+
+namespace {
+
+size_t CountText(const std::string& text, const std::string& sub)
+{
+    size_t nCount = 0;
+    for (size_t nPos = text.find(sub); nPos != std::string::npos; nPos = text.find(sub, nPos + sub.size())) {
+        ++nCount;
+    }
+    return nCount;
+}
+
+} // namespace
+
+TEST(PerformanceUtilTest, FrameTimeHistogram)
+{
+    FrameTimeHistory history(4);
+    EXPECT_EQ(history.GetFrameCount(), 0u);
+    EXPECT_EQ(history.GetAverageTime().count(), 0);
+
+    history.AddFrame(std::chrono::microseconds(2000));
+    history.AddFrame(std::chrono::microseconds(10000));
+    history.AddFrame(std::chrono::microseconds(20000));
+    history.AddFrame(std::chrono::microseconds(100000));
+    EXPECT_EQ(history.GetFrameCount(), 4u);
+    EXPECT_EQ(history.GetMaxTime().count(), 100000);
+    EXPECT_EQ(history.GetAverageTime().count(), 33000);
+
+    std::vector<uint32_t> histogram;
+    history.GetHistogram(histogram);
+    ASSERT_EQ(histogram.size(), FrameTimeHistory::GetHistogramBounds().size() + 1);
+    EXPECT_EQ(histogram, (std::vector<uint32_t>{ 1, 0, 1, 1, 0, 1 }));
+
+    //超过容量时，替换最早的帧
+    history.AddFrame(std::chrono::microseconds(5000));
+    EXPECT_EQ(history.GetFrameCount(), 4u);
+    history.GetHistogram(histogram);
+    EXPECT_EQ(histogram, (std::vector<uint32_t>{ 0, 1, 1, 1, 0, 1 }));
+
+    history.Clear();
+    EXPECT_EQ(history.GetFrameCount(), 0u);
+}
+
+TEST(PerformanceUtilTest, ChromeTraceExport)
+{
+    PerformanceUtil& util = PerformanceUtil::Instance();
+    util.ClearTraceEvents();
+    {
+        //未开启时不记录
+        ui::PerformanceTrace trace(_T("TraceTest::Disabled"));
+    }
+    util.SetTraceEnabled(true);
+    for (int32_t i = 0; i < 3; ++i) {
+        ui::PerformanceTrace trace(_T("TraceTest::Outer"));
+        ui::PerformanceStat stat(_T("TraceTest::\"Quoted\""));
+    }
+    std::thread worker([]() {
+            ui::PerformanceTrace trace(_T("TraceTest::Worker"));
+        });
+    worker.join();
+    util.SetTraceEnabled(false);
+
+    const std::string json = util.GetChromeTraceJson();
+    EXPECT_EQ(json.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["), 0u);
+    EXPECT_EQ(CountText(json, "TraceTest::Disabled"), 0u);
+    EXPECT_EQ(CountText(json, "\"name\":\"TraceTest::Outer\""), 3u);
+    EXPECT_EQ(CountText(json, "\"name\":\"TraceTest::\\\"Quoted\\\"\""), 3u);
+    EXPECT_EQ(CountText(json, "\"name\":\"TraceTest::Worker\",\"ph\":\"X\",\"pid\":1,\"tid\":1,"), 0u);
+    EXPECT_EQ(CountText(json, "\"name\":\"TraceTest::Worker\""), 1u);
+
+    util.ClearTraceEvents();
+    EXPECT_EQ(CountText(util.GetChromeTraceJson(), "TraceTest::"), 0u);
+}
+
+TEST(PerformanceUtilTest, TraceRingBufferKeepsRecentEvents)
+{
+    PerformanceUtil& util = PerformanceUtil::Instance();
+    util.ClearTraceEvents();
+    const auto now = std::chrono::steady_clock::now();
+    const size_t nEventCount = 100000;
+    for (size_t i = 0; i < nEventCount; ++i) {
+        util.AddTraceEvent((i + 1 == nEventCount) ? _T("TraceTest::Last") : _T("TraceTest::Ring"), now, now);
+    }
+    const std::string json = util.GetChromeTraceJson();
+    const size_t nRingCount = CountText(json, "TraceTest::Ring");
+    EXPECT_GT(nRingCount, 0u);
+    EXPECT_LT(nRingCount, nEventCount - 1);
+    EXPECT_EQ(CountText(json, "TraceTest::Last"), 1u);
+    util.ClearTraceEvents();
+}
+
+TEST(PerformanceUtilTest, ClearTraceEventsWhileTracing)
+{
+    PerformanceUtil& util = PerformanceUtil::Instance();
+    util.ClearTraceEvents();
+    const auto now = std::chrono::steady_clock::now();
+    util.AddTraceEvent(_T("TraceTest::Before"), now, now);
+
+    //其他线程清除记录时，所属线程的写入计数不受影响，之后写入的记录仍可导出
+    std::thread cleaner([&util]() {
+            util.ClearTraceEvents();
+        });
+    cleaner.join();
+    util.AddTraceEvent(_T("TraceTest::After"), now, now);
+
+    const std::string json = util.GetChromeTraceJson();
+    EXPECT_EQ(CountText(json, "TraceTest::Before"), 0u);
+    EXPECT_EQ(CountText(json, "TraceTest::After"), 1u);
+    util.ClearTraceEvents();
+}